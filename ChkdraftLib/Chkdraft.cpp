@@ -69,7 +69,10 @@ int Chkdraft::Run(LPSTR lpCmdLine, int nCmdShow)
     if ( !CreateThis() )
         return 1;
     
-    scData.load(Sc::DataFile::BrowserPtr(new ChkdDataFileBrowser()), ChkdDataFileBrowser::getDataFileDescriptors(), ChkdDataFileBrowser::getExpectedStarCraftDirectory());
+    std::string cachePath;
+    std::string scDataCacheFilePath = GetCachePath(cachePath) ? cachePath + "ScData.cache" : "";
+    scData.load(Sc::DataFile::BrowserPtr(new ChkdDataFileBrowser()), ChkdDataFileBrowser::getDataFileDescriptors(), ChkdDataFileBrowser::getExpectedStarCraftDirectory(),
+        Sc::DataFile::Browser::getDefaultStarCraftBrowser(), scDataCacheFilePath);
     InitCommonControls();
     UpdateLogLevelCheckmarks(logger.getLogLevel());
     ShowWindow(getHandle(), nCmdShow);
@@ -115,7 +118,7 @@ int Chkdraft::Run(LPSTR lpCmdLine, int nCmdShow)
         }
 
         if ( CM != nullptr && ColorCycler::CycleColors(CM->layers.getTileset(), CM->getPalette()) )
-            CM->Redraw(false);
+            CM->Recolor();
 
         std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Avoid consuming a core
 
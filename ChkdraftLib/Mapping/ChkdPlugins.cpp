@@ -1,7 +1,45 @@
 #include "ChkdPlugins.h"
 #include "../Chkdraft.h"
 #include "../../MappingCoreLib/TextTrigCompiler.h"
+#include "../../MappingCoreLib/TextTrigGenerator.h"
+#include "../../MappingCoreLib/PluginTransport.h"
 #include "Settings.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace
+{
+    std::map<u16, std::unique_ptr<SharedMemory>> scenarioViews; // The view last published for each mapID
+    u32 numScenarioViewsPublished = 0;
+
+    struct TriggerTextHashes // The hashes of a map's triggers as text, as of the last time they were generated or compiled
+    {
+        std::vector<u64> triggerHashes;
+        u64 modificationEpoch = 0; // The map's Scenario::getModificationEpoch when the hashes were taken
+        bool useAddressesForMemory = false; // The settings the text was generated with
+        u32 deathTableStart = 0;
+    };
+    std::map<u16, TriggerTextHashes> triggerTextHashes; // Kept for each mapID so unchanged maps aren't converted to text again
+
+    bool applyPluginPatch(GuiMapPtr map, const ScenarioPatch & patch) // Re-reads only the sections the patch touches
+    {
+        scenarioViews.erase(chkd.maps.GetMapID(map)); // The view no longer matches the map
+        if ( patch.apply(*map) )
+        {
+            map->refreshScenario();
+            map->notifyChange(false);
+            return true;
+        }
+        return false;
+    }
+}
+
+void ReleaseScenarioView(u16 mapID)
+{
+    scenarioViews.erase(mapID);
+    triggerTextHashes.erase(mapID); // A map opened later may be given the same mapID
+}
 
 LRESULT CALLBACK PluginProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
@@ -26,11 +64,37 @@ LRESULT CALLBACK PluginProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
                         {
                             case UPDATE_CHK_FILE:
                                 {
-                                    if ( map->deserialize((Chk::SerializedChk*)copyData) )
+                                    const Chk::SerializedChk* serializedChk = (const Chk::SerializedChk*)copyData;
+                                    if ( size_t(length) >= sizeof(Chk::ChkHeader) && serializedChk->header.name == Chk::CHK &&
+                                        serializedChk->header.sizeInBytes <= Chk::Size(size_t(length) - sizeof(Chk::ChkHeader)) )
                                     {
-                                        map->refreshScenario();
-                                        map->notifyChange(false);
-                                        return TRUE;
+                                        ScenarioPatch patch; // Each section in the file replaces the map's section, sections the file lacks are left unchanged
+                                        const u8* chk = &serializedChk->data[0];
+                                        size_t chkSize = size_t(serializedChk->header.sizeInBytes);
+                                        for ( size_t pos = 0; pos + sizeof(Chk::SectionHeader) <= chkSize; )
+                                        {
+                                            const Chk::SectionHeader* sectionHeader = (const Chk::SectionHeader*)&chk[pos];
+                                            pos += sizeof(Chk::SectionHeader);
+                                            if ( sectionHeader->sizeInBytes < 0 )
+                                                break;
+
+                                            size_t sectionSize = std::min(size_t(sectionHeader->sizeInBytes), chkSize - pos); // The last section may be cut short
+                                            patch.replaceSection(sectionHeader->name, &chk[pos], sectionSize);
+                                            pos += sectionSize;
+                                        }
+                                        if ( !patch.empty() && applyPluginPatch(map, patch) )
+                                            return TRUE;
+                                    }
+                                }
+                                break;
+                            case REPLACE_TRIGGERS_BYTES:
+                                {
+                                    if ( length % sizeof(Chk::Trigger) == 0 )
+                                    {
+                                        ScenarioPatch patch;
+                                        patch.replaceSection(SectionName::TRIG, copyData, size_t(length));
+                                        if ( applyPluginPatch(map, patch) )
+                                            return TRUE;
                                     }
                                 }
                                 break;
@@ -43,9 +107,29 @@ LRESULT CALLBACK PluginProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 
                                     std::string textBuf(inputText.get());
 
+                                    u16 mapID = chkd.maps.GetMapID(map);
+                                    auto hashes = triggerTextHashes.find(mapID); // Triggers the plugin left as they were generated aren't compiled again
+                                    if ( hashes == triggerTextHashes.end() || hashes->second.modificationEpoch != map->getModificationEpoch() ||
+                                        hashes->second.triggerHashes.size() != map->triggers.numTriggers() ||
+                                        hashes->second.useAddressesForMemory != Settings::useAddressesForMemory || hashes->second.deathTableStart != Settings::deathTableStart )
+                                    { // The map changed since its triggers were last hashed, generate them again
+                                        std::string currentText;
+                                        TextTrigGenerator textTrigs(Settings::useAddressesForMemory, Settings::deathTableStart);
+                                        TriggerTextHashes generated;
+                                        generated.useAddressesForMemory = Settings::useAddressesForMemory;
+                                        generated.deathTableStart = Settings::deathTableStart;
+                                        if ( textTrigs.generateTextTrigs(map, currentText) )
+                                        {
+                                            generated.triggerHashes = textTrigs.getTriggerHashes();
+                                            generated.modificationEpoch = textTrigs.getModificationEpoch();
+                                        }
+                                        hashes = triggerTextHashes.insert_or_assign(mapID, std::move(generated)).first;
+                                    }
+
                                     TextTrigCompiler compiler(Settings::useAddressesForMemory, Settings::deathTableStart);
-                                    if ( compiler.compileTriggers(textBuf, map, chkd.scData, 0, map->triggers.numTriggers()) )
+                                    if ( compiler.compileChangedTriggers(textBuf, map, chkd.scData, hashes->second.triggerHashes, hashes->second.modificationEpoch) ) // Updates the hashes to the compiled text
                                     {
+                                        scenarioViews.erase(mapID);
                                         map->notifyChange(false);
                                         return TRUE;
                                     }
@@ -53,6 +137,15 @@ LRESULT CALLBACK PluginProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
                                         WinLib::Message("Compilation failed.", "Error!");
                                 }
                                 break;
+                            case APPLY_SCENARIO_PATCH:
+                                {
+                                    ScenarioPatch patch;
+                                    if ( patch.deserialize((const u8*)copyData, size_t(length)) && applyPluginPatch(map, patch) )
+                                        return TRUE;
+                                    else
+                                        scenarioViews.erase(chkd.maps.GetMapID(map));
+                                }
+                                break;
                         }
                     }
                 }
@@ -87,6 +180,30 @@ LRESULT CALLBACK PluginProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
             }
             break;
 
+        case MAP_SCENARIO_VIEW:
+            {
+                GuiMapPtr map = chkd.maps.GetMap((u16)lParam);
+                if ( map != nullptr )
+                {
+                    u16 mapID = chkd.maps.GetMapID(map);
+                    scenarioViews.erase(mapID);
+                    std::string viewName = "ChkdScenarioView-" + std::to_string(GetCurrentProcessId()) + "-" + std::to_string(mapID) +
+                        "-" + std::to_string(++numScenarioViewsPublished);
+                    std::unique_ptr<SharedMemory> view = std::unique_ptr<SharedMemory>(new SharedMemory());
+                    if ( ScenarioView::publish(*map, viewName, *view) )
+                    {
+                        scenarioViews[mapID] = std::move(view);
+                        COPYDATASTRUCT copyData;
+                        copyData.dwData = (ULONG_PTR)MAKELONG(MAP_SCENARIO_VIEW, mapID);
+                        copyData.lpData = PVOID(viewName.c_str());
+                        copyData.cbData = DWORD(viewName.size()+1);
+                        SendMessage((HWND)wParam, WM_COPYDATA, (WPARAM)hWnd, (LPARAM)&copyData);
+                        return mapID;
+                    }
+                }
+            }
+            break;
+
         default:
             return DefWindowProc(hWnd, msg, wParam, lParam); // Valid occasion to use this method
             break;
@@ -1,9 +1,10 @@
 #ifndef PLUGINS_H
 #define PLUGINS_H
+#include "../../MappingCoreLib/Basics.h"
 #include <Windows.h>
 
 #define PLUGIN_MSG_START        (WM_APP+200)
-#define PLUGIN_MSG_END          (WM_APP+204)
+#define PLUGIN_MSG_END          (WM_APP+206)
 
 /** Basic messages, get a handle to CHKDraft with the above
     messages, then you can use the messages that follow */
@@ -36,7 +37,8 @@
         /** Send this as part of WM_COPYDATA to update and refresh
             the map; it is recommeded to return the scenario file
             ASAP after retrieving it so changes aren't made and lost
-            in CHKDraft
+            in CHKDraft; each section in the file replaces the map's
+            section, sections left out of the file are left unchanged
 
             wParam: set to sending handle
             lParam: COPYDATASTRUCT with lpData = chk file, size
@@ -55,10 +57,49 @@
     FALSE otherwise */
 
     #define REPLACE_TRIGGERS_BYTES  (PLUGIN_MSG_START+3)
+        /** lpData is the new TRIG section, it's applied as a ScenarioPatch
+            replacing only that section */
     #define REPLACE_TRIGGERS_TEXT   (PLUGIN_MSG_START+4)
+        /** lpData is NUL-terminated text triggers, triggers left as text
+            trigger generation would write them aren't compiled again */
+
+
+/** For large maps, copying and re-reading the whole chk file for a small
+    change is slow; instead plugins can read the map through a view in
+    shared memory and send back a patch with only the bytes they changed,
+    include mapping core in your project and see PluginTransport.h for
+    ScenarioView and ScenarioPatch */
+
+    #define MAP_SCENARIO_VIEW       (PLUGIN_MSG_START+5)
+        /** This will cause CHKDraft to publish a ScenarioView of the map
+            in shared memory and send you WM_COPYDATA containing the
+            NUL-terminated name of the shared memory in lpData, its size
+            in cbData, and MAKELONG(MAP_SCENARIO_VIEW, mapID) as dwData;
+            open the view with SharedMemory::open before returning from
+            WM_COPYDATA, the view stays valid until the next
+            MAP_SCENARIO_VIEW or APPLY_SCENARIO_PATCH for the map
+
+            wParam: HWND to the window WM_COPYDATA with the name will be
+                    sent to
+            lParam: mapID, if NULL, the currently focused map will be used
+            return: The mapped mapID if successful, 0 otherwise */
+
+    #define APPLY_SCENARIO_PATCH    (PLUGIN_MSG_START+6)
+        /** Send this as part of WM_COPYDATA to apply a patch and refresh
+            the map, either the whole patch is applied or none of it is
+
+            wParam: set to sending handle
+            lParam: COPYDATASTRUCT with lpData = ScenarioPatch::serialize(),
+                    its size as cbData and dwData as described below
+
+                    dwData = (LPARAM)MAKELONG(APPLY_SCENARIO_PATCH, mapID);
+                    if mapID is 0 the current map is the one patched.
+            return: TRUE if the patch was applied, FALSE otherwise */
 
 
 
 LRESULT CALLBACK PluginProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
+void ReleaseScenarioView(u16 mapID); // Closes the view last published for mapID, if any, and drops its trigger hashes, called when the map closes
+
 #endif
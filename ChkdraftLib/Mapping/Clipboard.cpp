@@ -145,7 +145,7 @@ void Clipboard::copy(GuiMap & map, Layer layer)
             edges.bottom = currUnit->yc;
 
             auto & selectedUnits = selections.getUnits();
-            for ( u16 & unitIndex : selectedUnits )
+            for ( u16 unitIndex : selectedUnits )
             {
                 Chk::UnitPtr currUnit = map.layers.getUnit(unitIndex);
                 PasteUnitNode add(currUnit);
@@ -412,6 +412,7 @@ void Clipboard::pasteUnits(s32 mapClickX, s32 mapClickY, GuiMap & map, Undos & u
                 prevPaste.y = pasteUnit.unit->yc;
                 size_t numUnits = map.layers.numUnits();
                 map.layers.addUnit(Chk::UnitPtr(new Chk::Unit(*pasteUnit.unit)));
+                map.UnitAdded(numUnits);
                 unitCreates->Insert(UnitCreateDel::Make((u16)numUnits));
                 if ( chkd.unitWindow.getHandle() != nullptr )
                     chkd.unitWindow.AddUnitItem((u16)numUnits, pasteUnit.unit);
@@ -130,9 +130,41 @@ inline void BoundedAdjustPx(Sc::SystemColor & pixel, s16 redOffset, s16 greenOff
 
 Sc::SystemColor black = Sc::SystemColor();
 
+constexpr PaletteFramebuffer::Slot BlackSlot = PaletteFramebuffer::FirstFixedSlot;
+constexpr PaletteFramebuffer::Slot FirstGridSlot = BlackSlot+1; // One slot for each of the two grids
+constexpr PaletteFramebuffer::Slot FirstPlayerColorSlot = FirstGridSlot+2; // Eight slots for each of the sixteen player colors
+constexpr PaletteFramebuffer::Slot FirstSelectionSlot = FirstPlayerColorSlot+16*8; // Eight slots for selection circle colors
+
+std::array<TileMipmaps, Sc::Terrain::NumTilesets> Graphics::tileMipmaps;
+
+inline s32 FloorShift(s32 value, u8 shift) // value >> shift, rounding toward negative infinity for negative values
+{
+    return value >= 0 ? value >> shift : -((-value + (1 << shift) - 1) >> shift);
+}
+
 Graphics::Graphics(GuiMap & map, Selections & selections) : map(map), selections(selections),
-    displayingTileNums(false), tileNumsFromMTXM(false), displayingElevations(false), clipLocationNames(true), mapWidth(0), mapHeight(0), screenWidth(0), screenHeight(0), screenLeft(0), screenTop(0)
+    displayingTileNums(false), tileNumsFromMTXM(false), displayingElevations(false), clipLocationNames(true), mapWidth(0), mapHeight(0), screenWidth(0), screenHeight(0), screenLeft(0), screenTop(0),
+    zoomLevel(0)
 {
+    framebuffer.setFixedColor(BlackSlot, black);
+    for ( size_t color=0; color<playerColorSlots.size(); color++ )
+    {
+        playerColorSlots[color] = PaletteFramebuffer::paletteSlots();
+        for ( size_t i=0; i<8; i++ )
+        {
+            PaletteFramebuffer::Slot slot = PaletteFramebuffer::Slot(FirstPlayerColorSlot + 8*color + i);
+            playerColorSlots[color][8+i] = slot;
+            framebuffer.setFixedColor(slot, 8*color+i < chkd.scData.tunit.palette.size() ? chkd.scData.tunit.palette[8*color+i] : black);
+        }
+    }
+
+    selectionSlots = PaletteFramebuffer::paletteSlots();
+    for ( size_t i=0; i<8; i++ )
+    {
+        selectionSlots[i] = PaletteFramebuffer::Slot(FirstSelectionSlot + i);
+        framebuffer.setFixedColor(selectionSlots[i], i < chkd.scData.tselect.palette.size() ? chkd.scData.tselect.palette[i] : black);
+    }
+
     if ( !map.empty() )
         updatePalette();
 }
@@ -163,32 +195,135 @@ void Graphics::DrawMap(u16 bitWidth, u16 bitHeight, s32 screenLeft, s32 screenTo
     mapWidth = (u16)map.layers.getTileWidth();
     mapHeight = (u16)map.layers.getTileHeight();
 
-    if ( displayingElevations )
+    zoomLevel = displayingElevations ? 0 : TileMipmaps::levelFor(map.getZoom()); // Elevations are only drawn at full scale
+    framebuffer.resize(screenWidth >> zoomLevel, screenHeight >> zoomLevel);
+    if ( displayingElevations ) // Elevations are drawn straight to the bitmap, everything else is composed over them
+    {
+        framebuffer.fill(PaletteFramebuffer::Transparent);
         DrawTileElevations(bitmap);
+    }
     else
-        DrawTerrain(bitmap);
+    {
+        framebuffer.fill(BlackSlot);
+        DrawTerrain(framebuffer);
+    }
 
-    DrawGrid(bitmap);
+    DrawGrid(framebuffer);
 
-    DrawUnits(bitmap);
+    DrawUnits(framebuffer);
 
-    DrawSprites(bitmap);
+    DrawSprites(framebuffer);
 
-    if ( map.getLayer() == Layer::Locations )
-        DrawLocations(bitmap, showAnywhere);
+    ComposeMap(bitmap, hDC, showAnywhere);
+}
+
+void Graphics::RecolorMap(u16 bitWidth, u16 bitHeight, s32 screenLeft, s32 screenTop, ChkdBitmap & bitmap, HDC hDC, bool showAnywhere)
+{
+    if ( IsLastDrawnView(bitWidth, bitHeight, screenLeft, screenTop, bitmap) )
+        ComposeMap(bitmap, hDC, showAnywhere);
+    else
+        DrawMap(bitWidth, bitHeight, screenLeft, screenTop, bitmap, hDC, showAnywhere);
+}
+
+void Graphics::DrawMapRegions(const DirtyRegion & dirtyRegion, u16 bitWidth, u16 bitHeight, s32 screenLeft, s32 screenTop, ChkdBitmap & bitmap, HDC hDC, bool showAnywhere)
+{
+    if ( dirtyRegion.isAll() || !IsLastDrawnView(bitWidth, bitHeight, screenLeft, screenTop, bitmap) )
+        DrawMap(bitWidth, bitHeight, screenLeft, screenTop, bitmap, hDC, showAnywhere);
+    else
+    {
+        DirtyRegion::Rect view = { screenLeft, screenTop, screenLeft+s32(bitWidth), screenTop+s32(bitHeight) };
+        for ( const DirtyRegion::Rect & rect : dirtyRegion.clip(view) )
+            DrawRegion(rect);
+
+        ComposeMap(bitmap, hDC, showAnywhere);
+    }
+}
+
+DirtyRegion::Rect Graphics::UnitBounds(s32 xc, s32 yc)
+{
+    return DirtyRegion::Rect { xc-MaxUnitBounds::Left, yc-MaxUnitBounds::Up, xc+MaxUnitBounds::Right+1, yc+MaxUnitBounds::Down+1 };
+}
+
+bool Graphics::IsLastDrawnView(u16 bitWidth, u16 bitHeight, s32 screenLeft, s32 screenTop, const ChkdBitmap & bitmap)
+{
+    return !displayingElevations && zoomLevel == TileMipmaps::levelFor(map.getZoom()) &&
+        bitWidth == screenWidth && bitHeight == screenHeight && screenLeft == this->screenLeft && screenTop == this->screenTop &&
+        bitmap.size() == size_t(bitWidth)*size_t(bitHeight) && framebuffer.getWidth() == size_t(bitWidth >> zoomLevel) && framebuffer.getHeight() == size_t(bitHeight >> zoomLevel) &&
+        mapWidth == (u16)map.layers.getTileWidth() && mapHeight == (u16)map.layers.getTileHeight();
+}
+
+void Graphics::DrawRegion(const DirtyRegion::Rect & rect)
+{
+    s32 viewLeft = screenLeft, viewTop = screenTop, viewWidth = screenWidth, viewHeight = screenHeight;
+    s32 step = s32(1) << zoomLevel;
+
+    // Zoomed out, rect is widened to whole framebuffer pixels so the region is drawn from the same map pixels a full draw uses
+    s32 reducedLeft = std::max(s32(0), FloorShift(rect.left-viewLeft, zoomLevel)),
+        reducedTop = std::max(s32(0), FloorShift(rect.top-viewTop, zoomLevel)),
+        reducedRight = std::min(s32(framebuffer.getWidth()), FloorShift(rect.right-viewLeft+step-1, zoomLevel)),
+        reducedBottom = std::min(s32(framebuffer.getHeight()), FloorShift(rect.bottom-viewTop+step-1, zoomLevel));
+    if ( reducedLeft >= reducedRight || reducedTop >= reducedBottom )
+        return;
+
+    screenLeft = viewLeft + reducedLeft*step;
+    screenTop = viewTop + reducedTop*step;
+    screenWidth = (reducedRight-reducedLeft)*step;
+    screenHeight = (reducedBottom-reducedTop)*step;
+
+    regionBuffer.resize(size_t(reducedRight-reducedLeft), size_t(reducedBottom-reducedTop));
+    regionBuffer.fill(BlackSlot);
+    DrawTerrain(regionBuffer);
+    DrawGrid(regionBuffer);
+    DrawUnits(regionBuffer);
+    DrawSprites(regionBuffer);
+    framebuffer.blit(regionBuffer, size_t(reducedLeft), size_t(reducedTop));
+
+    screenLeft = viewLeft;
+    screenTop = viewTop;
+    screenWidth = viewWidth;
+    screenHeight = viewHeight;
+}
 
-    BITMAPINFO bmi = GetBMI(screenWidth, screenHeight);
-    SetDIBitsToDevice( hDC, 0, 0, screenWidth, screenHeight, 0, 0, 0,
-                       screenHeight, bitmap.data(), &bmi, DIB_RGB_COLORS);
+s32 Graphics::ReducedX(s32 mapX)
+{
+    return FloorShift(mapX-screenLeft, zoomLevel);
+}
+
+s32 Graphics::ReducedY(s32 mapY)
+{
+    return FloorShift(mapY-screenTop, zoomLevel);
+}
+
+void Graphics::ComposeMap(ChkdBitmap & bitmap, HDC hDC, bool showAnywhere)
+{
+    ChkdBitmap & composed = zoomLevel == 0 ? bitmap : reducedBitmap;
+    if ( zoomLevel > 0 )
+        reducedBitmap.resize(framebuffer.getSlots().size());
+
+    framebuffer.setPalette(palette);
+    framebuffer.compose(composed);
 
     if ( map.getLayer() == Layer::Locations )
-        DrawLocationNames(hDC);
+        DrawLocations(composed, showAnywhere);
 
-    if ( displayingTileNums )
-        DrawTileNumbers(hDC);
+    if ( zoomLevel == 0 )
+    {
+        BITMAPINFO bmi = GetBMI(screenWidth, screenHeight);
+        SetDIBitsToDevice( hDC, 0, 0, screenWidth, screenHeight, 0, 0, 0,
+                           screenHeight, bitmap.data(), &bmi, DIB_RGB_COLORS);
+
+        DrawMapText(hDC);
+    }
+    else // The reduced map is drawn at its own size, it's stretched once to the window size and text is drawn over the stretched map
+    {
+        s32 reducedWidth = s32(framebuffer.getWidth()), reducedHeight = s32(framebuffer.getHeight());
+        BITMAPINFO bmi = GetBMI(reducedWidth, reducedHeight);
+        SetDIBitsToDevice( hDC, 0, 0, reducedWidth, reducedHeight, 0, 0, 0,
+                           reducedHeight, reducedBitmap.data(), &bmi, DIB_RGB_COLORS);
+    }
 }
 
-void Graphics::DrawTerrain(ChkdBitmap & bitmap)
+void Graphics::DrawTerrain(PaletteFramebuffer & target)
 {
     u32 maxRowX, maxRowY;
 
@@ -207,12 +342,28 @@ void Graphics::DrawTerrain(ChkdBitmap & bitmap)
     else
         maxRowX = (screenLeft+screenWidth)/32+1;
 
-    for ( yTile = (u16)(screenTop/32); yTile < maxRowY; yTile++ ) // Cycle through all rows on the screen
+    if ( zoomLevel == 0 )
     {
-        for ( xTile = (u16)(screenLeft/32); xTile < maxRowX; xTile++ ) // Cycle through all columns on the screen
+        for ( yTile = (u16)(screenTop/32); yTile < maxRowY; yTile++ ) // Cycle through all rows on the screen
         {
-            TileToBits(bitmap, palette, tiles, s32(xTile)*32-screenLeft, s32(yTile)*32-screenTop,
-                u16(screenWidth), u16(screenHeight), map.layers.getTile(xTile, yTile));
+            for ( xTile = (u16)(screenLeft/32); xTile < maxRowX; xTile++ ) // Cycle through all columns on the screen
+            {
+                TileToBits(target, BlackSlot, tiles, s32(xTile)*32-screenLeft, s32(yTile)*32-screenTop,
+                    u16(screenWidth), u16(screenHeight), map.layers.getTile(xTile, yTile));
+            }
+        }
+    }
+    else // Zoomed out, draw tiles from images already reduced to the framebuffer's scale
+    {
+        TileMipmaps & mipmaps = tileMipmaps[size_t(tileset) % Sc::Terrain::NumTilesets];
+        mipmaps.setTiles(tiles);
+        for ( yTile = (u16)(screenTop/32); yTile < maxRowY; yTile++ )
+        {
+            for ( xTile = (u16)(screenLeft/32); xTile < maxRowX; xTile++ )
+            {
+                MipmapToBits(target, BlackSlot, mipmaps, zoomLevel, ReducedX(s32(xTile)*32), ReducedY(s32(yTile)*32),
+                    map.layers.getTile(xTile, yTile));
+            }
         }
     }
 }
@@ -246,33 +397,39 @@ void Graphics::DrawTileElevations(ChkdBitmap & bitmap)
     }
 }
 
-void Graphics::DrawGrid(ChkdBitmap & bitmap)
+void Graphics::DrawGrid(PaletteFramebuffer & target)
 {
     u16 gridXSize = 0,
         gridYSize = 0,
         x = 0, y = 0;
 
+    std::vector<PaletteFramebuffer::Slot> & slots = target.getSlots();
+    size_t width = target.getWidth(), height = target.getHeight();
     for ( u32 i=0; i<2; i++ )
     {
         MapGrid currGrid = grids[i];
         gridXSize = currGrid.size.x;
         gridYSize = currGrid.size.y;
 
+        PaletteFramebuffer::Slot gridSlot = PaletteFramebuffer::Slot(FirstGridSlot+i);
+        framebuffer.setFixedColor(gridSlot, currGrid.color);
+
         if ( gridXSize > 0 )
         {
-            for ( x = gridXSize-(screenLeft%gridXSize); x < screenWidth; x += gridXSize ) // Draw vertical lines
+            for ( x = (gridXSize-(screenLeft%gridXSize))%gridXSize; x < screenWidth; x += gridXSize ) // Draw vertical lines
             {
-                for ( y = 0; y < screenHeight; y++ )
-                    bitmap[y*screenWidth + x] = currGrid.color;
+                size_t column = size_t(ReducedX(screenLeft+x));
+                for ( size_t row = 0; row < height; row++ )
+                    slots[row*width + column] = gridSlot;
             }
         }
             
         if ( gridYSize > 0 )
         {
-            for ( y = gridYSize-(screenTop%gridYSize); y < screenHeight; y += gridYSize )
+            for ( y = (gridYSize-(screenTop%gridYSize))%gridYSize; y < screenHeight; y += gridYSize ) // Draw horizontal lines
             {
-                for ( x = 0; x < screenWidth; x++ )
-                    bitmap[y*screenWidth + x] = currGrid.color;
+                size_t row = size_t(ReducedY(screenTop+y));
+                std::fill_n(slots.begin()+row*width, width, gridSlot);
             }
         }
     }
@@ -280,11 +437,12 @@ void Graphics::DrawGrid(ChkdBitmap & bitmap)
 
 void Graphics::DrawLocations(ChkdBitmap & bitmap, bool showAnywhere)
 {
-    u32 bitMax = screenWidth*screenHeight;
+    s32 bitmapWidth = s32(framebuffer.getWidth()), // Locations are drawn over the composed framebuffer, which is reduced when zoomed out
+        bitmapHeight = s32(framebuffer.getHeight());
 
     for ( size_t locationId = 1; locationId <= map.layers.numLocations(); locationId++ )
     {
-        const auto location = map.layers.getLocation(locationId);
+        const auto location = static_cast<const Layers &>(map.layers).getLocation(locationId); // Drawing doesn't count as a location change
         if ( (locationId != Chk::LocationId::Anywhere || showAnywhere) && location != nullptr )
         {
             
@@ -327,30 +485,30 @@ void Graphics::DrawLocations(ChkdBitmap & bitmap, bool showAnywhere)
                                 bottomMostOnScreen = false;
                             }
 
-                            leftMost -= screenLeft;
-                            rightMost -= screenLeft;
-                            topMost -= screenTop;
-                            bottomMost -= screenTop;
+                            leftMost = ReducedX(leftMost);
+                            rightMost = ReducedX(rightMost);
+                            topMost = ReducedY(topMost);
+                            bottomMost = ReducedY(bottomMost);
 
                             if ( leftMostOnScreen )
                             {
                                 for ( s32 y = topMost; y < bottomMost; y++ )
-                                    bitmap[y*screenWidth + leftMost] = black;
+                                    bitmap[y*bitmapWidth + leftMost] = black;
                             }
                             if ( rightMostOnScreen )
                             {
                                 for ( s32 y = topMost; y < bottomMost; y++ )
-                                    bitmap[y*screenWidth + rightMost] = black;
+                                    bitmap[y*bitmapWidth + rightMost] = black;
                             }
                             if ( topMostOnScreen )
                             {
                                 for ( s32 x = leftMost; x < rightMost; x++ )
-                                    bitmap[topMost*screenWidth + x] = black;
+                                    bitmap[topMost*bitmapWidth + x] = black;
                             }
                             if ( bottomMostOnScreen )
                             {
                                 for ( s32 x = leftMost; x < rightMost; x++ )
-                                    bitmap[bottomMost*screenWidth + x] = black;
+                                    bitmap[bottomMost*bitmapWidth + x] = black;
                             }
 
                             if ( inverted )
@@ -360,7 +518,7 @@ void Graphics::DrawLocations(ChkdBitmap & bitmap, bool showAnywhere)
                                 for ( s32 y = topMost; y<bottomMost; y++ )
                                 {
                                     for ( s32 x = leftMost; x<rightMost; x++ )
-                                        BoundedAdjustPx(bitmap[y*screenWidth + x], 20, -10, -10);
+                                        BoundedAdjustPx(bitmap[y*bitmapWidth + x], 20, -10, -10);
                                 }
                             }
                             else
@@ -369,7 +527,7 @@ void Graphics::DrawLocations(ChkdBitmap & bitmap, bool showAnywhere)
                                 for ( s32 y = topMost; y<bottomMost; y++ )
                                 {
                                     for ( s32 x = leftMost; x<rightMost; x++ )
-                                        BoundedAdjustPx(bitmap[y*screenWidth + x], -10, 10, 15);
+                                        BoundedAdjustPx(bitmap[y*bitmapWidth + x], -10, 10, 15);
                                 }
                             }
                         }
@@ -382,7 +540,7 @@ void Graphics::DrawLocations(ChkdBitmap & bitmap, bool showAnywhere)
     u16 selectedLoc = selections.getSelectedLocation();
     if ( selectedLoc != NO_LOCATION )
     {
-        const Chk::LocationPtr loc = map.layers.getLocation(selectedLoc);
+        const Chk::LocationPtr loc = static_cast<const Layers &>(map.layers).getLocation(selectedLoc);
         if ( loc != nullptr )
         {
             s32 leftMost = std::min(loc->left, loc->right);
@@ -399,49 +557,49 @@ void Graphics::DrawLocations(ChkdBitmap & bitmap, bool showAnywhere)
                 if ( !leftMostOnScreen )
                     leftMost = 0;
                 else
-                    leftMost -= screenLeft;
+                    leftMost = ReducedX(leftMost);
 
                 if ( !rightMostOnScreen )
-                    rightMost = screenWidth;
+                    rightMost = bitmapWidth;
                 else
-                    rightMost -= screenLeft;
+                    rightMost = ReducedX(rightMost);
 
                 if ( !topMostOnScreen )
                     topMost = 0;
                 else
-                    topMost -= screenTop;
+                    topMost = ReducedY(topMost);
 
                 if ( !bottomMostOnScreen )
-                    bottomMost = screenHeight;
+                    bottomMost = bitmapHeight;
                 else
-                    bottomMost -= screenTop;
+                    bottomMost = ReducedY(bottomMost);
 
                 if ( leftMostOnScreen )
                 {
                     for ( s32 y = topMost; y < bottomMost; y++ )
-                        bitmap[y*screenWidth + leftMost] = Sc::SystemColor(255, 255, 255);
+                        bitmap[y*bitmapWidth + leftMost] = Sc::SystemColor(255, 255, 255);
                 }
                 if ( rightMostOnScreen )
                 {
                     for ( s32 y = topMost; y < bottomMost; y++ )
-                        bitmap[y*screenWidth + rightMost] = Sc::SystemColor(255, 255, 255);
+                        bitmap[y*bitmapWidth + rightMost] = Sc::SystemColor(255, 255, 255);
                 }
                 if ( topMostOnScreen )
                 {
                     for ( s32 x = leftMost; x < rightMost; x++ )
-                        bitmap[topMost*screenWidth + x] = Sc::SystemColor(255, 255, 255);
+                        bitmap[topMost*bitmapWidth + x] = Sc::SystemColor(255, 255, 255);
                 }
                 if ( bottomMostOnScreen )
                 {
                     for ( s32 x = leftMost; x < rightMost; x++ )
-                        bitmap[bottomMost*screenWidth + x] = Sc::SystemColor(255, 255, 255);
+                        bitmap[bottomMost*bitmapWidth + x] = Sc::SystemColor(255, 255, 255);
                 }
             }
         }
     }
 }
 
-void Graphics::DrawUnits(ChkdBitmap & bitmap)
+void Graphics::DrawUnits(PaletteFramebuffer & target)
 {
     s32 screenRight = screenLeft+screenWidth,
         screenBottom = screenTop+screenHeight;
@@ -465,15 +623,18 @@ void Graphics::DrawUnits(ChkdBitmap & bitmap)
 
                 bool isSelected = selections.unitIsSelected(unitNum);
 
-                UnitToBits(bitmap, palette, color, u16(screenWidth), u16(screenHeight),
-                    screenLeft, screenTop, (u16)unit->type, unit->xc, unit->yc,
-                    u16(frame), isSelected);
+                if ( zoomLevel > 0 )
+                    DrawReduced(target, playerColorSlots[color%16], (u16)unit->type, unit->xc, unit->yc, false, isSelected);
+                else
+                    UnitToBits(target, playerColorSlots[color%16], selectionSlots, u16(screenWidth), u16(screenHeight),
+                        screenLeft, screenTop, (u16)unit->type, unit->xc, unit->yc,
+                        u16(frame), isSelected);
             }
         }
     }
 }
 
-void Graphics::DrawSprites(ChkdBitmap & bitmap)
+void Graphics::DrawSprites(PaletteFramebuffer & target)
 {
     s32 screenRight = screenLeft + screenWidth,
         screenBottom = screenTop + screenHeight;
@@ -496,11 +657,13 @@ void Graphics::DrawSprites(ChkdBitmap & bitmap)
                 Chk::PlayerColor color = (sprite->owner < Sc::Player::TotalSlots ?
                     map.players.getPlayerColor(sprite->owner) : (Chk::PlayerColor)sprite->owner);
 
-                if ( isSprite )
-                    SpriteToBits(bitmap, palette, color, u16(screenWidth), u16(screenHeight),
+                if ( zoomLevel > 0 )
+                    DrawReduced(target, playerColorSlots[color%16], (u16)sprite->type, sprite->xc, sprite->yc, isSprite, false);
+                else if ( isSprite )
+                    SpriteToBits(target, playerColorSlots[color%16], u16(screenWidth), u16(screenHeight),
                         screenLeft, screenTop, (u16)sprite->type, sprite->xc, sprite->yc);
                 else
-                    UnitToBits(bitmap, palette, color, u16(screenWidth), u16(screenHeight),
+                    UnitToBits(target, playerColorSlots[color%16], selectionSlots, u16(screenWidth), u16(screenHeight),
                         screenLeft, screenTop, (u16)sprite->type, sprite->xc, sprite->yc,
                         frame, false);
             }
@@ -508,6 +671,23 @@ void Graphics::DrawSprites(ChkdBitmap & bitmap)
     }
 }
 
+void Graphics::DrawReduced(PaletteFramebuffer & target, const PaletteFramebuffer::SlotMap & colorSlots, u16 type, u16 xc, u16 yc, bool isSprite, bool isSelected)
+{
+    s32 step = s32(1) << zoomLevel;
+    DirtyRegion::Rect bounds = UnitBounds(s32(xc), s32(yc));
+    s32 left = screenLeft + FloorShift(bounds.left-screenLeft, zoomLevel)*step, // Aligned so the pixels kept fall on the framebuffer's pixels
+        top = screenTop + FloorShift(bounds.top-screenTop, zoomLevel)*step;
+
+    spriteBuffer.resize(size_t(bounds.right-left), size_t(bounds.bottom-top));
+    spriteBuffer.fill(PaletteFramebuffer::Transparent);
+    if ( isSprite )
+        SpriteToBits(spriteBuffer, colorSlots, u16(spriteBuffer.getWidth()), u16(spriteBuffer.getHeight()), left, top, type, xc, yc);
+    else
+        UnitToBits(spriteBuffer, colorSlots, selectionSlots, u16(spriteBuffer.getWidth()), u16(spriteBuffer.getHeight()), left, top, type, xc, yc, 0, isSelected);
+
+    target.blitReduced(spriteBuffer, ReducedX(left), ReducedY(top), zoomLevel);
+}
+
 void Graphics::DrawLocationNames(HDC hDC)
 {
     s32 screenRight = screenLeft + screenWidth;
@@ -521,7 +701,7 @@ void Graphics::DrawLocationNames(HDC hDC)
 
     for ( size_t locationId = 1; locationId <= map.layers.numLocations(); locationId++ )
     {
-        const auto location = map.layers.getLocation(locationId);
+        const auto location = static_cast<const Layers &>(map.layers).getLocation(locationId); // Drawing doesn't count as a location change
         if ( locationId != Chk::LocationId::Anywhere && location != nullptr )
         {
             s32 leftMost = std::min(location->left, location->right);
@@ -635,6 +815,20 @@ void Graphics::DrawTileNumbers(HDC hDC)
     }
 }
 
+void Graphics::DrawMapText(HDC hDC)
+{
+    if ( map.getLayer() == Layer::Locations )
+        DrawLocationNames(hDC);
+
+    if ( displayingTileNums )
+        DrawTileNumbers(hDC);
+}
+
+u8 Graphics::GetZoomLevel()
+{
+    return zoomLevel;
+}
+
 void Graphics::ToggleTileNumSource(bool MTXMoverTILE)
 {
     if ( !( displayingTileNums && tileNumsFromMTXM != MTXMoverTILE ) )
@@ -844,7 +1038,8 @@ void TileElevationsToBits(ChkdBitmap & bitmap, s64 bitWidth, s64 bitHeight, cons
     }
 }
 
-void GrpToBits(ChkdBitmap & bitmap, ChkdPalette & palette, s64 bitWidth, s64 bitHeight, s64 xStart, s64 yStart,
+template <typename Pixels, typename Colors> // Pixels may be a ChkdBitmap with a ChkdPalette, or framebuffer slots with a SlotMap
+void GrpToBits(Pixels & bitmap, const Colors & palette, s64 bitWidth, s64 bitHeight, s64 xStart, s64 yStart,
                const Sc::Sprite::GrpFile & grpFile, s64 grpXc, s64 grpYc, u16 frame, u8 color, bool flipped)
 {
     if ( frame < grpFile.numFrames )
@@ -965,19 +1160,40 @@ void UnitToBits(ChkdBitmap & bitmap, ChkdPalette & palette, u8 color, u16 bitWid
     }
 }
 
-void SpriteToBits(ChkdBitmap & bitmap, ChkdPalette & palette, u8 color, u16 bitWidth, u16 bitHeight,
+void UnitToBits(PaletteFramebuffer & framebuffer, const PaletteFramebuffer::SlotMap & colorSlots, const PaletteFramebuffer::SlotMap & selectionSlots,
+                 u16 bitWidth, u16 bitHeight, s32 & xStart, s32 & yStart, u16 unitID, u16 unitXC, u16 unitYC, u16 frame, bool selected )
+{
+    Sc::Unit::Type drawnUnitId = unitID < 228 ? (Sc::Unit::Type)unitID : Sc::Unit::Type::TerranMarine; // Extended units use ID:0's graphics (for now)
+    u32 grpId = chkd.scData.sprites.getImage(chkd.scData.sprites.getSprite(chkd.scData.units.getFlingy(chkd.scData.units.getUnit(drawnUnitId).graphics).sprite).imageFile).grpFile;
+
+    if ( (size_t)grpId < chkd.scData.sprites.numGrps() )
+    {
+        if ( selected )
+        {
+            u32 selectionGrpId = chkd.scData.sprites.getImage(chkd.scData.sprites.getSprite(chkd.scData.units.getFlingy(chkd.scData.units.getUnit(drawnUnitId).graphics).sprite).selectionCircleImage+561).grpFile;
+            if ( selectionGrpId < chkd.scData.sprites.numGrps() )
+            {
+                const Sc::Sprite::GrpFile & selCirc = chkd.scData.sprites.getGrp(selectionGrpId).get();
+                u16 offsetY = unitYC + chkd.scData.sprites.getSprite(chkd.scData.units.getFlingy(chkd.scData.units.getUnit(drawnUnitId).graphics).sprite).selectionCircleOffset;
+                GrpToBits(framebuffer.getSlots(), selectionSlots, bitWidth, bitHeight, xStart, yStart, selCirc, unitXC, offsetY, frame, 0, false);
+            }
+        }
+        
+        const Sc::Sprite::GrpFile & curr = chkd.scData.sprites.getGrp(grpId).get();
+        GrpToBits(framebuffer.getSlots(), colorSlots, bitWidth, bitHeight, xStart, yStart, curr, unitXC, unitYC, frame, 0, false);
+    }
+}
+
+void SpriteToBits(PaletteFramebuffer & framebuffer, const PaletteFramebuffer::SlotMap & colorSlots, u16 bitWidth, u16 bitHeight,
                    s32 & xStart, s32 & yStart, u16 spriteID, u16 spriteXC, u16 spriteYC )
 {
     const Sc::Sprite::GrpFile & curr = chkd.scData.sprites.getGrp(chkd.scData.sprites.getImage(chkd.scData.sprites.getSprite(spriteID).imageFile).grpFile).get();
-    Sc::SystemColor remapped[8];
-    std::memcpy(remapped, &palette[8], sizeof(remapped));
-    std::memcpy(&palette[8], &chkd.scData.tunit.palette[color < 16 ? 8*color : 8*(color%16)], sizeof(remapped));
-    GrpToBits(bitmap, palette, bitWidth, bitHeight, xStart, yStart, curr, spriteXC, spriteYC, 0, color, false);
-    std::memcpy(&palette[8], remapped, sizeof(remapped));
+    GrpToBits(framebuffer.getSlots(), colorSlots, bitWidth, bitHeight, xStart, yStart, curr, spriteXC, spriteYC, 0, 0, false);
 }
 
-void TileToBits(ChkdBitmap & bitmap, ChkdPalette & palette, const Sc::Terrain::Tiles & tiles, s64 xStart, s64 yStart, s64 width, s64 height, u16 TileValue)
+void TileToBits(PaletteFramebuffer & framebuffer, PaletteFramebuffer::Slot blackSlot, const Sc::Terrain::Tiles & tiles, s64 xStart, s64 yStart, s64 width, s64 height, u16 TileValue)
 {
+    std::vector<PaletteFramebuffer::Slot> & slots = framebuffer.getSlots();
     size_t groupIndex = Sc::Terrain::Tiles::getGroupIndex(TileValue);
     if ( groupIndex < tiles.tileGroups.size() )
     {
@@ -1002,7 +1218,7 @@ void TileToBits(ChkdBitmap & bitmap, ChkdPalette & palette, const Sc::Terrain::T
                     {
                         const Sc::Terrain::MiniTilePixels & miniTilePixels = tiles.miniTilePixels[vr4Index];
                         const u8 & wpeIndex = miniTilePixels.wpeIndex[yMiniPixel][flipped ? 7-xMiniPixel : xMiniPixel];
-                        bitmap[(yMiniOffset+yMiniPixel)*width + (xMiniOffset+xMiniPixel)] = palette[wpeIndex];
+                        slots[(yMiniOffset+yMiniPixel)*width + (xMiniOffset+xMiniPixel)] = PaletteFramebuffer::Slot(wpeIndex);
                     }
                 }
             }
@@ -1015,11 +1231,29 @@ void TileToBits(ChkdBitmap & bitmap, ChkdPalette & palette, const Sc::Terrain::T
         for ( s64 yc = yStart; yc < yEnd; yc++ )
         {
             for ( s64 xc = xStart; xc < xEnd; xc++ )
-                bitmap[yc*width + xc] = black;
+                slots[yc*width + xc] = blackSlot;
         }
     }
 }
 
+void MipmapToBits(PaletteFramebuffer & framebuffer, PaletteFramebuffer::Slot blackSlot, TileMipmaps & mipmaps, u8 level, s64 xStart, s64 yStart, u16 tileValue)
+{
+    std::vector<PaletteFramebuffer::Slot> & slots = framebuffer.getSlots();
+    s64 width = s64(framebuffer.getWidth()),
+        height = s64(framebuffer.getHeight()),
+        tileSize = s64(TileMipmaps::tileSize(level));
+
+    s64 xEnd = std::min(xStart + tileSize, width),
+        yEnd = std::min(yStart + tileSize, height);
+
+    const u8* image = mipmaps.get(tileValue, level);
+    for ( s64 y = std::max(yStart, s64(0)); y < yEnd; y++ )
+    {
+        for ( s64 x = std::max(xStart, s64(0)); x < xEnd; x++ )
+            slots[y*width + x] = image != nullptr ? PaletteFramebuffer::Slot(image[(y-yStart)*tileSize + (x-xStart)]) : blackSlot; // Black if no CV5 reference
+    }
+}
+
 void DrawMiniTileElevation(HDC hDC, const Sc::Terrain::Tiles & tiles, s64 xOffset, s64 yOffset, u16 tileValue, s64 miniTileX, s64 miniTileY, BITMAPINFO & bmi)
 {
     ChkdBitmap graphicBits;
@@ -1126,7 +1360,7 @@ void DrawTile(HDC hDC, ChkdPalette & palette, const Sc::Terrain::Tiles & tiles,
                 }
             }
         }
-        SetDIBitsToDevice(hDC, xOffset, yOffset, 32, 32, 0, 0, 0, 32, &graphicBits[0], &bmi, DIB_RGB_COLORS);
+        StretchDIBits(hDC, xOffset, yOffset, 32, 32, 0, 0, 32, 32, &graphicBits[0], &bmi, DIB_RGB_COLORS, SRCCOPY); // Scaled if hDC maps map pixels to a zoomed out view
     }
 }
 
@@ -1287,6 +1521,17 @@ void DrawPasteGraphics( HDC hDC, HBITMAP bitmap, ChkdPalette & palette, u16 widt
     }
     else if ( layer == Layer::Units )
     {
+        HDC scaledDc = NULL;
+        if ( GetMapMode(hDC) != MM_TEXT ) // hDC maps map pixels to a zoomed out view, unit graphics are drawn to map pixels then scaled back
+        {
+            scaledDc = hDC;
+            hDC = CreateCompatibleDC(scaledDc);
+            bitmap = CreateCompatibleBitmap(scaledDc, width, height);
+            SelectObject(hDC, bitmap);
+            SetStretchBltMode(hDC, COLORONCOLOR);
+            StretchBlt(hDC, 0, 0, width, height, scaledDc, 0, 0, width, height, SRCCOPY);
+        }
+
         ChkdBitmap graphicBits;
         graphicBits.resize(((size_t)width)*((size_t)height));
 
@@ -1316,6 +1561,14 @@ void DrawPasteGraphics( HDC hDC, HBITMAP bitmap, ChkdPalette & palette, u16 widt
 
         SetDIBitsToDevice( hDC, 0, 0, width, height, 0, 0, 0,
                            height, &graphicBits[0], &bmi, DIB_RGB_COLORS);
+
+        if ( scaledDc != NULL )
+        {
+            SetStretchBltMode(scaledDc, COLORONCOLOR);
+            StretchBlt(scaledDc, 0, 0, width, height, hDC, 0, 0, width, height, SRCCOPY);
+            DeleteDC(hDC);
+            DeleteObject(bitmap);
+        }
     }
 }
 
@@ -1334,7 +1587,7 @@ void DrawTempLocs(HDC hDC, u32 screenLeft, u32 screenTop, Selections & selection
     else
     {
         u16 selectedLocation = selections.getSelectedLocation();
-        const Chk::LocationPtr loc = selectedLocation != NO_LOCATION ? map.layers.getLocation((size_t)selectedLocation) : nullptr;
+        const Chk::LocationPtr loc = selectedLocation != NO_LOCATION ? static_cast<const Layers &>(map.layers).getLocation((size_t)selectedLocation) : nullptr;
         if ( loc != nullptr ) // Draw location resize/movement graphics
         {
             s32 locLeft = loc->left-screenLeft;
@@ -1449,108 +1702,14 @@ void DrawLocationFrame(HDC hDC, s32 left, s32 top, s32 right, s32 bottom)
     DeleteObject(brush);
 }
 
-void DrawMiniMapTiles(ChkdBitmap & bitmap, const ChkdPalette & palette, s64 bitWidth, s64 bitHeight, s64 xSize, s64 ySize,
-                       s64 xOffset, s64 yOffset, float scale, const Sc::Terrain::Tiles & tiles, GuiMap & map )
+void DrawMiniMap(HDC hDC, const MiniMapRaster & miniMap)
 {
-    for ( s64 yc=0; yc<128-2*yOffset; yc++ ) // Cycle through all minimap pixel rows
-    {
-        s64 yMiniTile = 0;
-        s64 yTile = (s64)(yc/scale); // Get the yc of tile used for the pixel
-        if ( scale > 1 )
-        {
-            yMiniTile = yc%(int)scale; // Get the y-minitile used for the pixel
-            if ( yMiniTile > 3 )
-                yMiniTile %= 4; // Correct for invalid y-minitiles
-        }
-    
-        for ( s64 xc=0; xc<128-2*xOffset; xc++ ) // Cycle through all minimap pixel columns
-        {
-            s64 xMiniTile = 0;
-            s64 xTile = (s64)(xc/scale); // Get the xc of the tile used for the pixel
-            if ( scale > 1 )
-            {
-                xMiniTile = xc%(int)scale; // Get the x-minitile used for the pixel
-                if ( xMiniTile > 3 )
-                    xMiniTile %= 4; // Correct for invalid x-minitiles
-            }
-
-            u16 tileIndex = map.layers.getTile(xTile, yTile);
-            size_t groupIndex = Sc::Terrain::Tiles::getGroupIndex(tileIndex);
-            if ( groupIndex < tiles.tileGroups.size() )
-            {
-                const Sc::Terrain::TileGroup & tileGroup = tiles.tileGroups[groupIndex];
-                const u16 & megaTileIndex = tileGroup.megaTileIndex[tiles.getGroupMemberIndex(tileIndex)];
-                const Sc::Terrain::TileGraphics & tileGraphics = tiles.tileGraphics[megaTileIndex];
-
-                const size_t vr4Index = size_t(tileGraphics.miniTileGraphics[yMiniTile][xMiniTile].vr4Index());
-                const Sc::Terrain::MiniTilePixels & miniTilePixels = tiles.miniTilePixels[vr4Index];
-                const u8 & wpeIndex = miniTilePixels.wpeIndex[6][7];
-                
-                bitmap[(yc + yOffset) * 128 + xc + xOffset] = palette[wpeIndex];
-            }
-        }
-    }
-}
-
-#define MINI_MAP_MAXBIT 65536 // Maximum graphicBits position
-
-void DrawMiniMapUnits(ChkdBitmap & bitmap, u16 bitWidth, u16 bitHeight, u16 xSize, u16 ySize,
-                       u16 xOffset, u16 yOffset, float scale, const Sc::Terrain::Tiles & tiles, GuiMap & map )
-{
-    for ( u16 i = 0; i < map.layers.numUnits(); i++ )
-    {
-        Chk::UnitPtr unit = map.layers.getUnit(i);
-
-        Chk::PlayerColor color = (unit->owner < Sc::Player::TotalSlots ?
-            map.players.getPlayerColor(unit->owner) : (Chk::PlayerColor)unit->owner);
-
-        if ( color > Chk::TotalColors )
-            color = Chk::PlayerColor(color % Chk::TotalColors);
-
-        u32 bitIndex = (
-            ((u32)((unit->yc / 32)*scale) + yOffset) * 128
-            + (u32)((unit->xc / 32)*scale) + xOffset
-            );
+    BITMAPINFO bmi = GetBMI(MiniMapRaster::Width, MiniMapRaster::Height);
 
-        if ( bitIndex < MINI_MAP_MAXBIT )
-            bitmap[bitIndex] = chkd.scData.tminimap.palette[color];
-    }
-
-    for ( size_t i = 0; i < map.layers.numSprites(); i++ )
-    {
-        Chk::SpritePtr sprite = map.layers.getSprite(i);
-        if ( sprite->isDrawnAsSprite() )
-        {
-            Chk::PlayerColor color = (sprite->owner < Sc::Player::TotalSlots ?
-                map.players.getPlayerColor(sprite->owner) : Chk::PlayerColor(sprite->owner%16));
-
-            if ( color > 16 )
-                color = Chk::PlayerColor(color % 16);
-
-            u32 bitIndex = (((u32)((sprite->yc / 32)*scale) + yOffset) * 128
-                + (u32)((sprite->xc / 32)*scale) + xOffset);
-
-            if ( bitIndex < MINI_MAP_MAXBIT )
-                bitmap[bitIndex] = chkd.scData.tminimap.palette[color];
-        }
-    }
-}
+    u16 xOffset = (u16)miniMap.getXOffset(),
+        yOffset = (u16)miniMap.getYOffset();
 
-void DrawMiniMap(HDC hDC, const ChkdPalette & palette, u16 xSize, u16 ySize, float scale, GuiMap & map)
-{
-    ChkdBitmap graphicBits;
-    graphicBits.resize(65536);
-
-    BITMAPINFO bmi = GetBMI(128, 128);
-
-    u16 xOffset = (u16)((128-xSize*scale)/2),
-        yOffset = (u16)((128-ySize*scale)/2);
-    
-    Sc::Terrain::Tileset tileset = map.layers.getTileset();
-    const Sc::Terrain::Tiles & tiles = chkd.scData.terrain.get(tileset);
-    DrawMiniMapTiles(graphicBits, palette, 128, 128, xSize, ySize, xOffset, yOffset, scale, tiles, map);
-    DrawMiniMapUnits(graphicBits, 128, 128, xSize, ySize, xOffset, yOffset, scale, tiles, map);
-    SetDIBitsToDevice(hDC, xOffset, yOffset, 128-2*xOffset, 128-2*yOffset, xOffset, yOffset, 0, 128, &graphicBits[0], &bmi, DIB_RGB_COLORS);
+    SetDIBitsToDevice(hDC, xOffset, yOffset, 128-2*xOffset, 128-2*yOffset, xOffset, yOffset, 0, 128, miniMap.getBitmap().data(), &bmi, DIB_RGB_COLORS);
 
     // Draw Map Borders
 
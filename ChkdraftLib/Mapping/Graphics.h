@@ -80,14 +80,29 @@ class Graphics
 
         void DrawMap(u16 bitWidth, u16 bitHeight, s32 screenLeft, s32 screenTop, ChkdBitmap & bitmap, HDC hDC, bool showAnywhere);
 
-        void DrawTerrain(ChkdBitmap & bitmap);
+        /** Recomposes the last map drawn using the current palette (e.g. after colors cycle) without redrawing terrain,
+            units or sprites; falls back to DrawMap if the last map drawn can't be recomposed */
+        void RecolorMap(u16 bitWidth, u16 bitHeight, s32 screenLeft, s32 screenTop, ChkdBitmap & bitmap, HDC hDC, bool showAnywhere);
+
+        /** Redraws only the parts of the last map drawn within dirtyRegion (in map pixels) then recomposes the map;
+            falls back to DrawMap if the whole region is dirty or the last map drawn can't be partially redrawn */
+        void DrawMapRegions(const DirtyRegion & dirtyRegion, u16 bitWidth, u16 bitHeight, s32 screenLeft, s32 screenTop, ChkdBitmap & bitmap, HDC hDC, bool showAnywhere);
+
+        static DirtyRegion::Rect UnitBounds(s32 xc, s32 yc); // The area (in map pixels) a unit or sprite at xc, yc may be drawn within
+
+        void DrawTerrain(PaletteFramebuffer & target);
         void DrawTileElevations(ChkdBitmap & bitmap);
-        void DrawGrid(ChkdBitmap & bitmap);
+        void DrawGrid(PaletteFramebuffer & target);
         void DrawLocations(ChkdBitmap & bitmap, bool showAnywhere);
-        void DrawUnits(ChkdBitmap & bitmap);
-        void DrawSprites(ChkdBitmap & bitmap);
+        void DrawUnits(PaletteFramebuffer & target);
+        void DrawSprites(PaletteFramebuffer & target);
         void DrawLocationNames(HDC hDC);
         void DrawTileNumbers(HDC hDC);
+        void DrawMapText(HDC hDC); // Draws location names and tile numbers if they're showing, in map pixels from the screen's top left
+
+        /** The mipmap level the last map was drawn at; above zero the map drawn to hDC is the reduced map at its own size in the top left,
+            (mapWidth >> level) by (mapHeight >> level), to be stretched to the window once with text and tools drawn over it (DrawMapText) */
+        u8 GetZoomLevel();
 
         void AdjustSize(u32 newWidth, u32 newHeight); // Updates pane size and first and last sprite nodes
         void AdjustPosition(u32 newX, u32 newY); // Updates first and last sprite nodes
@@ -121,6 +136,14 @@ class Graphics
         GuiMap & map; // Reference to the map this instance of graphics renders
         Selections & selections; // Reference to the selections belonging to the corresponding map
         ChkdPalette palette;
+        PaletteFramebuffer framebuffer; // Slots for the terrain, grid, units and sprites last drawn, composed into the bitmap with the palette
+        std::array<PaletteFramebuffer::SlotMap, 16> playerColorSlots; // Slot maps that remap palette indexes 8-15 to each player color
+        PaletteFramebuffer::SlotMap selectionSlots; // Slot map that remaps palette indexes 0-7 to selection circle colors
+        PaletteFramebuffer regionBuffer; // Slots for a dirty region being redrawn, copied into framebuffer once drawn
+        PaletteFramebuffer spriteBuffer; // Slots for a unit or sprite drawn at full scale before being reduced into a zoomed out framebuffer
+        ChkdBitmap reducedBitmap; // The composed framebuffer when zoomed out, drawn at its own size
+        u8 zoomLevel; // The mipmap level the framebuffer was drawn at, the framebuffer is (1 << zoomLevel) times smaller than the screen each way
+        static std::array<TileMipmaps, Sc::Terrain::NumTilesets> tileMipmaps; // Reduced tile images shared by all maps, built as zoomed out views need them
 
         s32 screenLeft; // X-Position of the screens left edge in the map
         s32 screenTop; // Y-Position of the screens top edge in the map
@@ -136,6 +159,14 @@ class Graphics
         bool clipLocationNames; // Determines whether the locationName can be drawn partly outside locations
 
         // Utility Methods...
+        void ComposeMap(ChkdBitmap & bitmap, HDC hDC, bool showAnywhere); // Composes the framebuffer into bitmap, adds locations, and draws to hDC with text if not zoomed out
+        bool IsLastDrawnView(u16 bitWidth, u16 bitHeight, s32 screenLeft, s32 screenTop, const ChkdBitmap & bitmap); // Whether the framebuffer holds this view
+        void DrawRegion(const DirtyRegion::Rect & rect); // Redraws the framebuffer within rect (in map pixels, inside the current view), zoomed out rect is widened to whole framebuffer pixels
+        s32 ReducedX(s32 mapX); // The framebuffer column that map pixel column mapX is drawn in at the current zoom level
+        s32 ReducedY(s32 mapY); // The framebuffer row that map pixel row mapY is drawn in at the current zoom level
+
+        /** Draws a unit or sprite at full scale into spriteBuffer then reduces it into target, a framebuffer drawn at the current zoom level */
+        void DrawReduced(PaletteFramebuffer & target, const PaletteFramebuffer::SlotMap & colorSlots, u16 type, u16 xc, u16 yc, bool isSprite, bool isSelected);
 };
 
 BITMAPINFO GetBMI(s32 width, s32 height);
@@ -143,10 +174,15 @@ BITMAPINFO GetBMI(s32 width, s32 height);
 void UnitToBits(ChkdBitmap & bitmap, ChkdPalette & palette, u8 color, u16 bitWidth, u16 bitHeight,
                  s32 & xStart, s32 & yStart, u16 unitID, u16 unitXC, u16 unitYC, u16 frame, bool selected );
 
-void SpriteToBits(ChkdBitmap & bitmap, ChkdPalette & palette, u8 color, u16 bitWidth, u16 bitHeight,
+void UnitToBits(PaletteFramebuffer & framebuffer, const PaletteFramebuffer::SlotMap & colorSlots, const PaletteFramebuffer::SlotMap & selectionSlots,
+                 u16 bitWidth, u16 bitHeight, s32 & xStart, s32 & yStart, u16 unitID, u16 unitXC, u16 unitYC, u16 frame, bool selected );
+
+void SpriteToBits(PaletteFramebuffer & framebuffer, const PaletteFramebuffer::SlotMap & colorSlots, u16 bitWidth, u16 bitHeight,
                    s32 & xStart, s32 & yStart, u16 spriteID, u16 spriteXC, u16 spriteYC );
 
-void TileToBits(ChkdBitmap & bitmap, ChkdPalette & palette, const Sc::Terrain::Tiles & tiles, s64 xStart, s64 yStart, s64 width, s64 height, u16 TileValue);
+void TileToBits(PaletteFramebuffer & framebuffer, PaletteFramebuffer::Slot blackSlot, const Sc::Terrain::Tiles & tiles, s64 xStart, s64 yStart, s64 width, s64 height, u16 TileValue);
+
+void MipmapToBits(PaletteFramebuffer & framebuffer, PaletteFramebuffer::Slot blackSlot, TileMipmaps & mipmaps, u8 level, s64 xStart, s64 yStart, u16 tileValue);
 
 void DrawMiniTileElevation(HDC hDC, const Sc::Terrain::Tiles & tiles, s64 xOffset, s64 yOffset, u16 tileValue, s64 miniTileX, s64 miniTileY, BITMAPINFO & bmi);
 
@@ -172,7 +208,7 @@ void DrawSelectingFrame(HDC hDC, Selections & selections, u32 screenLeft, u32 sc
 
 void DrawLocationFrame(HDC hDC, s32 left, s32 top, s32 right, s32 bottom);
 
-void DrawMiniMap(HDC hDC, const ChkdPalette & palette, u16 xSize, u16 ySize, float scale, GuiMap & map);
+void DrawMiniMap(HDC hDC, const MiniMapRaster & miniMap);
 
 void DrawMiniMapBox(HDC hDC, u32 screenLeft, u32 screenTop, u16 screenWidth, u16 screenHeight, u16 xSize, u16 ySize, float scale);
 
@@ -220,15 +220,12 @@ void Selections::selectLocation(s32 clickX, s32 clickY, bool canSelectAnywhere)
 
 void Selections::addUnit(u16 index)
 {
-    if ( !unitIsSelected(index) )
-        selUnits.insert(selUnits.begin(), index);
+    selUnits.add(index);
 }
 
 void Selections::removeUnit(u16 index)
 {
-    auto toErase = std::find(selUnits.begin(), selUnits.end(), index);
-    if ( toErase != selUnits.end() )
-        selUnits.erase(toErase);
+    selUnits.remove(index);
 }
 
 void Selections::removeUnits()
@@ -238,67 +235,47 @@ void Selections::removeUnits()
 
 void Selections::ensureFirst(u16 index)
 {
-    if ( selUnits.size() > 0 && selUnits[0] != index )
-    {
-        auto toErase = std::find(selUnits.begin(), selUnits.end(), index);
-        if ( toErase != selUnits.end() )
-        {
-            selUnits.erase(toErase);
-            selUnits.insert(selUnits.begin(), index);
-        }
-    }
+    selUnits.ensureFirst(index);
+}
+
+void Selections::setUnit(size_t position, u16 index)
+{
+    selUnits.set(position, index);
+}
+
+void Selections::unitInserted(u16 index)
+{
+    selUnits.unitInserted(index);
+}
+
+void Selections::unitDeleted(u16 index)
+{
+    selUnits.unitDeleted(index);
 }
 
 void Selections::sendSwap(u16 oldIndex, u16 newIndex)
 {
-    for ( u16 & unitIndex : selUnits )
-    {
-        if ( unitIndex == newIndex )
-            unitIndex = oldIndex | UnitSortFlags::Swapped;
-        else if ( unitIndex == oldIndex )
-            unitIndex = newIndex;
-    }
+    selUnits.sendSwap(oldIndex, newIndex);
 }
 
 void Selections::sendMove(u16 oldIndex, u16 newIndex) // The item is being moved back to its oldIndex from its newIndex
 {
-    for ( u16 & unitIndex : selUnits )
-    {
-        if ( unitIndex == newIndex )
-            unitIndex = oldIndex | UnitSortFlags::Moved;
-        else if ( newIndex > unitIndex && oldIndex <= unitIndex ) // The moved unit was somewhere ahead of track and is now behind track
-            unitIndex++; // Selected unit index needs to be moved forward
-        else if ( newIndex < unitIndex && oldIndex >= unitIndex ) // The moved unit was somewhere behind track and is now ahead of track
-            unitIndex--; // Selected unit index needs to be moved backward
-    }
+    selUnits.sendMove(oldIndex, newIndex);
 }
 
 void Selections::finishSwap()
 {
-    for ( u16 & unitIndex : selUnits )
-    {
-        if ( unitIndex & UnitSortFlags::Swapped )
-            unitIndex &= UnitSortFlags::Unswap;
-    }
+    selUnits.finishSwap();
 }
 
 void Selections::finishMove()
 {
-    for ( u16 & unitIndex : selUnits )
-    {
-        if ( unitIndex & UnitSortFlags::Moved )
-            unitIndex &= UnitSortFlags::Unmove;
-    }
+    selUnits.finishMove();
 }
 
 bool Selections::unitIsSelected(u16 index)
 {
-    for ( u16 & unitIndex : selUnits )
-    {
-        if ( unitIndex == index )
-            return true;
-    }
-    return false;
+    return selUnits.contains(index);
 }
 
 u16 Selections::numUnits()
@@ -311,13 +288,7 @@ u16 Selections::numUnits()
 
 u16 Selections::numUnitsUnder(u16 index)
 {
-    u16 numUnitsBefore = 0;
-    for ( u16 & unitIndex : selUnits )
-    {
-        if ( unitIndex < index )
-            numUnitsBefore++;
-    }
-    return numUnitsBefore;
+    return u16(selUnits.numBefore(index));
 }
 
 std::vector<TileNode> & Selections::getTiles()
@@ -344,49 +315,27 @@ TileNode Selections::getFirstTile()
     return tile;
 }
 
-std::vector<u16> & Selections::getUnits()
+const std::vector<u16> & Selections::getUnits()
 {
-    return selUnits;
+    return selUnits.getIndexes();
 }
 
 u16 Selections::getFirstUnit()
 {
-    if ( selUnits.size() > 0 )
-        return selUnits[0];
-    else
-        return 0;
+    return selUnits.first();
 }
 
 u16 Selections::getHighestIndex()
 {
-    int highestIndex = -1;
-    for ( u16 & unitIndex : selUnits )
-    {
-        if ( (int)unitIndex > highestIndex )
-            highestIndex = (int)unitIndex;
-    }
-
-    if ( highestIndex >= 0 )
-        return highestIndex;
-    else
-        return (u16)highestIndex;
+    return selUnits.highest();
 }
 
 u16 Selections::getLowestIndex()
 {
-    u16 highestIndex = u16_max;
-    for ( u16 & unitIndex : selUnits )
-    {
-        if ( unitIndex < highestIndex )
-            highestIndex = unitIndex;
-    }
-    return highestIndex;
+    return selUnits.lowest();
 }
 
 void Selections::sortUnits(bool ascending)
 {
-    if ( ascending )
-        std::sort(selUnits.begin(), selUnits.end());
-    else // Sort descending
-        std::sort(selUnits.begin(), selUnits.end(), std::greater<u16>());
+    selUnits.sort(ascending);
 }
@@ -9,9 +9,6 @@ enum_t(LocSelFlags, u8, { North = BIT_0, South = BIT_1, East = BIT_2, West = BIT
     Middle = North | South | East | West, None = 0 });
 
 
-enum_t(UnitSortFlags, u16, { Swapped = (u16)BIT_14, Moved = (u16)BIT_15, Unswap = x16BIT_14, Unmove = x16BIT_15 });
-
-
 enum_t(TileNeighbor, u8, { Left = BIT_0, Top = BIT_1, Right = BIT_2, Bottom = BIT_3,
     All = Left | Top | Right | Bottom, xLeft = x8BIT_0, xTop = x8BIT_1, xRight = x8BIT_2, xBottom = x8BIT_3, None = 0 });
 
@@ -60,20 +57,23 @@ class Selections
         void removeUnit(u16 index);
         void removeUnits();
         void ensureFirst(u16 index); // Moves the unit @ index
+        void setUnit(size_t position, u16 index); // Changes the index of the selected unit at position in getUnits, e.g. after the unit is moved
+        void unitInserted(u16 index); // Call after a unit is inserted at index
+        void unitDeleted(u16 index); // Call after the unit at index is deleted
         void sendSwap(u16 oldIndex, u16 newIndex);
         void sendMove(u16 oldIndex, u16 newIndex);
         void finishSwap();
         void finishMove();
 
         bool unitIsSelected(u16 index);
-        bool hasUnits() { return selUnits.size() > 0; }
+        bool hasUnits() { return !selUnits.empty(); }
         bool hasTiles() { return selTiles.size() > 0; }
         u16 numUnits();
         u16 numUnitsUnder(u16 index);
 
         std::vector<TileNode> & getTiles();
         TileNode getFirstTile();
-        std::vector<u16> & getUnits();
+        const std::vector<u16> & getUnits();
         u16 getFirstUnit();
         u16 getLastUnit();
         u16 getHighestIndex();
@@ -90,7 +90,7 @@ class Selections
         POINT startDrag;
         POINT endDrag;
 
-        std::vector<u16> selUnits;
+        UnitSelection selUnits;
         std::vector<TileNode> selTiles;
 
         u16 selectedLocation;
@@ -76,6 +76,18 @@ bool GetLoggerPath(std::string & outLoggerPath)
     return false;
 }
 
+bool GetCachePath(std::string & outCachePath)
+{
+    std::string chkdPath;
+    if ( GetChkdPath(chkdPath) )
+    {
+        makeDirectory(chkdPath + "\\Cache");
+        outCachePath = chkdPath + std::string("\\Cache\\");
+        return true;
+    }
+    return false;
+}
+
 bool GetSettingsPath(std::string & outFilePath)
 {
     std::string moduleDirectory;
@@ -7,6 +7,8 @@ bool getPreSavePath(std::string & outPreSavePath); // Gets path holding assets t
 
 bool GetLoggerPath(std::string & outLoggerPath); // Gets the path at which logs are stored
 
+bool GetCachePath(std::string & outCachePath); // Gets the path at which data that can be rebuilt, such as decoded StarCraft data, is stored
+
 bool GetSettingsPath(std::string & outFilePath);
 
 class Settings
@@ -50,6 +50,7 @@ void UnitChange::Reverse(void *guiMap)
             ((GuiMap*)guiMap)->layers.getUnit(unitIndex)->relationClassId = data; break;
     }
     data = replacedData;
+    ((GuiMap*)guiMap)->RedrawUnit(unitIndex, true);
 }
 
 int32_t UnitChange::GetType()
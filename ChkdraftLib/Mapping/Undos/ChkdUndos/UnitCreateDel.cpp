@@ -23,11 +23,15 @@ void UnitCreateDel::Reverse(void *guiMap)
         unit = std::unique_ptr<Chk::Unit>(new Chk::Unit);
         *unit = *((GuiMap*)guiMap)->layers.getUnit(index);
         ((GuiMap*)guiMap)->layers.deleteUnit(index);
+        ((GuiMap*)guiMap)->UnitDeleted(index);
+        ((GuiMap*)guiMap)->GetSelections().unitDeleted(index);
     }
     else // Do create
     {
         Chk::UnitPtr newUnit = Chk::UnitPtr(new Chk::Unit(*unit));
         ((GuiMap*)guiMap)->layers.insertUnit(index, newUnit);
+        ((GuiMap*)guiMap)->UnitAdded(index);
+        ((GuiMap*)guiMap)->GetSelections().unitInserted(index);
         unit = nullptr;
     }
 }
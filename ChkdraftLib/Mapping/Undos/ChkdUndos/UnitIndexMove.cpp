@@ -16,6 +16,7 @@ void UnitIndexMove::Reverse(void *guiMap)
     Chk::UnitPtr preserve = ((GuiMap*)guiMap)->layers.getUnit(newIndex);
     ((GuiMap*)guiMap)->layers.deleteUnit(newIndex);
     ((GuiMap*)guiMap)->layers.insertUnit(oldIndex, preserve);
+    ((GuiMap*)guiMap)->UnitIndexMoved(newIndex, oldIndex);
     ((GuiMap*)guiMap)->GetSelections().sendMove(oldIndex, newIndex);
     std::swap(oldIndex, newIndex);
 }
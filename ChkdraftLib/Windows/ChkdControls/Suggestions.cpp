@@ -4,41 +4,6 @@
 #include <string>
 #include <vector>
 
-bool alphabetize(const std::string & first, const std::string & second)
-{
-    // true = first before second, false = second before first
-    size_t firstLen = first.length(),
-        secondLen = second.length();
-
-    u32 i = 0;
-    while ( i < firstLen && i < secondLen )
-    {
-        if ( tolower(first[i]) < tolower(second[i]) )
-            return true;
-        else if ( tolower(first[i]) > tolower(second[i]) )
-            return false;
-
-        i = i+1;
-    }
-    return firstLen < secondLen;
-}
-
-bool firstStartsWithSecond(const std::string & first, const std::string & second)
-{
-    size_t firstLen = first.length();
-    size_t secondLen = second.length();
-
-    if ( firstLen < secondLen )
-        return false;
-
-    for ( size_t i = 0; i < secondLen; i++ )
-    {
-        if ( tolower(first[i]) != tolower(second[i]) )
-            return false;
-    }
-    return true;
-}
-
 Suggestions::Suggestions() : isShown(false)
 {
     suggestParent = NULL;
@@ -68,20 +33,20 @@ bool Suggestions::CreateThis(HWND hParent, int x, int y, int width, int height)
 
 void Suggestions::ClearStrings()
 {
-    strList.clear();
+    strIndex.clear();
+    addedStrings.clear();
     listSuggestions.ClearSel();
     listSuggestions.ClearItems();
 }
 
 void Suggestions::AddStrings(const std::vector<std::string> & strings)
 {
-    for (auto string : strings)
-        strList.push_back(string);
+    addedStrings.insert(addedStrings.end(), strings.begin(), strings.end());
 }
 
 void Suggestions::AddString(const std::string & string)
 {
-    strList.push_back(string);
+    addedStrings.push_back(string);
 }
 
 void Suggestions::SetStrings()
@@ -89,20 +54,28 @@ void Suggestions::SetStrings()
     listSuggestions.ClearSel();
     listSuggestions.ClearItems();
 
-    strList.sort(alphabetize);
-    for ( auto & str : strList )
-        listSuggestions.AddString(str);
+    if ( !addedStrings.empty() )
+    {
+        strIndex.add(addedStrings);
+        addedStrings.clear();
+    }
+    for ( size_t i=0; i<strIndex.size(); i++ )
+        listSuggestions.AddString(strIndex.at(i));
 }
 
 void Suggestions::SetStrings(const std::vector<std::string> & strings)
 {
-    strList.clear();
-    for ( auto str : strings )
-        strList.push_back(str);
-
+    strIndex.clear();
+    addedStrings = strings;
     SetStrings();
 }
 
+void Suggestions::SetStrings(const AutocompleteIndex & index)
+{
+    strIndex = index;
+    addedStrings.clear();
+}
+
 void Suggestions::Show()
 {
     SetStrings();
@@ -118,7 +91,9 @@ void Suggestions::Hide()
 
 void Suggestions::SuggestNear(const std::string & str)
 {
-    SuggestFirstStartingWith(str);
+    size_t index = strIndex.nearest(str);
+    if ( index != AutocompleteIndex::NoMatch )
+        listSuggestions.SetCurSel(int(index));
 }
 
 void Suggestions::ArrowUp()
@@ -162,16 +137,9 @@ void Suggestions::EraseBackground(HDC hDC)
 
 void Suggestions::SuggestFirstStartingWith(const std::string & str)
 {
-    int i = 0;
-    for ( auto & check : strList )
-    {
-        if ( firstStartsWithSecond(check, str) ) // *it begins with str
-        {
-            listSuggestions.SetCurSel(i);
-            return;
-        }
-        i++;
-    }
+    size_t index = strIndex.firstStartingWith(str);
+    if ( index != AutocompleteIndex::NoMatch )
+        listSuggestions.SetCurSel(int(index));
 }
 
 void Suggestions::KeyDown(WPARAM wParam)
@@ -220,7 +188,7 @@ LRESULT Suggestions::WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
     switch ( msg )
     {
         //case WM_SIZE: DoSize(); break;
-        case WinLib::GV::WM_NEWGRIDTEXT: SuggestFirstStartingWith(*(std::string*)lParam); break;
+        case WinLib::GV::WM_NEWGRIDTEXT: SuggestNear(*(std::string*)lParam); break;
         case WM_KEYDOWN: KeyDown(wParam); break;
         case WM_ERASEBKGND: EraseBackground((HDC)wParam); break;
         default: return ClassWindow::WndProc(hWnd, msg, wParam, lParam); break;
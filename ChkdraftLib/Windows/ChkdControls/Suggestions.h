@@ -1,6 +1,7 @@
 #ifndef SUGGESTIONS_H
 #define SUGGESTIONS_H
 #include "../../../WindowsLib/WindowsUi.h"
+#include "../../../MappingCoreLib/MappingCore.h"
 #include <string>
 #include <vector>
 
@@ -16,6 +17,7 @@ class Suggestions : public WinLib::ClassWindow
         void AddString(const std::string & string); // Adds a string to the stored list but does not yet display it
         void SetStrings(); // Sets all the strings in the stored list to the display
         void SetStrings(const std::vector<std::string> & strings);
+        void SetStrings(const AutocompleteIndex & index); // Replaces the stored list with the strings of an already sorted index, displayed on Show
         void Show();
         void Hide();
         void SuggestNear(const std::string & str);
@@ -38,7 +40,8 @@ class Suggestions : public WinLib::ClassWindow
         bool isShown;
 
         void KeyDown(WPARAM wParam);
-        std::list<std::string> strList;
+        AutocompleteIndex strIndex;
+        std::vector<std::string> addedStrings; // Strings added since the last SetStrings, merged into strIndex together
 };
 
 #endif
\ No newline at end of file
@@ -87,7 +87,7 @@ void LocationWindow::RefreshLocationElevationFlags()
     bool prevRefreshingValue = refreshing;
     refreshing = true;
 
-    const Chk::LocationPtr locRef = currentLocationId != NO_LOCATION ? CM->layers.getLocation(currentLocationId) : nullptr;
+    const Chk::LocationPtr locRef = currentLocationId != NO_LOCATION ? static_cast<const Layers &>(CM->layers).getLocation(currentLocationId) : nullptr;
     if ( locRef != nullptr )
     {
         checkLowGround.SetCheck((locRef->elevationFlags & Chk::Location::Elevation::LowElevation) == 0);
@@ -109,7 +109,7 @@ void LocationWindow::RefreshLocationInfo()
         DestroyThis();
 
     currentLocationId = CM->GetSelectedLocation();
-    const Chk::LocationPtr locRef = currentLocationId != NO_LOCATION ? CM->layers.getLocation(currentLocationId) : nullptr;
+    const Chk::LocationPtr locRef = currentLocationId != NO_LOCATION ? static_cast<const Layers &>(CM->layers).getLocation(currentLocationId) : nullptr;
     if ( locRef != nullptr )
     {
         editLocLeft.SetText(std::to_string(locRef->left));
@@ -288,12 +288,13 @@ void LocationWindow::NotifyHighAirClicked()
 
 void LocationWindow::NotifyLocNamePropertiesClicked()
 {
-    Chk::LocationPtr location = CM->layers.getLocation(currentLocationId);
+    const Chk::LocationPtr location = static_cast<const Layers &>(CM->layers).getLocation(currentLocationId);
     if ( location != nullptr )
     {
         ChkdStringPtr gameString = CM->strings.getLocationName<ChkdString>(currentLocationId, Chk::Scope::Game);
         ChkdStringPtr editorString = CM->strings.getLocationName<ChkdString>(currentLocationId, Chk::Scope::Editor);
         ChkdStringInputDialog::Result result = ChkdStringInputDialog::GetChkdString(getHandle(), gameString, editorString, Chk::StringUserFlag::Location, currentLocationId);
+        LocationNameIndex::Rename rename = CM->getLocationNameIndex().beginRename(*CM, { currentLocationId });
 
         if ( (result & ChkdStringInputDialog::Result::GameStringChanged) == ChkdStringInputDialog::Result::GameStringChanged )
         {
@@ -315,6 +316,7 @@ void LocationWindow::NotifyLocNamePropertiesClicked()
             CM->strings.deleteUnusedStrings(Chk::Scope::Editor);
         }
 
+        CM->getLocationNameIndex().endRename(*CM, rename);
         if ( result > 0 )
             CM->refreshScenario();
     }
@@ -378,14 +380,16 @@ void LocationWindow::LocationBottomUpdated()
 
 void LocationWindow::LocationNameFocusLost()
 {
-    Chk::LocationPtr locRef = currentLocationId != NO_LOCATION ? CM->layers.getLocation(currentLocationId) : nullptr;
+    const Chk::LocationPtr locRef = currentLocationId != NO_LOCATION ? static_cast<const Layers &>(CM->layers).getLocation(currentLocationId) : nullptr;
     if ( locRef != nullptr )
     {
         ChkdString locationName;
         if ( editLocName.GetWinText(locationName) )
         {
+            LocationNameIndex::Rename rename = CM->getLocationNameIndex().beginStringRename(*CM, locRef->stringId);
             CM->strings.replaceString<ChkdString>(locRef->stringId, locationName);
             CM->strings.deleteUnusedStrings(Chk::Scope::Both);
+            CM->getLocationNameIndex().endRename(*CM, rename);
             CM->notifyChange(false);
             CM->refreshScenario();
         }
@@ -516,7 +520,7 @@ void LocationWindow::NotifyEditFocused(int idFrom, HWND hWndFrom)
     if ( refreshing )
         return;
     
-    Chk::LocationPtr locRef = currentLocationId != NO_LOCATION ? CM->layers.getLocation(currentLocationId) : nullptr;
+    const Chk::LocationPtr locRef = currentLocationId != NO_LOCATION ? static_cast<const Layers &>(CM->layers).getLocation(currentLocationId) : nullptr;
     if ( locRef != nullptr )
     {
         switch ( idFrom )
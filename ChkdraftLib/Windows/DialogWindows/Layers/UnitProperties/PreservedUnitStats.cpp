@@ -23,7 +23,7 @@ void PreservedUnitStats::AddStats(Selections & sel, Chk::Unit::Field statField)
     Clear();
     field = statField;
     auto & unitIndexes = sel.getUnits();
-    for ( u16 & unitIndex : unitIndexes )
+    for ( u16 unitIndex : unitIndexes )
     {
         Chk::UnitPtr unit = CM->layers.getUnit(unitIndex);
         switch ( field )
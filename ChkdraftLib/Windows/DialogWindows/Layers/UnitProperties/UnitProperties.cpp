@@ -131,12 +131,13 @@ void UnitPropertiesWindow::ChangeCurrOwner(u8 newOwner)
         {
             u8 prevOwner = unit->owner;
             unit->owner = newOwner;
+            CM->RedrawUnit(unitIndex, true);
             ChangeUnitsDisplayedOwner(unitIndex, newOwner);
             undoableChanges->Insert(UnitChange::Make(unitIndex, Chk::Unit::Field::Owner, prevOwner));
         }
     }
     CM->AddUndo(undoableChanges);
-    CM->Redraw(true);
+    CM->Redraw(false);
 }
 
 void UnitPropertiesWindow::ChangeDropdownPlayer(u8 newPlayer)
@@ -255,7 +256,7 @@ void UnitPropertiesWindow::RepopulateList()
             listUnits.FocusItem(selectedIndex);
 
             auto & selUnits = selections.getUnits();
-            for ( u16 & unitIndex : selUnits )
+            for ( u16 unitIndex : selUnits )
                 listUnits.SelectRow(unitIndex);
 
             EnableUnitEditing();
@@ -489,7 +490,7 @@ void UnitPropertiesWindow::LvItemChanged(NMHDR* nmhdr)
             WindowsItem::SetWinText(*unitName);
             SetUnitFieldText(unit);
 
-            CM->Redraw(false);
+            CM->RedrawUnit(index, false);
         }
         else if ( itemInfo->uOldState & LVIS_SELECTED ) // From selected to not selected
                                                         // Remove item from selection
@@ -507,7 +508,7 @@ void UnitPropertiesWindow::LvItemChanged(NMHDR* nmhdr)
                 DisableUnitEditing();
             }
 
-            CM->Redraw(false);
+            CM->RedrawUnit(index, false);
         }
     }
 }
@@ -532,18 +533,20 @@ void UnitPropertiesWindow::NotifyMoveTopPressed()
     unitChanges->Insert(UnitIndexMoveBoundary::Make());
     u16 i = 0;
     auto & selUnits = selections.getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( size_t position = 0; position < selUnits.size(); position++ )
     {
+        u16 unitIndex = selUnits[position];
         if ( unitIndex != 0 ) // If unit is not at the destination index and unitptr can be retrieved
         {
             preserve = CM->layers.getUnit(unitIndex); // Preserve the unit info
             CM->layers.deleteUnit(unitIndex);
             CM->layers.insertUnit(i, preserve);
+            CM->UnitIndexMoved(unitIndex, i);
             unitChanges->Insert(UnitIndexMove::Make(unitIndex, i));
             if ( unitIndex == unitStackTopIndex )
                 unitStackTopIndex = i;
 
-            unitIndex = i; // Modify the index that denotes unit selection
+            selections.setUnit(position, i); // Modify the index that denotes unit selection
         }
         i++;
     }
@@ -573,19 +576,21 @@ void UnitPropertiesWindow::NotifyMoveEndPressed()
     auto unitChanges = ReversibleActions::Make();
     unitChanges->Insert(UnitIndexMoveBoundary::Make());
     auto & selUnits = selections.getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( size_t position = 0; position < selUnits.size(); position++ )
     {
+        u16 unitIndex = selUnits[position];
         if ( unitIndex != numUnits - 1 )
         {
             preserve = CM->layers.getUnit(unitIndex);
             CM->layers.deleteUnit(unitIndex);
             CM->layers.insertUnit(numUnits - i, preserve);
+            CM->UnitIndexMoved(unitIndex, numUnits - i);
             unitChanges->Insert(UnitIndexMove::Make(unitIndex, u16(numUnits - i)));
 
             if ( unitIndex == unitStackTopIndex )
                 unitStackTopIndex = u16(numUnits - i);
 
-            unitIndex = u16(numUnits - i);
+            selections.setUnit(position, u16(numUnits - i));
         }
         i++;
     }
@@ -609,14 +614,16 @@ void UnitPropertiesWindow::NotifyMoveUpPressed()
     auto unitChanges = ReversibleActions::Make();
     unitChanges->Insert(UnitIndexMoveBoundary::Make());
     auto & selUnits = selections.getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( size_t position = 0; position < selUnits.size(); position++ )
     {
+        u16 unitIndex = selUnits[position];
         if ( unitIndex > 0 && !selections.unitIsSelected(unitIndex - 1) )
         {
             CM->layers.moveUnit(unitIndex, unitIndex-1);
+            CM->UnitIndexMoved(unitIndex, unitIndex-1);
             unitChanges->Insert(UnitIndexMove::Make(unitIndex, unitIndex - 1));
             SwapIndexes(hUnitList, unitIndex, unitIndex - 1);
-            unitIndex--;
+            selections.setUnit(position, unitIndex - 1);
         }
     }
 
@@ -644,14 +651,16 @@ void UnitPropertiesWindow::NotifyMoveDownPressed()
     auto unitChanges = ReversibleActions::Make();
     unitChanges->Insert(UnitIndexMoveBoundary::Make());
     auto & selUnits = selections.getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( size_t position = 0; position < selUnits.size(); position++ )
     {
+        u16 unitIndex = selUnits[position];
         if ( unitIndex < CM->layers.numUnits() && !selections.unitIsSelected(unitIndex + 1) )
         {
             CM->layers.moveUnit(unitIndex, unitIndex+1);
+            CM->UnitIndexMoved(unitIndex, unitIndex+1);
             unitChanges->Insert(UnitIndexMove::Make(unitIndex, unitIndex + 1));
             SwapIndexes(hUnitList, unitIndex, unitIndex + 1);
-            unitIndex++;
+            selections.setUnit(position, unitIndex + 1);
         }
     }
 
@@ -705,19 +714,22 @@ void UnitPropertiesWindow::NotifyMoveToPressed()
             auto unitCreateDels = ReversibleActions::Make();
             u16 i = 0;
             auto & selUnits = selections.getUnits();
-            for ( u16 & unitIndex : selUnits )
+            for ( size_t position = 0; position < selUnits.size(); position++ )
             { // Remove each selected unit from the map, store in selectedUnits
+                u16 unitIndex = selUnits[position];
                 u32 loc = ((u32)unitIndex)*sizeof(Chk::Unit);
                 selectedUnits[shift - i] = CM->layers.getUnit(unitIndex);
                 CM->layers.deleteUnit(unitIndex);
+                CM->UnitDeleted(unitIndex);
                 unitCreateDels->Insert(UnitCreateDel::Make((u16)unitIndex, *selectedUnits[shift - i]));
-                unitIndex = u16(unitMoveTo + shift - i);
+                selections.setUnit(position, u16(unitMoveTo + shift - i));
                 i++;
             }
 
             for ( int i = 0; i < numUnits; i++ )
             {
                 CM->layers.insertUnit(unitMoveTo + i, selectedUnits[i]);
+                CM->UnitAdded(unitMoveTo + i);
                 unitCreateDels->Insert(UnitCreateDel::Make(unitMoveTo + i));
             }
 
@@ -747,12 +759,13 @@ void UnitPropertiesWindow::NotifyDeletePressed()
         unitDeletes->Insert(UnitCreateDel::Make(index, *unit));
 
         CM->layers.deleteUnit(index);
+        CM->UnitDeleted(index);
 
         for ( size_t i = index + 1; i <= CM->layers.numUnits(); i++ )
             ChangeIndex(hUnitList, i, i - 1);
     }
     CM->AddUndo(unitDeletes);
-    CM->Redraw(true);
+    CM->Redraw(false);
     listUnits.SetRedraw(true);
 }
 
@@ -760,7 +773,7 @@ void UnitPropertiesWindow::NotifyInvincibleClicked()
 {
     auto unitChanges = ReversibleActions::Make();
     auto & selUnits = CM->GetSelections().getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( u16 unitIndex : selUnits )
     {
         Chk::UnitPtr unit = CM->layers.getUnit(unitIndex);
         unitChanges->Insert(UnitChange::Make(unitIndex, Chk::Unit::Field::StateFlags, unit->stateFlags));
@@ -777,7 +790,7 @@ void UnitPropertiesWindow::NotifyHallucinatedClicked()
 {
     auto unitChanges = ReversibleActions::Make();
     auto & selUnits = CM->GetSelections().getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( u16 unitIndex : selUnits )
     {
         Chk::UnitPtr unit = CM->layers.getUnit(unitIndex);
         unitChanges->Insert(UnitChange::Make(unitIndex, Chk::Unit::Field::StateFlags, unit->stateFlags));
@@ -794,7 +807,7 @@ void UnitPropertiesWindow::NotifyBurrowedClicked()
 {
     auto unitChanges = ReversibleActions::Make();
     auto & selUnits = CM->GetSelections().getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( u16 unitIndex : selUnits )
     {
         Chk::UnitPtr unit = CM->layers.getUnit(unitIndex);
         unitChanges->Insert(UnitChange::Make(unitIndex, Chk::Unit::Field::StateFlags, unit->stateFlags));
@@ -811,7 +824,7 @@ void UnitPropertiesWindow::NotifyCloakedClicked()
 {
     auto unitChanges = ReversibleActions::Make();
     auto & selUnits = CM->GetSelections().getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( u16 unitIndex : selUnits )
     {
         Chk::UnitPtr unit = CM->layers.getUnit(unitIndex);
         unitChanges->Insert(UnitChange::Make(unitIndex, Chk::Unit::Field::StateFlags, unit->stateFlags));
@@ -828,7 +841,7 @@ void UnitPropertiesWindow::NotifyLiftedClicked()
 {
     auto unitChanges = ReversibleActions::Make();
     auto & selUnits = CM->GetSelections().getUnits();
-    for ( u16 & unitIndex : selUnits )
+    for ( u16 unitIndex : selUnits )
     {
         Chk::UnitPtr unit = CM->layers.getUnit(unitIndex);
         unitChanges->Insert(UnitChange::Make(unitIndex, Chk::Unit::Field::StateFlags, unit->stateFlags));
@@ -847,7 +860,7 @@ void UnitPropertiesWindow::NotifyHpEditUpdated()
     if ( editLife.GetEditNum<u8>(hpPercent) )
     {
         auto & selUnits = CM->GetSelections().getUnits();
-        for ( u16 & unitIndex : selUnits )
+        for ( u16 unitIndex : selUnits )
             CM->layers.getUnit(unitIndex)->hitpointPercent = hpPercent;
 
         CM->Redraw(false);
@@ -860,7 +873,7 @@ void UnitPropertiesWindow::NotifyMpEditUpdated()
     if ( editMana.GetEditNum<u8>(mpPercent) )
     {
         auto & selUnits = CM->GetSelections().getUnits();
-        for ( u16 & unitIndex : selUnits )
+        for ( u16 unitIndex : selUnits )
             CM->layers.getUnit(unitIndex)->energyPercent = mpPercent;
 
         CM->Redraw(false);
@@ -873,7 +886,7 @@ void UnitPropertiesWindow::NotifyShieldEditUpdated()
     if ( editShield.GetEditNum<u8>(shieldPercent) )
     {
         auto & selUnits = CM->GetSelections().getUnits();
-        for ( u16 & unitIndex : selUnits )
+        for ( u16 unitIndex : selUnits )
             CM->layers.getUnit(unitIndex)->shieldPercent = shieldPercent;
 
         CM->Redraw(false);
@@ -886,7 +899,7 @@ void UnitPropertiesWindow::NotifyResourcesEditUpdated()
     if ( editResources.GetEditNum<u32>(resources) )
     {
         auto & selUnits = CM->GetSelections().getUnits();
-        for ( u16 & unitIndex : selUnits )
+        for ( u16 unitIndex : selUnits )
             CM->layers.getUnit(unitIndex)->resourceAmount = resources;
 
         CM->Redraw(false);
@@ -899,7 +912,7 @@ void UnitPropertiesWindow::NotifyHangerEditUpdated()
     if ( editHanger.GetEditNum<u16>(hanger) )
     {
         auto & selUnits = CM->GetSelections().getUnits();
-        for ( u16 & unitIndex : selUnits )
+        for ( u16 unitIndex : selUnits )
             CM->layers.getUnit(unitIndex)->hangerAmount = hanger;
 
         CM->Redraw(true);
@@ -912,7 +925,7 @@ void UnitPropertiesWindow::NotifyIdEditUpdated()
     if ( editUnitId.GetEditNum<u16>(unitID) )
     {
         auto & selUnits = CM->GetSelections().getUnits();
-        for ( u16 & unitIndex : selUnits )
+        for ( u16 unitIndex : selUnits )
         {
             CM->layers.getUnit(unitIndex)->type = (Sc::Unit::Type)unitID;
             int row = listUnits.GetItemRow(unitIndex);
@@ -934,13 +947,14 @@ void UnitPropertiesWindow::NotifyXcEditUpdated()
     if ( editXc.GetEditNum<u16>(unitXC) )
     {
         auto & selUnits = CM->GetSelections().getUnits();
-        for ( u16 & unitIndex : selUnits )
+        for ( u16 unitIndex : selUnits )
         {
+            CM->RedrawUnit(unitIndex, true); // Redraw where the unit was and where it's moved to
             CM->layers.getUnit(unitIndex)->xc = unitXC;
+            CM->RedrawUnit(unitIndex, true);
             int row = listUnits.GetItemRow(unitIndex);
             listUnits.SetItemText(row, (int)UnitListColumn::Xc, unitXC);
         }
-        CM->Redraw(true);
         ListView_SortItems(listUnits.getHandle(), ForwardCompareLvItems, this);
     }
 }
@@ -951,13 +965,14 @@ void UnitPropertiesWindow::NotifyYcEditUpdated()
     if ( editYc.GetEditNum<u16>(unitYC) )
     {
         auto & selUnits = CM->GetSelections().getUnits();
-        for ( u16 & unitIndex : selUnits )
+        for ( u16 unitIndex : selUnits )
         {
+            CM->RedrawUnit(unitIndex, true); // Redraw where the unit was and where it's moved to
             CM->layers.getUnit(unitIndex)->yc = unitYC;
+            CM->RedrawUnit(unitIndex, true);
             int row = listUnits.GetItemRow(unitIndex);
             listUnits.SetItemText(row, (int)UnitListColumn::Yc, unitYC);
         }
-        CM->Redraw(true);
         ListView_SortItems(listUnits.getHandle(), ForwardCompareLvItems, this);
     }
 }
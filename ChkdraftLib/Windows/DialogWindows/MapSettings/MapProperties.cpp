@@ -296,7 +296,7 @@ LRESULT MapPropertiesWindow::Command(HWND hWnd, WPARAM wParam, LPARAM lParam)
             if ( player >= 0 && player < 12 && newColor != CB_ERR && newColor >= 0 && newColor < 16 )
             {
                 CM->players.setPlayerColor(player, (Chk::PlayerColor)newColor);
-                CM->Redraw(true);
+                CM->PlayerColorChanged(player);
                 CM->notifyChange(false);
             }
         }
@@ -308,7 +308,7 @@ LRESULT MapPropertiesWindow::Command(HWND hWnd, WPARAM wParam, LPARAM lParam)
             if ( dropPlayerColor[player].GetEditNum<u8>(newColor) )
             {
                 CM->players.setPlayerColor(player, (Chk::PlayerColor)newColor);
-                CM->Redraw(true);
+                CM->PlayerColorChanged(player);
                 CM->notifyChange(false);
             }
         }
@@ -354,7 +354,9 @@ bool StringEditorWindow::updateString(u32 stringNum)
     ChkdStringPtr existingStr = CM->strings.getString<ChkdString>((size_t)stringNum);
     if ( CM != nullptr && editString.GetWinText(editStr) && existingStr != nullptr && existingStr->compare(editStr) != 0 )
     {
+        LocationNameIndex::Rename rename = CM->getLocationNameIndex().beginStringRename(*CM, (size_t)stringNum);
         CM->strings.replaceString<ChkdString>((size_t)stringNum, editStr);
+        CM->getLocationNameIndex().endRename(*CM, rename);
         CM->notifyChange(false);
         if ( CM->layers.stringUsed(currSelString, Chk::Scope::EditorOverGame) )
             chkd.mainPlot.leftBar.mainTree.locTree.RebuildLocationTree();
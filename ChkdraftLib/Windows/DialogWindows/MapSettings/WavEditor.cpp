@@ -61,7 +61,7 @@ void WavEditorWindow::RefreshWindow()
     }
     for ( size_t i=0; i<CM->triggers.numTriggers(); i++ )
     {
-        const Chk::TriggerPtr trigger = CM->triggers.getTrigger(i);
+        const Chk::Trigger* trigger = CM->triggers.readTrigger(i);
         for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
         {
             if ( (trigger->actions[actionIndex].actionType == Chk::Action::Type::PlaySound ||
@@ -74,7 +74,7 @@ void WavEditorWindow::RefreshWindow()
     }
     for ( size_t i=0; i<CM->triggers.numBriefingTriggers(); i++ )
     {
-        Chk::TriggerPtr trigger = CM->triggers.getBriefingTrigger(i);
+        const Chk::Trigger* trigger = CM->triggers.readBriefingTrigger(i);
         for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
         {
             if ( (trigger->actions[actionIndex].actionType == Chk::Action::Type::BriefingPlaySound ||
@@ -461,7 +461,7 @@ void WavEditorWindow::DeleteSoundButtonPressed()
         bool wavStringIdIsUsed = false;
         for ( size_t i=0; i<CM->triggers.numTriggers(); i++ )
         {
-            Chk::TriggerPtr trigger = CM->triggers.getTrigger(i);
+            const Chk::Trigger* trigger = CM->triggers.readTrigger(i);
             for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
             {
                 if ( (trigger->actions[actionIndex].actionType == Chk::Action::Type::PlaySound ||
@@ -478,7 +478,7 @@ void WavEditorWindow::DeleteSoundButtonPressed()
         {
             for ( size_t i=0; i<CM->triggers.numBriefingTriggers(); i++ )
             {
-                Chk::TriggerPtr trigger = CM->triggers.getBriefingTrigger(i);
+                const Chk::Trigger* trigger = CM->triggers.readBriefingTrigger(i);
                 for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
                 {
                     if ( (trigger->actions[actionIndex].actionType == Chk::Action::Type::BriefingPlaySound ||
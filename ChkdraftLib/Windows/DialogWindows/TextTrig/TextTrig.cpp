@@ -30,6 +30,8 @@ void TextTrigWindow::RefreshWindow()
     {
         auto start = std::chrono::high_resolution_clock::now();
         SetDialogItemText(IDC_EDIT_TRIGTEXT, trigString);
+        triggerHashes = textTrigs.getTriggerHashes();
+        modificationEpoch = textTrigs.getModificationEpoch();
         auto finish = std::chrono::high_resolution_clock::now();
         logger.debug() << "Windows updated textbox contents in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
     }
@@ -152,7 +154,7 @@ bool TextTrigWindow::CompileEditText(ScenarioPtr map)
         if ( editControl.GetWinText(trigText) )
         {
             TextTrigCompiler compiler(Settings::useAddressesForMemory, Settings::deathTableStart); // All data for compilation is gathered on-the-fly, no need to check for updates
-            if ( compiler.compileTriggers(trigText, map, chkd.scData, 0, map->triggers.numTriggers()) )
+            if ( compiler.compileChangedTriggers(trigText, map, chkd.scData, triggerHashes, modificationEpoch) )
                 return true;
             else
                 WinLib::Message("Compilation failed.", "Error!");
@@ -20,6 +20,8 @@ class TextTrigWindow : public WinLib::ClassDialog
 
     private:
         WinLib::EditControl editControl;
+        std::vector<u64> triggerHashes; // Hash of each trigger's text as of the last generate or compile, lets unchanged triggers skip compilation
+        u64 modificationEpoch = 0; // The map's modification epoch as of the last generate or compile, triggerHashes are only used if it's unchanged
 };
 
 #endif
\ No newline at end of file
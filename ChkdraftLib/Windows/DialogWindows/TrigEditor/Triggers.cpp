@@ -310,10 +310,10 @@ void TriggersWindow::ButtonModify()
     }
 }
 
-std::string TriggersWindow::GetConditionString(u8 conditionNum, Chk::Trigger* trigger, TextTrigGenerator & tt)
+std::string TriggersWindow::GetConditionString(u8 conditionNum, const Chk::Trigger* trigger, TextTrigGenerator & tt)
 {
     std::stringstream ssCondition;
-    Chk::Condition & condition = trigger->condition(conditionNum);
+    const Chk::Condition & condition = trigger->condition(conditionNum);
     Chk::Condition::Type conditionType = condition.conditionType;
     if ( condition.isDisabled() )
         ssCondition << "(disabled) ";
@@ -422,10 +422,10 @@ std::string TriggersWindow::GetConditionString(u8 conditionNum, Chk::Trigger* tr
     return ssCondition.str();
 }
 
-std::string TriggersWindow::GetActionString(u8 actionNum, Chk::Trigger* trigger, TextTrigGenerator & tt)
+std::string TriggersWindow::GetActionString(u8 actionNum, const Chk::Trigger* trigger, TextTrigGenerator & tt)
 {
     std::stringstream ssAction;
-    Chk::Action & action = trigger->action(actionNum);
+    const Chk::Action & action = trigger->action(actionNum);
     Chk::Action::Type actionType = action.actionType;
     if ( action.isDisabled() )
         ssAction << "(disabled) ";
@@ -692,7 +692,7 @@ std::string TriggersWindow::GetActionString(u8 actionNum, Chk::Trigger* trigger,
     return ssAction.str();
 }
 
-std::string TriggersWindow::GetTriggerString(u32 trigNum, Chk::Trigger* trigger, TextTrigGenerator & tt)
+std::string TriggersWindow::GetTriggerString(u32 trigNum, const Chk::Trigger* trigger, TextTrigGenerator & tt)
 {
     bool more = false;
     std::stringstream ssTrigger;
@@ -791,7 +791,7 @@ void TriggersWindow::RefreshGroupList()
         size_t numTriggers = CM->triggers.numTriggers();
         for ( size_t i=0; i<numTriggers; i++ )
         {
-            const Chk::TriggerPtr trigger = CM->triggers.getTrigger(i);
+            const Chk::Trigger* trigger = CM->triggers.readTrigger(i);
             if ( trigger != nullptr )
             {
                 for ( u8 player=firstNotFound; player<Chk::Trigger::MaxOwners; player++ )
@@ -857,8 +857,8 @@ void TriggersWindow::RefreshTrigList()
         size_t numTriggers = CM->triggers.numTriggers();
         for ( size_t i=0; i<numTriggers; i++ )
         {
-            const Chk::TriggerPtr trigger = CM->triggers.getTrigger(i);
-            if ( trigger != nullptr && ShowTrigger(&(*trigger)) )
+            const Chk::Trigger* trigger = CM->triggers.readTrigger(i);
+            if ( trigger != nullptr && ShowTrigger(trigger) )
             {
                 int newListIndex = listTriggers.AddItem((u32)i);
                 if ( newListIndex != -1 ) // Only consider the trigger if it could be added to the ListBox
@@ -1083,7 +1083,7 @@ bool TriggersWindow::FindTargetListIndex(int currListIndex, u32 currTrigIndex, u
     }
 }
 
-bool TriggersWindow::ShowTrigger(Chk::Trigger* trigger)
+bool TriggersWindow::ShowTrigger(const Chk::Trigger* trigger)
 {
     if ( displayAll )
         return true;
@@ -1103,7 +1103,7 @@ void TriggersWindow::ClearGroups()
         groupSelected[i] = false;
 }
 
-bool TriggersWindow::GetTriggerDrawSize(HDC hDC, UINT & width, UINT & height, ScenarioPtr chk, u32 triggerNum, Chk::Trigger* trigger)
+bool TriggersWindow::GetTriggerDrawSize(HDC hDC, UINT & width, UINT & height, ScenarioPtr chk, u32 triggerNum, const Chk::Trigger* trigger)
 {
     RawStringPtr commentString = CM->strings.getExtendedComment<RawString>(triggerNum);
     if ( commentString == nullptr )
@@ -1205,7 +1205,7 @@ void TriggersWindow::DrawGroup(HDC hDC, RECT & rcItem, bool isSelected, u8 group
     }
 }
 
-void TriggersWindow::DrawTrigger(HDC hDC, RECT & rcItem, bool isSelected, ScenarioPtr chk, u32 triggerNum, Chk::Trigger* trigger)
+void TriggersWindow::DrawTrigger(HDC hDC, RECT & rcItem, bool isSelected, ScenarioPtr chk, u32 triggerNum, const Chk::Trigger* trigger)
 {
     HBRUSH hBackground = CreateSolidBrush(RGB(171, 171, 171)); // Same color as in WM_CTLCOLORLISTBOX
     if ( hBackground != NULL )
@@ -1369,9 +1369,9 @@ LRESULT TriggersWindow::WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lPara
                 MEASUREITEMSTRUCT* mis = (MEASUREITEMSTRUCT*)lParam;
                 u32 triggerNum = (u32)mis->itemData;
                 
-                const Chk::TriggerPtr trigger = CM->triggers.getTrigger(triggerNum);
+                const Chk::Trigger* trigger = CM->triggers.readTrigger(triggerNum);
                 if ( trigger != nullptr )
-                    GetTriggerDrawSize(trigListDC, mis->itemWidth, mis->itemHeight, CM, triggerNum, &(*trigger));
+                    GetTriggerDrawSize(trigListDC, mis->itemWidth, mis->itemHeight, CM, triggerNum, trigger);
                 
                 return TRUE;
             }
@@ -1422,9 +1422,9 @@ LRESULT TriggersWindow::WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lPara
                 {
                     u32 triggerNum = (u32)pdis->itemData;
                     
-                    const Chk::TriggerPtr trigger = CM->triggers.getTrigger(triggerNum);
+                    const Chk::Trigger* trigger = CM->triggers.readTrigger(triggerNum);
                     if ( CM != nullptr && trigger != nullptr )
-                        DrawTrigger(pdis->hDC, pdis->rcItem, isSelected, CM, triggerNum, &(*trigger));
+                        DrawTrigger(pdis->hDC, pdis->rcItem, isSelected, CM, triggerNum, trigger);
                 }
 
                 if ( !drawingAll )
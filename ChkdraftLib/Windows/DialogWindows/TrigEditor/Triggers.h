@@ -29,9 +29,9 @@ class TriggersWindow : public WinLib::ClassWindow
         void ButtonNew();
         void ButtonModify();
 
-        std::string GetConditionString(u8 conditionNum, Chk::Trigger* trigger, TextTrigGenerator & tt);
-        std::string GetActionString(u8 actionNum, Chk::Trigger* trigger, TextTrigGenerator & tt);
-        std::string GetTriggerString(u32 trigNum, Chk::Trigger* trigger, TextTrigGenerator & tt);
+        std::string GetConditionString(u8 conditionNum, const Chk::Trigger* trigger, TextTrigGenerator & tt);
+        std::string GetActionString(u8 actionNum, const Chk::Trigger* trigger, TextTrigGenerator & tt);
+        std::string GetTriggerString(u32 trigNum, const Chk::Trigger* trigger, TextTrigGenerator & tt);
 
     protected:
         bool SelectTrigListItem(int listIndex); // Attempts to select item at listIndex, updating currTrigger
@@ -91,11 +91,11 @@ class TriggersWindow : public WinLib::ClassWindow
         std::unordered_multimap<size_t, CommentSize> commentSizeTable;
         std::unordered_multimap<size_t, WinLib::LineSize> trigLineSizeTable;
 
-        bool ShowTrigger(Chk::Trigger* trigger); // Checks if trigger should currently be shown
+        bool ShowTrigger(const Chk::Trigger* trigger); // Checks if trigger should currently be shown
         void ClearGroups();
-        bool GetTriggerDrawSize(HDC hDC, UINT & width, UINT & height, ScenarioPtr chk, u32 triggerNum, Chk::Trigger* trigger);
+        bool GetTriggerDrawSize(HDC hDC, UINT & width, UINT & height, ScenarioPtr chk, u32 triggerNum, const Chk::Trigger* trigger);
         void DrawGroup(HDC hDC, RECT & rcItem, bool isSelected, u8 groupNum);
-        void DrawTrigger(HDC hDC, RECT & rcItem, bool isSelected, ScenarioPtr chk, u32 triggerNum, Chk::Trigger* trigger);
+        void DrawTrigger(HDC hDC, RECT & rcItem, bool isSelected, ScenarioPtr chk, u32 triggerNum, const Chk::Trigger* trigger);
         void PrepDoubleBuffer(HWND hWnd, HDC hDC);
 };
 
@@ -156,10 +156,11 @@ void TrigActionsWindow::CndActEnableToggled(u8 actionNum)
     Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
     if ( actionNum >= 0 && actionNum < 64 && trig != nullptr )
     {
-        Chk::Action & action = trig->action(actionNum);
+        Chk::Action action = trig->action(actionNum);
         if ( action.actionType != Chk::Action::Type::NoAction )
         {
             action.toggleDisabled();
+            CM->triggers.setAction(trigIndex, actionNum, action);
 
             CM->notifyChange(false);
             RefreshWindow(trigIndex);
@@ -339,11 +340,14 @@ void TrigActionsWindow::ChangeActionType(Chk::Action & action, Chk::Action::Type
     }
 }
 
-bool TrigActionsWindow::TransformAction(Chk::Action & action, Chk::Action::Type newType, bool refreshImmediately)
+bool TrigActionsWindow::TransformAction(u8 actionNum, Chk::Action::Type newType, bool refreshImmediately)
 {
-    if ( action.actionType != newType )
+    Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
+    if ( trig != nullptr && trig->action(actionNum).actionType != newType )
     {
+        Chk::Action action = trig->action(actionNum);
         ChangeActionType(action, newType);
+        CM->triggers.setAction(trigIndex, actionNum, action);
         if ( refreshImmediately )
             RefreshActionAreas();
 
@@ -367,16 +371,13 @@ void TrigActionsWindow::UpdateActionName(u8 actionNum, const std::string & newTe
     if ( ttc.parseActionName(newText, newType) || ttc.parseActionName(suggestions.Take(), newType) )
     {
         if ( trig != nullptr )
-        {
-            Chk::Action & action = trig->action(actionNum);
-            TransformAction(action, newType, refreshImmediately);
-        }
+            TransformAction(actionNum, newType, refreshImmediately);
     }
     else if ( newText.length() == 0 )
     {
         if ( trig != nullptr && trig->action(actionNum).actionType != newType )
         {
-            trig->deleteAction((u8)actionNum);
+            CM->triggers.deleteAction(trigIndex, actionNum);
             if ( refreshImmediately )
                 RefreshActionAreas();
         }
@@ -392,7 +393,7 @@ void TrigActionsWindow::UpdateActionArg(u8 actionNum, u8 argNum, const std::stri
     Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
     if ( trig != nullptr )
     {
-        Chk::Action & action = trig->action(actionNum);
+        Chk::Action action = trig->action(actionNum);
         if ( action.actionType < Chk::Action::NumActionTypes )
         {
             Chk::Action::ArgType argType = Chk::Action::getClassicArgType(action.actionType, argNum);
@@ -413,6 +414,7 @@ void TrigActionsWindow::UpdateActionArg(u8 actionNum, u8 argNum, const std::stri
                     else if ( argType == Chk::Action::ArgType::Sound )
                         action.soundStringId = (u32)newStringId;
                     
+                    CM->triggers.setAction(trigIndex, actionNum, action);
                     CM->strings.deleteUnusedStrings(Chk::Scope::Both);
                     madeChange = true;
                 }
@@ -467,6 +469,7 @@ void TrigActionsWindow::UpdateActionArg(u8 actionNum, u8 argNum, const std::stri
 
             if ( madeChange )
             {
+                CM->triggers.setAction(trigIndex, actionNum, action);
                 if ( refreshImmediately )
                     RefreshActionAreas();
             }
@@ -503,7 +506,9 @@ BOOL TrigActionsWindow::GridItemDeleting(u16 gridItemX, u16 gridItemY)
             trig != nullptr &&
             trig->action(actionNum).actionType != Chk::Action::Type::NoAction )
         {
-            ChangeActionType(trig->action(actionNum), Chk::Action::Type::NoAction);
+            Chk::Action action = trig->action(actionNum);
+            ChangeActionType(action, Chk::Action::Type::NoAction);
+            CM->triggers.setAction(trigIndex, actionNum, action);
         }
         else if ( gridItemX > 1 ) // Action Arg
         {
@@ -679,23 +684,8 @@ void TrigActionsWindow::SuggestNothing()
 void TrigActionsWindow::SuggestLocation()
 {
     if ( CM != nullptr )
-    {
-        suggestions.AddString(std::string("No Location"));
-        size_t numLocations = (u16)CM->layers.numLocations();
-        for ( size_t i = 1; i <= numLocations; i++ )
-        {
-            const Chk::LocationPtr loc = CM->layers.getLocation(i);
-            std::shared_ptr<SingleLineChkdString> locationName = loc != nullptr && loc->stringId > 0 ? CM->strings.getLocationName<SingleLineChkdString>(i) : nullptr;
-            if ( locationName != nullptr )
-                suggestions.AddString(*locationName);
-            else if ( !loc->isBlank() )
-            {
-                std::stringstream ssLoc;
-                ssLoc << i;
-                suggestions.AddString(ssLoc.str());
-            }
-        }
-    }
+        suggestions.SetStrings(CM->getLocationNameIndex().get(*CM));
+
     suggestions.Show();
 }
 
@@ -943,7 +933,7 @@ void TrigActionsWindow::ButtonEditString()
     Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
     if ( trig != nullptr && gridActions.GetFocusedItem(focusedX, focusedY) )
     {
-        Chk::Action & action = trig->action((u8)focusedY);
+        Chk::Action action = trig->action((u8)focusedY);
         if ( action.hasStringArgument() )
         {
             ChkdStringPtr gameString, editorString;
@@ -963,6 +953,7 @@ void TrigActionsWindow::ButtonEditString()
                 else
                     action.stringId = Chk::StringId::NoString;
 
+                CM->triggers.setAction(trigIndex, (size_t)focusedY, action);
                 CM->strings.deleteUnusedStrings(Chk::Scope::Game);
             }
 
@@ -992,7 +983,7 @@ void TrigActionsWindow::ButtonEditSound()
     Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
     if ( trig != nullptr && gridActions.GetFocusedItem(focusedX, focusedY) )
     {
-        Chk::Action & action = trig->action((u8)focusedY);
+        Chk::Action action = trig->action((u8)focusedY);
         if ( action.hasSoundArgument() )
         {
             ChkdStringPtr gameString, editorString;
@@ -1012,6 +1003,7 @@ void TrigActionsWindow::ButtonEditSound()
                 else
                     action.soundStringId = Chk::StringId::NoString;
 
+                CM->triggers.setAction(trigIndex, (size_t)focusedY, action);
                 CM->strings.deleteUnusedStrings(Chk::Scope::Game);
             }
 
@@ -1041,16 +1033,17 @@ void TrigActionsWindow::ButtonEditUnitProperties()
     int focusedX = 0, focusedY = 0;
     if ( trig != nullptr && gridActions.GetFocusedItem(focusedX, focusedY) )
     {
-        Chk::Action & action = trig->action((u8)focusedY);
+        Chk::Action action = trig->action((u8)focusedY);
         u32 cuwpIndex = action.number;
         Chk::Cuwp initialCuwp = CM->triggers.getCuwp(cuwpIndex);
         Chk::Cuwp newCuwp = {};
         if ( CuwpInputDialog::GetCuwp(newCuwp, initialCuwp, getHandle()) )
         {
-            size_t newCuwpIndex = CM->triggers.addCuwp(newCuwp, trigIndex, (size_t)focusedY);
+            size_t newCuwpIndex = CM->triggers.addCuwp(newCuwp, true, trigIndex, (size_t)focusedY);
             if ( newCuwpIndex < Sc::Unit::MaxCuwps )
             {
                 action.number = (u32)newCuwpIndex;
+                CM->triggers.setAction(trigIndex, (size_t)focusedY, action);
                 CM->triggers.setCuwpUsed(newCuwpIndex, true);
                 RefreshWindow(trigIndex);
             }
@@ -1065,7 +1058,7 @@ void TrigActionsWindow::GridEditStart(u16 gridItemX, u16 gridItemY)
     Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
     if ( trig != nullptr )
     {
-        Chk::Action & action = trig->action((u8)gridItemY);
+        const Chk::Action & action = trig->action((u8)gridItemY);
         Chk::Action::ArgType argType = Chk::Action::ArgType::NoType;
         if ( gridItemX == 1 ) // Action Name
             argType = Chk::Action::ArgType::ActionType;
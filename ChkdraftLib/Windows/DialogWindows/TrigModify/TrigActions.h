@@ -53,7 +53,7 @@ class TrigActionsWindow : public WinLib::ClassWindow, public ICndActGridUser
         LRESULT MeasureItem(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
         LRESULT EraseBackground(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
         void ChangeActionType(Chk::Action & action, Chk::Action::Type newType);
-        bool TransformAction(Chk::Action & action, Chk::Action::Type newType, bool refreshImmediately);
+        bool TransformAction(u8 actionNum, Chk::Action::Type newType, bool refreshImmediately);
         void RefreshActionAreas();
         void ClearArgument(Chk::Action & action, u8 argNum, bool refreshImmediately);
         void UpdateActionName(u8 actionNum, const std::string & newText, bool refreshImmediately);
@@ -123,10 +123,11 @@ void TrigConditionsWindow::CndActEnableToggled(u8 conditionNum)
     Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
     if ( conditionNum >= 0 && conditionNum < 16 && trig != nullptr )
     {
-        Chk::Condition & condition = trig->condition(conditionNum);
+        Chk::Condition condition = trig->condition(conditionNum);
         if ( condition.conditionType != Chk::Condition::Type::NoCondition )
         {
             condition.toggleDisabled();
+            CM->triggers.setCondition(trigIndex, conditionNum, condition);
 
             CM->notifyChange(false);
             RefreshWindow(trigIndex);
@@ -269,11 +270,14 @@ void TrigConditionsWindow::ChangeConditionType(Chk::Condition & condition, Chk::
     }
 }
 
-bool TrigConditionsWindow::TransformCondition(Chk::Condition & condition, Chk::Condition::Type conditionType, bool refreshImmediately)
+bool TrigConditionsWindow::TransformCondition(u8 conditionNum, Chk::Condition::Type conditionType, bool refreshImmediately)
 {
-    if ( condition.conditionType != conditionType )
+    Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
+    if ( trig != nullptr && trig->condition(conditionNum).conditionType != conditionType )
     {
+        Chk::Condition condition = trig->condition(conditionNum);
         ChangeConditionType(condition, conditionType);
+        CM->triggers.setCondition(trigIndex, conditionNum, condition);
         if ( refreshImmediately )
             RefreshConditionAreas();
 
@@ -297,16 +301,13 @@ void TrigConditionsWindow::UpdateConditionName(u8 conditionNum, const std::strin
     if ( ttc.parseConditionName(newText, conditionType) || ttc.parseConditionName(suggestions.Take(), conditionType) )
     {
         if ( trig != nullptr )
-        {
-            Chk::Condition & condition = trig->condition(conditionNum);
-            TransformCondition(condition, conditionType, refreshImmediately);
-        }
+            TransformCondition(conditionNum, conditionType, refreshImmediately);
     }
     else if ( newText.length() == 0 )
     {
         if ( trig != nullptr && trig->condition(conditionNum).conditionType != conditionType )
         {
-            trig->deleteCondition(conditionNum);
+            CM->triggers.deleteCondition(trigIndex, conditionNum);
             if ( refreshImmediately )
                 RefreshConditionAreas();
         }
@@ -322,12 +323,14 @@ void TrigConditionsWindow::UpdateConditionArg(u8 conditionNum, u8 argNum, const
     TextTrigCompiler ttc(Settings::useAddressesForMemory, Settings::deathTableStart);
     if ( trig != nullptr )
     {
-        Chk::Condition::Argument argument = Chk::Condition::getClassicArg(trig->condition(conditionNum).conditionType, argNum);
+        Chk::Condition condition = trig->condition(conditionNum);
+        Chk::Condition::Argument argument = Chk::Condition::getClassicArg(condition.conditionType, argNum);
         if ( ( parseChkdStr(ChkdString(newText), rawUpdateText) &&
-               ttc.parseConditionArg(rawUpdateText, argument, trig->condition(conditionNum), CM, chkd.scData, trigIndex, hasSuggestion) ) ||
+               ttc.parseConditionArg(rawUpdateText, argument, condition, CM, chkd.scData, trigIndex, hasSuggestion) ) ||
              ( hasSuggestion && parseChkdStr(ChkdString(suggestionString), rawSuggestText) &&
-               ttc.parseConditionArg(rawSuggestText, argument, trig->condition(conditionNum), CM, chkd.scData, trigIndex, false) ) )
+               ttc.parseConditionArg(rawSuggestText, argument, condition, CM, chkd.scData, trigIndex, false) ) )
         {
+            CM->triggers.setCondition(trigIndex, conditionNum, condition);
             if ( refreshImmediately )
                 RefreshConditionAreas();
         }
@@ -363,7 +366,9 @@ BOOL TrigConditionsWindow::GridItemDeleting(u16 gridItemX, u16 gridItemY)
              trig != nullptr &&
              trig->condition(conditionNum).conditionType != Chk::Condition::Type::NoCondition )
         {
-            ChangeConditionType(trig->condition(conditionNum), Chk::Condition::Type::NoCondition);
+            Chk::Condition condition = trig->condition(conditionNum);
+            ChangeConditionType(condition, Chk::Condition::Type::NoCondition);
+            CM->triggers.setCondition(trigIndex, conditionNum, condition);
         }
         else if ( gridItemX > 1 ) // Condition Arg
         {
@@ -555,23 +560,8 @@ void TrigConditionsWindow::SuggestUnit()
 void TrigConditionsWindow::SuggestLocation()
 {
     if ( CM != nullptr )
-    {
-        suggestions.AddString(std::string("No Location"));
-        size_t numLocations = CM->layers.numLocations();
-        for ( size_t i = 1; i <= numLocations; i++ )
-        {
-            const Chk::LocationPtr loc = CM->layers.getLocation(i);
-            std::shared_ptr<SingleLineChkdString> locationName = loc != nullptr && loc->stringId > 0 ? CM->strings.getLocationName<SingleLineChkdString>(i) : nullptr;
-            if ( locationName != nullptr )
-                suggestions.AddString(*locationName);
-            else if ( !loc->isBlank() )
-            {
-                std::stringstream ssLoc;
-                ssLoc << i;
-                suggestions.AddString(ssLoc.str());
-            }
-        }
-    }
+        suggestions.SetStrings(CM->getLocationNameIndex().get(*CM));
+
     suggestions.Show();
 }
 
@@ -670,7 +660,7 @@ void TrigConditionsWindow::GridEditStart(u16 gridItemX, u16 gridItemY)
     Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
     if ( trig != nullptr )
     {
-        Chk::Condition & condition = trig->condition((u8)gridItemY);
+        const Chk::Condition & condition = trig->condition((u8)gridItemY);
         Chk::Condition::ArgType argType = Chk::Condition::ArgType::NoType;
         if ( gridItemX == 1 ) // Condition Name
             argType = Chk::Condition::ArgType::ConditionType;
@@ -40,7 +40,7 @@ class TrigConditionsWindow : public WinLib::ClassWindow, public ICndActGridUser
         LRESULT MeasureItem(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
         LRESULT EraseBackground(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
         void ChangeConditionType(Chk::Condition & condition, Chk::Condition::Type newType);
-        bool TransformCondition(Chk::Condition & condition, Chk::Condition::Type newType, bool refreshImmediately);
+        bool TransformCondition(u8 conditionNum, Chk::Condition::Type newType, bool refreshImmediately);
         void RefreshConditionAreas();
         void ClearArgument(Chk::Condition & condition, u8 argNum);
         void UpdateConditionName(u8 conditionNum, const std::string & newText, bool refreshImmediately);
@@ -182,7 +182,9 @@ void TrigGeneralWindow::SetPreserveTrigger(bool preserve)
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        trigger->setPreserveTriggerFlagged(preserve);
+        Chk::Trigger editedTrigger = *trigger;
+        editedTrigger.setPreserveTriggerFlagged(preserve);
+        CM->triggers.setTrigger(trigIndex, editedTrigger);
         CM->notifyChange(false);
         RefreshWindow(trigIndex);
     }
@@ -193,7 +195,9 @@ void TrigGeneralWindow::SetDisabledTrigger(bool disabled)
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        trigger->setDisabled(disabled);
+        Chk::Trigger editedTrigger = *trigger;
+        editedTrigger.setDisabled(disabled);
+        CM->triggers.setTrigger(trigIndex, editedTrigger);
         CM->notifyChange(false);
         RefreshWindow(trigIndex);
     }
@@ -204,7 +208,9 @@ void TrigGeneralWindow::SetIgnoreConditionsOnce(bool ignoreConditionsOnce)
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        trigger->setIgnoreConditionsOnce(ignoreConditionsOnce);
+        Chk::Trigger editedTrigger = *trigger;
+        editedTrigger.setIgnoreConditionsOnce(ignoreConditionsOnce);
+        CM->triggers.setTrigger(trigIndex, editedTrigger);
         CM->notifyChange(false);
         RefreshWindow(trigIndex);
     }
@@ -215,7 +221,9 @@ void TrigGeneralWindow::SetIgnoreWaitSkipOnce(bool ignoreWaitSkipOnce)
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        trigger->setIgnoreWaitSkipOnce(ignoreWaitSkipOnce);
+        Chk::Trigger editedTrigger = *trigger;
+        editedTrigger.setIgnoreWaitSkipOnce(ignoreWaitSkipOnce);
+        CM->triggers.setTrigger(trigIndex, editedTrigger);
         CM->notifyChange(false);
         RefreshWindow(trigIndex);
     }
@@ -226,7 +234,9 @@ void TrigGeneralWindow::SetIgnoreMiscActionsOnce(bool ignoreMiscActionsOnce)
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        trigger->setIgnoreMiscActionsOnce(ignoreMiscActionsOnce);
+        Chk::Trigger editedTrigger = *trigger;
+        editedTrigger.setIgnoreMiscActionsOnce(ignoreMiscActionsOnce);
+        CM->triggers.setTrigger(trigIndex, editedTrigger);
         CM->notifyChange(false);
         RefreshWindow(trigIndex);
     }
@@ -237,7 +247,9 @@ void TrigGeneralWindow::SetIgnoreDefeatDraw(bool ignoreDefeatDraw)
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        trigger->setIgnoreDefeatDraw(ignoreDefeatDraw);
+        Chk::Trigger editedTrigger = *trigger;
+        editedTrigger.setIgnoreDefeatDraw(ignoreDefeatDraw);
+        CM->triggers.setTrigger(trigIndex, editedTrigger);
         CM->notifyChange(false);
         RefreshWindow(trigIndex);
     }
@@ -248,7 +260,9 @@ void TrigGeneralWindow::SetPausedTrigger(bool paused)
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        trigger->setPauseFlagged(paused);
+        Chk::Trigger editedTrigger = *trigger;
+        editedTrigger.setPauseFlagged(paused);
+        CM->triggers.setTrigger(trigIndex, editedTrigger);
         CM->notifyChange(false);
         RefreshWindow(trigIndex);
     }
@@ -259,8 +273,14 @@ void TrigGeneralWindow::ParseRawFlagsText()
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        if ( editRawFlags.GetEditBinaryNum(trigger->flags) )
+        u32 flags = trigger->flags;
+        if ( editRawFlags.GetEditBinaryNum(flags) )
+        {
+            Chk::Trigger editedTrigger = *trigger;
+            editedTrigger.flags = flags;
+            CM->triggers.setTrigger(trigIndex, editedTrigger);
             CM->notifyChange(false);
+        }
         
         RefreshWindow(trigIndex);
     }
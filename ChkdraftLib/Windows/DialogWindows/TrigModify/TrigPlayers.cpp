@@ -1,5 +1,6 @@
 #include "TrigPlayers.h"
 #include "../../../Chkdraft.h"
+#include <cstring>
 #include <sstream>
 
 enum_t(Id, u32, {
@@ -182,53 +183,54 @@ void TrigPlayersWindow::CheckBoxUpdated(u16 checkId)
     Chk::TriggerPtr trig = CM->triggers.getTrigger(trigIndex);
     if ( trig != nullptr )
     {
+        Chk::Trigger editedTrigger = *trig;
         if ( checkId >= Id::CHECK_PLAYER1 && checkId <= Id::CHECK_PLAYER8 )
         {
             u8 player = u8(checkId-Id::CHECK_PLAYER1);
             if ( checkMainPlayers[player].isChecked() )
-                trig->owners[player+Sc::Player::Id::Player1] = Chk::Trigger::Owned::Yes;
+                editedTrigger.owners[player+Sc::Player::Id::Player1] = Chk::Trigger::Owned::Yes;
             else
-                trig->owners[player+Sc::Player::Id::Player1] = Chk::Trigger::Owned::No;
+                editedTrigger.owners[player+Sc::Player::Id::Player1] = Chk::Trigger::Owned::No;
         }
         else if ( checkId >= Id::CHECK_FORCE1 && checkId <= Id::CHECK_FORCE4 )
         {
             u8 force = u8(checkId-Id::CHECK_FORCE1);
             if ( checkForces[force].isChecked() )
-                trig->owners[force+Sc::Player::Id::Force1] = Chk::Trigger::Owned::Yes;
+                editedTrigger.owners[force+Sc::Player::Id::Force1] = Chk::Trigger::Owned::Yes;
             else
-                trig->owners[force+Sc::Player::Id::Force1] = Chk::Trigger::Owned::No;
+                editedTrigger.owners[force+Sc::Player::Id::Force1] = Chk::Trigger::Owned::No;
         }
         else if ( checkId == Id::CHECK_ALL_PLAYERS )
         {
             if ( checkAllPlayers.isChecked() )
-                trig->owners[Sc::Player::Id::AllPlayers] = Chk::Trigger::Owned::Yes;
+                editedTrigger.owners[Sc::Player::Id::AllPlayers] = Chk::Trigger::Owned::Yes;
             else
-                trig->owners[Sc::Player::Id::AllPlayers] = Chk::Trigger::Owned::No;
+                editedTrigger.owners[Sc::Player::Id::AllPlayers] = Chk::Trigger::Owned::No;
         }
         else if ( checkId >= Id::CHECK_PLAYER9 && checkId <= Id::CHECK_NEUTRALPLAYERS )
         {
             u8 lowerNonExecutingPlayersId = u8(checkId-Id::CHECK_PLAYER9);
             if ( checkNonExecutingPlayers[lowerNonExecutingPlayersId].isChecked() )
-                trig->owners[checkId-Id::CHECK_PLAYER1] = Chk::Trigger::Owned::Yes;
+                editedTrigger.owners[checkId-Id::CHECK_PLAYER1] = Chk::Trigger::Owned::Yes;
             else
-                trig->owners[checkId-Id::CHECK_PLAYER1] = Chk::Trigger::Owned::No;
+                editedTrigger.owners[checkId-Id::CHECK_PLAYER1] = Chk::Trigger::Owned::No;
         }
         else if ( checkId >= Id::CHECK_UNUSED1 && checkId <= Id::CHECK_NONAVPLAYERS )
         {
             u8 upperNonExecutingPlayersId = u8(checkId-Id::CHECK_UNUSED1+9);
             if ( checkNonExecutingPlayers[upperNonExecutingPlayersId].isChecked() )
             {
-                if ( trig->getExtendedDataIndex() != Chk::ExtendedTrigDataIndex::None )
-                    (u8 &)trig->owners[checkId-Id::CHECK_PLAYER1] |= Chk::Trigger::Owned::Yes;
+                if ( editedTrigger.getExtendedDataIndex() != Chk::ExtendedTrigDataIndex::None )
+                    (u8 &)editedTrigger.owners[checkId-Id::CHECK_PLAYER1] |= Chk::Trigger::Owned::Yes;
                 else
-                    trig->owners[checkId-Id::CHECK_PLAYER1] = Chk::Trigger::Owned::Yes;
+                    editedTrigger.owners[checkId-Id::CHECK_PLAYER1] = Chk::Trigger::Owned::Yes;
             }
             else
             {
-                if ( trig->getExtendedDataIndex() != Chk::ExtendedTrigDataIndex::None )
-                    (u8 &)trig->owners[checkId-Id::CHECK_PLAYER1] &= ~Chk::Trigger::Owned::Yes;
+                if ( editedTrigger.getExtendedDataIndex() != Chk::ExtendedTrigDataIndex::None )
+                    (u8 &)editedTrigger.owners[checkId-Id::CHECK_PLAYER1] &= ~Chk::Trigger::Owned::Yes;
                 else
-                    trig->owners[checkId-Id::CHECK_PLAYER1] = Chk::Trigger::Owned::No;
+                    editedTrigger.owners[checkId-Id::CHECK_PLAYER1] = Chk::Trigger::Owned::No;
             }
         }
         else if ( checkId == Id::CHECK_ALLOWRAWEDIT )
@@ -238,7 +240,9 @@ void TrigPlayersWindow::CheckBoxUpdated(u16 checkId)
             else
                 editRawPlayers.DisableThis();
         }
-        
+
+        if ( std::memcmp(editedTrigger.owners, trig->owners, sizeof(editedTrigger.owners)) != 0 )
+            CM->triggers.setTrigger(trigIndex, editedTrigger);
     }
     RefreshWindow(trigIndex);
 }
@@ -253,8 +257,12 @@ void TrigPlayersWindow::ParseRawPlayers()
     Chk::TriggerPtr trigger = CM->triggers.getTrigger(trigIndex);
     if ( trigger != nullptr )
     {
-        if ( editRawPlayers.GetHexByteString((u8*)&trigger->owners[0], 27) )
+        Chk::Trigger editedTrigger = *trigger;
+        if ( editRawPlayers.GetHexByteString((u8*)&editedTrigger.owners[0], 27) )
+        {
+            CM->triggers.setTrigger(trigIndex, editedTrigger);
             CM->notifyChange(false);
+        }
         
         RefreshWindow(trigIndex);
     }
@@ -13,7 +13,7 @@ bool GuiMap::doAutoBackups = false;
 GuiMap::GuiMap(Clipboard & clipboard, const std::string & filePath)
     : MapFile(filePath), clipboard(clipboard), selections(*this), graphics(*this, selections),
     screenLeft(0), screenTop(0),
-    bitmapHeight(0), bitmapWidth(0), currLayer(Layer::Terrain), currPlayer(0), zoom(1), RedrawMiniMap(true), RedrawMap(true),
+    bitmapHeight(0), bitmapWidth(0), currLayer(Layer::Terrain), currPlayer(0), zoom(1), RedrawMiniMap(true), UpdateMiniMap(false), RedrawMap(true), RecolorMap(false),
     dragging(false), snapLocations(true), locSnapTileOverGrid(true), lockAnywhere(true),
     snapUnits(true), stackUnits(false), mapId(0), unsavedChanges(false), changeLock(false), undos(*this),
     minSecondsBetweenBackups(1800), lastBackupTime(-1)
@@ -27,7 +27,7 @@ GuiMap::GuiMap(Clipboard & clipboard, const std::string & filePath)
 GuiMap::GuiMap(Clipboard & clipboard, FileBrowserPtr<SaveType> fileBrowser)
     : MapFile(fileBrowser), clipboard(clipboard), selections(*this), graphics(*this, selections),
     screenLeft(0), screenTop(0),
-    bitmapHeight(0), bitmapWidth(0), currLayer(Layer::Terrain), currPlayer(0), zoom(1), RedrawMiniMap(true), RedrawMap(true),
+    bitmapHeight(0), bitmapWidth(0), currLayer(Layer::Terrain), currPlayer(0), zoom(1), RedrawMiniMap(true), UpdateMiniMap(false), RedrawMap(true), RecolorMap(false),
     dragging(false), snapLocations(true), locSnapTileOverGrid(true), lockAnywhere(true),
     snapUnits(true), stackUnits(false), mapId(0), unsavedChanges(false), changeLock(false), undos(*this),
     minSecondsBetweenBackups(1800), lastBackupTime(-1)
@@ -41,7 +41,7 @@ GuiMap::GuiMap(Clipboard & clipboard, FileBrowserPtr<SaveType> fileBrowser)
 GuiMap::GuiMap(Clipboard & clipboard, Sc::Terrain::Tileset tileset, u16 width, u16 height)
     : MapFile(tileset, width, height), clipboard(clipboard), selections(*this), graphics(*this, selections),
     screenLeft(0), screenTop(0),
-    bitmapHeight(0), bitmapWidth(0), currLayer(Layer::Terrain), currPlayer(0), zoom(1), RedrawMiniMap(true), RedrawMap(true),
+    bitmapHeight(0), bitmapWidth(0), currLayer(Layer::Terrain), currPlayer(0), zoom(1), RedrawMiniMap(true), UpdateMiniMap(false), RedrawMap(true), RecolorMap(false),
     dragging(false), snapLocations(true), locSnapTileOverGrid(true), lockAnywhere(true),
     snapUnits(true), stackUnits(false), mapId(0), unsavedChanges(false), changeLock(false), undos(*this),
     minSecondsBetweenBackups(1800), lastBackupTime(-1)
@@ -113,9 +113,11 @@ bool GuiMap::SetTile(s32 x, s32 y, u16 tileNum)
     rcTile.top    = y*32-screenTop;
     rcTile.bottom = rcTile.top+32;
 
-    RedrawMap = true;
-    RedrawMiniMap = true;
+    dirtyRegion.invalidateTiles(x, y, x+1, y+1);
+    miniMapRaster.tileChanged(*this, x, y);
+    UpdateMiniMap = true;
     InvalidateRect(getHandle(), &rcTile, true);
+    RedrawWindow(chkd.mainPlot.leftBar.miniMap.getHandle(), NULL, NULL, RDW_INVALIDATE);
     return true;
 }
 
@@ -153,12 +155,8 @@ void GuiMap::setZoom(double newScale)
             chkd.mainToolbar.zoomBox.SetSel(i);
     }
     zoom = newScale;
-    RedrawMap = true;
-    RedrawMiniMap = true;
-
     Scroll(true, true, true);
     UpdateZoomMenuItems();
-    RedrawWindow(getHandle(), NULL, NULL, RDW_INVALIDATE);
 }
 
 u8 GuiMap::getCurrPlayer()
@@ -499,7 +497,7 @@ void GuiMap::selectAll()
                         }
                     }
                     chkd.unitWindow.SetChangeHighlightOnly(false);
-                    Redraw(true);
+                    Redraw(false);
                 }
                 break;
         }
@@ -543,6 +541,7 @@ void GuiMap::deleteSelection()
                             Chk::UnitPtr delUnit = layers.getUnit(index);
                             deletes->Insert(UnitCreateDel::Make(index, *delUnit));
                             layers.deleteUnit(index);
+                            UnitDeleted(index);
                         }
                         undos.AddUndo(deletes);
                     }
@@ -582,7 +581,9 @@ void GuiMap::deleteSelection()
         }
 
         RedrawMap = true;
-        RedrawMiniMap = true;
+        if ( currLayer != Layer::Units ) // Unit deletes update the minimap as they're made
+            RedrawMiniMap = true;
+
         RedrawWindow(getHandle(), NULL, NULL, RDW_INVALIDATE);
     }
 }
@@ -595,7 +596,7 @@ void GuiMap::paste(s32 mapClickX, s32 mapClickY)
 
     clipboard.doPaste(currLayer, xc, yc, *this, undos, stackUnits);
 
-    Redraw(true);
+    Redraw(currLayer != Layer::Units); // Pasted units update the minimap as they're added
 }
 
 void GuiMap::PlayerChanged(u8 newPlayer)
@@ -607,13 +608,14 @@ void GuiMap::PlayerChanged(u8 newPlayer)
         Chk::UnitPtr unit = layers.getUnit(unitIndex);
         unitChanges->Insert(UnitChange::Make(unitIndex, Chk::Unit::Field::Owner, unit->owner));
         unit->owner = newPlayer;
+        RedrawUnit(unitIndex, true);
 
         if ( chkd.unitWindow.getHandle() != nullptr )
             chkd.unitWindow.ChangeUnitsDisplayedOwner(unitIndex, newPlayer);
     }
     chkd.unitWindow.ChangeDropdownPlayer(newPlayer);
     undos.AddUndo(unitChanges);
-    Redraw(true);
+    Redraw(false);
 }
 
 Selections & GuiMap::GetSelections()
@@ -661,7 +663,7 @@ void GuiMap::undo()
             }
             break;
     }
-    Redraw(true);
+    Redraw(currLayer != Layer::Units); // Reversed unit changes update the minimap as they're made
 }
 
 void GuiMap::redo()
@@ -691,7 +693,7 @@ void GuiMap::redo()
             refreshScenario();
             break;
     }
-    Redraw(true);
+    Redraw(currLayer != Layer::Units); // Reversed unit changes update the minimap as they're made
 }
 
 void GuiMap::ChangesMade()
@@ -716,21 +718,7 @@ void GuiMap::SetScreenTop(s32 newScreenTop)
 
 float GuiMap::MiniMapScale(u16 xSize, u16 ySize)
 {
-    if ( xSize >= ySize && xSize > 0 )
-    {
-        if ( 128.0/xSize > 1 )
-            return (float)(128/xSize);
-        else
-            return (float)(128.0/xSize);
-    }
-    else
-    {
-        if ( 128.0/ySize > 1 && ySize > 0 )
-            return (float)(128/ySize);
-        else
-            return (float)(128.0/ySize);
-    }
-    return 1;
+    return MiniMapRaster::scaleFor(xSize, ySize);
 }
 
 bool GuiMap::EnsureBitmapSize(u32 desiredWidth, u32 desiredHeight)
@@ -771,6 +759,8 @@ void GuiMap::PaintMap(GuiMapPtr currMap, bool pasting)
         if ( RedrawMap == true && EnsureBitmapSize(scaledWidth, scaledHeight) )
         {
             RedrawMap = false;
+            RecolorMap = false;
+            dirtyRegion.clear();
 
             mapBuffer.SetSize(GetPaintDc(), scaledWidth, scaledHeight);
             if ( currMap == nullptr || currMap.get() == this ) // Only redraw minimap for active window
@@ -779,9 +769,37 @@ void GuiMap::PaintMap(GuiMapPtr currMap, bool pasting)
             // Terrain, Grid, Units, Sprites, Debug
             graphics.DrawMap(bitmapWidth, bitmapHeight, screenLeft, screenTop, graphicBits, mapBuffer.GetPaintDc(), !lockAnywhere);
         }
+        else if ( !dirtyRegion.isEmpty() && bitmapWidth == scaledWidth && bitmapHeight == scaledHeight )
+        {
+            RecolorMap = false;
+            graphics.DrawMapRegions(dirtyRegion, bitmapWidth, bitmapHeight, screenLeft, screenTop, graphicBits, mapBuffer.GetPaintDc(), !lockAnywhere);
+            dirtyRegion.clear();
+        }
+        else if ( RecolorMap == true && bitmapWidth == scaledWidth && bitmapHeight == scaledHeight )
+        {
+            RecolorMap = false;
+            graphics.RecolorMap(bitmapWidth, bitmapHeight, screenLeft, screenTop, graphicBits, mapBuffer.GetPaintDc(), !lockAnywhere);
+        }
+
+        u8 zoomLevel = graphics.GetZoomLevel();
+        if ( zoomLevel > 0 ) // Zoomed out, stretch the reduced map once to the window then draw text and tools over it in map pixels
+        {
+            toolsBuffer.SetSize(GetPaintDc(), PaintWidth(), PaintHeight());
+            SetStretchBltMode(toolsBuffer.GetPaintDc(), COLORONCOLOR);
+            StretchBlt(toolsBuffer.GetPaintDc(), 0, 0, PaintWidth(), PaintHeight(), mapBuffer.GetPaintDc(), 0, 0,
+                scaledWidth >> zoomLevel, scaledHeight >> zoomLevel, SRCCOPY);
+
+            SetMapMode(toolsBuffer.GetPaintDc(), MM_ANISOTROPIC);
+            SetWindowExtEx(toolsBuffer.GetPaintDc(), scaledWidth, scaledHeight, NULL);
+            SetViewportExtEx(toolsBuffer.GetPaintDc(), PaintWidth(), PaintHeight(), NULL);
+            graphics.DrawMapText(toolsBuffer.GetPaintDc());
+        }
+        else
+        {
+            toolsBuffer.SetSize(GetPaintDc(), scaledWidth, scaledHeight);
+            BitBlt(toolsBuffer.GetPaintDc(), 0, 0, scaledWidth, scaledHeight, mapBuffer.GetPaintDc(), 0, 0, SRCCOPY);
+        }
 
-        toolsBuffer.SetSize(GetPaintDc(), scaledWidth, scaledHeight);
-        BitBlt(toolsBuffer.GetPaintDc(), 0, 0, scaledWidth, scaledHeight, mapBuffer.GetPaintDc(), 0, 0, SRCCOPY);
         if ( currMap == nullptr || currMap.get() == this )
         { // Drag and paste graphics
             graphics.DrawTools(toolsBuffer.GetPaintDc(), toolsBuffer.GetPaintBitmap(), scaledWidth, scaledHeight,
@@ -790,11 +808,20 @@ void GuiMap::PaintMap(GuiMapPtr currMap, bool pasting)
             if ( currLayer != Layer::Locations )
                 DrawSelectingFrame(toolsBuffer.GetPaintDc(), selections, screenLeft, screenTop, bitmapWidth, bitmapHeight, zoom);
         }
-        SetStretchBltMode(GetPaintDc(), HALFTONE);
-        if ( zoom == 1 )
+
+        if ( zoomLevel > 0 )
+        {
+            SetMapMode(toolsBuffer.GetPaintDc(), MM_TEXT);
             BitBlt(GetPaintDc(), 0, 0, PaintWidth(), PaintHeight(), toolsBuffer.GetPaintDc(), 0, 0, SRCCOPY);
+        }
         else
-            StretchBlt(GetPaintDc(), 0, 0, PaintWidth(), PaintHeight(), toolsBuffer.GetPaintDc(), 0, 0, scaledWidth, scaledHeight, SRCCOPY);
+        {
+            SetStretchBltMode(GetPaintDc(), HALFTONE);
+            if ( zoom == 1 )
+                BitBlt(GetPaintDc(), 0, 0, PaintWidth(), PaintHeight(), toolsBuffer.GetPaintDc(), 0, 0, SRCCOPY);
+            else
+                StretchBlt(GetPaintDc(), 0, 0, PaintWidth(), PaintHeight(), toolsBuffer.GetPaintDc(), 0, 0, scaledWidth, scaledHeight, SRCCOPY);
+        }
     }
     WindowsItem::EndPaint();
 }
@@ -803,11 +830,16 @@ void GuiMap::PaintMiniMap(HDC miniMapDc, int miniMapWidth, int miniMapHeight)
 {
     if ( this != nullptr && miniMapDc != NULL )
     {
-        if ( RedrawMiniMap && miniMapBuffer.SetSize(miniMapDc, miniMapWidth, miniMapHeight) )
+        if ( (RedrawMiniMap || UpdateMiniMap) && miniMapBuffer.SetSize(miniMapDc, miniMapWidth, miniMapHeight) )
         {
+            if ( RedrawMiniMap )
+            {
+                miniMapRaster.rebuild(*this, chkd.scData.terrain.get(Scenario::layers.getTileset()), getPalette(),
+                    chkd.scData.tminimap.palette);
+            }
             RedrawMiniMap = false;
-            DrawMiniMap(miniMapBuffer.GetPaintDc(), getPalette(), (u16)Scenario::layers.getTileWidth(), (u16)Scenario::layers.getTileHeight(),
-                MiniMapScale((u16)Scenario::layers.getTileWidth(), (u16)Scenario::layers.getTileHeight()), *this);
+            UpdateMiniMap = false;
+            DrawMiniMap(miniMapBuffer.GetPaintDc(), miniMapRaster);
         }
 
         if ( miniMapBuffer.GetPaintDc() != NULL )
@@ -832,6 +864,94 @@ void GuiMap::Redraw(bool includeMiniMap)
     }
 }
 
+void GuiMap::RedrawView()
+{
+    if ( this != nullptr )
+    {
+        RedrawMap = true;
+        RedrawWindow(getHandle(), NULL, NULL, RDW_INVALIDATE);
+        if ( CM.get() == this ) // The kept minimap is repainted with the new view box, it isn't rebuilt
+            RedrawWindow(chkd.mainPlot.leftBar.miniMap.getHandle(), NULL, NULL, RDW_INVALIDATE);
+    }
+}
+
+void GuiMap::RedrawRegion(const DirtyRegion::Rect & rect, bool includeMiniMap)
+{
+    if ( this != nullptr )
+    {
+        dirtyRegion.invalidate(rect);
+        if ( includeMiniMap )
+            RedrawMiniMap = true;
+
+        RedrawWindow(getHandle(), NULL, NULL, RDW_INVALIDATE);
+    }
+}
+
+void GuiMap::RedrawUnit(size_t unitIndex, bool includeMiniMap)
+{
+    if ( this != nullptr && unitIndex < layers.numUnits() )
+    {
+        if ( includeMiniMap )
+        {
+            miniMapRaster.unitChanged(*this, unitIndex);
+            UpdateMiniMap = true;
+            RedrawWindow(chkd.mainPlot.leftBar.miniMap.getHandle(), NULL, NULL, RDW_INVALIDATE);
+        }
+        Chk::UnitPtr unit = layers.getUnit(unitIndex);
+        RedrawRegion(Graphics::UnitBounds(unit->xc, unit->yc), false);
+    }
+}
+
+void GuiMap::UnitAdded(size_t unitIndex)
+{
+    if ( this != nullptr )
+    {
+        miniMapRaster.unitAdded(*this, unitIndex);
+        UpdateMiniMap = true;
+        RedrawWindow(chkd.mainPlot.leftBar.miniMap.getHandle(), NULL, NULL, RDW_INVALIDATE);
+    }
+}
+
+void GuiMap::UnitDeleted(size_t unitIndex)
+{
+    if ( this != nullptr )
+    {
+        miniMapRaster.unitRemoved(unitIndex);
+        UpdateMiniMap = true;
+        RedrawWindow(chkd.mainPlot.leftBar.miniMap.getHandle(), NULL, NULL, RDW_INVALIDATE);
+    }
+}
+
+void GuiMap::UnitIndexMoved(size_t oldIndex, size_t newIndex)
+{
+    if ( this != nullptr )
+    {
+        miniMapRaster.unitRemoved(oldIndex);
+        miniMapRaster.unitAdded(*this, newIndex);
+        UpdateMiniMap = true;
+        RedrawWindow(chkd.mainPlot.leftBar.miniMap.getHandle(), NULL, NULL, RDW_INVALIDATE);
+    }
+}
+
+void GuiMap::PlayerColorChanged(size_t player)
+{
+    if ( this != nullptr )
+    {
+        miniMapRaster.playerColorChanged(*this, player);
+        UpdateMiniMap = true;
+        Redraw(false);
+    }
+}
+
+void GuiMap::Recolor()
+{
+    if ( this != nullptr )
+    {
+        RecolorMap = true;
+        RedrawWindow(getHandle(), NULL, NULL, RDW_INVALIDATE);
+    }
+}
+
 void GuiMap::ValidateBorder(s32 screenWidth, s32 screenHeight)
 {
     if ( screenLeft < 0 )
@@ -1202,7 +1322,7 @@ void GuiMap::Scroll(bool scrollX, bool scrollY, bool validateBorder)
         scrollbars.nPage = screenHeight;
         SetScrollInfo(getHandle(), SB_VERT, &scrollbars, true);
     }
-    Redraw(true);
+    RedrawView();
 }
 
 void GuiMap::setMapId(u16 mapId)
@@ -1327,6 +1447,11 @@ ChkdPalette & GuiMap::getPalette()
     return graphics.getPalette();
 }
 
+LocationNameIndex & GuiMap::getLocationNameIndex()
+{
+    return locationNameIndex;
+}
+
 LRESULT GuiMap::WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
     switch ( msg )
@@ -1374,7 +1499,6 @@ LRESULT GuiMap::HorizontalScroll(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lPar
             break;
     }
     Scroll(true, false, true);
-    Redraw(true);
     return 0;
 }
 
@@ -1401,7 +1525,6 @@ LRESULT GuiMap::VerticalScroll(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam
             break;
     }
     Scroll(false, true, true);
-    Redraw(true);
     return 0;
 }
 
@@ -1417,7 +1540,7 @@ void GuiMap::ActivateMap(HWND hWnd)
     if ( hWnd != NULL )
     {
         chkd.maps.Focus(hWnd);
-        Redraw(true);
+        RedrawView(); // This map's minimap raster is kept current, activating it only repaints
         chkd.maps.UpdateTreeView();
     }
 }
@@ -1440,7 +1563,7 @@ void GuiMap::RButtonUp()
 {
     chkd.maps.endPaste();
     ClipCursor(NULL);
-    Redraw(true);
+    Redraw(false);
 }
 
 void GuiMap::LButtonDoubleClick(int x, int y)
@@ -1900,7 +2023,7 @@ void GuiMap::LocationLButtonUp(HWND hWnd, int mapX, int mapY, WPARAM wParam)
                     }
                 }
                 //undos().submitUndo();
-                Redraw(false);
+                Recolor();
                 if ( chkd.locationWindow.getHandle() != NULL )
                     chkd.locationWindow.RefreshLocationInfo();
             }
@@ -1912,7 +2035,7 @@ void GuiMap::LocationLButtonUp(HWND hWnd, int mapX, int mapY, WPARAM wParam)
         if ( chkd.locationWindow.getHandle() != NULL )
             chkd.locationWindow.RefreshLocationInfo();
     
-        Redraw(false);
+        Recolor();
     }
     selections.setLocationFlags(LocSelFlags::None);
 }
@@ -1933,6 +2056,9 @@ void GuiMap::UnitLButtonUp(HWND hWnd, int mapX, int mapY, WPARAM wParam)
             
             chkd.unitWindow.SetChangeHighlightOnly(false);
         }
+        for ( u16 unitIndex : selections.getUnits() )
+            RedrawUnit(unitIndex, false);
+
         selections.removeUnits();
         chkd.unitWindow.UpdateEnabledState();
     }
@@ -1969,6 +2095,8 @@ void GuiMap::UnitLButtonUp(HWND hWnd, int mapX, int mapY, WPARAM wParam)
             else
                 selections.addUnit((u16)i);
 
+            RedrawUnit(i, false);
+
             if ( chkd.unitWindow.getHandle() != nullptr )
             {
                 chkd.unitWindow.SetChangeHighlightOnly(true);
@@ -1982,7 +2110,6 @@ void GuiMap::UnitLButtonUp(HWND hWnd, int mapX, int mapY, WPARAM wParam)
             chkd.unitWindow.UpdateEnabledState();
         }
     }
-    Redraw(true);
 }
 
 LRESULT GuiMap::ConfirmWindowClose(HWND hWnd)
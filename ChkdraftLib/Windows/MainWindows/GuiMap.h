@@ -70,6 +70,14 @@ class GuiMap : public MapFile, public WinLib::ClassWindow, public IObserveUndos
                     void PaintMap(GuiMapPtr currMap, bool pasting);
                     void PaintMiniMap(HDC miniMapDc, int miniMapWidth, int miniMapHeight);
                     void Redraw(bool includeMiniMap);
+                    void RedrawView(); // Redraws the map after scrolling or zooming, the minimap is only repainted with the new view box
+                    void RedrawRegion(const DirtyRegion::Rect & rect, bool includeMiniMap); // Redraws only the part of the map (in map pixels) within rect
+                    void RedrawUnit(size_t unitIndex, bool includeMiniMap); // Redraws only the area a unit is drawn within, call after the unit changes
+                    void UnitAdded(size_t unitIndex); // Updates the minimap, call after a unit is added or inserted at unitIndex
+                    void UnitDeleted(size_t unitIndex); // Updates the minimap, call after the unit at unitIndex is deleted
+                    void UnitIndexMoved(size_t oldIndex, size_t newIndex); // Updates the minimap, call after a unit is moved from oldIndex to newIndex
+                    void PlayerColorChanged(size_t player); // Redraws the map and updates the minimap after a player's color changes
+                    void Recolor(); // Recomposes the map, e.g. after colors cycle or locations change, without redrawing terrain, units or sprites
                     void ValidateBorder(s32 screenWidth, s32 screenHeight);
 
                     bool SetGridSize(s16 xSize, s16 ySize);
@@ -124,6 +132,7 @@ class GuiMap : public MapFile, public WinLib::ClassWindow, public IObserveUndos
                     static void SetAutoBackup(bool doAutoBackups);
 
                     ChkdPalette & getPalette();
+                    LocationNameIndex & getLocationNameIndex(); // Location suggestions, updated in place when locations are renamed
 
 
     protected:
@@ -172,13 +181,17 @@ class GuiMap : public MapFile, public WinLib::ClassWindow, public IObserveUndos
                     ChkdBitmap graphicBits;
                     s32 screenLeft, screenTop;
                     u32 bitmapWidth, bitmapHeight;
-                    bool RedrawMiniMap, RedrawMap;
+                    bool RedrawMiniMap, UpdateMiniMap, RedrawMap, RecolorMap;
+                    MiniMapRaster miniMapRaster; // Rebuilt when RedrawMiniMap is set, kept up to date by change notifications otherwise
+                    DirtyRegion dirtyRegion; // Parts of the map (in map pixels) that need to be redrawn
                     WinLib::PaintBuffer miniMapBuffer, mapBuffer, toolsBuffer;
 
                     static bool doAutoBackups;
                     double minSecondsBetweenBackups; // The smallest interval between consecutive backups
                     time_t lastBackupTime; // -1 if there are no previous backups
 
+                    LocationNameIndex locationNameIndex;
+
                     GuiMap();
 };
 
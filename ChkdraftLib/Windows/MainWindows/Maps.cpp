@@ -664,6 +664,7 @@ bool Maps::RemoveMap(std::shared_ptr<GuiMap> guiMap)
             currentlyActiveMap = nullptr;
 
         std::string mapFilePath = guiMap->getFilePath();
+        ReleaseScenarioView(toDelete);
         openMaps.erase(toDelete);
         logger.info() << "Closed map [ID:" << toDelete << "] " << (mapFilePath.empty() ? "(Untitled)" : mapFilePath.c_str()) << std::endl;
         return true;
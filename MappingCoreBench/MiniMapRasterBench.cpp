@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+Sc::Terrain::Tiles testTiles() // Eight tile groups whose tiles are solid or striped palette colors
+{
+    Sc::Terrain::Tiles tiles {};
+    tiles.miniTilePixels.resize(32);
+    for ( size_t i=0; i<tiles.miniTilePixels.size(); i++ )
+    {
+        for ( size_t y=0; y<8; y++ )
+        {
+            for ( size_t x=0; x<8; x++ )
+                tiles.miniTilePixels[i].wpeIndex[y][x] = u8(i%2 == 0 ? i : (x%2 == 0 ? i : i*3));
+        }
+    }
+    tiles.tileGraphics.resize(16);
+    for ( size_t i=0; i<tiles.tileGraphics.size(); i++ )
+    {
+        for ( size_t y=0; y<4; y++ )
+        {
+            for ( size_t x=0; x<4; x++ )
+                tiles.tileGraphics[i].miniTileGraphics[y][x].graphics = Sc::Terrain::TileGraphics::MiniTileGraphics::Graphics(u16(((i+x+y)%32) << 1));
+        }
+    }
+    tiles.tileGroups.resize(8);
+    for ( size_t i=0; i<tiles.tileGroups.size(); i++ )
+    {
+        for ( size_t member=0; member<16; member++ )
+            tiles.tileGroups[i].megaTileIndex[member] = u16((i+member)%16);
+    }
+    return tiles;
+}
+
+MiniMapRaster::Palette testMiniMapPalette()
+{
+    MiniMapRaster::Palette palette {};
+    for ( size_t i=0; i<Sc::NumColors; i++ )
+    {
+        palette[i].red = u8(i);
+        palette[i].green = u8(255-i);
+        palette[i].blue = u8(i*7);
+    }
+    return palette;
+}
+
+std::vector<Sc::SystemColor> testMiniMapColors()
+{
+    std::vector<Sc::SystemColor> colors(24);
+    for ( size_t i=0; i<colors.size(); i++ )
+    {
+        colors[i].red = 255;
+        colors[i].green = u8(i*10);
+        colors[i].blue = u8(i);
+    }
+    return colors;
+}
+
+Chk::UnitPtr testUnit(u16 xc, u16 yc, u8 owner)
+{
+    Chk::UnitPtr unit = Chk::UnitPtr(new Chk::Unit());
+    std::memset(unit.get(), 0, sizeof(Chk::Unit));
+    unit->xc = xc;
+    unit->yc = yc;
+    unit->owner = owner;
+    return unit;
+}
+
+void expectSameBitmap(const MiniMapRaster & expected, const MiniMapRaster & actual)
+{
+    const std::vector<Sc::SystemColor> & expectedBitmap = expected.getBitmap();
+    const std::vector<Sc::SystemColor> & actualBitmap = actual.getBitmap();
+    ASSERT_EQ(expectedBitmap.size(), actualBitmap.size());
+    size_t numDifferent = 0;
+    for ( size_t i=0; i<expectedBitmap.size(); i++ )
+    {
+        if ( expectedBitmap[i].red != actualBitmap[i].red || expectedBitmap[i].green != actualBitmap[i].green ||
+            expectedBitmap[i].blue != actualBitmap[i].blue )
+        {
+            numDifferent++;
+        }
+    }
+    EXPECT_EQ(0, numDifferent);
+}
+
+TEST(MiniMapRasterBench, TileEdit)
+{
+    constexpr size_t numEdits = 2000;
+    Sc::Terrain::Tiles tiles = testTiles();
+    MiniMapRaster::Palette palette = testMiniMapPalette();
+    std::vector<Sc::SystemColor> miniMapColors = testMiniMapColors();
+    Scenario scenario(Sc::Terrain::Tileset::Badlands, 256, 256);
+    for ( size_t i=0; i<1000; i++ )
+        scenario.layers.addUnit(testUnit(u16(i*37 % 8192), u16(i*91 % 8192), u8(i % 8)));
+
+    MiniMapRaster incremental, rebuilt;
+    incremental.rebuild(scenario, tiles, palette, miniMapColors);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for ( size_t i=0; i<numEdits; i++ )
+    {
+        scenario.layers.setTile(i*13 % 256, i*7 % 256, u16(i % 128));
+        incremental.tileChanged(scenario, i*13 % 256, i*7 % 256);
+    }
+    auto incrementalFinish = std::chrono::high_resolution_clock::now();
+    for ( size_t i=0; i<numEdits/20; i++ ) // Rebuilding is far slower, time a fraction of the edits and scale up
+    {
+        scenario.layers.setTile(i*13 % 256, i*7 % 256, u16(i % 128));
+        rebuilt.rebuild(scenario, tiles, palette, miniMapColors);
+    }
+    auto rebuildFinish = std::chrono::high_resolution_clock::now();
+
+    rebuilt.rebuild(scenario, tiles, palette, miniMapColors);
+    expectSameBitmap(rebuilt, incremental);
+    std::cout << "[ BENCHMARK] " << numEdits << " minimap tile edits in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(incrementalFinish-start).count() << "ms incrementally, ~"
+        << 20*std::chrono::duration_cast<std::chrono::milliseconds>(rebuildFinish-incrementalFinish).count() << "ms with full rebuilds" << std::endl;
+}
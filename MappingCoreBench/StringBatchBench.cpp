@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void stringBatchBenchUse(Scenario & scenario, size_t userIndex, size_t stringId) // Puts the string to use in a trigger action, adding triggers as needed
+{
+    while ( scenario.triggers.numTriggers() <= userIndex/Chk::Trigger::MaxActions )
+        scenario.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger()));
+
+    Chk::Action action = scenario.triggers.getTrigger(userIndex/Chk::Trigger::MaxActions)->actions[userIndex%Chk::Trigger::MaxActions];
+    action.actionType = Chk::Action::Type::DisplayTextMessage;
+    action.stringId = u32(stringId);
+    scenario.triggers.setAction(userIndex/Chk::Trigger::MaxActions, userIndex%Chk::Trigger::MaxActions, action);
+}
+
+TEST(StringBatchBench, Add)
+{
+    // Adding the strings of a text trigger file introducing many new strings, one string at a time versus in a batch
+    constexpr size_t numStrings = 30000;
+    std::vector<RawString> strs;
+    for ( size_t i=0; i<numStrings; i++ )
+        strs.push_back("Text trigger string " + std::to_string(i));
+
+    Scenario sequential(Sc::Terrain::Tileset::Badlands), batched(Sc::Terrain::Tileset::Badlands);
+    for ( size_t i=0; i<numStrings; i++ )
+    {
+        stringBatchBenchUse(sequential, i, 0);
+        stringBatchBenchUse(batched, i, 0);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<size_t> expectedIds;
+    for ( size_t i=0; i<numStrings; i++ )
+    {
+        expectedIds.push_back(sequential.strings.addString<RawString>(strs[i]));
+        stringBatchBenchUse(sequential, i, expectedIds.back());
+    }
+    auto sequentialFinish = std::chrono::high_resolution_clock::now();
+    std::vector<size_t> stringIds = batched.strings.addStrings<RawString>(strs);
+    for ( size_t i=0; i<numStrings; i++ )
+        stringBatchBenchUse(batched, i, stringIds[i]);
+    auto batchFinish = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(expectedIds, stringIds);
+    std::cout << "[ BENCHMARK] Added " << numStrings << " strings one at a time in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(sequentialFinish-start).count() << "ms, in a batch in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(batchFinish-sequentialFinish).count() << "ms" << std::endl;
+}
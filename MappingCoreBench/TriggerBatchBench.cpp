@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <chrono>
+#include <iostream>
+
+Scenario triggerBatchBenchScenario(size_t numTriggers, size_t extensionEvery, size_t extensionOffset)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    for ( size_t i=0; i<numTriggers; i++ )
+    {
+        Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+        trigger->conditions[0].amount = u32(i); // Identifies the trigger wherever it's moved
+        scenario.triggers.addTrigger(trigger);
+        if ( i % extensionEvery == extensionOffset )
+            scenario.triggers.getTriggerExtension(i, true)->trigNum = u32(i);
+    }
+    return scenario;
+}
+
+void triggerBatchBenchDeleteEveryFifth(Scenario & scenario, size_t numDeleted) // None of the deleted triggers have extensions
+{
+    for ( size_t i=0; i<numDeleted; i++ )
+        scenario.triggers.deleteTrigger(i*4);
+}
+
+TEST(TriggerBatchBench, Delete)
+{
+    // Deleting 10000 of 50000 triggers, one change at a time versus in a batch
+    constexpr size_t numTriggers = 50000, numDeleted = 10000;
+    Scenario unbatched = triggerBatchBenchScenario(numTriggers, 5, 2);
+    Scenario batched = triggerBatchBenchScenario(numTriggers, 5, 2);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    triggerBatchBenchDeleteEveryFifth(unbatched, numDeleted);
+    auto unbatchedFinish = std::chrono::high_resolution_clock::now();
+    Triggers::Batch batch(batched.triggers);
+    triggerBatchBenchDeleteEveryFifth(batched, numDeleted);
+    batch.commit();
+    auto batchedFinish = std::chrono::high_resolution_clock::now();
+
+    ASSERT_EQ(unbatched.triggers.numTriggers(), batched.triggers.numTriggers());
+    for ( size_t i=0; i<unbatched.triggers.numTriggers(); i++ )
+        ASSERT_EQ(unbatched.triggers.getTrigger(i)->conditions[0].amount, batched.triggers.getTrigger(i)->conditions[0].amount);
+
+    std::cout << "[ BENCHMARK] Deleted " << numDeleted << " of " << numTriggers << " triggers one at a time in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(unbatchedFinish-start).count() << "ms, in a batch in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(batchedFinish-unbatchedFinish).count() << "ms" << std::endl;
+}
@@ -0,0 +1,193 @@
+#include "AutocompleteIndex.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+AutocompleteIndex::AutocompleteIndex()
+{
+
+}
+
+AutocompleteIndex::~AutocompleteIndex()
+{
+
+}
+
+void AutocompleteIndex::add(const std::string & str)
+{
+    Entry entry { makeKey(str), str };
+    auto position = std::upper_bound(entries.begin(), entries.end(), entry, before);
+    entries.insert(position, std::move(entry));
+}
+
+void AutocompleteIndex::add(const std::vector<std::string> & strs)
+{
+    size_t numSorted = entries.size();
+    entries.reserve(entries.size() + strs.size());
+    for ( const std::string & str : strs )
+        entries.push_back(Entry { makeKey(str), str });
+
+    std::stable_sort(entries.begin() + numSorted, entries.end(), before);
+    std::inplace_merge(entries.begin(), entries.begin() + numSorted, entries.end(), before);
+}
+
+bool AutocompleteIndex::remove(const std::string & str)
+{
+    size_t index = find(str);
+    if ( index != NoMatch )
+    {
+        entries.erase(entries.begin() + index);
+        return true;
+    }
+    return false;
+}
+
+bool AutocompleteIndex::rename(const std::string & oldStr, const std::string & newStr)
+{
+    if ( remove(oldStr) )
+    {
+        add(newStr);
+        return true;
+    }
+    return false;
+}
+
+void AutocompleteIndex::clear()
+{
+    entries.clear();
+}
+
+bool AutocompleteIndex::empty() const
+{
+    return entries.empty();
+}
+
+size_t AutocompleteIndex::size() const
+{
+    return entries.size();
+}
+
+const std::string & AutocompleteIndex::at(size_t index) const
+{
+    if ( index < entries.size() )
+        return entries[index].str;
+    else
+        throw std::out_of_range("Index " + std::to_string(index) + " is past the end of an autocomplete index with " + std::to_string(entries.size()) + " strings!");
+}
+
+size_t AutocompleteIndex::find(const std::string & str) const
+{
+    Entry entry { makeKey(str), str };
+    size_t index = lowerBound(entry);
+    return index < entries.size() && entries[index].str == str ? index : NoMatch;
+}
+
+void AutocompleteIndex::prefixRange(const std::string & prefix, size_t & first, size_t & last) const
+{
+    std::string key = makeKey(prefix);
+    first = lowerBound(Entry { key, std::string() });
+    last = first;
+    while ( last < entries.size() && startsWith(entries[last].key, key) )
+        last++;
+}
+
+size_t AutocompleteIndex::firstStartingWith(const std::string & prefix) const
+{
+    std::string key = makeKey(prefix);
+    size_t index = lowerBound(Entry { key, std::string() });
+    return index < entries.size() && startsWith(entries[index].key, key) ? index : NoMatch;
+}
+
+size_t AutocompleteIndex::nearest(const std::string & str, size_t maxEdits) const
+{
+    size_t index = firstStartingWith(str);
+    if ( index != NoMatch || str.empty() )
+        return index;
+
+    std::string key = makeKey(str);
+    for ( size_t i=0; i<entries.size(); i++ )
+    {
+        if ( wordStartsWith(entries[i].key, key) )
+            return i;
+    }
+
+    size_t bestIndex = NoMatch,
+        bestEdits = maxEdits + 1;
+    std::vector<size_t> row, prevRow;
+    for ( size_t i=0; i<entries.size() && bestEdits > 1; i++ ) // No string starts with str so one edit is the best possible
+    {
+        size_t edits = prefixEdits(entries[i].key, key, bestEdits - 1, row, prevRow);
+        if ( edits < bestEdits )
+        {
+            bestIndex = i;
+            bestEdits = edits;
+        }
+    }
+    return bestIndex;
+}
+
+std::string AutocompleteIndex::makeKey(const std::string & str)
+{
+    std::string key(str);
+    for ( char & c : key )
+    {
+        if ( c >= 'A' && c <= 'Z' )
+            c += 'a' - 'A';
+    }
+    return key;
+}
+
+bool AutocompleteIndex::before(const Entry & lhs, const Entry & rhs)
+{
+    int keyComparison = lhs.key.compare(rhs.key);
+    return keyComparison < 0 || (keyComparison == 0 && lhs.str < rhs.str);
+}
+
+bool AutocompleteIndex::startsWith(const std::string & str, const std::string & prefix)
+{
+    return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool AutocompleteIndex::wordStartsWith(const std::string & str, const std::string & prefix)
+{
+    for ( size_t i=1; i+prefix.size() <= str.size(); i++ )
+    {
+        char prev = str[i-1];
+        bool wordStart = !((prev >= 'a' && prev <= 'z') || (prev >= '0' && prev <= '9') || (u8)prev >= 128);
+        if ( wordStart && str.compare(i, prefix.size(), prefix) == 0 )
+            return true;
+    }
+    return false;
+}
+
+size_t AutocompleteIndex::prefixEdits(const std::string & str, const std::string & text, size_t maxEdits, std::vector<size_t> & row, std::vector<size_t> & prevRow)
+{
+    // prevRow[j] holds the edits between the text so far and the first j characters of str, the fewest in the last row is the answer
+    size_t numColumns = std::min(str.size(), text.size() + maxEdits) + 1;
+    row.resize(numColumns);
+    prevRow.resize(numColumns);
+    for ( size_t j=0; j<numColumns; j++ )
+        prevRow[j] = j;
+
+    for ( size_t i=1; i<=text.size(); i++ )
+    {
+        row[0] = i;
+        size_t rowMin = i;
+        for ( size_t j=1; j<numColumns; j++ )
+        {
+            size_t substitution = prevRow[j-1] + (str[j-1] == text[i-1] ? 0 : 1);
+            row[j] = std::min(substitution, std::min(prevRow[j], row[j-1]) + 1);
+            rowMin = std::min(rowMin, row[j]);
+        }
+        if ( rowMin > maxEdits ) // Every later row is at least this far
+            return maxEdits + 1;
+
+        std::swap(row, prevRow);
+    }
+    return *std::min_element(prevRow.begin(), prevRow.end());
+}
+
+size_t AutocompleteIndex::lowerBound(const Entry & entry) const
+{
+    return size_t(std::lower_bound(entries.begin(), entries.end(), entry, before) - entries.begin());
+}
@@ -0,0 +1,59 @@
+#ifndef AUTOCOMPLETEINDEX_H
+#define AUTOCOMPLETEINDEX_H
+#include "Basics.h"
+#include <string>
+#include <vector>
+
+/**
+    An autocomplete index holds strings in case-insensitive alphabetical order alongside a lower-cased copy of each, so the
+    strings starting with some text are one contiguous range found by binary search rather than a walk through every string
+
+    Near matches are for text that doesn't start any string: a string with a later word starting with the text is preferred
+    (so "marine" finds "Terran Marine"), then the string that starts with the fewest edits (insertions, deletions or
+    substitutions) to the text, up to a maximum number of edits
+
+    Strings can be added, removed and renamed as the names they come from change without rebuilding the index, adding many
+    strings at once sorts them together and merges them in rather than inserting them one at a time
+*/
+
+class AutocompleteIndex
+{
+    public:
+        static constexpr size_t NoMatch = size_t(-1);
+        static constexpr size_t DefaultMaxEdits = 2;
+
+        AutocompleteIndex();
+        virtual ~AutocompleteIndex();
+
+        void add(const std::string & str); // Duplicates are kept
+        void add(const std::vector<std::string> & strs);
+        bool remove(const std::string & str); // Removes one copy of str, returns false if str isn't present
+        bool rename(const std::string & oldStr, const std::string & newStr); // Replaces one copy of oldStr with newStr
+        void clear();
+
+        bool empty() const;
+        size_t size() const;
+        const std::string & at(size_t index) const; // Strings are indexed in case-insensitive alphabetical order
+
+        size_t find(const std::string & str) const; // Gets the index of a string exactly matching str, or NoMatch
+        void prefixRange(const std::string & prefix, output_param size_t & first, output_param size_t & last) const; // [first, last) start with prefix
+        size_t firstStartingWith(const std::string & prefix) const; // NoMatch if no string starts with prefix
+        size_t nearest(const std::string & str, size_t maxEdits = DefaultMaxEdits) const; // NoMatch if nothing is near
+
+    private:
+        struct Entry {
+            std::string key; // Lower-cased str, entries are sorted by key then str
+            std::string str;
+        };
+        std::vector<Entry> entries;
+
+        static std::string makeKey(const std::string & str);
+        static bool before(const Entry & lhs, const Entry & rhs);
+        static bool startsWith(const std::string & str, const std::string & prefix);
+        static bool wordStartsWith(const std::string & str, const std::string & prefix); // Whether a word after the first starts with prefix
+        static size_t prefixEdits(const std::string & str, const std::string & text, size_t maxEdits, std::vector<size_t> & row, std::vector<size_t> & prevRow); // Fewest edits to make text a prefix of str, > maxEdits if too many
+
+        size_t lowerBound(const Entry & entry) const;
+};
+
+#endif
@@ -686,63 +686,39 @@ inline void Chk::Action::markUsedBriefingStrings(std::bitset<Chk::MaxStrings> &
     }
 }
 
-void Chk::Action::remapLocationIds(const std::map<u32, u32> & locationIdRemappings)
+void Chk::Action::remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings)
 {
     if ( actionType < NumActionTypes )
     {
         if ( actionUsesLocationArg[actionType] )
-        {
-            auto found = locationIdRemappings.find(locationId);
-            if ( found != locationIdRemappings.end() )
-                locationId = found->second;
-        }
+            locationIdRemappings.remap(locationId);
 
         if ( actionUsesSecondaryLocationArg[actionType] )
-        {
-            auto found = locationIdRemappings.find(locationId);
-            if ( found != locationIdRemappings.end() )
-                locationId = found->second;
-        }
+            locationIdRemappings.remap(number);
     }
 }
 
-void Chk::Action::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void Chk::Action::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     if ( actionType < NumActionTypes )
     {
         if ( actionUsesStringArg[actionType] )
-        {
-            auto found = stringIdRemappings.find(stringId);
-            if ( found != stringIdRemappings.end() )
-                stringId = found->second;
-        }
+            stringIdRemappings.remap(stringId);
 
         if ( actionUsesSoundArg[actionType] )
-        {
-            auto found = stringIdRemappings.find(soundStringId);
-            if ( found != stringIdRemappings.end() )
-                soundStringId = found->second;
-        }
+            stringIdRemappings.remap(soundStringId);
     }
 }
 
-void Chk::Action::remapBriefingStringIds(const std::map<u32, u32> & stringIdRemappings)
+void Chk::Action::remapBriefingStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     if ( actionType < NumBriefingActionTypes )
     {
         if ( briefingActionUsesStringArg[actionType] )
-        {
-            auto found = stringIdRemappings.find(stringId);
-            if ( found != stringIdRemappings.end() )
-                stringId = found->second;
-        }
+            stringIdRemappings.remap(stringId);
 
         if ( briefingActionUsesSoundArg[actionType] )
-        {
-            auto found = stringIdRemappings.find(soundStringId);
-            if ( found != stringIdRemappings.end() )
-                soundStringId = found->second;
-        }
+            stringIdRemappings.remap(soundStringId);
     }
 }
 
@@ -964,6 +940,14 @@ Chk::Condition & Chk::Trigger::condition(size_t conditionIndex)
         throw std::out_of_range("conditionIndex " + std::to_string(conditionIndex) + " exceeds max " + std::to_string(MaxConditions-1));
 }
 
+const Chk::Condition & Chk::Trigger::condition(size_t conditionIndex) const
+{
+    if ( conditionIndex < MaxConditions )
+        return conditions[conditionIndex];
+    else
+        throw std::out_of_range("conditionIndex " + std::to_string(conditionIndex) + " exceeds max " + std::to_string(MaxConditions-1));
+}
+
 Chk::Action & Chk::Trigger::action(size_t actionIndex)
 {
     if ( actionIndex < MaxActions )
@@ -972,6 +956,14 @@ Chk::Action & Chk::Trigger::action(size_t actionIndex)
         throw std::out_of_range("actionIndex " + std::to_string(actionIndex) + " exceeds max " + std::to_string(MaxActions-1));
 }
 
+const Chk::Action & Chk::Trigger::action(size_t actionIndex) const
+{
+    if ( actionIndex < MaxActions )
+        return actions[actionIndex];
+    else
+        throw std::out_of_range("actionIndex " + std::to_string(actionIndex) + " exceeds max " + std::to_string(MaxActions-1));
+}
+
 void Chk::Condition::toggleDisabled()
 {
     if ( (flags & Flags::Disabled) == Flags::Disabled )
@@ -996,16 +988,12 @@ inline void Chk::Condition::markUsedLocations(std::bitset<Chk::TotalLocations+1>
         locationIdUsed[locationId] = true;
 }
 
-void Chk::Condition::remapLocationIds(const std::map<u32, u32> & locationIdRemappings)
+void Chk::Condition::remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings)
 {
     if ( conditionType < NumConditionTypes )
     {
         if ( conditionUsesLocationArg[conditionType] )
-        {
-            auto found = locationIdRemappings.find(locationId);
-            if ( found != locationIdRemappings.end() )
-                locationId = found->second;
-        }
+            locationIdRemappings.remap(locationId);
     }
 }
 
@@ -1031,6 +1019,14 @@ Chk::Trigger::Owned & Chk::Trigger::owned(size_t ownerIndex)
         throw std::out_of_range("ownerIndex " + std::to_string(ownerIndex) + " exceeds max " + std::to_string(MaxOwners-1));
 }
 
+const Chk::Trigger::Owned & Chk::Trigger::owned(size_t ownerIndex) const
+{
+    if ( ownerIndex < MaxOwners )
+        return owners[ownerIndex];
+    else
+        throw std::out_of_range("ownerIndex " + std::to_string(ownerIndex) + " exceeds max " + std::to_string(MaxOwners-1));
+}
+
 Chk::Trigger & Chk::Trigger::operator=(const Trigger & trigger)
 {
     if ( this != &trigger )
@@ -1322,7 +1318,7 @@ void Chk::Trigger::markUsedBriefingStrings(std::bitset<Chk::MaxStrings> & string
         actions[i].markUsedBriefingStrings(stringIdUsed, userMask);
 }
 
-void Chk::Trigger::remapLocationIds(const std::map<u32, u32> & locationIdRemappings)
+void Chk::Trigger::remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings)
 {
     for ( size_t i=0; i<MaxConditions; i++ )
         conditions[i].remapLocationIds(locationIdRemappings);
@@ -1331,13 +1327,13 @@ void Chk::Trigger::remapLocationIds(const std::map<u32, u32> & locationIdRemappi
         actions[i].remapLocationIds(locationIdRemappings);
 }
 
-void Chk::Trigger::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void Chk::Trigger::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     for ( size_t i=0; i<MaxActions; i++ )
         actions[i].remapStringIds(stringIdRemappings);
 }
 
-void Chk::Trigger::remapBriefingStringIds(const std::map<u32, u32> & stringIdRemappings)
+void Chk::Trigger::remapBriefingStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     for ( size_t i=0; i<MaxActions; i++ )
         actions[i].remapBriefingStringIds(stringIdRemappings);
@@ -2,7 +2,10 @@
 #define CHK_H
 #include "Basics.h"
 #include "Sc.h"
+#include <algorithm>
 #include <bitset>
+#include <utility>
+#include <vector>
 
 #undef PlaySound
 
@@ -305,7 +308,88 @@ namespace Chk {
         NoLocation = 0,
         Anywhere = 64
     });
-    
+
+    /**
+        An id remapping table, ids that were not remapped map to themselves and ids beyond the table are never remapped
+
+        Up to MaxSparseRemappings remapped ids are kept sorted by old id and found by binary search, so remapping a few ids (e.g. moving
+        one string) doesn't allocate a table for every id; past that a dense table indexed by the old id is built, so remapping an id
+        is a single array access, letting sections with many id references (e.g. the actions of every trigger) be remapped in one pass
+    */
+    template <size_t TotalIds>
+    class IdRemappings
+    {
+        public:
+            static constexpr size_t MaxSparseRemappings = 64;
+
+            IdRemappings() : numRemapped(0) {}
+
+            bool empty() const { return numRemapped == 0; }
+            size_t size() const { return numRemapped; }
+            bool isRemapped(size_t oldId) const { return (*this)[oldId] != u32(oldId); }
+            u32 operator[](size_t oldId) const {
+                if ( oldId >= TotalIds || numRemapped == 0 )
+                    return u32(oldId);
+                else if ( !newIds.empty() )
+                    return newIds[oldId];
+
+                auto found = std::lower_bound(sparseIds.begin(), sparseIds.end(), u32(oldId), oldIdLess);
+                return found != sparseIds.end() && found->first == u32(oldId) ? found->second : u32(oldId);
+            }
+
+            void set(size_t oldId, size_t newId) {
+                if ( oldId >= TotalIds )
+                    return;
+                else if ( newIds.empty() && (numRemapped < MaxSparseRemappings || isRemapped(oldId) || newId == oldId) )
+                {
+                    auto found = std::lower_bound(sparseIds.begin(), sparseIds.end(), u32(oldId), oldIdLess);
+                    bool wasRemapped = found != sparseIds.end() && found->first == u32(oldId);
+                    if ( newId == oldId && wasRemapped )
+                        sparseIds.erase(found);
+                    else if ( wasRemapped )
+                        found->second = u32(newId);
+                    else if ( newId != oldId )
+                        sparseIds.insert(found, std::make_pair(u32(oldId), u32(newId)));
+
+                    numRemapped = sparseIds.size();
+                    return;
+                }
+                else if ( newIds.empty() ) // Too many remappings to search, build the dense table
+                {
+                    newIds.resize(TotalIds);
+                    for ( size_t id=0; id<TotalIds; id++ )
+                        newIds[id] = u32(id);
+                    for ( const auto & entry : sparseIds )
+                        newIds[entry.first] = entry.second;
+
+                    sparseIds.clear();
+                    sparseIds.shrink_to_fit();
+                }
+
+                bool wasRemapped = newIds[oldId] != u32(oldId);
+                newIds[oldId] = u32(newId);
+                if ( !wasRemapped && newId != oldId )
+                    numRemapped++;
+                else if ( wasRemapped && newId == oldId )
+                    numRemapped--;
+            }
+
+            template <typename IdType>
+            void remap(IdType & id) const {
+                if ( size_t(id) < TotalIds && numRemapped > 0 )
+                    id = IdType((*this)[size_t(id)]);
+            }
+
+        private:
+            std::vector<std::pair<u32, u32>> sparseIds; // The old and new ids of each remapped id sorted by old id, used until the dense table is built
+            std::vector<u32> newIds; // The dense table, empty until there are more than MaxSparseRemappings
+            size_t numRemapped;
+
+            static bool oldIdLess(const std::pair<u32, u32> & entry, u32 oldId) { return entry.first < oldId; }
+    };
+    using StringIdRemappings = IdRemappings<MaxStrings>;
+    using LocationIdRemappings = IdRemappings<TotalLocations+1>;
+
     __declspec(align(1)) struct Location
     {
         enum_t(Elevation, u16, {
@@ -499,7 +583,7 @@ namespace Chk {
         bool isDisabled() const;
         inline bool locationUsed(size_t locationId) const;
         inline void markUsedLocations(std::bitset<Chk::TotalLocations+1> & locationIdUsed) const;
-        void remapLocationIds(const std::map<u32, u32> & locationIdRemappings);
+        void remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings);
         void deleteLocation(size_t locationId);
         static const Argument & getClassicArg(Type conditionType, size_t argIndex);
         static const Argument & getClassicArg(VirtualType conditionType, size_t argIndex);
@@ -798,9 +882,9 @@ namespace Chk {
         inline void markUsedGameStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
         inline void markUsedCommentStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
         inline void markUsedBriefingStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyBriefingTrigger) const;
-        void remapLocationIds(const std::map<u32, u32> & locationIdRemappings);
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
-        void remapBriefingStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
+        void remapBriefingStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteLocation(size_t locationId);
         void deleteString(size_t stringId);
         void deleteBriefingString(size_t stringId);
@@ -869,8 +953,11 @@ namespace Chk {
             No = 0
         });
         Condition & condition(size_t conditionIndex);
+        const Condition & condition(size_t conditionIndex) const;
         Action & action(size_t actionIndex);
+        const Action & action(size_t actionIndex) const;
         Owned & owned(size_t ownerIndex);
+        const Owned & owned(size_t ownerIndex) const;
         Trigger & operator= (const Trigger & trigger);
         void deleteAction(size_t actionIndex, bool alignTop = true);
         void deleteCondition(size_t conditionIndex, bool alignTop = true);
@@ -908,9 +995,9 @@ namespace Chk {
         void markUsedGameStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
         void markUsedCommentStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
         void markUsedBriefingStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyBriefingTrigger) const;
-        void remapLocationIds(const std::map<u32, u32> & locationIdRemappings);
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
-        void remapBriefingStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
+        void remapBriefingStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteLocation(size_t locationId);
         void deleteString(size_t stringId);
         void deleteBriefingString(size_t stringId);
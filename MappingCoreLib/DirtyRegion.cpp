@@ -0,0 +1,196 @@
+#include "DirtyRegion.h"
+#include "Sc.h"
+#include <algorithm>
+#include <limits>
+
+bool DirtyRegion::Rect::isEmpty() const
+{
+    return right <= left || bottom <= top;
+}
+
+s64 DirtyRegion::Rect::width() const
+{
+    return right > left ? s64(right)-s64(left) : 0;
+}
+
+s64 DirtyRegion::Rect::height() const
+{
+    return bottom > top ? s64(bottom)-s64(top) : 0;
+}
+
+s64 DirtyRegion::Rect::area() const
+{
+    return width()*height();
+}
+
+bool DirtyRegion::Rect::intersects(const Rect & other) const
+{
+    return !isEmpty() && !other.isEmpty() && left < other.right && other.left < right && top < other.bottom && other.top < bottom;
+}
+
+bool DirtyRegion::Rect::touches(const Rect & other) const
+{
+    return !isEmpty() && !other.isEmpty() && left <= other.right && other.left <= right && top <= other.bottom && other.top <= bottom;
+}
+
+bool DirtyRegion::Rect::contains(const Rect & other) const
+{
+    return other.isEmpty() || (left <= other.left && other.right <= right && top <= other.top && other.bottom <= bottom);
+}
+
+DirtyRegion::Rect DirtyRegion::Rect::intersection(const Rect & other) const
+{
+    Rect result = { std::max(left, other.left), std::max(top, other.top), std::min(right, other.right), std::min(bottom, other.bottom) };
+    if ( result.isEmpty() )
+        return Rect {};
+    else
+        return result;
+}
+
+DirtyRegion::Rect DirtyRegion::Rect::united(const Rect & other) const
+{
+    if ( isEmpty() )
+        return other;
+    else if ( other.isEmpty() )
+        return *this;
+    else
+        return Rect { std::min(left, other.left), std::min(top, other.top), std::max(right, other.right), std::max(bottom, other.bottom) };
+}
+
+DirtyRegion::DirtyRegion(size_t maxRects) : maxRects(std::max(size_t(1), maxRects)), all(false)
+{
+
+}
+
+DirtyRegion::~DirtyRegion()
+{
+
+}
+
+void DirtyRegion::invalidate(const Rect & rect)
+{
+    if ( all || rect.isEmpty() )
+        return;
+
+    for ( const Rect & existing : rects )
+    {
+        if ( existing.contains(rect) )
+            return;
+    }
+
+    rects.push_back(rect);
+    mergeTouching(rects.size()-1);
+    while ( rects.size() > maxRects )
+        mergeCheapest();
+}
+
+void DirtyRegion::invalidateTiles(s32 left, s32 top, s32 right, s32 bottom)
+{
+    invalidate(tileRect(left, top, right, bottom));
+}
+
+void DirtyRegion::invalidateAll()
+{
+    all = true;
+    rects.clear();
+}
+
+void DirtyRegion::clear()
+{
+    all = false;
+    rects.clear();
+}
+
+bool DirtyRegion::isEmpty() const
+{
+    return !all && rects.empty();
+}
+
+bool DirtyRegion::isAll() const
+{
+    return all;
+}
+
+const std::vector<DirtyRegion::Rect> & DirtyRegion::getRects() const
+{
+    return rects;
+}
+
+s64 DirtyRegion::area() const
+{
+    s64 total = 0;
+    for ( const Rect & rect : rects )
+        total += rect.area();
+
+    return total;
+}
+
+std::vector<DirtyRegion::Rect> DirtyRegion::clip(const Rect & view) const
+{
+    std::vector<Rect> clipped;
+    if ( view.isEmpty() )
+        return clipped;
+    else if ( all )
+        clipped.push_back(view);
+    else
+    {
+        for ( const Rect & rect : rects )
+        {
+            Rect visible = rect.intersection(view);
+            if ( !visible.isEmpty() )
+                clipped.push_back(visible);
+        }
+    }
+    return clipped;
+}
+
+DirtyRegion::Rect DirtyRegion::tileRect(s32 left, s32 top, s32 right, s32 bottom)
+{
+    constexpr s32 pixelsPerTile = s32(Sc::Terrain::PixelsPerTile);
+    return Rect { left*pixelsPerTile, top*pixelsPerTile, right*pixelsPerTile, bottom*pixelsPerTile };
+}
+
+void DirtyRegion::mergeTouching(size_t index)
+{
+    bool merged = true;
+    while ( merged )
+    {
+        merged = false;
+        for ( size_t i=0; i<rects.size(); i++ )
+        {
+            if ( i != index && rects[i].touches(rects[index]) )
+            {
+                rects[index] = rects[index].united(rects[i]);
+                rects.erase(rects.begin()+i);
+                if ( i < index )
+                    index--;
+
+                merged = true;
+                break;
+            }
+        }
+    }
+}
+
+void DirtyRegion::mergeCheapest()
+{
+    size_t first = 0, second = 1;
+    s64 leastWaste = std::numeric_limits<s64>::max();
+    for ( size_t i=0; i<rects.size(); i++ )
+    {
+        for ( size_t j=i+1; j<rects.size(); j++ )
+        {
+            s64 waste = rects[i].united(rects[j]).area() - rects[i].area() - rects[j].area();
+            if ( waste < leastWaste )
+            {
+                leastWaste = waste;
+                first = i;
+                second = j;
+            }
+        }
+    }
+
+    rects[first] = rects[first].united(rects[second]);
+    rects.erase(rects.begin()+second);
+    mergeTouching(first);
+}
@@ -0,0 +1,63 @@
+#ifndef DIRTYREGION_H
+#define DIRTYREGION_H
+#include "Basics.h"
+#include <vector>
+
+/**
+    A dirty region tracks the parts of a view that have been invalidated since it was last drawn so that only those parts are redrawn
+
+    Areas are invalidated in pixel space or in tile space (tiles of Sc::Terrain::PixelsPerTile pixels); overlapping and adjacent rectangles
+    are merged as they're added so the rectangles held never overlap, and once more than maxRects rectangles are held the pair that
+    wastes the least area when joined is merged, keeping the number of separate redraws small no matter how many changes are made
+*/
+
+class DirtyRegion
+{
+    public:
+        struct Rect // A rectangle in pixels, left and top are inclusive while right and bottom are exclusive
+        {
+            s32 left;
+            s32 top;
+            s32 right;
+            s32 bottom;
+
+            bool isEmpty() const;
+            s64 width() const;
+            s64 height() const;
+            s64 area() const;
+            bool intersects(const Rect & other) const;
+            bool touches(const Rect & other) const; // True if the rectangles intersect or share an edge
+            bool contains(const Rect & other) const;
+            Rect intersection(const Rect & other) const;
+            Rect united(const Rect & other) const; // The smallest rectangle containing both rectangles
+        };
+
+        static constexpr size_t DefaultMaxRects = 16;
+
+        DirtyRegion(size_t maxRects = DefaultMaxRects);
+        virtual ~DirtyRegion();
+
+        void invalidate(const Rect & rect); // Invalidates a rectangle in pixel space
+        void invalidateTiles(s32 left, s32 top, s32 right, s32 bottom); // Invalidates the tiles from left, top up to but excluding right, bottom
+        void invalidateAll(); // Invalidates the whole view, regardless of its size
+        void clear();
+
+        bool isEmpty() const;
+        bool isAll() const;
+        const std::vector<Rect> & getRects() const; // The invalidated rectangles (empty if all is invalidated)
+        s64 area() const; // The total area of the invalidated rectangles
+
+        std::vector<Rect> clip(const Rect & view) const; // The invalidated rectangles within view, or the view itself if all is invalidated
+
+        static Rect tileRect(s32 left, s32 top, s32 right, s32 bottom); // Converts tile coordinates to a rectangle in pixel space
+
+    private:
+        size_t maxRects;
+        bool all;
+        std::vector<Rect> rects;
+
+        void mergeTouching(size_t index); // Merges the rectangle at index with any rectangles it touches until none touch
+        void mergeCheapest(); // Merges the pair of rectangles whose union adds the least area
+};
+
+#endif
@@ -1,6 +1,11 @@
 #include "EscapeStrings.h"
 #include <iostream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ESCAPE_STRINGS_SSE2 // Scans for characters needing escapes 16 at a time
+#endif
+
 bool getOneCharHexVal(char character, u8 & value)
 {
     if ( character >= '0' && character <= '9' )
@@ -15,23 +20,23 @@ bool getOneCharHexVal(char character, u8 & value)
     return true;
 }
 
-bool getTwoCharHexVal(const std::string & firstCharPtr, u8 & value)
+bool getTwoCharHexVal(const char* firstChar, u8 & value)
 {
-    if ( firstCharPtr[0] >= '0' && firstCharPtr[0] <= '9' )
-        value = (u8)((firstCharPtr[0] - '0') << 4);
-    else if ( firstCharPtr[0] >= 'A' && firstCharPtr[0] <= 'F' )
-        value = (u8)((firstCharPtr[0] - 'A' + 10) << 4);
-    else if ( firstCharPtr[0] >= 'a' && firstCharPtr[0] <= 'f' )
-        value = (u8)((firstCharPtr[0] - 'a' + 10) << 4);
+    if ( firstChar[0] >= '0' && firstChar[0] <= '9' )
+        value = (u8)((firstChar[0] - '0') << 4);
+    else if ( firstChar[0] >= 'A' && firstChar[0] <= 'F' )
+        value = (u8)((firstChar[0] - 'A' + 10) << 4);
+    else if ( firstChar[0] >= 'a' && firstChar[0] <= 'f' )
+        value = (u8)((firstChar[0] - 'a' + 10) << 4);
     else
         return false;
 
-    if ( firstCharPtr[1] >= '0' && firstCharPtr[1] <= '9' )
-        value += (u8)(firstCharPtr[1] - '0');
-    else if ( firstCharPtr[1] >= 'A' && firstCharPtr[1] <= 'F' )
-        value += (u8)(firstCharPtr[1] - 'A' + 10);
-    else if ( firstCharPtr[1] >= 'a' && firstCharPtr[1] <= 'f' )
-        value += (u8)(firstCharPtr[1] - 'a' + 10);
+    if ( firstChar[1] >= '0' && firstChar[1] <= '9' )
+        value += (u8)(firstChar[1] - '0');
+    else if ( firstChar[1] >= 'A' && firstChar[1] <= 'F' )
+        value += (u8)(firstChar[1] - 'A' + 10);
+    else if ( firstChar[1] >= 'a' && firstChar[1] <= 'f' )
+        value += (u8)(firstChar[1] - 'a' + 10);
     else
         return false;
 
@@ -48,32 +53,89 @@ bool getOneCharOctVal(const char character, u8 & value)
     return false;
 }
 
-bool getTwoCharOctVal(const std::string & firstCharPtr, u8 & value)
+bool getTwoCharOctVal(const char* firstChar, u8 & value)
 {
-    if ( firstCharPtr[0] >= '0' && firstCharPtr[0] <= '7' &&
-        firstCharPtr[1] >= '0' && firstCharPtr[1] <= '7' )
+    if ( firstChar[0] >= '0' && firstChar[0] <= '7' &&
+        firstChar[1] >= '0' && firstChar[1] <= '7' )
     {
-        value = (u8)((firstCharPtr[0] - '0') << 3);
-        value += (u8)(firstCharPtr[1] - '0');
+        value = (u8)((firstChar[0] - '0') << 3);
+        value += (u8)(firstChar[1] - '0');
         return true;
     }
     return false;
 }
 
-bool getThreeCharOctVal(const std::string & firstCharPtr, u8 & value)
+bool getThreeCharOctVal(const char* firstChar, u8 & value)
 {
-    if ( firstCharPtr[0] >= '0' && firstCharPtr[0] <= '7' &&
-        firstCharPtr[1] >= '0' && firstCharPtr[1] <= '7' &&
-        firstCharPtr[2] >= '0' && firstCharPtr[2] <= '7' )
+    if ( firstChar[0] >= '0' && firstChar[0] <= '7' &&
+        firstChar[1] >= '0' && firstChar[1] <= '7' &&
+        firstChar[2] >= '0' && firstChar[2] <= '7' )
     {
-        value = (u8)((firstCharPtr[0] - '0') << 6);
-        value += (u8)((firstCharPtr[1] - '0') << 3);
-        value += (u8)(firstCharPtr[2] - '0');
+        value = (u8)((firstChar[0] - '0') << 6);
+        value += (u8)((firstChar[1] - '0') << 3);
+        value += (u8)(firstChar[2] - '0');
         return true;
     }
     return false;
 }
 
+namespace SpecialChars // Sets of characters the conversions can't copy as they are
+{
+    constexpr u32 Control = 0x1; // Characters < 32 and 127
+    constexpr u32 Quote = 0x2;
+    constexpr u32 Backslash = 0x4;
+    constexpr u32 LessThan = 0x8;
+    constexpr u32 Nul = 0x10;
+}
+
+template <u32 specialChars>
+inline bool isSpecialChar(unsigned char character)
+{
+    return ((specialChars & SpecialChars::Control) && (character < 32 || character == 127)) ||
+        ((specialChars & SpecialChars::Quote) && character == '\"') ||
+        ((specialChars & SpecialChars::Backslash) && character == '\\') ||
+        ((specialChars & SpecialChars::LessThan) && character == '<') ||
+        ((specialChars & SpecialChars::Nul) && character == '\0');
+}
+
+template <u32 specialChars>
+size_t findSpecialChar(const char* str, size_t pos, size_t length) // Gets the position of the first special character at or after pos, or length if there are none
+{
+#ifdef ESCAPE_STRINGS_SSE2
+    for ( ; pos + 16 <= length; pos += 16 ) // Skip over runs of 16 characters containing no special characters
+    {
+        __m128i chars = _mm_loadu_si128((const __m128i*)&str[pos]);
+        __m128i special = _mm_setzero_si128();
+        if ( specialChars & SpecialChars::Control )
+        {
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(chars, _mm_set1_epi8(31)), chars)); // chars <= 31
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(chars, _mm_set1_epi8(127)));
+        }
+        if ( specialChars & SpecialChars::Quote )
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\"')));
+        if ( specialChars & SpecialChars::Backslash )
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\')));
+        if ( specialChars & SpecialChars::LessThan )
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(chars, _mm_set1_epi8('<')));
+        if ( specialChars & SpecialChars::Nul )
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(chars, _mm_setzero_si128()));
+
+        if ( _mm_movemask_epi8(special) != 0 )
+            break; // The special character is found below
+    }
+#endif
+    while ( pos < length && !isSpecialChar<specialChars>((unsigned char)str[pos]) )
+        pos++;
+
+    return pos;
+}
+
+inline void appendHexByte(std::string & str, unsigned char character)
+{
+    str.push_back("0123456789ABCDEF"[character / 16]);
+    str.push_back("0123456789ABCDEF"[character % 16]);
+}
+
 RawString::RawString()
 {
 
@@ -149,9 +211,17 @@ bool makeEscStr(const std::string & inRawString, size_t inRawStringLength, EscSt
     outEscString.clear();
     try
     {
+        const char* rawString = inRawString.c_str();
+        outEscString.reserve(inRawStringLength);
         for ( size_t i = 0; i < inRawStringLength; i++ )
         {
-            unsigned char currChar = inRawString[i];
+            size_t specialPos = findSpecialChar<SpecialChars::Control | SpecialChars::Quote | SpecialChars::Backslash>(rawString, i, inRawStringLength);
+            outEscString.append(&rawString[i], specialPos - i); // Characters before specialPos are added as they are
+            if ( specialPos == inRawStringLength )
+                break;
+
+            i = specialPos;
+            unsigned char currChar = rawString[i];
             if ( currChar == '\n' )
                 outEscString.append("\\n");
             else if ( currChar == '\r' )
@@ -162,23 +232,11 @@ bool makeEscStr(const std::string & inRawString, size_t inRawStringLength, EscSt
                 outEscString.append("\\\"");
             else if ( currChar == '\\' )
                 outEscString.append("\\\\");
-            else if ( currChar < 32 || currChar == 127 )
+            else // currChar < 32 || currChar == 127
             {
-                outEscString.push_back('\\');
-                outEscString.push_back('x');
-
-                if ( currChar / 16 > 9 )
-                    outEscString.push_back(currChar / 16 + 'A' - 10);
-                else
-                    outEscString.push_back(currChar / 16 + '0');
-
-                if ( currChar % 16 > 9 )
-                    outEscString.push_back(currChar % 16 + 'A' - 10);
-                else
-                    outEscString.push_back(currChar % 16 + '0');
+                outEscString.append("\\x");
+                appendHexByte(outEscString, currChar);
             }
-            else
-                outEscString.push_back(currChar);
         }
         return true;
     }
@@ -277,11 +335,18 @@ bool parseEscStr(const EscString & inEscString, RawString & outRawString)
         currChar = '\0';
     try
     {
+        const char* escString = inEscString.c_str();
         outRawString.clear();
-        outRawString = "";
+        outRawString.reserve(strLength);
         for ( size_t i = 0; i < strLength; i++ )
         {
-            currChar = inEscString[i];
+            size_t specialPos = findSpecialChar<SpecialChars::Backslash | SpecialChars::Nul>(escString, i, strLength);
+            outRawString.append(&escString[i], specialPos - i); // Characters before specialPos are added as they are
+            if ( specialPos == strLength )
+                break;
+
+            i = specialPos;
+            currChar = escString[i];
             if ( currChar == '\\' && // Escape sequence detected
                 getSlashEscCodeChar(inEscString, strLength, i, escapedChar, lastEscCharPos) &&
                 escapedChar != '\0' )
@@ -312,17 +377,24 @@ bool parseEscBytes(const EscString & inEscString, std::vector<u8> & outRawBytes)
         currChar = '\0';
     try
     {
+        const char* escString = inEscString.c_str();
         outRawBytes.clear();
+        outRawBytes.reserve(strLength);
         for ( size_t i = 0; i < strLength; i++ )
         {
-            currChar = inEscString[i];
-            if ( currChar == '\\' && // Escape sequence detected
-                getSlashEscCodeChar(inEscString, strLength, i, escapedChar, lastEscCharPos) )
+            size_t specialPos = findSpecialChar<SpecialChars::Backslash>(escString, i, strLength);
+            outRawBytes.insert(outRawBytes.end(), (const u8*)&escString[i], (const u8*)&escString[specialPos]); // Characters before specialPos are added as they are
+            if ( specialPos == strLength )
+                break;
+
+            i = specialPos;
+            currChar = escString[i];
+            if ( getSlashEscCodeChar(inEscString, strLength, i, escapedChar, lastEscCharPos) ) // Escape sequence detected
             {
                 outRawBytes.push_back(escapedChar);
                 i = lastEscCharPos;
             }
-            else // Not a '\\' or no characters follow the '\\'
+            else // No characters follow the '\\'
                 outRawBytes.push_back(currChar);
         }
         return true;
@@ -336,15 +408,23 @@ bool MakeOneLineChkdStr(const std::string & inRawString, size_t inRawStringLengt
 {
     try
     {
+        const char* rawString = inRawString.c_str();
         outChkdString.clear();
+        outChkdString.reserve(inRawStringLength);
         for ( size_t i = 0; i < inRawStringLength; i++ )
         {
-            unsigned char currChar = inRawString[i];
-            if ( currChar == '\r' && i + 1 < inRawStringLength && inRawString[i + 1] == '\n' )
+            size_t specialPos = findSpecialChar<SpecialChars::Control | SpecialChars::LessThan | SpecialChars::Backslash>(rawString, i, inRawStringLength);
+            outChkdString.append(&rawString[i], specialPos - i); // Characters before specialPos are added as they are
+            if ( specialPos == inRawStringLength )
+                break;
+
+            i = specialPos;
+            unsigned char currChar = rawString[i];
+            if ( currChar == '\r' && i + 1 < inRawStringLength && rawString[i + 1] == '\n' )
             {
                 outChkdString.append("\\r");
             }
-            else if ( currChar == '\n' && i != 0 && inRawString[i - 1] == '\r' )
+            else if ( currChar == '\n' && i != 0 && rawString[i - 1] == '\r' )
             {
                 outChkdString.append("\\n");
             }
@@ -355,25 +435,13 @@ bool MakeOneLineChkdStr(const std::string & inRawString, size_t inRawStringLengt
             else if ( currChar < 32 || currChar == 127 )
             {
                 outChkdString.push_back('<');
-
-                if ( currChar / 16 > 9 )
-                    outChkdString.push_back(currChar / 16 + 'A' - 10);
-                else
-                    outChkdString.push_back(currChar / 16 + '0');
-
-                if ( currChar % 16 > 9 )
-                    outChkdString.push_back(currChar % 16 + 'A' - 10);
-                else
-                    outChkdString.push_back(currChar % 16 + '0');
-
+                appendHexByte(outChkdString, currChar);
                 outChkdString.push_back('>');
             }
             else if ( currChar == '<' )
                 outChkdString.append("\\<");
-            else if ( currChar == '\\' )
+            else // currChar == '\\'
                 outChkdString.append("\\\\");
-            else
-                outChkdString.push_back(currChar);
         }
         return true;
     }
@@ -389,34 +457,32 @@ bool makeChkdStr(const std::string & inRawString, size_t inRawStringLength, Chkd
 
     try
     {
+        const char* rawString = inRawString.c_str();
         outChkdString.clear();
+        outChkdString.reserve(inRawStringLength);
         for ( size_t i = 0; i < inRawStringLength; i++ )
         {
-            unsigned char currChar = inRawString[i];
-            bool partOfNewLine = ((currChar == '\r' && i + 1 < inRawStringLength && inRawString[i+1] == '\n') ||
-                (currChar == '\n' && i != 0 && inRawString[i - 1] == '\r'));
+            size_t specialPos = findSpecialChar<SpecialChars::Control | SpecialChars::LessThan | SpecialChars::Backslash>(rawString, i, inRawStringLength);
+            outChkdString.append(&rawString[i], specialPos - i); // Characters before specialPos are added as they are
+            if ( specialPos == inRawStringLength )
+                break;
+
+            i = specialPos;
+            unsigned char currChar = rawString[i];
+            bool partOfNewLine = ((currChar == '\r' && i + 1 < inRawStringLength && rawString[i+1] == '\n') ||
+                (currChar == '\n' && i != 0 && rawString[i - 1] == '\r'));
 
             if ( (currChar < 32 || currChar == 127) && currChar != '\t' && !partOfNewLine )
             {
                 outChkdString.push_back('<');
-
-                if ( currChar / 16 > 9 )
-                    outChkdString.push_back(currChar / 16 + 'A' - 10);
-                else
-                    outChkdString.push_back(currChar / 16 + '0');
-
-                if ( currChar % 16 > 9 )
-                    outChkdString.push_back(currChar % 16 + 'A' - 10);
-                else
-                    outChkdString.push_back(currChar % 16 + '0');
-
+                appendHexByte(outChkdString, currChar);
                 outChkdString.push_back('>');
             }
             else if ( currChar == '<' )
                 outChkdString.append("\\<");
             else if ( currChar == '\\' )
                 outChkdString.append("\\\\");
-            else
+            else // Tabs and paired newline characters
                 outChkdString.push_back(currChar);
         }
         return true;
@@ -478,11 +544,18 @@ bool parseChkdStr(const ChkdString & inChkdString, RawString & outRawString)
         currChar = '\0';
     try
     {
+        const char* chkdString = inChkdString.c_str();
         outRawString.clear();
-        outRawString = "";
+        outRawString.reserve(strLength);
         for ( size_t i = 0; i < strLength; i++ )
         {
-            currChar = inChkdString[i];
+            size_t specialPos = findSpecialChar<SpecialChars::Backslash | SpecialChars::LessThan | SpecialChars::Nul>(chkdString, i, strLength);
+            outRawString.append(&chkdString[i], specialPos - i); // Characters before specialPos are added as they are
+            if ( specialPos == strLength )
+                break;
+
+            i = specialPos;
+            currChar = chkdString[i];
             if ( currChar == '\\' && // Possible slash escape sequence
                 getSlashEscCodeChar(inChkdString, strLength, i, escapedChar, lastEscCharPos) &&
                 escapedChar != '\0' )
@@ -520,10 +593,18 @@ bool parseChkdBytes(const ChkdString & inChkdString, std::vector<u8> & outRawByt
         currChar = '\0';
     try
     {
+        const char* chkdString = inChkdString.c_str();
         outRawBytes.clear();
+        outRawBytes.reserve(strLength);
         for ( size_t i = 0; i < strLength; i++ )
         {
-            currChar = inChkdString[i];
+            size_t specialPos = findSpecialChar<SpecialChars::Backslash | SpecialChars::LessThan>(chkdString, i, strLength);
+            outRawBytes.insert(outRawBytes.end(), (const u8*)&chkdString[i], (const u8*)&chkdString[specialPos]); // Characters before specialPos are added as they are
+            if ( specialPos == strLength )
+                break;
+
+            i = specialPos;
+            currChar = chkdString[i];
             if ( currChar == '\\' && // Possible slash escape sequence
                 getSlashEscCodeChar(inChkdString, strLength, i, escapedChar, lastEscCharPos) )
             {
@@ -537,7 +618,7 @@ bool parseChkdBytes(const ChkdString & inChkdString, std::vector<u8> & outRawByt
                 i = lastEscCharPos;
             }
             else // Not a valid escape sequence
-                outRawBytes.push_back(escapedChar);
+                outRawBytes.push_back(currChar);
         }
         return true;
     }
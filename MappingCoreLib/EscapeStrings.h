@@ -136,13 +136,13 @@ bool parseChkdBytes(const ChkdString & inChkdString, std::vector<u8> & outRawByt
 
 bool getOneCharHexVal(const char character, u8 & value);
 
-bool getTwoCharHexVal(const std::string & firstCharPtr, u8 & value); // firstCharPtr must point to a string at least 2 characters long
+bool getTwoCharHexVal(const char* firstChar, u8 & value); // firstChar must point to a string at least 2 characters long
 
 bool getOneCharOctVal(const char character, u8 & value);
 
-bool getTwoCharOctVal(const std::string & firstCharPtr, u8 & value); // firstCharPtr must point to a string at least 2 characters long
+bool getTwoCharOctVal(const char* firstChar, u8 & value); // firstChar must point to a string at least 2 characters long
 
-bool getThreeCharOctVal(const std::string & firstCharPtr, u8 & value); // firstCharPtr must point to a string at least 3 characters long
+bool getThreeCharOctVal(const char* firstChar, u8 & value); // firstChar must point to a string at least 3 characters long
 
 // TODO: It's very likely these could mostly be unique_ptrs, the scenario file does NOT return pointers to its own strings...
 //       It always builds a copy for which it doesn't retain ownership
@@ -0,0 +1,364 @@
+#ifndef KEYWORDTABLE_H
+#define KEYWORDTABLE_H
+#include "Basics.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+    Keyword and name tables find values by name using a perfect hash: every name is given a slot of its own, so a lookup
+    is one hash of the input, one slot probe and one comparison, without copying the input or allocating
+
+    Slots are assigned by hash-and-displace, names are hashed into small buckets and each bucket (largest first) is given
+    the smallest displacement that moves all of its names into free slots; lookups re-apply their bucket's displacement
+
+    KeywordTable is built at compile time from a fixed list of keywords (e.g. condition names), NameTable is built at
+    runtime from names only known once a map is loaded (e.g. location names)
+*/
+
+namespace PerfectHash
+{
+    static constexpr size_t EmptySlot = size_t(-1);
+    static constexpr u32 MaxDisplacement = 0x1000; // Buckets that can't be placed within this many displacements fail the build
+
+    constexpr char toUpper(char c) { return c >= 'a' && c <= 'z' ? char(c-32) : c; }
+
+    constexpr size_t length(const char* str)
+    {
+        size_t length = 0;
+        while ( str[length] != '\0' )
+            length ++;
+
+        return length;
+    }
+
+    template <bool CaseSensitive>
+    constexpr u64 hash(const char* str, size_t length, u64 seed) // 64-bit FNV-1a, finalized so the low and high halves are both well mixed
+    {
+        u64 hash = 0xCBF29CE484222325ull ^ seed;
+        for ( size_t i=0; i<length; i++ )
+        {
+            hash ^= u64(u8(CaseSensitive ? str[i] : toUpper(str[i])));
+            hash *= 0x100000001B3ull;
+        }
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    template <bool CaseSensitive>
+    constexpr bool equals(const char* lhs, size_t lhsLength, const char* rhs, size_t rhsLength)
+    {
+        if ( lhsLength != rhsLength )
+            return false;
+
+        for ( size_t i=0; i<lhsLength; i++ )
+        {
+            if ( CaseSensitive ? lhs[i] != rhs[i] : toUpper(lhs[i]) != toUpper(rhs[i]) )
+                return false;
+        }
+        return true;
+    }
+
+    constexpr size_t numSlots(size_t numKeys) // The smallest power of two holding every key at a load factor of at most one half
+    {
+        size_t numSlots = 1;
+        while ( numSlots < 2*numKeys )
+            numSlots *= 2;
+
+        return numSlots;
+    }
+
+    constexpr size_t numBuckets(size_t numSlots) { return numSlots >= 4 ? numSlots/4 : 1; }
+
+    constexpr size_t bucket(u64 hash, size_t numBuckets) { return size_t(hash >> 32) & (numBuckets-1); }
+
+    constexpr size_t slot(u64 hash, u32 displacement, size_t numSlots)
+    {
+        u32 mixed = u32(hash) ^ (displacement * 0x9E3779B9u);
+        mixed ^= mixed >> 16;
+        mixed *= 0x85EBCA6Bu;
+        mixed ^= mixed >> 13;
+        mixed *= 0xC2B2AE35u;
+        mixed ^= mixed >> 16;
+        return size_t(mixed) & (numSlots-1);
+    }
+
+    /**
+        Assigns each of the numKeys keys a distinct slot, filling displacements (one per bucket) and slotKeys (the index of the key in each slot or EmptySlot);
+        keysByBucket must hold numKeys entries and bucketStarts numBuckets+1 entries, returns false if two keys in a bucket couldn't be separated
+    */
+    constexpr bool assignSlots(const u64* keyHashes, size_t numKeys, size_t* keysByBucket, size_t* bucketStarts, u32* displacements, size_t numBuckets, size_t* slotKeys, size_t numSlots)
+    {
+        for ( size_t i=0; i<=numBuckets; i++ )
+            bucketStarts[i] = 0;
+
+        for ( size_t key=0; key<numKeys; key++ ) // Count the keys in each bucket
+            bucketStarts[bucket(keyHashes[key], numBuckets)+1] ++;
+
+        for ( size_t i=1; i<=numBuckets; i++ )
+            bucketStarts[i] += bucketStarts[i-1];
+
+        for ( size_t key=0; key<numKeys; key++ ) // Sort the keys by bucket, leaving bucketStarts[i] at the end of bucket i
+            keysByBucket[bucketStarts[bucket(keyHashes[key], numBuckets)] ++] = key;
+
+        for ( size_t i=numBuckets; i>0; i-- )
+            bucketStarts[i] = bucketStarts[i-1];
+
+        bucketStarts[0] = 0;
+        size_t maxBucketSize = 0;
+        for ( size_t i=0; i<numBuckets; i++ )
+        {
+            displacements[i] = 0;
+            maxBucketSize = std::max(maxBucketSize, bucketStarts[i+1] - bucketStarts[i]);
+        }
+
+        for ( size_t i=0; i<numSlots; i++ )
+            slotKeys[i] = EmptySlot;
+
+        for ( size_t bucketSize=maxBucketSize; bucketSize>0; bucketSize-- ) // Place the largest buckets first
+        {
+            for ( size_t bucketIndex=0; bucketIndex<numBuckets; bucketIndex++ )
+            {
+                size_t start = bucketStarts[bucketIndex];
+                if ( bucketStarts[bucketIndex+1] - start != bucketSize )
+                    continue;
+
+                bool placed = false;
+                for ( u32 displacement=0; displacement<MaxDisplacement && !placed; displacement++ )
+                {
+                    placed = true;
+                    for ( size_t i=start; i<start+bucketSize && placed; i++ )
+                    {
+                        size_t slotIndex = slot(keyHashes[keysByBucket[i]], displacement, numSlots);
+                        if ( slotKeys[slotIndex] != EmptySlot )
+                            placed = false;
+
+                        for ( size_t j=start; j<i && placed; j++ )
+                        {
+                            if ( slot(keyHashes[keysByBucket[j]], displacement, numSlots) == slotIndex )
+                                placed = false;
+                        }
+                    }
+
+                    if ( placed )
+                    {
+                        displacements[bucketIndex] = displacement;
+                        for ( size_t i=start; i<start+bucketSize; i++ )
+                            slotKeys[slot(keyHashes[keysByBucket[i]], displacement, numSlots)] = keysByBucket[i];
+                    }
+                }
+
+                if ( !placed )
+                    return false;
+            }
+        }
+        return true;
+    }
+}
+
+template <typename Value>
+struct Keyword
+{
+    const char* name = nullptr;
+    Value value {};
+};
+
+/**
+    A perfect hash table over a fixed list of keywords, built at compile time, names are compared case-insensitively unless CaseSensitive is set
+
+    Declare tables using makeKeywordTable, e.g. "constexpr auto orders = makeKeywordTable<Order>({ { "MOVE", Order::Move }, { "PATROL", Order::Patrol } });"
+*/
+template <typename Value, size_t NumKeywords, bool CaseSensitive = false, u64 Seed = 0>
+class KeywordTable
+{
+    public:
+        static constexpr size_t NumSlots = PerfectHash::numSlots(NumKeywords);
+        static constexpr size_t NumBuckets = PerfectHash::numBuckets(NumSlots);
+
+        constexpr KeywordTable(const Keyword<Value> (& keywords)[NumKeywords])
+        {
+            std::array<u64, NumKeywords> keyHashes {};
+            std::array<size_t, NumKeywords> keysByBucket {};
+            std::array<size_t, NumBuckets+1> bucketStarts {};
+            for ( size_t i=0; i<NumKeywords; i++ )
+            {
+                this->keywords[i] = keywords[i];
+                lengths[i] = PerfectHash::length(keywords[i].name);
+                keyHashes[i] = PerfectHash::hash<CaseSensitive>(keywords[i].name, lengths[i], Seed);
+                maxLength = std::max(maxLength, lengths[i]);
+            }
+
+            for ( size_t i=0; i<NumKeywords; i++ ) // Flag keywords that begin a longer keyword
+            {
+                for ( size_t j=0; j<NumKeywords && !beginsLonger[i]; j++ )
+                {
+                    beginsLonger[i] = lengths[j] > lengths[i] &&
+                        PerfectHash::equals<CaseSensitive>(keywords[i].name, lengths[i], keywords[j].name, lengths[i]);
+                }
+            }
+
+            if ( !PerfectHash::assignSlots(keyHashes.data(), NumKeywords, keysByBucket.data(), bucketStarts.data(), displacements.data(), NumBuckets, slotKeywords.data(), NumSlots) )
+                throw std::logic_error("Keywords could not be separated, the table must be given a different seed!");
+        }
+
+        constexpr size_t size() const { return NumKeywords; }
+        constexpr const Keyword<Value> & operator[](size_t index) const { return keywords[index]; }
+
+        constexpr bool find(const char* name, size_t length, Value & value) const
+        {
+            size_t keywordIndex = slotIndex(name, length);
+            if ( keywordIndex != PerfectHash::EmptySlot && PerfectHash::equals<CaseSensitive>(name, length, keywords[keywordIndex].name, lengths[keywordIndex]) )
+            {
+                value = keywords[keywordIndex].value;
+                return true;
+            }
+            return false;
+        }
+
+        bool find(const std::string & name, Value & value) const { return find(name.c_str(), name.size(), value); }
+
+        /**
+            Finds the longest keyword the name starts with, ignoring any trailing text; a keyword that begins a longer keyword
+            (e.g. "COMMAND" in "COMMANDTHELEAST") only matches the whole name, so a misspelling of the longer keyword isn't taken for it
+        */
+        constexpr bool findPrefix(const char* name, size_t length, Value & value) const
+        {
+            for ( size_t prefixLength = std::min(length, maxLength); prefixLength > 0; prefixLength-- )
+            {
+                size_t keywordIndex = slotIndex(name, prefixLength);
+                if ( keywordIndex != PerfectHash::EmptySlot && (prefixLength == length || !beginsLonger[keywordIndex]) &&
+                    PerfectHash::equals<CaseSensitive>(name, prefixLength, keywords[keywordIndex].name, lengths[keywordIndex]) )
+                {
+                    value = keywords[keywordIndex].value;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool findPrefix(const std::string & name, Value & value) const { return findPrefix(name.c_str(), name.size(), value); }
+
+    private:
+        std::array<Keyword<Value>, NumKeywords> keywords {};
+        std::array<size_t, NumKeywords> lengths {};
+        std::array<bool, NumKeywords> beginsLonger {};
+        size_t maxLength = 0;
+        std::array<u32, NumBuckets> displacements {};
+        std::array<size_t, NumSlots> slotKeywords {};
+
+        constexpr size_t slotIndex(const char* name, size_t length) const // The index of the only keyword that could match name, or EmptySlot
+        {
+            u64 hash = PerfectHash::hash<CaseSensitive>(name, length, Seed);
+            return slotKeywords[PerfectHash::slot(hash, displacements[PerfectHash::bucket(hash, NumBuckets)], NumSlots)];
+        }
+};
+
+template <typename Value, bool CaseSensitive = false, size_t NumKeywords>
+constexpr KeywordTable<Value, NumKeywords, CaseSensitive> makeKeywordTable(const Keyword<Value> (& keywords)[NumKeywords])
+{
+    return KeywordTable<Value, NumKeywords, CaseSensitive>(keywords);
+}
+
+/**
+    A perfect hash table over names added at runtime, names are compared case-sensitively unless CaseSensitive is false
+
+    Add every name then build the table before finding names; when a name is added more than once, the first value added is kept
+*/
+template <typename Value, bool CaseSensitive = true>
+class NameTable
+{
+    public:
+        static constexpr u64 MaxSeeds = 8; // Builds that can't separate the names with this many seeds fail
+
+        NameTable() : seed(0) {}
+
+        void clear()
+        {
+            names.clear();
+            displacements.clear();
+            slotNames.clear();
+        }
+
+        void add(const std::string & name, Value value)
+        {
+            names.push_back(std::make_pair(name, value));
+        }
+
+        bool build()
+        {
+            std::stable_sort(names.begin(), names.end(), [](const std::pair<std::string, Value> & lhs, const std::pair<std::string, Value> & rhs) {
+                return lhs.first.size() < rhs.first.size() || (lhs.first.size() == rhs.first.size() &&
+                    (CaseSensitive ? lhs.first.compare(rhs.first) < 0 : lessIgnoreCase(lhs.first, rhs.first)));
+            });
+            names.erase(std::unique(names.begin(), names.end(), [](const std::pair<std::string, Value> & lhs, const std::pair<std::string, Value> & rhs) {
+                return PerfectHash::equals<CaseSensitive>(lhs.first.c_str(), lhs.first.size(), rhs.first.c_str(), rhs.first.size());
+            }), names.end());
+
+            size_t numNames = names.size();
+            size_t numSlots = PerfectHash::numSlots(numNames);
+            size_t numBuckets = PerfectHash::numBuckets(numSlots);
+            std::vector<u64> nameHashes(numNames);
+            std::vector<size_t> namesByBucket(numNames);
+            std::vector<size_t> bucketStarts(numBuckets+1);
+            displacements.assign(numBuckets, 0);
+            slotNames.assign(numSlots, PerfectHash::EmptySlot);
+            for ( seed=0; seed<MaxSeeds; seed++ )
+            {
+                for ( size_t i=0; i<numNames; i++ )
+                    nameHashes[i] = PerfectHash::hash<CaseSensitive>(names[i].first.c_str(), names[i].first.size(), seed);
+
+                if ( PerfectHash::assignSlots(nameHashes.data(), numNames, namesByBucket.data(), bucketStarts.data(), displacements.data(), numBuckets, slotNames.data(), numSlots) )
+                    return true;
+            }
+            clear();
+            return false;
+        }
+
+        size_t size() const { return names.size(); }
+
+        bool find(const char* name, size_t length, Value & value) const
+        {
+            if ( slotNames.empty() )
+                return false;
+
+            u64 hash = PerfectHash::hash<CaseSensitive>(name, length, seed);
+            size_t nameIndex = slotNames[PerfectHash::slot(hash, displacements[PerfectHash::bucket(hash, displacements.size())], slotNames.size())];
+            if ( nameIndex != PerfectHash::EmptySlot &&
+                PerfectHash::equals<CaseSensitive>(name, length, names[nameIndex].first.c_str(), names[nameIndex].first.size()) )
+            {
+                value = names[nameIndex].second;
+                return true;
+            }
+            return false;
+        }
+
+        bool find(const std::string & name, Value & value) const { return find(name.c_str(), name.size(), value); }
+
+    private:
+        std::vector<std::pair<std::string, Value>> names;
+        std::vector<u32> displacements;
+        std::vector<size_t> slotNames;
+        u64 seed;
+
+        static bool lessIgnoreCase(const std::string & lhs, const std::string & rhs)
+        {
+            for ( size_t i=0; i<lhs.size(); i++ )
+            {
+                char left = PerfectHash::toUpper(lhs[i]);
+                char right = PerfectHash::toUpper(rhs[i]);
+                if ( left != right )
+                    return left < right;
+            }
+            return false;
+        }
+};
+
+#endif
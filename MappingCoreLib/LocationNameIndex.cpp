@@ -0,0 +1,94 @@
+#include "LocationNameIndex.h"
+#include "EscapeStrings.h"
+
+LocationNameIndex::LocationNameIndex() : built(false), epoch(0)
+{
+
+}
+
+LocationNameIndex::~LocationNameIndex()
+{
+
+}
+
+const AutocompleteIndex & LocationNameIndex::get(const Scenario & scenario)
+{
+    if ( !built || epoch != getEpoch(scenario) )
+    {
+        std::vector<std::string> names { "No Location" };
+        size_t numLocations = scenario.layers.numLocations();
+        for ( size_t locationId=1; locationId<=numLocations; locationId++ )
+        {
+            std::string name = getName(scenario, locationId);
+            if ( !name.empty() )
+                names.push_back(name);
+        }
+        index.clear();
+        index.add(names);
+        built = true;
+        epoch = getEpoch(scenario);
+    }
+    return index;
+}
+
+std::string LocationNameIndex::getName(const Scenario & scenario, size_t locationId)
+{
+    const Chk::LocationPtr location = scenario.layers.getLocation(locationId);
+    if ( location != nullptr )
+    {
+        std::shared_ptr<SingleLineChkdString> locationName = location->stringId > 0 ? scenario.strings.getLocationName<SingleLineChkdString>(locationId) : nullptr;
+        if ( locationName != nullptr )
+            return *locationName;
+        else if ( !location->isBlank() )
+            return std::to_string(locationId);
+    }
+    return "";
+}
+
+LocationNameIndex::Rename LocationNameIndex::beginRename(const Scenario & scenario, const std::vector<size_t> & locationIds) const
+{
+    Rename rename { locationIds, {}, built && epoch == getEpoch(scenario), epoch };
+    for ( size_t locationId : locationIds )
+        rename.oldNames.push_back(getName(scenario, locationId));
+
+    return rename;
+}
+
+LocationNameIndex::Rename LocationNameIndex::beginStringRename(const Scenario & scenario, size_t stringId) const
+{
+    std::vector<size_t> locationIds;
+    size_t numLocations = scenario.layers.numLocations();
+    for ( size_t locationId=1; locationId<=numLocations; locationId++ )
+    {
+        if ( scenario.strings.getLocationNameStringId(locationId, Chk::Scope::Game) == stringId ||
+            scenario.strings.getLocationNameStringId(locationId, Chk::Scope::Editor) == stringId )
+        {
+            locationIds.push_back(locationId);
+        }
+    }
+    return beginRename(scenario, locationIds);
+}
+
+void LocationNameIndex::endRename(const Scenario & scenario, const Rename & rename)
+{
+    if ( rename.indexCurrent && epoch == rename.epoch ) // The index wasn't rebuilt since the rename began
+    {
+        for ( size_t i=0; i<rename.locationIds.size(); i++ )
+        {
+            const std::string & oldName = rename.oldNames[i];
+            std::string newName = getName(scenario, rename.locationIds[i]);
+            if ( oldName.empty() && !newName.empty() )
+                index.add(newName);
+            else if ( !oldName.empty() && newName.empty() )
+                index.remove(oldName);
+            else if ( oldName != newName )
+                index.rename(oldName, newName);
+        }
+        epoch = getEpoch(scenario);
+    }
+}
+
+u64 LocationNameIndex::getEpoch(const Scenario & scenario)
+{
+    return scenario.layers.getLocationModificationEpoch() + scenario.strings.getModificationEpoch();
+}
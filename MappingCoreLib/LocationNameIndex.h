@@ -0,0 +1,47 @@
+#ifndef LOCATIONNAMEINDEX_H
+#define LOCATIONNAMEINDEX_H
+#include "Basics.h"
+#include "AutocompleteIndex.h"
+#include "Scenario.h"
+#include <string>
+#include <vector>
+
+/**
+    A location name index holds the location suggestions of a scenario ("No Location", then the name of each named location or
+    the id of each unnamed location in use) in an autocomplete index; the index is built when first used and rebuilt only if the
+    scenario's locations or strings changed since
+
+    Renaming locations between beginRename and endRename updates the index in place instead of rebuilding it, so long as the
+    index was current when the rename began and only the names of the given locations changed in between; any other change made
+    to locations or strings causes a rebuild the next time the index is used
+*/
+
+class LocationNameIndex
+{
+    public:
+        struct Rename {
+            std::vector<size_t> locationIds;
+            std::vector<std::string> oldNames;
+            bool indexCurrent; // Whether the index matched the scenario when the rename began
+            u64 epoch; // The index's epoch when the rename began
+        };
+
+        LocationNameIndex();
+        virtual ~LocationNameIndex();
+
+        const AutocompleteIndex & get(const Scenario & scenario); // Builds the index if it doesn't match the scenario
+        static std::string getName(const Scenario & scenario, size_t locationId); // The suggestion for a location, empty if there is none
+
+        Rename beginRename(const Scenario & scenario, const std::vector<size_t> & locationIds) const; // Call before changing the names of locationIds
+        Rename beginStringRename(const Scenario & scenario, size_t stringId) const; // Call before replacing a string, covers each location it may name
+        void endRename(const Scenario & scenario, const Rename & rename); // Call after the names are changed
+
+    private:
+        AutocompleteIndex index;
+        bool built;
+        u64 epoch; // The sum of the scenario's location and string modification epochs when the index was last made to match
+
+        static u64 getEpoch(const Scenario & scenario);
+};
+
+#endif
@@ -616,10 +616,14 @@ bool MapFile::getSoundStatuses(std::map<size_t/*stringId*/, SoundStatus> & outSo
 {
     std::map<size_t/*stringId*/, u16/*soundIndex*/> soundMap;
     for ( size_t i=0; i<Chk::TotalSounds; i++ )
-        soundMap.insert(std::pair<size_t, u16>(i, (u16)Scenario::triggers.getSoundStringId(i)));
+    {
+        size_t soundStringId = Scenario::triggers.getSoundStringId(i);
+        if ( soundStringId != Chk::StringId::UnusedSound )
+            soundMap.insert(std::pair<size_t, u16>(soundStringId, (u16)i));
+    }
     for ( size_t i=0; i<Scenario::triggers.numTriggers(); i++ )
     {
-        Chk::TriggerPtr trigger = Scenario::triggers.getTrigger(i);
+        const Chk::Trigger* trigger = Scenario::triggers.readTrigger(i);
         for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
         {
             if ( (trigger->actions[actionIndex].actionType == Chk::Action::Type::PlaySound ||
@@ -632,7 +636,7 @@ bool MapFile::getSoundStatuses(std::map<size_t/*stringId*/, SoundStatus> & outSo
     }
     for ( size_t i=0; i<Scenario::triggers.numBriefingTriggers(); i++ )
     {
-        Chk::TriggerPtr trigger = Scenario::triggers.getBriefingTrigger(i);
+        const Chk::Trigger* trigger = Scenario::triggers.readBriefingTrigger(i);
         for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
         {
             if ( (trigger->actions[actionIndex].actionType == Chk::Action::Type::BriefingPlaySound ||
@@ -13,14 +13,27 @@
 #include "Basics.h" // Numerous useful definitions, constants, and utility functions
 #include "sha256.h" // Provides the means to compute sha256 hashes for securing sensitive passwords or keys
 #include "StringBuffer.h" // Provides faster alternatives to std::stringstream
+#include "KeywordTable.h" // Provides perfect hash tables for finding values by name without copying or allocating
+#include "WorkerPool.h" // Runs batches of independent tasks across the available cores
+#include "DirtyRegion.h" // Tracks the parts of a view that need to be redrawn
+#include "UnitSelection.h" // Holds the indexes of selected units and answers whether a unit is selected without searching
+#include "AutocompleteIndex.h" // Holds strings in order so those starting with or near some text are found without checking every string
 
 #include "Chk.h" // Defines all static structures, constants, and enumerations specific to scenario files (.chk)
 #include "EscapeStrings.h" // Defines several string types that extend basic strings in ways useful for mapping purposes
+#include "LocationNameIndex.h" // Holds the location suggestions of a scenario, updated in place when locations are renamed
 #include "MapFile.h" // A map file is a Scenario wrapped inside of an MpqFile (or rarely a standalone Scenario)
+#include "MiniMapRaster.h" // Holds a minimap for a scenario and keeps it up to date as tiles, units and sprites change
 #include "MpqFile.h" // An MPQ file is nothing more than an archive format (like .zip) specialized for StarCraft
+#include "PaletteFramebuffer.h" // Holds color slots for pixels so graphics can be recomposed when palette colors change without being redrawn
+#include "PluginTransport.h" // Lets plugins read a scenario from shared memory and send back patches to the sections they change
 #include "Sc.h" // Contains resources to load assets from StarCraft and defines static structures, constants, and enumerations general to StarCraft
+#include "ScDataCache.h" // Stores decoded StarCraft data in a file keyed by the archives it came from so later loads can skip decoding
 #include "Scenario.h" // Resources for working with scenarios - scenario are the core piece of a map and describe their versioning, strings, player information, terrain, units, locations, properties, triggers and more
+#include "ScenarioValidator.h" // Checks a whole scenario for bad dimensions, terrain, units, sprites, section sizes and references across the available cores
 #include "Sections.h" // Defines sections which encapsulate the storage structures defined in the Chk
+#include "TileMipmaps.h" // Holds tile images reduced for drawing zoomed out views, built as tiles are needed
+#include "TriggerColumns.h" // Holds a read-only structure-of-arrays copy of trigger conditions and actions for scanning many triggers quickly
 
 #include "TextTrigCompiler.h" // Provides the means to compile text triggers into a scenario file
 #include "TextTrigGenerator.h" // Provides the means to turn triggers into text 
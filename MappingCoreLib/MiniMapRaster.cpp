@@ -0,0 +1,357 @@
+#include "MiniMapRaster.h"
+#include <algorithm>
+#include <cmath>
+
+MiniMapRaster::MiniMapRaster() : tiles(nullptr), palette(), tileWidth(0), tileHeight(0), scale(1), xOffset(0), yOffset(0),
+    terrain(Width*Height), overlayKeys(Width*Height), bitmap(Width*Height)
+{
+
+}
+
+MiniMapRaster::~MiniMapRaster()
+{
+
+}
+
+void MiniMapRaster::rebuild(const Scenario & scenario, const Sc::Terrain::Tiles & tiles, const Palette & palette, const std::vector<Sc::SystemColor> & minimapColors)
+{
+    this->tiles = &tiles;
+    this->palette = palette;
+    this->minimapColors = minimapColors;
+    tileWidth = scenario.layers.getTileWidth();
+    tileHeight = scenario.layers.getTileHeight();
+    scale = scaleFor(tileWidth, tileHeight);
+    xOffset = tileWidth > 0 && tileHeight > 0 ? size_t((Width-tileWidth*scale)/2) : 0;
+    yOffset = tileWidth > 0 && tileHeight > 0 ? size_t((Height-tileHeight*scale)/2) : 0;
+
+    tileValueColors.assign(size_t(u16_max)+1, Sc::SystemColor());
+    tileValueCached.assign(size_t(u16_max)+1, false);
+    tileColors.assign(tileWidth*tileHeight, Sc::SystemColor());
+    for ( size_t y=0; y<tileHeight; y++ )
+    {
+        for ( size_t x=0; x<tileWidth; x++ )
+            tileColors[y*tileWidth+x] = tileValueColor(scenario.layers.getTile(x, y));
+    }
+
+    terrain.assign(Width*Height, Sc::SystemColor());
+    if ( tileWidth > 0 && tileHeight > 0 )
+    {
+        for ( size_t yc=0; yc<Height-2*yOffset; yc++ ) // Cycle through all minimap pixel rows
+        {
+            size_t yTile = size_t(float(yc)/scale); // Get the yc of the tile used for the pixel
+            for ( size_t xc=0; xc<Width-2*xOffset; xc++ ) // Cycle through all minimap pixel columns
+            {
+                size_t xTile = size_t(float(xc)/scale); // Get the xc of the tile used for the pixel
+                if ( xTile < tileWidth && yTile < tileHeight )
+                    terrain[(yc+yOffset)*Width + xc+xOffset] = tileColors[yTile*tileWidth + xTile];
+            }
+        }
+    }
+
+    units.clear();
+    sprites.clear();
+    for ( std::vector<u32> & keys : overlayKeys )
+        keys.clear();
+
+    bitmap = terrain;
+    for ( size_t i=0; i<scenario.layers.numUnits(); i++ )
+        units.push_back(unitItem(scenario, i));
+    for ( size_t i=0; i<scenario.layers.numSprites(); i++ )
+        sprites.push_back(spriteItem(scenario, i));
+
+    for ( u32 keyFlag : { u32(0), SpriteKey } ) // Keys are added in drawing order, later items over earlier ones and sprites over units
+    {
+        const std::vector<OverlayItem> & items = keyFlag == SpriteKey ? sprites : units;
+        for ( size_t i=0; i<items.size(); i++ )
+        {
+            if ( items[i].pixel != NoPixel )
+            {
+                overlayKeys[items[i].pixel].push_back(u32(i) | keyFlag);
+                bitmap[items[i].pixel] = items[i].color;
+            }
+        }
+    }
+}
+
+void MiniMapRaster::tileChanged(const Scenario & scenario, size_t tileX, size_t tileY)
+{
+    if ( tiles == nullptr || tileX >= tileWidth || tileY >= tileHeight )
+        return;
+
+    const Sc::SystemColor & color = tileValueColor(scenario.layers.getTile(tileX, tileY));
+    tileColors[tileY*tileWidth + tileX] = color;
+
+    // Only the pixels that sample this tile change, check the pixels around the tile's scaled bounds using the same mapping as rebuild
+    size_t xcEnd = std::min(Width-2*xOffset, size_t(std::ceil((tileX+1)*scale))+1);
+    size_t ycEnd = std::min(Height-2*yOffset, size_t(std::ceil((tileY+1)*scale))+1);
+    for ( size_t yc = size_t(std::max(0.0f, std::floor(tileY*scale)-1)); yc < ycEnd; yc++ )
+    {
+        if ( size_t(float(yc)/scale) == tileY )
+        {
+            for ( size_t xc = size_t(std::max(0.0f, std::floor(tileX*scale)-1)); xc < xcEnd; xc++ )
+            {
+                if ( size_t(float(xc)/scale) == tileX )
+                {
+                    u32 pixel = u32((yc+yOffset)*Width + xc+xOffset);
+                    terrain[pixel] = color;
+                    refreshPixel(pixel);
+                }
+            }
+        }
+    }
+}
+
+void MiniMapRaster::unitAdded(const Scenario & scenario, size_t unitIndex)
+{
+    if ( unitIndex <= units.size() && unitIndex < scenario.layers.numUnits() )
+    {
+        OverlayItem item = unitItem(scenario, unitIndex);
+        units.insert(units.begin()+unitIndex, item);
+        shiftOverlayKeys(units, 0, unitIndex+1, true);
+        addOverlay(item, u32(unitIndex));
+    }
+}
+
+void MiniMapRaster::unitRemoved(size_t unitIndex)
+{
+    if ( unitIndex < units.size() )
+    {
+        removeOverlay(units[unitIndex], u32(unitIndex)); // Removed while keys still match indexes, so the pixel is refreshed from the right item
+        units.erase(units.begin()+unitIndex);
+        shiftOverlayKeys(units, 0, unitIndex, false);
+    }
+}
+
+void MiniMapRaster::unitChanged(const Scenario & scenario, size_t unitIndex)
+{
+    if ( unitIndex < units.size() && unitIndex < scenario.layers.numUnits() )
+    {
+        OverlayItem previous = units[unitIndex];
+        units[unitIndex] = unitItem(scenario, unitIndex);
+        removeOverlay(previous, u32(unitIndex));
+        addOverlay(units[unitIndex], u32(unitIndex));
+    }
+}
+
+void MiniMapRaster::spriteAdded(const Scenario & scenario, size_t spriteIndex)
+{
+    if ( spriteIndex <= sprites.size() && spriteIndex < scenario.layers.numSprites() )
+    {
+        OverlayItem item = spriteItem(scenario, spriteIndex);
+        sprites.insert(sprites.begin()+spriteIndex, item);
+        shiftOverlayKeys(sprites, SpriteKey, spriteIndex+1, true);
+        addOverlay(item, u32(spriteIndex) | SpriteKey);
+    }
+}
+
+void MiniMapRaster::spriteRemoved(size_t spriteIndex)
+{
+    if ( spriteIndex < sprites.size() )
+    {
+        removeOverlay(sprites[spriteIndex], u32(spriteIndex) | SpriteKey);
+        sprites.erase(sprites.begin()+spriteIndex);
+        shiftOverlayKeys(sprites, SpriteKey, spriteIndex, false);
+    }
+}
+
+void MiniMapRaster::spriteChanged(const Scenario & scenario, size_t spriteIndex)
+{
+    if ( spriteIndex < sprites.size() && spriteIndex < scenario.layers.numSprites() )
+    {
+        OverlayItem previous = sprites[spriteIndex];
+        sprites[spriteIndex] = spriteItem(scenario, spriteIndex);
+        removeOverlay(previous, u32(spriteIndex) | SpriteKey);
+        addOverlay(sprites[spriteIndex], u32(spriteIndex) | SpriteKey);
+    }
+}
+
+void MiniMapRaster::playerColorChanged(const Scenario & scenario, size_t player)
+{
+    for ( size_t i=0; i<units.size(); i++ )
+    {
+        if ( units[i].owner == player )
+            unitChanged(scenario, i);
+    }
+    for ( size_t i=0; i<sprites.size(); i++ )
+    {
+        if ( sprites[i].owner == player )
+            spriteChanged(scenario, i);
+    }
+}
+
+const std::vector<Sc::SystemColor> & MiniMapRaster::getBitmap() const
+{
+    return bitmap;
+}
+
+float MiniMapRaster::getScale() const
+{
+    return scale;
+}
+
+size_t MiniMapRaster::getXOffset() const
+{
+    return xOffset;
+}
+
+size_t MiniMapRaster::getYOffset() const
+{
+    return yOffset;
+}
+
+float MiniMapRaster::scaleFor(size_t tileWidth, size_t tileHeight)
+{
+    if ( tileWidth >= tileHeight && tileWidth > 0 )
+    {
+        if ( double(Width)/tileWidth > 1 )
+            return (float)(Width/tileWidth);
+        else
+            return (float)(double(Width)/tileWidth);
+    }
+    else if ( tileHeight > 0 )
+    {
+        if ( double(Height)/tileHeight > 1 )
+            return (float)(Height/tileHeight);
+        else
+            return (float)(double(Height)/tileHeight);
+    }
+    return 1;
+}
+
+const Sc::SystemColor & MiniMapRaster::tileValueColor(u16 tileValue)
+{
+    if ( !tileValueCached[tileValue] )
+    {
+        Sc::SystemColor color = {};
+        size_t groupIndex = Sc::Terrain::Tiles::getGroupIndex(tileValue);
+        if ( tiles != nullptr && groupIndex < tiles->tileGroups.size() )
+        {
+            size_t megaTileIndex = size_t(tiles->tileGroups[groupIndex].megaTileIndex[Sc::Terrain::Tiles::getGroupMemberIndex(tileValue)]);
+            if ( megaTileIndex < tiles->tileGraphics.size() )
+            {
+                const Sc::Terrain::TileGraphics & tileGraphics = tiles->tileGraphics[megaTileIndex];
+                u32 red = 0, green = 0, blue = 0, numPixels = 0;
+                for ( size_t yMiniTile=0; yMiniTile<4; yMiniTile++ )
+                {
+                    for ( size_t xMiniTile=0; xMiniTile<4; xMiniTile++ )
+                    {
+                        size_t vr4Index = size_t(tileGraphics.miniTileGraphics[yMiniTile][xMiniTile].vr4Index());
+                        if ( vr4Index < tiles->miniTilePixels.size() )
+                        {
+                            const Sc::Terrain::MiniTilePixels & miniTilePixels = tiles->miniTilePixels[vr4Index];
+                            for ( size_t yPixel=0; yPixel<8; yPixel++ )
+                            {
+                                for ( size_t xPixel=0; xPixel<8; xPixel++ ) // Flipping doesn't change the average, so it's ignored
+                                {
+                                    const Sc::SystemColor & pixel = palette[miniTilePixels.wpeIndex[yPixel][xPixel]];
+                                    red += pixel.red;
+                                    green += pixel.green;
+                                    blue += pixel.blue;
+                                }
+                            }
+                            numPixels += 64;
+                        }
+                    }
+                }
+                if ( numPixels > 0 )
+                {
+                    color.red = u8(red/numPixels);
+                    color.green = u8(green/numPixels);
+                    color.blue = u8(blue/numPixels);
+                }
+            }
+        }
+        tileValueColors[tileValue] = color;
+        tileValueCached[tileValue] = true;
+    }
+    return tileValueColors[tileValue];
+}
+
+Sc::SystemColor MiniMapRaster::minimapColor(size_t colorIndex) const
+{
+    return colorIndex < minimapColors.size() ? minimapColors[colorIndex] : Sc::SystemColor();
+}
+
+MiniMapRaster::OverlayItem MiniMapRaster::unitItem(const Scenario & scenario, size_t unitIndex) const
+{
+    const Chk::UnitPtr unit = scenario.layers.getUnit(unitIndex);
+    size_t color = unit->owner < Sc::Player::TotalSlots ? size_t(scenario.players.getPlayerColor(unit->owner)) : size_t(unit->owner);
+    if ( color > Chk::TotalColors )
+        color %= Chk::TotalColors;
+
+    return OverlayItem { overlayPixel(unit->xc, unit->yc), unit->owner, minimapColor(color) };
+}
+
+MiniMapRaster::OverlayItem MiniMapRaster::spriteItem(const Scenario & scenario, size_t spriteIndex) const
+{
+    const Chk::SpritePtr sprite = scenario.layers.getSprite(spriteIndex);
+    if ( !sprite->isDrawnAsSprite() )
+        return OverlayItem { NoPixel, sprite->owner, Sc::SystemColor() };
+
+    size_t color = sprite->owner < Sc::Player::TotalSlots ? size_t(scenario.players.getPlayerColor(sprite->owner)) : size_t(sprite->owner%16);
+    if ( color > 16 )
+        color %= 16;
+
+    return OverlayItem { overlayPixel(sprite->xc, sprite->yc), sprite->owner, minimapColor(color) };
+}
+
+u32 MiniMapRaster::overlayPixel(u16 xc, u16 yc) const
+{
+    if ( tileWidth == 0 || tileHeight == 0 )
+        return NoPixel;
+
+    size_t pixel = (size_t((yc/32)*scale) + yOffset)*Width + size_t((xc/32)*scale) + xOffset;
+    return pixel < Width*Height ? u32(pixel) : NoPixel;
+}
+
+void MiniMapRaster::addOverlay(const OverlayItem & item, u32 key)
+{
+    if ( item.pixel != NoPixel )
+    {
+        std::vector<u32> & keys = overlayKeys[item.pixel];
+        keys.insert(std::lower_bound(keys.begin(), keys.end(), key), key);
+        refreshPixel(item.pixel);
+    }
+}
+
+void MiniMapRaster::removeOverlay(const OverlayItem & item, u32 key)
+{
+    if ( item.pixel != NoPixel )
+    {
+        std::vector<u32> & keys = overlayKeys[item.pixel];
+        auto found = std::lower_bound(keys.begin(), keys.end(), key);
+        if ( found != keys.end() && *found == key )
+        {
+            keys.erase(found);
+            refreshPixel(item.pixel);
+        }
+    }
+}
+
+void MiniMapRaster::shiftOverlayKeys(const std::vector<OverlayItem> & items, u32 keyFlag, size_t firstIndex, bool inserted)
+{
+    // Each item from firstIndex moved by one, keys are renumbered furthest from the change first so keys at a pixel stay distinct and sorted
+    for ( size_t n=0; n+firstIndex<items.size(); n++ )
+    {
+        size_t index = inserted ? items.size()-1-n : firstIndex+n;
+        if ( items[index].pixel != NoPixel )
+        {
+            std::vector<u32> & keys = overlayKeys[items[index].pixel];
+            u32 previousKey = u32(inserted ? index-1 : index+1) | keyFlag;
+            auto found = std::lower_bound(keys.begin(), keys.end(), previousKey);
+            if ( found != keys.end() && *found == previousKey )
+                *found = u32(index) | keyFlag;
+        }
+    }
+}
+
+void MiniMapRaster::refreshPixel(u32 pixel)
+{
+    const std::vector<u32> & keys = overlayKeys[pixel];
+    if ( keys.empty() )
+        bitmap[pixel] = terrain[pixel];
+    else if ( (keys.back() & SpriteKey) == SpriteKey )
+        bitmap[pixel] = sprites[keys.back() & ~SpriteKey].color;
+    else
+        bitmap[pixel] = units[keys.back()].color;
+}
@@ -0,0 +1,91 @@
+#ifndef MINIMAPRASTER_H
+#define MINIMAPRASTER_H
+#include "Basics.h"
+#include "Sc.h"
+#include "Scenario.h"
+#include <array>
+#include <vector>
+
+/**
+    A minimap raster holds the 128x128 minimap for a scenario and keeps it up to date as the scenario changes
+
+    Each tile is drawn as the average color of its pixels, averages are cached by tile value so each distinct tile is only averaged
+    once; units and sprites are drawn over the terrain as a single pixel in their owner's minimap color, later units and sprites
+    over earlier ones with sprites over units
+
+    The raster is built in full with rebuild, after which changes to tiles, units, sprites and player colors are applied through
+    the change notifications, each of which recomputes only the pixels that the change affects; anything else (e.g. a new tileset
+    or map size) calls for another rebuild
+*/
+
+class MiniMapRaster
+{
+    public:
+        static constexpr size_t Width = 128;
+        static constexpr size_t Height = 128;
+        using Palette = std::array<Sc::SystemColor, Sc::NumColors>;
+
+        MiniMapRaster();
+        virtual ~MiniMapRaster();
+
+        /** Rebuilds the whole raster, tiles (which must outlive the raster or the next rebuild) supplies tile graphics, palette the tileset's colors
+            and minimapColors the color used for each player color (as in tminimap.pcx) */
+        void rebuild(const Scenario & scenario, const Sc::Terrain::Tiles & tiles, const Palette & palette, const std::vector<Sc::SystemColor> & minimapColors);
+
+        void tileChanged(const Scenario & scenario, size_t tileX, size_t tileY);
+        void unitAdded(const Scenario & scenario, size_t unitIndex); // Call after a unit is added or inserted at unitIndex
+        void unitRemoved(size_t unitIndex); // Call after the unit at unitIndex is removed
+        void unitChanged(const Scenario & scenario, size_t unitIndex); // Call after a unit moves or changes owner
+        void spriteAdded(const Scenario & scenario, size_t spriteIndex);
+        void spriteRemoved(size_t spriteIndex);
+        void spriteChanged(const Scenario & scenario, size_t spriteIndex);
+        void playerColorChanged(const Scenario & scenario, size_t player); // Call after the color of a player changes
+
+        const std::vector<Sc::SystemColor> & getBitmap() const; // Width*Height pixels, row by row from the top-left
+        float getScale() const; // Minimap pixels per tile
+        size_t getXOffset() const; // Pixels left blank on either side of the map
+        size_t getYOffset() const; // Pixels left blank above and below the map
+
+        static float scaleFor(size_t tileWidth, size_t tileHeight);
+
+    private:
+        static constexpr u32 NoPixel = u32(Width*Height);
+        static constexpr u32 SpriteKey = 0x80000000; // Overlay keys are unit indexes, or sprite indexes with this bit set so sprites sort after units
+
+        struct OverlayItem
+        {
+            u32 pixel; // NoPixel if the item isn't drawn on the minimap
+            u8 owner;
+            Sc::SystemColor color;
+        };
+
+        const Sc::Terrain::Tiles* tiles;
+        Palette palette;
+        std::vector<Sc::SystemColor> minimapColors;
+        size_t tileWidth;
+        size_t tileHeight;
+        float scale;
+        size_t xOffset;
+        size_t yOffset;
+
+        std::vector<Sc::SystemColor> tileValueColors; // The average color of each tile value, valid where tileValueCached is set
+        std::vector<bool> tileValueCached;
+        std::vector<Sc::SystemColor> tileColors; // The average color of each tile on the map
+        std::vector<Sc::SystemColor> terrain; // Terrain for each minimap pixel
+        std::vector<OverlayItem> units;
+        std::vector<OverlayItem> sprites;
+        std::vector<std::vector<u32>> overlayKeys; // The keys of the units and sprites at each minimap pixel in drawing order, the last is drawn on top
+        std::vector<Sc::SystemColor> bitmap;
+
+        const Sc::SystemColor & tileValueColor(u16 tileValue);
+        Sc::SystemColor minimapColor(size_t colorIndex) const;
+        OverlayItem unitItem(const Scenario & scenario, size_t unitIndex) const;
+        OverlayItem spriteItem(const Scenario & scenario, size_t spriteIndex) const;
+        u32 overlayPixel(u16 xc, u16 yc) const;
+        void addOverlay(const OverlayItem & item, u32 key);
+        void removeOverlay(const OverlayItem & item, u32 key);
+        void shiftOverlayKeys(const std::vector<OverlayItem> & items, u32 keyFlag, size_t firstIndex, bool inserted); // Renumbers the keys of items from firstIndex after an insert or erase
+        void refreshPixel(u32 pixel); // Recomputes the bitmap at pixel from the terrain and the top overlay item
+};
+
+#endif
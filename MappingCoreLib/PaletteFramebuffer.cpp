@@ -0,0 +1,133 @@
+#include "PaletteFramebuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+PaletteFramebuffer::PaletteFramebuffer() : width(0), height(0), colors(Sc::NumColors)
+{
+
+}
+
+PaletteFramebuffer::~PaletteFramebuffer()
+{
+
+}
+
+size_t PaletteFramebuffer::getWidth() const
+{
+    return width;
+}
+
+size_t PaletteFramebuffer::getHeight() const
+{
+    return height;
+}
+
+void PaletteFramebuffer::resize(size_t width, size_t height)
+{
+    this->width = width;
+    this->height = height;
+    slots.resize(width*height);
+}
+
+void PaletteFramebuffer::fill(Slot slot)
+{
+    std::fill(slots.begin(), slots.end(), slot);
+}
+
+void PaletteFramebuffer::blit(const PaletteFramebuffer & source, size_t x, size_t y)
+{
+    if ( x >= width || y >= height )
+        return;
+
+    size_t copyWidth = std::min(source.width, width-x);
+    size_t copyHeight = std::min(source.height, height-y);
+    for ( size_t row=0; row<copyHeight; row++ )
+    {
+        auto sourceRow = source.slots.begin()+row*source.width;
+        std::copy(sourceRow, sourceRow+copyWidth, slots.begin()+(y+row)*width+x);
+    }
+}
+
+void PaletteFramebuffer::blitReduced(const PaletteFramebuffer & source, s64 x, s64 y, u8 level)
+{
+    size_t step = size_t(1) << level;
+    s64 reducedWidth = s64((source.width+step-1) >> level),
+        reducedHeight = s64((source.height+step-1) >> level);
+
+    s64 rowStart = std::max(s64(0), -y), rowEnd = std::min(reducedHeight, s64(height)-y),
+        columnStart = std::max(s64(0), -x), columnEnd = std::min(reducedWidth, s64(width)-x);
+    for ( s64 row=rowStart; row<rowEnd; row++ )
+    {
+        size_t sourceRow = size_t(row)*step*source.width;
+        s64 destRow = (y+row)*s64(width)+x;
+        for ( s64 column=columnStart; column<columnEnd; column++ )
+        {
+            Slot slot = source.slots[sourceRow+size_t(column)*step];
+            if ( slot != Transparent )
+                slots[size_t(destRow+column)] = slot;
+        }
+    }
+}
+
+std::vector<PaletteFramebuffer::Slot> & PaletteFramebuffer::getSlots()
+{
+    return slots;
+}
+
+const std::vector<PaletteFramebuffer::Slot> & PaletteFramebuffer::getSlots() const
+{
+    return slots;
+}
+
+bool PaletteFramebuffer::setPalette(const Palette & palette)
+{
+    if ( std::memcmp(&palette[0], &colors[0], sizeof(Palette)) == 0 )
+        return false;
+
+    std::memcpy(&colors[0], &palette[0], sizeof(Palette));
+    return true;
+}
+
+void PaletteFramebuffer::setFixedColor(Slot slot, const Sc::SystemColor & color)
+{
+    if ( slot < FirstFixedSlot || slot == Transparent )
+        throw std::out_of_range("Slot " + std::to_string(slot) + " is not a fixed slot!");
+
+    if ( size_t(slot) >= colors.size() )
+        colors.resize(size_t(slot)+1);
+
+    colors[slot] = color;
+}
+
+const Sc::SystemColor & PaletteFramebuffer::getColor(Slot slot) const
+{
+    return colors[slot];
+}
+
+void PaletteFramebuffer::compose(std::vector<Sc::SystemColor> & bitmap) const
+{
+    if ( bitmap.size() != slots.size() )
+        throw std::length_error("Bitmap size " + std::to_string(bitmap.size()) + " does not match the framebuffer size " + std::to_string(slots.size()) + "!");
+
+    const Slot* slot = slots.data();
+    const Sc::SystemColor* lookup = colors.data();
+    Sc::SystemColor* pixel = bitmap.data();
+    size_t numPixels = slots.size();
+    Slot numSlots = Slot(std::min(colors.size(), size_t(Transparent)));
+    for ( size_t i=0; i<numPixels; i++ )
+    {
+        if ( slot[i] < numSlots )
+            pixel[i] = lookup[slot[i]];
+    }
+}
+
+PaletteFramebuffer::SlotMap PaletteFramebuffer::paletteSlots()
+{
+    SlotMap slotMap = {};
+    for ( size_t i=0; i<Sc::NumColors; i++ )
+        slotMap[i] = Slot(i);
+
+    return slotMap;
+}
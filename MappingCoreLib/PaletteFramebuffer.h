@@ -0,0 +1,58 @@
+#ifndef PALETTEFRAMEBUFFER_H
+#define PALETTEFRAMEBUFFER_H
+#include "Basics.h"
+#include "Sc.h"
+#include <array>
+#include <vector>
+
+/**
+    A palette framebuffer holds a color slot for every pixel rather than a color, and is composed into RGB through a lookup table
+
+    Slots below Sc::NumColors look up the palette, so when a palette rotates only the lookup table changes and the RGB can be
+    recomposed in one quick pass rather than redrawing what was drawn; slots from FirstFixedSlot on hold colors that aren't part
+    of the palette (e.g. player colors that graphics remap onto palette indexes 8-15), and the Transparent slot leaves whatever
+    was already in the RGB bitmap in place
+*/
+
+class PaletteFramebuffer
+{
+    public:
+        using Slot = u16;
+        using Palette = std::array<Sc::SystemColor, Sc::NumColors>;
+        using SlotMap = std::array<Slot, Sc::NumColors>; // The slot each palette index of a graphic is drawn with
+
+        static constexpr Slot FirstFixedSlot = Slot(Sc::NumColors);
+        static constexpr Slot Transparent = Slot(0xFFFF);
+
+        PaletteFramebuffer();
+        virtual ~PaletteFramebuffer();
+
+        size_t getWidth() const;
+        size_t getHeight() const;
+        void resize(size_t width, size_t height); // Slots are not preserved when the size changes
+        void fill(Slot slot);
+        void blit(const PaletteFramebuffer & source, size_t x, size_t y); // Copies the slots of source to this framebuffer with source's top-left at x, y, clipping anything outside
+
+        /** Draws every (1 << level)th slot of every (1 << level)th row of source onto this framebuffer with source's top-left at x, y,
+            leaving transparent slots and anything outside this framebuffer untouched */
+        void blitReduced(const PaletteFramebuffer & source, s64 x, s64 y, u8 level);
+
+        std::vector<Slot> & getSlots(); // The slot for each pixel, row by row from the top-left
+        const std::vector<Slot> & getSlots() const;
+
+        bool setPalette(const Palette & palette); // Updates the palette part of the lookup table, returns true if any color changed
+        void setFixedColor(Slot slot, const Sc::SystemColor & color); // Sets the color for a slot at or after FirstFixedSlot
+        const Sc::SystemColor & getColor(Slot slot) const;
+
+        void compose(std::vector<Sc::SystemColor> & bitmap) const; // Replaces the color of each non-transparent pixel in bitmap (which must be the framebuffer's size) with its slot's color
+
+        static SlotMap paletteSlots(); // Maps each palette index to its own palette slot
+
+    private:
+        size_t width;
+        size_t height;
+        std::vector<Slot> slots;
+        std::vector<Sc::SystemColor> colors; // The lookup table, indexed by slot
+};
+
+#endif
@@ -0,0 +1,387 @@
+#include "PluginTransport.h"
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+class ScenarioView::MemoryStreamBuffer : public std::streambuf // Writes to a fixed block of memory, failing rather than writing past it
+{
+    public:
+        MemoryStreamBuffer(u8* begin, size_t size) { setp((char*)begin, (char*)begin + size); }
+};
+
+bool ScenarioView::publish(Scenario & scenario, const std::string & name, SharedMemory & sharedMemory)
+{
+    std::vector<Section> sections;
+    std::vector<u64> sizes;
+    u64 totalSize = 0;
+    if ( layOut(scenario, sections, sizes, totalSize) && sharedMemory.create(name, size_t(totalSize)) )
+    {
+        if ( fill(scenario, sections, sizes, sharedMemory.writableData(), totalSize) )
+            return true;
+
+        sharedMemory.close();
+    }
+    return false;
+}
+
+std::vector<u8> ScenarioView::write(Scenario & scenario)
+{
+    std::vector<Section> sections;
+    std::vector<u64> sizes;
+    u64 totalSize = 0;
+    if ( layOut(scenario, sections, sizes, totalSize) )
+    {
+        std::vector<u8> view(size_t(totalSize), u8(0));
+        if ( fill(scenario, sections, sizes, &view[0], totalSize) )
+            return view;
+    }
+    return std::vector<u8>();
+}
+
+ScenarioView::ScenarioView(const u8* view, size_t viewSize) : valid(false)
+{
+    if ( view == nullptr || viewSize < sizeof(Header) )
+        return;
+
+    const Header & header = (const Header &)view[0];
+    if ( header.magic != Magic || header.version != Version || header.totalSize > u64(viewSize) ||
+        header.numSections > (header.totalSize - sizeof(Header)) / sizeof(SectionEntry) )
+        return;
+
+    const SectionEntry* entries = (const SectionEntry*)&view[sizeof(Header)];
+    for ( u64 i=0; i<header.numSections; i++ )
+    {
+        const SectionEntry & entry = entries[i];
+        if ( entry.offset > header.totalSize || entry.size > header.totalSize - entry.offset )
+        {
+            sections.clear();
+            return;
+        }
+        sections.push_back(SectionData { entry.name, &view[size_t(entry.offset)], size_t(entry.size) });
+    }
+    valid = true;
+}
+
+ScenarioView::~ScenarioView()
+{
+
+}
+
+bool ScenarioView::isValid() const
+{
+    return valid;
+}
+
+size_t ScenarioView::numSections() const
+{
+    return sections.size();
+}
+
+const ScenarioView::SectionData & ScenarioView::getSection(size_t sectionIndex) const
+{
+    if ( sectionIndex < sections.size() )
+        return sections[sectionIndex];
+    else
+        throw std::out_of_range("SectionIndex " + std::to_string(sectionIndex) + " is past the end of a view with " + std::to_string(sections.size()) + " sections!");
+}
+
+bool ScenarioView::getSection(SectionName sectionName, SectionData & sectionData) const
+{
+    for ( const SectionData & section : sections )
+    {
+        if ( section.name == sectionName )
+        {
+            sectionData = section;
+            return true;
+        }
+    }
+    return false;
+}
+
+const u8* ScenarioView::getSectionData(SectionName sectionName, size_t & size) const
+{
+    SectionData sectionData = {};
+    if ( getSection(sectionName, sectionData) )
+    {
+        size = sectionData.size;
+        return sectionData.data;
+    }
+    size = 0;
+    return nullptr;
+}
+
+bool ScenarioView::layOut(Scenario & scenario, std::vector<Section> & sections, std::vector<u64> & sizes, u64 & totalSize)
+{
+    sections = scenario.getSectionsInUse();
+    sizes.clear();
+    totalSize = sizeof(Header) + sections.size()*sizeof(SectionEntry);
+    try
+    {
+        for ( const Section & section : sections )
+        {
+            u64 size = u64(section->getSize(scenario));
+            sizes.push_back(size);
+            totalSize = (totalSize + 7) & ~u64(7);
+            totalSize += size;
+        }
+    }
+    catch ( std::exception & e )
+    {
+        logger.error("Error laying out scenario view ", e);
+        return false;
+    }
+    return true;
+}
+
+bool ScenarioView::fill(Scenario & scenario, const std::vector<Section> & sections, const std::vector<u64> & sizes, u8* view, u64 totalSize)
+{
+    Header & header = (Header &)view[0];
+    header.magic = Magic;
+    header.version = Version;
+    header.numSections = u64(sections.size());
+    header.totalSize = totalSize;
+
+    SectionEntry* entries = (SectionEntry*)&view[sizeof(Header)];
+    u64 offset = sizeof(Header) + sections.size()*sizeof(SectionEntry);
+    try
+    {
+        for ( size_t i=0; i<sections.size(); i++ )
+        {
+            offset = (offset + 7) & ~u64(7);
+            entries[i] = SectionEntry { sections[i]->getName(), 0, offset, sizes[i] };
+
+            MemoryStreamBuffer sectionBuffer(&view[size_t(offset)], size_t(sizes[i]));
+            std::ostream sectionStream(&sectionBuffer);
+            sections[i]->write(sectionStream, scenario);
+            if ( !sectionStream.good() )
+            {
+                logger.error() << "Section " << ChkSection::getNameString(sections[i]->getName()) << " didn't fit its size in the scenario view" << std::endl;
+                return false;
+            }
+            offset += sizes[i];
+        }
+    }
+    catch ( std::exception & e )
+    {
+        logger.error("Error writing scenario view ", e);
+        return false;
+    }
+    return true;
+}
+
+ScenarioPatch::ScenarioPatch()
+{
+
+}
+
+ScenarioPatch::~ScenarioPatch()
+{
+
+}
+
+void ScenarioPatch::replaceSection(SectionName sectionName, const void* data, size_t size)
+{
+    operations.push_back(PatchOperation { Operation::ReplaceSection, sectionName, 0, std::vector<u8>((const u8*)data, (const u8*)data + size) });
+}
+
+void ScenarioPatch::write(SectionName sectionName, size_t offset, const void* data, size_t size)
+{
+    if ( offset > size_t(ChkSection::MaxChkSectionSize) || size > size_t(ChkSection::MaxChkSectionSize) - offset )
+        throw std::out_of_range("Writing " + std::to_string(size) + " bytes at offset " + std::to_string(offset) + " would pass the max section size!");
+
+    operations.push_back(PatchOperation { Operation::Write, sectionName, u32(offset), std::vector<u8>((const u8*)data, (const u8*)data + size) });
+}
+
+void ScenarioPatch::resize(SectionName sectionName, size_t size)
+{
+    if ( size > size_t(ChkSection::MaxChkSectionSize) )
+        throw std::out_of_range("Resizing a section to " + std::to_string(size) + " bytes would pass the max section size!");
+
+    operations.push_back(PatchOperation { Operation::Resize, sectionName, u32(size), std::vector<u8>() });
+}
+
+bool ScenarioPatch::empty() const
+{
+    return operations.empty();
+}
+
+size_t ScenarioPatch::numOperations() const
+{
+    return operations.size();
+}
+
+void ScenarioPatch::clear()
+{
+    operations.clear();
+}
+
+std::vector<u8> ScenarioPatch::serialize() const
+{
+    size_t size = sizeof(Header);
+    for ( const PatchOperation & patchOperation : operations )
+        size += sizeof(OperationHeader) + patchOperation.data.size();
+
+    std::vector<u8> patch(size);
+    Header & header = (Header &)patch[0];
+    header = Header { Magic, Version, u32(operations.size()) };
+    size_t offset = sizeof(Header);
+    for ( const PatchOperation & patchOperation : operations )
+    {
+        (OperationHeader &)patch[offset] = OperationHeader { patchOperation.operation, patchOperation.sectionName, patchOperation.offset, u32(patchOperation.data.size()) };
+        offset += sizeof(OperationHeader);
+        if ( !patchOperation.data.empty() )
+            std::memcpy(&patch[offset], &patchOperation.data[0], patchOperation.data.size());
+
+        offset += patchOperation.data.size();
+    }
+    return patch;
+}
+
+bool ScenarioPatch::deserialize(const u8* data, size_t size)
+{
+    operations.clear();
+    if ( data == nullptr || size < sizeof(Header) )
+        return false;
+
+    const Header & header = (const Header &)data[0];
+    if ( header.magic != Magic || header.version != Version )
+        return false;
+
+    size_t offset = sizeof(Header);
+    for ( u32 i=0; i<header.numOperations; i++ )
+    {
+        if ( size - offset < sizeof(OperationHeader) )
+        {
+            operations.clear();
+            return false;
+        }
+        const OperationHeader & operationHeader = (const OperationHeader &)data[offset];
+        offset += sizeof(OperationHeader);
+        if ( operationHeader.operation > Operation::Resize || size - offset < size_t(operationHeader.size) )
+        {
+            operations.clear();
+            return false;
+        }
+        operations.push_back(PatchOperation { operationHeader.operation, operationHeader.sectionName, operationHeader.offset,
+            std::vector<u8>(&data[offset], &data[offset] + operationHeader.size) });
+        offset += operationHeader.size;
+    }
+    if ( offset != size )
+    {
+        operations.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ScenarioPatch::diff(const ScenarioView & current, const ScenarioView & updated)
+{
+    operations.clear();
+    if ( !current.isValid() || !updated.isValid() )
+        return false;
+
+    ScenarioView::SectionData updatedSection {};
+    for ( size_t i=0; i<current.numSections(); i++ )
+    {
+        if ( !updated.getSection(current.getSection(i).name, updatedSection) )
+            return false;
+    }
+
+    ScenarioView::SectionData currentSection {};
+    for ( size_t i=0; i<updated.numSections(); i++ )
+    {
+        const ScenarioView::SectionData & section = updated.getSection(i);
+        if ( !current.getSection(section.name, currentSection) || currentSection.size != section.size ||
+            (section.size > 0 && std::memcmp(currentSection.data, section.data, section.size) != 0) )
+        {
+            replaceSection(section.name, section.data, section.size);
+        }
+    }
+    return true;
+}
+
+bool ScenarioPatch::apply(Scenario & scenario) const
+{
+    std::vector<SectionName> patchedSectionNames;
+    std::unordered_map<SectionName, std::vector<u8>> patchedSections;
+    for ( const PatchOperation & patchOperation : operations )
+    {
+        auto found = patchedSections.find(patchOperation.sectionName);
+        if ( found == patchedSections.end() )
+        {
+            patchedSectionNames.push_back(patchOperation.sectionName);
+            found = patchedSections.insert(std::pair<SectionName, std::vector<u8>>(patchOperation.sectionName, std::vector<u8>())).first;
+            if ( patchOperation.operation != Operation::ReplaceSection ) // Start from the section's current contents
+            {
+                for ( const Section & section : scenario.getSectionsInUse() )
+                {
+                    if ( section->getName() == patchOperation.sectionName )
+                    {
+                        std::stringstream sectionData(std::ios_base::in|std::ios_base::out|std::ios_base::binary);
+                        try {
+                            section->write(sectionData, scenario);
+                        } catch ( std::exception & e ) {
+                            logger.error("Error reading section to patch ", e);
+                            return false;
+                        }
+                        const std::string & contents = sectionData.str();
+                        found->second.assign(contents.begin(), contents.end());
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::vector<u8> & sectionData = found->second;
+        switch ( patchOperation.operation )
+        {
+            case Operation::ReplaceSection:
+                sectionData = patchOperation.data;
+                break;
+            case Operation::Write:
+                if ( size_t(patchOperation.offset) > sectionData.size() )
+                {
+                    logger.error() << "Patch writes past the end of section " << ChkSection::getNameString(patchOperation.sectionName) << std::endl;
+                    return false;
+                }
+                if ( size_t(patchOperation.offset) + patchOperation.data.size() > sectionData.size() )
+                    sectionData.resize(size_t(patchOperation.offset) + patchOperation.data.size());
+                if ( !patchOperation.data.empty() )
+                    std::memcpy(&sectionData[size_t(patchOperation.offset)], &patchOperation.data[0], patchOperation.data.size());
+                break;
+            case Operation::Resize:
+                sectionData.resize(size_t(patchOperation.offset), u8(0));
+                break;
+        }
+    }
+
+    std::unordered_map<SectionName, Section> replacements;
+    for ( const SectionName & sectionName : patchedSectionNames )
+    {
+        const std::vector<u8> & sectionData = patchedSections[sectionName];
+        if ( sectionData.size() > size_t(ChkSection::MaxChkSectionSize) )
+            return false;
+
+        std::multimap<SectionName, Section> parsedSections;
+        Chk::SectionHeader sectionHeader = { sectionName, Chk::SectionSize(sectionData.size()) };
+        std::stringstream sectionStream(std::string(sectionData.begin(), sectionData.end()), std::ios_base::in|std::ios_base::binary);
+        Chk::SectionSize sizeRead = 0;
+        Section section = nullptr;
+        try {
+            section = ChkSection::read(parsedSections, sectionHeader, sectionStream, sizeRead);
+        } catch ( std::exception & e ) {
+            logger.error() << "Read of patched section " << ChkSection::getNameString(sectionName) << " failed with error: " << e.what() << std::endl;
+            return false;
+        }
+        if ( section == nullptr )
+            return false;
+
+        replacements.insert(std::pair<SectionName, Section>(sectionName, section));
+    }
+
+    if ( !replacements.empty() )
+        scenario.replaceSections(replacements);
+
+    return true;
+}
@@ -0,0 +1,143 @@
+#ifndef PLUGINTRANSPORT_H
+#define PLUGINTRANSPORT_H
+#include "Basics.h"
+#include "Scenario.h"
+#include "SystemIO.h"
+#include <string>
+#include <vector>
+
+/**
+    The plugin transport lets plugins read a scenario and send back changes without either side copying the whole scenario file
+
+    The host lays the scenario out as a ScenarioView (a directory giving the name, offset and size of each section followed by
+    the section contents) in shared memory, plugins map that read-only and look sections up by name; plugins send changes back
+    as a ScenarioPatch (small enough to go through any message) listing whole sections to replace and byte ranges to write within
+    sections, such as a single unit or trigger, and the host applies a patch by re-reading only the sections the patch touches
+*/
+
+class ScenarioView
+{
+    public:
+        static constexpr u32 Magic = 0x56444B43; // "CKDV"
+        static constexpr u32 Version = 1;
+
+#pragma pack(push, 1)
+        __declspec(align(1)) struct Header {
+            u32 magic;
+            u32 version;
+            u64 numSections;
+            u64 totalSize;
+        };
+        __declspec(align(1)) struct SectionEntry {
+            SectionName name;
+            u32 reserved;
+            u64 offset; // From the start of the view, always a multiple of 8
+            u64 size;
+        };
+#pragma pack(pop)
+
+        struct SectionData {
+            SectionName name;
+            const u8* data;
+            size_t size;
+        };
+
+        /** Lays the sections in use by scenario out in a new shared memory block with the given name, the view stays valid until
+            sharedMemory is closed and doesn't follow later changes to the scenario */
+        static bool publish(Scenario & scenario, const std::string & name, SharedMemory & sharedMemory);
+
+        /** Lays the sections in use by scenario out in memory, the same as publish would in shared memory */
+        static std::vector<u8> write(Scenario & scenario);
+
+        ScenarioView(const u8* view, size_t viewSize); // Reads the directory of a view, if the view isn't valid it has no sections
+        virtual ~ScenarioView();
+
+        bool isValid() const;
+        size_t numSections() const;
+        const SectionData & getSection(size_t sectionIndex) const;
+        bool getSection(SectionName sectionName, output_param SectionData & sectionData) const;
+        const u8* getSectionData(SectionName sectionName, output_param size_t & size) const; // nullptr if the view has no such section
+
+        template <typename Record> const Record* getRecords(SectionName sectionName, output_param size_t & numRecords) const
+        {
+            size_t size = 0;
+            const u8* data = getSectionData(sectionName, size);
+            numRecords = size / sizeof(Record);
+            return (const Record*)data;
+        }
+
+    private:
+        bool valid;
+        std::vector<SectionData> sections;
+
+        class MemoryStreamBuffer;
+
+        static bool layOut(Scenario & scenario, output_param std::vector<Section> & sections, output_param std::vector<u64> & sizes, output_param u64 & totalSize);
+        static bool fill(Scenario & scenario, const std::vector<Section> & sections, const std::vector<u64> & sizes, u8* view, u64 totalSize);
+};
+
+class ScenarioPatch
+{
+    public:
+        static constexpr u32 Magic = 0x50444B43; // "CKDP"
+        static constexpr u32 Version = 1;
+
+        enum class Operation : u8 {
+            ReplaceSection = 0, // Replaces the whole contents of the section
+            Write = 1, // Writes bytes at an offset in the section, writes past the end of the section extend it
+            Resize = 2 // Truncates or zero-extends the section
+        };
+
+        ScenarioPatch();
+        virtual ~ScenarioPatch();
+
+        void replaceSection(SectionName sectionName, const void* data, size_t size);
+        void write(SectionName sectionName, size_t offset, const void* data, size_t size);
+        void resize(SectionName sectionName, size_t size);
+
+        template <typename Record> void writeRecord(SectionName sectionName, size_t recordIndex, const Record & record)
+        {
+            write(sectionName, recordIndex*sizeof(Record), &record, sizeof(Record));
+        }
+
+        bool empty() const;
+        size_t numOperations() const;
+        void clear();
+
+        std::vector<u8> serialize() const;
+        bool deserialize(const u8* data, size_t size); // Replaces the operations in this patch, returns false and leaves this empty if data isn't a valid patch
+
+        /** Replaces the operations in this patch with one replacing each section of updated that's missing from or differs from
+            current, so applying it to the scenario current was written from re-reads only the sections that changed; returns false
+            and leaves this empty if either view isn't valid or current has a section updated doesn't (patches can't remove sections) */
+        bool diff(const ScenarioView & current, const ScenarioView & updated);
+
+        /** Applies every operation to scenario, or applies nothing and returns false if any section can't be patched or read back */
+        bool apply(Scenario & scenario) const;
+
+    private:
+#pragma pack(push, 1)
+        __declspec(align(1)) struct Header {
+            u32 magic;
+            u32 version;
+            u32 numOperations;
+        };
+        __declspec(align(1)) struct OperationHeader {
+            Operation operation;
+            SectionName sectionName;
+            u32 offset; // The offset written at for Write, the new size for Resize
+            u32 size; // The number of data bytes that follow
+        };
+#pragma pack(pop)
+
+        struct PatchOperation {
+            Operation operation;
+            SectionName sectionName;
+            u32 offset;
+            std::vector<u8> data;
+        };
+
+        std::vector<PatchOperation> operations;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "Sc.h"
+#include "ScDataCache.h"
 #include <chrono>
 
 const std::string Sc::DataFile::starCraftFileName = "StarCraft.exe";
@@ -3343,7 +3344,7 @@ bool Sc::Pcx::load(const std::vector<MpqFilePtr> & orderedSourceFiles, const std
 }
 
 bool Sc::Data::load(Sc::DataFile::BrowserPtr dataFileBrowser, const std::unordered_map<Sc::DataFile::Priority, Sc::DataFile::Descriptor> & dataFiles,
-    const std::string & expectedStarCraftDirectory, FileBrowserPtr<u32> starCraftBrowser)
+    const std::string & expectedStarCraftDirectory, FileBrowserPtr<u32> starCraftBrowser, const std::string & cacheFilePath)
 {
     auto start = std::chrono::high_resolution_clock::now();
     logger.debug("Loading StarCraft Data...");
@@ -3357,40 +3358,85 @@ bool Sc::Data::load(Sc::DataFile::BrowserPtr dataFileBrowser, const std::unorder
         logger.error("No archives selected, many features will not work without the game files.\n\nInstall or locate StarCraft for the best experience.");
         return false;
     }
+
+    std::string sourceKey = cacheFilePath.empty() ? "" : ScDataCache::getSourceKey(orderedSourceFiles);
+    if ( !cacheFilePath.empty() && ScDataCache::read(*this, sourceKey, cacheFilePath) )
+    {
+        auto finish = std::chrono::high_resolution_clock::now();
+        logger.debug() << "StarCraft data loaded from cache in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
+        return true;
+    }
     
+    bool loadedAll = true;
     if ( !terrain.load(orderedSourceFiles) )
+    {
         CHKD_ERR("Failed to load terrain");
+        loadedAll = false;
+    }
 
     if ( !upgrades.load(orderedSourceFiles) )
+    {
         CHKD_ERR("Failed to load upgrades");
+        loadedAll = false;
+    }
 
     if ( !techs.load(orderedSourceFiles) )
+    {
         CHKD_ERR("Failed to load techs");
+        loadedAll = false;
+    }
 
     if ( !units.load(orderedSourceFiles) )
+    {
         CHKD_ERR("Failed to load unit dat");
+        loadedAll = false;
+    }
 
     if ( !weapons.load(orderedSourceFiles) )
+    {
         CHKD_ERR("Failed to load Weapons.dat");
+        loadedAll = false;
+    }
 
     if ( !sprites.load(orderedSourceFiles) )
+    {
         CHKD_ERR("Failed to load sprites!");
+        loadedAll = false;
+    }
 
     if ( !tunit.load(orderedSourceFiles, "game\\tunit.pcx") )
+    {
         CHKD_ERR("Failed to load tunit.pcx");
+        loadedAll = false;
+    }
 
     if ( !tminimap.load(orderedSourceFiles, "game\\tminimap.pcx") )
+    {
         CHKD_ERR("Failed to load tminimap.pcx");
+        loadedAll = false;
+    }
 
     if ( !tselect.load(orderedSourceFiles, "game\\tselect.pcx") )
+    {
         CHKD_ERR("Failed to load tselect.pcx");
+        loadedAll = false;
+    }
 
     Sc::TblFilePtr statTxt = Sc::TblFilePtr(new Sc::TblFile());
     if ( !statTxt->load(orderedSourceFiles, "Rez\\stat_txt.tbl") )
+    {
         CHKD_ERR("Failed to load stat_txt.tbl");
+        loadedAll = false;
+    }
 
     if ( !ai.load(orderedSourceFiles, statTxt) )
+    {
         CHKD_ERR("Failed to load AiScripts");
+        loadedAll = false;
+    }
+
+    if ( !cacheFilePath.empty() && loadedAll ) // Data that failed to load isn't cached, the next launch tries the archives again
+        ScDataCache::write(*this, sourceKey, cacheFilePath);
     
     auto finish = std::chrono::high_resolution_clock::now();
     logger.debug() << "StarCraft data loading completed in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
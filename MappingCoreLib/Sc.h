@@ -12,6 +12,8 @@
     This file also provides resources to find the StarCraft directory and load assets from the StarCraft data files
 */
 
+class ScDataCache;
+
 namespace Sc {
 
     /**
@@ -534,6 +536,8 @@ namespace Sc {
     private:
         std::vector<DatEntry> units;
         std::vector<FlingyDatEntry> flingies;
+
+        friend class ::ScDataCache; // Reads and writes the decoded data
     };
 
     class Sprite
@@ -691,6 +695,8 @@ namespace Sc {
 
         private:
             std::vector<u8> grpData;
+
+            friend class ::ScDataCache; // Reads and writes the decoded data
             
             inline bool isValid(const std::string & mpqFileName) const;
             inline bool fileHeaderIsValid(const std::string & mpqFileName) const;
@@ -710,6 +716,8 @@ namespace Sc {
         std::vector<Grp> grps;
         std::vector<ImageDatEntry> images;
         std::vector<DatEntry> sprites;
+
+        friend class ::ScDataCache; // Reads and writes the decoded data
     };
 
     class Upgrade {
@@ -835,6 +843,8 @@ namespace Sc {
 
     private:
         std::vector<DatEntry> upgrades;
+
+        friend class ::ScDataCache; // Reads and writes the decoded data
     };
 
     class Tech {
@@ -937,6 +947,8 @@ namespace Sc {
 
     private:
         std::vector<DatEntry> techs;
+
+        friend class ::ScDataCache; // Reads and writes the decoded data
     };
 
     class TblFile
@@ -950,6 +962,8 @@ namespace Sc {
 
     private:
         std::vector<std::string> strings;
+
+        friend class ::ScDataCache; // Reads and writes the decoded data
     };
     using TblFilePtr = std::shared_ptr<TblFile>;
 
@@ -1583,6 +1597,8 @@ namespace Sc {
     private:
         std::vector<Entry> entries;
         TblFilePtr statTxt;
+
+        friend class ::ScDataCache; // Reads and writes the decoded data
     };
 
     static constexpr size_t NumColors = 256;
@@ -1764,6 +1780,8 @@ namespace Sc {
 
     private:
         Tiles tilesets[NumTilesets];
+
+        friend class ::ScDataCache; // Reads and writes the decoded data
     };
 
     class Weapon {
@@ -1967,6 +1985,8 @@ namespace Sc {
 
     private:
         std::vector<DatEntry> weapons;
+
+        friend class ::ScDataCache; // Reads and writes the decoded data
     };
 
     class Sound {
@@ -2038,7 +2058,8 @@ namespace Sc {
         bool load(Sc::DataFile::BrowserPtr dataFileBrowser = Sc::DataFile::BrowserPtr(new Sc::DataFile::Browser()),
             const std::unordered_map<Sc::DataFile::Priority, Sc::DataFile::Descriptor> & dataFiles = Sc::DataFile::getDefaultDataFiles(),
             const std::string & expectedStarCraftDirectory = getDefaultScPath(),
-            FileBrowserPtr<u32> starCraftBrowser = Sc::DataFile::Browser::getDefaultStarCraftBrowser());
+            FileBrowserPtr<u32> starCraftBrowser = Sc::DataFile::Browser::getDefaultStarCraftBrowser(),
+            const std::string & cacheFilePath = ""); // If cacheFilePath is set, data is loaded from and saved to a cache there (see ScDataCache)
         
         static bool GetAsset(const std::vector<MpqFilePtr> & orderedSourceFiles, const std::string & assetMpqPath, std::vector<u8> & outAssetContents);
         static bool GetAsset(const std::string & assetMpqPath, std::vector<u8> & outAssetContents,
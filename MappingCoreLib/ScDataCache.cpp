@@ -0,0 +1,289 @@
+#include "ScDataCache.h"
+#include "sha256.h"
+#include "SystemIO.h"
+#include <SimpleIcu.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+const std::string ScDataCache::Magic = "ChkdScDataCache";
+
+class ScDataCache::Reader
+{
+    public:
+        Reader(const u8* buffer, size_t size) : buffer(buffer), size(size), offset(0) {}
+
+        bool atEnd() const { return offset == size; }
+
+        bool readCount(size_t & count, size_t elementSize)
+        {
+            u64 rawCount = 0;
+            if ( size - offset < sizeof(rawCount) )
+                return false;
+
+            std::memcpy(&rawCount, &buffer[offset], sizeof(rawCount));
+            offset += sizeof(rawCount);
+            if ( elementSize > 0 && rawCount > u64(size - offset) / u64(elementSize) )
+                return false;
+
+            count = size_t(rawCount);
+            return true;
+        }
+
+        template <typename T> bool readArray(T* values, size_t count)
+        {
+            size_t readCount = 0;
+            if ( !this->readCount(readCount, sizeof(T)) || readCount != count )
+                return false;
+
+            if ( count > 0 )
+                std::memcpy(values, &buffer[offset], count*sizeof(T));
+
+            offset += count*sizeof(T);
+            return true;
+        }
+
+        template <typename T> bool readArray(std::vector<T> & values)
+        {
+            size_t count = 0;
+            if ( !readCount(count, sizeof(T)) )
+                return false;
+
+            values.resize(count);
+            if ( count > 0 )
+                std::memcpy(&values[0], &buffer[offset], count*sizeof(T));
+
+            offset += count*sizeof(T);
+            return true;
+        }
+
+        bool readString(std::string & str)
+        {
+            size_t length = 0;
+            if ( !readCount(length, 1) )
+                return false;
+
+            str.assign((const char*)&buffer[offset], length);
+            offset += length;
+            return true;
+        }
+
+    private:
+        const u8* buffer;
+        size_t size;
+        size_t offset;
+};
+
+ScDataCache::~ScDataCache()
+{
+
+}
+
+std::string ScDataCache::getSourceKey(const std::vector<MpqFilePtr> & orderedSourceFiles)
+{
+    std::vector<std::string> orderedSourceFilePaths;
+    for ( const MpqFilePtr & mpqFile : orderedSourceFiles )
+        orderedSourceFilePaths.push_back(mpqFile == nullptr ? std::string() : mpqFile->getFilePath());
+
+    return getSourceKey(orderedSourceFilePaths);
+}
+
+std::string ScDataCache::getSourceKey(const std::vector<std::string> & orderedSourceFilePaths)
+{
+    SHA256 sha256;
+    const u64 layout[] = {
+        u64(Version), u64(sizeof(Sc::Terrain::TileGroup)), u64(sizeof(Sc::Terrain::Doodad)), u64(sizeof(Sc::Terrain::TileFlags)),
+        u64(sizeof(Sc::Terrain::TileGraphics)), u64(sizeof(Sc::Terrain::MiniTilePixels)), u64(sizeof(Sc::SystemColor)),
+        u64(sizeof(Sc::Unit::DatEntry)), u64(sizeof(Sc::Unit::FlingyDatEntry)), u64(sizeof(Sc::Weapon::DatEntry)),
+        u64(sizeof(Sc::Sprite::ImageDatEntry)), u64(sizeof(Sc::Sprite::DatEntry)), u64(sizeof(Sc::Upgrade::DatEntry)),
+        u64(sizeof(Sc::Tech::DatEntry)), u64(sizeof(Sc::Ai::Entry))
+    };
+    sha256.add(layout, sizeof(layout));
+
+    for ( const std::string & sourceFilePath : orderedSourceFilePaths )
+    {
+        std::error_code error;
+        std::filesystem::path path(icux::toFilestring(sourceFilePath));
+        u64 fileSize = u64(std::filesystem::file_size(path, error));
+        if ( error )
+            fileSize = u64_max;
+
+        s64 lastWriteTime = s64(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+        if ( error )
+            lastWriteTime = 0;
+
+        sha256.add(sourceFilePath.c_str(), sourceFilePath.size()+1);
+        sha256.add(&fileSize, sizeof(fileSize));
+        sha256.add(&lastWriteTime, sizeof(lastWriteTime));
+
+        MappedFile sourceFile;
+        if ( sourceFile.open(sourceFilePath) ) // Archives keep their header at the start and their hash and block tables at the end
+        {
+            size_t sampleSize = std::min(sourceFile.size(), SourceSampleSize);
+            sha256.add(sourceFile.data(), sampleSize);
+            sha256.add(sourceFile.data() + sourceFile.size() - sampleSize, sampleSize);
+        }
+    }
+    return sha256.getHash();
+}
+
+template <typename T>
+void ScDataCache::writeArray(std::vector<u8> & buffer, const T* values, size_t count)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Cached structures must be copyable as raw bytes");
+    writeCount(buffer, count);
+    if ( count > 0 )
+        buffer.insert(buffer.end(), (const u8*)values, (const u8*)values + count*sizeof(T));
+}
+
+template <typename T>
+void ScDataCache::writeArray(std::vector<u8> & buffer, const std::vector<T> & values)
+{
+    writeArray(buffer, values.empty() ? nullptr : &values[0], values.size());
+}
+
+void ScDataCache::writeCount(std::vector<u8> & buffer, size_t count)
+{
+    u64 rawCount = u64(count);
+    const u8* countBytes = (const u8*)&rawCount;
+    buffer.insert(buffer.end(), countBytes, countBytes+sizeof(rawCount));
+}
+
+void ScDataCache::writeString(std::vector<u8> & buffer, const std::string & str)
+{
+    writeArray(buffer, str.c_str(), str.size());
+}
+
+bool ScDataCache::write(const Sc::Data & data, const std::string & sourceKey, const std::string & cacheFilePath)
+{
+    std::vector<u8> buffer;
+    writeString(buffer, Magic);
+    writeString(buffer, sourceKey);
+
+    for ( size_t i=0; i<Sc::Terrain::NumTilesets; i++ )
+    {
+        const Sc::Terrain::Tiles & tiles = data.terrain.tilesets[i];
+        writeArray(buffer, tiles.tileGroups);
+        writeArray(buffer, tiles.doodads);
+        writeArray(buffer, tiles.tileFlags);
+        writeArray(buffer, tiles.tileGraphics);
+        writeArray(buffer, tiles.miniTilePixels);
+        writeArray(buffer, &tiles.systemColorPalette[0], tiles.systemColorPalette.size());
+    }
+
+    writeArray(buffer, data.units.units);
+    writeArray(buffer, data.units.flingies);
+    writeArray(buffer, data.weapons.weapons);
+    writeArray(buffer, data.upgrades.upgrades);
+    writeArray(buffer, data.techs.techs);
+
+    writeArray(buffer, data.sprites.images);
+    writeArray(buffer, data.sprites.sprites);
+    writeCount(buffer, data.sprites.grps.size());
+    for ( const Sc::Sprite::Grp & grp : data.sprites.grps )
+        writeArray(buffer, grp.grpData);
+
+    writeArray(buffer, data.ai.entries);
+    const std::vector<std::string> noStrings;
+    const std::vector<std::string> & statTxtStrings = data.ai.statTxt == nullptr ? noStrings : data.ai.statTxt->strings;
+    writeCount(buffer, statTxtStrings.size());
+    for ( const std::string & str : statTxtStrings )
+        writeString(buffer, str);
+
+    writeArray(buffer, data.tunit.palette);
+    writeArray(buffer, data.tselect.palette);
+    writeArray(buffer, data.tminimap.palette);
+
+    std::filesystem::path path(icux::toFilestring(cacheFilePath));
+    std::filesystem::path partialPath(icux::toFilestring(cacheFilePath + ".partial"));
+    {
+        std::ofstream outFile(partialPath, std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+        outFile.write((const char*)&buffer[0], std::streamsize(buffer.size()));
+        if ( !outFile.good() )
+        {
+            logger.warn() << "Failed to write StarCraft data cache to " << cacheFilePath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(partialPath, path, error);
+    if ( error )
+    {
+        logger.warn() << "Failed to replace StarCraft data cache " << cacheFilePath << ": " << error.message() << std::endl;
+        std::filesystem::remove(partialPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool ScDataCache::read(Sc::Data & data, const std::string & sourceKey, const std::string & cacheFilePath)
+{
+    MappedFile cacheFile;
+    if ( !cacheFile.open(cacheFilePath) )
+        return false;
+
+    Reader reader(cacheFile.data(), cacheFile.size());
+    std::string magic, key;
+    if ( !reader.readString(magic) || magic != Magic || !reader.readString(key) || key != sourceKey )
+        return false;
+
+    Sc::Data loaded;
+    bool success = true;
+    for ( size_t i=0; i<Sc::Terrain::NumTilesets; i++ )
+    {
+        Sc::Terrain::Tiles & tiles = loaded.terrain.tilesets[i];
+        success = success &&
+            reader.readArray(tiles.tileGroups) &&
+            reader.readArray(tiles.doodads) &&
+            reader.readArray(tiles.tileFlags) &&
+            reader.readArray(tiles.tileGraphics) &&
+            reader.readArray(tiles.miniTilePixels) &&
+            reader.readArray(&tiles.systemColorPalette[0], tiles.systemColorPalette.size());
+    }
+
+    success = success &&
+        reader.readArray(loaded.units.units) &&
+        reader.readArray(loaded.units.flingies) &&
+        reader.readArray(loaded.weapons.weapons) &&
+        reader.readArray(loaded.upgrades.upgrades) &&
+        reader.readArray(loaded.techs.techs) &&
+        reader.readArray(loaded.sprites.images) &&
+        reader.readArray(loaded.sprites.sprites);
+
+    size_t numGrps = 0;
+    if ( success && (success = reader.readCount(numGrps, sizeof(u64))) )
+    {
+        loaded.sprites.grps.resize(numGrps);
+        for ( size_t i=0; i<numGrps && success; i++ )
+            success = reader.readArray(loaded.sprites.grps[i].grpData);
+    }
+
+    success = success && reader.readArray(loaded.ai.entries);
+
+    size_t numStatTxtStrings = 0;
+    if ( success && (success = reader.readCount(numStatTxtStrings, sizeof(u64))) )
+    {
+        Sc::TblFilePtr statTxt = Sc::TblFilePtr(new Sc::TblFile());
+        statTxt->strings.resize(numStatTxtStrings);
+        for ( size_t i=0; i<numStatTxtStrings && success; i++ )
+            success = reader.readString(statTxt->strings[i]);
+
+        loaded.ai.statTxt = statTxt;
+    }
+
+    success = success &&
+        reader.readArray(loaded.tunit.palette) &&
+        reader.readArray(loaded.tselect.palette) &&
+        reader.readArray(loaded.tminimap.palette) &&
+        reader.atEnd();
+
+    if ( success )
+        data = std::move(loaded);
+    else
+        logger.warn() << "StarCraft data cache " << cacheFilePath << " is incomplete, it will be rebuilt" << std::endl;
+
+    return success;
+}
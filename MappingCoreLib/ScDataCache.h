@@ -0,0 +1,51 @@
+#ifndef SCDATACACHE_H
+#define SCDATACACHE_H
+#include "Basics.h"
+#include "Sc.h"
+#include <string>
+#include <vector>
+
+/**
+    The Sc data cache stores the fully decoded state of Sc::Data (tile tables, DAT entries, palettes, GRPs, AI entries and the
+    stat_txt strings they're named with) in a single flat file so later launches can skip extracting and parsing every asset
+
+    A cache file is keyed by the source archives it was decoded from: the key hashes the cache version, the size of every cached
+    structure and, for each archive in priority order, its path, size, last write time and the contents of its first and last
+    SourceSampleSize bytes (which hold the archive's header and its hash and block tables), so replacing or patching any archive
+    (or changing the cached layout) means the key no longer matches and the cache is rebuilt from the archives
+
+    The file is the key followed by each cached array as a count and the raw structures, it's mapped into memory and read back
+    with one copy per array rather than any parsing
+*/
+
+class ScDataCache
+{
+    public:
+        static constexpr u32 Version = 1; // Increment whenever what's cached or how it's laid out changes
+
+        virtual ~ScDataCache();
+
+        static std::string getSourceKey(const std::vector<MpqFilePtr> & orderedSourceFiles);
+        static std::string getSourceKey(const std::vector<std::string> & orderedSourceFilePaths);
+
+        /** Writes data to cacheFilePath under sourceKey, the file is written aside and moved into place so an interrupted write
+            never leaves a partial cache behind */
+        static bool write(const Sc::Data & data, const std::string & sourceKey, const std::string & cacheFilePath);
+
+        /** Reads data from cacheFilePath if the file exists, is complete and was written under sourceKey; otherwise returns false
+            and leaves data unchanged */
+        static bool read(Sc::Data & data, const std::string & sourceKey, const std::string & cacheFilePath);
+
+    private:
+        static const std::string Magic;
+        static constexpr size_t SourceSampleSize = 0x10000;
+
+        class Reader;
+
+        template <typename T> static void writeArray(std::vector<u8> & buffer, const T* values, size_t count);
+        template <typename T> static void writeArray(std::vector<u8> & buffer, const std::vector<T> & values);
+        static void writeCount(std::vector<u8> & buffer, size_t count);
+        static void writeString(std::vector<u8> & buffer, const std::string & str);
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include "../CommanderLib/Logger.h"
 #include "Sections.h"
 #include <algorithm>
+#include <cassert>
 #include <cstdio>
 #include <exception>
 #include <functional>
@@ -139,6 +140,11 @@ bool Scenario::empty() const
     return allSections.empty() && tailLength == 0 && versions.empty() && strings.empty() && players.empty() && layers.empty() && properties.empty() && triggers.empty();
 }
 
+u64 Scenario::getModificationEpoch() const
+{
+    return strings.getModificationEpoch() + layers.getLocationModificationEpoch() + triggers.getModificationEpoch(); // Each only increases, so the sum changes with any of them
+}
+
 bool Scenario::isProtected() const
 {
     return mapIsProtected;
@@ -373,6 +379,64 @@ bool Scenario::parsingFailed(const std::string & error)
     return false;
 }
 
+std::vector<Section> Scenario::getSectionsInUse() const
+{
+    std::vector<Section> sectionsInUse;
+    const Section sections[] = {
+        versions.type, versions.ver, versions.iver, versions.ive2, versions.vcod, players.iown, players.ownr, layers.era,
+        layers.dim, players.side, layers.mtxm, properties.puni, properties.upgr, properties.ptec, layers.unit, layers.isom,
+        layers.tile, layers.dd2, layers.thg2, layers.mask, strings.str, triggers.uprp, triggers.upus, layers.mrgn,
+        triggers.trig, triggers.mbrf, strings.sprp, players.forc, triggers.wav, properties.unis, properties.upgs, properties.tecs,
+        triggers.swnm, players.colr, properties.pupx, properties.ptex, properties.unix, properties.upgx, properties.tecx,
+        strings.ostr, strings.kstr, triggers.ktrg, triggers.ktgp
+    };
+    for ( const Section & section : sections )
+    {
+        if ( section != nullptr )
+            sectionsInUse.push_back(section);
+    }
+    return sectionsInUse;
+}
+
+void Scenario::replaceSections(std::unordered_map<SectionName, Section> & replacements)
+{
+    std::unordered_map<SectionName, Section> sections;
+    for ( const Section & section : getSectionsInUse() )
+        sections.insert(std::pair<SectionName, Section>(section->getName(), section));
+
+    for ( auto & replacement : replacements )
+    {
+        sections[replacement.first] = replacement.second;
+
+        bool replaced = false; // The first saved instance is replaced, any later instances are removed
+        for ( auto it = allSections.begin(); it != allSections.end(); )
+        {
+            if ( (*it)->getName() != replacement.first )
+                ++it;
+            else if ( !replaced )
+            {
+                *it = replacement.second;
+                replaced = true;
+                ++it;
+            }
+            else
+                it = allSections.erase(it);
+        }
+        if ( !replaced )
+            allSections.push_back(replacement.second);
+    }
+
+    versions.set(sections);
+    strings.set(sections);
+    players.set(sections);
+    layers.set(sections);
+    properties.set(sections);
+    triggers.set(sections);
+
+    if ( replacements.count(SectionName::TRIG) > 0 || replacements.count(SectionName::KTRG) > 0 || replacements.count(SectionName::KTGP) > 0 )
+        triggers.fixTriggerExtensions();
+}
+
 void Scenario::write(std::ostream & os)
 {
     try
@@ -430,11 +494,42 @@ void Scenario::updateSaveSections()
         addSection(triggers.ktgp);
 }
 
+Scenario::VersionChange Scenario::planVersionChange(Chk::Version version, bool lockAnywhere, bool autoDefragmentLocations) const
+{
+    VersionChange versionChange;
+    versionChange.version = version;
+    versionChange.numLocationsUsed = layers.planTrimLocationsToOriginal(versionChange.locationIdRemappings, lockAnywhere);
+    versionChange.possible = version >= Chk::Version::StarCraft_Hybrid || versionChange.numLocationsUsed <= Chk::TotalOriginalLocations;
+    if ( versionChange.possible ) // Moving locations does not change which strings are used, so unused strings are found before anything is moved
+    {
+        std::bitset<Chk::MaxStrings> gameStringIdUsed, editorStringIdUsed;
+        strings.markUsedStrings(gameStringIdUsed, Chk::Scope::Either, Chk::Scope::Game);
+        strings.markUsedStrings(editorStringIdUsed, Chk::Scope::Either, Chk::Scope::Editor);
+        for ( size_t stringId=0; stringId<strings.getCapacity(Chk::Scope::Game); stringId++ )
+        {
+            if ( !gameStringIdUsed[stringId] && strings.stringStored(stringId, Chk::Scope::Game) )
+                versionChange.unusedGameStringIds.push_back(stringId);
+        }
+        for ( size_t stringId=0; stringId<strings.getCapacity(Chk::Scope::Editor); stringId++ )
+        {
+            if ( !editorStringIdUsed[stringId] && strings.stringStored(stringId, Chk::Scope::Editor) )
+                versionChange.unusedEditorStringIds.push_back(stringId);
+        }
+    }
+    return versionChange;
+}
+
 bool Scenario::changeVersionTo(Chk::Version version, bool lockAnywhere, bool autoDefragmentLocations)
 {
-    if ( versions.changeTo(version, lockAnywhere, autoDefragmentLocations) )
+    VersionChange versionChange = planVersionChange(version, lockAnywhere, autoDefragmentLocations);
+    if ( versionChange.possible )
     {
-        strings.deleteUnusedStrings(Chk::Scope::Both);
+        versions.applyChangeTo(version, versionChange.locationIdRemappings);
+        for ( size_t stringId : versionChange.unusedGameStringIds )
+            strings.str->deleteString(stringId, false);
+        for ( size_t stringId : versionChange.unusedEditorStringIds )
+            strings.kstr->deleteString(stringId, false);
+
         if ( version < Chk::Version::StarCraft_BroodWar ) // Original or Hybrid: No COLR, include all original properties
         {
             if ( version < Chk::Version::StarCraft_Hybrid ) // Original: No TYPE, IVE2, or expansion properties
@@ -475,6 +570,7 @@ bool Scenario::changeVersionTo(Chk::Version version, bool lockAnywhere, bool aut
         }
         return true;
     }
+    logger.error("Cannot save as original with over 64 locations in use!");
     return false;
 }
 
@@ -564,6 +660,7 @@ void Scenario::upgradeKstrToCurrent()
                             }
                         }
                     }
+                    triggers.markModified(); // Action string ids were changed in the section directly
                 }
                 break;
                 case Chk::SectionName::MBRF:
@@ -814,20 +911,34 @@ bool Versions::isHybridOrAbove() const
 
 bool Versions::changeTo(Chk::Version version, bool lockAnywhere, bool autoDefragmentLocations)
 {
-    Chk::Version oldVersion = ver->getVersion();
+    Chk::LocationIdRemappings locationIdRemappings;
+    if ( version < Chk::Version::StarCraft_Hybrid && layers->planTrimLocationsToOriginal(locationIdRemappings, lockAnywhere) > Chk::TotalOriginalLocations )
+    {
+        logger.error("Cannot save as original with over 64 locations in use!");
+        return false;
+    }
+    applyChangeTo(version, locationIdRemappings);
+    return true;
+}
+
+bool Versions::hasDefaultValidation() const
+{
+    return vcod->isDefault();
+}
+
+void Versions::setToDefaultValidation()
+{
+    vcod->setToDefault();
+}
+
+void Versions::applyChangeTo(Chk::Version version, const Chk::LocationIdRemappings & locationIdRemappings)
+{
     ver->setVersion(version);
     if ( version < Chk::Version::StarCraft_Hybrid )
     {
-        if ( layers->trimLocationsToOriginal(lockAnywhere, autoDefragmentLocations) )
-        {
-            type->setType(Chk::Type::RAWS);
-            iver->setVersion(Chk::IVersion::Current);
-        }
-        else
-        {
-            logger.error("Cannot save as original with over 64 locations in use!");
-            return false;
-        }
+        layers->trimLocationsToOriginal(locationIdRemappings);
+        type->setType(Chk::Type::RAWS);
+        iver->setVersion(Chk::IVersion::Current);
     }
     else if ( version < Chk::Version::StarCraft_BroodWar )
     {
@@ -843,17 +954,6 @@ bool Versions::changeTo(Chk::Version version, bool lockAnywhere, bool autoDefrag
         ive2->setVersion(Chk::I2Version::StarCraft_1_04);
         layers->expandToScHybridOrExpansion();
     }
-    return true;
-}
-
-bool Versions::hasDefaultValidation() const
-{
-    return vcod->isDefault();
-}
-
-void Versions::setToDefaultValidation()
-{
-    vcod->setToDefault();
 }
 
 void Versions::set(std::unordered_map<SectionName, Section> & sections)
@@ -888,7 +988,7 @@ void Versions::clear()
 
 
 Strings::Strings(bool useDefault) : versions(nullptr), players(nullptr), layers(nullptr), properties(nullptr), triggers(nullptr),
-    StrSynchronizer(StrCompressFlag::DuplicateStringRecycling, StrCompressFlag::AllNonInterlacing)
+    StrSynchronizer(StrCompressFlag::DuplicateStringRecycling, StrCompressFlag::AllNonInterlacing), modificationEpoch(0)
 {
     if ( useDefault )
     {
@@ -915,6 +1015,11 @@ bool Strings::hasExtendedStrings() const
     return ostr != nullptr && kstr != nullptr && !kstr->empty();
 }
 
+u64 Strings::getModificationEpoch() const
+{
+    return modificationEpoch;
+}
+
 size_t Strings::getCapacity(Chk::Scope storageScope) const
 {
     if ( storageScope == Chk::Scope::Game )
@@ -1144,6 +1249,7 @@ template size_t Strings::findString<SingleLineChkdString>(const SingleLineChkdSt
 
 void Strings::setCapacity(size_t stringCapacity, Chk::Scope storageScope, bool autoDefragment)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Game )
         str->setCapacity(stringCapacity, *this, autoDefragment);
     else if ( storageScope == Chk::Scope::Editor )
@@ -1153,6 +1259,7 @@ void Strings::setCapacity(size_t stringCapacity, Chk::Scope storageScope, bool a
 template <typename StringType>
 size_t Strings::addString(const StringType & str, Chk::Scope storageScope, bool autoDefragment)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Game )
         return this->str->addString<StringType>(str, *this, autoDefragment);
     else if ( storageScope == Chk::Scope::Editor )
@@ -1165,9 +1272,26 @@ template size_t Strings::addString<EscString>(const EscString & str, Chk::Scope
 template size_t Strings::addString<ChkdString>(const ChkdString & str, Chk::Scope storageScope, bool autoDefragment);
 template size_t Strings::addString<SingleLineChkdString>(const SingleLineChkdString & str, Chk::Scope storageScope, bool autoDefragment);
 
+template <typename StringType>
+std::vector<size_t> Strings::addStrings(const std::vector<StringType> & strs, Chk::Scope storageScope, bool autoDefragment, const std::vector<size_t> & reservedStringIds)
+{
+    modificationEpoch++;
+    if ( storageScope == Chk::Scope::Game )
+        return str->addStrings<StringType>(strs, *this, autoDefragment, reservedStringIds);
+    else if ( storageScope == Chk::Scope::Editor )
+        return kstr->addStrings<StringType>(strs, *this, autoDefragment, reservedStringIds);
+
+    return std::vector<size_t>(strs.size(), size_t(Chk::StringId::NoString));
+}
+template std::vector<size_t> Strings::addStrings<RawString>(const std::vector<RawString> & strs, Chk::Scope storageScope, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> Strings::addStrings<EscString>(const std::vector<EscString> & strs, Chk::Scope storageScope, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> Strings::addStrings<ChkdString>(const std::vector<ChkdString> & strs, Chk::Scope storageScope, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> Strings::addStrings<SingleLineChkdString>(const std::vector<SingleLineChkdString> & strs, Chk::Scope storageScope, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+
 template <typename StringType>
 void Strings::replaceString(size_t stringId, const StringType & str, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Game )
         this->str->replaceString<StringType>(stringId, str);
     else if ( storageScope == Chk::Scope::Editor )
@@ -1178,8 +1302,23 @@ template void Strings::replaceString<EscString>(size_t stringId, const EscString
 template void Strings::replaceString<ChkdString>(size_t stringId, const ChkdString & str, Chk::Scope storageScope);
 template void Strings::replaceString<SingleLineChkdString>(size_t stringId, const SingleLineChkdString & str, Chk::Scope storageScope);
 
+template <typename StringType>
+void Strings::replaceStrings(const std::vector<std::pair<size_t, StringType>> & replacements, Chk::Scope storageScope)
+{
+    modificationEpoch++;
+    if ( storageScope == Chk::Scope::Game )
+        this->str->replaceStrings<StringType>(replacements);
+    else if ( storageScope == Chk::Scope::Editor )
+        kstr->replaceStrings<StringType>(replacements);
+}
+template void Strings::replaceStrings<RawString>(const std::vector<std::pair<size_t, RawString>> & replacements, Chk::Scope storageScope);
+template void Strings::replaceStrings<EscString>(const std::vector<std::pair<size_t, EscString>> & replacements, Chk::Scope storageScope);
+template void Strings::replaceStrings<ChkdString>(const std::vector<std::pair<size_t, ChkdString>> & replacements, Chk::Scope storageScope);
+template void Strings::replaceStrings<SingleLineChkdString>(const std::vector<std::pair<size_t, SingleLineChkdString>> & replacements, Chk::Scope storageScope);
+
 void Strings::deleteUnusedStrings(Chk::Scope storageScope)
 {
+    modificationEpoch++;
     switch ( storageScope )
     {
         case Chk::Scope::Game: str->deleteUnusedStrings(*this); break;
@@ -1190,6 +1329,7 @@ void Strings::deleteUnusedStrings(Chk::Scope storageScope)
 
 void Strings::deleteString(size_t stringId, Chk::Scope storageScope, bool deleteOnlyIfUnused)
 {
+    modificationEpoch++;
     if ( (storageScope & Chk::Scope::Game) == Chk::Scope::Game )
     {
         if ( !deleteOnlyIfUnused || !stringUsed(stringId, Chk::Scope::Game) )
@@ -1216,8 +1356,49 @@ void Strings::deleteString(size_t stringId, Chk::Scope storageScope, bool delete
     }
 }
 
+void Strings::deleteStrings(const std::vector<size_t> & stringIds, Chk::Scope storageScope, bool deleteOnlyIfUnused)
+{
+    modificationEpoch++;
+    std::bitset<Chk::MaxStrings> gameStringIdUsed, editorStringIdUsed;
+    if ( deleteOnlyIfUnused )
+    {
+        if ( (storageScope & Chk::Scope::Game) == Chk::Scope::Game )
+            markUsedStrings(gameStringIdUsed, Chk::Scope::Game, Chk::Scope::Game); // As in stringUsed(stringId, Chk::Scope::Game)
+        if ( (storageScope & Chk::Scope::Editor) == Chk::Scope::Editor )
+            ostr->markUsedStrings(editorStringIdUsed); // As in stringUsed(stringId, Chk::Scope::Either, Chk::Scope::Editor, Chk::StringUserFlag::All, true)
+    }
+
+    for ( size_t stringId : stringIds )
+    {
+        if ( stringId >= Chk::MaxStrings ) // Beyond what can be marked
+            deleteString(stringId, storageScope, deleteOnlyIfUnused);
+        else
+        {
+            if ( (storageScope & Chk::Scope::Game) == Chk::Scope::Game && !gameStringIdUsed[stringId] )
+            {
+                str->deleteString(stringId, false);
+
+                sprp->deleteString(stringId);
+                players->deleteString(stringId);
+                properties->deleteString(stringId);
+                layers->deleteString(stringId);
+                triggers->deleteString(stringId, Chk::Scope::Game);
+            }
+
+            if ( (storageScope & Chk::Scope::Editor) == Chk::Scope::Editor && (!editorStringIdUsed[stringId] || !kstr->stringStored(stringId)) )
+            {
+                kstr->deleteString(stringId, false);
+
+                ostr->deleteString(stringId);
+                triggers->deleteString(stringId, Chk::Scope::Editor);
+            }
+        }
+    }
+}
+
 void Strings::moveString(size_t stringIdFrom, size_t stringIdTo, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Game )
         str->moveString(stringIdFrom, stringIdTo, *this);
     else if ( storageScope == Chk::Scope::Editor )
@@ -1226,6 +1407,7 @@ void Strings::moveString(size_t stringIdFrom, size_t stringIdTo, Chk::Scope stor
 
 size_t Strings::rescopeString(size_t stringId, Chk::Scope changeStorageScopeTo, bool autoDefragment)
 {
+    modificationEpoch++;
     if ( changeStorageScopeTo == Chk::Scope::Editor && stringUsed(stringId, Chk::Scope::Either, Chk::Scope::Game, Chk::StringUserFlag::All, true) )
     {
         RawStringPtr toRescope = getString<RawString>(stringId, Chk::Scope::Game);
@@ -1448,13 +1630,14 @@ size_t Strings::getLocationNameStringId(size_t locationId, Chk::Scope storageSco
         return ostr->getLocationNameStringId(locationId);
     else
     {
-        Chk::LocationPtr location = layers->getLocation(locationId);
+        const Chk::LocationPtr location = static_cast<const Layers*>(layers)->getLocation(locationId); // Reading doesn't count as a location change
         return location != nullptr ? location->stringId : 0;
     }
 }
 
 void Strings::setScenarioNameStringId(size_t scenarioNameStringId, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Editor )
         ostr->setScenarioNameStringId((u32)scenarioNameStringId);
     else
@@ -1463,6 +1646,7 @@ void Strings::setScenarioNameStringId(size_t scenarioNameStringId, Chk::Scope st
 
 void Strings::setScenarioDescriptionStringId(size_t scenarioDescriptionStringId, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Editor )
         ostr->setScenarioDescriptionStringId((u32)scenarioDescriptionStringId);
     else
@@ -1471,6 +1655,7 @@ void Strings::setScenarioDescriptionStringId(size_t scenarioDescriptionStringId,
 
 void Strings::setForceNameStringId(Chk::Force force, size_t forceNameStringId, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Editor )
         ostr->setForceNameStringId(force, (u32)forceNameStringId);
     else
@@ -1479,6 +1664,7 @@ void Strings::setForceNameStringId(Chk::Force force, size_t forceNameStringId, C
 
 void Strings::setUnitNameStringId(Sc::Unit::Type unitType, size_t unitNameStringId, Chk::UseExpSection useExp, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Game )
         properties->setUnitNameStringId(unitType, unitNameStringId, useExp);
     else
@@ -1497,6 +1683,7 @@ void Strings::setUnitNameStringId(Sc::Unit::Type unitType, size_t unitNameString
 
 void Strings::setSoundPathStringId(size_t soundIndex, size_t soundPathStringId, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Editor )
         ostr->setSoundPathStringId(soundIndex, (u32)soundPathStringId);
     else
@@ -1505,6 +1692,7 @@ void Strings::setSoundPathStringId(size_t soundIndex, size_t soundPathStringId,
 
 void Strings::setSwitchNameStringId(size_t switchIndex, size_t switchNameStringId, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Editor )
         ostr->setSwitchNameStringId(switchIndex, (u32)switchNameStringId);
     else
@@ -1513,6 +1701,7 @@ void Strings::setSwitchNameStringId(size_t switchIndex, size_t switchNameStringI
 
 void Strings::setLocationNameStringId(size_t locationId, size_t locationNameStringId, Chk::Scope storageScope)
 {
+    modificationEpoch++;
     if ( storageScope == Chk::Scope::Editor )
         ostr->setLocationNameStringId(locationId, (u32)locationNameStringId);
     else
@@ -1614,6 +1803,7 @@ template std::shared_ptr<SingleLineChkdString> Strings::getSwitchName<SingleLine
 template <typename StringType>
 std::shared_ptr<StringType> Strings::getLocationName(size_t locationId, Chk::Scope storageScope) const
 {
+    const Layers* layers = this->layers; // Reading doesn't count as a location change
     return getString<StringType>((locationId > 0 && locationId <= layers->numLocations() ? layers->getLocation(locationId)->stringId : 0), ostr->getLocationNameStringId(locationId), storageScope);
 }
 template std::shared_ptr<RawString> Strings::getLocationName<RawString>(size_t locationId, Chk::Scope storageScope) const;
@@ -1831,7 +2021,7 @@ template void Strings::setExtendedNotes<EscString>(size_t triggerIndex, const Es
 template void Strings::setExtendedNotes<ChkdString>(size_t triggerIndex, const ChkdString & notes, bool autoDefragment);
 template void Strings::setExtendedNotes<SingleLineChkdString>(size_t triggerIndex, const SingleLineChkdString & notes, bool autoDefragment);
 
-void Strings::syncStringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8> & stringBytes,
+void Strings::syncStringsToBytes(const ScStrArena & arena, const std::vector<u32> & strings, std::vector<u8> & stringBytes,
     StrCompressionElevatorPtr compressionElevator, u32 requestedCompressionFlags, u32 allowedCompressionFlags)
 {
     /**
@@ -1851,8 +2041,8 @@ void Strings::syncStringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8>
     size_t sectionSize = sizeAndOffsetSpaceAndNulSpace;
     for ( size_t i=1; i<=numStrings; i++ )
     {
-        if ( strings[i] != nullptr )
-            sectionSize += strings[i]->length();
+        if ( strings[i] != ScStrArena::NoStr )
+            sectionSize += arena.length(strings[i]);
     }
 
     constexpr size_t maxStandardSize = u16_max;
@@ -1865,17 +2055,17 @@ void Strings::syncStringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8>
     stringBytes.push_back(u8('\0')); // Add initial NUL character
     for ( size_t i=1; i<=numStrings; i++ )
     {
-        if ( strings[i] == nullptr )
+        if ( strings[i] == ScStrArena::NoStr )
             (u16 &)stringBytes[sizeof(u16)*i] = initialNulOffset;
         else
         {
             (u16 &)stringBytes[sizeof(u16)*i] = u16(stringBytes.size());
-            stringBytes.insert(stringBytes.end(), strings[i]->str, strings[i]->str+(strings[i]->length()+1));
+            stringBytes.insert(stringBytes.end(), arena.str(strings[i]), arena.str(strings[i])+(arena.length(strings[i])+1));
         }
     }
 }
 
-void Strings::syncKstringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8> & stringBytes,
+void Strings::syncKstringsToBytes(const ScStrArena & arena, const std::vector<u32> & strings, const std::vector<StrProp> & stringProperties, std::vector<u8> & stringBytes,
     StrCompressionElevatorPtr compressionElevator, u32 requestedCompressionFlags, u32 allowedCompressionFlags)
 {
     /**
@@ -1898,8 +2088,8 @@ void Strings::syncKstringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8
     size_t sectionSize = versionAndSizeAndOffsetAndStringPropertiesAndNulSpace;
     for ( size_t i=1; i<=numStrings; i++ )
     {
-        if ( strings[i] != nullptr )
-            sectionSize += strings[i]->length();
+        if ( strings[i] != ScStrArena::NoStr )
+            sectionSize += arena.length(strings[i]);
     }
 
     constexpr size_t maxStandardSize = s32_max;
@@ -1913,14 +2103,14 @@ void Strings::syncKstringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8
     stringBytes.push_back(u8('\0')); // Add initial NUL character
     for ( size_t i=1; i<=numStrings; i++ )
     {
-        if ( strings[i] == nullptr )
+        if ( strings[i] == ScStrArena::NoStr )
             (u32 &)stringBytes[sizeof(u32)+sizeof(u32)*i] = initialNulOffset;
         else
         {
-            auto prop = strings[i]->properties();
+            const StrProp & prop = stringProperties[i];
             (u32 &)stringBytes[stringPropertiesStart+sizeof(u32)*i] = (u32 &)Chk::StringProperties(prop.red, prop.green, prop.blue, prop.isUsed, prop.hasPriority, prop.isBold, prop.isUnderlined, prop.isItalics, prop.size);
             (u32 &)stringBytes[sizeof(u32)+sizeof(u32)*i] = u32(stringBytes.size());
-            stringBytes.insert(stringBytes.end(), strings[i]->str, strings[i]->str+strings[i]->length()+1);
+            stringBytes.insert(stringBytes.end(), arena.str(strings[i]), arena.str(strings[i])+arena.length(strings[i])+1);
         }
     }
 }
@@ -1985,13 +2175,17 @@ Strings::StringBackup Strings::backup() const
 
 void Strings::restore(StringBackup & backup)
 {
+    modificationEpoch++;
     if ( str != nullptr )
         str->restore(backup.strBackup);
 }
 
-void Strings::remapStringIds(const std::map<u32, u32> & stringIdRemappings, Chk::Scope storageScope)
+void Strings::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings, Chk::Scope storageScope)
 {
-    if ( storageScope == Chk::Scope::Game )
+    modificationEpoch++;
+    if ( stringIdRemappings.empty() )
+        return;
+    else if ( storageScope == Chk::Scope::Game )
     {
         sprp->remapStringIds(stringIdRemappings);
         players->remapStringIds(stringIdRemappings);
@@ -2008,6 +2202,7 @@ void Strings::remapStringIds(const std::map<u32, u32> & stringIdRemappings, Chk:
 
 void Strings::set(std::unordered_map<SectionName, Section> & sections)
 {
+    modificationEpoch++;
     sprp = GetSection<SprpSection>(sections, SectionName::SPRP);
     str = GetSection<StrSection>(sections, SectionName::STR);
     ostr = GetSection<OstrSection>(sections, SectionName::OSTR);
@@ -2023,6 +2218,7 @@ void Strings::set(std::unordered_map<SectionName, Section> & sections)
 
 void Strings::clear()
 {
+    modificationEpoch++;
     sprp = nullptr;
     str = nullptr;
     ostr = nullptr;
@@ -2145,7 +2341,7 @@ void Players::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 u
         forc->markUsedStrings(stringIdUsed);
 }
 
-void Players::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void Players::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     forc->remapStringIds(stringIdRemappings);
 }
@@ -2344,12 +2540,12 @@ void Terrain::clear()
 }
 
 
-Layers::Layers() : Terrain(), strings(nullptr), triggers(nullptr)
+Layers::Layers() : Terrain(), strings(nullptr), triggers(nullptr), locationModificationEpoch(0)
 {
 
 }
 
-Layers::Layers(Sc::Terrain::Tileset tileset, u16 width, u16 height) : Terrain(tileset, width, height), strings(nullptr)
+Layers::Layers(Sc::Terrain::Tileset tileset, u16 width, u16 height) : Terrain(tileset, width, height), strings(nullptr), locationModificationEpoch(0)
 {
     mask = MaskSection::GetDefault(width, height); // Fog of war
     thg2 = Thg2Section::GetDefault(); // Sprites
@@ -2616,6 +2812,11 @@ void Layers::removeOutOfBoundsUnits()
     }
 }
 
+u64 Layers::getLocationModificationEpoch() const
+{
+    return locationModificationEpoch;
+}
+
 size_t Layers::numLocations() const
 {
     return mrgn->numLocations();
@@ -2623,6 +2824,7 @@ size_t Layers::numLocations() const
 
 std::shared_ptr<Chk::Location> Layers::getLocation(size_t locationId)
 {
+    locationModificationEpoch++;
     return mrgn->getLocation(locationId);
 }
 
@@ -2633,22 +2835,26 @@ const std::shared_ptr<Chk::Location> Layers::getLocation(size_t locationId) cons
 
 size_t Layers::addLocation(std::shared_ptr<Chk::Location> location)
 {
+    locationModificationEpoch++;
     return mrgn->addLocation(location);
 }
 
 void Layers::replaceLocation(size_t locationId, std::shared_ptr<Chk::Location> location)
 {
+    locationModificationEpoch++;
     mrgn->replaceLocation(locationId, location);
 }
 
 void Layers::deleteLocation(size_t locationId, bool deleteOnlyIfUnused)
 {
+    locationModificationEpoch++;
     if ( !deleteOnlyIfUnused || !triggers->locationUsed(locationId) )
         mrgn->deleteLocation(locationId);
 }
 
 bool Layers::moveLocation(size_t locationIdFrom, size_t locationIdTo, bool lockAnywhere)
 {
+    locationModificationEpoch++;
     return mrgn->moveLocation(locationIdFrom, locationIdTo, lockAnywhere);
 }
 
@@ -2659,6 +2865,7 @@ bool Layers::isBlank(size_t locationId) const
 
 void Layers::downsizeOutOfBoundsLocations()
 {
+    locationModificationEpoch++;
     size_t pixelWidth = dim->getPixelWidth();
     size_t pixelHeight = dim->getPixelHeight();
     size_t numLocations = mrgn->numLocations();
@@ -2687,11 +2894,24 @@ bool Layers::locationsFitOriginal(bool lockAnywhere, bool autoDefragment)
 
 bool Layers::trimLocationsToOriginal(bool lockAnywhere, bool autoDefragment)
 {
+    locationModificationEpoch++;
     return mrgn->trimToOriginal(*triggers, lockAnywhere, autoDefragment);
 }
 
+size_t Layers::planTrimLocationsToOriginal(Chk::LocationIdRemappings & locationIdRemappings, bool lockAnywhere) const
+{
+    return mrgn->planTrimToOriginal(*triggers, locationIdRemappings, lockAnywhere);
+}
+
+void Layers::trimLocationsToOriginal(const Chk::LocationIdRemappings & locationIdRemappings)
+{
+    locationModificationEpoch++;
+    mrgn->trimToOriginal(*triggers, locationIdRemappings);
+}
+
 void Layers::expandToScHybridOrExpansion()
 {
+    locationModificationEpoch++;
     mrgn->expandToScHybridOrExpansion();
 }
 
@@ -2703,6 +2923,7 @@ bool Layers::anywhereIsStandardDimensions() const
 
 void Layers::matchAnywhereToDimensions()
 {
+    locationModificationEpoch++;
     std::shared_ptr<Chk::Location> anywhere = mrgn->getLocation(Chk::LocationId::Anywhere);
     if ( anywhere != nullptr )
     {
@@ -2742,18 +2963,21 @@ void Layers::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 us
         mrgn->markUsedStrings(stringIdUsed);
 }
 
-void Layers::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void Layers::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
+    locationModificationEpoch++;
     mrgn->remapStringIds(stringIdRemappings);
 }
 
 void Layers::deleteString(size_t stringId)
 {
+    locationModificationEpoch++;
     mrgn->deleteString(stringId);
 }
 
 void Layers::set(std::unordered_map<SectionName, Section> & sections)
 {
+    locationModificationEpoch++;
     Terrain::set(sections);
     mask = GetSection<MaskSection>(sections, SectionName::MASK);
     thg2 = GetSection<Thg2Section>(sections, SectionName::THG2);
@@ -2775,6 +2999,7 @@ void Layers::set(std::unordered_map<SectionName, Section> & sections)
 
 void Layers::clear()
 {
+    locationModificationEpoch++;
     Terrain::clear();
     mask = nullptr;
     thg2 = nullptr;
@@ -3772,7 +3997,7 @@ void Properties::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u3
         unix->markUsedStrings(stringIdUsed);
 }
 
-void Properties::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void Properties::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     unis->remapStringIds(stringIdRemappings);
     unix->remapStringIds(stringIdRemappings);
@@ -3844,7 +4069,30 @@ void Properties::clear()
 }
 
 
-Triggers::Triggers(bool useDefault) : LocationSynchronizer(), strings(nullptr), layers(nullptr)
+Triggers::Batch::Batch(Triggers & triggers) : triggers(&triggers)
+{
+    triggers.beginBatch();
+}
+
+Triggers::Batch::~Batch()
+{
+    try {
+        commit();
+    } catch ( std::exception ) {} // Destructors must not throw, the batch is closed before fixing extensions so it's never committed twice
+}
+
+void Triggers::Batch::commit()
+{
+    if ( triggers != nullptr )
+    {
+        Triggers* committing = triggers;
+        triggers = nullptr;
+        committing->commitBatch();
+    }
+}
+
+Triggers::Triggers(bool useDefault) : LocationSynchronizer(), strings(nullptr), layers(nullptr), batchDepth(0), extensionsNeedFixing(false), modificationEpoch(0), referencesEpoch(0), referencesVerifiedEpoch(0),
+    cuwpReferences(), locationReferences(), columnsEpoch(0), columns(nullptr)
 {
     if ( useDefault )
     {
@@ -3876,6 +4124,29 @@ bool Triggers::empty() const
     return uprp == nullptr && upus == nullptr && trig == nullptr && mbrf == nullptr && swnm == nullptr && wav == nullptr && ktrg == nullptr && ktgp == nullptr;
 }
 
+void Triggers::beginBatch()
+{
+    batchDepth++;
+}
+
+void Triggers::commitBatch()
+{
+    if ( batchDepth == 0 )
+        throw std::logic_error("A trigger batch was committed without being begun!");
+
+    batchDepth--;
+    if ( batchDepth == 0 && extensionsNeedFixing )
+    {
+        extensionsNeedFixing = false;
+        fixTriggerExtensions();
+    }
+}
+
+bool Triggers::inBatch() const
+{
+    return batchDepth > 0;
+}
+
 Chk::Cuwp Triggers::getCuwp(size_t cuwpIndex) const
 {
     return uprp->getCuwp(cuwpIndex);
@@ -3906,20 +4177,21 @@ size_t Triggers::addCuwp(const Chk::Cuwp & cuwp, bool fixUsageBeforeAdding, size
 
 void Triggers::fixCuwpUsage(size_t excludedTriggerIndex, size_t excludedTriggerActionIndex)
 {
-    for ( size_t i=0; i<Sc::Unit::MaxCuwps; i++ )
-        upus->setCuwpUsed(i, false);
-
-    size_t numTriggers = trig->numTriggers();
-    for ( size_t triggerIndex=0; triggerIndex<numTriggers; triggerIndex++ )
+    updateReferences();
+    size_t excludedCuwpIndex = Sc::Unit::MaxCuwps;
+    if ( excludedTriggerIndex < trig->numTriggers() && excludedTriggerActionIndex < Chk::Trigger::MaxActions )
     {
-        Chk::TriggerPtr trigger = trig->getTrigger(triggerIndex);
-        for ( size_t actionIndex=0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
+        const Chk::Trigger* excludedTrigger = trig->readTrigger(excludedTriggerIndex);
+        if ( excludedTrigger != nullptr )
         {
-            Chk::Action & action = trigger->action(actionIndex);
-            if ( action.actionType == Chk::Action::Type::CreateUnitWithProperties && action.number < Sc::Unit::MaxCuwps && !(triggerIndex == excludedTriggerIndex && actionIndex == excludedTriggerActionIndex) )
-                upus->setCuwpUsed(action.number, true);
+            const Chk::Action & excludedAction = excludedTrigger->action(excludedTriggerActionIndex);
+            if ( excludedAction.actionType == Chk::Action::Type::CreateUnitWithProperties )
+                excludedCuwpIndex = excludedAction.number;
         }
     }
+
+    for ( size_t i=0; i<Sc::Unit::MaxCuwps; i++ )
+        upus->setCuwpUsed(i, cuwpReferences[i] > (i == excludedCuwpIndex ? 1 : 0));
 }
 
 bool Triggers::cuwpUsed(size_t cuwpIndex) const
@@ -3932,53 +4204,247 @@ void Triggers::setCuwpUsed(size_t cuwpIndex, bool cuwpUsed)
     upus->setCuwpUsed(cuwpIndex, cuwpUsed);
 }
 
+size_t Triggers::getCuwpReferences(size_t cuwpIndex) const
+{
+    updateReferences();
+    if ( cuwpIndex < Sc::Unit::MaxCuwps )
+        return cuwpReferences[cuwpIndex];
+    else
+        throw std::out_of_range(std::string("CuwpIndex: ") + std::to_string(cuwpIndex) + " is out of range for the CUWP reference counts!");
+}
+
+size_t Triggers::getLocationReferences(size_t locationId) const
+{
+    updateReferences();
+    if ( locationId <= Chk::TotalLocations )
+        return locationReferences[locationId];
+    else
+        throw std::out_of_range(std::string("LocationId: ") + std::to_string(locationId) + " is out of range for the location reference counts!");
+}
+
+void Triggers::recountReferences() const
+{
+    cuwpReferences.fill(0);
+    locationReferences.fill(0);
+    if ( trig != nullptr )
+    {
+        auto triggerColumns = getColumns(); // The same build serves the string scans that follow a change
+        const std::vector<u8> & conditionTypes = triggerColumns->getConditionTypes();
+        const std::vector<u32> & conditionLocations = triggerColumns->getConditionLocations();
+        for ( size_t i=0; i<conditionTypes.size(); i++ )
+        {
+            if ( conditionTypes[i] < Chk::Condition::NumConditionTypes && Chk::Condition::conditionUsesLocationArg[conditionTypes[i]] &&
+                conditionLocations[i] <= Chk::TotalLocations )
+            {
+                locationReferences[conditionLocations[i]]++;
+            }
+        }
+
+        const std::vector<u8> & actionTypes = triggerColumns->getActionTypes();
+        const std::vector<u32> & actionLocations = triggerColumns->getActionLocations();
+        const std::vector<u32> & actionNumbers = triggerColumns->getActionNumbers();
+        for ( size_t i=0; i<actionTypes.size(); i++ )
+        {
+            if ( actionTypes[i] < Chk::Action::NumActionTypes )
+            {
+                if ( Chk::Action::actionUsesLocationArg[actionTypes[i]] && actionLocations[i] <= Chk::TotalLocations )
+                    locationReferences[actionLocations[i]]++;
+
+                if ( Chk::Action::actionUsesSecondaryLocationArg[actionTypes[i]] && actionNumbers[i] <= Chk::TotalLocations )
+                    locationReferences[actionNumbers[i]]++;
+
+                if ( actionTypes[i] == Chk::Action::Type::CreateUnitWithProperties && actionNumbers[i] < Sc::Unit::MaxCuwps )
+                    cuwpReferences[actionNumbers[i]]++;
+            }
+        }
+    }
+    referencesEpoch = modificationEpoch;
+}
+
+bool Triggers::cuwpReferencesMatchScan() const
+{
+    updateReferences();
+    return cuwpCountsMatchScan();
+}
+
+bool Triggers::locationReferencesMatchScan() const
+{
+    updateReferences();
+    return locationCountsMatchScan();
+}
+
+bool Triggers::cuwpCountsMatchScan() const
+{
+    std::array<size_t, Sc::Unit::MaxCuwps> scannedReferences = {};
+    if ( trig != nullptr )
+    {
+        size_t numTriggers = trig->numTriggers();
+        for ( size_t triggerIndex=0; triggerIndex<numTriggers; triggerIndex++ )
+        {
+            const Chk::Trigger* trigger = trig->readTrigger(triggerIndex);
+            if ( trigger != nullptr )
+            {
+                for ( size_t actionIndex=0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
+                {
+                    const Chk::Action & action = trigger->action(actionIndex);
+                    if ( action.actionType == Chk::Action::Type::CreateUnitWithProperties && action.number < Sc::Unit::MaxCuwps )
+                        scannedReferences[action.number]++;
+                }
+            }
+        }
+    }
+    return scannedReferences == cuwpReferences;
+}
+
+bool Triggers::locationCountsMatchScan() const
+{
+    std::bitset<Chk::TotalLocations+1> locationIdUsed;
+    if ( trig != nullptr )
+    {
+        trig->markUsedLocations(locationIdUsed); // Doesn't mark NoLocation
+        locationIdUsed[Chk::LocationId::NoLocation] = trig->locationUsed(Chk::LocationId::NoLocation);
+    }
+    for ( size_t locationId=0; locationId<=Chk::TotalLocations; locationId++ )
+    {
+        if ( (locationReferences[locationId] > 0) != locationIdUsed[locationId] )
+            return false;
+    }
+    return true;
+}
+
+u64 Triggers::getModificationEpoch() const
+{
+    return modificationEpoch;
+}
+
 size_t Triggers::numTriggers() const
 {
     return trig->numTriggers();
 }
 
-std::shared_ptr<Chk::Trigger> Triggers::getTrigger(size_t triggerIndex)
+const std::shared_ptr<Chk::Trigger> Triggers::getTrigger(size_t triggerIndex) const
 {
     return trig->getTrigger(triggerIndex);
 }
 
-const std::shared_ptr<Chk::Trigger> Triggers::getTrigger(size_t triggerIndex) const
+const Chk::Trigger* Triggers::readTrigger(size_t triggerIndex) const
 {
-    return trig->getTrigger(triggerIndex);
+    return trig->readTrigger(triggerIndex);
 }
 
 size_t Triggers::addTrigger(std::shared_ptr<Chk::Trigger> trigger)
 {
-    return trig->addTrigger(trigger);
+    size_t triggerIndex = trig->addTrigger(trigger);
+    addReferences(trigger.get());
+    markModified();
+    return triggerIndex;
 }
 
 void Triggers::insertTrigger(size_t triggerIndex, std::shared_ptr<Chk::Trigger> trigger)
 {
-    trig->insertTrigger(triggerIndex, trigger);
-    fixTriggerExtensions();
+    if ( triggerIndex <= trig->numTriggers() )
+    {
+        trig->insertTrigger(triggerIndex, trigger);
+        addReferences(trigger.get());
+        markModified();
+        triggersChanged();
+    }
 }
 
 void Triggers::deleteTrigger(size_t triggerIndex)
 {
-    trig->deleteTrigger(triggerIndex);
-    fixTriggerExtensions();
+    if ( triggerIndex < trig->numTriggers() )
+    {
+        removeReferences(trig->readTrigger(triggerIndex));
+        trig->deleteTrigger(triggerIndex);
+        markModified();
+        triggersChanged();
+    }
 }
 
 void Triggers::moveTrigger(size_t triggerIndexFrom, size_t triggerIndexTo)
 {
     trig->moveTrigger(triggerIndexFrom, triggerIndexTo);
-    fixTriggerExtensions();
+    markModified();
+    triggersChanged();
 }
 
 std::deque<Chk::TriggerPtr> Triggers::replaceRange(size_t beginIndex, size_t endIndex, std::deque<Chk::TriggerPtr> & triggers)
 {
-    return trig->replaceRange(beginIndex, endIndex, triggers);
-    fixTriggerExtensions();
+    size_t numInsertedTriggers = triggers.size();
+    std::deque<Chk::TriggerPtr> replacedTriggers = trig->replaceRange(beginIndex, endIndex, triggers);
+    for ( const auto & replacedTrigger : replacedTriggers )
+        removeReferences(replacedTrigger.get());
+
+    for ( size_t triggerIndex=beginIndex; triggerIndex<beginIndex+numInsertedTriggers; triggerIndex++ )
+        addReferences(trig->readTrigger(triggerIndex));
+
+    markModified();
+    triggersChanged();
+    return replacedTriggers;
+}
+
+void Triggers::setTrigger(size_t triggerIndex, const Chk::Trigger & trigger)
+{
+    Chk::TriggerPtr existingTrigger = triggerIndex < trig->numTriggers() ? trig->getTrigger(triggerIndex) : nullptr;
+    if ( existingTrigger != nullptr )
+    {
+        removeReferences(existingTrigger.get());
+        *existingTrigger = trigger;
+        addReferences(existingTrigger.get());
+        markModified();
+    }
+}
+
+void Triggers::setAction(size_t triggerIndex, size_t actionIndex, const Chk::Action & action)
+{
+    Chk::TriggerPtr trigger = triggerIndex < trig->numTriggers() ? trig->getTrigger(triggerIndex) : nullptr;
+    if ( trigger != nullptr && actionIndex < Chk::Trigger::MaxActions )
+    {
+        removeReferences(trigger->action(actionIndex));
+        trigger->action(actionIndex) = action;
+        addReferences(action);
+        markModified();
+    }
+}
+
+void Triggers::deleteAction(size_t triggerIndex, size_t actionIndex, bool alignTop)
+{
+    Chk::TriggerPtr trigger = triggerIndex < trig->numTriggers() ? trig->getTrigger(triggerIndex) : nullptr;
+    if ( trigger != nullptr && actionIndex < Chk::Trigger::MaxActions )
+    {
+        removeReferences(trigger->action(actionIndex));
+        trigger->deleteAction(actionIndex, alignTop);
+        markModified();
+    }
+}
+
+void Triggers::setCondition(size_t triggerIndex, size_t conditionIndex, const Chk::Condition & condition)
+{
+    Chk::TriggerPtr trigger = triggerIndex < trig->numTriggers() ? trig->getTrigger(triggerIndex) : nullptr;
+    if ( trigger != nullptr && conditionIndex < Chk::Trigger::MaxConditions )
+    {
+        removeReferences(trigger->condition(conditionIndex));
+        trigger->condition(conditionIndex) = condition;
+        addReferences(condition);
+        markModified();
+    }
+}
+
+void Triggers::deleteCondition(size_t triggerIndex, size_t conditionIndex, bool alignTop)
+{
+    Chk::TriggerPtr trigger = triggerIndex < trig->numTriggers() ? trig->getTrigger(triggerIndex) : nullptr;
+    if ( trigger != nullptr && conditionIndex < Chk::Trigger::MaxConditions )
+    {
+        removeReferences(trigger->condition(conditionIndex));
+        trigger->deleteCondition(conditionIndex, alignTop);
+        markModified();
+    }
 }
 
 Chk::ExtendedTrigDataPtr Triggers::getTriggerExtension(size_t triggerIndex, bool addIfNotFound)
 {
-    auto trigger = trig->getTrigger(triggerIndex);
+    const Chk::Trigger* trigger = trig->readTrigger(triggerIndex);
     if ( trigger != nullptr )
     {
         size_t extendedTrigDataIndex = trigger->getExtendedDataIndex();
@@ -3991,7 +4457,7 @@ Chk::ExtendedTrigDataPtr Triggers::getTriggerExtension(size_t triggerIndex, bool
             size_t newExtendedTrigDataIndex = ktrg->addExtendedTrigger(newExtendedTrigData);
             if ( newExtendedTrigDataIndex != 0 )
             {
-                trigger->setExtendedDataIndex(newExtendedTrigDataIndex);
+                trig->getTrigger(triggerIndex)->setExtendedDataIndex(newExtendedTrigDataIndex);
                 return newExtendedTrigData;
             }
         }
@@ -4001,7 +4467,7 @@ Chk::ExtendedTrigDataPtr Triggers::getTriggerExtension(size_t triggerIndex, bool
 
 const Chk::ExtendedTrigDataPtr Triggers::getTriggerExtension(size_t triggerIndex) const
 {
-    auto trigger = trig->getTrigger(triggerIndex);
+    const Chk::Trigger* trigger = trig->readTrigger(triggerIndex);
     if ( trigger != nullptr )
     {
         size_t extendedTrigDataIndex = trigger->getExtendedDataIndex();
@@ -4014,13 +4480,13 @@ const Chk::ExtendedTrigDataPtr Triggers::getTriggerExtension(size_t triggerIndex
 
 void Triggers::deleteTriggerExtension(size_t triggerIndex)
 {
-    auto trigger = trig->getTrigger(triggerIndex);
+    const Chk::Trigger* trigger = trig->readTrigger(triggerIndex);
     if ( trigger != nullptr )
     {
         size_t extendedTrigDataIndex = trigger->getExtendedDataIndex();
         if ( extendedTrigDataIndex != 0 )
         {
-            trigger->clearExtendedDataIndex();
+            trig->getTrigger(triggerIndex)->clearExtendedDataIndex();
             ktrg->deleteExtendedTrigger(extendedTrigDataIndex);
         }
     }
@@ -4028,11 +4494,11 @@ void Triggers::deleteTriggerExtension(size_t triggerIndex)
 
 void Triggers::fixTriggerExtensions()
 {
-    std::set<size_t> usedExtendedTrigDataIndexes;
+    std::vector<bool> usedExtendedTrigDataIndexes(ktrg->numExtendedTriggers(), false);
     size_t numTriggers = trig->numTriggers();
     for ( size_t i=0; i<numTriggers; i++ )
     {
-        Chk::TriggerPtr trigger = trig->getTrigger(i);
+        const Chk::Trigger* trigger = trig->readTrigger(i); // Only triggers that need fixing are gotten
         if ( trigger != nullptr )
         {
             size_t extendedDataIndex = trigger->getExtendedDataIndex();
@@ -4040,14 +4506,14 @@ void Triggers::fixTriggerExtensions()
             {
                 Chk::ExtendedTrigDataPtr extension = ktrg->getExtendedTrigger(extendedDataIndex);
                 if ( extension == nullptr ) // Invalid extendedDataIndex
-                    trigger->clearExtendedDataIndex();
-                else if ( usedExtendedTrigDataIndexes.find(extendedDataIndex) == usedExtendedTrigDataIndexes.end() ) // Valid extension
+                    trig->getTrigger(i)->clearExtendedDataIndex();
+                else if ( !usedExtendedTrigDataIndexes[extendedDataIndex] ) // Valid extension
                 {
                     extension->trigNum = (u32)i; // Ensure the trigNum is correct
-                    usedExtendedTrigDataIndexes.insert(extendedDataIndex);
+                    usedExtendedTrigDataIndexes[extendedDataIndex] = true;
                 }
                 else // Same extension used by multiple triggers
-                    trigger->clearExtendedDataIndex();
+                    trig->getTrigger(i)->clearExtendedDataIndex();
             }
         }
     }
@@ -4056,7 +4522,7 @@ void Triggers::fixTriggerExtensions()
     for ( size_t i=0; i<numTriggerExtensions; i++ )
     {
         Chk::ExtendedTrigDataPtr extension = ktrg->getExtendedTrigger(i);
-        if ( extension != nullptr && usedExtendedTrigDataIndexes.find(i) == usedExtendedTrigDataIndexes.end() ) // Extension exists, but no trigger uses it
+        if ( extension != nullptr && !usedExtendedTrigDataIndexes[i] ) // Extension exists, but no trigger uses it
         {
             if ( extension->trigNum != Chk::ExtendedTrigData::TrigNum::None ) // Refers to a trigger
             {
@@ -4072,9 +4538,111 @@ void Triggers::fixTriggerExtensions()
     }
 }
 
+void Triggers::markModified()
+{
+    bool referencesCurrent = referencesEpoch == modificationEpoch;
+    modificationEpoch++;
+    if ( referencesCurrent )
+        referencesEpoch = modificationEpoch;
+}
+
+void Triggers::updateReferences() const
+{
+    if ( referencesEpoch != modificationEpoch )
+        recountReferences();
+#ifdef _DEBUG
+    else if ( referencesVerifiedEpoch != modificationEpoch ) // Counts kept through changes are checked once per change, a trigger changed around Triggers shows up here
+    {
+        assert(cuwpCountsMatchScan());
+        assert(locationCountsMatchScan());
+    }
+    referencesVerifiedEpoch = modificationEpoch;
+#endif
+}
+
+void Triggers::triggersChanged()
+{
+    if ( batchDepth > 0 )
+        extensionsNeedFixing = true;
+    else
+        fixTriggerExtensions();
+}
+
+void Triggers::addReferences(const Chk::Condition & condition) const
+{
+    if ( condition.conditionType < Chk::Condition::NumConditionTypes && Chk::Condition::conditionUsesLocationArg[condition.conditionType] &&
+        condition.locationId <= Chk::TotalLocations )
+    {
+        locationReferences[condition.locationId]++;
+    }
+}
+
+void Triggers::removeReferences(const Chk::Condition & condition) const
+{
+    if ( condition.conditionType < Chk::Condition::NumConditionTypes && Chk::Condition::conditionUsesLocationArg[condition.conditionType] &&
+        condition.locationId <= Chk::TotalLocations && locationReferences[condition.locationId] > 0 )
+    {
+        locationReferences[condition.locationId]--;
+    }
+}
+
+void Triggers::addReferences(const Chk::Action & action) const
+{
+    if ( action.actionType < Chk::Action::NumActionTypes )
+    {
+        if ( Chk::Action::actionUsesLocationArg[action.actionType] && action.locationId <= Chk::TotalLocations )
+            locationReferences[action.locationId]++;
+
+        if ( Chk::Action::actionUsesSecondaryLocationArg[action.actionType] && action.number <= Chk::TotalLocations )
+            locationReferences[action.number]++;
+
+        if ( action.actionType == Chk::Action::Type::CreateUnitWithProperties && action.number < Sc::Unit::MaxCuwps )
+            cuwpReferences[action.number]++;
+    }
+}
+
+void Triggers::removeReferences(const Chk::Action & action) const
+{
+    if ( action.actionType < Chk::Action::NumActionTypes )
+    {
+        if ( Chk::Action::actionUsesLocationArg[action.actionType] && action.locationId <= Chk::TotalLocations && locationReferences[action.locationId] > 0 )
+            locationReferences[action.locationId]--;
+
+        if ( Chk::Action::actionUsesSecondaryLocationArg[action.actionType] && action.number <= Chk::TotalLocations && locationReferences[action.number] > 0 )
+            locationReferences[action.number]--;
+
+        if ( action.actionType == Chk::Action::Type::CreateUnitWithProperties && action.number < Sc::Unit::MaxCuwps && cuwpReferences[action.number] > 0 )
+            cuwpReferences[action.number]--;
+    }
+}
+
+void Triggers::addReferences(const Chk::Trigger* trigger) const
+{
+    if ( trigger != nullptr )
+    {
+        for ( size_t conditionIndex=0; conditionIndex < Chk::Trigger::MaxConditions; conditionIndex++ )
+            addReferences(trigger->conditions[conditionIndex]);
+
+        for ( size_t actionIndex=0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
+            addReferences(trigger->actions[actionIndex]);
+    }
+}
+
+void Triggers::removeReferences(const Chk::Trigger* trigger) const
+{
+    if ( trigger != nullptr )
+    {
+        for ( size_t conditionIndex=0; conditionIndex < Chk::Trigger::MaxConditions; conditionIndex++ )
+            removeReferences(trigger->conditions[conditionIndex]);
+
+        for ( size_t actionIndex=0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
+            removeReferences(trigger->actions[actionIndex]);
+    }
+}
+
 size_t Triggers::getCommentStringId(size_t triggerIndex) const
 {
-    auto trigger = trig->getTrigger(triggerIndex);
+    const Chk::Trigger* trigger = trig->readTrigger(triggerIndex);
     if ( trigger != nullptr )
         return trigger->getComment();
     else
@@ -4137,6 +4705,11 @@ const std::shared_ptr<Chk::Trigger> Triggers::getBriefingTrigger(size_t briefing
     return mbrf->getBriefingTrigger(briefingTriggerIndex);
 }
 
+const Chk::Trigger* Triggers::readBriefingTrigger(size_t briefingTriggerIndex) const
+{
+    return mbrf->readBriefingTrigger(briefingTriggerIndex);
+}
+
 size_t Triggers::addBriefingTrigger(std::shared_ptr<Chk::Trigger> briefingTrigger)
 {
     return mbrf->addBriefingTrigger(briefingTrigger);
@@ -4165,10 +4738,12 @@ size_t Triggers::getSwitchNameStringId(size_t switchIndex) const
 void Triggers::setSwitchNameStringId(size_t switchIndex, size_t stringId)
 {
     swnm->setSwitchNameStringId(switchIndex, stringId);
+    markModified();
 }
 
 size_t Triggers::addSound(size_t stringId)
 {
+    markModified();
     return wav->addSound(stringId);
 }
 
@@ -4185,11 +4760,26 @@ size_t Triggers::getSoundStringId(size_t soundIndex) const
 void Triggers::setSoundStringId(size_t soundIndex, size_t soundStringId)
 {
     wav->setSoundStringId(soundIndex, soundStringId);
+    markModified();
+}
+
+std::shared_ptr<const TriggerColumns> Triggers::getColumns() const
+{
+    if ( columns == nullptr || columnsEpoch != modificationEpoch )
+    {
+        columns = std::make_shared<TriggerColumns>(*trig);
+        columnsEpoch = modificationEpoch;
+    }
+    return columns;
 }
 
 bool Triggers::locationUsed(size_t locationId) const
 {
-    return trig->locationUsed(locationId);
+    updateReferences();
+    if ( locationId <= Chk::TotalLocations )
+        return locationReferences[locationId] > 0;
+    else
+        return trig->locationUsed(locationId);
 }
 
 void Triggers::appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, Chk::Scope storageScope, u32 userMask) const
@@ -4243,7 +4833,12 @@ bool Triggers::editorStringUsed(size_t stringId, Chk::Scope storageScope, u32 us
 
 void Triggers::markUsedLocations(std::bitset<Chk::TotalLocations+1> & locationIdUsed) const
 {
-    trig->markUsedLocations(locationIdUsed);
+    updateReferences();
+    for ( size_t locationId=1; locationId<=Chk::TotalLocations; locationId++ )
+    {
+        if ( locationReferences[locationId] > 0 )
+            locationIdUsed[locationId] = true;
+    }
 }
 
 void Triggers::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, Chk::Scope storageScope, u32 userMask) const
@@ -4257,7 +4852,7 @@ void Triggers::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, Chk:
             swnm->markUsedStrings(stringIdUsed);
 
         if ( (userMask & Chk::StringUserFlag::AnyTrigger) > 0 )
-            trig->markUsedStrings(stringIdUsed, userMask);
+            getColumns()->markUsedStrings(stringIdUsed, userMask);
 
         if ( (userMask & Chk::StringUserFlag::AnyBriefingTrigger) > 0 )
             mbrf->markUsedStrings(stringIdUsed, userMask);
@@ -4269,7 +4864,7 @@ void Triggers::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, Chk:
 void Triggers::markUsedGameStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask) const
 {
     if ( (userMask & Chk::StringUserFlag::AnyTrigger) > 0 )
-        trig->markUsedGameStrings(stringIdUsed);
+        getColumns()->markUsedGameStrings(stringIdUsed);
 
     if ( (userMask & Chk::StringUserFlag::AnyBriefingTrigger) > 0 )
         mbrf->markUsedStrings(stringIdUsed);
@@ -4286,18 +4881,29 @@ void Triggers::markUsedEditorStrings(std::bitset<Chk::MaxStrings> & stringIdUsed
             swnm->markUsedStrings(stringIdUsed);
 
         if ( (userMask & Chk::StringUserFlag::TriggerAction) == Chk::StringUserFlag::TriggerAction )
-            trig->markUsedCommentStrings(stringIdUsed);
+            getColumns()->markUsedCommentStrings(stringIdUsed);
     }
     else if ( storageScope == Chk::Scope::Editor && (userMask & Chk::StringUserFlag::AnyTriggerExtension) > 0 )
         ktrg->markUsedEditorStrings(stringIdUsed, userMask);
 }
 
-void Triggers::remapLocationIds(const std::map<u32, u32> & locationIdRemappings)
+void Triggers::remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings)
 {
+    updateReferences();
     trig->remapLocationIds(locationIdRemappings);
+
+    std::array<size_t, Chk::TotalLocations+1> remappedReferences = {};
+    for ( size_t locationId=0; locationId<=Chk::TotalLocations; locationId++ )
+    {
+        size_t remappedLocationId = locationIdRemappings[locationId];
+        if ( remappedLocationId <= Chk::TotalLocations )
+            remappedReferences[remappedLocationId] += locationReferences[locationId];
+    }
+    locationReferences = remappedReferences;
+    markModified();
 }
 
-void Triggers::remapStringIds(const std::map<u32, u32> & stringIdRemappings, Chk::Scope storageScope)
+void Triggers::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings, Chk::Scope storageScope)
 {
     if ( storageScope == Chk::Scope::Game )
     {
@@ -4308,11 +4914,20 @@ void Triggers::remapStringIds(const std::map<u32, u32> & stringIdRemappings, Chk
     }
     else if ( storageScope == Chk::Scope::Editor )
         ktrg->remapEditorStringIds(stringIdRemappings);
+
+    markModified();
 }
 
 void Triggers::deleteLocation(size_t locationId)
 {
+    updateReferences();
     trig->deleteLocation(locationId);
+    if ( locationId != Chk::LocationId::NoLocation && locationId <= Chk::TotalLocations )
+    {
+        locationReferences[Chk::LocationId::NoLocation] += locationReferences[locationId];
+        locationReferences[locationId] = 0;
+    }
+    markModified();
 }
 
 void Triggers::deleteString(size_t stringId, Chk::Scope storageScope)
@@ -4326,6 +4941,8 @@ void Triggers::deleteString(size_t stringId, Chk::Scope storageScope)
     }
     else if ( storageScope == Chk::Scope::Editor )
         ktrg->deleteEditorString(stringId);
+
+    markModified();
 }
 
 void Triggers::set(std::unordered_map<SectionName, Section> & sections)
@@ -4356,6 +4973,9 @@ void Triggers::set(std::unordered_map<SectionName, Section> & sections)
         ktrg = KtrgSection::GetDefault();
     if ( ktgp == nullptr )
         ktgp = KtgpSection::GetDefault();
+
+    modificationEpoch++;
+    recountReferences();
 }
 
 void Triggers::clear()
@@ -4370,4 +4990,8 @@ void Triggers::clear()
     
     ktrg = nullptr;
     ktgp = nullptr;
+
+    cuwpReferences.fill(0);
+    locationReferences.fill(0);
+    markModified();
 }
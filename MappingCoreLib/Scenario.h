@@ -3,6 +3,7 @@
 #include "Basics.h"
 #include "EscapeStrings.h"
 #include "Sections.h"
+#include "TriggerColumns.h"
 #include <memory>
 #include <string>
 #include <array>
@@ -52,6 +53,8 @@ class Versions
         Layers* layers; // For updating location capacity as necessary
         friend class Scenario;
 
+        void applyChangeTo(Chk::Version version, const Chk::LocationIdRemappings & locationIdRemappings); // Changes to a version the locations in use were already found to fit
+
         void set(std::unordered_map<SectionName, Section> & sections);
         void clear();
 };
@@ -81,6 +84,8 @@ class Strings : public StrSynchronizer
             Rescope
         });
 
+        u64 getModificationEpoch() const; // Changes whenever strings are added, replaced, deleted or moved, or a string id is set through Strings
+
         size_t getCapacity(Chk::Scope storageScope = Chk::Scope::Game) const;
         size_t getBytesUsed(Chk::Scope storageScope = Chk::Scope::Game);
 
@@ -104,11 +109,19 @@ class Strings : public StrSynchronizer
         template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
         size_t addString(const StringType & str, Chk::Scope storageScope = Chk::Scope::Game, bool autoDefragment = true);
 
+        template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
+        std::vector<size_t> addStrings(const std::vector<StringType> & strs, Chk::Scope storageScope = Chk::Scope::Game, bool autoDefragment = true,
+            const std::vector<size_t> & reservedStringIds = {}); // Gets the ids addString would give were each string put to use before the next is added, reserved ids are treated as used
+
         template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
         void replaceString(size_t stringId, const StringType & str, Chk::Scope storageScope = Chk::Scope::Game);
 
+        template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
+        void replaceStrings(const std::vector<std::pair<size_t, StringType>> & replacements, Chk::Scope storageScope = Chk::Scope::Game); // Same as replaceString for each (stringId, str) in order
+
         void deleteUnusedStrings(Chk::Scope storageScope = Chk::Scope::Both);
         void deleteString(size_t stringId, Chk::Scope storageScope = Chk::Scope::Both, bool deleteOnlyIfUnused = true);
+        void deleteStrings(const std::vector<size_t> & stringIds, Chk::Scope storageScope = Chk::Scope::Both, bool deleteOnlyIfUnused = true); // Same as deleteString for each stringId, checking usage once
         void moveString(size_t stringIdFrom, size_t stringIdTo, Chk::Scope storageScope = Chk::Scope::Game);
         size_t rescopeString(size_t stringId, Chk::Scope changeStorageScopeTo = Chk::Scope::Editor, bool autoDefragment = true);
 
@@ -180,11 +193,11 @@ class Strings : public StrSynchronizer
         // If no configuration among requestedCompressionFlags is viable, additional methods through allowedCompressionFlags are added as neccessary
         // allowedCompressionFlags may be increased as neccessary if elevator.elevate() returns true
         
-        virtual void syncStringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8> & stringBytes,
+        virtual void syncStringsToBytes(const ScStrArena & arena, const std::vector<u32> & strings, std::vector<u8> & stringBytes,
             StrCompressionElevatorPtr compressionElevator = StrCompressionElevator::NeverElevate(),
             u32 requestedCompressionFlags = StrCompressFlag::Unchanged, u32 allowedCompressionFlags = StrCompressFlag::Unchanged);
 
-        virtual void syncKstringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8> & stringBytes,
+        virtual void syncKstringsToBytes(const ScStrArena & arena, const std::vector<u32> & strings, const std::vector<StrProp> & stringProperties, std::vector<u8> & stringBytes,
             StrCompressionElevatorPtr compressionElevator = StrCompressionElevator::NeverElevate(),
             u32 requestedCompressionFlags = StrCompressFlag::Unchanged, u32 allowedCompressionFlags = StrCompressFlag::Unchanged);
 
@@ -192,7 +205,7 @@ class Strings : public StrSynchronizer
         void restore(StringBackup & backup); // A backup instance can only be restored once
 
     protected:
-        virtual void remapStringIds(const std::map<u32, u32> & stringIdRemappings, Chk::Scope storageScope);
+        virtual void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings, Chk::Scope storageScope); // Remaps every section referencing strings in storageScope with the one table, visiting each section once
 
     private:
         Versions* versions; // For auto-determining the section for regular or expansion units
@@ -200,6 +213,7 @@ class Strings : public StrSynchronizer
         Layers* layers; // For finding location string usage
         Properties* properties; // For finding unit name string usage
         Triggers* triggers; // For finding trigger and briefing string usage
+        u64 modificationEpoch; // Incremented by every change made through Strings
         friend class Scenario;
 
         static const std::vector<u32> compressionFlagsProgression;
@@ -239,7 +253,7 @@ class Players
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask = Chk::StringUserFlag::All) const;
         bool stringUsed(size_t stringId, u32 userMask = Chk::StringUserFlag::All) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::All) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 
     private:
@@ -356,8 +370,10 @@ class Layers : public Terrain
         void updateOutOfBoundsUnits();
         void removeOutOfBoundsUnits();
         
+        u64 getLocationModificationEpoch() const; // Changes whenever locations change, or a location that can be changed in place is handed out
+
         size_t numLocations() const;
-        std::shared_ptr<Chk::Location> getLocation(size_t locationId);
+        std::shared_ptr<Chk::Location> getLocation(size_t locationId); // Assumes the location will be changed in place, prefer the const overload for reading
         const std::shared_ptr<Chk::Location> getLocation(size_t locationId) const;
         size_t addLocation(std::shared_ptr<Chk::Location> location);
         void replaceLocation(size_t locationId, std::shared_ptr<Chk::Location> location);
@@ -368,6 +384,8 @@ class Layers : public Terrain
 
         bool locationsFitOriginal(bool lockAnywhere = true, bool autoDefragment = true); // Checks if all locations fit in indexes < Chk::TotalOriginalLocations
         bool trimLocationsToOriginal(bool lockAnywhere = true, bool autoDefragment = true); // If possible, trims locations to indexes < Chk::TotalOriginalLocations
+        size_t planTrimLocationsToOriginal(Chk::LocationIdRemappings & locationIdRemappings, bool lockAnywhere = true) const; // Gets the number of locations used or created and, if they fit, the moves trimming them would make
+        void trimLocationsToOriginal(const Chk::LocationIdRemappings & locationIdRemappings); // Trims locations to indexes < Chk::TotalOriginalLocations, making the moves from planTrimLocationsToOriginal
         void expandToScHybridOrExpansion();
         
         bool anywhereIsStandardDimensions() const;
@@ -376,12 +394,13 @@ class Layers : public Terrain
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask = Chk::StringUserFlag::All) const;
         bool stringUsed(size_t stringId, Chk::Scope storageScope = Chk::Scope::Game, u32 userMask = Chk::StringUserFlag::All) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::All) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 
     private:
         Strings* strings; // For reading and updating location names
         Triggers* triggers; // For reading and updating locationIds
+        u64 locationModificationEpoch; // Incremented by every change to the locations, and each time a location is handed out that may be changed in place
         friend class Scenario;
         
         void set(std::unordered_map<SectionName, Section> & sections);
@@ -497,7 +516,7 @@ class Properties
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask = Chk::StringUserFlag::All) const;
         bool stringUsed(size_t stringId, u32 userMask = Chk::StringUserFlag::All) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::All) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 
     private:
@@ -521,26 +540,70 @@ class Triggers : public LocationSynchronizer
         KtrgSectionPtr ktrg; // Extended trigger data
         KtgpSectionPtr ktgp; // Extended trigger groupings
 
+        /**
+            A batch defers fixing trigger extensions (KTRG) after inserting, deleting, moving or replacing triggers until the batch is
+            committed, extensions are fixed once at commit rather than after every change; while a batch is open the trigNum of
+            extensions may be out of date, batches can be nested and only committing the outermost batch fixes extensions
+        */
+        class Batch
+        {
+            public:
+                Batch(Triggers & triggers); // Begins a batch
+                ~Batch(); // Commits the batch if it wasn't already committed, never throws; call commit to see failures
+                void commit();
+
+            private:
+                Triggers* triggers;
+
+                Batch(const Batch &) = delete;
+                Batch & operator=(const Batch &) = delete;
+        };
+
         Triggers(bool useDefault = false);
 
         bool empty() const;
 
+        void beginBatch();
+        void commitBatch(); // Must be paired with a prior beginBatch
+        bool inBatch() const;
+
         Chk::Cuwp getCuwp(size_t cuwpIndex) const;
         void setCuwp(size_t cuwpIndex, const Chk::Cuwp & cuwp);
         size_t addCuwp(const Chk::Cuwp & cuwp, bool fixUsageBeforeAdding = true, size_t excludedTriggerIndex = Chk::MaximumTriggers, size_t excludedTriggerActionIndex = Chk::Trigger::MaxActions);
         
-        void fixCuwpUsage(size_t excludedTriggerIndex = Chk::MaximumTriggers, size_t excludedTriggerActionIndex = Chk::Trigger::MaxActions);
+        void fixCuwpUsage(size_t excludedTriggerIndex = Chk::MaximumTriggers, size_t excludedTriggerActionIndex = Chk::Trigger::MaxActions); // Sets usage from the CUWP reference counts
         bool cuwpUsed(size_t cuwpIndex) const;
         void setCuwpUsed(size_t cuwpIndex, bool cuwpUsed);
-
+        size_t getCuwpReferences(size_t cuwpIndex) const; // Gets the number of create unit with properties actions using cuwpIndex
+        size_t getLocationReferences(size_t locationId) const; // Gets the number of trigger condition and action arguments using locationId
+        void recountReferences() const; // Rescans every trigger, done automatically before reference counts are used if the triggers were replaced wholesale
+        bool cuwpReferencesMatchScan() const; // Compares the CUWP reference counts, recounted first if stale, with a full rescan of every trigger action
+        bool locationReferencesMatchScan() const; // Compares the location reference counts, recounted first if stale, with a full rescan of every trigger
+
+        u64 getModificationEpoch() const; // Changes whenever triggers, switches or sounds change
+
+        /**
+            Triggers must only be changed through the members of Triggers (setTrigger, setCondition, setAction, replaceRange and
+            so on) which keep the reference counts, columns and modification epoch current; a trigger from getTrigger is for
+            reading, and a trigger passed to addTrigger, insertTrigger or replaceRange belongs to Triggers and mustn't be changed
+            through any pointer kept to it; debug builds compare the reference counts with a full rescan after each change
+
+            Triggers read from a map stay raw records in the section until gotten (see TriggerRecords), getTrigger gives a trigger
+            its own allocation so it mustn't be called while other threads read triggers; scans and threads use readTrigger
+        */
         size_t numTriggers() const;
-        std::shared_ptr<Chk::Trigger> getTrigger(size_t triggerIndex);
         const std::shared_ptr<Chk::Trigger> getTrigger(size_t triggerIndex) const;
+        const Chk::Trigger* readTrigger(size_t triggerIndex) const; // Gets the trigger for reading without copying it, valid until triggers change or one is gotten
         size_t addTrigger(std::shared_ptr<Chk::Trigger> trigger);
         void insertTrigger(size_t triggerIndex, std::shared_ptr<Chk::Trigger> trigger);
         void deleteTrigger(size_t triggerIndex);
         void moveTrigger(size_t triggerIndexFrom, size_t triggerIndexTo);
         std::deque<Chk::TriggerPtr> replaceRange(size_t beginIndex, size_t endIndex, std::deque<Chk::TriggerPtr> & triggers);
+        void setTrigger(size_t triggerIndex, const Chk::Trigger & trigger); // Overwrites the trigger at triggerIndex, prefer setCondition or setAction to change one condition or action
+        void setCondition(size_t triggerIndex, size_t conditionIndex, const Chk::Condition & condition);
+        void deleteCondition(size_t triggerIndex, size_t conditionIndex, bool alignTop = true);
+        void setAction(size_t triggerIndex, size_t actionIndex, const Chk::Action & action);
+        void deleteAction(size_t triggerIndex, size_t actionIndex, bool alignTop = true);
         
         Chk::ExtendedTrigDataPtr getTriggerExtension(size_t triggerIndex, bool addIfNotFound = false);
         const Chk::ExtendedTrigDataPtr getTriggerExtension(size_t triggerIndex) const;
@@ -556,6 +619,7 @@ class Triggers : public LocationSynchronizer
         size_t numBriefingTriggers() const;
         std::shared_ptr<Chk::Trigger> getBriefingTrigger(size_t briefingTriggerIndex);
         const std::shared_ptr<Chk::Trigger> getBriefingTrigger(size_t briefingTriggerIndex) const;
+        const Chk::Trigger* readBriefingTrigger(size_t briefingTriggerIndex) const; // Gets the trigger for reading without copying it, valid until briefing triggers change or one is gotten
         size_t addBriefingTrigger(std::shared_ptr<Chk::Trigger> briefingTrigger);
         void insertBriefingTrigger(size_t briefingTriggerIndex, std::shared_ptr<Chk::Trigger> briefingTrigger);
         void deleteBriefingTrigger(size_t briefingTriggerIndex);
@@ -569,6 +633,8 @@ class Triggers : public LocationSynchronizer
         size_t getSoundStringId(size_t soundIndex) const;
         void setSoundStringId(size_t soundIndex, size_t soundStringId);
 
+        std::shared_ptr<const TriggerColumns> getColumns() const; // Gets columns of the triggers, rebuilt only if a trigger may have changed since they were last built
+
         bool locationUsed(size_t locationId) const;
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, Chk::Scope storageScope = Chk::Scope::Game, u32 userMask = Chk::StringUserFlag::All) const;
         bool stringUsed(size_t stringId, Chk::Scope storageScope, u32 userMask = Chk::StringUserFlag::All) const;
@@ -578,16 +644,36 @@ class Triggers : public LocationSynchronizer
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, Chk::Scope storageScope, u32 userMask = Chk::StringUserFlag::All) const;
         void markUsedGameStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::All) const;
         void markUsedEditorStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, Chk::Scope storageScope, u32 userMask = Chk::StringUserFlag::All) const;
-        void remapLocationIds(const std::map<u32, u32> & locationIdRemappings);
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings, Chk::Scope storageScope);
+        void remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings, Chk::Scope storageScope);
         void deleteLocation(size_t locationId);
         void deleteString(size_t stringId, Chk::Scope storageScope);
 
     private:
         Strings* strings; // For reading and updating sound paths, next scenario paths, text messages, leader board text, comments, and switch names
         Layers* layers; // For reading locations
+        size_t batchDepth; // The number of batches begun and not yet committed
+        bool extensionsNeedFixing; // Whether triggers changed during the current batch
+        u64 modificationEpoch; // Incremented by every change to the triggers
+        mutable u64 referencesEpoch; // The modificationEpoch at which cuwpReferences and locationReferences were last known to be correct
+        mutable u64 referencesVerifiedEpoch; // The modificationEpoch at which the reference counts were last compared with a rescan (debug builds only)
+        mutable std::array<size_t, Sc::Unit::MaxCuwps> cuwpReferences; // The number of create unit with properties actions using each CUWP
+        mutable std::array<size_t, Chk::TotalLocations+1> locationReferences; // The number of trigger condition and action arguments using each location
+        mutable u64 columnsEpoch; // The modificationEpoch at which columns were last built
+        mutable std::shared_ptr<TriggerColumns> columns; // Columns of the triggers for scans, built when first needed after a change
         friend class Scenario;
         
+        void triggersChanged(); // Fixes trigger extensions, or defers fixing them until the current batch is committed
+        void markModified(); // Advances the modification epoch, reference counts stay current if they were current, callers update them first
+        void updateReferences() const; // Recounts references if they weren't kept current through the last change, in debug builds checks them against a rescan
+        bool cuwpCountsMatchScan() const; // Compares the CUWP reference counts as they are with a full rescan
+        bool locationCountsMatchScan() const; // Compares the location reference counts as they are with a full rescan
+        void addReferences(const Chk::Condition & condition) const;
+        void removeReferences(const Chk::Condition & condition) const;
+        void addReferences(const Chk::Action & action) const;
+        void removeReferences(const Chk::Action & action) const;
+        void addReferences(const Chk::Trigger* trigger) const;
+        void removeReferences(const Chk::Trigger* trigger) const;
         void set(std::unordered_map<SectionName, Section> & sections);
         void clear();
 };
@@ -614,6 +700,8 @@ class Scenario : ScenarioSaver
         virtual ~Scenario();
 
         bool empty() const;
+
+        u64 getModificationEpoch() const; // Changes whenever the strings, locations or triggers change, as tracked by Strings, Layers and Triggers
         
         bool isProtected() const; // Checks if map is protected
         bool hasPassword() const; // Checks if the map has a password
@@ -628,7 +716,18 @@ class Scenario : ScenarioSaver
                                          includes a 4 byte "CHK " tag followed by a 4-byte size, followed by data */
         bool deserialize(Chk::SerializedChk* data); // "Opens" a serialized Scenario.chk file, data must be 8+ bytes
         
+        struct VersionChange // A change between Original, Hybrid and Expansion, planned out before anything is changed
+        {
+            Chk::Version version;
+            bool possible; // False if the locations in use do not fit in the new version
+            size_t numLocationsUsed; // Locations used or created, including anywhere if locked
+            Chk::LocationIdRemappings locationIdRemappings; // Moves fitting the locations in use to original, made when changing to original
+            std::vector<size_t> unusedGameStringIds; // Stored game strings no longer in use, deleted by the change
+            std::vector<size_t> unusedEditorStringIds; // Stored editor strings no longer in use, deleted by the change
+        };
+
         void updateSaveSections();
+        VersionChange planVersionChange(Chk::Version version, bool lockAnywhere = true, bool autoDefragmentLocations = true) const; // Reports what changeVersionTo would do without changing the scenario
         bool changeVersionTo(Chk::Version version, bool lockAnywhere = true, bool autoDefragmentLocations = true);
         virtual void setTileset(Sc::Terrain::Tileset tileset);
 
@@ -643,7 +742,13 @@ class Scenario : ScenarioSaver
         bool parsingFailed(const std::string & error);
         void clear();
 
+        std::vector<Section> getSectionsInUse() const; // The instance in use of each section the scenario has, in SectionIndex order
+        void replaceSections(std::unordered_map<SectionName, Section> & replacements); // Puts each replacement in use in place of the section with the same name
+
     private:
+        friend class ScenarioView;
+        friend class ScenarioPatch;
+
         std::vector<Section> allSections; // Holds all the sections of a map
         std::array<u8, 7> tailData; // The 0-7 bytes just before the Scenario file ends, after the last valid section
         u8 tailLength; // 0 for no tail data, must be less than 8
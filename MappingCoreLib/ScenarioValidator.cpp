@@ -0,0 +1,451 @@
+#include "ScenarioValidator.h"
+#include <algorithm>
+#include <bitset>
+#include <functional>
+
+constexpr size_t TriggersPerTask = 1024; // Triggers checked by each task
+constexpr size_t EntriesPerTask = 16384; // Units or sprites checked by each task
+constexpr size_t TileRowsPerTask = 64; // Rows of tiles compared with ISOM by each task
+
+using Issue = ScenarioValidator::Issue;
+using ValidationTask = std::function<void(std::vector<Issue> & issues)>;
+
+struct ValidationReferences // What references in the scenario may refer to, gathered once before the tasks run
+{
+    std::bitset<Chk::TotalLocations+1> locationExists;
+    std::bitset<Sc::Unit::MaxCuwps> cuwpExists;
+    bool conditionUsesUnitArg[Chk::Condition::NumConditionTypes];
+    bool actionUsesUnitArg[Chk::Action::NumActionTypes];
+    bool actionUsesCuwpArg[Chk::Action::NumActionTypes];
+
+    ValidationReferences(const Scenario & scenario)
+    {
+        if ( scenario.layers.mrgn != nullptr )
+        {
+            size_t numLocations = std::min(scenario.layers.numLocations(), Chk::TotalLocations);
+            for ( size_t locationId=1; locationId<=numLocations; locationId++ )
+                locationExists[locationId] = !scenario.layers.isBlank(locationId);
+        }
+        if ( scenario.triggers.upus != nullptr )
+        {
+            for ( size_t cuwpIndex=0; cuwpIndex<Sc::Unit::MaxCuwps; cuwpIndex++ )
+                cuwpExists[cuwpIndex] = scenario.triggers.cuwpUsed(cuwpIndex);
+        }
+        for ( size_t conditionType=0; conditionType<Chk::Condition::NumConditionTypes; conditionType++ )
+        {
+            conditionUsesUnitArg[conditionType] = false;
+            for ( size_t argIndex=0; argIndex<Chk::Condition::MaxArguments; argIndex++ )
+                conditionUsesUnitArg[conditionType] |= Chk::Condition::getClassicArgType(Chk::Condition::Type(conditionType), argIndex) == Chk::Condition::ArgType::Unit;
+        }
+        for ( size_t actionType=0; actionType<Chk::Action::NumActionTypes; actionType++ )
+        {
+            actionUsesUnitArg[actionType] = false;
+            actionUsesCuwpArg[actionType] = false;
+            for ( size_t argIndex=0; argIndex<Chk::Action::MaxArguments; argIndex++ )
+            {
+                Chk::Action::ArgType argType = Chk::Action::getClassicArgType(Chk::Action::Type(actionType), argIndex);
+                actionUsesUnitArg[actionType] |= argType == Chk::Action::ArgType::Unit;
+                actionUsesCuwpArg[actionType] |= argType == Chk::Action::ArgType::CUWP;
+            }
+        }
+    }
+};
+
+void addValidationIssue(std::vector<Issue> & issues, Issue::Type type, SectionName sectionName, size_t index, size_t value,
+    Issue::Within within = Issue::Within::Entry, size_t subIndex = 0)
+{
+    Issue issue = { type, sectionName, index, within, subIndex, value };
+    issues.push_back(issue);
+}
+
+void addValidationRangeTasks(std::vector<ValidationTask> & tasks, size_t count, size_t perTask, const std::function<void(size_t, size_t, std::vector<Issue> &)> & check)
+{
+    for ( size_t begin=0; begin<count; begin+=perTask )
+    {
+        size_t end = std::min(begin+perTask, count);
+        tasks.push_back([begin, end, check](std::vector<Issue> & issues) { check(begin, end, issues); });
+    }
+}
+
+void validateTerrain(const Scenario & scenario, std::vector<Issue> & issues)
+{
+    const Layers & layers = scenario.layers;
+    if ( layers.dim == nullptr )
+        return;
+
+    size_t tileWidth = layers.getTileWidth();
+    size_t tileHeight = layers.getTileHeight();
+    if ( tileWidth == 0 || tileWidth > ScenarioValidator::MaxTileDimension )
+        addValidationIssue(issues, Issue::Type::BadDimensions, SectionName::DIM, 0, tileWidth);
+    if ( tileHeight == 0 || tileHeight > ScenarioValidator::MaxTileDimension )
+        addValidationIssue(issues, Issue::Type::BadDimensions, SectionName::DIM, 1, tileHeight);
+
+    size_t numTiles = tileWidth*tileHeight;
+    size_t numMtxmTiles = layers.mtxm != nullptr ? layers.mtxm->numTiles() : 0;
+    size_t numTileTiles = layers.tile != nullptr ? layers.tile->numTiles() : 0;
+    if ( layers.mtxm != nullptr && numMtxmTiles < numTiles )
+        addValidationIssue(issues, Issue::Type::TerrainTooSmall, SectionName::MTXM, numMtxmTiles, numTiles);
+    if ( layers.tile != nullptr && numTileTiles < numTiles )
+        addValidationIssue(issues, Issue::Type::TerrainTooSmall, SectionName::TILE, numTileTiles, numTiles);
+    if ( layers.isom != nullptr )
+    {
+        size_t numIsomEntries = layers.isom->numIsomEntries();
+        size_t numIsomEntriesNeeded = (tileWidth/2 + 1)*(tileHeight + 1);
+        if ( numIsomEntries < numIsomEntriesNeeded )
+            addValidationIssue(issues, Issue::Type::TerrainTooSmall, SectionName::ISOM, numIsomEntries, numIsomEntriesNeeded);
+    }
+    if ( layers.mtxm != nullptr && layers.tile != nullptr )
+    {
+        size_t numComparableTiles = std::min(numTiles, std::min(numMtxmTiles, numTileTiles));
+        for ( size_t tileIndex=0; tileIndex<numComparableTiles; tileIndex++ )
+        {
+            u16 tile = layers.tile->getTile(tileIndex);
+            if ( tile != layers.mtxm->getTile(tileIndex) )
+                addValidationIssue(issues, Issue::Type::TileMismatch, SectionName::TILE, tileIndex, tile);
+        }
+    }
+}
+
+void validateIsomTiles(const Scenario & scenario, const ScenarioValidator::IsomTileGroups & isomTileGroups, size_t rowBegin, size_t rowEnd, std::vector<Issue> & issues)
+{
+    const Layers & layers = scenario.layers;
+    size_t tileWidth = layers.getTileWidth();
+    size_t numMtxmTiles = layers.mtxm->numTiles();
+    for ( size_t y=rowBegin; y<rowEnd; y++ )
+    {
+        for ( size_t x=0; x<tileWidth && y*tileWidth+x < numMtxmTiles; x++ )
+        {
+            u16 isomTileGroup = 0;
+            if ( isomTileGroups(scenario, x, y, isomTileGroup) && isomTileGroup != layers.mtxm->getTile(y*tileWidth+x)/16 )
+                addValidationIssue(issues, Issue::Type::IsomMismatch, SectionName::MTXM, x, isomTileGroup, Issue::Within::Tile, y);
+        }
+    }
+}
+
+void validateStringSections(const Scenario & scenario, std::vector<Issue> & issues)
+{
+    // Strings are written uncompressed: a count, an offset for each string, a NUL that blank strings point to, then each stored string
+    const Strings & strings = scenario.strings;
+    if ( strings.str != nullptr )
+    {
+        size_t numStrings = strings.str->getCapacity() > 0 ? strings.str->getCapacity()-1 : 0;
+        size_t sectionSize = sizeof(u16) + sizeof(u16)*numStrings + 1 + strings.str->getStoredCharacters();
+        if ( sectionSize > ScenarioValidator::MaxStrSectionSize )
+            addValidationIssue(issues, Issue::Type::StringSectionTooLarge, SectionName::STR, ScenarioValidator::MaxStrSectionSize, sectionSize);
+    }
+    if ( strings.kstr != nullptr )
+    {
+        size_t numStrings = strings.kstr->getCapacity() > 0 ? strings.kstr->getCapacity()-1 : 0;
+        size_t sectionSize = 2*sizeof(u32) + 2*sizeof(u32)*numStrings + 1 + strings.kstr->getStoredCharacters();
+        if ( sectionSize > ScenarioValidator::MaxKstrSectionSize )
+            addValidationIssue(issues, Issue::Type::StringSectionTooLarge, SectionName::KSTR, ScenarioValidator::MaxKstrSectionSize, sectionSize);
+    }
+}
+
+void validateSectionSizes(const Scenario & scenario, std::vector<Issue> & issues)
+{
+    struct { SectionName sectionName; bool inUse; size_t entrySize; size_t numEntries; } sections[] = {
+        { SectionName::UNIT, scenario.layers.unit != nullptr, sizeof(Chk::Unit), scenario.layers.unit != nullptr ? scenario.layers.numUnits() : 0 },
+        { SectionName::DD2, scenario.layers.dd2 != nullptr, sizeof(Chk::Doodad), scenario.layers.dd2 != nullptr ? scenario.layers.numDoodads() : 0 },
+        { SectionName::THG2, scenario.layers.thg2 != nullptr, sizeof(Chk::Sprite), scenario.layers.thg2 != nullptr ? scenario.layers.numSprites() : 0 },
+        { SectionName::TRIG, scenario.triggers.trig != nullptr, sizeof(Chk::Trigger), scenario.triggers.trig != nullptr ? scenario.triggers.numTriggers() : 0 },
+        { SectionName::MBRF, scenario.triggers.mbrf != nullptr, sizeof(Chk::Trigger), scenario.triggers.mbrf != nullptr ? scenario.triggers.numBriefingTriggers() : 0 }
+    };
+    for ( const auto & section : sections )
+    {
+        size_t sectionSize = section.entrySize*section.numEntries;
+        if ( section.inUse && sectionSize > size_t(ChkSection::MaxChkSectionSize) )
+            addValidationIssue(issues, Issue::Type::SectionTooLarge, section.sectionName, 0, sectionSize);
+    }
+    validateStringSections(scenario, issues);
+}
+
+void validateUnits(const Scenario & scenario, size_t unitIndexBegin, size_t unitIndexEnd, std::vector<Issue> & issues)
+{
+    size_t pixelWidth = scenario.layers.getPixelWidth();
+    size_t pixelHeight = scenario.layers.getPixelHeight();
+    for ( size_t unitIndex=unitIndexBegin; unitIndex<unitIndexEnd; unitIndex++ )
+    {
+        const std::shared_ptr<Chk::Unit> unit = scenario.layers.getUnit(unitIndex);
+        if ( unit == nullptr )
+            continue;
+
+        if ( size_t(unit->type) >= Sc::Unit::TotalTypes )
+            addValidationIssue(issues, Issue::Type::BadUnitType, SectionName::UNIT, unitIndex, size_t(unit->type));
+        if ( unit->xc >= pixelWidth || unit->yc >= pixelHeight )
+            addValidationIssue(issues, Issue::Type::UnitOutOfBounds, SectionName::UNIT, unitIndex, 0);
+    }
+}
+
+void validateSprites(const Scenario & scenario, size_t spriteIndexBegin, size_t spriteIndexEnd, std::vector<Issue> & issues)
+{
+    size_t pixelWidth = scenario.layers.getPixelWidth();
+    size_t pixelHeight = scenario.layers.getPixelHeight();
+    for ( size_t spriteIndex=spriteIndexBegin; spriteIndex<spriteIndexEnd; spriteIndex++ )
+    {
+        const std::shared_ptr<Chk::Sprite> sprite = scenario.layers.getSprite(spriteIndex);
+        if ( sprite == nullptr )
+            continue;
+
+        if ( size_t(sprite->type) >= Sc::Sprite::TotalSprites )
+            addValidationIssue(issues, Issue::Type::BadSpriteType, SectionName::THG2, spriteIndex, size_t(sprite->type));
+        if ( sprite->xc >= pixelWidth || sprite->yc >= pixelHeight )
+            addValidationIssue(issues, Issue::Type::SpriteOutOfBounds, SectionName::THG2, spriteIndex, 0);
+    }
+}
+
+void validateStringId(const Strings & strings, std::vector<Issue> & issues, SectionName sectionName, size_t index, size_t stringId, Chk::Scope storageScope)
+{
+    if ( stringId != Chk::StringId::NoString && !strings.stringStored(stringId, storageScope) )
+    {
+        addValidationIssue(issues, Issue::Type::MissingString, sectionName, index, stringId,
+            storageScope == Chk::Scope::Editor ? Issue::Within::EditorString : Issue::Within::Entry);
+    }
+}
+
+void validateStringUsers(const Scenario & scenario, std::vector<Issue> & issues) // Strings used outside of triggers
+{
+    const Strings & strings = scenario.strings;
+    if ( strings.str == nullptr )
+        return;
+
+    std::vector<Chk::Scope> storageScopes = { Chk::Scope::Game };
+    if ( strings.ostr != nullptr && strings.kstr != nullptr )
+        storageScopes.push_back(Chk::Scope::Editor);
+
+    for ( Chk::Scope storageScope : storageScopes )
+    {
+        if ( strings.sprp != nullptr || storageScope == Chk::Scope::Editor )
+        {
+            validateStringId(strings, issues, SectionName::SPRP, 0, strings.getScenarioNameStringId(storageScope), storageScope);
+            validateStringId(strings, issues, SectionName::SPRP, 1, strings.getScenarioDescriptionStringId(storageScope), storageScope);
+        }
+        if ( scenario.players.forc != nullptr || storageScope == Chk::Scope::Editor )
+        {
+            for ( size_t force=0; force<Chk::TotalForces; force++ )
+                validateStringId(strings, issues, SectionName::FORC, force, strings.getForceNameStringId(Chk::Force(force), storageScope), storageScope);
+        }
+        if ( scenario.triggers.wav != nullptr || storageScope == Chk::Scope::Editor )
+        {
+            for ( size_t soundIndex=0; soundIndex<Chk::TotalSounds; soundIndex++ )
+                validateStringId(strings, issues, SectionName::WAV, soundIndex, strings.getSoundPathStringId(soundIndex, storageScope), storageScope);
+        }
+        if ( scenario.triggers.swnm != nullptr || storageScope == Chk::Scope::Editor )
+        {
+            for ( size_t switchIndex=0; switchIndex<Chk::TotalSwitches; switchIndex++ )
+                validateStringId(strings, issues, SectionName::SWNM, switchIndex, strings.getSwitchNameStringId(switchIndex, storageScope), storageScope);
+        }
+        if ( scenario.layers.mrgn != nullptr )
+        {
+            size_t numLocations = scenario.layers.numLocations();
+            for ( size_t locationId=1; locationId<=numLocations; locationId++ )
+                validateStringId(strings, issues, SectionName::MRGN, locationId, strings.getLocationNameStringId(locationId, storageScope), storageScope);
+        }
+    }
+}
+
+void validateTriggers(const Scenario & scenario, const ValidationReferences & references, size_t trigIndexBegin, size_t trigIndexEnd, std::vector<Issue> & issues)
+{
+    const Strings & strings = scenario.strings;
+    for ( size_t trigIndex=trigIndexBegin; trigIndex<trigIndexEnd; trigIndex++ )
+    {
+        const Chk::Trigger* trigger = scenario.triggers.readTrigger(trigIndex); // Read in place, other workers are reading too
+        if ( trigger == nullptr )
+            continue;
+
+        for ( size_t conditionIndex=0; conditionIndex<Chk::Trigger::MaxConditions; conditionIndex++ )
+        {
+            const Chk::Condition & condition = trigger->conditions[conditionIndex];
+            if ( condition.conditionType == Chk::Condition::Type::NoCondition || condition.conditionType >= Chk::Condition::NumConditionTypes )
+                continue;
+
+            if ( Chk::Condition::conditionUsesLocationArg[condition.conditionType] && condition.locationId != Chk::LocationId::NoLocation &&
+                (condition.locationId > Chk::TotalLocations || !references.locationExists[condition.locationId]) )
+            {
+                addValidationIssue(issues, Issue::Type::MissingLocation, SectionName::TRIG, trigIndex, condition.locationId, Issue::Within::Condition, conditionIndex);
+            }
+            if ( references.conditionUsesUnitArg[condition.conditionType] && size_t(condition.unitType) >= Sc::Unit::TotalReferenceTypes )
+                addValidationIssue(issues, Issue::Type::BadUnitType, SectionName::TRIG, trigIndex, size_t(condition.unitType), Issue::Within::Condition, conditionIndex);
+        }
+
+        for ( size_t actionIndex=0; actionIndex<Chk::Trigger::MaxActions; actionIndex++ )
+        {
+            const Chk::Action & action = trigger->actions[actionIndex];
+            if ( action.actionType == Chk::Action::Type::NoAction || action.actionType >= Chk::Action::NumActionTypes )
+                continue;
+
+            if ( Chk::Action::actionUsesLocationArg[action.actionType] && action.locationId != Chk::LocationId::NoLocation &&
+                (action.locationId > Chk::TotalLocations || !references.locationExists[action.locationId]) )
+            {
+                addValidationIssue(issues, Issue::Type::MissingLocation, SectionName::TRIG, trigIndex, action.locationId, Issue::Within::Action, actionIndex);
+            }
+            if ( Chk::Action::actionUsesSecondaryLocationArg[action.actionType] && action.number != Chk::LocationId::NoLocation &&
+                (action.number > Chk::TotalLocations || !references.locationExists[action.number]) )
+            {
+                addValidationIssue(issues, Issue::Type::MissingLocation, SectionName::TRIG, trigIndex, action.number, Issue::Within::Action, actionIndex);
+            }
+            if ( Chk::Action::actionUsesStringArg[action.actionType] && action.stringId != Chk::StringId::NoString &&
+                !strings.stringStored(action.stringId, Chk::Action::actionUsesGameStringArg[action.actionType] ? Chk::Scope::Game : Chk::Scope::Either) )
+            {
+                addValidationIssue(issues, Issue::Type::MissingString, SectionName::TRIG, trigIndex, action.stringId, Issue::Within::Action, actionIndex);
+            }
+            if ( Chk::Action::actionUsesSoundArg[action.actionType] && action.soundStringId != Chk::StringId::UnusedSound &&
+                !strings.stringStored(action.soundStringId, Chk::Scope::Game) )
+            {
+                addValidationIssue(issues, Issue::Type::MissingSound, SectionName::TRIG, trigIndex, action.soundStringId, Issue::Within::Action, actionIndex);
+            }
+            if ( references.actionUsesUnitArg[action.actionType] && size_t(action.type) >= Sc::Unit::TotalReferenceTypes )
+                addValidationIssue(issues, Issue::Type::BadUnitType, SectionName::TRIG, trigIndex, size_t(action.type), Issue::Within::Action, actionIndex);
+            if ( references.actionUsesCuwpArg[action.actionType] && (action.number >= Sc::Unit::MaxCuwps || !references.cuwpExists[action.number]) )
+                addValidationIssue(issues, Issue::Type::BadCuwp, SectionName::TRIG, trigIndex, action.number, Issue::Within::Action, actionIndex);
+        }
+    }
+}
+
+void validateBriefingTriggers(const Scenario & scenario, size_t briefingTrigIndexBegin, size_t briefingTrigIndexEnd, std::vector<Issue> & issues)
+{
+    const Strings & strings = scenario.strings;
+    for ( size_t briefingTrigIndex=briefingTrigIndexBegin; briefingTrigIndex<briefingTrigIndexEnd; briefingTrigIndex++ )
+    {
+        const Chk::Trigger* briefingTrigger = scenario.triggers.readBriefingTrigger(briefingTrigIndex); // Read in place, other workers are reading too
+        if ( briefingTrigger == nullptr )
+            continue;
+
+        for ( size_t actionIndex=0; actionIndex<Chk::Trigger::MaxActions; actionIndex++ )
+        {
+            const Chk::Action & action = briefingTrigger->actions[actionIndex];
+            if ( action.actionType >= Chk::Action::NumBriefingActionTypes )
+                continue;
+
+            if ( Chk::Action::briefingActionUsesStringArg[action.actionType] && action.stringId != Chk::StringId::NoString &&
+                !strings.stringStored(action.stringId, Chk::Scope::Game) )
+            {
+                addValidationIssue(issues, Issue::Type::MissingString, SectionName::MBRF, briefingTrigIndex, action.stringId, Issue::Within::Action, actionIndex);
+            }
+            if ( Chk::Action::briefingActionUsesSoundArg[action.actionType] && action.soundStringId != Chk::StringId::UnusedSound &&
+                !strings.stringStored(action.soundStringId, Chk::Scope::Game) )
+            {
+                addValidationIssue(issues, Issue::Type::MissingSound, SectionName::MBRF, briefingTrigIndex, action.soundStringId, Issue::Within::Action, actionIndex);
+            }
+        }
+    }
+}
+
+std::string ScenarioValidator::Issue::toString() const
+{
+    std::string section = ChkSection::getNameString(sectionName) + ": ";
+    std::string valueString = std::to_string(value);
+    switch ( type )
+    {
+        case Type::BadDimensions: return section + (index == 0 ? "width " : "height ") + valueString + " is not between 1 and " + std::to_string(MaxTileDimension);
+        case Type::TerrainTooSmall: return section + "has " + std::to_string(index) + " entries where the dimensions need " + valueString;
+        case Type::SectionTooLarge: return section + "is " + valueString + " bytes, over the max section size of " + std::to_string(ChkSection::MaxChkSectionSize);
+        case Type::StringSectionTooLarge: return section + "would be written as " + valueString + " bytes, over the " + std::to_string(index) + " its offsets can address";
+        default: break;
+    }
+
+    std::string place = section;
+    switch ( sectionName )
+    {
+        case SectionName::UNIT: place += "unit " + std::to_string(index); break;
+        case SectionName::THG2: place += "sprite " + std::to_string(index); break;
+        case SectionName::TILE: place += "tile " + std::to_string(index); break;
+        case SectionName::MTXM: place += "tile (" + std::to_string(index) + ", " + std::to_string(subIndex) + ")"; break;
+        case SectionName::TRIG: place += "trigger " + std::to_string(index); break;
+        case SectionName::MBRF: place += "briefing trigger " + std::to_string(index); break;
+        case SectionName::SPRP: place += index == 0 ? "scenario name" : "scenario description"; break;
+        case SectionName::FORC: place += "force " + std::to_string(index+1) + " name"; break;
+        case SectionName::WAV: place += "sound " + std::to_string(index); break;
+        case SectionName::SWNM: place += "switch " + std::to_string(index+1) + " name"; break;
+        case SectionName::MRGN: place += "location " + std::to_string(index) + " name"; break;
+        default: place += "entry " + std::to_string(index); break;
+    }
+    switch ( within )
+    {
+        case Within::Condition: place += " condition " + std::to_string(subIndex); break;
+        case Within::Action: place += " action " + std::to_string(subIndex); break;
+        case Within::EditorString: place += " editor string"; break;
+        case Within::Tile: break; // Included in the place
+        default: break;
+    }
+
+    switch ( type )
+    {
+        case Type::TileMismatch: return place + " is " + valueString + " which differs from the MTXM tile";
+        case Type::IsomMismatch: return place + " differs from tile group " + valueString + " which ISOM places there";
+        case Type::UnitOutOfBounds: return place + " is outside the map";
+        case Type::BadUnitType: return place + " has unit type " + valueString + " which doesn't exist";
+        case Type::SpriteOutOfBounds: return place + " is outside the map";
+        case Type::BadSpriteType: return place + " has sprite type " + valueString + " which doesn't exist";
+        case Type::MissingString: return place + " uses string " + valueString + " which isn't stored";
+        case Type::MissingSound: return place + " uses sound string " + valueString + " which isn't stored";
+        case Type::MissingLocation: return place + " uses location " + valueString + " which doesn't exist";
+        case Type::BadCuwp: return place + " uses CUWP " + valueString + " which doesn't exist";
+        default: return place + " has an unknown issue";
+    }
+}
+
+ScenarioValidator::ScenarioValidator(size_t numWorkers) : numWorkers(numWorkers), isomTileGroups(nullptr)
+{
+
+}
+
+ScenarioValidator::~ScenarioValidator()
+{
+
+}
+
+void ScenarioValidator::setIsomTileGroups(IsomTileGroups isomTileGroups)
+{
+    this->isomTileGroups = isomTileGroups;
+}
+
+std::vector<Issue> ScenarioValidator::validate(const Scenario & scenario) const
+{
+    ValidationReferences references(scenario);
+    std::vector<ValidationTask> tasks;
+    tasks.push_back([&](std::vector<Issue> & issues) { validateTerrain(scenario, issues); });
+    if ( isomTileGroups != nullptr && scenario.layers.dim != nullptr && scenario.layers.mtxm != nullptr && scenario.layers.isom != nullptr )
+    {
+        addValidationRangeTasks(tasks, scenario.layers.getTileHeight(), TileRowsPerTask, [&](size_t begin, size_t end, std::vector<Issue> & issues) {
+            validateIsomTiles(scenario, isomTileGroups, begin, end, issues);
+        });
+    }
+    tasks.push_back([&](std::vector<Issue> & issues) { validateSectionSizes(scenario, issues); });
+    tasks.push_back([&](std::vector<Issue> & issues) { validateStringUsers(scenario, issues); });
+    if ( scenario.layers.dim != nullptr && scenario.layers.unit != nullptr )
+    {
+        addValidationRangeTasks(tasks, scenario.layers.numUnits(), EntriesPerTask, [&](size_t begin, size_t end, std::vector<Issue> & issues) {
+            validateUnits(scenario, begin, end, issues);
+        });
+    }
+    if ( scenario.layers.dim != nullptr && scenario.layers.thg2 != nullptr )
+    {
+        addValidationRangeTasks(tasks, scenario.layers.numSprites(), EntriesPerTask, [&](size_t begin, size_t end, std::vector<Issue> & issues) {
+            validateSprites(scenario, begin, end, issues);
+        });
+    }
+    if ( scenario.triggers.trig != nullptr && scenario.strings.str != nullptr )
+    {
+        addValidationRangeTasks(tasks, scenario.triggers.numTriggers(), TriggersPerTask, [&](size_t begin, size_t end, std::vector<Issue> & issues) {
+            validateTriggers(scenario, references, begin, end, issues);
+        });
+    }
+    if ( scenario.triggers.mbrf != nullptr && scenario.strings.str != nullptr )
+    {
+        addValidationRangeTasks(tasks, scenario.triggers.numBriefingTriggers(), TriggersPerTask, [&](size_t begin, size_t end, std::vector<Issue> & issues) {
+            validateBriefingTriggers(scenario, begin, end, issues);
+        });
+    }
+
+    std::vector<std::vector<Issue>> taskIssues(tasks.size());
+    WorkerPool::run(tasks.size(), [&](size_t taskIndex) {
+        tasks[taskIndex](taskIssues[taskIndex]);
+    }, numWorkers);
+
+    std::vector<Issue> issues;
+    for ( const auto & found : taskIssues )
+        issues.insert(issues.end(), found.begin(), found.end());
+
+    return issues;
+}
@@ -0,0 +1,84 @@
+#ifndef SCENARIOVALIDATOR_H
+#define SCENARIOVALIDATOR_H
+#include "Basics.h"
+#include "Scenario.h"
+#include "WorkerPool.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+    The scenario validator checks a whole scenario for problems that would otherwise surface one at a time while saving or in-game:
+    dimensions, terrain sections too small for the dimensions, TILE tiles and ISOM-derived tiles differing from MTXM tiles, units and
+    sprites outside the map, unit and sprite types out of range, sections over the max section size, string sections past what their
+    offsets can address, and references to strings, sounds, locations, unit types and CUWPs that don't exist
+
+    Deriving tiles from ISOM needs the tileset's isometric terrain tables, which aren't part of the scenario; ISOM is only compared with
+    MTXM tile by tile if the tile groups ISOM places are supplied through setIsomTileGroups
+
+    Checks are split into tasks (triggers, units and sprites in ranges) that run across the available cores, each task lists its own
+    issues and the lists are merged in task order, so the issues found are the same and in the same order for any number of workers
+
+    The validator only reads the scenario, which must not be changed while it is being validated
+*/
+
+class ScenarioValidator
+{
+    public:
+        struct Issue
+        {
+            enum_t(Type, u32, {
+                BadDimensions, // index: 0 for width 1 for height, value: the tile width or height
+                TerrainTooSmall, // index: entries held by the MTXM, TILE or ISOM section, value: entries needed for the dimensions
+                TileMismatch, // index: tile index, value: the TILE tile, which differs from the MTXM tile
+                SectionTooLarge, // value: the size of the section in bytes
+                UnitOutOfBounds, // index: unit index
+                BadUnitType, // index: unit index or trigger index, value: the unit type
+                SpriteOutOfBounds, // index: sprite index
+                BadSpriteType, // index: sprite index, value: the sprite type
+                MissingString, // index: the index of the string user, value: a string id that isn't stored
+                MissingSound, // index: trigger index, value: a sound string id that isn't stored
+                MissingLocation, // index: trigger index, value: a location id past the last location or of a blank location
+                BadCuwp, // index: trigger index, value: a CUWP index past the last CUWP or of an unused CUWP
+                IsomMismatch, // index: tile x, subIndex: tile y, value: the tile group ISOM places there, which differs from the MTXM tile's group
+                StringSectionTooLarge // index: the most bytes the section's offsets can address, value: the size of the section as it would be written
+            });
+            enum_t(Within, u8, { // What subIndex is the index of
+                Entry = 0, // No subIndex, the issue is with the entry at index
+                Condition = 1, // The condition at subIndex in the trigger at index
+                Action = 2, // The action at subIndex in the trigger at index
+                EditorString = 3, // The editor string override (OSTR) of the string user at index
+                Tile = 4 // The tile in column index and row subIndex
+            });
+
+            Type type;
+            SectionName sectionName; // The section the issue is in
+            size_t index;
+            Within within;
+            size_t subIndex;
+            size_t value;
+
+            std::string toString() const; // Describes the issue, e.g. "TRIG: trigger 5 action 3 uses location 70 which doesn't exist"
+        };
+
+        static constexpr size_t MaxTileDimension = 256; // The largest width or height StarCraft can play
+        static constexpr size_t MaxStrSectionSize = u16_max; // STR offsets are u16s
+        static constexpr size_t MaxKstrSectionSize = size_t(ChkSection::MaxChkSectionSize); // KSTR offsets are u32s, limited by the section size
+
+        /** Gets the tile group that the scenario's ISOM data places at tile (tileX, tileY), or returns false if it doesn't determine one;
+            must be safe to call from several threads at once */
+        using IsomTileGroups = std::function<bool(const Scenario & scenario, size_t tileX, size_t tileY, output_param u16 & tileGroup)>;
+
+        ScenarioValidator(size_t numWorkers = WorkerPool::defaultNumWorkers()); // numWorkers limits the threads used to validate
+        virtual ~ScenarioValidator();
+
+        void setIsomTileGroups(IsomTileGroups isomTileGroups); // Compares the group of each MTXM tile with the group ISOM places there
+
+        std::vector<Issue> validate(const Scenario & scenario) const; // Gets every issue found in the scenario, an empty list if there are none
+
+    private:
+        size_t numWorkers;
+        IsomTileGroups isomTileGroups;
+};
+
+#endif
@@ -1,5 +1,8 @@
 #include "Sections.h"
 #include <unordered_map>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <set>
 #include <memory>
@@ -294,36 +297,193 @@ StrProp::StrProp(u8 red, u8 green, u8 blue, u32 size, bool isUsed, bool hasPrior
 
 }
 
-ScStr::ScStr(const std::string & str) : strProp()
+ScStrArena::ScStrArena() : blockAvailable(nullptr), blockRemaining(0), totalAllocated(0), interned(1, Interned { nullptr, 0 })
 {
-    for ( const char & c : str )
-        allocation.push_back(c);
 
-    if ( allocation.size() == 0 || allocation.back() != '\0' )
-        allocation.push_back('\0');
+}
+
+ScStrArena::~ScStrArena()
+{
 
-    this->str = &allocation[0];
 }
 
-ScStr::ScStr(const std::string & str, const StrProp & strProp) : strProp(strProp)
+u32 ScStrArena::intern(const char* str, size_t length)
 {
-    for ( const char & c : str )
-        allocation.push_back(c);
+    size_t hash = std::hash<std::string_view>()(std::string_view(str, length));
+    u32 strId = findEntry(str, length, hash);
+    if ( strId != NoStr )
+        return strId;
 
-    if ( allocation.size() == 0 || allocation.back() != '\0' )
-        allocation.push_back('\0');
+    char* internedStr = allocate(length+1);
+    std::memcpy(internedStr, str, length);
+    internedStr[length] = '\0';
+    return insert(internedStr, length, hash);
+}
 
-    this->str = &allocation[0];
+u32 ScStrArena::internInPlace(const char* str, size_t length)
+{
+    size_t hash = std::hash<std::string_view>()(std::string_view(str, length));
+    u32 strId = findEntry(str, length, hash);
+    return strId != NoStr ? strId : insert(str, length, hash);
+}
+
+u32 ScStrArena::find(const char* str, size_t length) const
+{
+    return findEntry(str, length, std::hash<std::string_view>()(std::string_view(str, length)));
+}
+
+const char* ScStrArena::copy(const void* data, size_t size)
+{
+    char* block = allocate(size+1);
+    if ( size > 0 )
+        std::memcpy(block, data, size);
+
+    block[size] = '\0';
+    return block;
+}
+
+void ScStrArena::reserve(size_t numStrings)
+{
+    size_t tableSize = table.size() == 0 ? 64 : table.size();
+    while ( tableSize < 2*numStrings )
+        tableSize *= 2;
+
+    if ( tableSize > table.size() )
+        rehash(tableSize);
+
+    interned.reserve(numStrings+1);
+}
+
+const char* ScStrArena::str(u32 strId) const
+{
+    return interned[strId].str;
+}
+
+size_t ScStrArena::length(u32 strId) const
+{
+    return interned[strId].length;
+}
+
+bool ScStrArena::isSubStringOf(u32 strId, u32 otherStrId, size_t & offset) const
+{
+    const Interned & str = interned[strId];
+    const Interned & other = interned[otherStrId];
+    if ( strId != NoStr && otherStrId != NoStr && str.length <= other.length )
+    {
+        std::uintptr_t start = std::uintptr_t(str.str), otherStart = std::uintptr_t(other.str);
+        if ( start >= otherStart && start + str.length == otherStart + other.length )
+        {
+            offset = size_t(start - otherStart);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ScStrArena::numInterned() const
+{
+    return interned.size()-1;
+}
+
+size_t ScStrArena::numBlocks() const
+{
+    return blocks.size();
+}
+
+size_t ScStrArena::bytesAllocated() const
+{
+    return totalAllocated;
+}
+
+char* ScStrArena::allocate(size_t size)
+{
+    if ( size > blockRemaining )
+    {
+        if ( size > BlockSize/4 ) // Large allocations get their own block so the rest of the current block isn't wasted
+        {
+            blocks.push_back(std::unique_ptr<char[]>(new char[size]));
+            totalAllocated += size;
+            return blocks.back().get();
+        }
+        blocks.push_back(std::unique_ptr<char[]>(new char[BlockSize]));
+        totalAllocated += BlockSize;
+        blockAvailable = blocks.back().get();
+        blockRemaining = BlockSize;
+    }
+    char* allocation = blockAvailable;
+    blockAvailable += size;
+    blockRemaining -= size;
+    return allocation;
+}
+
+u32 ScStrArena::findEntry(const char* str, size_t length, size_t hash) const
+{
+    if ( table.empty() )
+        return NoStr;
+
+    size_t mask = table.size()-1;
+    for ( size_t i = hash & mask; table[i].strId != NoStr; i = (i+1) & mask )
+    {
+        const Entry & entry = table[i];
+        const Interned & internedStr = interned[entry.strId];
+        if ( entry.hash == u32(hash) && internedStr.length == length && std::memcmp(internedStr.str, str, length) == 0 )
+            return entry.strId;
+    }
+    return NoStr;
+}
+
+u32 ScStrArena::insert(const char* str, size_t length, size_t hash)
+{
+    if ( 2*interned.size() > table.size() ) // Keep the table at most half full
+        rehash(table.size() == 0 ? 64 : 2*table.size());
+
+    size_t mask = table.size()-1;
+    size_t i = hash & mask;
+    while ( table[i].strId != NoStr )
+        i = (i+1) & mask;
+
+    u32 strId = u32(interned.size());
+    interned.push_back(Interned { str, length });
+    table[i] = Entry { strId, u32(hash) };
+    return strId;
+}
+
+void ScStrArena::rehash(size_t tableSize)
+{
+    std::vector<Entry> oldTable(tableSize, Entry { NoStr, 0 });
+    oldTable.swap(table);
+    size_t mask = table.size()-1;
+    for ( const Entry & entry : oldTable )
+    {
+        if ( entry.strId != NoStr )
+        {
+            size_t i = entry.hash & mask;
+            while ( table[i].strId != NoStr )
+                i = (i+1) & mask;
+
+            table[i] = entry;
+        }
+    }
+}
+
+ScStr::ScStr(const std::string & str) : strProp()
+{
+    assign(str);
+}
+
+ScStr::ScStr(const std::string & str, const StrProp & strProp) : strProp(strProp)
+{
+    assign(str);
 }
 
 bool ScStr::empty() const
 {
-    return parentStr == nullptr ? allocation.size() <= 1 : parentStr->empty();
+    return allocation.size() <= 1;
 }
 
 size_t ScStr::length() const
 {
-    return parentStr == nullptr ? (allocation.size() > 0 ? allocation.size()-1 : 0) : strlen(str);
+    return allocation.size()-1;
 }
 
 StrProp & ScStr::properties()
@@ -355,74 +515,109 @@ template std::shared_ptr<EscString> ScStr::toString<EscString>() const;
 template std::shared_ptr<ChkdString> ScStr::toString<ChkdString>() const;
 template std::shared_ptr<SingleLineChkdString> ScStr::toString<SingleLineChkdString>() const;
 
-ScStrPtr ScStr::getParentStr()
+void ScStr::assign(const std::string & str)
 {
-    return parentStr;
+    size_t length = std::strlen(str.c_str()); // Characters after an embedded NUL aren't part of the string
+    allocation.assign(str.c_str(), str.c_str()+length+1);
+    this->str = &allocation[0];
 }
 
-ScStrPtr ScStr::getChildStr()
+template <typename StringType>
+static std::shared_ptr<StringType> arenaStrToString(const ScStrArena & arena, u32 strId)
 {
-    return childStr;
+    std::shared_ptr<StringType> destStr = std::shared_ptr<StringType>(new StringType());
+    convertStr<RawString, StringType>(arena.str(strId), *destStr);
+    return destStr;
 }
 
-bool ScStr::adopt(ScStrPtr lhs, ScStrPtr rhs)
+static bool compactScStrArena(ScStrArenaPtr & arena, std::vector<u32> & strings, size_t & arenaBytesChecked, bool checkNow) // Returns true if the strings were moved to a new arena
 {
-    if ( rhs != nullptr && lhs != nullptr && rhs->parentStr == nullptr || lhs->parentStr == nullptr )
+    // Characters of replaced and deleted strings stay in the arena until the stored strings are moved to a new arena, which is done once most of the arena is unused;
+    // unless checkNow is set that's only checked after the arena has doubled in size since it was last checked, so the pass over the strings is amortized over the allocations
+    size_t bytesAllocated = arena->bytesAllocated();
+    if ( !checkNow && bytesAllocated < 2*arenaBytesChecked + ScStrArena::BlockSize )
+        return false;
+
+    size_t bytesUsed = 0;
+    for ( u32 strId : strings )
     {
-        size_t lhsLength = lhs->parentStr == nullptr ? lhs->allocation.size()-1 : strlen(lhs->str);
-        size_t rhsLength = rhs->parentStr == nullptr ? rhs->allocation.size()-1 : strlen(rhs->str);
-        if ( rhsLength > lhsLength ) // The length of rhs is greater
-        {
-            const char* rhsSubString = &rhs->str[rhsLength-lhsLength];
-            if ( strcmp(lhs->str, rhsSubString) == 0 ) // rhs can adopt lhs
-                ScStr::adopt(rhs, lhs, rhsLength, lhsLength, rhsSubString);
-        }
-        else // lhsLength >= rhsLength - the length of lhs is greater or equal to rhs
+        if ( strId != ScStrArena::NoStr )
+            bytesUsed += arena->length(strId)+1;
+    }
+
+    if ( 2*bytesUsed < bytesAllocated )
+    {
+        ScStrArenaPtr compacted = std::make_shared<ScStrArena>();
+        compacted->reserve(strings.size());
+        for ( u32 & strId : strings )
         {
-            const char* lhsSubString = &lhs->str[lhsLength-rhsLength];
-            if ( strcmp(rhs->str, lhsSubString) == 0 ) // lhs can adopt rhs
-                ScStr::adopt(lhs, rhs, lhsLength, rhsLength, lhsSubString);
+            if ( strId != ScStrArena::NoStr ) // The old arena is released with the last section (e.g. a section backup) still using it
+                strId = compacted->intern(arena->str(strId), arena->length(strId));
         }
+        arena = compacted;
+        arenaBytesChecked = arena->bytesAllocated();
+        return true;
     }
+    arenaBytesChecked = arena->bytesAllocated();
     return false;
 }
 
-void ScStr::disown()
+size_t ScStrIndex::find(u32 strId, const std::vector<u32> & strings)
 {
-    if ( childStr != nullptr )
-    {
-        childStr->parentStr = parentStr; // Make child's parent its grandparent (or nullptr if none)
-        childStr = nullptr;
-    }
-    if ( parentStr != nullptr )
+    if ( !indexed )
     {
-        parentStr->childStr = childStr; // Make parent's child its grandchild (or nullptr if none)
-        parentStr = nullptr;
+        ids.clear();
+        for ( size_t stringId=1; stringId<strings.size(); stringId++ )
+        {
+            if ( strings[stringId] != ScStrArena::NoStr )
+            {
+                if ( strings[stringId] >= ids.size() )
+                    ids.resize(strings[stringId]+1, Ids{0, 0});
+
+                Ids & stringIds = ids[strings[stringId]];
+                if ( stringIds.count++ == 0 )
+                    stringIds.lowestId = stringId;
+            }
+        }
+        indexed = true;
     }
+    return strId < ids.size() && ids[strId].count > 0 ? ids[strId].lowestId : (size_t)Chk::StringId::NoString;
 }
 
-void ScStr::adopt(ScStrPtr parent, ScStrPtr child, size_t parentLength, size_t childLength, const char* parentSubString)
+void ScStrIndex::add(size_t stringId, const std::vector<u32> & strings)
 {
-    ScStrPtr nextChild = parent->childStr; // Some descendent of parent may be a more suitable parent for this child
-    while ( nextChild != nullptr && nextChild->length() > childLength )
-    {
-        parent = nextChild;
-        nextChild = parent->childStr;
-    }
-    if ( nextChild != nullptr ) // There are more children smaller than this one that this child should adopt
+    if ( indexed && stringId < strings.size() && strings[stringId] != ScStrArena::NoStr )
     {
-        child->childStr = parent->childStr; // Make child's child the smaller child
-        child->childStr->parentStr = child; // Make parent for that same smaller child this child
-        child->parentStr = parent; // Make child's parent the smallest suitable parent selected above
-        parent->childStr = child; // Assign the child as child to the parent
+        if ( strings[stringId] >= ids.size() )
+            ids.resize(strings[stringId]+1, Ids{0, 0});
+
+        Ids & stringIds = ids[strings[stringId]];
+        if ( stringIds.count++ == 0 || stringId < stringIds.lowestId )
+            stringIds.lowestId = stringId;
     }
-    else // nextChild == nullptr, there are no more children smaller than this one
+}
+
+void ScStrIndex::remove(size_t stringId, const std::vector<u32> & strings)
+{
+    if ( indexed && stringId < strings.size() && strings[stringId] != ScStrArena::NoStr )
     {
-        child->parentStr = parent; // Make child's parent the smallest suitable parent selected above
-        parent->childStr = child; // Assign the child as child to the parent
+        if ( strings[stringId] >= ids.size() || ids[strings[stringId]].count == 0 )
+            indexed = false;
+        else if ( ids[strings[stringId]].count == 1 )
+            ids[strings[stringId]].count = 0;
+        else if ( ids[strings[stringId]].lowestId == stringId ) // The next lowest id with the same characters isn't known, rebuild on the next find
+            indexed = false;
+        else
+            ids[strings[stringId]].count--;
     }
 }
 
+void ScStrIndex::clear()
+{
+    ids.clear();
+    indexed = false;
+}
+
 StrSerializationFailure::StrSerializationFailure()
     : StringException("Unknown error serializing STR section!")
 {
@@ -903,6 +1098,11 @@ MtxmSection::~MtxmSection()
 
 }
 
+size_t MtxmSection::numTiles() const
+{
+    return tiles.size();
+}
+
 u16 MtxmSection::getTile(size_t tileIndex) const
 {
     if ( tileIndex < tiles.size() )
@@ -1618,6 +1818,11 @@ IsomSection::~IsomSection()
 
 }
 
+size_t IsomSection::numIsomEntries() const
+{
+    return isomEntries.size();
+}
+
 Chk::IsomEntry & IsomSection::getIsomEntry(size_t isomIndex)
 {
     if ( isomIndex < isomEntries.size() )
@@ -1698,6 +1903,11 @@ TileSection::~TileSection()
 
 }
 
+size_t TileSection::numTiles() const
+{
+    return tiles.size();
+}
+
 u16 TileSection::getTile(size_t tileIndex) const
 {
     if ( tileIndex < tiles.size() )
@@ -2183,7 +2393,7 @@ StrSectionPtr StrSection::GetDefault(bool blank)
     StrSectionPtr newSection(new (std::nothrow) StrSection());
 
     newSection->strings.clear();
-    newSection->strings.push_back(nullptr); // Fill the non-existant 0th stringId
+    newSection->strings.push_back(ScStrArena::NoStr); // Fill the non-existant 0th stringId
     if ( !blank )
     {
         const std::vector<std::string> defaultStrings = {
@@ -2197,19 +2407,21 @@ StrSectionPtr StrSection::GetDefault(bool blank)
         };
 
         for ( const std::string & defaultString : defaultStrings )
-            newSection->strings.push_back(ScStrPtr(new ScStr(defaultString)));
+        {
+            newSection->strings.push_back(newSection->arena->intern(defaultString.c_str(), defaultString.size()));
+        }
     }
 
     return newSection;
 }
 
-StrSection::StrSection() : DynamicSection<false>(SectionName::STR), bytePaddedTo(4), initialTailDataOffset(0)
+StrSection::StrSection() : DynamicSection<false>(SectionName::STR), arena(std::make_shared<ScStrArena>()), arenaBytesChecked(0), bytePaddedTo(4), initialTailDataOffset(0)
 {
     
 }
 
 
-StrSection::StrSection(const StrSection & other) : DynamicSection<false>(SectionName::STR), strings(other.strings), stringBytes(other.stringBytes),
+StrSection::StrSection(const StrSection & other) : DynamicSection<false>(SectionName::STR), arena(other.arena), arenaBytesChecked(other.arenaBytesChecked), strings(other.strings), stringBytes(other.stringBytes),
     bytePaddedTo(other.bytePaddedTo), initialTailDataOffset(other.initialTailDataOffset), tailData(other.tailData)
 {
 
@@ -2225,6 +2437,22 @@ size_t StrSection::getCapacity() const
     return strings.size();
 }
 
+size_t StrSection::getCharactersAllocated() const
+{
+    return arena->bytesAllocated();
+}
+
+size_t StrSection::getStoredCharacters() const
+{
+    size_t storedCharacters = 0;
+    for ( size_t stringId=1; stringId<strings.size(); stringId++ )
+    {
+        if ( strings[stringId] != ScStrArena::NoStr )
+            storedCharacters += arena->length(strings[stringId])+1;
+    }
+    return storedCharacters;
+}
+
 size_t StrSection::getBytesUsed(StrSynchronizerPtr strSynchronizer, StrCompressionElevatorPtr compressionElevator)
 {
     if ( syncStringsToBytes(strSynchronizer) )
@@ -2237,7 +2465,7 @@ size_t StrSection::getBytesUsed(StrSynchronizerPtr strSynchronizer, StrCompressi
 
 bool StrSection::stringStored(size_t stringId) const
 {
-    return stringId < strings.size() && strings[stringId] != nullptr;
+    return stringId < strings.size() && strings[stringId] != ScStrArena::NoStr;
 }
 
 void StrSection::unmarkUnstoredStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const
@@ -2246,7 +2474,7 @@ void StrSection::unmarkUnstoredStrings(std::bitset<Chk::MaxStrings> & stringIdUs
     size_t stringId = 1;
     for ( ; stringId < limit; ++stringId )
     {
-        if ( stringIdUsed[stringId] && strings[stringId] == nullptr )
+        if ( stringIdUsed[stringId] && strings[stringId] == ScStrArena::NoStr )
             stringIdUsed[stringId] = false;
     }
     for ( ; stringId < Chk::MaxStrings; stringId++ )
@@ -2259,7 +2487,7 @@ void StrSection::unmarkUnstoredStrings(std::bitset<Chk::MaxStrings> & stringIdUs
 template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkdString (Editor <01>Style)
 std::shared_ptr<StringType> StrSection::getString(size_t stringId) const
 {
-    return stringId < strings.size() && strings[stringId] != nullptr ? strings[stringId]->toString<StringType>() : nullptr;
+    return stringId < strings.size() && strings[stringId] != ScStrArena::NoStr ? arenaStrToString<StringType>(*arena, strings[stringId]) : nullptr;
 }
 template std::shared_ptr<RawString> StrSection::getString<RawString>(size_t stringId) const;
 template std::shared_ptr<EscString> StrSection::getString<EscString>(size_t stringId) const;
@@ -2269,11 +2497,12 @@ template std::shared_ptr<SingleLineChkdString> StrSection::getString<SingleLineC
 template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
 size_t StrSection::findString(const StringType & str) const
 {
-    for ( size_t stringId=1; stringId<strings.size(); stringId++ )
-    {
-        if ( strings[stringId] != nullptr && strings[stringId]->compare<StringType>(str) == 0 )
-            return stringId;
-    }
+    RawString rawString;
+    convertStr<StringType, RawString>(str, rawString);
+    u32 strId = arena->find(rawString.c_str(), std::strlen(rawString.c_str()));
+    if ( strId != ScStrArena::NoStr ) // Every string in the section is interned, so any match has the same arena id
+        return stringIndex.find(strId, strings);
+
     return Chk::StringId::NoString;
 }
 template size_t StrSection::findString<RawString>(const RawString & str) const;
@@ -2310,10 +2539,13 @@ bool StrSection::setCapacity(size_t stringCapacity, StrSynchronizer & strSynchro
     }
         
     while ( strings.size() <= stringCapacity )
-        strings.push_back(nullptr);
+        strings.push_back(ScStrArena::NoStr);
 
     while ( strings.size() > stringCapacity )
+    {
+        stringIndex.remove(strings.size()-1, strings);
         strings.pop_back();
+    }
 
     return true;
 }
@@ -2337,7 +2569,13 @@ size_t StrSection::addString(const StringType & str, StrSynchronizer & strSynchr
     else if ( nextUnusedStringId == 0 )
         throw MaximumStringsExceeded();
 
-    strings[nextUnusedStringId] = ScStrPtr(new ScStr(rawString));
+    size_t length = std::strlen(rawString.c_str());
+    stringIndex.remove(nextUnusedStringId, strings);
+    strings[nextUnusedStringId] = arena->intern(rawString.c_str(), length);
+    stringIndex.add(nextUnusedStringId, strings);
+    if ( compactScStrArena(arena, strings, arenaBytesChecked, false) )
+        stringIndex.clear();
+
     return nextUnusedStringId;
 }
 template size_t StrSection::addString<RawString>(const RawString & str, StrSynchronizer & strSynchronizer, bool autoDefragment);
@@ -2345,6 +2583,89 @@ template size_t StrSection::addString<EscString>(const EscString & str, StrSynch
 template size_t StrSection::addString<ChkdString>(const ChkdString & str, StrSynchronizer & strSynchronizer, bool autoDefragment);
 template size_t StrSection::addString<SingleLineChkdString>(const SingleLineChkdString & str, StrSynchronizer & strSynchronizer, bool autoDefragment);
 
+template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
+std::vector<size_t> StrSection::addStrings(const std::vector<StringType> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds)
+{
+    // Used strings are marked, existing strings are looked up and capacity is set once for all the strings rather than once per string, nothing is added if this throws
+    std::vector<size_t> stringIds(strs.size(), size_t(Chk::StringId::NoString));
+    if ( strs.empty() )
+        return stringIds;
+
+    std::set<size_t> replacedStringIds; // Stored but unused strings that strings added earlier in this batch take the place of
+    std::bitset<Chk::MaxStrings> stringIdUsed;
+    strSynchronizer.markUsedStrings(stringIdUsed, Chk::Scope::Either, Chk::Scope::Game);
+    for ( size_t stringId : reservedStringIds )
+    {
+        if ( stringId < Chk::MaxStrings )
+            stringIdUsed[stringId] = true; // In use by something not yet in the scenario
+    }
+    std::deque<RawString> rawStrings; // Holds the characters of the added strings until they're interned, which happens once nothing can throw
+    std::unordered_map<std::string_view, size_t> addedStringIds; // The id of each string added so far
+    std::vector<std::pair<size_t, std::string_view>> addedStrings;
+    size_t nextUnusedStringId = 1;
+    for ( size_t i=0; i<strs.size(); i++ )
+    {
+        RawString rawString;
+        convertStr<StringType, RawString>(strs[i], rawString);
+        size_t length = std::strlen(rawString.c_str());
+        u32 strId = arena->find(rawString.c_str(), length);
+        size_t foundStringId = strId != ScStrArena::NoStr ? stringIndex.find(strId, strings) : (size_t)Chk::StringId::NoString;
+        if ( foundStringId != Chk::StringId::NoString && replacedStringIds.count(foundStringId) > 0 ) // The lowest copy is being replaced, as in findString use the next
+        {
+            size_t replacedStringId = foundStringId;
+            foundStringId = Chk::StringId::NoString;
+            for ( size_t stringId=replacedStringId+1; stringId<strings.size(); stringId++ )
+            {
+                if ( strings[stringId] == strId && replacedStringIds.count(stringId) == 0 )
+                {
+                    foundStringId = stringId;
+                    break;
+                }
+            }
+        }
+        auto added = addedStringIds.find(std::string_view(rawString.c_str(), length));
+        if ( foundStringId != Chk::StringId::NoString )
+            stringIds[i] = foundStringId; // String already exists
+        else if ( added != addedStringIds.end() )
+            stringIds[i] = added->second; // String was added earlier in this batch
+        else
+        {
+            nextUnusedStringId = getNextUnusedStringId(stringIdUsed, true, nextUnusedStringId);
+            if ( nextUnusedStringId == 0 )
+                throw MaximumStringsExceeded();
+
+            if ( nextUnusedStringId < strings.size() && strings[nextUnusedStringId] != ScStrArena::NoStr ) // Replacing a stored but unused string
+                replacedStringIds.insert(nextUnusedStringId);
+
+            rawStrings.push_back(std::move(rawString));
+            std::string_view addedString(rawStrings.back().c_str(), length);
+            addedStringIds.insert(std::pair<std::string_view, size_t>(addedString, nextUnusedStringId));
+            addedStrings.push_back(std::pair<size_t, std::string_view>(nextUnusedStringId, addedString));
+            stringIds[i] = nextUnusedStringId;
+        }
+        stringIdUsed[stringIds[i]] = true; // The string is put to use before the next is added
+    }
+
+    if ( !addedStrings.empty() && addedStrings.back().first >= strings.size() )
+        setCapacity(addedStrings.back().first+1, strSynchronizer, autoDefragment);
+
+    for ( auto & addedString : addedStrings )
+    {
+        stringIndex.remove(addedString.first, strings);
+        strings[addedString.first] = arena->intern(addedString.second.data(), addedString.second.size());
+        stringIndex.add(addedString.first, strings);
+    }
+
+    if ( compactScStrArena(arena, strings, arenaBytesChecked, false) )
+        stringIndex.clear();
+
+    return stringIds;
+}
+template std::vector<size_t> StrSection::addStrings<RawString>(const std::vector<RawString> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> StrSection::addStrings<EscString>(const std::vector<EscString> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> StrSection::addStrings<ChkdString>(const std::vector<ChkdString> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> StrSection::addStrings<SingleLineChkdString>(const std::vector<SingleLineChkdString> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+
 template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
 void StrSection::replaceString(size_t stringId, const StringType & str)
 {
@@ -2352,22 +2673,57 @@ void StrSection::replaceString(size_t stringId, const StringType & str)
     convertStr<StringType, RawString>(str, rawString);
 
     if ( stringId < strings.size() )
-        strings[stringId] = ScStrPtr(new ScStr(rawString, StrProp()));
+    {
+        size_t length = std::strlen(rawString.c_str());
+        stringIndex.remove(stringId, strings);
+        strings[stringId] = arena->intern(rawString.c_str(), length);
+        stringIndex.add(stringId, strings);
+        if ( compactScStrArena(arena, strings, arenaBytesChecked, false) )
+            stringIndex.clear();
+    }
 }
 template void StrSection::replaceString<RawString>(size_t stringId, const RawString & str);
 template void StrSection::replaceString<EscString>(size_t stringId, const EscString & str);
 template void StrSection::replaceString<ChkdString>(size_t stringId, const ChkdString & str);
 template void StrSection::replaceString<SingleLineChkdString>(size_t stringId, const SingleLineChkdString & str);
 
+template <typename StringType>
+void StrSection::replaceStrings(const std::vector<std::pair<size_t, StringType>> & replacements)
+{
+    bool replaced = false;
+    for ( const auto & replacement : replacements )
+    {
+        size_t stringId = replacement.first;
+        if ( stringId < strings.size() )
+        {
+            RawString rawString;
+            convertStr<StringType, RawString>(replacement.second, rawString);
+            size_t length = std::strlen(rawString.c_str());
+            stringIndex.remove(stringId, strings);
+            strings[stringId] = arena->intern(rawString.c_str(), length);
+            stringIndex.add(stringId, strings);
+            replaced = true;
+        }
+    }
+    if ( replaced && compactScStrArena(arena, strings, arenaBytesChecked, false) ) // Moves the strings to a new arena at most once for the batch
+        stringIndex.clear();
+}
+template void StrSection::replaceStrings<RawString>(const std::vector<std::pair<size_t, RawString>> & replacements);
+template void StrSection::replaceStrings<EscString>(const std::vector<std::pair<size_t, EscString>> & replacements);
+template void StrSection::replaceStrings<ChkdString>(const std::vector<std::pair<size_t, ChkdString>> & replacements);
+template void StrSection::replaceStrings<SingleLineChkdString>(const std::vector<std::pair<size_t, SingleLineChkdString>> & replacements);
+
 void StrSection::deleteUnusedStrings(StrSynchronizer & strSynchronizer)
 {
     std::bitset<65536> stringIdUsed;
     strSynchronizer.markUsedStrings(stringIdUsed, Chk::Scope::Either, Chk::Scope::Game);
     for ( size_t i=0; i<strings.size(); i++ )
     {
-        if ( !stringIdUsed[i] && strings[i] != nullptr )
-            strings[i] = nullptr;
+        if ( !stringIdUsed[i] && strings[i] != ScStrArena::NoStr )
+            strings[i] = ScStrArena::NoStr;
     }
+    compactScStrArena(arena, strings, arenaBytesChecked, true);
+    stringIndex.clear();
 }
 
 bool StrSection::deleteString(size_t stringId, bool deleteOnlyIfUnused, StrSynchronizerPtr strSynchronizer)
@@ -2376,7 +2732,8 @@ bool StrSection::deleteString(size_t stringId, bool deleteOnlyIfUnused, StrSynch
     {
         if ( stringId < strings.size() )
         {
-            strings[stringId] = nullptr;
+            stringIndex.remove(stringId, strings);
+            strings[stringId] = ScStrArena::NoStr;
             return true;
         }
     }
@@ -2391,9 +2748,9 @@ void StrSection::moveString(size_t stringIdFrom, size_t stringIdTo, StrSynchroni
     {
         std::bitset<Chk::MaxStrings> stringIdUsed;
         strSynchronizer.markUsedStrings(stringIdUsed, Chk::Scope::Game);
-        ScStrPtr selected = strings[stringIdFrom];
+        u32 selected = strings[stringIdFrom];
         stringIdUsed[stringIdFrom] = false;
-        std::map<u32, u32> stringIdRemappings;
+        Chk::StringIdRemappings stringIdRemappings;
         if ( stringIdTo < stringIdFrom ) // Move to a lower stringId, if there are strings in the way, cascade towards stringIdFrom
         {
             while ( stringIdUsed[stringIdTo] ) // There is a block of one or more strings where the selected string needs to go
@@ -2402,17 +2759,16 @@ void StrSection::moveString(size_t stringIdFrom, size_t stringIdTo, StrSynchroni
                 {
                     if ( !stringIdUsed[stringId] ) // Move the highest stringId remaining in the block to the next available stringId
                     {
-                        ScStrPtr highestString = strings[stringId-1];
-                        strings[stringId-1] = nullptr;
+                        u32 highestString = strings[stringId-1];
+                        strings[stringId-1] = ScStrArena::NoStr;
                         stringIdUsed[stringId-1] = false;
                         strings[stringId] = highestString;
                         stringIdUsed[stringId] = true;
-                        stringIdRemappings.insert(std::pair<u32, u32>(u32(stringId-1), (u32)stringId));
+                        stringIdRemappings.set(stringId-1, stringId);
                         break;
                     }
                 }
             }
-            stringIdRemappings.insert(std::pair<u32, u32>((u32)stringIdFrom, (u32)stringIdTo));
         }
         else if ( stringIdTo > stringIdFrom ) // Move to a higher stringId, if there are strings in the way, cascade towards stringIdTo
         {
@@ -2422,19 +2778,20 @@ void StrSection::moveString(size_t stringIdFrom, size_t stringIdTo, StrSynchroni
                 {
                     if ( !stringIdUsed[stringId] ) // Move the lowest stringId in the block to the available stringId
                     {
-                        ScStrPtr lowestString = strings[stringId+1];
-                        strings[stringId+1] = nullptr;
+                        u32 lowestString = strings[stringId+1];
+                        strings[stringId+1] = ScStrArena::NoStr;
                         stringIdUsed[stringId+1] = false;
                         strings[stringId] = lowestString;
                         stringIdUsed[stringId] = true;
-                        stringIdRemappings.insert(std::pair<u32, u32>(u32(stringId+1), (u32)stringId));
+                        stringIdRemappings.set(stringId+1, stringId);
                         break;
                     }
                 }
             }
         }
         strings[stringIdTo] = selected;
-        stringIdRemappings.insert(std::pair<u32, u32>((u32)stringIdFrom, (u32)stringIdTo));
+        stringIndex.clear();
+        stringIdRemappings.set(stringIdFrom, stringIdTo);
         strSynchronizer.remapStringIds(stringIdRemappings, Chk::Scope::Game);
     }
 }
@@ -2445,7 +2802,7 @@ bool StrSection::checkFit(StrSynchronizer & strSynchronizer, StrCompressionEleva
         return false;
 
     try {
-        strSynchronizer.syncStringsToBytes(strings, stringBytes, compressionElevator);
+        strSynchronizer.syncStringsToBytes(*arena, strings, stringBytes, compressionElevator);
         return true;
     } catch ( std::exception & ) {
         return false;
@@ -2456,23 +2813,27 @@ bool StrSection::defragment(StrSynchronizer & strSynchronizer, bool matchCapacit
 {
     size_t nextCandidateStringId = 0;
     size_t numStrings = strings.size();
-    std::map<u32, u32> stringIdRemappings;
-    for ( size_t i=0; i<numStrings; i++ )
+    Chk::StringIdRemappings stringIdRemappings;
+    for ( size_t i=1; i<numStrings; i++ ) // stringId:0 is never used
     {
-        if ( strings[i] == nullptr )
+        if ( strings[i] == ScStrArena::NoStr )
         {
             for ( size_t j = std::max(i+1, nextCandidateStringId); j < numStrings; j++ )
             {
-                if ( strings[j] != nullptr )
+                if ( strings[j] != ScStrArena::NoStr )
                 {
                     strings[i] = strings[j];
-                    stringIdRemappings.insert(std::pair<u32, u32>((u32)j, (u32)i));
+                    strings[j] = ScStrArena::NoStr;
+                    stringIdRemappings.set(j, i);
+                    nextCandidateStringId = j+1;
                     break;
                 }
             }
         }
     }
 
+    compactScStrArena(arena, strings, arenaBytesChecked, true);
+    stringIndex.clear();
     if ( !stringIdRemappings.empty() )
     {
         strSynchronizer.remapStringIds(stringIdRemappings, Chk::Scope::Game);
@@ -2488,7 +2849,7 @@ std::vector<u8> & StrSection::getTailData()
 
 size_t StrSection::getTailDataOffset(StrSynchronizer & strSynchronizer)
 {
-    strSynchronizer.syncStringsToBytes(strings, stringBytes);
+    strSynchronizer.syncStringsToBytes(*arena, strings, stringBytes);
     return stringBytes.size();
 }
 
@@ -2517,7 +2878,10 @@ void StrSection::restore(StrSectionPtr backup)
 {
     if ( backup != nullptr )
     {
+        arena.swap(backup->arena);
+        std::swap(arenaBytesChecked, backup->arenaBytesChecked);
         strings.swap(backup->strings);
+        stringIndex.clear();
         stringBytes.swap(backup->stringBytes);
         bytePaddedTo = backup->bytePaddedTo;
         initialTailDataOffset = backup->initialTailDataOffset;
@@ -2578,6 +2942,7 @@ std::streamsize StrSection::read(const Chk::SectionHeader & sectionHeader, std::
     {
         stringBytes.clear();
         strings.clear();
+        stringIndex.clear();
         tailData.clear();
         initialTailDataOffset = 0;
         bytePaddedTo = 4;
@@ -2619,31 +2984,6 @@ size_t StrSection::getNextUnusedStringId(std::bitset<Chk::MaxStrings> & stringId
     return 0;
 }
 
-void StrSection::resolveParantage()
-{
-    for ( auto string = strings.begin(); string != strings.end(); ++string )
-    {
-        auto otherString = string;
-        ++otherString;
-        for ( ; otherString != strings.end(); ++otherString )
-            ScStr::adopt(*string, *otherString);
-    }
-}
-
-void StrSection::resolveParantage(ScStrPtr string)
-{
-    if ( string != nullptr )
-    {
-        string->disown();
-        for ( auto it = strings.begin(); it != strings.end(); ++it )
-        {
-            ScStrPtr otherString = *it;
-            if ( otherString != nullptr && otherString != string )
-                ScStr::adopt(string, otherString);
-        }
-    }
-}
-
 bool StrSection::stringsMatchBytes() const
 {
     if ( stringBytes.size() == 0 )
@@ -2656,14 +2996,14 @@ bool StrSection::stringsMatchBytes() const
 
     for ( size_t stringId = 1; stringId<strings.size(); ++stringId )
     {
-        ScStrPtr scStr = strings[stringId];
-        if ( scStr != nullptr )
+        u32 strId = strings[stringId];
+        if ( strId != ScStrArena::NoStr )
         {
             size_t offsetPos = sizeof(u16)*stringId;
             if ( offsetPos+1 < numBytes )
             {
                 u16 stringOffset = (u16 &)stringBytes[offsetPos];
-                if ( size_t(stringOffset)+scStr->length() > numBytes || std::memcmp(scStr->str, &stringBytes[stringOffset], scStr->length()) != 0 )
+                if ( size_t(stringOffset)+arena->length(strId) > numBytes || std::memcmp(arena->str(strId), &stringBytes[stringOffset], arena->length(strId)) != 0 )
                     return false; // String out of bounds or not equal
             }
             else // String offset out of bounds
@@ -2681,7 +3021,7 @@ bool StrSection::syncStringsToBytes(ScenarioSaver & scenarioSaver)
 bool StrSection::syncStringsToBytes(StrSynchronizerPtr strSynchronizer)
 {
     if ( strSynchronizer != nullptr )
-        strSynchronizer->syncStringsToBytes(strings, stringBytes);
+        strSynchronizer->syncStringsToBytes(*arena, strings, stringBytes);
     else
     {
         constexpr size_t maxStrings = (size_t(u16_max) - sizeof(u16))/sizeof(u16);
@@ -2693,8 +3033,8 @@ bool StrSection::syncStringsToBytes(StrSynchronizerPtr strSynchronizer)
         size_t sectionSize = sizeAndOffsetSpaceAndNulSpace;
         for ( size_t i=1; i<=numStrings; i++ )
         {
-            if ( strings[i] != nullptr )
-                sectionSize += strings[i]->length();
+            if ( strings[i] != ScStrArena::NoStr )
+                sectionSize += arena->length(strings[i]);
         }
 
         constexpr size_t maxStandardSize = u16_max;
@@ -2707,12 +3047,12 @@ bool StrSection::syncStringsToBytes(StrSynchronizerPtr strSynchronizer)
         stringBytes.push_back(u8('\0')); // Add initial NUL character
         for ( size_t i=1; i<=numStrings; i++ )
         {
-            if ( strings[i] == nullptr )
+            if ( strings[i] == ScStrArena::NoStr )
                 (u16 &)stringBytes[sizeof(u16)*i] = initialNulOffset;
             else
             {
                 (u16 &)stringBytes[sizeof(u16)*i] = u16(stringBytes.size());
-                stringBytes.insert(stringBytes.end(), strings[i]->str, strings[i]->str+(strings[i]->length()+1));
+                stringBytes.insert(stringBytes.end(), arena->str(strings[i]), arena->str(strings[i])+(arena->length(strings[i])+1));
             }
         }
     }
@@ -2725,7 +3065,12 @@ void StrSection::syncBytesToStrings()
     u16 rawNumStrings = numBytes >= 2 ? (u16 &)stringBytes[0] : numBytes == 1 ? (u16)stringBytes[0] : 0;
     size_t highestStringWithValidOffset = std::min(size_t(rawNumStrings), numBytes < 4 ? 0 : numBytes/2-1);
     strings.clear();
-    strings.push_back(nullptr); // Fill the non-existant 0th stringId
+    stringIndex.clear();
+    strings.push_back(ScStrArena::NoStr); // Fill the non-existant 0th stringId
+    arena = std::make_shared<ScStrArena>(); // Strings are interned in place within one copy of the section's bytes
+    const char* sectionCharacters = arena->copy(numBytes > 0 ? &stringBytes[0] : nullptr, numBytes);
+    arena->reserve(highestStringWithValidOffset+1);
+    arenaBytesChecked = arena->bytesAllocated();
 
     size_t stringId = 1;
     size_t sectionLastCharacter = 0;
@@ -2733,7 +3078,7 @@ void StrSection::syncBytesToStrings()
     {
         size_t offsetPos = sizeof(u16)*stringId;
         size_t stringOffset = size_t((u16 &)stringBytes[offsetPos]);
-        size_t lastCharacter = loadString(stringOffset, numBytes);
+        size_t lastCharacter = loadString(sectionCharacters, stringOffset, numBytes);
 
         if ( lastCharacter > sectionLastCharacter )
             sectionLastCharacter = lastCharacter;
@@ -2744,10 +3089,10 @@ void StrSection::syncBytesToStrings()
         {
             stringId ++;
             size_t stringOffset = size_t((u16)stringBytes[numBytes-1]);
-            loadString(stringOffset, numBytes);
+            loadString(sectionCharacters, stringOffset, numBytes);
         }
         for ( ; stringId <= size_t(rawNumStrings); ++stringId ) // Any remaining strings are fully out of bounds
-            strings.push_back(nullptr);
+            strings.push_back(ScStrArena::NoStr);
     }
 
     size_t offsetsEnd = sizeof(u16) + sizeof(u16)*rawNumStrings;
@@ -2771,35 +3116,18 @@ void StrSection::syncBytesToStrings()
     }
 }
 
-size_t StrSection::loadString(const size_t & stringOffset, const size_t & sectionSize)
+size_t StrSection::loadString(const char* sectionCharacters, const size_t & stringOffset, const size_t & sectionSize)
 {
     if ( stringOffset < sectionSize )
     {
         auto nextNull = std::find(stringBytes.begin()+stringOffset, stringBytes.end(), u8('\0'));
-        if ( nextNull != stringBytes.end() )
-        {
-            auto nullIndex = std::distance(stringBytes.begin(), nextNull);
-            if ( size_t(nullIndex) >= stringOffset ) // Regular string
-            {
-                strings.push_back(ScStrPtr(new ScStr(std::string((const char*)&stringBytes[stringOffset]))));
-                return nullIndex;
-            }
-            else // String ends where section ends
-            {
-                strings.push_back(ScStrPtr(new ScStr(std::string((const char*)&stringBytes[stringOffset], sectionSize-stringOffset))));
-                return sectionSize-1;
-            }
-        }
-        else if ( sectionSize > stringOffset ) // String ends where section ends
-        {
-            strings.push_back(ScStrPtr(new ScStr(std::string((const char*)&stringBytes[stringOffset], sectionSize-stringOffset))));
-            return sectionSize-1;
-        }
-        else // Character data would be out of bounds
-            strings.push_back(nullptr);
+        size_t lastCharacter = nextNull != stringBytes.end() ? size_t(std::distance(stringBytes.begin(), nextNull)) : sectionSize-1;
+        size_t length = nextNull != stringBytes.end() ? lastCharacter-stringOffset : sectionSize-stringOffset; // Strings without a NUL end where the section ends
+        strings.push_back(arena->internInPlace(&sectionCharacters[stringOffset], length)); // The copied section is followed by a NUL
+        return lastCharacter;
     }
     else // Offset is out of bounds
-        strings.push_back(nullptr);
+        strings.push_back(ScStrArena::NoStr);
 
     return 0;
 }
@@ -3057,15 +3385,10 @@ void MrgnSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) c
     }
 }
 
-void MrgnSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void MrgnSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     for ( size_t i=1; i<locations.size(); i++ )
-    {
-        auto & location = locations[i];
-        auto found = stringIdRemappings.find(location->stringId);
-        if ( found != stringIdRemappings.end() )
-            location->stringId = found->second;
-    }
+        stringIdRemappings.remap(locations[i]->stringId);
 }
 
 void MrgnSection::deleteString(size_t stringId)
@@ -3079,6 +3402,26 @@ void MrgnSection::deleteString(size_t stringId)
 }
 
 bool MrgnSection::locationsFitOriginal(LocationSynchronizer & locationSynchronizer, bool lockAnywhere, bool autoDefragment) const
+{
+    Chk::LocationIdRemappings locationIdRemappings;
+    return planTrimToOriginal(locationSynchronizer, locationIdRemappings, lockAnywhere) <= Chk::TotalOriginalLocations;
+}
+
+bool MrgnSection::trimToOriginal(LocationSynchronizer & locationSynchronizer, bool lockAnywhere, bool autoDefragment)
+{
+    if ( locations.size() > Chk::TotalOriginalLocations )
+    {
+        Chk::LocationIdRemappings locationIdRemappings;
+        if ( planTrimToOriginal(locationSynchronizer, locationIdRemappings, lockAnywhere) <= Chk::TotalOriginalLocations )
+        {
+            trimToOriginal(locationSynchronizer, locationIdRemappings);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t MrgnSection::planTrimToOriginal(LocationSynchronizer & locationSynchronizer, Chk::LocationIdRemappings & locationIdRemappings, bool lockAnywhere) const
 {
     std::bitset<Chk::TotalLocations+1> locationIdUsed;
     locationSynchronizer.markUsedLocations(locationIdUsed);
@@ -3091,51 +3434,44 @@ bool MrgnSection::locationsFitOriginal(LocationSynchronizer & locationSynchroniz
             countUsedOrCreated++;
     }
 
-    return countUsedOrCreated <= Chk::TotalOriginalLocations;
-}
-
-bool MrgnSection::trimToOriginal(LocationSynchronizer & locationSynchronizer, bool lockAnywhere, bool autoDefragment)
-{
-    if ( locations.size() > Chk::TotalOriginalLocations )
+    if ( countUsedOrCreated <= Chk::TotalOriginalLocations )
     {
-        std::bitset<Chk::TotalLocations+1> locationIdUsed;
-        locationSynchronizer.markUsedLocations(locationIdUsed);
-        markNonZeroLocations(locationIdUsed);
-
-        size_t countUsedOrCreated = 0;
-        for ( size_t i=1; i<=Chk::TotalLocations; i++ )
+        for ( size_t firstUnused=1; firstUnused<=Chk::TotalLocations; firstUnused++ )
         {
-            if ( locationIdUsed[i] || (i == Chk::LocationId::Anywhere && lockAnywhere) )
-                countUsedOrCreated++;
-        }
-
-        if ( countUsedOrCreated <= Chk::TotalOriginalLocations )
-        {
-            std::map<u32, u32> locationIdRemappings;
-            for ( size_t firstUnused=1; firstUnused<=Chk::TotalLocations; firstUnused++ )
+            if ( !locationIdUsed[firstUnused] && (firstUnused != Chk::LocationId::Anywhere || !lockAnywhere) )
             {
-                if ( !locationIdUsed[firstUnused] && (firstUnused != Chk::LocationId::Anywhere || !lockAnywhere) )
+                for ( size_t i=firstUnused+1; i<=Chk::TotalLocations; i++ )
                 {
-                    for ( size_t i=firstUnused+1; i<=Chk::TotalLocations; i++ )
+                    if ( locationIdUsed[i] && (i != Chk::LocationId::Anywhere || !lockAnywhere) )
                     {
-                        if ( locationIdUsed[i] && (i != Chk::LocationId::Anywhere || !lockAnywhere) )
-                        {
-                            locations[firstUnused] = locations[i];
-                            locationIdUsed[firstUnused] = true;
-                            locations[i] = Chk::LocationPtr(new Chk::Location());
-                            locationIdUsed[i] = false;
-                            locationIdRemappings.insert(std::pair<u32, u32>(u32(i), u32(firstUnused)));
-                            break;
-                        }
+                        locationIdUsed[firstUnused] = true;
+                        locationIdUsed[i] = false;
+                        locationIdRemappings.set(i, firstUnused);
+                        break;
                     }
                 }
             }
-            locations.erase(locations.begin()+Chk::TotalOriginalLocations+1, locations.end());
-            locationSynchronizer.remapLocationIds(locationIdRemappings);
-            return true;
         }
     }
-    return false;
+    return countUsedOrCreated;
+}
+
+void MrgnSection::trimToOriginal(LocationSynchronizer & locationSynchronizer, const Chk::LocationIdRemappings & locationIdRemappings)
+{
+    for ( size_t i=1; i<locations.size() && !locationIdRemappings.empty(); i++ )
+    {
+        if ( locationIdRemappings.isRemapped(i) ) // Moves are planned lowest location first, each into a location moved out of earlier or unused
+        {
+            locations[locationIdRemappings[i]] = locations[i];
+            locations[i] = Chk::LocationPtr(new Chk::Location());
+        }
+    }
+
+    if ( locations.size() > Chk::TotalOriginalLocations+1 )
+        locations.erase(locations.begin()+Chk::TotalOriginalLocations+1, locations.end());
+
+    if ( !locationIdRemappings.empty() )
+        locationSynchronizer.remapLocationIds(locationIdRemappings);
 }
 
 void MrgnSection::expandToScHybridOrExpansion()
@@ -3187,6 +3523,150 @@ void MrgnSection::write(std::ostream & os, ScenarioSaver & scenarioSaver)
         os.write((const char*)locations[i].get(), std::streamsize(sizeof(Chk::Location)));
 }
 
+TriggerRecords::TriggerRecords() : numRawRecords(0)
+{
+
+}
+
+TriggerRecords::~TriggerRecords()
+{
+
+}
+
+size_t TriggerRecords::size() const
+{
+    return records.size();
+}
+
+const Chk::Trigger* TriggerRecords::read(size_t triggerIndex) const
+{
+    const Record & record = records[triggerIndex];
+    return record.rawIndex == NotRaw ? record.trigger.get() : &rawTriggers[record.rawIndex];
+}
+
+Chk::Trigger* TriggerRecords::change(size_t triggerIndex)
+{
+    Record & record = records[triggerIndex];
+    return record.rawIndex == NotRaw ? record.trigger.get() : &rawTriggers[record.rawIndex];
+}
+
+Chk::TriggerPtr TriggerRecords::get(size_t triggerIndex) const
+{
+    Record & record = records[triggerIndex];
+    if ( record.rawIndex != NotRaw ) // Copy on first get, the trigger may be changed through the pointer from here on
+    {
+        record.trigger = Chk::TriggerPtr(new Chk::Trigger(rawTriggers[record.rawIndex]));
+        record.rawIndex = NotRaw;
+        releaseRaw(1);
+    }
+    return record.trigger;
+}
+
+void TriggerRecords::push_back(Chk::TriggerPtr trigger)
+{
+    records.push_back(Record{trigger, NotRaw});
+}
+
+void TriggerRecords::insert(size_t triggerIndex, Chk::TriggerPtr trigger)
+{
+    records.insert(std::next(records.begin(), triggerIndex), Record{trigger, NotRaw});
+}
+
+void TriggerRecords::erase(size_t triggerIndex)
+{
+    auto record = std::next(records.begin(), triggerIndex);
+    bool raw = record->rawIndex != NotRaw;
+    records.erase(record);
+    if ( raw )
+        releaseRaw(1);
+}
+
+void TriggerRecords::move(size_t triggerIndexFrom, size_t triggerIndexTo)
+{
+    size_t triggerIndexMin = std::min(triggerIndexFrom, triggerIndexTo);
+    size_t triggerIndexMax = std::max(triggerIndexFrom, triggerIndexTo);
+    if ( triggerIndexMax-triggerIndexMin == 1 ) // Move up or down by 1 using swap
+        std::swap(records[triggerIndexMin], records[triggerIndexMax]);
+    else // Move up or down by more than one, remove from present location, insert in the list at destination
+    {
+        Record record = records[triggerIndexFrom];
+        records.erase(std::next(records.begin(), triggerIndexFrom));
+        records.insert(std::next(records.begin(), triggerIndexTo-1), record);
+    }
+}
+
+std::deque<Chk::TriggerPtr> TriggerRecords::replaceRange(size_t beginIndex, size_t endIndex, std::deque<Chk::TriggerPtr> & triggers)
+{
+    std::deque<Chk::TriggerPtr> replacedTriggers;
+    for ( size_t i=beginIndex; i<endIndex; i++ )
+        replacedTriggers.push_back(get(i));
+
+    std::deque<Record> insertedRecords;
+    for ( auto & trigger : triggers )
+        insertedRecords.push_back(Record{trigger, NotRaw});
+
+    if ( beginIndex == 0 && endIndex == records.size() )
+        records.swap(insertedRecords);
+    else
+    {
+        records.erase(std::next(records.begin(), beginIndex), std::next(records.begin(), endIndex));
+        records.insert(std::next(records.begin(), beginIndex), insertedRecords.begin(), insertedRecords.end());
+    }
+    return replacedTriggers;
+}
+
+void TriggerRecords::clear()
+{
+    records.clear();
+    releaseRaw(numRawRecords);
+}
+
+std::streamsize TriggerRecords::readRaw(std::istream & is, size_t readSize)
+{
+    size_t firstRawIndex = rawTriggers.size();
+    size_t numRead = readSize/sizeof(Chk::Trigger) + (readSize%sizeof(Chk::Trigger) > 0 ? 1 : 0);
+    rawTriggers.resize(firstRawIndex+numRead); // Value-initialized, so a partial trigger is zero past the part read
+    is.read((char*)&rawTriggers[firstRawIndex], std::streamsize(readSize));
+    for ( size_t i=0; i<numRead; i++ )
+        records.push_back(Record{nullptr, firstRawIndex+i});
+
+    numRawRecords += numRead;
+    return is.gcount();
+}
+
+void TriggerRecords::writeRaw(std::ostream & os) const
+{
+    size_t numRecords = records.size();
+    for ( size_t i=0; i<numRecords; )
+    {
+        const Record & record = records[i];
+        if ( record.rawIndex == NotRaw )
+        {
+            os.write((const char*)record.trigger.get(), std::streamsize(sizeof(Chk::Trigger)));
+            i++;
+        }
+        else // Write the run of raw records that are still consecutive in rawTriggers at once
+        {
+            size_t runEnd = i+1;
+            while ( runEnd < numRecords && records[runEnd].rawIndex == records[runEnd-1].rawIndex+1 )
+                runEnd++;
+
+            os.write((const char*)&rawTriggers[record.rawIndex], std::streamsize(sizeof(Chk::Trigger)*(runEnd-i)));
+            i = runEnd;
+        }
+    }
+}
+
+void TriggerRecords::releaseRaw(size_t numReleased) const
+{
+    numRawRecords -= numReleased;
+    if ( numRawRecords == 0 )
+    {
+        rawTriggers.clear();
+        rawTriggers.shrink_to_fit();
+    }
+}
+
 TrigSectionPtr TrigSection::GetDefault()
 {
     return TrigSectionPtr(new (std::nothrow) TrigSection());
@@ -3209,12 +3689,17 @@ size_t TrigSection::numTriggers() const
 
 std::shared_ptr<Chk::Trigger> TrigSection::getTrigger(size_t triggerIndex)
 {
-    return triggers[triggerIndex];
+    return triggers.get(triggerIndex);
 }
 
 const std::shared_ptr<Chk::Trigger> TrigSection::getTrigger(size_t triggerIndex) const
 {
-    return triggers[triggerIndex];
+    return triggers.get(triggerIndex);
+}
+
+const Chk::Trigger* TrigSection::readTrigger(size_t triggerIndex) const
+{
+    return triggers.read(triggerIndex);
 }
 
 size_t TrigSection::addTrigger(std::shared_ptr<Chk::Trigger> trigger)
@@ -3226,10 +3711,7 @@ size_t TrigSection::addTrigger(std::shared_ptr<Chk::Trigger> trigger)
 void TrigSection::insertTrigger(size_t triggerIndex, std::shared_ptr<Chk::Trigger> trigger)
 {
     if ( triggerIndex < triggers.size() )
-    {
-        auto position = std::next(triggers.begin(), triggerIndex);
-        triggers.insert(position, trigger);
-    }
+        triggers.insert(triggerIndex, trigger);
     else if ( triggerIndex == triggers.size() )
         triggers.push_back(trigger);
 }
@@ -3237,62 +3719,37 @@ void TrigSection::insertTrigger(size_t triggerIndex, std::shared_ptr<Chk::Trigge
 void TrigSection::deleteTrigger(size_t triggerIndex)
 {
     if ( triggerIndex < triggers.size() )
-    {
-        auto trigger = std::next(triggers.begin(), triggerIndex);
-        triggers.erase(trigger);
-    }
+        triggers.erase(triggerIndex);
 }
 
 void TrigSection::moveTrigger(size_t triggerIndexFrom, size_t triggerIndexTo)
 {
-    size_t triggerIndexMin = std::min(triggerIndexFrom, triggerIndexTo);
     size_t triggerIndexMax = std::max(triggerIndexFrom, triggerIndexTo);
     if ( triggerIndexMax < triggers.size() && triggerIndexFrom != triggerIndexTo )
-    {
-        if ( triggerIndexMax-triggerIndexMin == 1 && triggerIndexMax < triggers.size() ) // Move up or down by 1 using swap
-            triggers[triggerIndexMin].swap(triggers[triggerIndexMax]);
-        else // Move up or down by more than one, remove from present location, insert in the list at destination
-        {
-            auto trigger = triggers[triggerIndexFrom];
-            auto toErase = std::next(triggers.begin(), triggerIndexFrom);
-            triggers.erase(toErase);
-            auto insertPosition = std::next(triggers.begin(), triggerIndexTo-1);
-            triggers.insert(insertPosition, trigger);
-        }
-    }
+        triggers.move(triggerIndexFrom, triggerIndexTo);
 }
 
 void TrigSection::swap(std::deque<std::shared_ptr<Chk::Trigger>> & triggers)
 {
-    this->triggers.swap(triggers);
+    std::deque<Chk::TriggerPtr> previousTriggers = this->triggers.replaceRange(0, this->triggers.size(), triggers);
+    triggers.swap(previousTriggers);
 }
 
 std::deque<Chk::TriggerPtr> TrigSection::replaceRange(size_t beginIndex, size_t endIndex, std::deque<Chk::TriggerPtr> & triggers)
 {
-    if ( beginIndex == 0 && endIndex == triggers.size() )
-    {
-        this->triggers.swap(triggers);
-        return triggers;
-    }
-    else if ( beginIndex < endIndex && endIndex <= this->triggers.size() )
-    {
-        auto begin = this->triggers.begin()+beginIndex;
-        auto end = this->triggers.begin()+endIndex;
-        std::deque<Chk::TriggerPtr> replacedTriggers(this->triggers.begin()+beginIndex, this->triggers.begin()+endIndex);
-        this->triggers.erase(begin, end);
-        this->triggers.insert(this->triggers.begin()+beginIndex, triggers.begin(), triggers.end());
-        return replacedTriggers;
-    }
+    if ( beginIndex <= endIndex && endIndex <= this->triggers.size() )
+        return this->triggers.replaceRange(beginIndex, endIndex, triggers);
     else
         throw std::out_of_range(std::string("Range [") + std::to_string(beginIndex) + ", " + std::to_string(endIndex) +
-            ") is invalid for trigger list of size: " + std::to_string(triggers.size()));
+            ") is invalid for trigger list of size: " + std::to_string(this->triggers.size()));
 }
 
 bool TrigSection::locationUsed(size_t locationId) const
 {
-    for ( auto trigger : triggers )
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
     {
-        if ( trigger->locationUsed(locationId) )
+        if ( triggers.read(i)->locationUsed(locationId) )
             return true;
     }
     return false;
@@ -3303,7 +3760,7 @@ void TrigSection::appendUsage(size_t stringId, std::vector<Chk::StringUser> & st
     size_t numTriggers = triggers.size();
     for ( size_t trigIndex=0; trigIndex<numTriggers; trigIndex++ )
     {
-        const auto & trigger = triggers[trigIndex];
+        const Chk::Trigger* trigger = triggers.read(trigIndex);
         if ( trigger != nullptr )
         {
             for ( size_t actionIndex=0; actionIndex<Chk::Trigger::MaxActions; actionIndex++ )
@@ -3325,9 +3782,10 @@ void TrigSection::appendUsage(size_t stringId, std::vector<Chk::StringUser> & st
 
 bool TrigSection::stringUsed(size_t stringId, u32 userMask) const
 {
-    for ( auto trigger : triggers )
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
     {
-        if ( trigger->stringUsed(stringId, userMask) )
+        if ( triggers.read(i)->stringUsed(stringId, userMask) )
             return true;
     }
     return false;
@@ -3335,9 +3793,10 @@ bool TrigSection::stringUsed(size_t stringId, u32 userMask) const
 
 bool TrigSection::gameStringUsed(size_t stringId, u32 userMask) const
 {
-    for ( auto trigger : triggers )
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
     {
-        if ( trigger->gameStringUsed(stringId, userMask) )
+        if ( triggers.read(i)->gameStringUsed(stringId, userMask) )
             return true;
     }
     return false;
@@ -3345,9 +3804,10 @@ bool TrigSection::gameStringUsed(size_t stringId, u32 userMask) const
 
 bool TrigSection::commentStringUsed(size_t stringId) const
 {
-    for ( auto trigger : triggers )
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
     {
-        if ( trigger->commentStringUsed(stringId) )
+        if ( triggers.read(i)->commentStringUsed(stringId) )
             return true;
     }
     return false;
@@ -3355,50 +3815,58 @@ bool TrigSection::commentStringUsed(size_t stringId) const
 
 void TrigSection::markUsedLocations(std::bitset<Chk::TotalLocations+1> & locationIdUsed) const
 {
-    for ( auto trigger : triggers )
-        trigger->markUsedLocations(locationIdUsed);
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
+        triggers.read(i)->markUsedLocations(locationIdUsed);
 }
 
 void TrigSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask) const
 {
-    for ( auto trigger : triggers )
-        trigger->markUsedStrings(stringIdUsed, userMask);
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
+        triggers.read(i)->markUsedStrings(stringIdUsed, userMask);
 }
 
 void TrigSection::markUsedGameStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask) const
 {
-    for ( auto trigger : triggers )
-        trigger->markUsedGameStrings(stringIdUsed, userMask);
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
+        triggers.read(i)->markUsedGameStrings(stringIdUsed, userMask);
 }
 
 void TrigSection::markUsedCommentStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const
 {
-    for ( auto trigger : triggers )
-        trigger->markUsedCommentStrings(stringIdUsed);
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
+        triggers.read(i)->markUsedCommentStrings(stringIdUsed);
 }
 
-void TrigSection::remapLocationIds(const std::map<u32, u32> & locationIdRemappings)
+void TrigSection::remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings)
 {
-    for ( auto trigger : triggers )
-        trigger->remapLocationIds(locationIdRemappings);
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
+        triggers.change(i)->remapLocationIds(locationIdRemappings); // Raw records are changed in place
 }
 
-void TrigSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void TrigSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
-    for ( auto trigger : triggers )
-        trigger->remapStringIds(stringIdRemappings);
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
+        triggers.change(i)->remapStringIds(stringIdRemappings); // Raw records are changed in place
 }
 
 void TrigSection::deleteLocation(size_t locationId)
 {
-    for ( auto trigger : triggers )
-        trigger->deleteLocation(locationId);
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
+        triggers.change(i)->deleteLocation(locationId); // Raw records are changed in place
 }
 
 void TrigSection::deleteString(size_t stringId)
 {
-    for ( auto trigger : triggers )
-        trigger->deleteString(stringId);
+    size_t numTriggers = triggers.size();
+    for ( size_t i=0; i<numTriggers; i++ )
+        triggers.change(i)->deleteString(stringId); // Raw records are changed in place
 }
 
 Chk::SectionSize TrigSection::getSize(ScenarioSaver &)
@@ -3414,22 +3882,10 @@ std::streamsize TrigSection::read(const Chk::SectionHeader & sectionHeader, std:
     size_t readSize = size_t(sectionHeader.sizeInBytes);
     if ( readSize > 0 )
     {
-        size_t readNumTriggers = readSize/sizeof(Chk::Trigger) + readSize%sizeof(Chk::Trigger);
-        std::vector<Chk::Trigger> triggerBuffer(readNumTriggers);
-        is.read((char*)&triggerBuffer[0], std::streamsize(sectionHeader.sizeInBytes));
-
-        if ( append )
-        {
-            for ( Chk::Trigger & trigger : triggerBuffer )
-                triggers.push_back(Chk::TriggerPtr(new Chk::Trigger(trigger)));
-        }
-        else
-        {
+        if ( !append )
             triggers.clear();
-            for ( Chk::Trigger & trigger : triggerBuffer )
-                triggers.push_back(Chk::TriggerPtr(new Chk::Trigger(trigger)));
-        }
-        return is.gcount();
+
+        return triggers.readRaw(is, readSize);
     }
     else if ( !append )
         triggers.clear();
@@ -3439,8 +3895,7 @@ std::streamsize TrigSection::read(const Chk::SectionHeader & sectionHeader, std:
 
 void TrigSection::write(std::ostream & os, ScenarioSaver &)
 {
-    for ( auto trigger : triggers )
-        os.write((const char*)trigger.get(), std::streamsize(sizeof(Chk::Trigger)));
+    triggers.writeRaw(os);
 }
 
 MbrfSectionPtr MbrfSection::GetDefault()
@@ -3465,12 +3920,17 @@ size_t MbrfSection::numBriefingTriggers() const
 
 std::shared_ptr<Chk::Trigger> MbrfSection::getBriefingTrigger(size_t briefingTriggerIndex)
 {
-    return briefingTriggers[briefingTriggerIndex];
+    return briefingTriggers.get(briefingTriggerIndex);
 }
 
 const std::shared_ptr<Chk::Trigger> MbrfSection::getBriefingTrigger(size_t briefingTriggerIndex) const
 {
-    return briefingTriggers[briefingTriggerIndex];
+    return briefingTriggers.get(briefingTriggerIndex);
+}
+
+const Chk::Trigger* MbrfSection::readBriefingTrigger(size_t briefingTriggerIndex) const
+{
+    return briefingTriggers.read(briefingTriggerIndex);
 }
 
 size_t MbrfSection::addBriefingTrigger(std::shared_ptr<Chk::Trigger> briefingTrigger)
@@ -3482,10 +3942,7 @@ size_t MbrfSection::addBriefingTrigger(std::shared_ptr<Chk::Trigger> briefingTri
 void MbrfSection::insertBriefingTrigger(size_t briefingTriggerIndex, std::shared_ptr<Chk::Trigger> briefingTrigger)
 {
     if ( briefingTriggerIndex < briefingTriggers.size() )
-    {
-        auto position = std::next(briefingTriggers.begin(), briefingTriggerIndex);
-        briefingTriggers.insert(position, briefingTrigger);
-    }
+        briefingTriggers.insert(briefingTriggerIndex, briefingTrigger);
     else if ( briefingTriggerIndex == briefingTriggers.size() )
         briefingTriggers.push_back(briefingTrigger);
 }
@@ -3493,29 +3950,14 @@ void MbrfSection::insertBriefingTrigger(size_t briefingTriggerIndex, std::shared
 void MbrfSection::deleteBriefingTrigger(size_t briefingTriggerIndex)
 {
     if ( briefingTriggerIndex < briefingTriggers.size() )
-    {
-        auto briefingTrigger = std::next(briefingTriggers.begin(), briefingTriggerIndex);
-        briefingTriggers.erase(briefingTrigger);
-    }
+        briefingTriggers.erase(briefingTriggerIndex);
 }
 
 void MbrfSection::moveBriefingTrigger(size_t briefingTriggerIndexFrom, size_t briefingTriggerIndexTo)
 {
-    size_t briefingTriggerIndexMin = std::min(briefingTriggerIndexFrom, briefingTriggerIndexTo);
     size_t briefingTriggerIndexMax = std::max(briefingTriggerIndexFrom, briefingTriggerIndexTo);
     if ( briefingTriggerIndexMax < briefingTriggers.size() && briefingTriggerIndexFrom != briefingTriggerIndexTo )
-    {
-        if ( briefingTriggerIndexMax-briefingTriggerIndexMin == 1 && briefingTriggerIndexMax < briefingTriggers.size() ) // Move up or down by 1 using swap
-            briefingTriggers[briefingTriggerIndexMin].swap(briefingTriggers[briefingTriggerIndexMax]);
-        else // Move up or down by more than one, remove from present location, insert in the list at destination
-        {
-            auto briefingTrigger = briefingTriggers[briefingTriggerIndexFrom];
-            auto toErase = std::next(briefingTriggers.begin(), briefingTriggerIndexFrom);
-            briefingTriggers.erase(toErase);
-            auto insertPosition = std::next(briefingTriggers.begin(), briefingTriggerIndexTo-1);
-            briefingTriggers.insert(insertPosition, briefingTrigger);
-        }
-    }
+        briefingTriggers.move(briefingTriggerIndexFrom, briefingTriggerIndexTo);
 }
 
 void MbrfSection::appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask) const
@@ -3523,7 +3965,7 @@ void MbrfSection::appendUsage(size_t stringId, std::vector<Chk::StringUser> & st
     size_t numBriefingTriggers = briefingTriggers.size();
     for ( size_t briefingTrigIndex=0; briefingTrigIndex<numBriefingTriggers; briefingTrigIndex++ )
     {
-        const auto & briefingTrigger = briefingTriggers[briefingTrigIndex];
+        const Chk::Trigger* briefingTrigger = briefingTriggers.read(briefingTrigIndex);
         if ( briefingTrigger != nullptr )
         {
             for ( size_t actionIndex=0; actionIndex<Chk::Trigger::MaxActions; actionIndex++ )
@@ -3545,9 +3987,10 @@ void MbrfSection::appendUsage(size_t stringId, std::vector<Chk::StringUser> & st
 
 bool MbrfSection::stringUsed(size_t stringId, u32 userMask)
 {
-    for ( auto briefingTrigger : briefingTriggers )
+    size_t numBriefingTriggers = briefingTriggers.size();
+    for ( size_t i=0; i<numBriefingTriggers; i++ )
     {
-        if ( briefingTrigger->briefingStringUsed(stringId, userMask) )
+        if ( briefingTriggers.read(i)->briefingStringUsed(stringId, userMask) )
             return true;
     }
     return false;
@@ -3555,20 +3998,23 @@ bool MbrfSection::stringUsed(size_t stringId, u32 userMask)
 
 void MbrfSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask)
 {
-    for ( auto briefingTrigger : briefingTriggers )
-        briefingTrigger->markUsedBriefingStrings(stringIdUsed, userMask);
+    size_t numBriefingTriggers = briefingTriggers.size();
+    for ( size_t i=0; i<numBriefingTriggers; i++ )
+        briefingTriggers.read(i)->markUsedBriefingStrings(stringIdUsed, userMask);
 }
 
-void MbrfSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void MbrfSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
-    for ( auto briefingTrigger : briefingTriggers )
-        briefingTrigger->remapBriefingStringIds(stringIdRemappings);
+    size_t numBriefingTriggers = briefingTriggers.size();
+    for ( size_t i=0; i<numBriefingTriggers; i++ )
+        briefingTriggers.change(i)->remapBriefingStringIds(stringIdRemappings); // Raw records are changed in place
 }
 
 void MbrfSection::deleteString(size_t stringId)
 {
-    for ( auto briefingTrigger : briefingTriggers )
-        briefingTrigger->deleteString(stringId);
+    size_t numBriefingTriggers = briefingTriggers.size();
+    for ( size_t i=0; i<numBriefingTriggers; i++ )
+        briefingTriggers.change(i)->deleteString(stringId); // Raw records are changed in place
 }
 
 Chk::SectionSize MbrfSection::getSize(ScenarioSaver &)
@@ -3584,22 +4030,10 @@ std::streamsize MbrfSection::read(const Chk::SectionHeader & sectionHeader, std:
     size_t readSize = size_t(sectionHeader.sizeInBytes);
     if ( readSize > 0 )
     {
-        size_t readNumTriggers = readSize/sizeof(Chk::Trigger) + readSize%sizeof(Chk::Trigger);
-        std::vector<Chk::Trigger> triggerBuffer(readNumTriggers);
-        is.read((char*)&triggerBuffer[0], std::streamsize(sectionHeader.sizeInBytes));
-
-        if ( append )
-        {
-            for ( Chk::Trigger & briefingTrigger : triggerBuffer )
-                briefingTriggers.push_back(Chk::TriggerPtr(new Chk::Trigger(briefingTrigger)));
-        }
-        else
-        {
+        if ( !append )
             briefingTriggers.clear();
-            for ( Chk::Trigger & briefingTrigger : triggerBuffer )
-                briefingTriggers.push_back(Chk::TriggerPtr(new Chk::Trigger(briefingTrigger)));
-        }
-        return is.gcount();
+
+        return briefingTriggers.readRaw(is, readSize);
     }
     else if ( !append )
         briefingTriggers.clear();
@@ -3609,8 +4043,7 @@ std::streamsize MbrfSection::read(const Chk::SectionHeader & sectionHeader, std:
 
 void MbrfSection::write(std::ostream & os, ScenarioSaver &)
 {
-    for ( auto trigger : briefingTriggers )
-        os.write((const char*)trigger.get(), std::streamsize(sizeof(Chk::Trigger)));
+    briefingTriggers.writeRaw(os);
 }
 
 SprpSectionPtr SprpSection::GetDefault(u16 scenarioNameStringId, u16 scenarioDescriptionStringId)
@@ -3679,16 +4112,10 @@ void SprpSection::deleteString(size_t stringId)
         data->scenarioDescriptionStringId = 0;
 }
 
-void SprpSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void SprpSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
-    auto scenarioNameRemapping = stringIdRemappings.find(data->scenarioNameStringId);
-    auto scenarioDescriptionRemapping = stringIdRemappings.find(data->scenarioDescriptionStringId);
-
-    if ( scenarioNameRemapping != stringIdRemappings.end() )
-        data->scenarioNameStringId = scenarioNameRemapping->second;
-
-    if ( scenarioDescriptionRemapping != stringIdRemappings.end() )
-        data->scenarioDescriptionStringId = scenarioDescriptionRemapping->second;
+    stringIdRemappings.remap(data->scenarioNameStringId);
+    stringIdRemappings.remap(data->scenarioDescriptionStringId);
 }
 
 void SprpSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask) const
@@ -3800,24 +4227,10 @@ void ForcSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) c
     }
 }
 
-void ForcSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void ForcSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
-    auto forceOneRemapping = stringIdRemappings.find(data->forceString[0]);
-    auto forceTwoRemapping = stringIdRemappings.find(data->forceString[1]);
-    auto forceThreeRemapping = stringIdRemappings.find(data->forceString[2]);
-    auto forceFourRemapping = stringIdRemappings.find(data->forceString[3]);
-
-    if ( forceOneRemapping != stringIdRemappings.end() )
-        data->forceString[0] = forceOneRemapping->second;
-
-    if ( forceTwoRemapping != stringIdRemappings.end() )
-        data->forceString[1] = forceTwoRemapping->second;
-
-    if ( forceThreeRemapping != stringIdRemappings.end() )
-        data->forceString[2] = forceThreeRemapping->second;
-
-    if ( forceFourRemapping != stringIdRemappings.end() )
-        data->forceString[3] = forceFourRemapping->second;
+    for ( size_t i=0; i<Chk::TotalForces; i++ )
+        stringIdRemappings.remap(data->forceString[i]);
 }
 
 void ForcSection::deleteString(size_t stringId)
@@ -3836,12 +4249,12 @@ WavSectionPtr WavSection::GetDefault()
 
 WavSection::WavSection(const Chk::WAV & data) : StructSection<Chk::WAV, true>(SectionName::WAV, data)
 {
-
+    indexSounds();
 }
 
 WavSection::WavSection() : StructSection<Chk::WAV, true>(SectionName::WAV)
 {
-
+    indexSounds();
 }
 
 WavSection::~WavSection()
@@ -3851,26 +4264,19 @@ WavSection::~WavSection()
 
 size_t WavSection::addSound(size_t stringId)
 {
-    for ( size_t i=0; i<Chk::TotalSounds; i++ )
+    auto unusedSounds = soundIndexes.find(Chk::StringId::UnusedSound);
+    if ( unusedSounds != soundIndexes.end() )
     {
-        if ( data->soundPathStringId[i] == Chk::StringId::UnusedSound )
-        {
-            data->soundPathStringId[i] = (u32)stringId;
-            return i;
-        }
+        size_t soundIndex = *unusedSounds->second.begin();
+        setSoundStringId(soundIndex, stringId);
+        return soundIndex;
     }
     return Chk::TotalSounds;
 }
 
 bool WavSection::stringIsSound(size_t stringId) const
 {
-    u32 u32StringId = (u32)stringId;
-    for ( size_t i=0; i<Chk::TotalSounds; i++ )
-    {
-        if ( data->soundPathStringId[i] == u32StringId )
-            return true;
-    }
-    return false;
+    return soundIndexes.find((u32)stringId) != soundIndexes.end();
 }
 
 size_t WavSection::getSoundStringId(size_t soundIndex) const
@@ -3883,16 +4289,27 @@ size_t WavSection::getSoundStringId(size_t soundIndex) const
 
 void WavSection::setSoundStringId(size_t soundIndex, size_t soundStringId)
 {
-    if ( soundIndex < Chk::TotalSounds )
+    if ( soundIndex < Chk::TotalSounds && data->soundPathStringId[soundIndex] != (u32)soundStringId )
+    {
+        auto prevSoundIndexes = soundIndexes.find(data->soundPathStringId[soundIndex]);
+        if ( prevSoundIndexes != soundIndexes.end() )
+        {
+            prevSoundIndexes->second.erase(soundIndex);
+            if ( prevSoundIndexes->second.empty() )
+                soundIndexes.erase(prevSoundIndexes);
+        }
         data->soundPathStringId[soundIndex] = (u32)soundStringId;
+        soundIndexes[(u32)soundStringId].insert(soundIndex);
+    }
 }
 
 void WavSection::appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers) const
 {
-    for ( size_t i=0; i<Chk::TotalSounds; i++ )
+    auto found = soundIndexes.find((u32)stringId);
+    if ( found != soundIndexes.end() && stringId == size_t(found->first) )
     {
-        if ( data->soundPathStringId[i] == stringId )
-            stringUsers.push_back(Chk::StringUser(Chk::StringUserFlag::Sound, i));
+        for ( size_t soundIndex : found->second )
+            stringUsers.push_back(Chk::StringUser(Chk::StringUserFlag::Sound, soundIndex));
     }
 }
 
@@ -3903,32 +4320,51 @@ bool WavSection::stringUsed(size_t stringId) const
 
 void WavSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const
 {
-    for ( size_t i=0; i<Chk::TotalSounds; i++ )
+    for ( auto & stringIdSoundIndexes : soundIndexes )
     {
-        if ( data->soundPathStringId[i] != Chk::StringId::UnusedSound && data->soundPathStringId[i] < Chk::MaxStrings )
-            stringIdUsed[data->soundPathStringId[i]] = true;
+        if ( stringIdSoundIndexes.first != Chk::StringId::UnusedSound && stringIdSoundIndexes.first < Chk::MaxStrings )
+            stringIdUsed[stringIdSoundIndexes.first] = true;
     }
 }
 
-void WavSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void WavSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     for ( size_t i=0; i<Chk::TotalSounds; i++ )
-    {
-        auto found = stringIdRemappings.find(data->soundPathStringId[i]);
-        if ( found != stringIdRemappings.end() )
-            data->soundPathStringId[i] = found->second;
-    }
+        stringIdRemappings.remap(data->soundPathStringId[i]);
+
+    indexSounds();
 }
 
 void WavSection::deleteString(size_t stringId)
 {
-    for ( size_t i=0; i<Chk::TotalSounds; i++ )
+    auto found = soundIndexes.find((u32)stringId);
+    if ( found != soundIndexes.end() && stringId == size_t(found->first) && stringId != Chk::StringId::UnusedSound )
     {
-        if ( data->soundPathStringId[i] == stringId )
-            data->soundPathStringId[i] = 0;
+        std::set<size_t> deletedSoundIndexes;
+        deletedSoundIndexes.swap(found->second);
+        soundIndexes.erase(found);
+        for ( size_t soundIndex : deletedSoundIndexes )
+        {
+            data->soundPathStringId[soundIndex] = Chk::StringId::UnusedSound;
+            soundIndexes[Chk::StringId::UnusedSound].insert(soundIndex);
+        }
     }
 }
 
+std::streamsize WavSection::read(const Chk::SectionHeader & sectionHeader, std::istream & is, bool overrideOrAppend)
+{
+    std::streamsize bytesRead = StructSection<Chk::WAV, true>::read(sectionHeader, is, overrideOrAppend);
+    indexSounds();
+    return bytesRead;
+}
+
+void WavSection::indexSounds()
+{
+    soundIndexes.clear();
+    for ( size_t i=0; i<Chk::TotalSounds; i++ )
+        soundIndexes[data->soundPathStringId[i]].insert(i);
+}
+
 
 UnisSectionPtr UnisSection::GetDefault()
 {
@@ -4153,14 +4589,10 @@ void UnisSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) c
     }
 }
 
-void UnisSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void UnisSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     for ( size_t i=0; i<Sc::Unit::TotalTypes; i++ )
-    {
-        auto found = stringIdRemappings.find(data->nameStringId[i]);
-        if ( found != stringIdRemappings.end() )
-            data->nameStringId[i] = found->second;
-    }
+        stringIdRemappings.remap(data->nameStringId[i]);
 }
 
 void UnisSection::deleteString(size_t stringId)
@@ -4489,14 +4921,10 @@ void SwnmSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) c
     }
 }
 
-void SwnmSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void SwnmSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     for ( size_t i=0; i<Chk::TotalSwitches; i++ )
-    {
-        auto found = stringIdRemappings.find(data->switchName[i]);
-        if ( found != stringIdRemappings.end() )
-            data->switchName[i] = found->second;
-    }
+        stringIdRemappings.remap(data->switchName[i]);
 }
 
 void SwnmSection::deleteString(size_t stringId)
@@ -5066,14 +5494,10 @@ void UnixSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) c
     }
 }
 
-void UnixSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void UnixSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     for ( size_t i=0; i<Sc::Unit::TotalTypes; i++ )
-    {
-        auto found = stringIdRemappings.find(data->nameStringId[i]);
-        if ( found != stringIdRemappings.end() )
-            data->nameStringId[i] = found->second;
-    }
+        stringIdRemappings.remap(data->nameStringId[i]);
 }
 
 void UnixSection::deleteString(size_t stringId)
@@ -5641,67 +6065,28 @@ void OstrSection::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u
     }
 }
 
-void OstrSection::remapStringIds(const std::map<u32, u32> & stringIdRemappings)
+void OstrSection::remapStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
-    auto scenarioNameRemapping = stringIdRemappings.find(data->scenarioName);
-    auto scenarioDescriptionRemapping= stringIdRemappings.find(data->scenarioDescription);
-    auto forceOneRemapping = stringIdRemappings.find(data->forceName[0]);
-    auto forceTwoRemapping = stringIdRemappings.find(data->forceName[1]);
-    auto forceThreeRemapping = stringIdRemappings.find(data->forceName[2]);
-    auto forceFourRemapping = stringIdRemappings.find(data->forceName[3]);
-
-    if ( scenarioNameRemapping != stringIdRemappings.end() )
-        data->scenarioName = scenarioNameRemapping->second;
-
-    if ( scenarioDescriptionRemapping != stringIdRemappings.end() )
-        data->scenarioDescription = scenarioDescriptionRemapping->second;
-    
-    if ( forceOneRemapping != stringIdRemappings.end() )
-        data->forceName[0] = forceOneRemapping->second;
+    stringIdRemappings.remap(data->scenarioName);
+    stringIdRemappings.remap(data->scenarioDescription);
 
-    if ( forceTwoRemapping != stringIdRemappings.end() )
-        data->forceName[1] = forceTwoRemapping->second;
-
-    if ( forceThreeRemapping != stringIdRemappings.end() )
-        data->forceName[2] = forceThreeRemapping->second;
+    for ( size_t i=0; i<Chk::TotalForces; i++ )
+        stringIdRemappings.remap(data->forceName[i]);
 
-    if ( forceFourRemapping != stringIdRemappings.end() )
-        data->forceName[3] = forceFourRemapping->second;
-    
     for ( size_t i=0; i<Sc::Unit::TotalTypes; i++ )
-    {
-        auto found = stringIdRemappings.find(data->unitName[i]);
-        if ( found != stringIdRemappings.end() )
-            data->unitName[i] = found->second;
-    }
+        stringIdRemappings.remap(data->unitName[i]);
 
     for ( size_t i=0; i<Sc::Unit::TotalTypes; i++ )
-    {
-        auto found = stringIdRemappings.find(data->expUnitName[i]);
-        if ( found != stringIdRemappings.end() )
-            data->expUnitName[i] = found->second;
-    }
+        stringIdRemappings.remap(data->expUnitName[i]);
     
     for ( size_t i=0; i<Chk::TotalSounds; i++ )
-    {
-        auto found = stringIdRemappings.find(data->soundPath[i]);
-        if ( found != stringIdRemappings.end() )
-            data->soundPath[i] = found->second;
-    }
+        stringIdRemappings.remap(data->soundPath[i]);
 
     for ( size_t i=0; i<Chk::TotalSwitches; i++ )
-    {
-        auto found = stringIdRemappings.find(data->switchName[i]);
-        if ( found != stringIdRemappings.end() )
-            data->switchName[i] = found->second;
-    }
+        stringIdRemappings.remap(data->switchName[i]);
 
     for ( size_t i=0; i<Chk::TotalLocations; i++ )
-    {
-        auto found = stringIdRemappings.find(data->locationName[i]);
-        if ( found != stringIdRemappings.end() )
-            data->locationName[i] = found->second;
-    }
+        stringIdRemappings.remap(data->locationName[i]);
 }
 
 void OstrSection::deleteString(size_t stringId)
@@ -5755,7 +6140,7 @@ KstrSectionPtr KstrSection::GetDefault()
     return newSection;
 }
 
-KstrSection::KstrSection() : DynamicSection<true>(SectionName::KSTR), version(Chk::KSTR::CurrentVersion)
+KstrSection::KstrSection() : DynamicSection<true>(SectionName::KSTR), version(Chk::KSTR::CurrentVersion), arena(std::make_shared<ScStrArena>()), arenaBytesChecked(0)
 {
 
 }
@@ -5767,9 +6152,9 @@ KstrSection::~KstrSection()
 
 bool KstrSection::empty() const
 {
-    for ( auto & string : strings )
+    for ( u32 strId : strings )
     {
-        if ( string != nullptr )
+        if ( strId != ScStrArena::NoStr )
             return false;
     }
     return true;
@@ -5780,6 +6165,22 @@ size_t KstrSection::getCapacity() const
     return strings.size();
 }
 
+size_t KstrSection::getCharactersAllocated() const
+{
+    return arena->bytesAllocated();
+}
+
+size_t KstrSection::getStoredCharacters() const
+{
+    size_t storedCharacters = 0;
+    for ( size_t stringId=1; stringId<strings.size(); stringId++ )
+    {
+        if ( strings[stringId] != ScStrArena::NoStr )
+            storedCharacters += arena->length(strings[stringId])+1;
+    }
+    return storedCharacters;
+}
+
 size_t KstrSection::getBytesUsed(StrSynchronizerPtr strSynchronizer)
 {
     if ( syncStringsToBytes(strSynchronizer) )
@@ -5792,7 +6193,7 @@ size_t KstrSection::getBytesUsed(StrSynchronizerPtr strSynchronizer)
 
 bool KstrSection::stringStored(size_t stringId) const
 {
-    return stringId < strings.size() && strings[stringId] != nullptr;
+    return stringId < strings.size() && strings[stringId] != ScStrArena::NoStr;
 }
 
 void KstrSection::unmarkUnstoredStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const
@@ -5801,7 +6202,7 @@ void KstrSection::unmarkUnstoredStrings(std::bitset<Chk::MaxStrings> & stringIdU
     size_t stringId = 1;
     for ( ; stringId < limit; ++stringId )
     {
-        if ( stringIdUsed[stringId] && strings[stringId] == nullptr )
+        if ( stringIdUsed[stringId] && strings[stringId] == ScStrArena::NoStr )
             stringIdUsed[stringId] = false;
     }
     for ( ; stringId < Chk::MaxStrings; stringId++ )
@@ -5813,19 +6214,19 @@ void KstrSection::unmarkUnstoredStrings(std::bitset<Chk::MaxStrings> & stringIdU
 
 StrProp KstrSection::getProperties(size_t stringId) const
 {
-    return stringId < strings.size() && strings[stringId] != nullptr ? strings[stringId]->properties() : StrProp();
+    return stringId < strings.size() && strings[stringId] != ScStrArena::NoStr ? stringProperties[stringId] : StrProp();
 }
 
 void KstrSection::setProperties(size_t stringId, const StrProp & strProp)
 {
-    if ( stringId < strings.size() && strings[stringId] != nullptr )
-        strings[stringId]->properties() = strProp;
+    if ( stringId < strings.size() && strings[stringId] != ScStrArena::NoStr )
+        stringProperties[stringId] = strProp;
 }
 
 template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkdString (Editor <01>Style)
 std::shared_ptr<StringType> KstrSection::getString(size_t stringId) const
 {
-    return stringId < strings.size() && strings[stringId] != nullptr ? strings[stringId]->toString<StringType>() : nullptr;
+    return stringId < strings.size() && strings[stringId] != ScStrArena::NoStr ? arenaStrToString<StringType>(*arena, strings[stringId]) : nullptr;
 }
 template std::shared_ptr<RawString> KstrSection::getString<RawString>(size_t stringId) const;
 template std::shared_ptr<EscString> KstrSection::getString<EscString>(size_t stringId) const;
@@ -5835,11 +6236,12 @@ template std::shared_ptr<SingleLineChkdString> KstrSection::getString<SingleLine
 template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
 size_t KstrSection::findString(const StringType & str) const
 {
-    for ( size_t stringId=1; stringId<strings.size(); stringId++ )
-    {
-        if ( strings[stringId] != nullptr && strings[stringId]->compare<StringType>(str) == 0 )
-            return stringId;
-    }
+    RawString rawString;
+    convertStr<StringType, RawString>(str, rawString);
+    u32 strId = arena->find(rawString.c_str(), std::strlen(rawString.c_str()));
+    if ( strId != ScStrArena::NoStr ) // Every string in the section is interned, so any match has the same arena id
+        return stringIndex.find(strId, strings);
+
     return Chk::StringId::NoString;
 }
 template size_t KstrSection::findString<RawString>(const RawString & str) const;
@@ -5876,10 +6278,14 @@ bool KstrSection::setCapacity(size_t stringCapacity, StrSynchronizer & strSynchr
     }
         
     while ( strings.size() < stringCapacity )
-        strings.push_back(nullptr);
+        strings.push_back(ScStrArena::NoStr);
 
     while ( strings.size() > stringCapacity )
+    {
+        stringIndex.remove(strings.size()-1, strings);
         strings.pop_back();
+    }
+    stringProperties.resize(strings.size());
 
     return true;
 }
@@ -5903,7 +6309,14 @@ size_t KstrSection::addString(const StringType & str, StrSynchronizer & strSynch
     else if ( nextUnusedStringId == 0 )
         throw MaximumStringsExceeded();
 
-    strings[nextUnusedStringId] = ScStrPtr(new ScStr(rawString));
+    size_t length = std::strlen(rawString.c_str());
+    stringIndex.remove(nextUnusedStringId, strings);
+    strings[nextUnusedStringId] = arena->intern(rawString.c_str(), length);
+    stringProperties[nextUnusedStringId] = StrProp();
+    stringIndex.add(nextUnusedStringId, strings);
+    if ( compactScStrArena(arena, strings, arenaBytesChecked, false) )
+        stringIndex.clear();
+
     return nextUnusedStringId;
 }
 template size_t KstrSection::addString<RawString>(const RawString & str, StrSynchronizer & strSynchronizer, bool autoDefragment);
@@ -5911,6 +6324,90 @@ template size_t KstrSection::addString<EscString>(const EscString & str, StrSync
 template size_t KstrSection::addString<ChkdString>(const ChkdString & str, StrSynchronizer & strSynchronizer, bool autoDefragment);
 template size_t KstrSection::addString<SingleLineChkdString>(const SingleLineChkdString & str, StrSynchronizer & strSynchronizer, bool autoDefragment);
 
+template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
+std::vector<size_t> KstrSection::addStrings(const std::vector<StringType> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds)
+{
+    // Used strings are marked, existing strings are looked up and capacity is set once for all the strings rather than once per string, nothing is added if this throws
+    std::vector<size_t> stringIds(strs.size(), size_t(Chk::StringId::NoString));
+    if ( strs.empty() )
+        return stringIds;
+
+    std::set<size_t> replacedStringIds; // Stored but unused strings that strings added earlier in this batch take the place of
+    std::bitset<Chk::MaxStrings> stringIdUsed;
+    strSynchronizer.markUsedStrings(stringIdUsed, Chk::Scope::Either, Chk::Scope::Editor);
+    for ( size_t stringId : reservedStringIds )
+    {
+        if ( stringId < Chk::MaxStrings )
+            stringIdUsed[stringId] = true; // In use by something not yet in the scenario
+    }
+    std::deque<RawString> rawStrings; // Holds the characters of the added strings until they're interned, which happens once nothing can throw
+    std::unordered_map<std::string_view, size_t> addedStringIds; // The id of each string added so far
+    std::vector<std::pair<size_t, std::string_view>> addedStrings;
+    size_t nextUnusedStringId = 1;
+    for ( size_t i=0; i<strs.size(); i++ )
+    {
+        RawString rawString;
+        convertStr<StringType, RawString>(strs[i], rawString);
+        size_t length = std::strlen(rawString.c_str());
+        u32 strId = arena->find(rawString.c_str(), length);
+        size_t foundStringId = strId != ScStrArena::NoStr ? stringIndex.find(strId, strings) : (size_t)Chk::StringId::NoString;
+        if ( foundStringId != Chk::StringId::NoString && replacedStringIds.count(foundStringId) > 0 ) // The lowest copy is being replaced, as in findString use the next
+        {
+            size_t replacedStringId = foundStringId;
+            foundStringId = Chk::StringId::NoString;
+            for ( size_t stringId=replacedStringId+1; stringId<strings.size(); stringId++ )
+            {
+                if ( strings[stringId] == strId && replacedStringIds.count(stringId) == 0 )
+                {
+                    foundStringId = stringId;
+                    break;
+                }
+            }
+        }
+        auto added = addedStringIds.find(std::string_view(rawString.c_str(), length));
+        if ( foundStringId != Chk::StringId::NoString )
+            stringIds[i] = foundStringId; // String already exists
+        else if ( added != addedStringIds.end() )
+            stringIds[i] = added->second; // String was added earlier in this batch
+        else
+        {
+            nextUnusedStringId = getNextUnusedStringId(stringIdUsed, true, nextUnusedStringId);
+            if ( nextUnusedStringId == 0 )
+                throw MaximumStringsExceeded();
+
+            if ( nextUnusedStringId < strings.size() && strings[nextUnusedStringId] != ScStrArena::NoStr ) // Replacing a stored but unused string
+                replacedStringIds.insert(nextUnusedStringId);
+
+            rawStrings.push_back(std::move(rawString));
+            std::string_view addedString(rawStrings.back().c_str(), length);
+            addedStringIds.insert(std::pair<std::string_view, size_t>(addedString, nextUnusedStringId));
+            addedStrings.push_back(std::pair<size_t, std::string_view>(nextUnusedStringId, addedString));
+            stringIds[i] = nextUnusedStringId;
+        }
+        stringIdUsed[stringIds[i]] = true; // The string is put to use before the next is added
+    }
+
+    if ( !addedStrings.empty() && addedStrings.back().first >= strings.size() )
+        setCapacity(addedStrings.back().first+1, strSynchronizer, autoDefragment);
+
+    for ( auto & addedString : addedStrings )
+    {
+        stringIndex.remove(addedString.first, strings);
+        strings[addedString.first] = arena->intern(addedString.second.data(), addedString.second.size());
+        stringProperties[addedString.first] = StrProp();
+        stringIndex.add(addedString.first, strings);
+    }
+
+    if ( compactScStrArena(arena, strings, arenaBytesChecked, false) )
+        stringIndex.clear();
+
+    return stringIds;
+}
+template std::vector<size_t> KstrSection::addStrings<RawString>(const std::vector<RawString> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> KstrSection::addStrings<EscString>(const std::vector<EscString> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> KstrSection::addStrings<ChkdString>(const std::vector<ChkdString> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+template std::vector<size_t> KstrSection::addStrings<SingleLineChkdString>(const std::vector<SingleLineChkdString> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment, const std::vector<size_t> & reservedStringIds);
+
 template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
 void KstrSection::replaceString(size_t stringId, const StringType & str)
 {
@@ -5918,22 +6415,59 @@ void KstrSection::replaceString(size_t stringId, const StringType & str)
     convertStr<StringType, RawString>(str, rawString);
 
     if ( stringId < strings.size() )
-        strings[stringId] = ScStrPtr(new ScStr(rawString, StrProp()));
+    {
+        size_t length = std::strlen(rawString.c_str());
+        stringIndex.remove(stringId, strings);
+        strings[stringId] = arena->intern(rawString.c_str(), length);
+        stringProperties[stringId] = StrProp();
+        stringIndex.add(stringId, strings);
+        if ( compactScStrArena(arena, strings, arenaBytesChecked, false) )
+            stringIndex.clear();
+    }
 }
 template void KstrSection::replaceString<RawString>(size_t stringId, const RawString & str);
 template void KstrSection::replaceString<EscString>(size_t stringId, const EscString & str);
 template void KstrSection::replaceString<ChkdString>(size_t stringId, const ChkdString & str);
 template void KstrSection::replaceString<SingleLineChkdString>(size_t stringId, const SingleLineChkdString & str);
 
+template <typename StringType>
+void KstrSection::replaceStrings(const std::vector<std::pair<size_t, StringType>> & replacements)
+{
+    bool replaced = false;
+    for ( const auto & replacement : replacements )
+    {
+        size_t stringId = replacement.first;
+        if ( stringId < strings.size() )
+        {
+            RawString rawString;
+            convertStr<StringType, RawString>(replacement.second, rawString);
+            size_t length = std::strlen(rawString.c_str());
+            stringIndex.remove(stringId, strings);
+            strings[stringId] = arena->intern(rawString.c_str(), length);
+            stringProperties[stringId] = StrProp();
+            stringIndex.add(stringId, strings);
+            replaced = true;
+        }
+    }
+    if ( replaced && compactScStrArena(arena, strings, arenaBytesChecked, false) ) // Moves the strings to a new arena at most once for the batch
+        stringIndex.clear();
+}
+template void KstrSection::replaceStrings<RawString>(const std::vector<std::pair<size_t, RawString>> & replacements);
+template void KstrSection::replaceStrings<EscString>(const std::vector<std::pair<size_t, EscString>> & replacements);
+template void KstrSection::replaceStrings<ChkdString>(const std::vector<std::pair<size_t, ChkdString>> & replacements);
+template void KstrSection::replaceStrings<SingleLineChkdString>(const std::vector<std::pair<size_t, SingleLineChkdString>> & replacements);
+
 void KstrSection::deleteUnusedStrings(StrSynchronizer & strSynchronizer)
 {
     std::bitset<65536> stringIdUsed;
     strSynchronizer.markUsedStrings(stringIdUsed, Chk::Scope::Either, Chk::Scope::Editor);
     for ( size_t i=0; i<strings.size(); i++ )
     {
-        if ( !stringIdUsed[i] && strings[i] != nullptr )
-            strings[i] = nullptr;
+        if ( !stringIdUsed[i] && strings[i] != ScStrArena::NoStr )
+            strings[i] = ScStrArena::NoStr;
     }
+    compactScStrArena(arena, strings, arenaBytesChecked, true);
+    stringIndex.clear();
 }
 
 bool KstrSection::deleteString(size_t stringId, bool deleteOnlyIfUnused, StrSynchronizerPtr strSynchronizer)
@@ -5942,7 +6476,8 @@ bool KstrSection::deleteString(size_t stringId, bool deleteOnlyIfUnused, StrSync
     {
         if ( stringId < strings.size() )
         {
-            strings[stringId] = nullptr;
+            stringIndex.remove(stringId, strings);
+            strings[stringId] = ScStrArena::NoStr;
             return true;
         }
     }
@@ -5957,9 +6492,10 @@ void KstrSection::moveString(size_t stringIdFrom, size_t stringIdTo, StrSynchron
     {
         std::bitset<Chk::MaxStrings> stringIdUsed;
         strSynchronizer.markUsedStrings(stringIdUsed, Chk::Scope::Editor);
-        ScStrPtr selected = strings[stringIdFrom];
+        u32 selected = strings[stringIdFrom];
+        StrProp selectedProperties = stringProperties[stringIdFrom];
         stringIdUsed[stringIdFrom] = false;
-        std::map<u32, u32> stringIdRemappings;
+        Chk::StringIdRemappings stringIdRemappings;
         if ( stringIdTo < stringIdFrom ) // Move to a lower stringId, if there are strings in the way, cascade towards stringIdFrom
         {
             while ( stringIdUsed[stringIdTo] ) // There is a block of one or more strings where the selected string needs to go
@@ -5968,17 +6504,17 @@ void KstrSection::moveString(size_t stringIdFrom, size_t stringIdTo, StrSynchron
                 {
                     if ( !stringIdUsed[stringId] ) // Move the highest stringId remaining in the block to the next available stringId
                     {
-                        ScStrPtr highestString = strings[stringId-1];
-                        strings[stringId-1] = nullptr;
+                        u32 highestString = strings[stringId-1];
+                        strings[stringId-1] = ScStrArena::NoStr;
                         stringIdUsed[stringId-1] = false;
                         strings[stringId] = highestString;
+                        stringProperties[stringId] = stringProperties[stringId-1];
                         stringIdUsed[stringId] = true;
-                        stringIdRemappings.insert(std::pair<u32, u32>(u32(stringId-1), (u32)stringId));
+                        stringIdRemappings.set(stringId-1, stringId);
                         break;
                     }
                 }
             }
-            stringIdRemappings.insert(std::pair<u32, u32>((u32)stringIdFrom, (u32)stringIdTo));
         }
         else if ( stringIdTo > stringIdFrom ) // Move to a higher stringId, if there are strings in the way, cascade towards stringIdTo
         {
@@ -5988,19 +6524,22 @@ void KstrSection::moveString(size_t stringIdFrom, size_t stringIdTo, StrSynchron
                 {
                     if ( !stringIdUsed[stringId] ) // Move the lowest stringId in the block to the available stringId
                     {
-                        ScStrPtr lowestString = strings[stringId+1];
-                        strings[stringId+1] = nullptr;
+                        u32 lowestString = strings[stringId+1];
+                        strings[stringId+1] = ScStrArena::NoStr;
                         stringIdUsed[stringId+1] = false;
                         strings[stringId] = lowestString;
+                        stringProperties[stringId] = stringProperties[stringId+1];
                         stringIdUsed[stringId] = true;
-                        stringIdRemappings.insert(std::pair<u32, u32>(u32(stringId+1), (u32)stringId));
+                        stringIdRemappings.set(stringId+1, stringId);
                         break;
                     }
                 }
             }
         }
         strings[stringIdTo] = selected;
-        stringIdRemappings.insert(std::pair<u32, u32>((u32)stringIdFrom, (u32)stringIdTo));
+        stringProperties[stringIdTo] = selectedProperties;
+        stringIndex.clear();
+        stringIdRemappings.set(stringIdFrom, stringIdTo);
         strSynchronizer.remapStringIds(stringIdRemappings, Chk::Scope::Editor);
     }
 }
@@ -6011,7 +6550,7 @@ bool KstrSection::checkFit(StrSynchronizer & strSynchronizer, StrCompressionElev
         return false;
 
     try {
-        strSynchronizer.syncKstringsToBytes(strings, stringBytes, compressionElevator);
+        strSynchronizer.syncKstringsToBytes(*arena, strings, stringProperties, stringBytes, compressionElevator);
         return true;
     } catch ( std::exception & ) {
         return false;
@@ -6022,23 +6561,28 @@ bool KstrSection::defragment(StrSynchronizer & strSynchronizer, bool matchCapaci
 {
     size_t nextCandidateStringId = 0;
     size_t numStrings = strings.size();
-    std::map<u32, u32> stringIdRemappings;
-    for ( size_t i=0; i<numStrings; i++ )
+    Chk::StringIdRemappings stringIdRemappings;
+    for ( size_t i=1; i<numStrings; i++ ) // stringId:0 is never used
     {
-        if ( strings[i] == nullptr )
+        if ( strings[i] == ScStrArena::NoStr )
         {
             for ( size_t j = std::max(i+1, nextCandidateStringId); j < numStrings; j++ )
             {
-                if ( strings[j] != nullptr )
+                if ( strings[j] != ScStrArena::NoStr )
                 {
                     strings[i] = strings[j];
-                    stringIdRemappings.insert(std::pair<u32, u32>((u32)j, (u32)i));
+                    stringProperties[i] = stringProperties[j];
+                    strings[j] = ScStrArena::NoStr;
+                    stringIdRemappings.set(j, i);
+                    nextCandidateStringId = j+1;
                     break;
                 }
             }
         }
     }
 
+    compactScStrArena(arena, strings, arenaBytesChecked, true);
+    stringIndex.clear();
     if ( !stringIdRemappings.empty() )
     {
         strSynchronizer.remapStringIds(stringIdRemappings, Chk::Scope::Editor);
@@ -6090,6 +6634,8 @@ std::streamsize KstrSection::read(const Chk::SectionHeader & sectionHeader, std:
     {
         stringBytes.clear();
         strings.clear();
+        stringProperties.clear();
+        stringIndex.clear();
     }
     return 0;
 }
@@ -6135,14 +6681,14 @@ bool KstrSection::stringsMatchBytes() const
 
     for ( size_t stringId = 1; stringId<strings.size(); ++stringId )
     {
-        ScStrPtr scStr = strings[stringId];
-        if ( scStr != nullptr )
+        u32 strId = strings[stringId];
+        if ( strId != ScStrArena::NoStr )
         {
             size_t offsetPos = sizeof(u32)*stringId;
             if ( offsetPos+1 < numBytes )
             {
                 u32 stringOffset = (u32 &)stringBytes[offsetPos];
-                if ( size_t(stringOffset)+scStr->length() > numBytes || std::memcmp(scStr->str, &stringBytes[stringOffset], scStr->length()) != 0 )
+                if ( size_t(stringOffset)+arena->length(strId) > numBytes || std::memcmp(arena->str(strId), &stringBytes[stringOffset], arena->length(strId)) != 0 )
                     return false; // String out of bounds or not equal
             }
             else // String offset out of bounds
@@ -6160,7 +6706,7 @@ bool KstrSection::syncStringsToBytes(ScenarioSaver & scenarioSaver)
 bool KstrSection::syncStringsToBytes(StrSynchronizerPtr strSynchronizer)
 {
     if ( strSynchronizer != nullptr )
-        strSynchronizer->syncKstringsToBytes(strings, stringBytes);
+        strSynchronizer->syncKstringsToBytes(*arena, strings, stringProperties, stringBytes);
     else
     {
         constexpr size_t maxStrings = (size_t(s32_max) - 2*sizeof(u32))/sizeof(u32);
@@ -6173,8 +6719,8 @@ bool KstrSection::syncStringsToBytes(StrSynchronizerPtr strSynchronizer)
         size_t sectionSize = versionAndSizeAndOffsetAndStringPropertiesAndNulSpace;
         for ( size_t i=1; i<=numStrings; i++ )
         {
-            if ( strings[i] != nullptr )
-                sectionSize += strings[i]->length();
+            if ( strings[i] != ScStrArena::NoStr )
+                sectionSize += arena->length(strings[i]);
         }
 
         constexpr size_t maxStandardSize = s32_max;
@@ -6188,14 +6734,14 @@ bool KstrSection::syncStringsToBytes(StrSynchronizerPtr strSynchronizer)
         stringBytes.push_back(u8('\0')); // Add initial NUL character
         for ( size_t i=1; i<=numStrings; i++ )
         {
-            if ( strings[i] == nullptr )
+            if ( strings[i] == ScStrArena::NoStr )
                 (u32 &)stringBytes[sizeof(u32)*i] = initialNulOffset;
             else
             {
-                auto prop = strings[i]->properties();
+                const StrProp & prop = stringProperties[i];
                 (u32 &)stringBytes[stringPropertiesStart+sizeof(u32)*i] = (u32 &)Chk::StringProperties(prop.red, prop.green, prop.blue, prop.isUsed, prop.hasPriority, prop.isBold, prop.isUnderlined, prop.isItalics, prop.size);
                 (u32 &)stringBytes[sizeof(u32)+sizeof(u32)*i] = u32(stringBytes.size());
-                stringBytes.insert(stringBytes.end(), strings[i]->str, strings[i]->str+strings[i]->length()+1);
+                stringBytes.insert(stringBytes.end(), arena->str(strings[i]), arena->str(strings[i])+arena->length(strings[i])+1);
             }
         }
     }
@@ -6231,20 +6777,19 @@ void KstrSection::syncBytesToStrings()
     size_t highestStringWithValidProperties = std::min(size_t(rawNumStrings), numBytes < 12 ? 0 : (numBytes-8)/8);
     size_t propertiesStartMinusFour = sizeof(u32)+sizeof(u32)*rawNumStrings;
     strings.clear();
-    strings.push_back(nullptr); // Fill the non-existant 0th stringId
+    stringIndex.clear();
+    strings.push_back(ScStrArena::NoStr); // Fill the non-existant 0th stringId
+    arena = std::make_shared<ScStrArena>(); // Strings are interned in place within one copy of the section's bytes
+    const char* sectionCharacters = arena->copy(numBytes > 0 ? &stringBytes[0] : nullptr, numBytes);
+    arena->reserve(highestStringWithValidOffset+1);
+    arenaBytesChecked = arena->bytesAllocated();
 
     size_t stringId = 1;
     for ( ; stringId <= highestStringWithValidOffset; ++stringId )
     {
         size_t offsetPos = sizeof(u32)+sizeof(u32)*stringId;
         size_t stringOffset = size_t((u32 &)stringBytes[offsetPos]);
-        loadString(stringOffset, numBytes);
-        if ( stringId <= highestStringWithValidProperties && strings[stringId] != nullptr )
-        {
-            size_t propertiesPos = propertiesStartMinusFour + sizeof(u32)*stringId;
-            Chk::StringProperties properties = (Chk::StringProperties &)stringBytes[propertiesPos];
-            strings[stringId]->properties() = StrProp(properties);
-        }
+        loadString(sectionCharacters, stringOffset, numBytes);
     }
     if ( highestStringWithValidOffset < size_t(rawNumStrings) ) // Some offsets aren't within bounds
     {
@@ -6253,45 +6798,46 @@ void KstrSection::syncBytesToStrings()
             stringId ++;
             u8 paddedTriplet[4] = { stringBytes[numBytes-3], stringBytes[numBytes-2], stringBytes[numBytes-1], u8(0) };
             size_t stringOffset = size_t((u32 &)paddedTriplet[0]);
-            loadString(stringOffset, numBytes);
+            loadString(sectionCharacters, stringOffset, numBytes);
         }
         else if ( numBytes % 4 == 2 ) // Can read two bytes of an offset
         {
             stringId ++;
             size_t stringOffset = size_t((u16 &)stringBytes[numBytes]);
-            loadString(stringOffset, numBytes);
+            loadString(sectionCharacters, stringOffset, numBytes);
         }
         else if ( numBytes % 4 == 1 ) // Can read one byte of an offset
         {
             stringId ++;
             size_t stringOffset = size_t(stringBytes[sizeof(u32)*highestStringWithValidOffset]);
-            loadString(stringOffset, numBytes);
+            loadString(sectionCharacters, stringOffset, numBytes);
         }
         for ( ; stringId <= size_t(rawNumStrings); ++stringId ) // Any remaining strings are fully out of bounds
-            strings.push_back(nullptr);
+            strings.push_back(ScStrArena::NoStr);
+    }
+
+    stringProperties.assign(strings.size(), StrProp());
+    for ( stringId = 1; stringId <= highestStringWithValidProperties && stringId <= highestStringWithValidOffset; ++stringId )
+    {
+        if ( strings[stringId] != ScStrArena::NoStr )
+        {
+            size_t propertiesPos = propertiesStartMinusFour + sizeof(u32)*stringId;
+            Chk::StringProperties properties = (Chk::StringProperties &)stringBytes[propertiesPos];
+            stringProperties[stringId] = StrProp(properties);
+        }
     }
 }
 
-void KstrSection::loadString(const size_t & stringOffset, const size_t & sectionSize)
+void KstrSection::loadString(const char* sectionCharacters, const size_t & stringOffset, const size_t & sectionSize)
 {
     if ( stringOffset < sectionSize )
     {
         auto nextNull = std::find(stringBytes.begin()+stringOffset, stringBytes.end(), u8('\0'));
-        if ( nextNull != stringBytes.end() )
-        {
-            auto nullIndex = std::distance(stringBytes.begin(), nextNull);
-            if ( size_t(nullIndex) >= stringOffset ) // Regular string
-                strings.push_back(ScStrPtr(new ScStr(std::string((const char*)&stringBytes[stringOffset]))));
-            else // String ends where section ends
-                strings.push_back(ScStrPtr(new ScStr(std::string((const char*)&stringBytes[stringOffset], sectionSize-stringOffset))));
-        }
-        else if ( sectionSize > stringOffset ) // String ends where section ends
-            strings.push_back(ScStrPtr(new ScStr(std::string((const char*)&stringBytes[stringOffset], sectionSize-stringOffset))));
-        else // Character data would be out of bounds
-            strings.push_back(nullptr);
+        size_t length = nextNull != stringBytes.end() ? size_t(std::distance(stringBytes.begin(), nextNull))-stringOffset : sectionSize-stringOffset; // Strings without a NUL end where the section ends
+        strings.push_back(arena->internInPlace(&sectionCharacters[stringOffset], length)); // The copied section is followed by a NUL
     }
     else // Offset is out of bounds
-        strings.push_back(nullptr);
+        strings.push_back(ScStrArena::NoStr);
 }
 
 KtrgSectionPtr KtrgSection::GetDefault()
@@ -6340,9 +6886,11 @@ size_t KtrgSection::addExtendedTrigger(std::shared_ptr<Chk::ExtendedTrigData> ex
 {
     if ( extendedTrigger != nullptr )
     {
-        for ( size_t i=0; i<extendedTrigData.size(); i++ )
+        while ( !freeIndexes.empty() )
         {
-            if ( extendedTrigData[i] == nullptr && (i & Chk::UnusedExtendedTrigDataIndexCheck) != 0 ) // If index is unused and usable
+            size_t i = freeIndexes.top();
+            freeIndexes.pop();
+            if ( i < extendedTrigData.size() && extendedTrigData[i] == nullptr ) // If index is still unused
             {
                 extendedTrigData[i] = extendedTrigger;
                 return i;
@@ -6362,7 +6910,11 @@ void KtrgSection::deleteExtendedTrigger(size_t extendedTriggerIndex)
 {
     if ( extendedTriggerIndex < extendedTrigData.size() )
     {
-        extendedTrigData[extendedTriggerIndex] = nullptr;
+        if ( extendedTrigData[extendedTriggerIndex] != nullptr )
+        {
+            extendedTrigData[extendedTriggerIndex] = nullptr;
+            freeIndexes.push(extendedTriggerIndex);
+        }
         cleanTail();
     }
 }
@@ -6418,19 +6970,14 @@ void KtrgSection::markUsedEditorStrings(std::bitset<Chk::MaxStrings> & stringIdU
     }
 }
 
-void KtrgSection::remapEditorStringIds(const std::map<u32, u32> & stringIdRemappings)
+void KtrgSection::remapEditorStringIds(const Chk::StringIdRemappings & stringIdRemappings)
 {
     for ( const auto & extendedTrig : extendedTrigData )
     {
         if ( extendedTrig != nullptr )
         {
-            auto replacement = stringIdRemappings.find(extendedTrig->commentStringId);
-            if ( replacement != stringIdRemappings.end() )
-                extendedTrig->commentStringId = replacement->second;
-
-            replacement = stringIdRemappings.find(extendedTrig->notesStringId);
-            if ( replacement != stringIdRemappings.end() )
-                extendedTrig->notesStringId = replacement->second;
+            stringIdRemappings.remap(extendedTrig->commentStringId);
+            stringIdRemappings.remap(extendedTrig->notesStringId);
         }
     }
 }
@@ -6505,7 +7052,10 @@ void KtrgSection::cleanTail()
     for ( ; i > 0 && (((i-1) & Chk::UnusedExtendedTrigDataIndexCheck) == 0 || extendedTrigData[i-1] == nullptr); i-- );
 
     if ( i == 0 )
+    {
         extendedTrigData.clear();
+        freeIndexes = decltype(freeIndexes)();
+    }
     else if ( i < extendedTrigData.size() )
     {
         auto firstErased = std::next(extendedTrigData.begin(), i);
@@ -6536,7 +7086,7 @@ bool KtgpSection::empty() const
 
 Chk::SectionSize KtgpSection::getSize(ScenarioSaver & scenarioSaver)
 {
-    Chk::SectionSize totalSize = Chk::SectionSize(triggerGroups.size()*sizeof(Chk::TriggerGroupHeader));
+    Chk::SectionSize totalSize = Chk::SectionSize(2*sizeof(u32) + triggerGroups.size()*sizeof(Chk::TriggerGroupHeader)); // Version, numGroups and headers
     for ( Chk::TriggerGroupPtr & triggerGroup : triggerGroups )
         totalSize += Chk::SectionSize(4*triggerGroup->extendedTrigDataIndexes.size() + 4*triggerGroup->groupIndexes.size());
 
@@ -6625,7 +7175,8 @@ void KtgpSection::write(std::ostream & os, ScenarioSaver & scenarioSaver)
         header.commentStringId = triggerGroup->commentStringId;
         header.notesStringId = triggerGroup->notesStringId;
         header.parentGroupId = triggerGroup->parentGroupId;
-        header.bodyOffset = u32(numGroups*sizeof(Chk::TriggerGroupHeader)+bodyData.size());
+        header.bodyOffset = u32(2*sizeof(u32) + numGroups*sizeof(Chk::TriggerGroupHeader) + 4*bodyData.size());
+        headers.push_back(header);
 
         for ( const u32 & extendedTrigDataIndex : triggerGroup->extendedTrigDataIndexes )
             bodyData.push_back(extendedTrigDataIndex);
@@ -6636,8 +7187,10 @@ void KtgpSection::write(std::ostream & os, ScenarioSaver & scenarioSaver)
 
     os.write((const char*)&version, sizeof(u32));
     os.write((const char*)&numGroups, sizeof(u32));
-    os.write((const char*)&headers[0], headers.size()*sizeof(Chk::TriggerGroupHeader));
-    os.write((const char*)&bodyData[0], bodyData.size()*sizeof(u32));
+    if ( !headers.empty() )
+        os.write((const char*)&headers[0], headers.size()*sizeof(Chk::TriggerGroupHeader));
+    if ( !bodyData.empty() )
+        os.write((const char*)&bodyData[0], bodyData.size()*sizeof(u32));
 }
 
 ScenarioSaver & ScenarioSaver::GetDefault()
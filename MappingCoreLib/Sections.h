@@ -6,6 +6,11 @@
 #include <string>
 #include <deque>
 #include <bitset>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <set>
+#include <unordered_map>
 #include <vector>
 using Chk::SectionName;
 
@@ -60,6 +65,7 @@ typedef std::shared_ptr<KtgpSection> KtgpSectionPtr;
 
 
 class StrProp;
+class ScStrArena;
 class ScStr;
 class StrCompressionElevator;
 class StringException;
@@ -74,6 +80,7 @@ class StrSerializationFailure;
 using StrCompressionElevatorPtr = std::shared_ptr<StrCompressionElevator>;
 using StrSynchronizerPtr = std::shared_ptr<StrSynchronizer>;
 using ScenarioSaverPtr = std::shared_ptr<ScenarioSaver>;
+using ScStrArenaPtr = std::shared_ptr<ScStrArena>;
 using ScStrPtr = std::shared_ptr<ScStr>;
 
 enum_t(SectionIndex, u32, { // The index at which a section appears in the default scenario file (plus indexes for extended sections), this is not related to section names
@@ -269,6 +276,7 @@ class StructSection : public ChkSection
             else
                 rawData.assign(size_t(sectionHeader.sizeInBytes), u8(0));
 
+            data = (StructType*)&rawData[0]; // rawData may have been reallocated
             is.read((char*)&rawData[0], (std::streamsize)sectionHeader.sizeInBytes);
             return (Chk::SectionSize)is.gcount();
         }
@@ -437,6 +445,7 @@ class MtxmSection : public DynamicSection<false>
         MtxmSection();
         virtual ~MtxmSection();
 
+        size_t numTiles() const;
         u16 getTile(size_t tileIndex) const;
         void setTile(size_t tileIndex, u16 tileValue);
         void setDimensions(u16 newTileWidth, u16 newTileHeight, u16 oldTileWidth, u16 oldTileHeight, s32 leftEdge = 0, s32 topEdge = 0);
@@ -537,6 +546,7 @@ class IsomSection : public DynamicSection<true>
         IsomSection();
         virtual ~IsomSection();
         
+        size_t numIsomEntries() const;
         Chk::IsomEntry & getIsomEntry(size_t isomIndex);
         const Chk::IsomEntry & getIsomEntry(size_t isomIndex) const;
         void setDimensions(u16 newTileWidth, u16 newTileHeight, u16 oldTileWidth, u16 oldTileHeight, s32 leftEdge = 0, s32 topEdge = 0);
@@ -557,6 +567,7 @@ class TileSection : public DynamicSection<true>
         TileSection();
         virtual ~TileSection();
 
+        size_t numTiles() const;
         u16 getTile(size_t tileIndex) const;
         void setTile(size_t tileIndex, u16 tileValue);
         void setDimensions(u16 newTileWidth, u16 newTileHeight, u16 oldTileWidth, u16 oldTileHeight, s32 leftEdge = 0, s32 topEdge = 0);
@@ -638,6 +649,29 @@ class MaskSection : public DynamicSection<true>
         std::vector<u8> fogTiles;
 };
 
+/**
+    Indexes the stored strings of a string section by their arena ids, so finding the id of a string is a lookup rather than a pass over
+    every string; the index is built by the first find after it's cleared and kept up to date by add and remove, which the section calls
+    around each change to a single string and replaces with clear when strings are moved in bulk or moved to a new arena
+*/
+class ScStrIndex
+{
+    public:
+        size_t find(u32 strId, const std::vector<u32> & strings); // Gets the lowest id storing the arena string strId, or 0 if none do
+        void add(size_t stringId, const std::vector<u32> & strings); // Call after a string is stored at stringId
+        void remove(size_t stringId, const std::vector<u32> & strings); // Call before the string stored at stringId is replaced or deleted
+        void clear(); // Call after strings are moved, swapped or moved to a new arena; the index is rebuilt by the next find
+
+    private:
+        struct Ids {
+            size_t lowestId;
+            size_t count; // The number of ids storing the same arena string, zero if none do
+        };
+
+        std::vector<Ids> ids; // Indexed by arena id
+        bool indexed = false;
+};
+
 class StrSection : public DynamicSection<false>
 {
     public:
@@ -647,6 +681,8 @@ class StrSection : public DynamicSection<false>
         virtual ~StrSection();
 
         size_t getCapacity() const;
+        size_t getCharactersAllocated() const; // The size of the arena holding the characters, including characters of replaced or deleted strings not yet released
+        size_t getStoredCharacters() const; // The characters of the stored strings plus a NUL terminator for each, as the strings are written without compression
         size_t getBytesUsed(StrSynchronizerPtr strSynchronizer = nullptr, StrCompressionElevatorPtr compressionElevator = StrCompressionElevatorPtr());
 
         bool stringStored(size_t stringId) const;
@@ -663,9 +699,16 @@ class StrSection : public DynamicSection<false>
         template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
         size_t addString(const StringType & str, StrSynchronizer & strSynchronizer, bool autoDefragment = true);
 
+        template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
+        std::vector<size_t> addStrings(const std::vector<StringType> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment = true,
+            const std::vector<size_t> & reservedStringIds = {}); // Gets the ids addString would give were each string put to use before the next is added, reserved ids are treated as used
+
         template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
         void replaceString(size_t stringId, const StringType & str);
 
+        template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
+        void replaceStrings(const std::vector<std::pair<size_t, StringType>> & replacements); // Same as replaceString for each replacement in order, checking for unused characters once
+
         void deleteUnusedStrings(StrSynchronizer & strSynchronizer);
         bool deleteString(size_t stringId, bool deleteOnlyIfUnused = true, StrSynchronizerPtr strSynchronizer = nullptr); // strSynchronizer required for deletion if deleteOnlyIfUnused is set
         void moveString(size_t stringIdFrom, size_t stringIdTo, StrSynchronizer & strSynchronizer);
@@ -689,7 +732,10 @@ class StrSection : public DynamicSection<false>
         virtual void write(std::ostream & os, ScenarioSaver & scenarioSaver = ScenarioSaver::GetDefault()); // Writes exactly sizeInBytes bytes to the output stream
 
     private:
-        std::deque<ScStrPtr> strings;
+        ScStrArenaPtr arena; // Holds the characters of the stored strings
+        size_t arenaBytesChecked; // The size of the arena when it was last checked for unused characters
+        std::vector<u32> strings; // The arena id of the string stored at each string id, or ScStrArena::NoStr if none is
+        mutable ScStrIndex stringIndex; // The ids of strings by their arena ids, used by findString
         std::vector<u8> stringBytes;
 
         size_t bytePaddedTo; // If 2, or 4, it's padded to the nearest 2 or 4 byte boundary; no other value has any effect; 4 by default, 0 if "read" is called and any tailData is found
@@ -697,14 +743,12 @@ class StrSection : public DynamicSection<false>
         std::vector<u8> tailData; // Any data that comes after the regular STR section data, and after any padding
         
         size_t getNextUnusedStringId(std::bitset<Chk::MaxStrings> & stringIdUsed, bool checkBeyondCapacity = true, size_t firstChecked = 1) const;
-        void resolveParantage();
-        void resolveParantage(ScStrPtr string);
 
         bool stringsMatchBytes() const; // Check whether every string in strings matches a string in stringBytes
         bool syncStringsToBytes(ScenarioSaver & scenarioSaver = ScenarioSaver::GetDefault()); // Default string write method (staredit-like, no compression applied)
         bool syncStringsToBytes(StrSynchronizerPtr strSynchronizer = nullptr); // Default string write method (staredit-like, no compression applied)
         void syncBytesToStrings(); // Universal string reader method
-        size_t loadString(const size_t & stringOffset, const size_t & sectionSize); // Returns position of last character in the string (usually position of NUL terminator) if loaded, 0 otherwise
+        size_t loadString(const char* sectionCharacters, const size_t & stringOffset, const size_t & sectionSize); // Returns position of last character in the string (usually position of NUL terminator) if loaded, 0 otherwise
 };
 
 class UprpSection : public StructSection<Chk::UPRP, false>
@@ -752,12 +796,14 @@ class MrgnSection : public DynamicSection<false>
         
         bool locationsFitOriginal(LocationSynchronizer & locationSynchronizer, bool lockAnywhere = true, bool autoDefragment = true) const; // Checks if all locations fit in indexes < Chk::TotalOriginalLocations
         bool trimToOriginal(LocationSynchronizer & locationSynchronizer, bool lockAnywhere = true, bool autoDefragment = true); // If possible, trims locations to indexes < Chk::TotalOriginalLocations
-        
+        size_t planTrimToOriginal(LocationSynchronizer & locationSynchronizer, Chk::LocationIdRemappings & locationIdRemappings, bool lockAnywhere = true) const; // Gets the number of locations used or created and, if they fit, the moves trimming them would make
+        void trimToOriginal(LocationSynchronizer & locationSynchronizer, const Chk::LocationIdRemappings & locationIdRemappings); // Trims locations to indexes < Chk::TotalOriginalLocations, making the moves from planTrimToOriginal
+
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers) const;
         bool stringUsed(size_t stringId) const;
         void markNonZeroLocations(std::bitset<Chk::TotalLocations+1> & locationIdUsed) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 
     protected:
@@ -769,6 +815,49 @@ class MrgnSection : public DynamicSection<false>
         std::deque<std::shared_ptr<Chk::Location>> locations;
 };
 
+/**
+    The triggers of a TRIG or MBRF section
+
+    Triggers read from a map are kept as raw records in one contiguous buffer, a trigger is only copied to its own allocation when it's
+    gotten as a TriggerPtr (which may then be changed through), so no trigger handed out keeps the buffer or any other trigger alive;
+    scans and re-serialization work from the raw records, and each run of raw records still in their read order is written at once.
+    The buffer is released once every trigger read into it has been gotten or removed
+*/
+class TriggerRecords
+{
+    public:
+        TriggerRecords();
+        virtual ~TriggerRecords();
+
+        size_t size() const;
+        const Chk::Trigger* read(size_t triggerIndex) const; // Gets the trigger for reading without copying it, valid until the records change or a trigger is gotten; several threads may read at once
+        Chk::Trigger* change(size_t triggerIndex); // Gets the trigger for changing in place without copying it, valid until the records change or a trigger is gotten
+        Chk::TriggerPtr get(size_t triggerIndex) const; // Gets the trigger, copying it from its raw record to its own allocation if needed; not safe while other threads read the records
+        void push_back(Chk::TriggerPtr trigger);
+        void insert(size_t triggerIndex, Chk::TriggerPtr trigger);
+        void erase(size_t triggerIndex);
+        void move(size_t triggerIndexFrom, size_t triggerIndexTo);
+        std::deque<Chk::TriggerPtr> replaceRange(size_t beginIndex, size_t endIndex, std::deque<Chk::TriggerPtr> & triggers); // Gets the replaced triggers
+        void clear();
+
+        std::streamsize readRaw(std::istream & is, size_t readSize); // Appends readSize bytes of raw records with a single read, a partial last record is zero past the part read
+        void writeRaw(std::ostream & os) const;
+
+    private:
+        static constexpr size_t NotRaw = std::numeric_limits<size_t>::max();
+
+        struct Record {
+            Chk::TriggerPtr trigger; // The trigger's own allocation, used if rawIndex is NotRaw
+            size_t rawIndex; // The index of the trigger's raw record in rawTriggers, or NotRaw
+        };
+
+        mutable std::vector<Chk::Trigger> rawTriggers;
+        mutable std::deque<Record> records;
+        mutable size_t numRawRecords; // The number of records still using rawTriggers
+
+        void releaseRaw(size_t numReleased) const; // Releases rawTriggers once no record uses it
+};
+
 class TrigSection : public DynamicSection<false>
 {
     public:
@@ -778,7 +867,8 @@ class TrigSection : public DynamicSection<false>
 
         size_t numTriggers() const;
         std::shared_ptr<Chk::Trigger> getTrigger(size_t triggerIndex);
-        const std::shared_ptr<Chk::Trigger> getTrigger(size_t triggerIndex) const;
+        const std::shared_ptr<Chk::Trigger> getTrigger(size_t triggerIndex) const; // Gives a trigger read from the map its own allocation, see TriggerRecords
+        const Chk::Trigger* readTrigger(size_t triggerIndex) const; // Gets the trigger for reading without copying it, see TriggerRecords::read
         size_t addTrigger(std::shared_ptr<Chk::Trigger> trigger);
         void insertTrigger(size_t triggerIndex, std::shared_ptr<Chk::Trigger> trigger);
         void deleteTrigger(size_t triggerIndex);
@@ -795,8 +885,8 @@ class TrigSection : public DynamicSection<false>
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
         void markUsedGameStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
         void markUsedCommentStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
-        void remapLocationIds(const std::map<u32, u32> & locationIdRemappings);
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteLocation(size_t locationId);
         void deleteString(size_t stringId);
 
@@ -806,7 +896,7 @@ class TrigSection : public DynamicSection<false>
         virtual void write(std::ostream & os, ScenarioSaver & scenarioSaver = ScenarioSaver::GetDefault()); // Writes exactly sizeInBytes bytes to the output stream
 
     private:
-        std::deque<Chk::TriggerPtr> triggers;
+        TriggerRecords triggers;
 };
 
 class MbrfSection : public DynamicSection<false>
@@ -818,7 +908,8 @@ class MbrfSection : public DynamicSection<false>
 
         size_t numBriefingTriggers() const;
         std::shared_ptr<Chk::Trigger> getBriefingTrigger(size_t briefingTriggerIndex);
-        const std::shared_ptr<Chk::Trigger> getBriefingTrigger(size_t briefingTriggerIndex) const;
+        const std::shared_ptr<Chk::Trigger> getBriefingTrigger(size_t briefingTriggerIndex) const; // Gives a trigger read from the map its own allocation, see TriggerRecords
+        const Chk::Trigger* readBriefingTrigger(size_t briefingTriggerIndex) const; // Gets the trigger for reading without copying it, see TriggerRecords::read
         size_t addBriefingTrigger(std::shared_ptr<Chk::Trigger> briefingTrigger);
         void insertBriefingTrigger(size_t briefingTriggerIndex, std::shared_ptr<Chk::Trigger> briefingTrigger);
         void deleteBriefingTrigger(size_t briefingTriggerIndex);
@@ -827,7 +918,7 @@ class MbrfSection : public DynamicSection<false>
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask = Chk::StringUserFlag::All) const;
         bool stringUsed(size_t stringId, u32 userMask = Chk::StringUserFlag::AnyBriefingTrigger);
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyBriefingTrigger);
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 
     protected:
@@ -836,7 +927,7 @@ class MbrfSection : public DynamicSection<false>
         virtual void write(std::ostream & os, ScenarioSaver & scenarioSaver = ScenarioSaver::GetDefault()); // Writes exactly sizeInBytes bytes to the output stream
 
     private:
-        std::deque<std::shared_ptr<Chk::Trigger>> briefingTriggers;
+        TriggerRecords briefingTriggers;
 };
 
 class SprpSection : public StructSection<Chk::SPRP, false>
@@ -854,7 +945,7 @@ class SprpSection : public StructSection<Chk::SPRP, false>
         bool stringUsed(size_t stringId, u32 userMask = Chk::StringUserFlag::All) const;
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask = (u32)Chk::StringUserFlag::ScenarioProperties) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::All) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 };
 
@@ -875,7 +966,7 @@ class ForcSection : public StructSection<Chk::FORC, false>
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers) const;
         bool stringUsed(size_t stringId) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 };
 
@@ -895,8 +986,16 @@ class WavSection : public StructSection<Chk::WAV, true>
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers) const;
         bool stringUsed(size_t stringId) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
+
+    protected:
+        virtual std::streamsize read(const Chk::SectionHeader & sectionHeader, std::istream & is, bool overrideOrAppend = false);
+
+    private:
+        std::unordered_map<u32, std::set<size_t>> soundIndexes; // The sound indexes using each string id, unused sounds are under Chk::StringId::UnusedSound
+
+        void indexSounds();
 };
 
 class UnisSection : public StructSection<Chk::UNIS, false>
@@ -932,7 +1031,7 @@ class UnisSection : public StructSection<Chk::UNIS, false>
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers) const;
         bool stringUsed(size_t stringId) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 };
 
@@ -995,7 +1094,7 @@ class SwnmSection : public StructSection<Chk::SWNM, true>
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers) const;
         bool stringUsed(size_t stringId) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 };
 
@@ -1084,7 +1183,7 @@ class UnixSection : public StructSection<Chk::UNIx, false>
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers) const;
         bool stringUsed(size_t stringId) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 };
 
@@ -1165,7 +1264,7 @@ class OstrSection : public StructSection<Chk::OSTR, true>
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask = Chk::StringUserFlag::All) const;
         bool stringUsed(size_t stringId, u32 userMask = Chk::StringUserFlag::All) const;
         void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::All) const;
-        void remapStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteString(size_t stringId);
 };
 
@@ -1179,6 +1278,8 @@ class KstrSection : public DynamicSection<true>
         bool empty() const;
 
         size_t getCapacity() const;
+        size_t getCharactersAllocated() const; // The size of the arena holding the characters, including characters of replaced or deleted strings not yet released
+        size_t getStoredCharacters() const; // The characters of the stored strings plus a NUL terminator for each, as the strings are written without compression
         size_t getBytesUsed(StrSynchronizerPtr strSynchronizer = nullptr);
 
         bool stringStored(size_t stringId) const;
@@ -1198,9 +1299,16 @@ class KstrSection : public DynamicSection<true>
         template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
         size_t addString(const StringType & str, StrSynchronizer & strSynchronizer, bool autoDefragment = true);
 
+        template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
+        std::vector<size_t> addStrings(const std::vector<StringType> & strs, StrSynchronizer & strSynchronizer, bool autoDefragment = true,
+            const std::vector<size_t> & reservedStringIds = {}); // Gets the ids addString would give were each string put to use before the next is added, reserved ids are treated as used
+
         template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
         void replaceString(size_t stringId, const StringType & str);
 
+        template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkString (Editor <01>Style)
+        void replaceStrings(const std::vector<std::pair<size_t, StringType>> & replacements); // Same as replaceString for each replacement in order, checking for unused characters once
+
         void deleteUnusedStrings(StrSynchronizer & strSynchronizer);
         bool deleteString(size_t stringId, bool deleteOnlyIfUnused = true, StrSynchronizerPtr strSynchronizer = nullptr); // strSynchronizer required for deletion if deleteOnlyIfUnused is set
         void moveString(size_t stringIdFrom, size_t stringIdTo, StrSynchronizer & strSynchronizer);
@@ -1219,7 +1327,11 @@ class KstrSection : public DynamicSection<true>
 
     private:
         u32 version;
-        std::deque<ScStrPtr> strings;
+        ScStrArenaPtr arena; // Holds the characters of the stored strings
+        size_t arenaBytesChecked; // The size of the arena when it was last checked for unused characters
+        std::vector<u32> strings; // The arena id of the string stored at each string id, or ScStrArena::NoStr if none is
+        mutable ScStrIndex stringIndex; // The ids of strings by their arena ids, used by findString
+        std::vector<StrProp> stringProperties; // The properties of the string stored at each string id
         std::vector<u8> stringBytes;
         
         size_t getNextUnusedStringId(std::bitset<Chk::MaxStrings> & stringIdUsed, bool checkBeyondCapacity = true, size_t firstChecked = 1) const;
@@ -1227,7 +1339,7 @@ class KstrSection : public DynamicSection<true>
         bool syncStringsToBytes(ScenarioSaver & scenarioSaver = ScenarioSaver::GetDefault()); // Default string write method (staredit-like, no compression applied)
         bool syncStringsToBytes(StrSynchronizerPtr strSynchronizer = nullptr); // Default string write method (staredit-like, no compression applied)
         void syncBytesToStrings(); // Universal string reader method
-        void loadString(const size_t & stringOffset, const size_t & sectionSize);
+        void loadString(const char* sectionCharacters, const size_t & stringOffset, const size_t & sectionSize);
 };
 
 class KtrgSection : public DynamicSection<true>
@@ -1248,7 +1360,7 @@ class KtrgSection : public DynamicSection<true>
         void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask = Chk::StringUserFlag::All) const;
         bool editorStringUsed(size_t stringId, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
         void markUsedEditorStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
-        void remapEditorStringIds(const std::map<u32, u32> & stringIdRemappings);
+        void remapEditorStringIds(const Chk::StringIdRemappings & stringIdRemappings);
         void deleteEditorString(size_t stringId);
 
     protected:
@@ -1260,6 +1372,7 @@ class KtrgSection : public DynamicSection<true>
 
     private:
         std::deque<Chk::ExtendedTrigDataPtr> extendedTrigData;
+        std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> freeIndexes; // Usable indexes emptied by deletes, lowest first, entries filled or cleaned from the tail since are skipped when popped
 };
 
 class KtgpSection : public DynamicSection<true>
@@ -1297,6 +1410,67 @@ class StrProp {
         StrProp(u8 red, u8 green, u8 blue, u32 size, bool isUsed, bool hasPriority, bool isBold, bool isUnderlined, bool isItalics);
 };
 
+/**
+    A string arena holds the character data of the strings in a STR or KSTR section in a few large blocks rather than an allocation per string
+
+    Strings are interned: each distinct string is held once and is identified by the id it was given when first interned, so strings interned
+    in the same arena are equal exactly when their ids are; character data copied in as a block (such as a whole section as it was read) is
+    used in place, so strings that were sub-strings of one another in the section are still offsets into the same characters
+
+    Sections store the arena id of each of their strings and hold the one reference to their arena, character data is only released when
+    the arena is; sections move their stored strings to a new arena once most of the characters in theirs belong to strings that were since
+    replaced or deleted, releasing the old arena
+*/
+class ScStrArena
+{
+    public:
+        static constexpr size_t BlockSize = 0x10000;
+        static constexpr u32 NoStr = 0; // The id of no string, never given to an interned string
+
+        ScStrArena();
+        virtual ~ScStrArena();
+
+        u32 intern(const char* str, size_t length); // Gets the id of the interned copy of the given characters, copying them in if they're not yet interned
+        u32 internInPlace(const char* str, size_t length); // Same as intern, but str must be NUL-terminated characters within a block copied into this arena
+        u32 find(const char* str, size_t length) const; // Gets the id of the interned copy of the given characters, or NoStr if they're not interned
+        const char* copy(const void* data, size_t size); // Copies a block of data into the arena followed by a NUL terminator, returns the start of the copy
+        void reserve(size_t numStrings); // Makes room to intern numStrings strings without growing the table
+
+        const char* str(u32 strId) const; // Gets the NUL-terminated characters of an interned string
+        size_t length(u32 strId) const;
+        bool isSubStringOf(u32 strId, u32 otherStrId, output_param size_t & offset) const; // Whether a string's characters are the end of another's characters in the same memory, if so offset is where the string starts in the other
+
+        size_t numInterned() const;
+        size_t numBlocks() const;
+        size_t bytesAllocated() const;
+
+    private:
+        struct Interned {
+            const char* str;
+            size_t length;
+        };
+
+        struct Entry {
+            u32 strId; // NoStr if the slot is empty
+            u32 hash; // The low bits of the string's hash
+        };
+
+        std::vector<std::unique_ptr<char[]>> blocks;
+        char* blockAvailable; // The next unused character in the current block
+        size_t blockRemaining; // The number of unused characters in the current block
+        size_t totalAllocated;
+        std::vector<Interned> interned; // The interned strings by id, the first is NoStr
+        std::vector<Entry> table; // Open-addressed with linear probing, the size is zero or a power of two
+
+        char* allocate(size_t size);
+        u32 findEntry(const char* str, size_t length, size_t hash) const;
+        u32 insert(const char* str, size_t length, size_t hash);
+        void rehash(size_t tableSize);
+
+        ScStrArena(const ScStrArena &) = delete;
+        ScStrArena & operator=(const ScStrArena &) = delete;
+};
+
 class ScStr
 {
     public:
@@ -1316,19 +1490,11 @@ class ScStr
         template <typename StringType> // Strings may be RawString (no escaping), EscString (C++ style \r\r escape characters) or ChkdString (Editor <01>Style)
         std::shared_ptr<StringType> toString() const;
 
-        ScStrPtr getParentStr();
-        ScStrPtr getChildStr();
-        static bool adopt(ScStrPtr lhs, ScStrPtr rhs); // Make lhs the parent of rhs if possible, or vice-versa
-        void disown(); // Break any connections with parent and child strings
-
     private:
-        ScStrPtr parentStr; // The larger string inside which this string fits, if null then this is a root string
-        ScStrPtr childStr; // The next largest string that fits inside this string
-        std::vector<char> allocation; // If parentStr is null, then this is the actual string data and str points to the first character
-                                      // else str points to first character of this string within the allocation of the highest-order parent
+        std::vector<char> allocation; // The character data, str points to the first character
         StrProp strProp; // Additional color and font details, if this string is extended and gets stored
 
-        static void adopt(ScStrPtr parent, ScStrPtr child, size_t parentLength, size_t childLength, const char* parentSubString);
+        void assign(const std::string & str);
 };
 
 /** None - No compression methods applied
@@ -1467,7 +1633,7 @@ class LocationSynchronizer
         virtual bool locationUsed(size_t locationId) const = 0;
         virtual void markUsedLocations(std::bitset<Chk::TotalLocations+1> & locationIdUsed) const = 0;
 
-        virtual void remapLocationIds(const std::map<u32, u32> & locationIdRemappings) = 0;
+        virtual void remapLocationIds(const Chk::LocationIdRemappings & locationIdRemappings) = 0;
 };
 
 class StrSynchronizer
@@ -1480,15 +1646,15 @@ class StrSynchronizer
         virtual void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, Chk::Scope usageScope = Chk::Scope::Either, Chk::Scope storageScope = Chk::Scope::Either, u32 userMask = Chk::StringUserFlag::All) const = 0;
         virtual void markValidUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, Chk::Scope usageScope = Chk::Scope::Either, Chk::Scope storageScope = Chk::Scope::Either, u32 userMask = Chk::StringUserFlag::All) const = 0;
 
-        virtual void syncStringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8> & stringBytes,
+        virtual void syncStringsToBytes(const ScStrArena & arena, const std::vector<u32> & strings, std::vector<u8> & stringBytes,
             StrCompressionElevatorPtr compressionElevator = StrCompressionElevator::NeverElevate(),
             u32 requestedCompressionFlags = StrCompressFlag::Unchanged, u32 allowedCompressionFlags = StrCompressFlag::Unchanged) = 0;
 
-        virtual void syncKstringsToBytes(std::deque<ScStrPtr> & strings, std::vector<u8> & stringBytes,
+        virtual void syncKstringsToBytes(const ScStrArena & arena, const std::vector<u32> & strings, const std::vector<StrProp> & stringProperties, std::vector<u8> & stringBytes,
             StrCompressionElevatorPtr compressionElevator = StrCompressionElevator::NeverElevate(),
             u32 requestedCompressionFlags = StrCompressFlag::Unchanged, u32 allowedCompressionFlags = StrCompressFlag::Unchanged) = 0;
         
-        virtual void remapStringIds(const std::map<u32, u32> & stringIdRemappings, Chk::Scope storageScope) = 0;
+        virtual void remapStringIds(const Chk::StringIdRemappings & stringIdRemappings, Chk::Scope storageScope) = 0;
 
         u32 getRequestedCompressionFlags() const { return requestedCompressionFlags; }
         u32 getAllowedCompressionFlags() const { return allowedCompressionFlags; }
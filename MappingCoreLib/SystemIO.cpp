@@ -11,6 +11,12 @@
 #include <iostream>
 #ifdef _WIN32
 #include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 constexpr u32 size_1kb = 0x400;
@@ -551,3 +557,262 @@ bool browseForSave(std::string & filePath, uint32_t & filterIndex, const std::ve
     return false;
 #endif
 }
+
+SharedMemory::SharedMemory() : memory(nullptr), memorySize(0), readOnly(true), owner(false), handle(nullptr)
+{
+
+}
+
+SharedMemory::~SharedMemory()
+{
+    close();
+}
+
+bool SharedMemory::create(const std::string & name, size_t size)
+{
+    close();
+    if ( name.empty() || size == 0 )
+        return false;
+
+#ifdef _WIN32
+    icux::filestring sysName = icux::toFilestring(name);
+    HANDLE mapping = CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, DWORD(u64(size) >> 32), DWORD(u64(size) & 0xFFFFFFFF), sysName.c_str());
+    if ( mapping == NULL )
+        return false;
+    else if ( GetLastError() == ERROR_ALREADY_EXISTS ) // Another process still holds a block by this name
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if ( view == NULL )
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    handle = (void*)mapping;
+    memory = (u8*)view;
+#else
+    std::string sysName = "/" + name;
+    int descriptor = shm_open(sysName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if ( descriptor == -1 && errno == EEXIST ) // Left by a process that didn't close it
+    {
+        shm_unlink(sysName.c_str());
+        descriptor = shm_open(sysName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    if ( descriptor == -1 )
+        return false;
+    else if ( ftruncate(descriptor, off_t(size)) != 0 )
+    {
+        ::close(descriptor);
+        shm_unlink(sysName.c_str());
+        return false;
+    }
+
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if ( view == MAP_FAILED )
+    {
+        shm_unlink(sysName.c_str());
+        return false;
+    }
+    memory = (u8*)view;
+#endif
+    this->name = name;
+    memorySize = size;
+    readOnly = false;
+    owner = true;
+    return true;
+}
+
+bool SharedMemory::open(const std::string & name, bool readOnly)
+{
+    close();
+    if ( name.empty() )
+        return false;
+
+#ifdef _WIN32
+    icux::filestring sysName = icux::toFilestring(name);
+    HANDLE mapping = OpenFileMapping(readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, FALSE, sysName.c_str());
+    if ( mapping == NULL )
+        return false;
+
+    void* view = MapViewOfFile(mapping, readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION viewInfo = {};
+    if ( view == NULL || VirtualQuery(view, &viewInfo, sizeof(viewInfo)) == 0 )
+    {
+        if ( view != NULL )
+            UnmapViewOfFile(view);
+
+        CloseHandle(mapping);
+        return false;
+    }
+    handle = (void*)mapping;
+    memory = (u8*)view;
+    memorySize = size_t(viewInfo.RegionSize);
+#else
+    std::string sysName = "/" + name;
+    int descriptor = shm_open(sysName.c_str(), readOnly ? O_RDONLY : O_RDWR, 0);
+    if ( descriptor == -1 )
+        return false;
+
+    struct stat blockInfo = {};
+    if ( fstat(descriptor, &blockInfo) != 0 || blockInfo.st_size <= 0 )
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    void* view = mmap(nullptr, size_t(blockInfo.st_size), readOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if ( view == MAP_FAILED )
+        return false;
+
+    memory = (u8*)view;
+    memorySize = size_t(blockInfo.st_size);
+#endif
+    this->name = name;
+    this->readOnly = readOnly;
+    owner = false;
+    return true;
+}
+
+void SharedMemory::close()
+{
+    if ( memory != nullptr )
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(memory);
+        CloseHandle((HANDLE)handle);
+#else
+        munmap(memory, memorySize);
+        if ( owner )
+            shm_unlink(("/" + name).c_str());
+#endif
+    }
+    name.clear();
+    memory = nullptr;
+    memorySize = 0;
+    readOnly = true;
+    owner = false;
+    handle = nullptr;
+}
+
+bool SharedMemory::isOpen() const
+{
+    return memory != nullptr;
+}
+
+bool SharedMemory::isReadOnly() const
+{
+    return readOnly;
+}
+
+const u8* SharedMemory::data() const
+{
+    return memory;
+}
+
+u8* SharedMemory::writableData()
+{
+    return readOnly ? nullptr : memory;
+}
+
+size_t SharedMemory::size() const
+{
+    return memorySize;
+}
+
+MappedFile::MappedFile() : memory(nullptr), memorySize(0)
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string & filePath)
+{
+    close();
+    if ( filePath.empty() )
+        return false;
+
+#ifdef _WIN32
+    icux::filestring sysFilePath = icux::toFilestring(filePath);
+    HANDLE file = CreateFile(sysFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if ( file == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER fileSize = {};
+    if ( !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 || u64(fileSize.QuadPart) > u64(size_t(-1)) )
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file); // The mapping keeps the file open
+    if ( mapping == NULL )
+        return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); // The view keeps the mapping open
+    if ( view == NULL )
+        return false;
+
+    memory = (u8*)view;
+    memorySize = size_t(fileSize.QuadPart);
+#else
+    int descriptor = ::open(filePath.c_str(), O_RDONLY);
+    if ( descriptor == -1 )
+        return false;
+
+    struct stat fileInfo = {};
+    if ( fstat(descriptor, &fileInfo) != 0 || fileInfo.st_size <= 0 )
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    void* view = mmap(nullptr, size_t(fileInfo.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor); // The mapping keeps the file open
+    if ( view == MAP_FAILED )
+        return false;
+
+    memory = (u8*)view;
+    memorySize = size_t(fileInfo.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close()
+{
+    if ( memory != nullptr )
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(memory);
+#else
+        munmap(memory, memorySize);
+#endif
+    }
+    memory = nullptr;
+    memorySize = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return memory != nullptr;
+}
+
+const u8* MappedFile::data() const
+{
+    return memory;
+}
+
+size_t MappedFile::size() const
+{
+    return memorySize;
+}
@@ -78,4 +78,64 @@ bool browseForFile(inout_param std::string & filePath, inout_param u32 & filterI
 bool browseForSave(inout_param std::string & filePath, inout_param u32 & filterIndex, const std::vector<std::pair<std::string, std::string>> & filtersAndLabels,
     const std::string & initialDirectory, const std::string & title, bool pathMustExist, bool provideOverwritePrompt);
 
+/**
+    A named block of memory that other processes on the same system can map by name, used to hand large buffers (such as a view
+    of a scenario) to plugins without copying them through messages
+
+    The creator sets the size and should keep the block open until readers are done with it, once the creator closes it the name
+    is released (readers that still have it mapped keep their mapping); on unsupported systems create and open return false
+*/
+class SharedMemory
+{
+    public:
+        SharedMemory();
+        virtual ~SharedMemory(); // Closes the block if it's open
+
+        bool create(const std::string & name, size_t size); // Creates a new block with the given name and size, replacing a stale block left with that name if the system allows it
+        bool open(const std::string & name, bool readOnly = true); // Maps an existing block created with the given name
+        void close();
+
+        bool isOpen() const;
+        bool isReadOnly() const;
+        const u8* data() const; // nullptr if the block isn't open
+        u8* writableData(); // nullptr if the block isn't open or was opened read-only
+        size_t size() const; // The mapped size, for blocks opened by name this may be rounded up to the system's page size
+
+    private:
+        std::string name;
+        u8* memory;
+        size_t memorySize;
+        bool readOnly;
+        bool owner;
+        void* handle; // The system's handle to the block, if the system uses one
+
+        SharedMemory(const SharedMemory &) = delete;
+        SharedMemory & operator=(const SharedMemory &) = delete;
+};
+
+/**
+    A file mapped read-only into memory, so its contents can be used in place without reading them into a buffer; the mapping is
+    private to this process and is released when the file is closed
+*/
+class MappedFile
+{
+    public:
+        MappedFile();
+        virtual ~MappedFile(); // Closes the file if it's open
+
+        bool open(const std::string & filePath); // Maps the whole file, returns false if the file is missing, empty or can't be mapped
+        void close();
+
+        bool isOpen() const;
+        const u8* data() const; // nullptr if the file isn't open
+        size_t size() const;
+
+    private:
+        u8* memory;
+        size_t memorySize;
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile & operator=(const MappedFile &) = delete;
+};
+
 #endif
\ No newline at end of file
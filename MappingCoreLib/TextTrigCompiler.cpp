@@ -2,9 +2,13 @@
 #include "EscapeStrings.h"
 #include "Math.h"
 #include "StringBuffer.h"
+#include "TextTrigGenerator.h"
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <exception>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -13,7 +17,465 @@
 
 using namespace BufferedStream;
 
-TextTrigCompiler::TextTrigCompiler(bool useAddressesForMemory, u32 deathTableOffset) : useAddressesForMemory(useAddressesForMemory), deathTableOffset(deathTableOffset)
+constexpr auto conditionNames = makeKeywordTable<Chk::Condition::VirtualType>({
+    { "ACCUMULATE",        Chk::Condition::VirtualType::Accumulate },
+    { "ALWAYS",            Chk::Condition::VirtualType::Always },
+    { "BRING",             Chk::Condition::VirtualType::Bring },
+    { "COMMAND",           Chk::Condition::VirtualType::Command },
+    { "COMMANDTHELEAST",   Chk::Condition::VirtualType::CommandTheLeast },
+    { "COMMANDTHELEASTAT", Chk::Condition::VirtualType::CommandTheLeastAt },
+    { "COMMANDTHEMOST",    Chk::Condition::VirtualType::CommandTheMost },
+    { "COMMANDTHEMOSTAT",  Chk::Condition::VirtualType::CommandTheMostAt },
+    { "COMMANDSTHEMOSTAT", Chk::Condition::VirtualType::CommandTheMostAt }, // command'S', added for backwards compatibility
+    { "COUNTDOWNTIMER",    Chk::Condition::VirtualType::CountdownTimer },
+    { "CUSTOM",            Chk::Condition::VirtualType::Custom },
+    { "DEATHS",            Chk::Condition::VirtualType::Deaths },
+    { "ELAPSEDTIME",       Chk::Condition::VirtualType::ElapsedTime },
+    { "HIGHESTSCORE",      Chk::Condition::VirtualType::HighestScore },
+    { "KILL",              Chk::Condition::VirtualType::Kill },
+    { "LEASTKILLS",        Chk::Condition::VirtualType::LeastKills },
+    { "LEASTRESOURCES",    Chk::Condition::VirtualType::LeastResources },
+    { "LOWESTSCORE",       Chk::Condition::VirtualType::LowestScore },
+    { "MEMORY",            Chk::Condition::VirtualType::Memory },
+    { "MOSTKILLS",         Chk::Condition::VirtualType::MostKills },
+    { "MOSTRESOURCES",     Chk::Condition::VirtualType::MostResources },
+    { "NEVER",             Chk::Condition::VirtualType::Never },
+    { "OPPONENTS",         Chk::Condition::VirtualType::Opponents },
+    { "SCORE",             Chk::Condition::VirtualType::Score },
+    { "SWITCH",            Chk::Condition::VirtualType::Switch }
+});
+
+constexpr auto actionNames = makeKeywordTable<Chk::Action::VirtualType>({
+    { "CENTERVIEW",                       Chk::Action::VirtualType::CenterView },
+    { "COMMENT",                          Chk::Action::VirtualType::Comment },
+    { "CREATEUNIT",                       Chk::Action::VirtualType::CreateUnit },
+    { "CREATEUNITWITHPROPERTIES",         Chk::Action::VirtualType::CreateUnitWithProperties },
+    { "CUSTOM",                           Chk::Action::VirtualType::Custom },
+    { "DEFEAT",                           Chk::Action::VirtualType::Defeat },
+    { "DISPLAYTEXTMESSAGE",               Chk::Action::VirtualType::DisplayTextMessage },
+    { "DRAW",                             Chk::Action::VirtualType::Draw },
+    { "GIVEUNITSTOPLAYER",                Chk::Action::VirtualType::GiveUnitsToPlayer },
+    { "KILLUNIT",                         Chk::Action::VirtualType::KillUnit },
+    { "KILLUNITATLOCATION",               Chk::Action::VirtualType::KillUnitAtLocation },
+    { "LEADERBOARDCOMPUTERPLAYERS",       Chk::Action::VirtualType::LeaderboardCompPlayers },
+    { "LEADERBOARDCONTROL",               Chk::Action::VirtualType::LeaderboardCtrl },
+    { "LEADERBOARDCONTROLATLOCATION",     Chk::Action::VirtualType::LeaderboardCtrlAtLoc },
+    { "LEADERBOARDGOALCONTROL",           Chk::Action::VirtualType::LeaderboardGoalCtrl },
+    { "LEADERBOARDGOALCONTROLATLOCATION", Chk::Action::VirtualType::LeaderboardGoalCtrlAtLoc },
+    { "LEADERBOARDGOALKILLS",             Chk::Action::VirtualType::LeaderboardGoalKills },
+    { "LEADERBOARDGOALPOINTS",            Chk::Action::VirtualType::LeaderboardGoalPoints },
+    { "LEADERBOARDGOALRESOURCES",         Chk::Action::VirtualType::LeaderboardGoalResources },
+    { "LEADERBOARDGREED",                 Chk::Action::VirtualType::LeaderboardGreed },
+    { "LEADERBOARDKILLS",                 Chk::Action::VirtualType::LeaderboardKills },
+    { "LEADERBOARDPOINTS",                Chk::Action::VirtualType::LeaderboardPoints },
+    { "LEADERBOARDRESOURCES",             Chk::Action::VirtualType::LeaderboardResources },
+    { "MEMORY",                           Chk::Action::VirtualType::SetMemory },
+    { "MINIMAPPING",                      Chk::Action::VirtualType::MinimapPing },
+    { "MODIFYUNITENERGY",                 Chk::Action::VirtualType::ModifyUnitEnergy },
+    { "MODIFYUNITHANGERCOUNT",            Chk::Action::VirtualType::ModifyUnitHangerCount },
+    { "MODIFYUNITHITPOINTS",              Chk::Action::VirtualType::ModifyUnitHitpoints },
+    { "MODIFYUNITRESOURCEAMOUNT",         Chk::Action::VirtualType::ModifyUnitResourceAmount },
+    { "MODIFYUNITSHIELDPOINTS",           Chk::Action::VirtualType::ModifyUnitShieldPoints },
+    { "MOVELOCATION",                     Chk::Action::VirtualType::MoveLocation },
+    { "MOVEUNIT",                         Chk::Action::VirtualType::MoveUnit },
+    { "MUTEUNITSPEECH",                   Chk::Action::VirtualType::MuteUnitSpeech },
+    { "ORDER",                            Chk::Action::VirtualType::Order },
+    { "PAUSEGAME",                        Chk::Action::VirtualType::PauseGame },
+    { "PAUSETIMER",                       Chk::Action::VirtualType::PauseTimer },
+    { "PLAYWAV",                          Chk::Action::VirtualType::PlaySound },
+    { "PRESERVETRIGGER",                  Chk::Action::VirtualType::PreserveTrigger },
+    { "REMOVEUNIT",                       Chk::Action::VirtualType::RemoveUnit },
+    { "REMOVEUNITATLOCATION",             Chk::Action::VirtualType::RemoveUnitAtLocation },
+    { "RUNAISCRIPT",                      Chk::Action::VirtualType::RunAiScript },
+    { "RUNAISCRIPTATLOCATION",            Chk::Action::VirtualType::RunAiScriptAtLocation },
+    { "SETALLIANCESTATUS",                Chk::Action::VirtualType::SetAllianceStatus },
+    { "SETCOUNTDOWNTIMER",                Chk::Action::VirtualType::SetCountdownTimer },
+    { "SETDEATHS",                        Chk::Action::VirtualType::SetDeaths },
+    { "SETDOODADSTATE",                   Chk::Action::VirtualType::SetDoodadState },
+    { "SETINVINCIBILITY",                 Chk::Action::VirtualType::SetInvincibility },
+    { "SETMEMORY",                        Chk::Action::VirtualType::SetMemory },
+    { "SETMISSIONOBJECTIVES",             Chk::Action::VirtualType::SetMissionObjectives },
+    { "SETNEXTSCENARIO",                  Chk::Action::VirtualType::SetNextScenario },
+    { "SETRESOURCES",                     Chk::Action::VirtualType::SetResources },
+    { "SETSCORE",                         Chk::Action::VirtualType::SetScore },
+    { "SETSWITCH",                        Chk::Action::VirtualType::SetSwitch },
+    { "TALKINGPORTRAIT",                  Chk::Action::VirtualType::TalkingPortrait },
+    { "TRANSMISSION",                     Chk::Action::VirtualType::Transmission },
+    { "UNMUTEUNITSPEECH",                 Chk::Action::VirtualType::UnmuteUnitSpeech },
+    { "UNPAUSEGAME",                      Chk::Action::VirtualType::UnpauseGame },
+    { "UNPAUSETIMER",                     Chk::Action::VirtualType::UnpauseTimer },
+    { "VICTORY",                          Chk::Action::VirtualType::Victory },
+    { "WAIT",                             Chk::Action::VirtualType::Wait }
+});
+
+constexpr auto standardUnitNames = makeKeywordTable<Sc::Unit::Type>({
+    { "ALAN SCHEZAR (GOLIATH)",               Sc::Unit::Type::AlanSchezar_Goliath },
+    { "ALAN SCHEZAR TURRET",                  Sc::Unit::Type::AlanTurret },
+    { "ALDARIS (TEMPLAR)",                    Sc::Unit::Type::Aldaris_Templar },
+    { "ALEXEI STUKOV (GHOST)",                Sc::Unit::Type::AlexeiStukov_Ghost },
+    { "ANY UNIT",                             Sc::Unit::Type::AnyUnit },
+    { "ARCTURUS MENGSK (BATTLECRUISER)",      Sc::Unit::Type::ArcturusMengsk_Battlecruiser },
+    { "ARTANIS (SCOUT)",                      Sc::Unit::Type::Artanis_Scout },
+    { "BENGALAAS (JUNGLE CRITTER)",           Sc::Unit::Type::Bengalaas_Jungle },
+    { "BUILDINGS",                            Sc::Unit::Type::Buildings },
+    { "CARGO SHIP (UNUSED)",                  Sc::Unit::Type::CargoShip_Unused },
+    { "CATINA (UNUSED)",                      Sc::Unit::Type::Cantina },
+    { "CAVE (UNUSED)",                        Sc::Unit::Type::Cave },
+    { "CAVE-IN (UNUSED)",                     Sc::Unit::Type::CaveIn },
+    { "DANIMOTH (ARBITER)",                   Sc::Unit::Type::Danimoth_Arbiter },
+    { "DARK SWARM",                           Sc::Unit::Type::DarkSwarm },
+    { "DATA DISC",                            Sc::Unit::Type::DataDisc },
+    { "DEVOURING ONE (ZERGLING)",             Sc::Unit::Type::DevouringOne_Zergling },
+    { "DISRUPTION WEB",                       Sc::Unit::Type::DisruptionField },
+    { "EDMUND DUKE (SIEGE MODE)",             Sc::Unit::Type::EdmundDuke_SiegeMode },
+    { "EDMUND DUKE (TANK MODE)",              Sc::Unit::Type::EdmundDuke_SiegeTank },
+    { "EDMUND DUKE TURRET (SIEGE MODE)",      Sc::Unit::Type::DukeTurretType2 },
+    { "EDMUND DUKE TURRET (TANK MODE)",       Sc::Unit::Type::DukeTurretType1 },
+    { "FACTORIES",                            Sc::Unit::Type::Factories },
+    { "FENIX (DRAGOON)",                      Sc::Unit::Type::Fenix_Dragoon },
+    { "FENIX (ZEALOT)",                       Sc::Unit::Type::Fenix_Zealot },
+    { "FLAG",                                 Sc::Unit::Type::Flag },
+    { "FLOOR GUN TRAP",                       Sc::Unit::Type::FloorGunTrap },
+    { "FLOOR HATCH (UNUSED)",                 Sc::Unit::Type::FloorHatch_Unused },
+    { "FLOOR MISSILE TRAP",                   Sc::Unit::Type::FloorMissileTrap },
+    { "GANTRITHOR (CARRIER)",                 Sc::Unit::Type::Gantrithor_Carrier },
+    { "GERARD DUGALLE (BATTLECRUISER)",       Sc::Unit::Type::GerardDuGalle_BattleCruiser },
+    { "GOLIATH TURRET",                       Sc::Unit::Type::GoliathTurret },
+    { "GUI MONTAG (FIREBAT)",                 Sc::Unit::Type::GuiMontag_Firebat },
+    { "HUNTER KILLER (HYDRALISK)",            Sc::Unit::Type::HunterKiller_Hydralisk },
+    { "HYPERION (BATTLECRUISER)",             Sc::Unit::Type::Hyperion_Battlecruiser },
+    { "INDEPENDENT COMMAND CENTER (UNUSED)",  Sc::Unit::Type::IndependentCommandCenter_Unused },
+    { "INDEPENDENT JUMP GATE (UNUSED)",       Sc::Unit::Type::IndependentJumpGate_Unused },
+    { "INDEPENDENT STARPORT (UNUSED)",        Sc::Unit::Type::IndependentStarport_Unused },
+    { "INFESTED COMMAND CENTER",              Sc::Unit::Type::InfestedCommandCenter },
+    { "INFESTED DURAN (INFESTED TERRAN)",     Sc::Unit::Type::InfestedDuran },
+    { "INFESTED KERRIGAN (INFESTED TERRAIN)", Sc::Unit::Type::InfestedKerrigan_InfestedTerran },
+    { "INFESTED TERRAN",                      Sc::Unit::Type::InfestedTerran },
+    { "ION CANNON",                           Sc::Unit::Type::IonCannon },
+    { "JIM RAYNOR (MARINE)",                  Sc::Unit::Type::JimRaynor_Marine },
+    { "JIM RAYNOR (VULTURE)",                 Sc::Unit::Type::JimRaynor_Vulture },
+    { "KAKARU (TWILIGHT CRITTER)",            Sc::Unit::Type::Kakaru_TwilightCritter },
+    { "KHADARIN CRYSTAL FORMATION (UNUSED)",  Sc::Unit::Type::KhadarinCrystalFormation_Unused },
+    { "KHALIS CRYSTAL",                       Sc::Unit::Type::KhalisCrystal },
+    { "KHAYDARIN CRYSTAL",                    Sc::Unit::Type::KhaydarinCrystal },
+    { "KHAYDARIN CRYSTAL FORMATION",          Sc::Unit::Type::KhaydarinCrystalFormation },
+    { "KUKULZA (GUARDIAN)",                   Sc::Unit::Type::Kukulza_Guardian },
+    { "KUKULZA (MUTALISK)",                   Sc::Unit::Type::Kukulza_Mutalisk },
+    { "LEFT PIT DOOR",                        Sc::Unit::Type::LeftPitDoor },
+    { "LEFT UPPER LEVEL DOOR",                Sc::Unit::Type::LeftUpperLevelDoor },
+    { "LEFT WALL FLAME TRAP",                 Sc::Unit::Type::LeftWallFlameTrap },
+    { "LEFT WALL MISSILE TRAP",               Sc::Unit::Type::LeftWallMissileTrap },
+    { "LURKER EGG",                           Sc::Unit::Type::LurkerEgg },
+    { "MAGELLAN (SCIENCE VESSEL)",            Sc::Unit::Type::Magellan_ScienceVessel },
+    { "MAP REVEALER",                         Sc::Unit::Type::MapRevealer },
+    { "MATRIARCH (QUEEN)",                    Sc::Unit::Type::Matriarch_Queen },
+    { "MATURE CRYSALIS",                      Sc::Unit::Type::MatureCrysalis },
+    { "MEN",                                  Sc::Unit::Type::Men },
+    { "MERCENARY GUNSHIP (UNUSED)",           Sc::Unit::Type::MercenaryGunship_Unused },
+    { "MINERAL CLUSTER TYPE 1",               Sc::Unit::Type::MineralClusterType1 },
+    { "MINERAL CLUSTER TYPE 2",               Sc::Unit::Type::MineralClusterType2 },
+    { "MINERAL FIELD (TYPE 1)",               Sc::Unit::Type::MineralFieldType1 },
+    { "MINERAL FIELD (TYPE 2)",               Sc::Unit::Type::MineralFieldType2 },
+    { "MINERAL FIELD (TYPE 3)",               Sc::Unit::Type::MineralFieldType3 },
+    { "MINING PLATFORM (UNUSED)",             Sc::Unit::Type::MiningPlatform_Unused },
+    { "MOJO (SCOUT)",                         Sc::Unit::Type::Mojo_Scout },
+    { "MUTALISK COCOON",                      Sc::Unit::Type::Cocoon },
+    { "NORAD II (BATTLECRUISER)",             Sc::Unit::Type::NoradII_Battlecruiser },
+    { "NORAD II (CRASHED)",                   Sc::Unit::Type::NoradII_Crashed },
+    { "NUCLEAR MISSILE",                      Sc::Unit::Type::NuclearMissile },
+    { "OVERMIND COCOON",                      Sc::Unit::Type::OvermindCocoon },
+    { "PROTOSS ARBITER",                      Sc::Unit::Type::ProtossArbiter },
+    { "PROTOSS ARBITER TRIBUNAL",             Sc::Unit::Type::ProtossArbiterTribunal },
+    { "PROTOSS ARCHON",                       Sc::Unit::Type::ProtossArchon },
+    { "PROTOSS ASSIMILATOR",                  Sc::Unit::Type::ProtossAssimilator },
+    { "PROTOSS BEACON",                       Sc::Unit::Type::ProtossBeacon },
+    { "PROTOSS CARRIER",                      Sc::Unit::Type::ProtossCarrier },
+    { "PROTOSS CITADEL OF ADUN",              Sc::Unit::Type::ProtossCitadelOfAdum },
+    { "PROTOSS CORSAIR",                      Sc::Unit::Type::ProtossCorsair },
+    { "PROTOSS CYBERNETICS CORE",             Sc::Unit::Type::ProtossCyberneticsCore },
+    { "PROTOSS DARK ARCHON",                  Sc::Unit::Type::ProtossDarkArchon },
+    { "PROTOSS DARK TEMPLAR (HERO)",          Sc::Unit::Type::DarkTemplar_Hero },
+    { "PROTOSS DARK TEMPLAR (UNIT)",          Sc::Unit::Type::ProtossDarkTemplar },
+    { "PROTOSS DRAGOON",                      Sc::Unit::Type::ProtossDragoon },
+    { "PROTOSS FLAG BEACON",                  Sc::Unit::Type::ProtossFlagBeacon },
+    { "PROTOSS FLEET BEACON",                 Sc::Unit::Type::ProtossFleetBeacon },
+    { "PROTOSS FORGE",                        Sc::Unit::Type::ProtossForge },
+    { "PROTOSS GATEWAY",                      Sc::Unit::Type::ProtossGateway },
+    { "PROTOSS HIGH TEMPLAR",                 Sc::Unit::Type::ProtossHighTemplar },
+    { "PROTOSS INTERCEPTOR",                  Sc::Unit::Type::ProtossInterceptor },
+    { "PROTOSS MARKER",                       Sc::Unit::Type::ProtossMarker },
+    { "PROTOSS NEXUS",                        Sc::Unit::Type::ProtossNexus },
+    { "PROTOSS OBSERVATORY",                  Sc::Unit::Type::ProtossObservatory },
+    { "PROTOSS OBSERVER",                     Sc::Unit::Type::ProtossObserver },
+    { "PROTOSS PHOTON CANNON",                Sc::Unit::Type::ProtossPhotonCannon },
+    { "PROTOSS PROBE",                        Sc::Unit::Type::ProtossProbe },
+    { "PROTOSS PYLON",                        Sc::Unit::Type::ProtossPylon },
+    { "PROTOSS REAVER",                       Sc::Unit::Type::ProtossReaver },
+    { "PROTOSS ROBOTICS FACILITY",            Sc::Unit::Type::ProtossRoboticsFacility },
+    { "PROTOSS ROBOTICS SUPPORT BAY",         Sc::Unit::Type::ProtossRoboticsSupportBay },
+    { "PROTOSS SCARAB",                       Sc::Unit::Type::ProtossScarab },
+    { "PROTOSS SCOUT",                        Sc::Unit::Type::ProtossScout },
+    { "PROTOSS SHIELD BATTERY",               Sc::Unit::Type::ProtossShieldBattery },
+    { "PROTOSS SHUTTLE",                      Sc::Unit::Type::ProtossShuttle },
+    { "PROTOSS STARGATE",                     Sc::Unit::Type::ProtossStargate },
+    { "PROTOSS TEMPLAR ARCHIVES",             Sc::Unit::Type::ProtossTemplarArchives },
+    { "PROTOSS TEMPLE",                       Sc::Unit::Type::ProtossTemple },
+    { "PROTOSS VESPENE GAS ORB TYPE 1",       Sc::Unit::Type::ProtossVespeneGasOrbType1 },
+    { "PROTOSS VESPENE GAS ORB TYPE 2",       Sc::Unit::Type::ProtossVespeneGasOrbType2 },
+    { "PROTOSS ZEALOT",                       Sc::Unit::Type::ProtossZealot },
+    { "PSI DISRUPTER",                        Sc::Unit::Type::PsiDistrupter },
+    { "PSI EMITTER",                          Sc::Unit::Type::PsiEmitter },
+    { "POWER GENERATOR",                      Sc::Unit::Type::PowerGenerator },
+    { "RAGNASAUR (ASHWORLD CRITTER)",         Sc::Unit::Type::Ragnasaur_AshworldCritter },
+    { "RASZAGAL (CORSAIR)",                   Sc::Unit::Type::Raszagal_Corsair },
+    { "REPAIR BAY (UNUSED)",                  Sc::Unit::Type::RepairBay_Unused },
+    { "RHYNADON (BADLANDS CRITTER)",          Sc::Unit::Type::Rhynadon_BadlandsCritter },
+    { "RIGHT PIT DOOR",                       Sc::Unit::Type::RightPitDoor },
+    { "RIGHT UPPER LEVEL DOOR",               Sc::Unit::Type::RightUpperLevelDoor },
+    { "RIGHT WALL FLAME TRAP",                Sc::Unit::Type::RightWallFlameTrap },
+    { "RIGHT WALL MISSILE TRAP",              Sc::Unit::Type::RightWallMissileTrap },
+    { "RUINS (UNUSED)",                       Sc::Unit::Type::Ruins_Unused },
+    { "SAMIR DURAN (GHOST)",                  Sc::Unit::Type::SamirDuran_Ghost },
+    { "SARAH KERRIGAN (GHOST)",               Sc::Unit::Type::SarahKerrigan_Ghost },
+    { "SCANNER SWEEP",                        Sc::Unit::Type::ScannerSweep },
+    { "SCANTID (DESERT CRITTER)",             Sc::Unit::Type::Scantid_DesertCritter },
+    { "SIEGE TANK TURRET (SIEGE MODE)",       Sc::Unit::Type::SiegeTankTurret_SiegeMode },
+    { "SIEGE TANK TURRET (TANK MODE)",        Sc::Unit::Type::SiegeTankTurret_TankMode },
+    { "SPIDER MINE",                          Sc::Unit::Type::SpiderMine },
+    { "STARBASE (UNUSED)",                    Sc::Unit::Type::Starbase_Unused },
+    { "START LOCATION",                       Sc::Unit::Type::StartLocation },
+    { "STASIS CELL/PRISON",                   Sc::Unit::Type::StasisCellPrison },
+    { "TERRAN ACADEMY",                       Sc::Unit::Type::TerranAcademy },
+    { "TERRAN ARMORY",                        Sc::Unit::Type::TerranArmory },
+    { "TERRAN BARRACKS",                      Sc::Unit::Type::TerranBarracks },
+    { "TERRAN BATTLECRUISER",                 Sc::Unit::Type::TerranBattlecruiser },
+    { "TERRAN BEACON",                        Sc::Unit::Type::TerranBeacon },
+    { "TERRAN BUNKER",                        Sc::Unit::Type::TerranBunker },
+    { "TERRAN CIVILIAN",                      Sc::Unit::Type::TerranCivilian },
+    { "TERRAN COMMAND CENTER",                Sc::Unit::Type::TerranCommandCenter },
+    { "TERRAN COMSAT STATION",                Sc::Unit::Type::TerranComsatStation },
+    { "TERRAN CONTROL TOWER",                 Sc::Unit::Type::TerranControlTower },
+    { "TERRAN COVERT OPS",                    Sc::Unit::Type::TerranCovertOps },
+    { "TERRAN DROPSHIP",                      Sc::Unit::Type::TerranDropship },
+    { "TERRAN ENGINEERING BAY",               Sc::Unit::Type::TerranEngineeringBay },
+    { "TERRAN FACTORY",                       Sc::Unit::Type::TerranFactory },
+    { "TERRAN FIREBAT",                       Sc::Unit::Type::TerranFirebat },
+    { "TERRAN FLAG BEACON",                   Sc::Unit::Type::TerranFlagBeacon },
+    { "TERRAN GHOST",                         Sc::Unit::Type::TerranGhost },
+    { "TERRAN GOLIATH",                       Sc::Unit::Type::TerranGoliath },
+    { "TERRAN MACHINE SHOP",                  Sc::Unit::Type::TerranMachineShop },
+    { "TERRAN MARINE",                        Sc::Unit::Type::TerranMarine },
+    { "TERRAN MARKER",                        Sc::Unit::Type::TerranMarker },
+    { "TERRAN MEDIC",                         Sc::Unit::Type::TerranMedic },
+    { "TERRAN MISSILE TURRET",                Sc::Unit::Type::TerranMissileTurret },
+    { "TERRAN NUCLEAR SILO",                  Sc::Unit::Type::TerranNuclearSilo },
+    { "TERRAN PHYSICS LAB",                   Sc::Unit::Type::TerranPhysicsLab },
+    { "TERRAN REFINERY",                      Sc::Unit::Type::TerranRefinery },
+    { "TERRAN SCIENCE FACILITY",              Sc::Unit::Type::TerranScienceFacility },
+    { "TERRAN SCIENCE VESSEL",                Sc::Unit::Type::TerranScienceVessel },
+    { "TERRAN SCV",                           Sc::Unit::Type::TerranScv },
+    { "TERRAN SIEGE TANK (SIEGE MODE)",       Sc::Unit::Type::TerranSiegeTank_SiegeMode },
+    { "TERRAN SIEGE TANK (TANK MODE)",        Sc::Unit::Type::TerranSiegeTank_TankMode },
+    { "TERRAN STARPORT",                      Sc::Unit::Type::TerranStarport },
+    { "TERRAN SUPPLY DEPOT",                  Sc::Unit::Type::TerranSupplyDepot },
+    { "TERRAN VALKYRIE",                      Sc::Unit::Type::TerranValkrie },
+    { "TERRAN VESPENE GAS TANK TYPE 1",       Sc::Unit::Type::TerranVespeneGasTankType1 },
+    { "TERRAN VESPENE GAS TANK TYPE 2",       Sc::Unit::Type::TerranVespeneGasTankType2 },
+    { "TERRAN VULTURE",                       Sc::Unit::Type::TerranVulture },
+    { "TERRAN WRAITH",                        Sc::Unit::Type::TerranWraith },
+    { "TASSADAR (TEMPLAR)",                   Sc::Unit::Type::Tassadar_Templar },
+    { "TASSADAR/ZERATUL (ARCHON)",            Sc::Unit::Type::TassadarZeratul_Archon },
+    { "TOM KAZANSKY (WRAITH)",                Sc::Unit::Type::TomKazansky_Wraith },
+    { "TORRASQUE (ULTRALISK)",                Sc::Unit::Type::Torrasque_Ultralisk },
+    { "UNCLEAN ONE (DEFILER)",                Sc::Unit::Type::UncleanOne_Defiler },
+    { "UNUSED PROTOSS BUILDING 1",            Sc::Unit::Type::UnusedProtossBuilding1 },
+    { "UNUSED PROTOSS BUILDING 2",            Sc::Unit::Type::UnusedProtossBuilding2 },
+    { "UNUSED ZERG BUILDING 1",               Sc::Unit::Type::UnusedZergBuilding1 },
+    { "UNUSED ZERG BUILDING 2",               Sc::Unit::Type::UnusedZergBuilding1 },
+    { "URAJ CRYSTAL",                         Sc::Unit::Type::UrajCrystal },
+    { "URSADON (ICE WORLD CRITTER)",          Sc::Unit::Type::Ursadon_IceWorldCritter },
+    { "VESPENE GEYSER",                       Sc::Unit::Type::VespeneGeyser },
+    { "WARBRINGER (REAVER)",                  Sc::Unit::Type::Warbringer_Reaver },
+    { "WARP GATE",                            Sc::Unit::Type::WarpGate },
+    { "XEL'NAGA TEMPLE",                      Sc::Unit::Type::XelNagaTemple },
+    { "YGGDRASILL (OVERLORD)",                Sc::Unit::Type::Yggdrasill_Overlord },
+    { "YOUNG CHRYSALIS",                      Sc::Unit::Type::YoungChrysalis },
+    { "ZERG BEACON",                          Sc::Unit::Type::ZergBeacon },
+    { "ZERG BROODLING",                       Sc::Unit::Type::ZergBroodling },
+    { "ZERG CEREBRATE",                       Sc::Unit::Type::ZergCerebrate },
+    { "ZERG CEREBRATE DAGGOTH",               Sc::Unit::Type::ZergCerebrateDaggoth },
+    { "ZERG CREEP COLONY",                    Sc::Unit::Type::ZergCreepColony },
+    { "ZERG DEFILER",                         Sc::Unit::Type::ZergDefiler },
+    { "ZERG DEFILER MOUND",                   Sc::Unit::Type::ZergDefilerMound },
+    { "ZERG DEVOURER",                        Sc::Unit::Type::ZergDevourer },
+    { "ZERG DRONE",                           Sc::Unit::Type::ZergDrone },
+    { "ZERG EGG",                             Sc::Unit::Type::ZergEgg },
+    { "ZERG EVOLUTION CHAMBER",               Sc::Unit::Type::ZergEvolutionChamber },
+    { "ZERG EXTRACTOR",                       Sc::Unit::Type::ZergExtractor },
+    { "ZERG FLAG BEACON",                     Sc::Unit::Type::ZergFlagBeacon },
+    { "ZERG GREATER SPIRE",                   Sc::Unit::Type::ZergGreaterSpire },
+    { "ZERG GUARDIAN",                        Sc::Unit::Type::ZergGuardian },
+    { "ZERG HATCHERY",                        Sc::Unit::Type::ZergHatchery },
+    { "ZERG HIVE",                            Sc::Unit::Type::ZergHive },
+    { "ZERG HYDRALISK",                       Sc::Unit::Type::ZergHydralisk },
+    { "ZERG HYDRALISK DEN",                   Sc::Unit::Type::ZergHydraliskDen },
+    { "ZERG LAIR",                            Sc::Unit::Type::ZergLair },
+    { "ZERG LARVA",                           Sc::Unit::Type::ZergLarva },
+    { "ZERG LURKER",                          Sc::Unit::Type::ZergLurker },
+    { "ZERG MARKER",                          Sc::Unit::Type::ZergMarker },
+    { "ZERG MUTALISK",                        Sc::Unit::Type::ZergMutalisk },
+    { "ZERG NYDUS CANAL",                     Sc::Unit::Type::ZergNydusCanal },
+    { "ZERG OVERLORD",                        Sc::Unit::Type::ZergOverlord },
+    { "ZERG OVERMIND",                        Sc::Unit::Type::ZergOvermind },
+    { "ZERG OVERMIND (WITH SHELL)",           Sc::Unit::Type::ZergOvermind_WithShell },
+    { "ZERG QUEEN",                           Sc::Unit::Type::ZergQueen },
+    { "ZERG QUEEN'S NEST",                    Sc::Unit::Type::ZergQueensNest },
+    { "ZERG SCOURGE",                         Sc::Unit::Type::ZergScourge },
+    { "ZERG SPAWNING POOL",                   Sc::Unit::Type::ZergSpawningPool },
+    { "ZERG SPIRE",                           Sc::Unit::Type::ZergSpire },
+    { "ZERG SPORE COLONY",                    Sc::Unit::Type::ZergSporeColony },
+    { "ZERG SUNKEN COLONY",                   Sc::Unit::Type::ZergSunkenColony },
+    { "ZERG ULTRALISK",                       Sc::Unit::Type::ZergUltralisk },
+    { "ZERG ULTRALISK CAVERN",                Sc::Unit::Type::ZergUltraliskCavern },
+    { "ZERG VESPENE GAS SAC TYPE 1",          Sc::Unit::Type::ZergVespeneGasSacType1 },
+    { "ZERG VESPENE GAS SAC TYPE 2",          Sc::Unit::Type::ZergVespeneGasSacType2 },
+    { "ZERG ZERGLING",                        Sc::Unit::Type::ZergZergling },
+    { "ZERATUL (DARK TEMPLAR)",               Sc::Unit::Type::Zeratul_DarkTemplar }
+});
+
+constexpr auto legacyUnitNames = makeKeywordTable<Sc::Unit::Type>({ // Legacy names, akas, and shortcut names
+    { "[ANY UNIT]",                          Sc::Unit::Type::AnyUnit },
+    { "[BUILDINGS]",                         Sc::Unit::Type::Buildings },
+    { "[FACTORIES]",                         Sc::Unit::Type::Factories },
+    { "[MEN]",                               Sc::Unit::Type::Men },
+    { "ALAN TURRET",                         Sc::Unit::Type::AlanTurret },
+    { "BENGALAAS (JUNGLE)",                  Sc::Unit::Type::Bengalaas_Jungle },
+    { "CANTINA",                             Sc::Unit::Type::Cantina },
+    { "CAVE",                                Sc::Unit::Type::Cave },
+    { "CAVE-IN",                             Sc::Unit::Type::CaveIn },
+    { "COCOON",                              Sc::Unit::Type::Cocoon },
+    { "DARK TEMPLAR (HERO)",                 Sc::Unit::Type::DarkTemplar_Hero },
+    { "DISRUPTION FIELD",                    Sc::Unit::Type::DisruptionField },
+    { "DUKE TURRET TYPE 1",                  Sc::Unit::Type::DukeTurretType1 },
+    { "DUKE TURRET TYPE 2",                  Sc::Unit::Type::DukeTurretType2 },
+    { "EDMUND DUKE (SIEGE TANK)",            Sc::Unit::Type::EdmundDuke_SiegeTank },
+    { "GERARD DUGALLE (GHOST)",              Sc::Unit::Type::GerardDuGalle_BattleCruiser },
+    { "INDEPENDENT COMMAND CENTER",          Sc::Unit::Type::IndependentCommandCenter_Unused },
+    { "INDEPENDENT STARPORT",                Sc::Unit::Type::IndependentStarport_Unused },
+    { "INFESTED DURAN",                      Sc::Unit::Type::InfestedDuran },
+    { "INFESTED KERRIGAN (INFESTED TERRAN)", Sc::Unit::Type::InfestedKerrigan_InfestedTerran },
+    { "INVALID UNIT",                        Sc::Unit::Type::Id228 },
+    { "JUMP GATE",                           Sc::Unit::Type::IndependentJumpGate_Unused },
+    { "KAKARU (TWILIGHT)",                   Sc::Unit::Type::Kakaru_TwilightCritter },
+    { "KYADARIN CRYSTAL FORMATION",          Sc::Unit::Type::KhadarinCrystalFormation_Unused },
+    { "MINING PLATFORM",                     Sc::Unit::Type::MiningPlatform_Unused },
+    { "MINERAL CHUNK (TYPE 1)",              Sc::Unit::Type::MineralClusterType1 },
+    { "MINERAL CHUNK (TYPE 2)",              Sc::Unit::Type::MineralClusterType2 },
+    { "NORAD II (CRASHED BATTLECRUISER)",    Sc::Unit::Type::NoradII_Crashed },
+    { "PROTOSS DARK TEMPLAR",                Sc::Unit::Type::ProtossDarkTemplar },
+    { "PROTOSS UNUSED TYPE 1",               Sc::Unit::Type::UnusedProtossBuilding1 },
+    { "PROTOSS UNUSED TYPE 2",               Sc::Unit::Type::UnusedProtossBuilding2 },
+    { "RAGNASAUR (ASH WORLD)",               Sc::Unit::Type::Ragnasaur_AshworldCritter },
+    { "RUINS",                               Sc::Unit::Type::Ruins_Unused },
+    { "RHYNADON (BADLANDS)",                 Sc::Unit::Type::Rhynadon_BadlandsCritter },
+    { "RASZAGAL (DARK TEMPLAR)",             Sc::Unit::Type::Raszagal_Corsair },
+    { "SCANTID (DESERT)",                    Sc::Unit::Type::Scantid_DesertCritter },
+    { "TANK TURRET TYPE 1",                  Sc::Unit::Type::SiegeTankTurret_TankMode },
+    { "TANK TURRET TYPE 2",                  Sc::Unit::Type::SiegeTankTurret_SiegeMode },
+    { "UNUSED TERRAN BLDG TYPE 1",           Sc::Unit::Type::Starbase_Unused },
+    { "UNUSED TERRAN BLDG TYPE 2",           Sc::Unit::Type::RepairBay_Unused },
+    { "UNUSED TYPE 1",                       Sc::Unit::Type::CargoShip_Unused },
+    { "UNUSED TYPE 2",                       Sc::Unit::Type::MercenaryGunship_Unused },
+    { "UNUSED ZERG BLDG",                    Sc::Unit::Type::UnusedZergBuilding1 },
+    { "UNUSED ZERG BLDG 5",                  Sc::Unit::Type::UnusedZergBuilding2 },
+    { "URSADON (ICE WORLD)",                 Sc::Unit::Type::Ursadon_IceWorldCritter },
+    { "VULTURE SPIDER MINE",                 Sc::Unit::Type::SpiderMine },
+    { "VESPENE TANK (TERRAN TYPE 1)",        Sc::Unit::Type::TerranVespeneGasTankType1 },
+    { "VESPENE TANK (TERRAN TYPE 2)",        Sc::Unit::Type::TerranVespeneGasTankType2 },
+    { "VESPENE ORB (PROTOSS TYPE 1)",        Sc::Unit::Type::ProtossVespeneGasOrbType1 },
+    { "VESPENE ORB (PROTOSS TYPE 2)",        Sc::Unit::Type::ProtossVespeneGasOrbType2 },
+    { "VESPENE SAC (ZERG TYPE 1)",           Sc::Unit::Type::ZergVespeneGasSacType1 },
+    { "VESPENE SAC (ZERG TYPE 2)",           Sc::Unit::Type::ZergVespeneGasSacType2 },
+    { "ZERG LURKER EGG",                     Sc::Unit::Type::LurkerEgg }
+});
+
+namespace
+{
+
+constexpr size_t MinTriggersPerChunk = 128; // Texts with fewer than two chunks worth of triggers are parsed in one piece
+constexpr size_t ChunksPerWorker = 4; // Splitting into more chunks than workers lets workers that finish early pick up more
+
+struct TriggerChunk
+{
+    size_t textStart = 0; // Position in the cleaned text of the first character in the chunk
+    size_t textEnd = 0; // Position in the cleaned text following the last character in the chunk
+    size_t firstString = 0; // Index in stringContents of the first string in the chunk
+    size_t numStrings = 0;
+    u32 numLines = 0; // Number of lines passed while parsing the chunk
+    bool parsed = false;
+    std::deque<Chk::TriggerPtr> triggers;
+};
+
+// Returns the number of strings in [pos, end) of cleaned text, where each string has been reduced to a pair of quotes
+size_t countStrings(const std::string & text, size_t pos, size_t end)
+{
+    size_t numQuotes = 0;
+    for ( ; pos<end; pos++ )
+    {
+        if ( text[pos] == '\"' )
+            numQuotes ++;
+    }
+    return numQuotes/2;
+}
+
+/** Splits cleaned text into chunks of whole triggers which can be parsed independently, chunks only begin at a "TRIGGER("
+    that's outside of any brackets; leaves chunks empty if the text isn't worth splitting */
+void splitTriggers(const std::string & text, std::vector<TriggerChunk> & chunks, size_t numWorkers)
+{
+    struct TriggerStart {
+        size_t pos;
+        size_t firstString;
+    };
+    std::vector<TriggerStart> triggerStarts;
+    const char* str = text.c_str();
+    size_t size = text.size();
+    size_t depth = 0;
+    size_t numQuotes = 0;
+    for ( size_t pos=0; pos<size; pos++ )
+    {
+        switch ( str[pos] )
+        {
+            case '\"': numQuotes ++; break;
+            case '(': case '{': depth ++; break;
+            case ')': case '}': if ( depth > 0 ) depth --; break;
+            case 'T':
+                if ( depth == 0 && (pos == 0 || str[pos-1] == '\n' || str[pos-1] == '}') && text.compare(pos, 8, "TRIGGER(") == 0 )
+                    triggerStarts.push_back({pos, numQuotes/2});
+                break;
+        }
+    }
+
+    size_t numChunks = numWorkers > 1 ? std::min(triggerStarts.size()/MinTriggersPerChunk, numWorkers*ChunksPerWorker) : 0;
+    if ( numChunks <= 1 )
+        return;
+
+    chunks.resize(numChunks);
+    for ( size_t i=1; i<numChunks; i++ ) // The first chunk starts at the beginning of the text
+    {
+        const TriggerStart & chunkStart = triggerStarts[i*triggerStarts.size()/numChunks];
+        chunks[i].textStart = chunkStart.pos;
+        chunks[i].firstString = chunkStart.firstString;
+        chunks[i-1].textEnd = chunkStart.pos;
+        chunks[i-1].numStrings = chunkStart.firstString - chunks[i-1].firstString;
+    }
+    chunks.back().textEnd = size;
+    chunks.back().numStrings = numQuotes/2 - chunks.back().firstString;
+}
+
+}
+
+TextTrigCompiler::TextTrigCompiler(bool useAddressesForMemory, u32 deathTableOffset, size_t numWorkers)
+    : useAddressesForMemory(useAddressesForMemory), deathTableOffset(deathTableOffset), numWorkers(numWorkers)
 {
 
 }
@@ -24,6 +486,11 @@ TextTrigCompiler::~TextTrigCompiler()
 }
 
 bool TextTrigCompiler::compileTriggers(std::string & text, ScenarioPtr chk, Sc::Data & scData, size_t trigIndexBegin, size_t trigIndexEnd)
+{
+    return compileTriggers(text, chk, scData, trigIndexBegin, trigIndexEnd, 1);
+}
+
+bool TextTrigCompiler::compileTriggers(std::string & text, ScenarioPtr chk, Sc::Data & scData, size_t trigIndexBegin, size_t trigIndexEnd, u32 firstLine)
 {
     logger.info() << "Starting trigger compilation to replace range [" << trigIndexBegin << ", " << trigIndexEnd << ")..." << std::endl;
     auto start = std::chrono::high_resolution_clock::now();
@@ -39,11 +506,10 @@ bool TextTrigCompiler::compileTriggers(std::string & text, ScenarioPtr chk, Sc::
         std::stringstream compilerError;
         std::stringstream buildError;
 
-        if ( parseTriggers(text, stringContents, triggers, compilerError) )
+        if ( parseTriggers(text, stringContents, triggers, compilerError, firstLine) )
         {
             if ( buildNewMap(chk, trigIndexBegin, trigIndexEnd, triggers, buildError) )
             {
-                chk->triggers.trig->swap(triggers);
                 auto finish = std::chrono::high_resolution_clock::now();
                 logger.info() << "Trigger compilation completed without error in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
                 return true;
@@ -91,13 +557,70 @@ bool TextTrigCompiler::compileTrigger(std::string & text, ScenarioPtr chk, Sc::D
     return false;
 }
 
+bool TextTrigCompiler::compileChangedTriggers(std::string & text, ScenarioPtr chk, Sc::Data & scData, std::vector<u64> & triggerHashes, u64 & modificationEpoch)
+{
+    if ( chk == nullptr )
+        return false;
+
+    std::vector<size_t> triggerStarts;
+    std::vector<u64> newTriggerHashes;
+    TextTrigGenerator::hashTriggers(text, triggerStarts, newTriggerHashes);
+
+    size_t numTriggers = chk->triggers.numTriggers();
+    if ( triggerHashes.size() != numTriggers || modificationEpoch != chk->getModificationEpoch() ) // Hashes weren't recorded for the current map, compile everything
+    {
+        if ( !compileTriggers(text, chk, scData, 0, numTriggers) )
+            return false;
+
+        triggerHashes.swap(newTriggerHashes);
+        modificationEpoch = chk->getModificationEpoch();
+        return true;
+    }
+
+    size_t numNewTriggers = newTriggerHashes.size();
+    size_t numSharedTriggers = std::min(numTriggers, numNewTriggers);
+    size_t numUnchangedBefore = 0;
+    while ( numUnchangedBefore < numSharedTriggers && triggerHashes[numUnchangedBefore] == newTriggerHashes[numUnchangedBefore] )
+        numUnchangedBefore ++;
+
+    size_t numUnchangedAfter = 0;
+    while ( numUnchangedBefore + numUnchangedAfter < numSharedTriggers &&
+        triggerHashes[numTriggers-numUnchangedAfter-1] == newTriggerHashes[numNewTriggers-numUnchangedAfter-1] )
+    {
+        numUnchangedAfter ++;
+    }
+
+    if ( numUnchangedBefore == numTriggers && numTriggers == numNewTriggers )
+    {
+        logger.info() << "No triggers changed, skipping compilation" << std::endl;
+        return true;
+    }
+
+    size_t textStart = numUnchangedBefore > 0 ? (numUnchangedBefore < triggerStarts.size() ? triggerStarts[numUnchangedBefore] : text.size()) : 0;
+    size_t textEnd = numUnchangedAfter > 0 ? triggerStarts[numNewTriggers-numUnchangedAfter] : text.size();
+    u32 firstLine = 1;
+    for ( size_t pos=0; pos<textStart; pos++ ) // Count line endings the same way cleanText does so errors report lines in the full text
+    {
+        if ( text[pos] == '\n' || text[pos] == '\v' || text[pos] == '\f' || (text[pos] == '\r' && text[pos+1] != '\n') )
+            firstLine ++;
+    }
+
+    std::string changedText = text.substr(textStart, textEnd-textStart);
+    if ( !compileTriggers(changedText, chk, scData, numUnchangedBefore, numTriggers-numUnchangedAfter, firstLine) )
+        return false;
+
+    triggerHashes.swap(newTriggerHashes);
+    modificationEpoch = chk->getModificationEpoch();
+    return true;
+}
+
 bool TextTrigCompiler::parseConditionName(std::string text, Chk::Condition::Type & conditionType) const
 {
     std::vector<RawString> stringContents;
     cleanText(text, stringContents);
     Chk::Condition::VirtualType newConditionType = Chk::Condition::VirtualType::NoCondition;
 
-    if ( parseConditionName(text, newConditionType) && newConditionType != Chk::Condition::VirtualType::Custom )
+    if ( parseConditionName(text, 0, text.size(), newConditionType) && newConditionType != Chk::Condition::VirtualType::Custom )
     {
         if ( ((s32)newConditionType) < 0 )
             conditionType = extendedToRegularConditionType(newConditionType);
@@ -158,7 +681,7 @@ bool TextTrigCompiler::parseActionName(std::string text, Chk::Action::Type & act
     std::vector<RawString> stringContents;
     cleanText(text, stringContents);
     Chk::Action::VirtualType newActionType = Chk::Action::VirtualType::NoAction;
-    if ( parseActionName(text, newActionType) && newActionType != Chk::Action::VirtualType::Custom )
+    if ( parseActionName(text, 0, text.size(), newActionType) && newActionType != Chk::Action::VirtualType::Custom )
     {
         if ( ((s32)newActionType) < 0 )
             actionType = extendedToRegularActionType(newActionType);
@@ -205,8 +728,12 @@ bool TextTrigCompiler::parseActionArg(std::string actionArgText, Chk::Action::Ar
     std::stringstream argumentError;
     std::vector<RawString> stringContents = { actionArgText };
     size_t nextString = 0;
+    stringDests.assign(stringContents.size(), nullptr);
     if ( parseActionArg(txac, stringContents, nextString, action, 0, txac.size(), argument, argumentError) )
+    {
+        assignStrings(stringContents);
         return true;
+    }
     else
     {
         std::stringstream errorMessage;
@@ -247,12 +774,15 @@ void TextTrigCompiler::clearCompiler()
     unitTable.clear();
     switchTable.clear();
     groupTable.clear();
+    scriptTable.clear();
 
     unassignedStrings.clear();
     newStringTable.clear();
 
     unassignedExtendedStrings.clear();
     newExtendedStringTable.clear();
+
+    stringDests.clear();
 }
 
 void TextTrigCompiler::cleanText(std::string & text, std::vector<RawString> & stringContents) const
@@ -328,7 +858,63 @@ void TextTrigCompiler::cleanText(std::string & text, std::vector<RawString> & st
     logger.debug() << "Finished text trig cleaning in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
 }
 
-bool TextTrigCompiler::parseTriggers(std::string & text, std::vector<RawString> & stringContents, std::deque<Chk::TriggerPtr> & output, std::stringstream & error)
+bool TextTrigCompiler::parseTriggers(std::string & text, std::vector<RawString> & stringContents, std::deque<Chk::TriggerPtr> & output, std::stringstream & error, u32 firstLine)
+{
+    stringDests.assign(stringContents.size(), nullptr);
+    std::vector<TriggerChunk> chunks;
+    splitTriggers(text, chunks, numWorkers);
+
+    if ( chunks.size() <= 1 ) // Too few triggers to be worth splitting up
+    {
+        size_t nextString = 0;
+        u32 line = firstLine;
+        if ( !parseTriggers(text, stringContents, nextString, line, output, error) )
+            return false;
+    }
+    else
+    {
+        WorkerPool::run(chunks.size(), [&](size_t chunkIndex) {
+            TriggerChunk & chunk = chunks[chunkIndex];
+            std::string chunkText = text.substr(chunk.textStart, chunk.textEnd-chunk.textStart);
+            std::stringstream chunkError;
+            size_t nextString = chunk.firstString;
+            u32 line = 1;
+            chunk.parsed = parseTriggers(chunkText, stringContents, nextString, line, chunk.triggers, chunkError) &&
+                nextString == chunk.firstString + chunk.numStrings;
+            chunk.numLines = line-1;
+        }, numWorkers);
+
+        size_t nextString = 0;
+        u32 line = firstLine;
+        for ( auto & chunk : chunks )
+        {
+            if ( chunk.parsed )
+            {
+                output.insert(output.end(), chunk.triggers.begin(), chunk.triggers.end());
+                nextString += chunk.numStrings;
+                line += chunk.numLines;
+            }
+            else
+            {
+                /** The chunk might have failed only because its text was cut off at the chunk end, so the rest of the text
+                    is parsed in order from the chunk start, giving exactly the errors and line numbers of an unsplit parse */
+                std::fill(stringDests.begin()+nextString, stringDests.end(), nullptr);
+                std::string remainingText = text.substr(chunk.textStart);
+                if ( !parseTriggers(remainingText, stringContents, nextString, line, output, error) )
+                    return false;
+
+                assignStrings(stringContents);
+                return true;
+            }
+        }
+        error << "Success!";
+    }
+
+    assignStrings(stringContents);
+    return true;
+}
+
+bool TextTrigCompiler::parseTriggers(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & line, std::deque<Chk::TriggerPtr> & output, std::stringstream & error)
 {
     text.push_back('\0'); // Add a terminating null character
 
@@ -339,12 +925,10 @@ bool TextTrigCompiler::parseTriggers(std::string & text, std::vector<RawString>
         conditionEnd = 0,
         actionEnd = 0,
         flagsEnd = 0,
-        argEnd = 0,
-        nextString = 0;
+        argEnd = 0;
 
     Expecting expecting = Expecting::Trigger_EndOfText;
-    u32 line = 1,
-        argIndex = 0,
+    u32 argIndex = 0,
         numConditions = 0,
         numActions = 0;
 
@@ -482,6 +1066,50 @@ bool TextTrigCompiler::parseTriggers(std::string & text, std::vector<RawString>
     return true;
 }
 
+void TextTrigCompiler::assignStrings(std::vector<RawString> & stringContents)
+{
+    for ( size_t stringIndex=0; stringIndex<stringDests.size(); stringIndex++ )
+    {
+        if ( stringDests[stringIndex] == nullptr )
+            continue;
+
+        u32 & dest = *stringDests[stringIndex];
+        const std::string & str = stringContents[stringIndex];
+        size_t hash = strHash(str);
+        bool found = false;
+        auto matches = newStringTable.equal_range(hash);
+        for ( auto it = matches.first; it != matches.second; ++it )
+        {
+            StringTableNodePtr & node = it->second;
+            if ( node->scStr->compare<RawString>(str) == 0 )
+            {
+                if ( node->unused )
+                    node->unused = false;
+
+                if ( node->stringId == Chk::StringId::NoString )
+                    node->assignees.push_back(&dest);
+                else
+                    dest = node->stringId;
+
+                found = true;
+                break;
+            }
+        }
+
+        if ( !found )
+        {
+            StringTableNodePtr node = StringTableNodePtr(new StringTableNode({}));
+            node->unused = false;
+            node->scStr = ScStrPtr(new ScStr(str));
+            node->stringId = 0;
+            node->assignees.push_back(&dest);
+            newStringTable.insert(std::pair<size_t, StringTableNodePtr>(hash, node));
+            unassignedStrings.push_back(node);
+        }
+    }
+    stringDests.clear();
+}
+
 inline bool TextTrigCompiler::parsePartZero(std::string & text, Chk::TriggerPtr & currTrig, Chk::Condition* & currCondition, Chk::Action* & currAction, std::stringstream & error, size_t & pos, u32 & line, Expecting & expecting)
 {
     //      trigger
@@ -552,6 +1180,7 @@ inline bool TextTrigCompiler::parsePartOne(std::string & text, std::vector<RawSt
 
             if ( parseExecutingPlayer(text, stringContents, nextString, output, pos, playerEnd) )
             {
+                nextString += countStrings(text, pos, playerEnd);
                 pos = playerEnd;
                 while ( text[pos] == '\n' )
                 {
@@ -869,6 +1498,7 @@ inline bool TextTrigCompiler::parsePartFive(std::string & text, std::vector<RawS
             std::stringstream argumentError;
             if ( parseConditionArg(text, stringContents, nextString, *currCondition, pos, argEnd, argument, argumentError) )
             {
+                nextString += countStrings(text, pos, argEnd);
                 pos = argEnd;
                 argIndex ++;
             }
@@ -892,6 +1522,7 @@ inline bool TextTrigCompiler::parsePartFive(std::string & text, std::vector<RawS
             std::stringstream argumentError;
             if ( parseConditionArg(text, stringContents, nextString, *currCondition, pos, argEnd, argument, argumentError) )
             {
+                nextString += countStrings(text, pos, argEnd);
                 pos = argEnd+1;
                 argIndex ++;
             }
@@ -1098,6 +1729,7 @@ inline bool TextTrigCompiler::parsePartEight(std::string & text, std::vector<Raw
             std::stringstream argumentError;
             if ( parseActionArg(text, stringContents, nextString, *currAction, pos, argEnd, argument, argumentError) )
             {
+                nextString += countStrings(text, pos, argEnd);
                 pos = argEnd;
                 argIndex ++;
             }
@@ -1121,6 +1753,7 @@ inline bool TextTrigCompiler::parsePartEight(std::string & text, std::vector<Raw
             std::stringstream argumentError;
             if ( parseActionArg(text, stringContents, nextString, *currAction, pos, argEnd, argument, argumentError) )
             {
+                nextString += countStrings(text, pos, argEnd);
                 pos = argEnd+1;
                 argIndex ++;
             }
@@ -1239,599 +1872,51 @@ bool TextTrigCompiler::parseExecutingPlayer(std::string & text, std::vector<RawS
     return false;
 }
 
-bool TextTrigCompiler::parseConditionName(const std::string & arg, Chk::Condition::VirtualType & conditionType) const
+bool TextTrigCompiler::parseConditionName(const std::string & text, size_t pos, size_t end, Chk::Condition::VirtualType & conditionType) const
 {
-    char currChar = arg[0];
-    switch ( currChar )
-    {
-    case 'A':
-    {
-        if ( arg.compare(1, 9, "CCUMULATE") == 0 )
-            conditionType = Chk::Condition::VirtualType::Accumulate;
-        else if ( arg.compare(1, 5, "LWAYS") == 0 )
-            conditionType = Chk::Condition::VirtualType::Always;
-    }
-    break;
-
-    case 'B':
-        if ( arg.compare(1, 4, "RING") == 0 )
-            conditionType = Chk::Condition::VirtualType::Bring;
-        break;
-
-    case 'C':
-        if ( arg.compare(1, 6, "OMMAND") == 0 )
-        {
-            if ( arg.compare(7, 8, "THELEAST") == 0 )
-            {
-                if ( arg.compare(15, 2, "AT") == 0 )
-                    conditionType = Chk::Condition::VirtualType::CommandTheLeastAt;
-                else if ( arg.size() == 15 )
-                    conditionType = Chk::Condition::VirtualType::CommandTheLeast;
-            }
-            else if ( arg.compare(7, 7, "THEMOST") == 0 )
-            {
-                if ( arg.compare(14, 2, "AT") == 0 )
-                    conditionType = Chk::Condition::VirtualType::CommandTheMostAt;
-                else if ( arg.size() == 14 )
-                    conditionType = Chk::Condition::VirtualType::CommandTheMost;
-            }
-            else if ( arg.compare(7, 10, "STHEMOSTAT") == 0 ) // command'S', added for backwards compatibility
-                conditionType = Chk::Condition::VirtualType::CommandTheMostAt;
-            else if ( arg.size() == 7 )
-                conditionType = Chk::Condition::VirtualType::Command;
-        }
-        else if ( arg.compare(1, 13, "OUNTDOWNTIMER") == 0 )
-            conditionType = Chk::Condition::VirtualType::CountdownTimer;
-        else if ( arg.compare(1, 5, "USTOM") == 0 )
-            conditionType = Chk::Condition::VirtualType::Custom;
-        break;
-
-    case 'D':
-        if ( arg.compare(1, 5, "EATHS") == 0 )
-            conditionType = Chk::Condition::VirtualType::Deaths;
-        break;
-
-    case 'E':
-        if ( arg.compare(1, 10, "LAPSEDTIME") == 0 )
-            conditionType = Chk::Condition::VirtualType::ElapsedTime;
-        break;
-
-    case 'H':
-        if ( arg.compare(1, 11, "IGHESTSCORE") == 0 )
-            conditionType = Chk::Condition::VirtualType::HighestScore;
-        break;
-
-    case 'K':
-        if ( arg.compare(1, 3, "ILL") == 0 )
-            conditionType = Chk::Condition::VirtualType::Kill;
-        break;
-
-    case 'L':
-        if ( arg.compare(1, 4, "EAST") == 0 )
-        {
-            if ( arg.compare(5, 5, "KILLS") == 0 )
-                conditionType = Chk::Condition::VirtualType::LeastKills;
-            else if ( arg.compare(5, 9, "RESOURCES") == 0 )
-                conditionType = Chk::Condition::VirtualType::LeastResources;
-        }
-        else if ( arg.compare(1, 10, "OWESTSCORE") == 0 )
-            conditionType = Chk::Condition::VirtualType::LowestScore;
-        break;
-
-    case 'M':
-        if ( arg.compare(1, 5, "EMORY") == 0 )
-            conditionType = Chk::Condition::VirtualType::Memory;
-        else if ( arg.compare(1, 3, "OST") == 0 )
-        {
-            if ( arg.compare(4, 5, "KILLS") == 0 )
-                conditionType = Chk::Condition::VirtualType::MostKills;
-            else if ( arg.compare(4, 9, "RESOURCES") == 0 )
-                conditionType = Chk::Condition::VirtualType::MostResources;
-        }
-        break;
-
-    case 'N':
-        if ( arg.compare(1, 4, "EVER") == 0 )
-            conditionType = Chk::Condition::VirtualType::Never;
-        break;
-
-    case 'O':
-        if ( arg.compare(1, 8, "PPONENTS") == 0 )
-            conditionType = Chk::Condition::VirtualType::Opponents;
-        break;
-
-    case 'S':
-        if ( arg.compare(1, 4, "CORE") == 0 )
-            conditionType = Chk::Condition::VirtualType::Score;
-        else if ( arg.compare(1, 5, "WITCH") == 0 )
-            conditionType = Chk::Condition::VirtualType::Switch;
-        break;
-    }
-
-    return conditionType != Chk::Condition::VirtualType::NoCondition;
+    return conditionNames.findPrefix(&text.c_str()[pos], end-pos, conditionType);
 }
 
 bool TextTrigCompiler::parseCondition(std::string & text, size_t pos, size_t end, Chk::Condition::VirtualType & conditionType, u8 & flags)
 {
     conditionType = Chk::Condition::VirtualType::NoCondition;
-    u16 number = 0;
-
-    size_t size = end - pos;
-    std::string arg;
-
-    for ( u32 i=0; i<size; i++ ) // Copy argument to arg buffer
-    {
-        char character = text[i+pos];
-        if ( character > 96 && character < 123 ) // lower-case
-            arg.push_back(character-32); // Capitalize
-        else if ( character != ' ' && character != '\t' ) // Ignore spaces and tabs
-            arg.push_back(character);
-    }
 
-    parseConditionName(arg, conditionType);
+    parseConditionName(text, pos, end, conditionType);
 
     flags = Chk::Condition::getDefaultFlags(conditionType);
 
     return conditionType != Chk::Condition::VirtualType::NoCondition;
 }
 
-bool TextTrigCompiler::parseActionName(const std::string & arg, Chk::Action::VirtualType & actionType) const
+bool TextTrigCompiler::parseActionName(const std::string & text, size_t pos, size_t end, Chk::Action::VirtualType & actionType) const
 {
-    char currChar = arg[0];
-    switch ( currChar )
-    {
-    case 'C':
-        if ( arg.compare(1, 6, "OMMENT") == 0 )
-            actionType = Chk::Action::VirtualType::Comment;
-        else if ( arg.compare(1, 9, "REATEUNIT") == 0 )
-        {
-            if ( arg.compare(10, 14, "WITHPROPERTIES") == 0 )
-                actionType = Chk::Action::VirtualType::CreateUnitWithProperties;
-            else if ( arg.size() == 10 )
-                actionType = Chk::Action::VirtualType::CreateUnit;
-        }
-        else if ( arg.compare(1, 9, "ENTERVIEW") == 0 )
-            actionType = Chk::Action::VirtualType::CenterView;
-        else if ( arg.compare(1, 5, "USTOM") == 0 )
-            actionType = Chk::Action::VirtualType::Custom;
-        break;
-
-    case 'D':
-        if ( arg.compare(1, 17, "ISPLAYTEXTMESSAGE") == 0 )
-            actionType = Chk::Action::VirtualType::DisplayTextMessage;
-        else if ( arg.compare(1, 5, "EFEAT") == 0 )
-            actionType = Chk::Action::VirtualType::Defeat;
-        else if ( arg.compare(1, 3, "RAW") == 0 )
-            actionType = Chk::Action::VirtualType::Draw;
-        break;
-
-    case 'G':
-        if ( arg.compare(1, 16, "IVEUNITSTOPLAYER") == 0 )
-            actionType = Chk::Action::VirtualType::GiveUnitsToPlayer;
-        break;
-
-    case 'K':
-        if ( arg.compare(1, 7, "ILLUNIT") == 0 )
-        {
-            if ( arg.compare(8, 10, "ATLOCATION") == 0 )
-                actionType = Chk::Action::VirtualType::KillUnitAtLocation;
-            else if ( arg.size() == 8 )
-                actionType = Chk::Action::VirtualType::KillUnit;
-        }
-        break;
-
-    case 'L':
-        if ( arg.compare(1, 10, "EADERBOARD") == 0 )
-        {
-            if ( arg.compare(11, 4, "GOAL") == 0 )
-            {
-                if ( arg.compare(15, 7, "CONTROL") == 0 )
-                {
-                    if ( arg.compare(22, 10, "ATLOCATION") == 0 )
-                        actionType = Chk::Action::VirtualType::LeaderboardGoalCtrlAtLoc;
-                    else if ( arg.size() == 22 )
-                        actionType = Chk::Action::VirtualType::LeaderboardGoalCtrl;
-                }
-                else if ( arg.compare(15, 5, "KILLS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardGoalKills;
-                else if ( arg.compare(15, 6, "POINTS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardGoalPoints;
-                else if ( arg.compare(15, 9, "RESOURCES") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardGoalResources;
-            }
-            else
-            {
-                if ( arg.compare(11, 7, "CONTROL") == 0 )
-                {
-                    if ( arg.compare(18, 10, "ATLOCATION") == 0 )
-                        actionType = Chk::Action::VirtualType::LeaderboardCtrlAtLoc;
-                    else if ( arg.size() == 18 )
-                        actionType = Chk::Action::VirtualType::LeaderboardCtrl;
-                }
-                else if ( arg.compare(11, 5, "GREED") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardGreed;
-                else if ( arg.compare(11, 5, "KILLS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardKills;
-                else if ( arg.compare(11, 6, "POINTS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardPoints;
-                else if ( arg.compare(11, 9, "RESOURCES") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardResources;
-                else if ( arg.compare(11, 15, "COMPUTERPLAYERS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardCompPlayers;
-            }
-        }
-        break;
-
-    case 'M':
-        if ( arg.compare(1, 5, "EMORY") == 0 )
-            actionType = Chk::Action::VirtualType::SetMemory;
-        else if ( arg.compare(1, 3, "OVE") == 0 )
-        {
-            if ( arg.compare(4, 4, "UNIT") == 0 )
-                actionType = Chk::Action::VirtualType::MoveUnit;
-            else if ( arg.compare(4, 8, "LOCATION") == 0 )
-                actionType = Chk::Action::VirtualType::MoveLocation;
-        }
-        else if ( arg.compare(1, 9, "ODIFYUNIT") == 0 )
-        {
-            if ( arg.compare(10, 6, "ENERGY") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitEnergy;
-            else if ( arg.compare(10, 11, "HANGERCOUNT") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitHangerCount;
-            else if ( arg.compare(10, 9, "HITPOINTS") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitHitpoints;
-            else if ( arg.compare(10, 14, "RESOURCEAMOUNT") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitResourceAmount;
-            else if ( arg.compare(10, 12, "SHIELDPOINTS") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitShieldPoints;
-        }
-        else if ( arg.compare(1, 10, "INIMAPPING") == 0 )
-            actionType = Chk::Action::VirtualType::MinimapPing;
-        else if ( arg.compare(1, 13, "UTEUNITSPEECH") == 0 )
-            actionType = Chk::Action::VirtualType::MuteUnitSpeech;
-        break;
-
-    case 'O':
-        if ( arg.compare(1, 4, "RDER") == 0 )
-            actionType = Chk::Action::VirtualType::Order;
-        break;
-
-    case 'P':
-        if ( arg.compare(1, 14, "RESERVETRIGGER") == 0 )
-            actionType = Chk::Action::VirtualType::PreserveTrigger;
-        else if ( arg.compare(1, 6, "LAYWAV") == 0 )
-            actionType = Chk::Action::VirtualType::PlaySound;
-        else if ( arg.compare(1, 4, "AUSE") == 0 )
-        {
-            if ( arg.compare(5, 4, "GAME") == 0 )
-                actionType = Chk::Action::VirtualType::PauseGame;
-            else if ( arg.compare(5, 5, "TIMER") == 0 )
-                actionType = Chk::Action::VirtualType::PauseTimer;
-        }
-        break;
-
-    case 'R':
-        if ( arg.compare(1, 9, "EMOVEUNIT") == 0 )
-        {
-            if ( arg.compare(10, 10, "ATLOCATION") == 0 )
-                actionType = Chk::Action::VirtualType::RemoveUnitAtLocation;
-            else if ( arg.size() == 10 )
-                actionType = Chk::Action::VirtualType::RemoveUnit;
-        }
-        else if ( arg.compare(1, 10, "UNAISCRIPT") == 0 )
-        {
-            if ( arg.compare(11, 10, "ATLOCATION") == 0 )
-                actionType = Chk::Action::VirtualType::RunAiScriptAtLocation;
-            else if ( arg.size() == 11 )
-                actionType = Chk::Action::VirtualType::RunAiScript;
-        }
-        break;
-
-    case 'S':
-        if ( arg.compare(1, 2, "ET") == 0 )
-        {
-            if ( arg.compare(3, 6, "DEATHS") == 0 )
-                actionType = Chk::Action::VirtualType::SetDeaths;
-            else if ( arg.compare(3, 6, "SWITCH") == 0 )
-                actionType = Chk::Action::VirtualType::SetSwitch;
-            else if ( arg.compare(3, 9, "RESOURCES") == 0 )
-                actionType = Chk::Action::VirtualType::SetResources;
-            else if ( arg.compare(3, 5, "SCORE") == 0 )
-                actionType = Chk::Action::VirtualType::SetScore;
-            else if ( arg.compare(3, 14, "ALLIANCESTATUS") == 0 )
-                actionType = Chk::Action::VirtualType::SetAllianceStatus;
-            else if ( arg.compare(3, 14, "COUNTDOWNTIMER") == 0 )
-                actionType = Chk::Action::VirtualType::SetCountdownTimer;
-            else if ( arg.compare(3, 11, "DOODADSTATE") == 0 )
-                actionType = Chk::Action::VirtualType::SetDoodadState;
-            else if ( arg.compare(3, 13, "INVINCIBILITY") == 0 )
-                actionType = Chk::Action::VirtualType::SetInvincibility;
-            else if ( arg.compare(3, 17, "MISSIONOBJECTIVES") == 0 )
-                actionType = Chk::Action::VirtualType::SetMissionObjectives;
-            else if ( arg.compare(3, 12, "NEXTSCENARIO") == 0 )
-                actionType = Chk::Action::VirtualType::SetNextScenario;
-            else if ( arg.compare(3, 6, "MEMORY") == 0 )
-                actionType = Chk::Action::VirtualType::SetMemory;
-        }
-        break;
-
-    case 'T':
-        if ( arg.compare(1, 14, "ALKINGPORTRAIT") == 0 )
-            actionType = Chk::Action::VirtualType::TalkingPortrait;
-        else if ( arg.compare(1, 11, "RANSMISSION") == 0 )
-            actionType = Chk::Action::VirtualType::Transmission;
-        break;
+    return actionNames.findPrefix(&text.c_str()[pos], end-pos, actionType);
+}
 
-    case 'U':
-        if ( arg.compare(1, 6, "NPAUSE") == 0 )
-        {
-            if ( arg.compare(7, 5, "TIMER") == 0 )
-                actionType = Chk::Action::VirtualType::UnpauseTimer;
-            else if ( arg.compare(7, 4, "GAME") == 0 )
-                actionType = Chk::Action::VirtualType::UnpauseGame;
-        }
-        else if ( arg.compare(1, 15, "NMUTEUNITSPEECH") == 0 )
-            actionType = Chk::Action::VirtualType::MuteUnitSpeech;
-        break;
+bool TextTrigCompiler::parseAction(std::string & text, size_t pos, size_t end, Chk::Action::VirtualType & actionType, u8 & flags)
+{
+    actionType = Chk::Action::VirtualType::NoAction;
 
-    case 'V':
-        if ( arg.compare(1, 6, "ICTORY") == 0 )
-            actionType = Chk::Action::VirtualType::Victory;
-        break;
+    parseActionName(text, pos, end, actionType);
 
-    case 'W':
-        if ( arg.compare(1, 3, "AIT") == 0 )
-            actionType = Chk::Action::VirtualType::Wait;
-        break;
-    }
+    flags = Chk::Action::getDefaultFlags(actionType);
 
     return actionType != Chk::Action::VirtualType::NoAction;
 }
 
-bool TextTrigCompiler::parseAction(std::string & text, size_t pos, size_t end, Chk::Action::VirtualType & actionType, u8 & flags)
+bool TextTrigCompiler::parseConditionArg(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, Chk::Condition & currCondition, size_t pos, size_t end, Chk::Condition::Argument argument, std::stringstream & error)
 {
-    actionType = Chk::Action::VirtualType::NoAction;
-    u16 number = 0;
-
-    size_t size = end - pos;
-    std::string arg;
-
-    for ( u32 i=0; i<size; i++ ) // Copy argument to arg buffer
-    {
-        char character = text[i+pos];
-        if ( character > 96 && character < 123 ) // lower-case
-            arg.push_back(character-32); // Capitalize
-        else if ( character != ' ' && character != '\t' ) // Ignore spaces and tabs
-            arg.push_back(character);
+    // returns whether the condition was true and prints msg to the error message if false
+#define returnMsg(condition, msg)                           \
+    if ( condition )                                        \
+        return true;                                        \
+    else {                                                  \
+        error << msg;                                       \
+        return false;                                       \
     }
 
-    char currChar = arg[0];
-
-    switch ( currChar )
-    {
-    case 'C':
-        if ( arg.compare(1, 6, "OMMENT") == 0 )
-            actionType = Chk::Action::VirtualType::Comment;
-        else if ( arg.compare(1, 9, "REATEUNIT") == 0 )
-        {
-            if ( arg.compare(10, 14, "WITHPROPERTIES") == 0 )
-                actionType = Chk::Action::VirtualType::CreateUnitWithProperties;
-            else if ( arg.size() == 10 )
-                actionType = Chk::Action::VirtualType::CreateUnit;
-        }
-        else if ( arg.compare(1, 9, "ENTERVIEW") == 0 )
-            actionType = Chk::Action::VirtualType::CenterView;
-        else if ( arg.compare(1, 5, "USTOM") == 0 )
-            actionType = Chk::Action::VirtualType::Custom;
-        break;
-
-    case 'D':
-        if ( arg.compare(1, 17, "ISPLAYTEXTMESSAGE") == 0 )
-            actionType = Chk::Action::VirtualType::DisplayTextMessage;
-        else if ( arg.compare(1, 5, "EFEAT") == 0 )
-            actionType = Chk::Action::VirtualType::Defeat;
-        else if ( arg.compare(1, 3, "RAW") == 0 )
-            actionType = Chk::Action::VirtualType::Draw;
-        break;
-
-    case 'G':
-        if ( arg.compare(1, 16, "IVEUNITSTOPLAYER") == 0 )
-            actionType = Chk::Action::VirtualType::GiveUnitsToPlayer;
-        break;
-
-    case 'K':
-        if ( arg.compare(1, 7, "ILLUNIT") == 0 )
-        {
-            if ( arg.compare(8, 10, "ATLOCATION") == 0 )
-                actionType = Chk::Action::VirtualType::KillUnitAtLocation;
-            else if ( arg.size() == 8 )
-                actionType = Chk::Action::VirtualType::KillUnit;
-        }
-        break;
-
-    case 'L':
-        if ( arg.compare(1, 10, "EADERBOARD") == 0 )
-        {
-            if ( arg.compare(11, 4, "GOAL") == 0 )
-            {
-                if ( arg.compare(15, 7, "CONTROL") == 0 )
-                {
-                    if ( arg.compare(22, 10, "ATLOCATION") == 0 )
-                        actionType = Chk::Action::VirtualType::LeaderboardGoalCtrlAtLoc;
-                    else if ( arg.size() == 22 )
-                        actionType = Chk::Action::VirtualType::LeaderboardGoalCtrl;
-                }
-                else if ( arg.compare(15, 5, "KILLS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardGoalKills;
-                else if ( arg.compare(15, 6, "POINTS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardGoalPoints;
-                else if ( arg.compare(15, 9, "RESOURCES") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardGoalResources;
-            }
-            else
-            {
-                if ( arg.compare(11, 7, "CONTROL") == 0 )
-                {
-                    if ( arg.compare(18, 10, "ATLOCATION") == 0 )
-                        actionType = Chk::Action::VirtualType::LeaderboardCtrlAtLoc;
-                    else if ( arg.size() == 18 )
-                        actionType = Chk::Action::VirtualType::LeaderboardCtrl;
-                }
-                else if ( arg.compare(11, 5, "GREED") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardGreed;
-                else if ( arg.compare(11, 5, "KILLS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardKills;
-                else if ( arg.compare(11, 6, "POINTS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardPoints;
-                else if ( arg.compare(11, 9, "RESOURCES") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardResources;
-                else if ( arg.compare(11, 15, "COMPUTERPLAYERS") == 0 )
-                    actionType = Chk::Action::VirtualType::LeaderboardCompPlayers;
-            }
-        }
-        break;
-
-    case 'M':
-        if ( arg.compare(1, 5, "EMORY") == 0 )
-            actionType = Chk::Action::VirtualType::SetMemory;
-        else if ( arg.compare(1, 3, "OVE") == 0 )
-        {
-            if ( arg.compare(4, 4, "UNIT") == 0 )
-                actionType = Chk::Action::VirtualType::MoveUnit;
-            else if ( arg.compare(4, 8, "LOCATION") == 0 )
-                actionType = Chk::Action::VirtualType::MoveLocation;
-        }
-        else if ( arg.compare(1, 9, "ODIFYUNIT") == 0 )
-        {
-            if ( arg.compare(10, 6, "ENERGY") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitEnergy;
-            else if ( arg.compare(10, 11, "HANGERCOUNT") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitHangerCount;
-            else if ( arg.compare(10, 9, "HITPOINTS") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitHitpoints;
-            else if ( arg.compare(10, 14, "RESOURCEAMOUNT") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitResourceAmount;
-            else if ( arg.compare(10, 12, "SHIELDPOINTS") == 0 )
-                actionType = Chk::Action::VirtualType::ModifyUnitShieldPoints;
-        }
-        else if ( arg.compare(1, 10, "INIMAPPING") == 0 )
-            actionType = Chk::Action::VirtualType::MinimapPing;
-        else if ( arg.compare(1, 13, "UTEUNITSPEECH") == 0 )
-            actionType = Chk::Action::VirtualType::MuteUnitSpeech;
-        break;
-
-    case 'O':
-        if ( arg.compare(1, 4, "RDER") == 0 )
-            actionType = Chk::Action::VirtualType::Order;
-        break;
-
-    case 'P':
-        if ( arg.compare(1, 14, "RESERVETRIGGER") == 0 )
-            actionType = Chk::Action::VirtualType::PreserveTrigger;
-        else if ( arg.compare(1, 6, "LAYWAV") == 0 )
-            actionType = Chk::Action::VirtualType::PlaySound;
-        else if ( arg.compare(1, 4, "AUSE") == 0 )
-        {
-            if ( arg.compare(5, 4, "GAME") == 0 )
-                actionType = Chk::Action::VirtualType::PauseGame;
-            else if ( arg.compare(5, 5, "TIMER") == 0 )
-                actionType = Chk::Action::VirtualType::PauseTimer;
-        }
-        break;
-
-    case 'R':
-        if ( arg.compare(1, 9, "EMOVEUNIT") == 0 )
-        {
-            if ( arg.compare(10, 10, "ATLOCATION") == 0 )
-                actionType = Chk::Action::VirtualType::RemoveUnitAtLocation;
-            else if ( arg.size() == 10 )
-                actionType = Chk::Action::VirtualType::RemoveUnit;
-        }
-        else if ( arg.compare(1, 10, "UNAISCRIPT") == 0 )
-        {
-            if ( arg.compare(11, 10, "ATLOCATION") == 0 )
-                actionType = Chk::Action::VirtualType::RunAiScriptAtLocation;
-            else if ( arg.size() == 11 )
-                actionType = Chk::Action::VirtualType::RunAiScript;
-        }
-        break;
-
-    case 'S':
-        if ( arg.compare(1, 2, "ET") == 0 )
-        {
-            if ( arg.compare(3, 6, "DEATHS") == 0 )
-                actionType = Chk::Action::VirtualType::SetDeaths;
-            else if ( arg.compare(3, 6, "SWITCH") == 0 )
-                actionType = Chk::Action::VirtualType::SetSwitch;
-            else if ( arg.compare(3, 9, "RESOURCES") == 0 )
-                actionType = Chk::Action::VirtualType::SetResources;
-            else if ( arg.compare(3, 5, "SCORE") == 0 )
-                actionType = Chk::Action::VirtualType::SetScore;
-            else if ( arg.compare(3, 14, "ALLIANCESTATUS") == 0 )
-                actionType = Chk::Action::VirtualType::SetAllianceStatus;
-            else if ( arg.compare(3, 14, "COUNTDOWNTIMER") == 0 )
-                actionType = Chk::Action::VirtualType::SetCountdownTimer;
-            else if ( arg.compare(3, 11, "DOODADSTATE") == 0 )
-                actionType = Chk::Action::VirtualType::SetDoodadState;
-            else if ( arg.compare(3, 13, "INVINCIBILITY") == 0 )
-                actionType = Chk::Action::VirtualType::SetInvincibility;
-            else if ( arg.compare(3, 17, "MISSIONOBJECTIVES") == 0 )
-                actionType = Chk::Action::VirtualType::SetMissionObjectives;
-            else if ( arg.compare(3, 12, "NEXTSCENARIO") == 0 )
-                actionType = Chk::Action::VirtualType::SetNextScenario;
-            else if ( arg.compare(3, 6, "MEMORY") == 0 )
-                actionType = Chk::Action::VirtualType::SetMemory;
-        }
-        break;
-
-    case 'T':
-        if ( arg.compare(1, 14, "ALKINGPORTRAIT") == 0 )
-            actionType = Chk::Action::VirtualType::TalkingPortrait;
-        else if ( arg.compare(1, 11, "RANSMISSION") == 0 )
-            actionType = Chk::Action::VirtualType::Transmission;
-        break;
-
-    case 'U':
-        if ( arg.compare(1, 6, "NPAUSE") == 0 )
-        {
-            if ( arg.compare(7, 5, "TIMER") == 0 )
-                actionType = Chk::Action::VirtualType::UnpauseTimer;
-            else if ( arg.compare(7, 4, "GAME") == 0 )
-                actionType = Chk::Action::VirtualType::UnpauseGame;
-        }
-        else if ( arg.compare(1, 15, "NMUTEUNITSPEECH") == 0 )
-            actionType = Chk::Action::VirtualType::UnmuteUnitSpeech;
-        break;
-
-    case 'V':
-        if ( arg.compare(1, 6, "ICTORY") == 0 )
-            actionType = Chk::Action::VirtualType::Victory;
-        break;
-
-    case 'W':
-        if ( arg.compare(1, 3, "AIT") == 0 )
-            actionType = Chk::Action::VirtualType::Wait;
-        break;
-    }
-
-    flags = Chk::Action::getDefaultFlags(actionType);
-
-    return actionType != Chk::Action::VirtualType::NoAction;
-}
-
-bool TextTrigCompiler::parseConditionArg(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, Chk::Condition & currCondition, size_t pos, size_t end, Chk::Condition::Argument argument, std::stringstream & error)
-{
-    // returns whether the condition was true and prints msg to the error message if false
-#define returnMsg(condition, msg)                           \
-    if ( condition )                                        \
-        return true;                                        \
-    else {                                                  \
-        error << msg;                                       \
-        return false;                                       \
-    }
-
-    Chk::Condition::ArgType argType = argument.type;
-    switch ( argType )
+    Chk::Condition::ArgType argType = argument.type;
+    switch ( argType )
     {
         case Chk::Condition::ArgType::Unit:
             returnMsg( parseUnitName(text, stringContents, nextString, currCondition.unitType, pos, end) ||
@@ -2041,39 +2126,7 @@ bool TextTrigCompiler::parseString(std::string & text, std::vector<RawString> &
     }
     else if ( pos < end && text[pos] == '\"' )
     {
-        const std::string & str = stringContents[nextString];
-        nextString++;
-        
-        size_t hash = strHash(str);
-        auto matches = newStringTable.equal_range(hash);
-        if ( matches.first != newStringTable.end() && matches.first->first == hash )
-        {
-            for ( auto it = matches.first; it != matches.second; ++it )
-            {
-                StringTableNodePtr & node = it->second;
-                if ( node->scStr->compare<RawString>(str) == 0 )
-                {
-                    if ( node->unused )
-                        node->unused = false;
-
-                    if ( node->stringId == Chk::StringId::NoString )
-                        node->assignees.push_back(&dest);
-                    else
-                        dest = node->stringId;
-
-                    return true;
-                }
-            }
-        }
-
-        // No matches
-        StringTableNodePtr node = StringTableNodePtr(new StringTableNode({}));
-        node->unused = false;
-        node->scStr = ScStrPtr(new ScStr(str));
-        node->stringId = 0;
-        node->assignees.push_back(&dest);
-        newStringTable.insert(std::pair<size_t, StringTableNodePtr>(strHash(str), node));
-        unassignedStrings.push_back(node);
+        stringDests[nextString] = &dest; // Strings are found or added in text order by assignStrings once parsing completes
         return true;
     }
     else
@@ -2082,7 +2135,8 @@ bool TextTrigCompiler::parseString(std::string & text, std::vector<RawString> &
 
 bool TextTrigCompiler::parseLocationName(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & dest, size_t pos, size_t end) const
 {
-    std::string str;
+    const char* name = nullptr;
+    size_t length = 0;
     if ( text.compare(pos, end-pos, "NOLOCATION") == 0 )
     {
         dest = 0;
@@ -2090,632 +2144,56 @@ bool TextTrigCompiler::parseLocationName(std::string & text, std::vector<RawStri
     }
     else if ( pos < end && text[pos] == '\"' )
     {
-        str = stringContents[nextString];
-        nextString ++;
+        name = stringContents[nextString].c_str();
+        length = stringContents[nextString].size();
     }
     else if ( parseLong(text, dest, pos, end) )
         return true;
     else
-        str = text.substr(pos, end-pos);
-
-    bool success = false;
+    {
+        name = &text.c_str()[pos];
+        length = end-pos;
+    }
 
-    if ( str.compare("anywhere") == 0 ) // Capitalize lower-case anywhere's
-        str[0] = 'A';
+    if ( length == 8 && std::strncmp(name, "anywhere", 8) == 0 ) // Capitalize lower-case anywhere's
+        name = "Anywhere";
 
-    // Grab the string hash
-    size_t hash = strHash(str);
-    size_t numMatching = locationTable.count(hash);
-    if ( numMatching == 1 )
-    { // Should guarentee that you can find at least one entry
-        const LocationTableNode & node = locationTable.find(hash)->second;
-        if ( node.locationName.compare(str) == 0 )
-        {
-            dest = node.locationId;
-            success = true;
-        }
-    }
-    else if ( numMatching > 1 )
+    u8 locationId = 0;
+    if ( locationTable.find(name, length, locationId) )
     {
-        auto range = locationTable.equal_range(hash);
-        for ( auto & pair = range.first; pair != range.second; ++pair )
-        {
-            const LocationTableNode & node = pair->second;
-            if ( node.locationName.compare(str) == 0 )
-            {
-                if ( success == false ) // If no matches have previously been found
-                {
-                    dest = node.locationId;
-                    success = true;
-                }
-                else // If matches have previously been found
-                {
-                    if ( u32(node.locationId) < dest )
-                        dest = node.locationId; // Replace if locationNum < previous locationNum
-                }
-            }
-        }
+        dest = locationId;
+        return true;
     }
-    return success;
+    return false;
 }
 
 bool TextTrigCompiler::parseUnitName(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, Sc::Unit::Type & dest, size_t pos, size_t end) const
 {
-    std::string str;
+    const char* name = nullptr;
+    size_t length = 0;
     if ( text[pos] == '\"' ) // If quoted, ignore quotes
     {
         if ( end-pos < 2 )
             return false;
 
-        str = stringContents[nextString];
-        nextString ++;
-        pos = 0;
-        end = str.size();
+        name = stringContents[nextString].c_str();
+        length = stringContents[nextString].size();
     }
     else if ( parseShort(text, (u16 &)dest, pos, end) )
         return true;
     else
-        str = text.substr(pos, end-pos);
-
-    bool success = false;
-    size_t size = str.size();
-    char unit[40] = {};
-    if ( size < 40 )
     {
-        // Take an upper case copy of the name
-        for ( int i=0; i<size; i++ )
-        {
-            char currChar = str[i];
-            if ( currChar > 96 && currChar < 123 )
-                unit[i] = currChar - 32;
-            else
-                unit[i] = currChar;
-        }
-        unit[size] = '\0';
-
-        switch ( unit[0] ) // First search standard unit names
-        {
-        case 'A':
-            if      ( strcmp(&unit[1], "LAN SCHEZAR (GOLIATH)"         ) == 0 ) { dest = Sc::Unit::Type::AlanSchezar_Goliath; success = true; }
-            else if ( strcmp(&unit[1], "LAN SCHEZAR TURRET"            ) == 0 ) { dest = Sc::Unit::Type::AlanTurret; success = true; }
-            else if ( strcmp(&unit[1], "LDARIS (TEMPLAR)"              ) == 0 ) { dest = Sc::Unit::Type::Aldaris_Templar; success = true; }
-            else if ( strcmp(&unit[1], "LEXEI STUKOV (GHOST)"          ) == 0 ) { dest = Sc::Unit::Type::AlexeiStukov_Ghost; success = true; }
-            else if ( strcmp(&unit[1], "NY UNIT"                       ) == 0 ) { dest = Sc::Unit::Type::AnyUnit; success = true; }
-            else if ( strcmp(&unit[1], "RCTURUS MENGSK (BATTLECRUISER)") == 0 ) { dest = Sc::Unit::Type::ArcturusMengsk_Battlecruiser; success = true; }
-            else if ( strcmp(&unit[1], "RTANIS (SCOUT)"                ) == 0 ) { dest = Sc::Unit::Type::Artanis_Scout; success = true; }
-            break;
-        case 'B':
-            if      ( strcmp(&unit[1], "ENGALAAS (JUNGLE CRITTER)") == 0 ) { dest = Sc::Unit::Type::Bengalaas_Jungle; success = true; }
-            else if ( strcmp(&unit[1], "UILDINGS"                 ) == 0 ) { dest = Sc::Unit::Type::Buildings; success = true; }
-            break;
-        case 'C':
-            if      ( strcmp(&unit[1], "ARGO SHIP (UNUSED)") == 0 ) { dest = Sc::Unit::Type::CargoShip_Unused; success = true; }
-            else if ( strcmp(&unit[1], "ATINA (UNUSED)"    ) == 0 ) { dest = Sc::Unit::Type::Cantina; success = true; }
-            else if ( strcmp(&unit[1], "AVE (UNUSED)"      ) == 0 ) { dest = Sc::Unit::Type::Cave; success = true; }
-            else if ( strcmp(&unit[1], "AVE-IN (UNUSED)"   ) == 0 ) { dest = Sc::Unit::Type::CaveIn; success = true; }
-            break;
-        case 'D':
-            if      ( strcmp(&unit[1], "ANIMOTH (ARBITER)"      ) == 0 ) { dest = Sc::Unit::Type::Danimoth_Arbiter; success = true; }
-            else if ( strcmp(&unit[1], "ARK SWARM"              ) == 0 ) { dest = Sc::Unit::Type::DarkSwarm; success = true; }
-            else if ( strcmp(&unit[1], "ATA DISC"               ) == 0 ) { dest = Sc::Unit::Type::DataDisc; success = true; }
-            else if ( strcmp(&unit[1], "EVOURING ONE (ZERGLING)") == 0 ) { dest = Sc::Unit::Type::DevouringOne_Zergling; success = true; }
-            else if ( strcmp(&unit[1], "ISRUPTION WEB"          ) == 0 ) { dest = Sc::Unit::Type::DisruptionField; success = true; }
-            break;
-        case 'E':
-            if      ( strcmp(&unit[1], "DMUND DUKE (SIEGE MODE)"       ) == 0 ) { dest = Sc::Unit::Type::EdmundDuke_SiegeMode; success = true; }
-            else if ( strcmp(&unit[1], "DMUND DUKE (TANK MODE)"        ) == 0 ) { dest = Sc::Unit::Type::EdmundDuke_SiegeTank; success = true; }
-            else if ( strcmp(&unit[1], "DMUND DUKE TURRET (SIEGE MODE)") == 0 ) { dest = Sc::Unit::Type::DukeTurretType2; success = true; }
-            else if ( strcmp(&unit[1], "DMUND DUKE TURRET (TANK MODE)" ) == 0 ) { dest = Sc::Unit::Type::DukeTurretType1; success = true; }
-            break;
-        case 'F':
-            if      ( strcmp(&unit[1], "ACTORIES"           ) == 0 ) { dest = Sc::Unit::Type::Factories; success = true; }
-            else if ( strcmp(&unit[1], "ENIX (DRAGOON)"     ) == 0 ) { dest = Sc::Unit::Type::Fenix_Dragoon; success = true; }
-            else if ( strcmp(&unit[1], "ENIX (ZEALOT)"      ) == 0 ) { dest = Sc::Unit::Type::Fenix_Zealot; success = true; }
-            else if ( strcmp(&unit[1], "LAG"                ) == 0 ) { dest = Sc::Unit::Type::Flag; success = true; }
-            else if ( strcmp(&unit[1], "LOOR GUN TRAP"      ) == 0 ) { dest = Sc::Unit::Type::FloorGunTrap; success = true; }
-            else if ( strcmp(&unit[1], "LOOR HATCH (UNUSED)") == 0 ) { dest = Sc::Unit::Type::FloorHatch_Unused; success = true; }
-            else if ( strcmp(&unit[1], "LOOR MISSILE TRAP"  ) == 0 ) { dest = Sc::Unit::Type::FloorMissileTrap; success = true; }
-            break;
-        case 'G':
-            if      ( strcmp(&unit[1], "ANTRITHOR (CARRIER)"          ) == 0 ) { dest = Sc::Unit::Type::Gantrithor_Carrier; success = true; }
-            else if ( strcmp(&unit[1], "ERARD DUGALLE (BATTLECRUISER)") == 0 ) { dest = Sc::Unit::Type::GerardDuGalle_BattleCruiser; success = true; }
-            else if ( strcmp(&unit[1], "OLIATH TURRET"                ) == 0 ) { dest = Sc::Unit::Type::GoliathTurret; success = true; }
-            else if ( strcmp(&unit[1], "UI MONTAG (FIREBAT)"          ) == 0 ) { dest = Sc::Unit::Type::GuiMontag_Firebat; success = true; }
-            break;
-        case 'H':
-            if      ( strcmp(&unit[1], "UNTER KILLER (HYDRALISK)") == 0 ) { dest = Sc::Unit::Type::HunterKiller_Hydralisk; success = true; }
-            else if ( strcmp(&unit[1], "YPERION (BATTLECRUISER)" ) == 0 ) { dest = Sc::Unit::Type::Hyperion_Battlecruiser; success = true; }
-            break;
-        case 'I':
-            if ( unit[1] == 'D' && unit[2] == ':' )
-                success = parseShort(unit, (u16 &)dest, 3, size);
-            else if ( strcmp(&unit[1], "NDEPENDENT COMMAND CENTER (UNUSED)"  ) == 0 ) { dest = Sc::Unit::Type::IndependentCommandCenter_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NDEPENDENT JUMP GATE (UNUSED)"       ) == 0 ) { dest = Sc::Unit::Type::IndependentJumpGate_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NDEPENDENT STARPORT (UNUSED)"        ) == 0 ) { dest = Sc::Unit::Type::IndependentStarport_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NFESTED COMMAND CENTER"              ) == 0 ) { dest = Sc::Unit::Type::InfestedCommandCenter; success = true; }
-            else if ( strcmp(&unit[1], "NFESTED DURAN (INFESTED TERRAN)"     ) == 0 ) { dest = Sc::Unit::Type::InfestedDuran; success = true; }
-            else if ( strcmp(&unit[1], "NFESTED KERRIGAN (INFESTED TERRAIN)" ) == 0 ) { dest = Sc::Unit::Type::InfestedKerrigan_InfestedTerran; success = true; }
-            else if ( strcmp(&unit[1], "NFESTED TERRAN"                      ) == 0 ) { dest = Sc::Unit::Type::InfestedTerran; success = true; }
-            else if ( strcmp(&unit[1], "ON CANNON"                           ) == 0 ) { dest = Sc::Unit::Type::IonCannon; success = true; }
-            break;
-        case 'J':
-            if      ( strcmp(&unit[1], "IM RAYNOR (MARINE)" ) == 0 ) { dest = Sc::Unit::Type::JimRaynor_Marine; success = true; }
-            else if ( strcmp(&unit[1], "IM RAYNOR (VULTURE)") == 0 ) { dest = Sc::Unit::Type::JimRaynor_Vulture; success = true; }
-            break;
-        case 'K':
-            if      ( strcmp(&unit[1], "AKARU (TWILIGHT CRITTER)"          ) == 0 ) { dest = Sc::Unit::Type::Kakaru_TwilightCritter; success = true; }
-            else if ( strcmp(&unit[1], "HADARIN CRYSTAL FORMATION (UNUSED)") == 0 ) { dest = Sc::Unit::Type::KhadarinCrystalFormation_Unused; success = true; }
-            else if ( strcmp(&unit[1], "HALIS CRYSTAL"                     ) == 0 ) { dest = Sc::Unit::Type::KhalisCrystal; success = true; }
-            else if ( strcmp(&unit[1], "HAYDARIN CRYSTAL"                  ) == 0 ) { dest = Sc::Unit::Type::KhaydarinCrystal; success = true; }
-            else if ( strcmp(&unit[1], "HAYDARIN CRYSTAL FORMATION"        ) == 0 ) { dest = Sc::Unit::Type::KhaydarinCrystalFormation; success = true; }
-            else if ( strcmp(&unit[1], "UKULZA (GUARDIAN)"                 ) == 0 ) { dest = Sc::Unit::Type::Kukulza_Guardian; success = true; }
-            else if ( strcmp(&unit[1], "UKULZA (MUTALISK)"                 ) == 0 ) { dest = Sc::Unit::Type::Kukulza_Mutalisk; success = true; }
-            break;
-        case 'L':
-            if      ( strcmp(&unit[1], "EFT PIT DOOR"         ) == 0 ) { dest = Sc::Unit::Type::LeftPitDoor; success = true; }
-            else if ( strcmp(&unit[1], "EFT UPPER LEVEL DOOR" ) == 0 ) { dest = Sc::Unit::Type::LeftUpperLevelDoor; success = true; }
-            else if ( strcmp(&unit[1], "EFT WALL FLAME TRAP"  ) == 0 ) { dest = Sc::Unit::Type::LeftWallFlameTrap; success = true; }
-            else if ( strcmp(&unit[1], "EFT WALL MISSILE TRAP") == 0 ) { dest = Sc::Unit::Type::LeftWallMissileTrap; success = true; }
-            else if ( strcmp(&unit[1], "URKER EGG"            ) == 0 ) { dest = Sc::Unit::Type::LurkerEgg; success = true; }
-            break;
-        case 'M':
-            if      ( strcmp(&unit[1], "AGELLAN (SCIENCE VESSEL)" ) == 0 ) { dest = Sc::Unit::Type::Magellan_ScienceVessel; success = true; }
-            else if ( strcmp(&unit[1], "AP REVEALER"              ) == 0 ) { dest = Sc::Unit::Type::MapRevealer; success = true; }
-            else if ( strcmp(&unit[1], "ATRIARCH (QUEEN)"         ) == 0 ) { dest = Sc::Unit::Type::Matriarch_Queen; success = true; }
-            else if ( strcmp(&unit[1], "ATURE CRYSALIS"           ) == 0 ) { dest = Sc::Unit::Type::MatureCrysalis; success = true; }
-            else if ( strcmp(&unit[1], "EN"                       ) == 0 ) { dest = Sc::Unit::Type::Men; success = true; }
-            else if ( strcmp(&unit[1], "ERCENARY GUNSHIP (UNUSED)") == 0 ) { dest = Sc::Unit::Type::MercenaryGunship_Unused; success = true; }
-            else if ( strcmp(&unit[1], "INERAL CLUSTER TYPE 1"    ) == 0 ) { dest = Sc::Unit::Type::MineralClusterType1; success = true; }
-            else if ( strcmp(&unit[1], "INERAL CLUSTER TYPE 2"    ) == 0 ) { dest = Sc::Unit::Type::MineralClusterType2; success = true; }
-            else if ( strcmp(&unit[1], "INERAL FIELD (TYPE 1)"    ) == 0 ) { dest = Sc::Unit::Type::MineralFieldType1; success = true; }
-            else if ( strcmp(&unit[1], "INERAL FIELD (TYPE 2)"    ) == 0 ) { dest = Sc::Unit::Type::MineralFieldType2; success = true; }
-            else if ( strcmp(&unit[1], "INERAL FIELD (TYPE 3)"    ) == 0 ) { dest = Sc::Unit::Type::MineralFieldType3; success = true; }
-            else if ( strcmp(&unit[1], "INING PLATFORM (UNUSED)"  ) == 0 ) { dest = Sc::Unit::Type::MiningPlatform_Unused; success = true; }
-            else if ( strcmp(&unit[1], "OJO (SCOUT)"              ) == 0 ) { dest = Sc::Unit::Type::Mojo_Scout; success = true; }
-            else if ( strcmp(&unit[1], "UTALISK COCOON"           ) == 0 ) { dest = Sc::Unit::Type::Cocoon; success = true; }
-            break;
-        case 'N':
-            if      ( strcmp(&unit[1], "ORAD II (BATTLECRUISER)") == 0 ) { dest = Sc::Unit::Type::NoradII_Battlecruiser; success = true; }
-            else if ( strcmp(&unit[1], "ORAD II (CRASHED)"      ) == 0 ) { dest = Sc::Unit::Type::NoradII_Crashed; success = true; }
-            else if ( strcmp(&unit[1], "UCLEAR MISSILE"         ) == 0 ) { dest = Sc::Unit::Type::NuclearMissile; success = true; }
-            break;
-        case 'O':
-            if      ( strcmp(&unit[1], "VERMIND COCOON") == 0 ) { dest = Sc::Unit::Type::OvermindCocoon; success = true; }
-            break;
-        case 'P':
-            if ( unit[1] == 'R' )
-            {
-                switch ( unit[8] )
-                {
-                case 'A':
-                    if      ( strcmp(&unit[2], "OTOSS ARBITER"         ) == 0 ) { dest = Sc::Unit::Type::ProtossArbiter; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS ARBITER TRIBUNAL") == 0 ) { dest = Sc::Unit::Type::ProtossArbiterTribunal; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS ARCHON"          ) == 0 ) { dest = Sc::Unit::Type::ProtossArchon; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS ASSIMILATOR"    ) == 0 ) { dest = Sc::Unit::Type::ProtossAssimilator; success = true; }
-                    break;
-                case 'B':
-                    if ( strcmp(&unit[2], "OTOSS BEACON") == 0 ) { dest = Sc::Unit::Type::ProtossBeacon; success = true; }
-                    break;
-                case 'C':
-                    if      ( strcmp(&unit[2], "OTOSS CARRIER"         ) == 0 ) { dest = Sc::Unit::Type::ProtossCarrier; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS CITADEL OF ADUN" ) == 0 ) { dest = Sc::Unit::Type::ProtossCitadelOfAdum; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS CORSAIR"         ) == 0 ) { dest = Sc::Unit::Type::ProtossCorsair; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS CYBERNETICS CORE") == 0 ) { dest = Sc::Unit::Type::ProtossCyberneticsCore; success = true; }
-                    break;
-                case 'D':
-                    if      ( strcmp(&unit[2], "OTOSS DARK ARCHON"        ) == 0 ) { dest = Sc::Unit::Type::ProtossDarkArchon; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS DARK TEMPLAR (HERO)") == 0 ) { dest = Sc::Unit::Type::DarkTemplar_Hero; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS DARK TEMPLAR (UNIT)") == 0 ) { dest = Sc::Unit::Type::ProtossDarkTemplar; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS DRAGOON"            ) == 0 ) { dest = Sc::Unit::Type::ProtossDragoon; success = true; }
-                    break;
-                case 'F':
-                    if      ( strcmp(&unit[2], "OTOSS FLAG BEACON" ) == 0 ) { dest = Sc::Unit::Type::ProtossFlagBeacon; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS FLEET BEACON") == 0 ) { dest = Sc::Unit::Type::ProtossFleetBeacon; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS FORGE"       ) == 0 ) { dest = Sc::Unit::Type::ProtossForge; success = true; }
-                    break;
-                case 'G':
-                    if ( strcmp(&unit[2], "OTOSS GATEWAY") == 0 ) { dest = Sc::Unit::Type::ProtossGateway; success = true; }
-                    break;
-                case 'H':
-                    if ( strcmp(&unit[2], "OTOSS HIGH TEMPLAR") == 0 ) { dest = Sc::Unit::Type::ProtossHighTemplar; success = true; }
-                    break;
-                case 'I':
-                    if ( strcmp(&unit[2], "OTOSS INTERCEPTOR") == 0 ) { dest = Sc::Unit::Type::ProtossInterceptor; success = true; }
-                    break;
-                case 'M':
-                    if ( strcmp(&unit[2], "OTOSS MARKER") == 0 ) { dest = Sc::Unit::Type::ProtossMarker; success = true; }
-                    break;
-                case 'N':
-                    if ( strcmp(&unit[2], "OTOSS NEXUS") == 0 ) { dest = Sc::Unit::Type::ProtossNexus; success = true; }
-                    break;
-                case 'O':
-                    if      ( strcmp(&unit[2], "OTOSS OBSERVATORY") == 0 ) { dest = Sc::Unit::Type::ProtossObservatory; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS OBSERVER"   ) == 0 ) { dest = Sc::Unit::Type::ProtossObserver; success = true; }
-                    break;
-                case 'P':
-                    if      ( strcmp(&unit[2], "OTOSS PHOTON CANNON") == 0 ) { dest = Sc::Unit::Type::ProtossPhotonCannon; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS PROBE"        ) == 0 ) { dest = Sc::Unit::Type::ProtossProbe; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS PYLON"        ) == 0 ) { dest = Sc::Unit::Type::ProtossPylon; success = true; }
-                    break;
-                case 'R':
-                    if      ( strcmp(&unit[2], "OTOSS REAVER"              ) == 0 ) { dest = Sc::Unit::Type::ProtossReaver; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS ROBOTICS FACILITY"   ) == 0 ) { dest = Sc::Unit::Type::ProtossRoboticsFacility; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS ROBOTICS SUPPORT BAY") == 0 ) { dest = Sc::Unit::Type::ProtossRoboticsSupportBay; success = true; }
-                    break;
-                case 'S':
-                    if      ( strcmp(&unit[2], "OTOSS SCARAB"        ) == 0 ) { dest = Sc::Unit::Type::ProtossScarab; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS SCOUT"         ) == 0 ) { dest = Sc::Unit::Type::ProtossScout; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS SHIELD BATTERY") == 0 ) { dest = Sc::Unit::Type::ProtossShieldBattery; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS SHUTTLE"       ) == 0 ) { dest = Sc::Unit::Type::ProtossShuttle; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS STARGATE"      ) == 0 ) { dest = Sc::Unit::Type::ProtossStargate; success = true; }
-                    break;
-                case 'T':
-                    if      ( strcmp(&unit[2], "OTOSS TEMPLAR ARCHIVES") == 0 ) { dest = Sc::Unit::Type::ProtossTemplarArchives; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS TEMPLE"          ) == 0 ) { dest = Sc::Unit::Type::ProtossTemple; success = true; }
-                    break;
-                case 'V':
-                    if      ( strcmp(&unit[2], "OTOSS VESPENE GAS ORB TYPE 1") == 0 ) { dest = Sc::Unit::Type::ProtossVespeneGasOrbType1; success = true; }
-                    else if ( strcmp(&unit[2], "OTOSS VESPENE GAS ORB TYPE 2") == 0 ) { dest = Sc::Unit::Type::ProtossVespeneGasOrbType2; success = true; }
-                    break;
-                case 'Z':
-                    if ( strcmp(&unit[2], "OTOSS ZEALOT") == 0 ) { dest = Sc::Unit::Type::ProtossZealot; success = true; }
-                    break;
-                }
-            }
-            else if ( unit[1] == 'S' )
-            {
-                if      ( strcmp(&unit[2], "I DISRUPTER") == 0 ) { dest = Sc::Unit::Type::PsiDistrupter; success = true; }
-                else if ( strcmp(&unit[2], "I EMITTER"  ) == 0 ) { dest = Sc::Unit::Type::PsiEmitter; success = true; }
-            }
-            else if ( strcmp(&unit[1], "OWER GENERATOR") == 0 ) { dest = Sc::Unit::Type::PowerGenerator; success = true; }
-            break;
-        case 'R':
-            if      ( strcmp(&unit[1], "AGNASAUR (ASHWORLD CRITTER)") == 0 ) { dest = Sc::Unit::Type::Ragnasaur_AshworldCritter; success = true; }
-            else if ( strcmp(&unit[1], "ASZAGAL (CORSAIR)"          ) == 0 ) { dest = Sc::Unit::Type::Raszagal_Corsair; success = true; }
-            else if ( strcmp(&unit[1], "EPAIR BAY (UNUSED)"         ) == 0 ) { dest = Sc::Unit::Type::RepairBay_Unused; success = true; }
-            else if ( strcmp(&unit[1], "HYNADON (BADLANDS CRITTER)" ) == 0 ) { dest = Sc::Unit::Type::Rhynadon_BadlandsCritter; success = true; }
-            else if ( strcmp(&unit[1], "IGHT PIT DOOR"              ) == 0 ) { dest = Sc::Unit::Type::RightPitDoor; success = true; }
-            else if ( strcmp(&unit[1], "IGHT UPPER LEVEL DOOR"      ) == 0 ) { dest = Sc::Unit::Type::RightUpperLevelDoor; success = true; }
-            else if ( strcmp(&unit[1], "IGHT WALL FLAME TRAP"       ) == 0 ) { dest = Sc::Unit::Type::RightWallFlameTrap; success = true; }
-            else if ( strcmp(&unit[1], "IGHT WALL MISSILE TRAP"     ) == 0 ) { dest = Sc::Unit::Type::RightWallMissileTrap; success = true; }
-            else if ( strcmp(&unit[1], "UINS (UNUSED)"              ) == 0 ) { dest = Sc::Unit::Type::Ruins_Unused; success = true; }
-            break;
-        case 'S':
-            if      ( strcmp(&unit[1], "AMIR DURAN (GHOST)"           ) == 0 ) { dest = Sc::Unit::Type::SamirDuran_Ghost; success = true; }
-            else if ( strcmp(&unit[1], "ARAH KERRIGAN (GHOST)"        ) == 0 ) { dest = Sc::Unit::Type::SarahKerrigan_Ghost; success = true; }
-            else if ( strcmp(&unit[1], "CANNER SWEEP"                 ) == 0 ) { dest = Sc::Unit::Type::ScannerSweep; success = true; }
-            else if ( strcmp(&unit[1], "CANTID (DESERT CRITTER)"      ) == 0 ) { dest = Sc::Unit::Type::Scantid_DesertCritter; success = true; }
-            else if ( strcmp(&unit[1], "IEGE TANK TURRET (SIEGE MODE)") == 0 ) { dest = Sc::Unit::Type::SiegeTankTurret_SiegeMode; success = true; }
-            else if ( strcmp(&unit[1], "IEGE TANK TURRET (TANK MODE)" ) == 0 ) { dest = Sc::Unit::Type::SiegeTankTurret_TankMode; success = true; }
-            else if ( strcmp(&unit[1], "PIDER MINE"                   ) == 0 ) { dest = Sc::Unit::Type::SpiderMine; success = true; }
-            else if ( strcmp(&unit[1], "TARBASE (UNUSED)"             ) == 0 ) { dest = Sc::Unit::Type::Starbase_Unused; success = true; }
-            else if ( strcmp(&unit[1], "TART LOCATION"                ) == 0 ) { dest = Sc::Unit::Type::StartLocation; success = true; }
-            else if ( strcmp(&unit[1], "TASIS CELL/PRISON"            ) == 0 ) { dest = Sc::Unit::Type::StasisCellPrison; success = true; }
-            break;
-        case 'T':
-            if ( unit[1] == 'E' )
-            {
-                switch ( unit[7] )
-                {
-                case 'A':
-                    if      ( strcmp(&unit[2], "RRAN ACADEMY") == 0 ) { dest = Sc::Unit::Type::TerranAcademy; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN ARMORY" ) == 0 ) { dest = Sc::Unit::Type::TerranArmory; success = true; }
-                    break;
-                case 'B':
-                    if      ( strcmp(&unit[2], "RRAN BARRACKS"     ) == 0 ) { dest = Sc::Unit::Type::TerranBarracks; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN BATTLECRUISER") == 0 ) { dest = Sc::Unit::Type::TerranBattlecruiser; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN BEACON"       ) == 0 ) { dest = Sc::Unit::Type::TerranBeacon; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN BUNKER"       ) == 0 ) { dest = Sc::Unit::Type::TerranBunker; success = true; }
-                    break;
-                case 'C':
-                    if      ( strcmp(&unit[2], "RRAN CIVILIAN"      ) == 0 ) { dest = Sc::Unit::Type::TerranCivilian; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN COMMAND CENTER") == 0 ) { dest = Sc::Unit::Type::TerranCommandCenter; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN COMSAT STATION") == 0 ) { dest = Sc::Unit::Type::TerranComsatStation; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN CONTROL TOWER" ) == 0 ) { dest = Sc::Unit::Type::TerranControlTower; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN COVERT OPS"    ) == 0 ) { dest = Sc::Unit::Type::TerranCovertOps; success = true; }
-                    break;
-                case 'D':
-                    if ( strcmp(&unit[2], "RRAN DROPSHIP") == 0 ) { dest = Sc::Unit::Type::TerranDropship; success = true; }
-                    break;
-                case 'E':
-                    if ( strcmp(&unit[2], "RRAN ENGINEERING BAY") == 0 ) { dest = Sc::Unit::Type::TerranEngineeringBay; success = true; }
-                    break;
-                case 'F':
-                    if      ( strcmp(&unit[2], "RRAN FACTORY"    ) == 0 ) { dest = Sc::Unit::Type::TerranFactory; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN FIREBAT"    ) == 0 ) { dest = Sc::Unit::Type::TerranFirebat; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN FLAG BEACON") == 0 ) { dest = Sc::Unit::Type::TerranFlagBeacon; success = true; }
-                    break;
-                case 'G':
-                    if      ( strcmp(&unit[2], "RRAN GHOST"  ) == 0 ) { dest = Sc::Unit::Type::TerranGhost; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN GOLIATH") == 0 ) { dest = Sc::Unit::Type::TerranGoliath; success = true; }
-                    break;
-                case 'M':
-                    if      ( strcmp(&unit[2], "RRAN MACHINE SHOP"  ) == 0 ) { dest = Sc::Unit::Type::TerranMachineShop; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN MARINE"        ) == 0 ) { dest = Sc::Unit::Type::TerranMarine; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN MARKER"        ) == 0 ) { dest = Sc::Unit::Type::TerranMarker; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN MEDIC"         ) == 0 ) { dest = Sc::Unit::Type::TerranMedic; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN MISSILE TURRET") == 0 ) { dest = Sc::Unit::Type::TerranMissileTurret; success = true; }
-                    break;
-                case 'N':
-                    if ( strcmp(&unit[2], "RRAN NUCLEAR SILO") == 0 ) { dest = Sc::Unit::Type::TerranNuclearSilo; success = true; }
-                    break;
-                case 'P':
-                    if ( strcmp(&unit[2], "RRAN PHYSICS LAB") == 0 ) { dest = Sc::Unit::Type::TerranPhysicsLab; success = true; }
-                    break;
-                case 'R':
-                    if ( strcmp(&unit[2], "RRAN REFINERY") == 0 ) { dest = Sc::Unit::Type::TerranRefinery; success = true; }
-                    break;
-                case 'S':
-                    if      ( strcmp(&unit[2], "RRAN SCIENCE FACILITY"       ) == 0 ) { dest = Sc::Unit::Type::TerranScienceFacility; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN SCIENCE VESSEL"         ) == 0 ) { dest = Sc::Unit::Type::TerranScienceVessel; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN SCV"                    ) == 0 ) { dest = Sc::Unit::Type::TerranScv; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN SIEGE TANK (SIEGE MODE)") == 0 ) { dest = Sc::Unit::Type::TerranSiegeTank_SiegeMode; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN SIEGE TANK (TANK MODE)" ) == 0 ) { dest = Sc::Unit::Type::TerranSiegeTank_TankMode; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN STARPORT"               ) == 0 ) { dest = Sc::Unit::Type::TerranStarport; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN SUPPLY DEPOT"           ) == 0 ) { dest = Sc::Unit::Type::TerranSupplyDepot; success = true; }
-                    break;
-                case 'V':
-                    if      ( strcmp(&unit[2], "RRAN VALKYRIE"               ) == 0 ) { dest = Sc::Unit::Type::TerranValkrie; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN VESPENE GAS TANK TYPE 1") == 0 ) { dest = Sc::Unit::Type::TerranVespeneGasTankType1; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN VESPENE GAS TANK TYPE 2") == 0 ) { dest = Sc::Unit::Type::TerranVespeneGasTankType2; success = true; }
-                    else if ( strcmp(&unit[2], "RRAN VULTURE"                ) == 0 ) { dest = Sc::Unit::Type::TerranVulture; success = true; }
-                    break;
-                case 'W':
-                    if ( strcmp(&unit[2], "RRAN WRAITH") == 0 ) { dest = Sc::Unit::Type::TerranWraith; success = true; }
-                    break;
-                }
-            }
-            else if ( unit[1] == 'A' )
-            {
-                if      ( strcmp(&unit[2], "SSADAR (TEMPLAR)"       ) == 0 ) { dest = Sc::Unit::Type::Tassadar_Templar; success = true; }
-                else if ( strcmp(&unit[2], "SSADAR/ZERATUL (ARCHON)") == 0 ) { dest = Sc::Unit::Type::TassadarZeratul_Archon; success = true; }
-            }
-            else if ( unit[1] == 'O' )
-            {
-                if      ( strcmp(&unit[2], "M KAZANSKY (WRAITH)") == 0 ) { dest = Sc::Unit::Type::TomKazansky_Wraith; success = true; }
-                else if ( strcmp(&unit[2], "RRASQUE (ULTRALISK)") == 0 ) { dest = Sc::Unit::Type::Torrasque_Ultralisk; success = true; }
-            }
-            break;
-        case 'U':
-            if      ( strcmp(&unit[1], "NCLEAN ONE (DEFILER)"      ) == 0 ) { dest = Sc::Unit::Type::UncleanOne_Defiler; success = true; }
-            else if ( strcmp(&unit[1], "NUSED PROTOSS BUILDING 1"  ) == 0 ) { dest = Sc::Unit::Type::UnusedProtossBuilding1; success = true; }
-            else if ( strcmp(&unit[1], "NUSED PROTOSS BUILDING 2"  ) == 0 ) { dest = Sc::Unit::Type::UnusedProtossBuilding2; success = true; }
-            else if ( strcmp(&unit[1], "NUSED ZERG BUILDING 1"     ) == 0 ) { dest = Sc::Unit::Type::UnusedZergBuilding1; success = true; }
-            else if ( strcmp(&unit[1], "NUSED ZERG BUILDING 2"     ) == 0 ) { dest = Sc::Unit::Type::UnusedZergBuilding1; success = true; }
-            else if ( strcmp(&unit[1], "RAJ CRYSTAL"               ) == 0 ) { dest = Sc::Unit::Type::UrajCrystal; success = true; }
-            else if ( strcmp(&unit[1], "RSADON (ICE WORLD CRITTER)") == 0 ) { dest = Sc::Unit::Type::Ursadon_IceWorldCritter; success = true; }
-            break;
-        case 'V':
-            if      ( strcmp(&unit[1], "ESPENE GEYSER") == 0 ) { dest = Sc::Unit::Type::VespeneGeyser; success = true; }
-            break;
-        case 'W':
-            if      ( strcmp(&unit[1], "ARBRINGER (REAVER)") == 0 ) { dest = Sc::Unit::Type::Warbringer_Reaver; success = true; }
-            else if ( strcmp(&unit[1], "ARP GATE"          ) == 0 ) { dest = Sc::Unit::Type::WarpGate; success = true; }
-            break;
-        case 'X':
-            if      ( strcmp(&unit[1], "EL'NAGA TEMPLE") == 0 ) { dest = Sc::Unit::Type::XelNagaTemple; success = true; }
-            break;
-        case 'Y':
-            if      ( strcmp(&unit[1], "GGDRASILL (OVERLORD)") == 0 ) { dest = Sc::Unit::Type::Yggdrasill_Overlord; success = true; }
-            else if ( strcmp(&unit[1], "OUNG CHRYSALIS"      ) == 0 ) { dest = Sc::Unit::Type::YoungChrysalis; success = true; }
-            break;
-        case 'Z':
-            if ( unit[3] == 'G' )
-            {
-                switch ( unit[5] )
-                {
-                case 'B':
-                    if      ( strcmp(&unit[1], "ERG BEACON"   ) == 0 ) { dest = Sc::Unit::Type::ZergBeacon; success = true; }
-                    else if ( strcmp(&unit[1], "ERG BROODLING") == 0 ) { dest = Sc::Unit::Type::ZergBroodling; success = true; }
-                    break;
-                case 'C':
-                    if      ( strcmp(&unit[1], "ERG CEREBRATE"        ) == 0 ) { dest = Sc::Unit::Type::ZergCerebrate; success = true; }
-                    else if ( strcmp(&unit[1], "ERG CEREBRATE DAGGOTH") == 0 ) { dest = Sc::Unit::Type::ZergCerebrateDaggoth; success = true; }
-                    else if ( strcmp(&unit[1], "ERG CREEP COLONY"     ) == 0 ) { dest = Sc::Unit::Type::ZergCreepColony; success = true; }
-                    break;
-                case 'D':
-                    if      ( strcmp(&unit[1], "ERG DEFILER"      ) == 0 ) { dest = Sc::Unit::Type::ZergDefiler; success = true; }
-                    else if ( strcmp(&unit[1], "ERG DEFILER MOUND") == 0 ) { dest = Sc::Unit::Type::ZergDefilerMound; success = true; }
-                    else if ( strcmp(&unit[1], "ERG DEVOURER"     ) == 0 ) { dest = Sc::Unit::Type::ZergDevourer; success = true; }
-                    else if ( strcmp(&unit[1], "ERG DRONE"        ) == 0 ) { dest = Sc::Unit::Type::ZergDrone; success = true; }
-                    break;
-                case 'E':
-                    if      ( strcmp(&unit[1], "ERG EGG"              ) == 0 ) { dest = Sc::Unit::Type::ZergEgg; success = true; }
-                    else if ( strcmp(&unit[1], "ERG EVOLUTION CHAMBER") == 0 ) { dest = Sc::Unit::Type::ZergEvolutionChamber; success = true; }
-                    else if ( strcmp(&unit[1], "ERG EXTRACTOR"        ) == 0 ) { dest = Sc::Unit::Type::ZergExtractor; success = true; }
-                    break;
-                case 'F':
-                    if ( strcmp(&unit[1], "ERG FLAG BEACON") == 0 ) { dest = Sc::Unit::Type::ZergFlagBeacon; success = true; }
-                    break;
-                case 'G':
-                    if      ( strcmp(&unit[1], "ERG GREATER SPIRE") == 0 ) { dest = Sc::Unit::Type::ZergGreaterSpire; success = true; }
-                    else if ( strcmp(&unit[1], "ERG GUARDIAN"     ) == 0 ) { dest = Sc::Unit::Type::ZergGuardian; success = true; }
-                    break;
-                case 'H':
-                    if      ( strcmp(&unit[1], "ERG HATCHERY"     ) == 0 ) { dest = Sc::Unit::Type::ZergHatchery; success = true; }
-                    else if ( strcmp(&unit[1], "ERG HIVE"         ) == 0 ) { dest = Sc::Unit::Type::ZergHive; success = true; }
-                    else if ( strcmp(&unit[1], "ERG HYDRALISK"    ) == 0 ) { dest = Sc::Unit::Type::ZergHydralisk; success = true; }
-                    else if ( strcmp(&unit[1], "ERG HYDRALISK DEN") == 0 ) { dest = Sc::Unit::Type::ZergHydraliskDen; success = true; }
-                    break;
-                case 'L':
-                    if      ( strcmp(&unit[1], "ERG LAIR"  ) == 0 ) { dest = Sc::Unit::Type::ZergLair; success = true; }
-                    else if ( strcmp(&unit[1], "ERG LARVA" ) == 0 ) { dest = Sc::Unit::Type::ZergLarva; success = true; }
-                    else if ( strcmp(&unit[1], "ERG LURKER") == 0 ) { dest = Sc::Unit::Type::ZergLurker; success = true; }
-                    break;
-                case 'M':
-                    if      ( strcmp(&unit[1], "ERG MARKER"  ) == 0 ) { dest = Sc::Unit::Type::ZergMarker; success = true; }
-                    else if ( strcmp(&unit[1], "ERG MUTALISK") == 0 ) { dest = Sc::Unit::Type::ZergMutalisk; success = true; }
-                    break;
-                case 'N':
-                    if ( strcmp(&unit[1], "ERG NYDUS CANAL") == 0 ) { dest = Sc::Unit::Type::ZergNydusCanal; success = true; }
-                    break;
-                case 'O':
-                    if      ( strcmp(&unit[1], "ERG OVERLORD"             ) == 0 ) { dest = Sc::Unit::Type::ZergOverlord; success = true; }
-                    else if ( strcmp(&unit[1], "ERG OVERMIND"             ) == 0 ) { dest = Sc::Unit::Type::ZergOvermind; success = true; }
-                    else if ( strcmp(&unit[1], "ERG OVERMIND (WITH SHELL)") == 0 ) { dest = Sc::Unit::Type::ZergOvermind_WithShell; success = true; }
-                    break;
-                case 'Q':
-                    if      ( strcmp(&unit[1], "ERG QUEEN"       ) == 0 ) { dest = Sc::Unit::Type::ZergQueen; success = true; }
-                    else if ( strcmp(&unit[1], "ERG QUEEN'S NEST") == 0 ) { dest = Sc::Unit::Type::ZergQueensNest; success = true; }
-                    break;
-                case 'S':
-                    if      ( strcmp(&unit[1], "ERG SCOURGE"      ) == 0 ) { dest = Sc::Unit::Type::ZergScourge; success = true; }
-                    else if ( strcmp(&unit[1], "ERG SPAWNING POOL") == 0 ) { dest = Sc::Unit::Type::ZergSpawningPool; success = true; }
-                    else if ( strcmp(&unit[1], "ERG SPIRE"        ) == 0 ) { dest = Sc::Unit::Type::ZergSpire; success = true; }
-                    else if ( strcmp(&unit[1], "ERG SPORE COLONY" ) == 0 ) { dest = Sc::Unit::Type::ZergSporeColony; success = true; }
-                    else if ( strcmp(&unit[1], "ERG SUNKEN COLONY") == 0 ) { dest = Sc::Unit::Type::ZergSunkenColony; success = true; }
-                    break;
-                case 'U':
-                    if      ( strcmp(&unit[1], "ERG ULTRALISK"       ) == 0 ) { dest = Sc::Unit::Type::ZergUltralisk; success = true; }
-                    else if ( strcmp(&unit[1], "ERG ULTRALISK CAVERN") == 0 ) { dest = Sc::Unit::Type::ZergUltraliskCavern; success = true; }
-                    break;
-                case 'V':
-                    if      ( strcmp(&unit[1], "ERG VESPENE GAS SAC TYPE 1") == 0 ) { dest = Sc::Unit::Type::ZergVespeneGasSacType1; success = true; }
-                    else if ( strcmp(&unit[1], "ERG VESPENE GAS SAC TYPE 2") == 0 ) { dest = Sc::Unit::Type::ZergVespeneGasSacType2; success = true; }
-                    break;
-                case 'Z':
-                    if ( strcmp(&unit[1], "ERG ZERGLING") == 0 ) { dest = Sc::Unit::Type::ZergZergling; success = true; }
-                    break;
-                }
-            }
-            else if ( strcmp(&unit[1], "ERATUL (DARK TEMPLAR)") == 0 ) { dest = Sc::Unit::Type::Zeratul_DarkTemplar; success = true; }
-            break;
-        }
+        name = &text.c_str()[pos];
+        length = end-pos;
     }
 
-    if ( !success ) // Now search the unit name table
-    {
-        size_t hash = strHash(str);
-        size_t numMatching = unitTable.count(hash);
-        if ( numMatching == 1 )
-        { // Should guarentee that you can find at least one entry
-            const UnitTableNode & node = unitTable.find(hash)->second;
-            if ( node.unitName.compare(str) == 0 )
-            {
-                dest = node.unitType;
-                success = true;
-            }
-        }
-        else if ( numMatching > 1 )
-        {
-            auto range = unitTable.equal_range(hash);
-            for ( auto & pair = range.first; pair != range.second; ++pair )
-            {
-                const UnitTableNode & node = pair->second;
-                if ( node.unitName.compare(str) == 0 )
-                {
-                    if ( success == false ) // If no matches have previously been found
-                    {
-                        dest = node.unitType;
-                        success = true;
-                    }
-                    else // If matches have previously been found
-                    {
-                        if ( node.unitType < dest )
-                            dest = node.unitType; // Replace if unitID < previous unitID
-                    }
-                }
-            }
-        }
-    }
+    if ( length > 3 && (name[0] == 'I' || name[0] == 'i') && (name[1] == 'D' || name[1] == 'd') && name[2] == ':' &&
+        parseShort(std::string(name, length), (u16 &)dest, 3, length) )
+        return true;
 
-    if ( !success && size < 40 ) // Now search legacy names, akas, and shortcut names
-    {
-        switch ( unit[0] )
-        {
-        case '[':
-            if      ( strcmp(&unit[1], "ANY UNIT]" ) == 0 ) { dest = Sc::Unit::Type::AnyUnit; success = true; }
-            else if ( strcmp(&unit[1], "BUILDINGS]") == 0 ) { dest = Sc::Unit::Type::Buildings; success = true; }
-            else if ( strcmp(&unit[1], "FACTORIES]") == 0 ) { dest = Sc::Unit::Type::Factories; success = true; }
-            else if ( strcmp(&unit[1], "MEN]"      ) == 0 ) { dest = Sc::Unit::Type::Men; success = true; }
-            break;
-        case 'A':
-            if ( strcmp(&unit[1], "LAN TURRET") == 0 ) { dest = Sc::Unit::Type::AlanTurret; success = true; }
-            break;
-        case 'B':
-            if ( strcmp(&unit[1], "ENGALAAS (JUNGLE)") == 0 ) { dest = Sc::Unit::Type::Bengalaas_Jungle; success = true; }
-            break;
-        case 'C':
-            if      ( strcmp(&unit[1], "ANTINA") == 0 ) { dest = Sc::Unit::Type::Cantina; success = true; }
-            else if ( strcmp(&unit[1], "AVE"   ) == 0 ) { dest = Sc::Unit::Type::Cave; success = true; }
-            else if ( strcmp(&unit[1], "AVE-IN") == 0 ) { dest = Sc::Unit::Type::CaveIn; success = true; }
-            else if ( strcmp(&unit[1], "OCOON" ) == 0 ) { dest = Sc::Unit::Type::Cocoon; success = true; }
-            break;
-        case 'D':
-            if      ( strcmp(&unit[1], "ARK TEMPLAR (HERO)") == 0 ) { dest = Sc::Unit::Type::DarkTemplar_Hero; success = true; }
-            else if ( strcmp(&unit[1], "ISRUPTION FIELD"   ) == 0 ) { dest = Sc::Unit::Type::DisruptionField; success = true; }
-            else if ( strcmp(&unit[1], "UKE TURRET TYPE 1" ) == 0 ) { dest = Sc::Unit::Type::DukeTurretType1; success = true; }
-            else if ( strcmp(&unit[1], "UKE TURRET TYPE 2" ) == 0 ) { dest = Sc::Unit::Type::DukeTurretType2; success = true; }
-            break;
-        case 'E':
-            if ( strcmp(&unit[1], "DMUND DUKE (SIEGE TANK)") == 0 ) { dest = Sc::Unit::Type::EdmundDuke_SiegeTank; success = true; }
-            break;
-        case 'G':
-            if ( strcmp(&unit[1], "ERARD DUGALLE (GHOST)") == 0 ) { dest = Sc::Unit::Type::GerardDuGalle_BattleCruiser; success = true; }
-            break;
-        case 'I':
-            if      ( strcmp(&unit[1], "NDEPENDENT COMMAND CENTER"         ) == 0 ) { dest = Sc::Unit::Type::IndependentCommandCenter_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NDEPENDENT STARPORT"               ) == 0 ) { dest = Sc::Unit::Type::IndependentStarport_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NFESTED DURAN"                     ) == 0 ) { dest = Sc::Unit::Type::InfestedDuran; success = true; }
-            else if ( strcmp(&unit[1], "NFESTED KERRIGAN (INFESTED TERRAN)") == 0 ) { dest = Sc::Unit::Type::InfestedKerrigan_InfestedTerran; success = true; }
-            else if ( strcmp(&unit[1], "NVALID UNIT"                       ) == 0 ) { dest = Sc::Unit::Type::Id228; success = true; }
-            break;
-        case 'J':
-            if ( strcmp(&unit[1], "UMP GATE") == 0 ) { dest = Sc::Unit::Type::IndependentJumpGate_Unused; success = true; }
-            break;
-        case 'K':
-            if      ( strcmp(&unit[1], "AKARU (TWILIGHT)"         ) == 0 ) { dest = Sc::Unit::Type::Kakaru_TwilightCritter; success = true; }
-            else if ( strcmp(&unit[1], "YADARIN CRYSTAL FORMATION") == 0 ) { dest = Sc::Unit::Type::KhadarinCrystalFormation_Unused; success = true; }
-            break;
-        case 'M':
-            if      ( strcmp(&unit[1], "INING PLATFORM"       ) == 0 ) { dest = Sc::Unit::Type::MiningPlatform_Unused; success = true; }
-            else if ( strcmp(&unit[1], "INERAL CHUNK (TYPE 1)") == 0 ) { dest = Sc::Unit::Type::MineralClusterType1; success = true; }
-            else if ( strcmp(&unit[1], "INERAL CHUNK (TYPE 2)") == 0 ) { dest = Sc::Unit::Type::MineralClusterType2; success = true; }
-            break;
-        case 'N':
-            if ( strcmp(&unit[1], "ORAD II (CRASHED BATTLECRUISER)") == 0 ) { dest = Sc::Unit::Type::NoradII_Crashed; success = true; }
-            break;
-        case 'P':
-            if      ( strcmp(&unit[1], "ROTOSS DARK TEMPLAR" ) == 0 ) { dest = Sc::Unit::Type::ProtossDarkTemplar; success = true; }
-            else if ( strcmp(&unit[1], "ROTOSS UNUSED TYPE 1") == 0 ) { dest = Sc::Unit::Type::UnusedProtossBuilding1; success = true; }
-            else if ( strcmp(&unit[1], "ROTOSS UNUSED TYPE 2") == 0 ) { dest = Sc::Unit::Type::UnusedProtossBuilding2; success = true; }
-            break;
-        case 'R':
-            if      ( strcmp(&unit[1], "AGNASAUR (ASH WORLD)"  ) == 0 ) { dest = Sc::Unit::Type::Ragnasaur_AshworldCritter; success = true; }
-            else if ( strcmp(&unit[1], "UINS"                  ) == 0 ) { dest = Sc::Unit::Type::Ruins_Unused; success = true; }
-            else if ( strcmp(&unit[1], "HYNADON (BADLANDS)"    ) == 0 ) { dest = Sc::Unit::Type::Rhynadon_BadlandsCritter; success = true; }
-            else if ( strcmp(&unit[1], "ASZAGAL (DARK TEMPLAR)") == 0 ) { dest = Sc::Unit::Type::Raszagal_Corsair; success = true; }
-        case 'S':
-            if ( strcmp(&unit[1], "CANTID (DESERT)") == 0 ) { dest = Sc::Unit::Type::Scantid_DesertCritter; success = true; }
-            break;
-        case 'T':
-            if      ( strcmp(&unit[1], "ANK TURRET TYPE 1") == 0 ) { dest = Sc::Unit::Type::SiegeTankTurret_TankMode; success = true; }
-            else if ( strcmp(&unit[1], "ANK TURRET TYPE 2") == 0 ) { dest = Sc::Unit::Type::SiegeTankTurret_SiegeMode; success = true; }
-            break;
-        case 'U':
-            if      ( strcmp(&unit[1], "NUSED TERRAN BLDG TYPE 1") == 0 ) { dest = Sc::Unit::Type::Starbase_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NUSED TERRAN BLDG TYPE 2") == 0 ) { dest = Sc::Unit::Type::RepairBay_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NUSED TYPE 1"            ) == 0 ) { dest = Sc::Unit::Type::CargoShip_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NUSED TYPE 2"            ) == 0 ) { dest = Sc::Unit::Type::MercenaryGunship_Unused; success = true; }
-            else if ( strcmp(&unit[1], "NUSED ZERG BLDG"         ) == 0 ) { dest = Sc::Unit::Type::UnusedZergBuilding1; success = true; }
-            else if ( strcmp(&unit[1], "NUSED ZERG BLDG 5"       ) == 0 ) { dest = Sc::Unit::Type::UnusedZergBuilding2; success = true; }
-            else if ( strcmp(&unit[1], "RSADON (ICE WORLD)"      ) == 0 ) { dest = Sc::Unit::Type::Ursadon_IceWorldCritter; success = true; }
-            break;
-        case 'V':
-            if      ( strcmp(&unit[1], "ULTURE SPIDER MINE"         ) == 0 ) { dest = Sc::Unit::Type::SpiderMine; success = true; }
-            else if ( strcmp(&unit[1], "ESPENE TANK (TERRAN TYPE 1)") == 0 ) { dest = Sc::Unit::Type::TerranVespeneGasTankType1; success = true; }
-            else if ( strcmp(&unit[1], "ESPENE TANK (TERRAN TYPE 2)") == 0 ) { dest = Sc::Unit::Type::TerranVespeneGasTankType2; success = true; }
-            else if ( strcmp(&unit[1], "ESPENE ORB (PROTOSS TYPE 1)") == 0 ) { dest = Sc::Unit::Type::ProtossVespeneGasOrbType1; success = true; }
-            else if ( strcmp(&unit[1], "ESPENE ORB (PROTOSS TYPE 2)") == 0 ) { dest = Sc::Unit::Type::ProtossVespeneGasOrbType2; success = true; }
-            else if ( strcmp(&unit[1], "ESPENE SAC (ZERG TYPE 1)"   ) == 0 ) { dest = Sc::Unit::Type::ZergVespeneGasSacType1; success = true; }
-            else if ( strcmp(&unit[1], "ESPENE SAC (ZERG TYPE 2)"   ) == 0 ) { dest = Sc::Unit::Type::ZergVespeneGasSacType2; success = true; }
-            break;
-        case 'Z':
-            if ( strcmp(&unit[1], "ERG LURKER EGG") == 0 ) { dest = Sc::Unit::Type::LurkerEgg; success = true; }
-            break;
-        }
-    }
-    return success;
+    return standardUnitNames.find(name, length, dest) || // First search standard unit names
+        unitTable.find(name, length, dest) || // Then search the unit name table
+        legacyUnitNames.find(name, length, dest); // Then search legacy names, akas, and shortcut names
 }
 
 bool TextTrigCompiler::parseSoundName(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & dest, size_t pos, size_t end)
@@ -2734,10 +2212,7 @@ bool TextTrigCompiler::parsePlayer(std::string & text, std::vector<RawString> &
     std::string str;
     u32 number = 0;
     if ( text[pos] == '\"' )
-    {
         str = stringContents[nextString];
-        nextString ++;
-    }
     else if ( parseLong(text, dest, pos, end) )
         return true;
     else
@@ -2932,65 +2407,30 @@ bool TextTrigCompiler::parsePlayer(std::string & text, std::vector<RawString> &
         }
     }
 
-    // Might be a defined group name
-    bool success = false;
-    size_t hash = strHash(str);
-    size_t numMatching = groupTable.count(hash);
-    if ( numMatching == 1 )
-    { // Should guarentee that you can find at least one entry
-        const GroupTableNode & node = groupTable.find(hash)->second;
-        if ( node.groupName.compare(str) == 0 )
-        {
-            dest = node.groupId;
-            success = true;
-        }
-    }
-    else if ( numMatching > 1 )
-    {
-        auto range = groupTable.equal_range(hash);
-        for ( auto & pair = range.first; pair != range.second; ++pair )
-        {
-            const GroupTableNode & node = pair->second;
-            if ( node.groupName.compare(str) == 0 )
-            {
-                if ( success == false ) // If no matches have previously been found
-                {
-                    dest = node.groupId;
-                    success = true;
-                }
-                else // If matches have previously been found
-                {
-                    if ( u32(node.groupId) < dest )
-                        dest = node.groupId; // Replace if groupID < previous groupID
-                }
-            }
-        }
-    }
-    return success;
+    return groupTable.find(str, dest); // Might be a defined group name
 }
 
 bool TextTrigCompiler::parseSwitch(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u8 & dest, size_t pos, size_t end) const
 {
-    std::string str;
+    const char* name = nullptr;
+    size_t length = 0;
     if ( text[pos] == '\"' ) // If quoted, ignore quotes
     {
-        str = stringContents[nextString];
-        nextString ++;
+        name = stringContents[nextString].c_str();
+        length = stringContents[nextString].size();
     }
     else if ( parseByte(text, dest, pos, end) )
         return true;
     else
-        str = text.substr(pos, end-pos);
-
-    size_t size = str.size();
-    bool success = false;
-
-    const char* switchNamePtr = &str.c_str()[0];
+    {
+        name = &text.c_str()[pos];
+        length = end-pos;
+    }
 
-    if ( size < 12 )
+    if ( length < 12 )
     {
         std::array<char, 12> sw;
-        copyUpperCaseNoSpace(sw, str);
+        copyUpperCaseNoSpace(sw, std::string(name, length));
 
         // Check if it's a standard switch name
         if ( sw[0] == 'S' && sw[1] == 'W' && sw[2] == 'I' &&
@@ -2998,46 +2438,11 @@ bool TextTrigCompiler::parseSwitch(std::string & text, std::vector<RawString> &
             ( dest = atoi(&sw[6]) ) )
         {
             dest --; // 0 based
-            success = true;
+            return true;
         }
     }
 
-    if ( !success ) // Otherwise search switch name table
-    {
-        size_t hash = strHash(str);
-        size_t numMatching = switchTable.count(hash);
-        if ( numMatching == 1 )
-        { // Should guarentee that you can find at least one entry
-            const SwitchTableNode & node = switchTable.find(hash)->second;
-            if ( node.switchName.compare(str) == 0 )
-            {
-                dest = node.switchId;
-                success = true;
-            }
-        }
-        else if ( numMatching > 1 )
-        {
-            auto range = switchTable.equal_range(hash);
-            for ( auto & pair = range.first; pair != range.second; ++pair )
-            {
-                const SwitchTableNode & node = pair->second;
-                if ( node.switchName.compare(str) == 0 )
-                {
-                    if ( success == false ) // If no matches have previously been found
-                    {
-                        dest = node.switchId;
-                        success = true;
-                    }
-                    else // If matches have previously been found
-                    {
-                        if ( node.switchId < dest )
-                            dest = node.switchId; // Replace if switchID < previous switchId
-                    }
-                }
-            }
-        }
-    }
-    return success;
+    return switchTable.find(name, length, dest); // Otherwise search switch name table
 }
 
 bool TextTrigCompiler::parseSwitch(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & dest, size_t pos, size_t end) const
@@ -3056,47 +2461,23 @@ bool TextTrigCompiler::parseScript(std::string & text, std::vector<RawString> &
         return true;
     }
 
-    std::string str;
+    const char* name = nullptr;
+    size_t length = 0;
     bool isQuoted = text[pos] == '\"';
     if ( isQuoted )
     {
-        str = stringContents[nextString];
-        nextString ++;
+        name = stringContents[nextString].c_str();
+        length = stringContents[nextString].size();
     }
     else
-        str = text.substr(pos, end-pos);
-
-    bool success = false;
-    size_t size = str.size();
-
-    // Grab the string hash
-    size_t hash = strHash(str);
-    size_t numMatching = scriptTable.count(hash);
-    if ( numMatching == 1 )
-    { // Should guarentee that you can find at least one entry
-        const ScriptTableNode & node = scriptTable.find(hash)->second;
-        if ( node.scriptName.compare(str) == 0 )
-        {
-            dest = node.scriptId;
-            success = true;
-        }
-    }
-    else if ( numMatching > 1 )
     {
-        auto range = scriptTable.equal_range(hash);
-        for ( auto & pair = range.first; pair != range.second; ++pair )
-        {
-            const ScriptTableNode & node = pair->second;
-            if ( node.scriptName.compare(str) == 0 && success == false ) // Compare equal and no prev matches
-            {
-                dest = node.scriptId;
-                success = true;
-                break;
-            }
-        }
+        name = &text.c_str()[pos];
+        length = end-pos;
     }
 
-    if ( !success && size == 4 )
+    if ( scriptTable.find(name, length, dest) )
+        return true;
+    else if ( length == 4 )
     {
         /** With scripts, the exact ascii characters entered can be the exact bytes out.
         As a consequence, if the script name is not quoted and is comprised entirely
@@ -3104,18 +2485,18 @@ bool TextTrigCompiler::parseScript(std::string & text, std::vector<RawString> &
         return false so ParseByte can be called. */
 
         bool hasNonNumericCharacter =
-            str[0] < '0' || str[0] > '9' ||
-            str[1] < '0' || str[1] > '9' ||
-            str[2] < '0' || str[2] > '9' ||
-            str[3] < '0' || str[3] > '9';
+            name[0] < '0' || name[0] > '9' ||
+            name[1] < '0' || name[1] > '9' ||
+            name[2] < '0' || name[2] > '9' ||
+            name[3] < '0' || name[3] > '9';
 
         if ( isQuoted || hasNonNumericCharacter )
         {
-            dest = (u32 &)str.c_str()[0];
-            success = true;
+            dest = (u32 &)name[0];
+            return true;
         }
     }
-    return success;
+    return false;
 }
 
 Chk::Condition::Type TextTrigCompiler::extendedToRegularConditionType(Chk::Condition::VirtualType conditionType) const
@@ -3532,155 +2913,85 @@ bool TextTrigCompiler::parseByte(const std::string & text, u8 & dest, size_t pos
 
 bool TextTrigCompiler::prepLocationTable(ScenarioPtr map)
 {
-    LocationTableNode locNode = {};
-    locationTable.reserve(map->layers.numLocations()+1);
-    locNode.locationId = 0;
-    locNode.locationName = "No Location";
-    locationTable.insert(std::pair<size_t, LocationTableNode>(strHash(locNode.locationName), locNode));
+    locationTable.add("No Location", 0);
     for ( u32 i=1; i<=map->layers.numLocations(); i++ )
     {
-        Chk::LocationPtr loc = map->layers.getLocation(i);
-        locNode.locationName = "";
-
         if ( i == Chk::LocationId::Anywhere )
-        {
-            locNode.locationId = Chk::LocationId::Anywhere;
-            locNode.locationName = "Anywhere";
-            locationTable.insert( std::pair<size_t, LocationTableNode>(strHash(locNode.locationName), locNode) );
-        }
+            locationTable.add("Anywhere", u8(Chk::LocationId::Anywhere));
         else
         {
             auto gameString = map->strings.getLocationName<RawString>(i, Chk::Scope::Game);
             auto editorString = map->strings.getLocationName<RawString>(i, Chk::Scope::Editor);
             if ( gameString != nullptr )
-            {
-                locNode.locationId = u8(i);
-                locNode.locationName = *gameString;
-                locationTable.insert( std::pair<size_t, LocationTableNode>(strHash(locNode.locationName), locNode) );
-            }
+                locationTable.add(*gameString, u8(i));
             if ( editorString != nullptr )
-            {
-                locNode.locationId = u8(i);
-                locNode.locationName = *editorString;
-                locationTable.insert( std::pair<size_t, LocationTableNode>(strHash(locNode.locationName), locNode) );
-            }
+                locationTable.add(*editorString, u8(i));
         }
     }
-    locationTable.reserve(locationTable.size());
-    return true;
+    return locationTable.build();
 }
 
 bool TextTrigCompiler::prepUnitTable(ScenarioPtr map)
 {
-    UnitTableNode unitNode = {};
-    u16 stringId = 0;
     for ( u16 unitId=0; unitId<Sc::Unit::TotalTypes; unitId++ )
     {
-        unitNode.unitType = (Sc::Unit::Type)unitId;
         auto gameString = map->strings.getUnitName<RawString>((Sc::Unit::Type)unitId, true, Chk::UseExpSection::Auto, Chk::Scope::Game);
         auto editorString = map->strings.getUnitName<RawString>((Sc::Unit::Type)unitId, true, Chk::UseExpSection::Auto, Chk::Scope::Editor);
         
         if ( gameString == nullptr && editorString == nullptr )
-        {
-            unitNode.unitName = Sc::Unit::defaultDisplayNames[unitId];
-            unitTable.insert( std::pair<size_t, UnitTableNode>(strHash(unitNode.unitName), unitNode) );
-        }
+            unitTable.add(Sc::Unit::defaultDisplayNames[unitId], (Sc::Unit::Type)unitId);
         else
         {
             if ( gameString != nullptr )
-            {
-                unitNode.unitName = *gameString;
-                unitTable.insert( std::pair<size_t, UnitTableNode>(strHash(unitNode.unitName), unitNode) );
-            }
+                unitTable.add(*gameString, (Sc::Unit::Type)unitId);
             if ( editorString != nullptr )
-            {
-                unitNode.unitName = *editorString;
-                unitTable.insert( std::pair<size_t, UnitTableNode>(strHash(unitNode.unitName), unitNode) );
-            }
+                unitTable.add(*editorString, (Sc::Unit::Type)unitId);
         }
     }
-    return true;
+    return unitTable.build();
 }
 
 bool TextTrigCompiler::prepSwitchTable(ScenarioPtr map)
 {
-    SwitchTableNode switchNode = {};
-    size_t stringId = 0;
     for ( size_t switchIndex=0; switchIndex<Chk::TotalSwitches; switchIndex++ )
     {
         auto gameString = map->strings.getSwitchName<RawString>(switchIndex, Chk::Scope::Game);
         auto editorString = map->strings.getSwitchName<RawString>(switchIndex, Chk::Scope::Editor);
         
         if ( gameString != nullptr )
-        {
-            switchNode.switchId = u8(switchIndex);
-            switchNode.switchName = *gameString;
-            switchTable.insert( std::pair<size_t, SwitchTableNode>(strHash(switchNode.switchName), switchNode) );
-        }
+            switchTable.add(*gameString, u8(switchIndex));
         if ( editorString != nullptr )
-        {
-            switchNode.switchId = u8(switchIndex);
-            switchNode.switchName = *editorString;
-            switchTable.insert( std::pair<size_t, SwitchTableNode>(strHash(switchNode.switchName), switchNode) );
-        }
+            switchTable.add(*editorString, u8(switchIndex));
     }
-    return true;
+    return switchTable.build();
 }
 
 bool TextTrigCompiler::prepGroupTable(ScenarioPtr map)
 {
-    GroupTableNode groupNode = {};
     for ( u32 i=0; i<Chk::TotalForces; i++ )
     {
         auto gameString = map->strings.getForceName<RawString>((Chk::Force)i, Chk::Scope::Game);
         auto editorString = map->strings.getForceName<RawString>((Chk::Force)i, Chk::Scope::Editor);
 
         if ( gameString != nullptr )
-        {
-            groupNode.groupId = i + 18;
-            groupNode.groupName = *gameString;
-            groupTable.insert(std::pair<size_t, GroupTableNode>(strHash(groupNode.groupName), groupNode));
-        }
+            groupTable.add(*gameString, i + 18);
         if ( editorString != nullptr )
-        {
-            groupNode.groupId = i + 18;
-            groupNode.groupName = *editorString;
-            groupTable.insert(std::pair<size_t, GroupTableNode>(strHash(groupNode.groupName), groupNode));
-        }
+            groupTable.add(*editorString, i + 18);
     }
-    return true;
+    return groupTable.build();
 }
 
 bool TextTrigCompiler::prepStringTable(ScenarioPtr map, std::unordered_multimap<size_t, StringTableNodePtr> & stringHashTable, size_t trigIndexBegin, size_t trigIndexEnd, const Chk::Scope & scope)
 {
-    std::bitset<Chk::MaxStrings> stringUsed; // Table of strings currently used in the map
-    u32 userMask = scope == Chk::Scope::Game ? Chk::StringUserFlag::xTrigger : Chk::StringUserFlag::All;
-    map->strings.markValidUsedStrings(stringUsed, Chk::Scope::Either, scope, userMask);
-    size_t stringCapacity = map->strings.getCapacity(scope);
-    for ( size_t stringId=1; stringId<=stringCapacity; stringId++ )
-    {
-        if ( stringUsed[stringId] )
-        {
-            RawStringPtr rawString = map->strings.getString<RawString>(stringId, scope);
-            if ( rawString != nullptr )
-            {
-                StringTableNodePtr node = StringTableNodePtr(new StringTableNode({}));
-                node->unused = false;
-                node->scStr = ScStrPtr(new ScStr(*rawString));
-                node->stringId = (u32)stringId;
-                stringHashTable.insert(std::pair<size_t, StringTableNodePtr>(strHash(*rawString), node));
-            }
-        }
-    }
-
     if ( scope == Chk::Scope::Game )
     {
-        auto & triggers = map->triggers;
-        size_t numTriggers = triggers.numTriggers();
-        for ( size_t trigIndex = 0; trigIndex < numTriggers; trigIndex++ )
+        /** Only the replaced triggers are visited, strings used anywhere outside of the range stay in the map and are
+            found again when the strings they share with the new triggers are added, so a small range never scans every string */
+        const Triggers & triggers = map->triggers;
+        size_t rangeEnd = std::min(trigIndexEnd, triggers.numTriggers());
+        for ( size_t trigIndex = trigIndexBegin; trigIndex < rangeEnd; trigIndex++ )
         {
-            bool inReplacedRange = trigIndex >= trigIndexBegin && trigIndex < trigIndexEnd;
-            const Chk::TriggerPtr trigger = triggers.getTrigger(trigIndex);
+            const Chk::Trigger* trigger = triggers.readTrigger(trigIndex);
             for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
             {
                 const Chk::Action & action = trigger->actions[actionIndex];
@@ -3688,10 +2999,10 @@ bool TextTrigCompiler::prepStringTable(ScenarioPtr map, std::unordered_multimap<
                 if ( actionType < Chk::Action::NumActionTypes )
                 {
                     if ( Chk::Action::actionUsesStringArg[actionType] && action.stringId > 0 )
-                        prepTriggerString(*map, stringHashTable, action.stringId, inReplacedRange, Chk::Scope::Game);
+                        prepTriggerString(*map, stringHashTable, action.stringId, true, Chk::Scope::Game);
 
                     if ( Chk::Action::actionUsesSoundArg[actionType] && action.soundStringId > 0 )
-                        prepTriggerString(*map, stringHashTable, action.soundStringId, inReplacedRange, Chk::Scope::Game);
+                        prepTriggerString(*map, stringHashTable, action.soundStringId, true, Chk::Scope::Game);
                 }
             }
         }
@@ -3740,24 +3051,80 @@ bool TextTrigCompiler::prepScriptTable(Sc::Data & scData)
     size_t numScripts = scData.ai.numEntries();
     for ( size_t i = 0; i < numScripts; i++ )
     {
-        ScriptTableNode scriptNode = {};
         const Sc::Ai::Entry & entry = scData.ai.getEntry(i);
         if ( scData.ai.getName(i, aiName) )
-            scriptTable.insert(std::pair<size_t, ScriptTableNode>(strHash(scriptNode.scriptName), scriptNode));
+            scriptTable.add(aiName, entry.identifier);
     }
-    return true;
+    return scriptTable.build();
 }
 
 bool TextTrigCompiler::buildNewMap(ScenarioPtr scenario, size_t trigIndexBegin, size_t trigIndexEnd, std::deque<Chk::TriggerPtr> triggers, std::stringstream & error) const
 {
+    std::vector<size_t> replacedStringIds; // Only strings used by the replaced triggers can become unused
+    std::vector<size_t> replacedExtendedStringIds;
+    const Triggers & currTriggers = scenario->triggers;
+    size_t rangeEnd = std::min(trigIndexEnd, currTriggers.numTriggers());
+    for ( size_t trigIndex = trigIndexBegin; trigIndex < rangeEnd; trigIndex++ )
+    {
+        const Chk::Trigger* trigger = currTriggers.readTrigger(trigIndex);
+        for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
+        {
+            const Chk::Action & action = trigger->actions[actionIndex];
+            if ( action.actionType < Chk::Action::NumActionTypes )
+            {
+                if ( Chk::Action::actionUsesStringArg[action.actionType] && action.stringId > 0 )
+                    replacedStringIds.push_back(action.stringId);
+
+                if ( Chk::Action::actionUsesSoundArg[action.actionType] && action.soundStringId > 0 )
+                    replacedStringIds.push_back(action.soundStringId);
+            }
+        }
+        const Chk::ExtendedTrigDataPtr extension = currTriggers.getTriggerExtension(trigIndex);
+        if ( extension != nullptr )
+        {
+            if ( extension->commentStringId != Chk::StringId::NoString )
+                replacedExtendedStringIds.push_back(extension->commentStringId);
+            if ( extension->notesStringId != Chk::StringId::NoString )
+                replacedExtendedStringIds.push_back(extension->notesStringId);
+        }
+    }
+
+    std::set<size_t> keptStringIds; // Strings the new triggers were already assigned, whether kept from the replaced triggers or found elsewhere
+    for ( const auto & trigger : triggers )
+    {
+        for ( size_t actionIndex = 0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
+        {
+            const Chk::Action & action = trigger->actions[actionIndex];
+            if ( action.actionType < Chk::Action::NumActionTypes )
+            {
+                if ( Chk::Action::actionUsesStringArg[action.actionType] && action.stringId > 0 )
+                    keptStringIds.insert(action.stringId);
+
+                if ( Chk::Action::actionUsesSoundArg[action.actionType] && action.soundStringId > 0 )
+                    keptStringIds.insert(action.soundStringId);
+            }
+        }
+    }
+    replacedStringIds.erase(std::remove_if(replacedStringIds.begin(), replacedStringIds.end(), [&](size_t stringId) {
+        return keptStringIds.count(stringId) > 0; }), replacedStringIds.end());
+
     auto strBackup = scenario->strings.backup();
-    std::deque<Chk::TriggerPtr> replacedTriggers = scenario->triggers.replaceRange(trigIndexBegin, trigIndexEnd, triggers);
+    Triggers::Batch triggerBatch(scenario->triggers); // Fix trigger extensions once the triggers are kept or restored
+    std::deque<Chk::TriggerPtr> noTriggers;
+    std::deque<Chk::TriggerPtr> replacedTriggers = scenario->triggers.replaceRange(trigIndexBegin, trigIndexEnd, noTriggers); // The new triggers are inserted once their strings are assigned
     bool success = true;
     try {
-        scenario->strings.deleteUnusedStrings(Chk::Scope::Both);
+        scenario->strings.deleteStrings(unusedStringIds(*scenario, replacedStringIds, Chk::Scope::Game), Chk::Scope::Game, false);
+        std::vector<RawString> newStrings;
         for ( auto str : unassignedStrings )
+            newStrings.push_back(str->scStr->str);
+
+        std::vector<size_t> reservedStringIds(keptStringIds.begin(), keptStringIds.end()); // Unused until the new triggers are inserted, so mustn't be given to new strings
+        std::vector<size_t> newStringIds = scenario->strings.addStrings<RawString>(newStrings, Chk::Scope::Game, true, reservedStringIds);
+        for ( size_t i=0; i<unassignedStrings.size(); i++ )
         {
-            str->stringId = (u32)scenario->strings.addString<RawString>(str->scStr->str, Chk::Scope::Game);
+            StringTableNodePtr str = unassignedStrings[i];
+            str->stringId = (u32)newStringIds[i];
             if ( str->stringId != Chk::StringId::NoString )
             {
                 for ( auto assignee : str->assignees )
@@ -3774,15 +3141,39 @@ bool TextTrigCompiler::buildNewMap(ScenarioPtr scenario, size_t trigIndexBegin,
         success = false;
     }
 
-    if ( !success )
+    if ( success )
+        scenario->triggers.replaceRange(trigIndexBegin, trigIndexBegin, triggers);
+    else
     {
-        size_t unreplaceEndIndex = trigIndexBegin + replacedTriggers.size();
-        auto unused = scenario->triggers.replaceRange(trigIndexBegin, unreplaceEndIndex, replacedTriggers);
+        scenario->triggers.replaceRange(trigIndexBegin, trigIndexBegin, replacedTriggers);
         scenario->strings.restore(strBackup);
     }
+    triggerBatch.commit();
+
+    if ( success && !replacedExtendedStringIds.empty() ) // Extensions the replaced triggers left behind were removed on commit
+        scenario->strings.deleteStrings(unusedStringIds(*scenario, replacedExtendedStringIds, Chk::Scope::Editor), Chk::Scope::Editor, false);
+
     return success;
 }
 
+std::vector<size_t> TextTrigCompiler::unusedStringIds(const Scenario & scenario, const std::vector<size_t> & stringIds, Chk::Scope storageScope)
+{
+    std::bitset<Chk::MaxStrings> stringIdUsed; // Game strings may also be used by editor users such as location and switch names
+    scenario.strings.markUsedStrings(stringIdUsed, Chk::Scope::Either, storageScope);
+    std::vector<size_t> unusedStringIds;
+    for ( size_t stringId : stringIds )
+    {
+        if ( stringId < Chk::MaxStrings && !stringIdUsed[stringId] )
+        {
+            unusedStringIds.push_back(stringId);
+            stringIdUsed[stringId] = true; // Listed once
+        }
+        else if ( stringId >= Chk::MaxStrings && !scenario.strings.stringUsed(stringId, Chk::Scope::Either, storageScope) ) // Beyond what can be marked
+            unusedStringIds.push_back(stringId);
+    }
+    return unusedStringIds;
+}
+
 size_t findStringEnd(const std::string & str, size_t pos)
 {
     size_t strSize = str.size();
@@ -3791,9 +3182,14 @@ size_t findStringEnd(const std::string & str, size_t pos)
         size_t nextQuote = str.find('\"', pos);
         if ( nextQuote == std::string::npos )
             return std::string::npos;
-        else if ( nextQuote > 0 && str[nextQuote-1] == '\\' ) // Escaped quote
+
+        size_t numBackslashes = 0;
+        while ( nextQuote-numBackslashes > pos && str[nextQuote-numBackslashes-1] == '\\' )
+            numBackslashes ++;
+
+        if ( numBackslashes % 2 == 1 ) // Escaped quote
             pos = nextQuote+1;
-        else  // Terminating quote
+        else // Terminating quote, any backslashes before it escape one another
             return nextQuote;
     }
     return std::string::npos;
@@ -1,32 +1,14 @@
 #ifndef TEXTTRIGCOMPILER_H
 #define TEXTTRIGCOMPILER_H
 #include "Basics.h"
+#include "KeywordTable.h"
 #include "Sc.h"
 #include "Scenario.h"
+#include "WorkerPool.h"
 #include <unordered_map>
 #include <sstream>
 #include <string>
 
-struct LocationTableNode {
-    RawString locationName;
-    u8 locationId;
-};
-struct UnitTableNode {
-    RawString unitName;
-    Sc::Unit::Type unitType;
-};
-struct SwitchTableNode {
-    RawString switchName;
-    u8 switchId;
-};
-struct GroupTableNode {
-    RawString groupName;
-    u32 groupId;
-};
-struct ScriptTableNode {
-    RawString scriptName;
-    u32 scriptId;
-};
 struct StringTableNode {
     bool unused; // If unused, string was only used by triggers being replaced and has yet to be used by new triggers
     ScStrPtr scStr;
@@ -67,11 +49,17 @@ class TextTrigCompiler
             Last = 12
         });
 
-        TextTrigCompiler(bool useAddressesForMemory, u32 deathTableOffset);
+        TextTrigCompiler(bool useAddressesForMemory, u32 deathTableOffset, size_t numWorkers = WorkerPool::defaultNumWorkers()); // numWorkers limits the threads used to parse triggers
         virtual ~TextTrigCompiler();
         bool compileTriggers(std::string & trigText, ScenarioPtr chk, Sc::Data & scData, size_t trigIndexBegin, size_t trigIndexEnd); // Compiles text, overwrites TRIG and STR upon success
         bool compileTrigger(std::string & trigText, ScenarioPtr chk, Sc::Data & scData, size_t trigIndex); // Compiles text, fills trigger upon success
 
+        /** Compiles only the triggers whose text changed since triggerHashes and modificationEpoch were recorded for the map by
+            TextTrigGenerator::generateTextTrigs or a previous call, triggers whose text is unchanged (along with their strings)
+            are left as they are; if the map's triggers, strings or locations changed since then (modificationEpoch no longer
+            matches Scenario::getModificationEpoch) everything is compiled; upon success both are updated to match trigText */
+        bool compileChangedTriggers(std::string & trigText, ScenarioPtr chk, Sc::Data & scData, std::vector<u64> & triggerHashes, u64 & modificationEpoch);
+
         // Attempts to compile the condition argument at argIndex into the given condition
         bool parseConditionName(std::string text, Chk::Condition::Type & conditionType) const;
         bool parseConditionArg(std::string conditionArgText, Chk::Condition::Argument argument, Chk::Condition & condition, ScenarioPtr chk, Sc::Data & scData, size_t trigIndex, bool silent = false);
@@ -81,11 +69,14 @@ class TextTrigCompiler
 
     protected:
 
+        bool compileTriggers(std::string & trigText, ScenarioPtr chk, Sc::Data & scData, size_t trigIndexBegin, size_t trigIndexEnd, u32 firstLine); // Compiles text that starts on the given line of the text shown to the user
         bool loadCompiler(ScenarioPtr chk, Sc::Data & scData, size_t trigIndexBegin, size_t trigIndexEnd, ScenarioDataFlag dataTypes = ScenarioDataFlag::All); // Sets up all the data needed for a run of the compiler
         void clearCompiler(); // Clears data loaded for a run of the compiler
         void cleanText(std::string & text, std::vector<RawString> & stringContents) const; // Remove spacing and standardize line endings
 
-        bool parseTriggers(std::string & text, std::vector<RawString> & stringContents, std::deque<std::shared_ptr<Chk::Trigger>> & output, std::stringstream & error); // Parse trigger, generate a trig section in buffer output
+        bool parseTriggers(std::string & text, std::vector<RawString> & stringContents, std::deque<std::shared_ptr<Chk::Trigger>> & output, std::stringstream & error, u32 firstLine = 1); // Parse triggers in parallel chunks, then assign strings in text order
+        bool parseTriggers(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & line, std::deque<Chk::TriggerPtr> & output, std::stringstream & error); // Parse the triggers in text, starting from the given string and line
+        void assignStrings(std::vector<RawString> & stringContents); // Finds or adds the strings parsed by parseString in text order
         inline bool parsePartZero(std::string & text, Chk::TriggerPtr & currTrig, Chk::Condition* & currCondition, Chk::Action* & currAction, std::stringstream & error, size_t & pos, u32 & line, Expecting & expecting);
         inline bool parsePartOne(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, Chk::Trigger & output, std::stringstream & error, size_t & pos, u32 & line, Expecting & expecting, size_t & playerEnd, size_t & lineEnd);
         inline bool parsePartTwo(std::string & text, std::stringstream & error, size_t & pos, u32 & line, Expecting & expecting);
@@ -107,15 +98,15 @@ class TextTrigCompiler
         inline bool parsePartEleven(std::string & text, std::stringstream & error, size_t & pos, u32 & line, Expecting & expecting);
 
         bool parseExecutingPlayer(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, Chk::Trigger & currTrig, size_t pos, size_t end) const; // Parse a player that the trigger is executed by
-        bool parseConditionName(const std::string & arg, Chk::Condition::VirtualType & conditionType) const;
+        bool parseConditionName(const std::string & text, size_t pos, size_t end, Chk::Condition::VirtualType & conditionType) const; // Find the conditionType named by text in [pos, end), ignoring any trailing text
         bool parseCondition(std::string & text, size_t pos, size_t end, Chk::Condition::VirtualType & conditionType, u8 & flags); // Find the equivilant conditionType
-        bool parseActionName(const std::string & arg, Chk::Action::VirtualType & actionType) const;
+        bool parseActionName(const std::string & text, size_t pos, size_t end, Chk::Action::VirtualType & actionType) const; // Find the actionType named by text in [pos, end), ignoring any trailing text
         bool parseAction(std::string & text, size_t pos, size_t end, Chk::Action::VirtualType & actionType, u8 & flags); // Find the equivilant actionType
         bool parseConditionArg(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, Chk::Condition & currCondition, size_t pos, size_t end, Chk::Condition::Argument argument, std::stringstream & error); // Parse an argument belonging to a condition
         bool parseActionArg(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, Chk::Action & currAction, size_t pos, size_t end, Chk::Action::Argument argument, std::stringstream & error); // Parse an argument belonging to an action
         bool parseExecutionFlags(std::string & text, size_t pos, size_t end, u32 & flags) const;
 
-        bool parseString(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & dest, size_t pos, size_t end); // Find a given string (not an extended string) in the map, prepare to add it if necessary
+        bool parseString(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & dest, size_t pos, size_t end); // Record dest as the destination of a given string (not an extended string), found or added by assignStrings
         bool parseLocationName(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & dest, size_t pos, size_t end) const; // Find a location in the map by its string
         bool parseUnitName(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, Sc::Unit::Type & dest, size_t pos, size_t end) const; // Get a unitID using a unit name
         bool parseSoundName(std::string & text, std::vector<RawString> & stringContents, size_t & nextString, u32 & dest, size_t pos, size_t end); // Find a sound in the map by its string, redundant? remove me?
@@ -158,12 +149,13 @@ class TextTrigCompiler
 
         bool useAddressesForMemory; // If true, uses 1.16.1 addresses for memory conditions and actions
         u32 deathTableOffset;
+        size_t numWorkers; // The maximum number of threads used to parse triggers
         std::hash<std::string> strHash; // A hasher to help generate tables
-        std::unordered_multimap<size_t, LocationTableNode> locationTable; // Location hash map
-        std::unordered_multimap<size_t, UnitTableNode> unitTable; // Unit hash map
-        std::unordered_multimap<size_t, SwitchTableNode> switchTable; // Switch hash map
-        std::unordered_multimap<size_t, GroupTableNode> groupTable; // Group/Player hash map
-        std::unordered_multimap<size_t, ScriptTableNode> scriptTable; // Script hash map
+        NameTable<u8> locationTable; // Location name table
+        NameTable<Sc::Unit::Type> unitTable; // Unit name table
+        NameTable<u8> switchTable; // Switch name table
+        NameTable<u32> groupTable; // Group/Player name table
+        NameTable<u32> scriptTable; // Script name table
 
         std::unordered_multimap<size_t, StringTableNodePtr> newStringTable; // String hash map
         std::vector<StringTableNodePtr> unassignedStrings; // Strings in stringTable that have yet to be assigned stringIds
@@ -171,15 +163,18 @@ class TextTrigCompiler
         std::unordered_multimap<size_t, StringTableNodePtr> newExtendedStringTable; // Extended string hash map
         std::vector<StringTableNodePtr> unassignedExtendedStrings; // Extended strings in extendedStringTable that have yet to be assigned stringIds
 
+        std::vector<u32*> stringDests; // The destination of each string in stringContents that was parsed by parseString, if any
+
         bool prepLocationTable(ScenarioPtr map); // Fills locationTable
         bool prepUnitTable(ScenarioPtr map); // Fills unitTable
         bool prepSwitchTable(ScenarioPtr map); // Fills switchTable
         bool prepGroupTable(ScenarioPtr map); // Fills groupTable
         bool prepScriptTable(Sc::Data & scData); // Fills scriptTable
-        bool prepStringTable(ScenarioPtr map, std::unordered_multimap<size_t, StringTableNodePtr> & stringHashTable, size_t trigIndexBegin, size_t trigIndexEnd, const Chk::Scope & scope); // Fills stringUsed and stringTable
+        bool prepStringTable(ScenarioPtr map, std::unordered_multimap<size_t, StringTableNodePtr> & stringHashTable, size_t trigIndexBegin, size_t trigIndexEnd, const Chk::Scope & scope); // Fills stringHashTable with the strings used by the triggers being replaced
         void prepTriggerString(Scenario & scenario, std::unordered_multimap<size_t, StringTableNodePtr> & stringHashTable, const u32 & stringId, const bool & inReplacedRange, const Chk::Scope & scope);
 
         bool buildNewMap(ScenarioPtr scenario, size_t trigIndexBegin, size_t trigIndexEnd, std::deque<Chk::TriggerPtr> triggers, std::stringstream & error) const; // Builds the new TRIG and STR sections
+        static std::vector<size_t> unusedStringIds(const Scenario & scenario, const std::vector<size_t> & stringIds, Chk::Scope storageScope); // Gets each of stringIds no longer used by anything, once
 };
 
 // Returns the position of the next unescaped quote, pos must be greater than the position of the string's open quote, returns npos on failure
@@ -234,9 +229,7 @@ inline void TextTrigCompiler::copyUpperCaseNoSpace(std::array<char, N> & dest, c
 {
     if ( text[pos] == '\"' ) // Quoted argument, take off stringContents
     {
-        RawString & rawString = stringContents[nextString];
-        nextString ++;
-        copyUpperCaseNoSpace(dest, rawString);
+        copyUpperCaseNoSpace(dest, stringContents[nextString]);
     }
     else
         copyUpperCaseNoSpace(dest, text, pos, end);
@@ -1,5 +1,6 @@
 #include "TextTrigGenerator.h"
 #include "Math.h"
+#include <algorithm>
 #include <string>
 #include <chrono>
 
@@ -14,8 +15,11 @@ std::vector<std::string> allyStates = { "Enemy", "Ally", "Allied Victory" };
 std::vector<std::string> numericComparisons = { "At least", "At most", "2", "3", "4", "5", "6", "7", "8", "9", "Exactly" };
 std::vector<std::string> numericModifiers = { "0", "1", "2", "3", "4", "5", "6", "Set To", "Add", "Subtract" };
 
-TextTrigGenerator::TextTrigGenerator(bool useAddressesForMemory, u32 deathTableOffset) :
-    goodConditionTable(false), goodActionTable(false), useAddressesForMemory(useAddressesForMemory), deathTableOffset(deathTableOffset)
+constexpr size_t TriggersPerChunk = 64; // Triggers rendered into each chunk's buffer
+constexpr size_t ChunksPerWorker = 4; // Chunks per worker in each batch streamed, bounds the text held in memory while streaming
+
+TextTrigGenerator::TextTrigGenerator(bool useAddressesForMemory, u32 deathTableOffset, size_t numWorkers) :
+    goodConditionTable(false), goodActionTable(false), useAddressesForMemory(useAddressesForMemory), deathTableOffset(deathTableOffset), numWorkers(numWorkers), modificationEpoch(0)
 {
 
 }
@@ -33,6 +37,7 @@ bool TextTrigGenerator::generateTextTrigs(ScenarioPtr map, std::string & trigStr
         loadScenario(map, true, false) &&
         buildTextTrigs(map, trigString) )
     {
+        modificationEpoch = map->getModificationEpoch();
         auto finish = std::chrono::high_resolution_clock::now();
         logger.info() << "Text trig generation completed in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
         return true;
@@ -40,17 +45,146 @@ bool TextTrigGenerator::generateTextTrigs(ScenarioPtr map, std::string & trigStr
     return false;
 }
 
+bool TextTrigGenerator::generateTextTrigs(ScenarioPtr map, std::ostream & output)
+{
+    logger.info() << "Starting text trig streaming..." << std::endl;
+    auto start = std::chrono::high_resolution_clock::now();
+    if ( map != nullptr &&
+        loadScenario(map, true, false) &&
+        buildTextTrigs(map, output) )
+    {
+        modificationEpoch = map->getModificationEpoch();
+        auto finish = std::chrono::high_resolution_clock::now();
+        logger.info() << "Text trig streaming completed in " << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
+        return true;
+    }
+    return false;
+}
+
 bool TextTrigGenerator::generateTextTrigs(ScenarioPtr map, size_t trigIndex, std::string & trigString)
 {
     if ( map != nullptr )
     {
-        Chk::TriggerPtr trig = map->triggers.getTrigger(trigIndex);
+        const Triggers & triggers = map->triggers;
+        const Chk::Trigger* trig = triggers.readTrigger(trigIndex);
         if ( trig != nullptr )
             return loadScenario(map, true, false) && buildTextTrig(*trig, trigString);
     }
     return false;
 }
 
+const std::vector<u64> & TextTrigGenerator::getTriggerHashes() const
+{
+    return triggerHashes;
+}
+
+u64 TextTrigGenerator::getModificationEpoch() const
+{
+    return modificationEpoch;
+}
+
+u64 TextTrigGenerator::hashTriggerText(const char* text, size_t length)
+{
+    u64 hash = 0xCBF29CE484222325ull; // 64-bit FNV-1a
+    bool inString = false;
+    bool escaped = false; // Whether the previous character in a string began an escape sequence
+    bool lineEnded = false; // Runs of line endings hash as one, line endings before or after everything else aren't hashed
+    for ( size_t pos=0; pos<length; pos++ )
+    {
+        char character = text[pos];
+        if ( inString )
+        {
+            inString = escaped || character != '\"'; // Escaped quotes don't end the string, escaped backslashes don't escape the quote
+            escaped = !escaped && character == '\\';
+        }
+        else if ( character == ' ' || character == '\t' )
+            continue;
+        else if ( character == '\n' || character == '\r' || character == '\v' || character == '\f' )
+        {
+            lineEnded = hash != 0xCBF29CE484222325ull;
+            continue;
+        }
+        else if ( character == '/' && pos+1 < length && text[pos+1] == '/' ) // Skip to the end of the comment
+        {
+            while ( pos+1 < length && text[pos+1] != '\n' && text[pos+1] != '\r' && text[pos+1] != '\v' && text[pos+1] != '\f' )
+                pos ++;
+
+            continue;
+        }
+        else if ( character == '\"' )
+            inString = true;
+        else if ( character >= 'a' && character <= 'z' )
+            character -= 32;
+
+        if ( lineEnded )
+        {
+            hash ^= u64('\n');
+            hash *= 0x100000001B3ull;
+            lineEnded = false;
+        }
+        hash ^= u64(u8(character));
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+void TextTrigGenerator::hashTriggers(const std::string & trigText, std::vector<size_t> & triggerStarts, std::vector<u64> & triggerHashes)
+{
+    triggerStarts.clear();
+    triggerHashes.clear();
+    const char* text = trigText.c_str();
+    size_t length = trigText.size();
+    size_t depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    bool lineStart = true;
+    for ( size_t pos=0; pos<length; pos++ )
+    {
+        char character = text[pos];
+        if ( inString )
+        {
+            inString = escaped || character != '\"';
+            escaped = !escaped && character == '\\';
+        }
+        else
+        {
+            switch ( character )
+            {
+                case '\n': case '\r': case '\v': case '\f': lineStart = true; continue;
+                case ' ': case '\t': continue;
+                case '\"': inString = true; break;
+                case '(': case '{': depth ++; break;
+                case ')': case '}': if ( depth > 0 ) depth --; break;
+                case '/':
+                    if ( pos+1 < length && text[pos+1] == '/' )
+                    {
+                        while ( pos+1 < length && text[pos+1] != '\n' && text[pos+1] != '\r' && text[pos+1] != '\v' && text[pos+1] != '\f' )
+                            pos ++;
+
+                        continue;
+                    }
+                    break;
+                case 'T': case 't':
+                    if ( lineStart && depth == 0 && pos+7 <= length && (text[pos+1] == 'R' || text[pos+1] == 'r') &&
+                        (text[pos+2] == 'I' || text[pos+2] == 'i') && (text[pos+3] == 'G' || text[pos+3] == 'g') &&
+                        (text[pos+4] == 'G' || text[pos+4] == 'g') && (text[pos+5] == 'E' || text[pos+5] == 'e') &&
+                        (text[pos+6] == 'R' || text[pos+6] == 'r') )
+                    {
+                        triggerStarts.push_back(triggerStarts.empty() ? 0 : pos); // Anything before the first trigger is hashed with it
+                    }
+                    break;
+            }
+        }
+        lineStart = false;
+    }
+
+    for ( size_t i=0; i<triggerStarts.size(); i++ )
+    {
+        size_t end = i+1 < triggerStarts.size() ? triggerStarts[i+1] : length;
+        triggerHashes.push_back(hashTriggerText(&text[triggerStarts[i]], end-triggerStarts[i]));
+    }
+}
+
 bool TextTrigGenerator::loadScenario(ScenarioPtr map)
 {
     return map != nullptr &&
@@ -332,15 +466,48 @@ bool TextTrigGenerator::correctLineEndings(StringBuffer & buf) const
 
 bool TextTrigGenerator::buildTextTrigs(ScenarioPtr scenario, std::string & trigString)
 {
-    StringBuffer output;
-    appendTriggers(output, scenario);
-    correctLineEndings(output);
-    trigString = output.str();
+    std::vector<std::vector<char>> chunks;
+    std::vector<u64> hashes;
+    renderTriggers(scenario, 0, scenario->triggers.numTriggers(), chunks, hashes);
+
+    size_t textSize = 0;
+    for ( const auto & chunk : chunks )
+        textSize += chunk.size();
+
+    trigString.clear();
+    trigString.reserve(textSize);
+    for ( auto & chunk : chunks )
+    {
+        trigString.append(chunk.begin(), chunk.end());
+        std::vector<char>().swap(chunk); // Release each chunk once copied so the text is held about twice at most
+    }
+    triggerHashes.swap(hashes);
     clearScenario();
     return true;
 }
 
-bool TextTrigGenerator::buildTextTrig(Chk::Trigger & trigger, std::string & trigString)
+bool TextTrigGenerator::buildTextTrigs(ScenarioPtr scenario, std::ostream & output)
+{
+    size_t numTriggers = scenario->triggers.numTriggers();
+    size_t triggersPerBatch = TriggersPerChunk*ChunksPerWorker*std::max(size_t(1), numWorkers);
+    std::vector<std::vector<char>> chunks;
+    std::vector<u64> hashes;
+    for ( size_t batchStart=0; batchStart<numTriggers && output.good(); batchStart += triggersPerBatch )
+    {
+        renderTriggers(scenario, batchStart, std::min(batchStart+triggersPerBatch, numTriggers), chunks, hashes);
+        for ( const auto & chunk : chunks )
+            output.write(chunk.data(), std::streamsize(chunk.size()));
+    }
+
+    bool success = output.good();
+    if ( success )
+        triggerHashes.swap(hashes);
+
+    clearScenario();
+    return success;
+}
+
+bool TextTrigGenerator::buildTextTrig(const Chk::Trigger & trigger, std::string & trigString)
 {
     StringBuffer output;
     appendTrigger(output, trigger);
@@ -350,19 +517,40 @@ bool TextTrigGenerator::buildTextTrig(Chk::Trigger & trigger, std::string & trig
     return true;
 }
 
-inline void TextTrigGenerator::appendTriggers(StringBuffer & output, ScenarioPtr scenario) const
+void TextTrigGenerator::renderTriggers(ScenarioPtr scenario, size_t trigIndexBegin, size_t trigIndexEnd, std::vector<std::vector<char>> & chunks, std::vector<u64> & triggerHashes) const
 {
-    Triggers & triggers = scenario->triggers;
-    size_t numTrigs = triggers.numTriggers();
-    for ( size_t trigIndex=0; trigIndex<numTrigs; trigIndex++ )
+    size_t numChunks = (trigIndexEnd - trigIndexBegin + TriggersPerChunk - 1) / TriggersPerChunk;
+    std::vector<std::vector<u64>> chunkHashes(numChunks);
+    chunks.assign(numChunks, std::vector<char>());
+    WorkerPool::run(numChunks, [&](size_t chunkIndex) {
+        size_t chunkBegin = trigIndexBegin + chunkIndex*TriggersPerChunk;
+        StringBuffer output;
+        appendTriggers(output, scenario, chunkBegin, std::min(chunkBegin+TriggersPerChunk, trigIndexEnd), chunkHashes[chunkIndex]);
+        correctLineEndings(output); // Chunks end between triggers, so line endings are never split across chunks
+        output.swap(chunks[chunkIndex]);
+    }, numWorkers);
+
+    for ( const auto & hashes : chunkHashes )
+        triggerHashes.insert(triggerHashes.end(), hashes.begin(), hashes.end());
+}
+
+inline void TextTrigGenerator::appendTriggers(StringBuffer & output, ScenarioPtr scenario, size_t trigIndexBegin, size_t trigIndexEnd, std::vector<u64> & triggerHashes) const
+{
+    const Triggers & triggers = scenario->triggers; // Read only, workers share the triggers
+    triggerHashes.reserve(trigIndexEnd-trigIndexBegin);
+    for ( size_t trigIndex=trigIndexBegin; trigIndex<trigIndexEnd; trigIndex++ )
     {
-        std::shared_ptr<Chk::Trigger> trigger = triggers.getTrigger(trigIndex);
+        const Chk::Trigger* trigger = triggers.readTrigger(trigIndex); // Read in place, other workers are reading too
         if ( trigger != nullptr )
+        {
+            size_t triggerStart = output.size();
             appendTrigger(output, *trigger);
+            triggerHashes.push_back(hashTriggerText(&output[triggerStart], output.size()-triggerStart)); // Line endings are ignored, so this matches the corrected text
+        }
     }
 }
 
-inline void TextTrigGenerator::appendTrigger(StringBuffer & output, Chk::Trigger & trigger) const
+inline void TextTrigGenerator::appendTrigger(StringBuffer & output, const Chk::Trigger & trigger) const
 {
     output += "Trigger(";
 
@@ -398,7 +586,7 @@ inline void TextTrigGenerator::appendTrigger(StringBuffer & output, Chk::Trigger
     // Add conditions
     for ( size_t i=0; i<Chk::Trigger::MaxConditions; i++ )
     {
-        Chk::Condition & condition = trigger.condition(i);
+        const Chk::Condition & condition = trigger.condition(i);
         Chk::Condition::VirtualType conditionType = (Chk::Condition::VirtualType)condition.conditionType;
 
         if ( conditionType != Chk::Condition::VirtualType::NoCondition )
@@ -444,7 +632,7 @@ inline void TextTrigGenerator::appendTrigger(StringBuffer & output, Chk::Trigger
     // Add actions
     for ( size_t i=0; i<Chk::Trigger::MaxActions; i++ )
     {
-        Chk::Action & action = trigger.action(i);
+        const Chk::Action & action = trigger.action(i);
         Chk::Action::VirtualType actionType = (Chk::Action::VirtualType)action.actionType;
 
         if ( actionType != Chk::Action::VirtualType::NoAction )
@@ -500,7 +688,7 @@ inline void TextTrigGenerator::appendTrigger(StringBuffer & output, Chk::Trigger
     output += "\n}\n\n//-----------------------------------------------------------------//\n\n";
 }
 
-inline void TextTrigGenerator::appendConditionArgument(StringBuffer & output, Chk::Condition & condition, Chk::Condition::Argument argument) const
+inline void TextTrigGenerator::appendConditionArgument(StringBuffer & output, const Chk::Condition & condition, Chk::Condition::Argument argument) const
 {
     switch ( argument.type )
     {
@@ -522,7 +710,7 @@ inline void TextTrigGenerator::appendConditionArgument(StringBuffer & output, Ch
     }
 }
 
-inline void TextTrigGenerator::appendActionArgument(StringBuffer & output, Chk::Action & action, Chk::Action::Argument argument) const
+inline void TextTrigGenerator::appendActionArgument(StringBuffer & output, const Chk::Action & action, Chk::Action::Argument argument) const
 {
     switch ( argument.type )
     {
@@ -928,33 +1116,21 @@ bool TextTrigGenerator::prepGroupTable(ScenarioPtr map, bool quoteArgs)
 
     EscString groupName;
 
-    const char** legacyLowerGroupNames;
-    const char** legacyUpperGroupNames;
-
-    if ( quoteArgs )
-    {
-        const char* legacyLowerGroups[] = { "\"Player 1\"", "\"Player 2\"", "\"Player 3\"", "\"Player 4\"", "\"Player 5\"", "\"Player 6\"",
-                                            "\"Player 7\"", "\"Player 8\"", "\"Player 9\"", "\"Player 10\"", "\"Player 11\"", "\"Player 12\"",
-                                            "\"unknown/unused\"", "\"Current Player\"", "\"Foes\"", "\"Allies\"", "\"Neutral Players\"",
-                                            "\"All players\"" };
-        const char* legacyUpperGroups[] = { "\"22\"", "\"23\"", "\"24\"", "\"25\"",
-                                            "\"Non Allied Victory Players\"", "\"unknown/unused\"" };
-
-        legacyLowerGroupNames = legacyLowerGroups;
-        legacyUpperGroupNames = legacyUpperGroups;
-    }
-    else
-    {
-        const char* legacyLowerGroups[] = { "Player 1", "Player 2", "Player 3", "Player 4", "Player 5", "Player 6",
-                                            "Player 7", "Player 8", "Player 9", "Player 10", "Player 11", "Player 12",
-                                            "unknown/unused", "Current Player", "Foes", "Allies", "Neutral Players",
-                                            "All players" };
-        const char* legacyUpperGroups[] = { "22", "23", "24", "25",
-                                            "Non Allied Victory Players", "unknown/unused" };
-
-        legacyLowerGroupNames = legacyLowerGroups;
-        legacyUpperGroupNames = legacyUpperGroups;
-    }
+    static const char* legacyQuotedLowerGroups[] = { "\"Player 1\"", "\"Player 2\"", "\"Player 3\"", "\"Player 4\"", "\"Player 5\"", "\"Player 6\"",
+                                                     "\"Player 7\"", "\"Player 8\"", "\"Player 9\"", "\"Player 10\"", "\"Player 11\"", "\"Player 12\"",
+                                                     "\"unknown/unused\"", "\"Current Player\"", "\"Foes\"", "\"Allies\"", "\"Neutral Players\"",
+                                                     "\"All players\"" };
+    static const char* legacyQuotedUpperGroups[] = { "\"22\"", "\"23\"", "\"24\"", "\"25\"",
+                                                     "\"Non Allied Victory Players\"", "\"unknown/unused\"" };
+    static const char* legacyLowerGroups[] = { "Player 1", "Player 2", "Player 3", "Player 4", "Player 5", "Player 6",
+                                               "Player 7", "Player 8", "Player 9", "Player 10", "Player 11", "Player 12",
+                                               "unknown/unused", "Current Player", "Foes", "Allies", "Neutral Players",
+                                               "All players" };
+    static const char* legacyUpperGroups[] = { "22", "23", "24", "25",
+                                               "Non Allied Victory Players", "unknown/unused" };
+
+    const char** legacyLowerGroupNames = quoteArgs ? legacyQuotedLowerGroups : legacyLowerGroups;
+    const char** legacyUpperGroupNames = quoteArgs ? legacyQuotedUpperGroups : legacyUpperGroups;
 
     const char** lowerGroups = legacyLowerGroupNames;
     const char** upperGroups = legacyUpperGroupNames;
@@ -1001,15 +1177,16 @@ bool TextTrigGenerator::prepScriptTable(ScenarioPtr map, bool quoteArgs)
     scriptTable.insert(std::pair<Sc::Ai::ScriptId, std::string>(Sc::Ai::ScriptId::NoScript, "No Script"));
 
     Chk::Trigger* trigPtr = nullptr;
-    size_t numTrigs = map->triggers.numTriggers();
+    const Triggers & triggers = map->triggers;
+    size_t numTrigs = triggers.numTriggers();
     for ( size_t i = 0; i < numTrigs; i++ )
     {
-        Chk::TriggerPtr trigPtr = map->triggers.getTrigger(i);
+        const Chk::Trigger* trigPtr = triggers.readTrigger(i);
         if ( trigPtr != nullptr )
         {
             for ( size_t actionNum = 0; actionNum < Chk::Trigger::MaxActions; actionNum++ )
             {
-                Chk::Action & action = trigPtr->action(actionNum);
+                const Chk::Action & action = trigPtr->action(actionNum);
                 Chk::Action::Type actionId = action.actionType;
                 bool isScriptAction = (actionId == Chk::Action::Type::RunAiScript || actionId == Chk::Action::Type::RunAiScriptAtLocation);
                 if ( isScriptAction && action.number != 0 )
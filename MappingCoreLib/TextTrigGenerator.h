@@ -3,6 +3,8 @@
 #include "Basics.h"
 #include "Scenario.h"
 #include "StringBuffer.h"
+#include "WorkerPool.h"
+#include <ostream>
 #include <vector>
 #include <string>
 #include <map>
@@ -13,14 +15,33 @@ class TextTrigGenerator
 {
     public:
         
-        TextTrigGenerator(bool useAddressesForMemory, u32 deathTableOffset);
+        TextTrigGenerator(bool useAddressesForMemory, u32 deathTableOffset, size_t numWorkers = WorkerPool::defaultNumWorkers()); // numWorkers limits the threads used to render triggers
         virtual ~TextTrigGenerator();
 
         // Places text trigs representative of the given TRIG section in trigString if successful
         bool generateTextTrigs(ScenarioPtr map, std::string & trigString);
 
+        // Streams text trigs representative of the given TRIG section to output a batch of triggers at a time, the text is the same as the text placed in trigString
+        bool generateTextTrigs(ScenarioPtr map, std::ostream & output);
+
         // Places text trigs representative of the given trigger in trigString if successful
         bool generateTextTrigs(ScenarioPtr map, size_t trigIndex, std::string & trigString);
+
+        /** Gets the hash of each trigger's text as of the last successful generateTextTrigs(map, trigString) or
+            generateTextTrigs(map, output); generating a single trigger's text leaves these unchanged */
+        const std::vector<u64> & getTriggerHashes() const;
+
+        /** Gets the map's Scenario::getModificationEpoch as of the last successful generateTextTrigs(map, trigString) or
+            generateTextTrigs(map, output); generating a single trigger's text leaves this unchanged */
+        u64 getModificationEpoch() const;
+
+        // Hashes the text of a trigger, ignoring spacing, comments, line endings and the case of anything outside of strings
+        static u64 hashTriggerText(const char* text, size_t length);
+
+        /** Splits trigText before each "Trigger" that starts a line outside of any brackets, strings or comments; fills
+            triggerStarts with the position each piece begins at (the first always begins at zero) and triggerHashes with the
+            hashTriggerText of each piece; pieces hash the same as the text generated for the same triggers */
+        static void hashTriggers(const std::string & trigText, std::vector<size_t> & triggerStarts, std::vector<u64> & triggerHashes);
         
         bool loadScenario(ScenarioPtr map); // Loads data about the given scenario for use outside text trigs
 
@@ -59,11 +80,13 @@ class TextTrigGenerator
         bool correctLineEndings(StringBuffer & buf) const; // Corrects any improperly formatted line endings
         
         bool buildTextTrigs(ScenarioPtr scenario, std::string & trigString);
-        bool buildTextTrig(Chk::Trigger & trigger, std::string & trigString);
-        inline void appendTriggers(StringBuffer & output, ScenarioPtr scenario) const;
-        inline void appendTrigger(StringBuffer & output, Chk::Trigger & trigger) const;
-        inline void appendConditionArgument(StringBuffer & output, Chk::Condition & condition, Chk::Condition::Argument argument) const;
-        inline void appendActionArgument(StringBuffer & output, Chk::Action & action, Chk::Action::Argument argument) const;
+        bool buildTextTrigs(ScenarioPtr scenario, std::ostream & output);
+        bool buildTextTrig(const Chk::Trigger & trigger, std::string & trigString);
+        void renderTriggers(ScenarioPtr scenario, size_t trigIndexBegin, size_t trigIndexEnd, std::vector<std::vector<char>> & chunks, std::vector<u64> & triggerHashes) const; // Renders chunks of triggers in parallel, appending the hash of each trigger
+        inline void appendTriggers(StringBuffer & output, ScenarioPtr scenario, size_t trigIndexBegin, size_t trigIndexEnd, std::vector<u64> & triggerHashes) const;
+        inline void appendTrigger(StringBuffer & output, const Chk::Trigger & trigger) const;
+        inline void appendConditionArgument(StringBuffer & output, const Chk::Condition & condition, Chk::Condition::Argument argument) const;
+        inline void appendActionArgument(StringBuffer & output, const Chk::Action & action, Chk::Action::Argument argument) const;
 
         inline void appendLocation(StringBuffer & output, const size_t & locationId) const;
         inline void appendString(StringBuffer & output, const size_t & stringId) const;
@@ -99,6 +122,7 @@ class TextTrigGenerator
 
         bool useAddressesForMemory; // If true, uses 1.16.1 addresses for memory conditions and actions
         u32 deathTableOffset;
+        size_t numWorkers;
         std::vector<ChkdString> stringTable; // Array list of map strings
         std::vector<ChkdString> extendedStringTable; // Array list of extended map strings
         std::vector<ChkdString> locationTable; // Array of map locations
@@ -111,6 +135,8 @@ class TextTrigGenerator
         std::vector<std::string> actionTable; // Array of action names
         bool goodConditionTable;
         bool goodActionTable;
+        std::vector<u64> triggerHashes; // Hash of the text of each trigger in the last text trigs generated
+        u64 modificationEpoch; // The map's modification epoch once the last text trigs were generated
 
         bool prepConditionTable(); // Fills conditionTable
         bool prepActionTable(); // Fills actionTable
@@ -0,0 +1,125 @@
+#include "TileMipmaps.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+TileMipmaps::TileMipmaps() : tiles(nullptr)
+{
+
+}
+
+TileMipmaps::~TileMipmaps()
+{
+
+}
+
+void TileMipmaps::setTiles(const Sc::Terrain::Tiles & tiles)
+{
+    if ( this->tiles != &tiles )
+    {
+        this->tiles = &tiles;
+        for ( u8 level=0; level<=MaxLevel; level++ )
+        {
+            offsets[level].clear();
+            pixels[level].clear();
+        }
+    }
+}
+
+const u8* TileMipmaps::get(u16 tileValue, u8 level)
+{
+    if ( level > MaxLevel )
+        throw std::out_of_range("Mipmap level " + std::to_string(level) + " is past the max level " + std::to_string(MaxLevel) + "!");
+    else if ( tiles == nullptr )
+        return nullptr;
+
+    std::vector<u32> & levelOffsets = offsets[level];
+    if ( levelOffsets.empty() )
+        levelOffsets.assign(size_t(u16_max)+1, NotBuilt);
+
+    u32 offset = levelOffsets[tileValue];
+    if ( offset == NotBuilt )
+    {
+        offset = build(tileValue, level);
+        levelOffsets[tileValue] = offset;
+    }
+    return offset == NoGraphics ? nullptr : &pixels[level][offset];
+}
+
+size_t TileMipmaps::tileSize(u8 level)
+{
+    return size_t(32) >> std::min(level, MaxLevel);
+}
+
+u8 TileMipmaps::levelFor(double zoom)
+{
+    u8 level = 0;
+    while ( level < MaxLevel && 1.0/double(2 << level) >= zoom )
+        level++;
+
+    return level;
+}
+
+u32 TileMipmaps::build(u16 tileValue, u8 level)
+{
+    size_t groupIndex = Sc::Terrain::Tiles::getGroupIndex(tileValue);
+    if ( groupIndex >= tiles->tileGroups.size() )
+        return NoGraphics;
+
+    size_t megaTileIndex = size_t(tiles->tileGroups[groupIndex].megaTileIndex[Sc::Terrain::Tiles::getGroupMemberIndex(tileValue)]);
+    if ( megaTileIndex >= tiles->tileGraphics.size() )
+        return NoGraphics;
+
+    u8 fullScale[32][32] = {};
+    const Sc::Terrain::TileGraphics & tileGraphics = tiles->tileGraphics[megaTileIndex];
+    for ( size_t yMiniTile=0; yMiniTile<4; yMiniTile++ )
+    {
+        for ( size_t xMiniTile=0; xMiniTile<4; xMiniTile++ )
+        {
+            const Sc::Terrain::TileGraphics::MiniTileGraphics & miniTileGraphics = tileGraphics.miniTileGraphics[yMiniTile][xMiniTile];
+            size_t vr4Index = size_t(miniTileGraphics.vr4Index());
+            if ( vr4Index < tiles->miniTilePixels.size() )
+            {
+                bool flipped = miniTileGraphics.isFlipped();
+                const Sc::Terrain::MiniTilePixels & miniTilePixels = tiles->miniTilePixels[vr4Index];
+                for ( size_t yPixel=0; yPixel<8; yPixel++ )
+                {
+                    for ( size_t xPixel=0; xPixel<8; xPixel++ )
+                        fullScale[yMiniTile*8+yPixel][xMiniTile*8+xPixel] = miniTilePixels.wpeIndex[yPixel][flipped ? 7-xPixel : xPixel];
+                }
+            }
+        }
+    }
+
+    std::vector<u8> & levelPixels = pixels[level];
+    size_t size = tileSize(level), blockSize = size_t(1) << level;
+    u32 offset = u32(levelPixels.size());
+    levelPixels.resize(levelPixels.size() + size*size);
+    u8* image = &levelPixels[offset];
+
+    u8 counts[Sc::NumColors] = {};
+    for ( size_t y=0; y<size; y++ )
+    {
+        for ( size_t x=0; x<size; x++ )
+        {
+            u8 mostSeen = fullScale[y*blockSize][x*blockSize];
+            for ( size_t yPixel=y*blockSize; yPixel<(y+1)*blockSize; yPixel++ )
+            {
+                for ( size_t xPixel=x*blockSize; xPixel<(x+1)*blockSize; xPixel++ )
+                {
+                    u8 wpeIndex = fullScale[yPixel][xPixel];
+                    if ( ++counts[wpeIndex] > counts[mostSeen] )
+                        mostSeen = wpeIndex;
+                }
+            }
+            image[y*size+x] = mostSeen;
+
+            for ( size_t yPixel=y*blockSize; yPixel<(y+1)*blockSize; yPixel++ ) // Reset only the counts this block touched
+            {
+                for ( size_t xPixel=x*blockSize; xPixel<(x+1)*blockSize; xPixel++ )
+                    counts[fullScale[yPixel][xPixel]] = 0;
+            }
+        }
+    }
+    return offset;
+}
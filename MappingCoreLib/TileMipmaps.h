@@ -0,0 +1,49 @@
+#ifndef TILEMIPMAPS_H
+#define TILEMIPMAPS_H
+#include "Basics.h"
+#include "Sc.h"
+#include <array>
+#include <vector>
+
+/**
+    Tile mipmaps hold megatile images for a tileset reduced to 1/2, 1/4 and 1/8 scale so zoomed out views can be drawn at the
+    resolution they're shown at rather than at full scale and shrunk afterwards
+
+    Images are built lazily the first time a tile value is asked for at a given level and kept until the tiles change; each pixel
+    of a reduced image is the palette index seen most often in the block of full scale pixels it covers (on a tie, whichever
+    reached that count first), palette indexes rather than averaged colors are kept so reduced images still color cycle
+
+    Level 0 is the full 32x32 image, level n is (32 >> n) pixels square
+*/
+
+class TileMipmaps
+{
+    public:
+        static constexpr u8 MaxLevel = 3;
+
+        TileMipmaps();
+        virtual ~TileMipmaps();
+
+        /** Sets the tiles (which must outlive this or the next call to setTiles) images are built from, images built from
+            other tiles are discarded */
+        void setTiles(const Sc::Terrain::Tiles & tiles);
+
+        /** Gets the palette indexes of tileValue's image at level (row by row from the top-left, tileSize(level) squared),
+            or nullptr if the tile value has no tile graphics; the pointer is valid until the next call to get or setTiles */
+        const u8* get(u16 tileValue, u8 level);
+
+        static size_t tileSize(u8 level); // The width and height of a tile's image at level
+        static u8 levelFor(double zoom); // The most reduced level with at least one pixel for every screen pixel at zoom
+
+    private:
+        static constexpr u32 NotBuilt = 0xFFFFFFFF;
+        static constexpr u32 NoGraphics = 0xFFFFFFFE;
+
+        const Sc::Terrain::Tiles* tiles;
+        std::array<std::vector<u32>, MaxLevel+1> offsets; // For each level, the offset of each tile value's image in pixels or NotBuilt/NoGraphics
+        std::array<std::vector<u8>, MaxLevel+1> pixels; // For each level, the images built so far
+
+        u32 build(u16 tileValue, u8 level); // Builds the image for a tile value at a level, returning its offset or NoGraphics
+};
+
+#endif
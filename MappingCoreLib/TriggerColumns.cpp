@@ -0,0 +1,338 @@
+#include "TriggerColumns.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRIGGER_COLUMNS_SSE2 // Compares 16 types or 16 ids at a time
+#endif
+
+size_t findColumnValue(const std::vector<u32> & column, size_t pos, u32 value) // Gets the position of the first value at or after pos, or the column size if there are none
+{
+    size_t size = column.size();
+#ifdef TRIGGER_COLUMNS_SSE2
+    __m128i values = _mm_set1_epi32(s32(value));
+    for ( ; pos + 16 <= size; pos += 16 ) // Skip over runs of 16 ids not matching value
+    {
+        const __m128i* ids = (const __m128i*)&column[pos];
+        __m128i matches = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(_mm_loadu_si128(&ids[0]), values), _mm_cmpeq_epi32(_mm_loadu_si128(&ids[1]), values)),
+            _mm_or_si128(_mm_cmpeq_epi32(_mm_loadu_si128(&ids[2]), values), _mm_cmpeq_epi32(_mm_loadu_si128(&ids[3]), values)));
+
+        if ( _mm_movemask_epi8(matches) != 0 )
+            break; // The match is found below
+    }
+#endif
+    while ( pos < size && column[pos] != value )
+        pos++;
+
+    return pos;
+}
+
+size_t countColumnValue(const std::vector<u8> & column, u8 value)
+{
+    size_t count = 0;
+    size_t pos = 0;
+    size_t size = column.size();
+#ifdef TRIGGER_COLUMNS_SSE2
+    __m128i values = _mm_set1_epi8(char(value));
+    for ( ; pos + 16 <= size; pos += 16 )
+    {
+        int matches = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&column[pos]), values));
+        count += std::bitset<16>(u16(matches)).count();
+    }
+#endif
+    for ( ; pos < size; pos++ )
+    {
+        if ( column[pos] == value )
+            count++;
+    }
+    return count;
+}
+
+TriggerColumns::TriggerColumns(const TrigSection & trig) : totalTriggers(trig.numTriggers())
+{
+    for ( size_t triggerIndex=0; triggerIndex<totalTriggers; triggerIndex++ )
+    {
+        const Chk::Trigger* trigger = trig.readTrigger(triggerIndex);
+        if ( trigger != nullptr )
+        {
+            for ( size_t conditionIndex=0; conditionIndex<Chk::Trigger::MaxConditions; conditionIndex++ )
+            {
+                const Chk::Condition & condition = trigger->conditions[conditionIndex];
+                if ( condition.conditionType != Chk::Condition::Type::NoCondition )
+                {
+                    conditionTriggers.push_back(u32(triggerIndex));
+                    conditionIndexes.push_back(u8(conditionIndex));
+                    conditionTypes.push_back(u8(condition.conditionType));
+                    conditionLocations.push_back(condition.locationId);
+                    conditionUnits.push_back(u16(condition.unitType));
+                    conditionPlayers.push_back(condition.player);
+                    conditionNumbers.push_back(condition.amount);
+                }
+            }
+            for ( size_t actionIndex=0; actionIndex<Chk::Trigger::MaxActions; actionIndex++ )
+            {
+                const Chk::Action & action = trigger->actions[actionIndex];
+                if ( action.actionType != Chk::Action::Type::NoAction )
+                {
+                    actionTriggers.push_back(u32(triggerIndex));
+                    actionIndexes.push_back(u8(actionIndex));
+                    actionTypes.push_back(u8(action.actionType));
+                    actionLocations.push_back(action.locationId);
+                    actionStrings.push_back(action.stringId);
+                    actionSounds.push_back(action.soundStringId);
+                    actionUnits.push_back(action.type);
+                    actionPlayers.push_back(action.group);
+                    actionNumbers.push_back(action.number);
+                }
+            }
+        }
+    }
+}
+
+TriggerColumns::~TriggerColumns()
+{
+
+}
+
+size_t TriggerColumns::numTriggers() const
+{
+    return totalTriggers;
+}
+
+size_t TriggerColumns::numConditions() const
+{
+    return conditionTypes.size();
+}
+
+size_t TriggerColumns::numActions() const
+{
+    return actionTypes.size();
+}
+
+size_t TriggerColumns::countConditions(Chk::Condition::Type conditionType) const
+{
+    if ( conditionType == Chk::Condition::Type::NoCondition )
+        return totalTriggers*Chk::Trigger::MaxConditions - conditionTypes.size();
+    else
+        return countColumnValue(conditionTypes, u8(conditionType));
+}
+
+size_t TriggerColumns::countActions(Chk::Action::Type actionType) const
+{
+    if ( actionType == Chk::Action::Type::NoAction )
+        return totalTriggers*Chk::Trigger::MaxActions - actionTypes.size();
+    else
+        return countColumnValue(actionTypes, u8(actionType));
+}
+
+bool TriggerColumns::locationUsed(size_t locationId) const
+{
+    if ( locationId > u32_max )
+        return false;
+
+    u32 value = u32(locationId);
+    for ( size_t i=findColumnValue(conditionLocations, 0, value); i<conditionLocations.size(); i=findColumnValue(conditionLocations, i+1, value) )
+    {
+        if ( conditionTypes[i] < Chk::Condition::NumConditionTypes && Chk::Condition::conditionUsesLocationArg[conditionTypes[i]] )
+            return true;
+    }
+    for ( size_t i=findColumnValue(actionLocations, 0, value); i<actionLocations.size(); i=findColumnValue(actionLocations, i+1, value) )
+    {
+        if ( actionTypes[i] < Chk::Action::NumActionTypes && Chk::Action::actionUsesLocationArg[actionTypes[i]] )
+            return true;
+    }
+    for ( size_t i=findColumnValue(actionNumbers, 0, value); i<actionNumbers.size(); i=findColumnValue(actionNumbers, i+1, value) )
+    {
+        if ( actionTypes[i] < Chk::Action::NumActionTypes && Chk::Action::actionUsesSecondaryLocationArg[actionTypes[i]] )
+            return true;
+    }
+    return false;
+}
+
+bool TriggerColumns::stringUsed(size_t stringId, u32 userMask) const
+{
+    if ( stringId > u32_max )
+        return false;
+
+    u32 value = u32(stringId);
+    if ( (userMask & Chk::StringUserFlag::TriggerAction) == Chk::StringUserFlag::TriggerAction )
+    {
+        for ( size_t i=findColumnValue(actionStrings, 0, value); i<actionStrings.size(); i=findColumnValue(actionStrings, i+1, value) )
+        {
+            if ( actionTypes[i] < Chk::Action::NumActionTypes && Chk::Action::actionUsesStringArg[actionTypes[i]] )
+                return true;
+        }
+    }
+    if ( (userMask & Chk::StringUserFlag::TriggerActionSound) == Chk::StringUserFlag::TriggerActionSound )
+    {
+        for ( size_t i=findColumnValue(actionSounds, 0, value); i<actionSounds.size(); i=findColumnValue(actionSounds, i+1, value) )
+        {
+            if ( actionTypes[i] < Chk::Action::NumActionTypes && Chk::Action::actionUsesSoundArg[actionTypes[i]] )
+                return true;
+        }
+    }
+    return false;
+}
+
+bool TriggerColumns::gameStringUsed(size_t stringId, u32 userMask) const
+{
+    if ( stringId > u32_max )
+        return false;
+
+    u32 value = u32(stringId);
+    if ( (userMask & Chk::StringUserFlag::TriggerAction) == Chk::StringUserFlag::TriggerAction )
+    {
+        for ( size_t i=findColumnValue(actionStrings, 0, value); i<actionStrings.size(); i=findColumnValue(actionStrings, i+1, value) )
+        {
+            if ( actionTypes[i] < Chk::Action::NumActionTypes && Chk::Action::actionUsesGameStringArg[actionTypes[i]] )
+                return true;
+        }
+    }
+    if ( (userMask & Chk::StringUserFlag::TriggerActionSound) == Chk::StringUserFlag::TriggerActionSound )
+    {
+        for ( size_t i=findColumnValue(actionSounds, 0, value); i<actionSounds.size(); i=findColumnValue(actionSounds, i+1, value) )
+        {
+            if ( actionTypes[i] < Chk::Action::NumActionTypes && Chk::Action::actionUsesSoundArg[actionTypes[i]] )
+                return true;
+        }
+    }
+    return false;
+}
+
+void TriggerColumns::appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask) const
+{
+    if ( stringId > u32_max )
+        return;
+
+    u32 value = u32(stringId);
+    size_t numActions = actionTypes.size();
+    bool findText = (userMask & Chk::StringUserFlag::TriggerAction) == Chk::StringUserFlag::TriggerAction;
+    bool findSound = (userMask & Chk::StringUserFlag::TriggerActionSound) == Chk::StringUserFlag::TriggerActionSound;
+    size_t text = findText ? findColumnValue(actionStrings, 0, value) : numActions;
+    size_t sound = findSound ? findColumnValue(actionSounds, 0, value) : numActions;
+    while ( text < numActions || sound < numActions ) // Text before sound within an action, actions in trigger order
+    {
+        if ( text <= sound )
+        {
+            if ( actionTypes[text] < Chk::Action::NumActionTypes && Chk::Action::actionUsesStringArg[actionTypes[text]] )
+                stringUsers.push_back(Chk::StringUser(Chk::StringUserFlag::TriggerAction, actionTriggers[text], actionIndexes[text]));
+
+            text = findColumnValue(actionStrings, text+1, value);
+        }
+        else
+        {
+            if ( actionTypes[sound] < Chk::Action::NumActionTypes && Chk::Action::actionUsesSoundArg[actionTypes[sound]] )
+                stringUsers.push_back(Chk::StringUser(Chk::StringUserFlag::TriggerActionSound, actionTriggers[sound], actionIndexes[sound]));
+
+            sound = findColumnValue(actionSounds, sound+1, value);
+        }
+    }
+}
+
+std::vector<size_t> TriggerColumns::findTriggersUsingLocation(size_t locationId) const
+{
+    std::vector<size_t> triggerIndexes;
+    if ( locationId > u32_max )
+        return triggerIndexes;
+
+    u32 value = u32(locationId);
+    for ( size_t i=findColumnValue(conditionLocations, 0, value); i<conditionLocations.size(); i=findColumnValue(conditionLocations, i+1, value) )
+    {
+        if ( conditionTypes[i] < Chk::Condition::NumConditionTypes && Chk::Condition::conditionUsesLocationArg[conditionTypes[i]] )
+            triggerIndexes.push_back(conditionTriggers[i]);
+    }
+    for ( size_t i=findColumnValue(actionLocations, 0, value); i<actionLocations.size(); i=findColumnValue(actionLocations, i+1, value) )
+    {
+        if ( actionTypes[i] < Chk::Action::NumActionTypes && Chk::Action::actionUsesLocationArg[actionTypes[i]] )
+            triggerIndexes.push_back(actionTriggers[i]);
+    }
+    for ( size_t i=findColumnValue(actionNumbers, 0, value); i<actionNumbers.size(); i=findColumnValue(actionNumbers, i+1, value) )
+    {
+        if ( actionTypes[i] < Chk::Action::NumActionTypes && Chk::Action::actionUsesSecondaryLocationArg[actionTypes[i]] )
+            triggerIndexes.push_back(actionTriggers[i]);
+    }
+    std::sort(triggerIndexes.begin(), triggerIndexes.end());
+    triggerIndexes.erase(std::unique(triggerIndexes.begin(), triggerIndexes.end()), triggerIndexes.end());
+    return triggerIndexes;
+}
+
+void TriggerColumns::markUsedLocations(std::bitset<Chk::TotalLocations+1> & locationIdUsed) const
+{
+    size_t numConditions = conditionTypes.size();
+    for ( size_t i=0; i<numConditions; i++ )
+    {
+        u32 locationId = conditionLocations[i];
+        if ( conditionTypes[i] < Chk::Condition::NumConditionTypes && Chk::Condition::conditionUsesLocationArg[conditionTypes[i]] &&
+            locationId != Chk::LocationId::NoLocation && locationId <= Chk::TotalLocations )
+        {
+            locationIdUsed[locationId] = true;
+        }
+    }
+
+    size_t numActions = actionTypes.size();
+    for ( size_t i=0; i<numActions; i++ )
+    {
+        if ( actionTypes[i] < Chk::Action::NumActionTypes )
+        {
+            u32 locationId = actionLocations[i];
+            if ( Chk::Action::actionUsesLocationArg[actionTypes[i]] && locationId != Chk::LocationId::NoLocation && locationId <= Chk::TotalLocations )
+                locationIdUsed[locationId] = true;
+
+            u32 secondaryLocationId = actionNumbers[i];
+            if ( Chk::Action::actionUsesSecondaryLocationArg[actionTypes[i]] && secondaryLocationId != Chk::LocationId::NoLocation && secondaryLocationId <= Chk::TotalLocations )
+                locationIdUsed[secondaryLocationId] = true;
+        }
+    }
+}
+
+void TriggerColumns::markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask) const
+{
+    bool markText = (userMask & Chk::StringUserFlag::TriggerAction) == Chk::StringUserFlag::TriggerAction;
+    bool markSound = (userMask & Chk::StringUserFlag::TriggerActionSound) == Chk::StringUserFlag::TriggerActionSound;
+    size_t numActions = actionTypes.size();
+    for ( size_t i=0; i<numActions; i++ )
+    {
+        if ( actionTypes[i] < Chk::Action::NumActionTypes )
+        {
+            u32 stringId = actionStrings[i];
+            if ( markText && Chk::Action::actionUsesStringArg[actionTypes[i]] && stringId > 0 && stringId < Chk::MaxStrings )
+                stringIdUsed[stringId] = true;
+
+            u32 soundStringId = actionSounds[i];
+            if ( markSound && Chk::Action::actionUsesSoundArg[actionTypes[i]] && soundStringId > 0 && soundStringId < Chk::MaxStrings )
+                stringIdUsed[soundStringId] = true;
+        }
+    }
+}
+
+void TriggerColumns::markUsedGameStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask) const
+{
+    bool markText = (userMask & Chk::StringUserFlag::TriggerAction) == Chk::StringUserFlag::TriggerAction;
+    bool markSound = (userMask & Chk::StringUserFlag::TriggerActionSound) == Chk::StringUserFlag::TriggerActionSound;
+    size_t numActions = actionTypes.size();
+    for ( size_t i=0; i<numActions; i++ )
+    {
+        if ( actionTypes[i] < Chk::Action::NumActionTypes )
+        {
+            u32 stringId = actionStrings[i];
+            if ( markText && Chk::Action::actionUsesGameStringArg[actionTypes[i]] && stringId > 0 && stringId < Chk::MaxStrings )
+                stringIdUsed[stringId] = true;
+
+            u32 soundStringId = actionSounds[i];
+            if ( markSound && Chk::Action::actionUsesSoundArg[actionTypes[i]] && soundStringId > 0 && soundStringId < Chk::MaxStrings )
+                stringIdUsed[soundStringId] = true;
+        }
+    }
+}
+
+void TriggerColumns::markUsedCommentStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const
+{
+    size_t numActions = actionTypes.size();
+    for ( size_t i=0; i<numActions; i++ )
+    {
+        u32 stringId = actionStrings[i];
+        if ( actionTypes[i] == Chk::Action::Type::Comment && stringId > 0 && stringId < Chk::MaxStrings )
+            stringIdUsed[stringId] = true;
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef TRIGGERCOLUMNS_H
+#define TRIGGERCOLUMNS_H
+#include "Basics.h"
+#include "Chk.h"
+#include "Sections.h"
+#include <bitset>
+#include <vector>
+
+/**
+    Trigger columns are a read-only structure-of-arrays copy of the conditions and actions in a list of triggers: each field is held
+    in its own column so a scan reads only the fields it needs rather than walking whole 2400 byte triggers, and only conditions and
+    actions that aren't NoCondition/NoAction are copied, so the 16 condition and 64 action slots most triggers leave empty are never scanned
+
+    Columns are a snapshot, build them once to answer many queries (e.g. the usage of every string, every trigger using a location,
+    how often each action type appears); changes made to the triggers after the columns were built are not seen by the columns,
+    Triggers::getColumns keeps columns of the scenario's triggers and rebuilds them only after the triggers may have changed
+*/
+
+class TriggerColumns
+{
+    public:
+        TriggerColumns(const TrigSection & trig);
+        virtual ~TriggerColumns();
+
+        size_t numTriggers() const;
+        size_t numConditions() const; // The number of conditions that aren't NoCondition
+        size_t numActions() const; // The number of actions that aren't NoAction
+
+        size_t countConditions(Chk::Condition::Type conditionType) const; // The number of conditions of conditionType, including NoCondition slots
+        size_t countActions(Chk::Action::Type actionType) const; // The number of actions of actionType, including NoAction slots
+
+        bool locationUsed(size_t locationId) const;
+        bool stringUsed(size_t stringId, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
+        bool gameStringUsed(size_t stringId, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
+        void appendUsage(size_t stringId, std::vector<Chk::StringUser> & stringUsers, u32 userMask = Chk::StringUserFlag::All) const; // Same users in the same order as TrigSection::appendUsage
+        std::vector<size_t> findTriggersUsingLocation(size_t locationId) const; // Gets the index of each trigger using locationId in order
+        void markUsedLocations(std::bitset<Chk::TotalLocations+1> & locationIdUsed) const;
+        void markUsedStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
+        void markUsedGameStrings(std::bitset<Chk::MaxStrings> & stringIdUsed, u32 userMask = Chk::StringUserFlag::AnyTrigger) const;
+        void markUsedCommentStrings(std::bitset<Chk::MaxStrings> & stringIdUsed) const;
+
+        // Conditions in trigger order, the trigger and condition index of each is kept in conditionTriggers and conditionIndexes
+        const std::vector<u32> & getConditionTriggers() const { return conditionTriggers; }
+        const std::vector<u8> & getConditionIndexes() const { return conditionIndexes; }
+        const std::vector<u8> & getConditionTypes() const { return conditionTypes; }
+        const std::vector<u32> & getConditionLocations() const { return conditionLocations; }
+        const std::vector<u16> & getConditionUnits() const { return conditionUnits; }
+        const std::vector<u32> & getConditionPlayers() const { return conditionPlayers; }
+        const std::vector<u32> & getConditionNumbers() const { return conditionNumbers; } // Amounts
+
+        // Actions in trigger order, the trigger and action index of each is kept in actionTriggers and actionIndexes
+        const std::vector<u32> & getActionTriggers() const { return actionTriggers; }
+        const std::vector<u8> & getActionIndexes() const { return actionIndexes; }
+        const std::vector<u8> & getActionTypes() const { return actionTypes; }
+        const std::vector<u32> & getActionLocations() const { return actionLocations; }
+        const std::vector<u32> & getActionStrings() const { return actionStrings; }
+        const std::vector<u32> & getActionSounds() const { return actionSounds; }
+        const std::vector<u16> & getActionUnits() const { return actionUnits; } // Unit/score/resource type/alliance status
+        const std::vector<u32> & getActionPlayers() const { return actionPlayers; } // Group/ZeroBasedBriefingSlot
+        const std::vector<u32> & getActionNumbers() const { return actionNumbers; } // Amount/Group2/LocDest/UnitPropNum/ScriptNum
+
+    private:
+        size_t totalTriggers;
+
+        std::vector<u32> conditionTriggers;
+        std::vector<u8> conditionIndexes;
+        std::vector<u8> conditionTypes;
+        std::vector<u32> conditionLocations;
+        std::vector<u16> conditionUnits;
+        std::vector<u32> conditionPlayers;
+        std::vector<u32> conditionNumbers;
+
+        std::vector<u32> actionTriggers;
+        std::vector<u8> actionIndexes;
+        std::vector<u8> actionTypes;
+        std::vector<u32> actionLocations;
+        std::vector<u32> actionStrings;
+        std::vector<u32> actionSounds;
+        std::vector<u16> actionUnits;
+        std::vector<u32> actionPlayers;
+        std::vector<u32> actionNumbers;
+
+        TriggerColumns(); // Disallow ctor
+};
+
+#endif
@@ -0,0 +1,202 @@
+#include "UnitSelection.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+UnitSelection::UnitSelection()
+{
+
+}
+
+UnitSelection::~UnitSelection()
+{
+
+}
+
+void UnitSelection::add(u16 index)
+{
+    if ( !contains(index) )
+    {
+        indexes.insert(indexes.begin(), index);
+        count(index);
+    }
+}
+
+void UnitSelection::remove(u16 index)
+{
+    if ( contains(index) )
+    {
+        auto toErase = std::find(indexes.begin(), indexes.end(), index);
+        if ( toErase != indexes.end() )
+        {
+            indexes.erase(toErase);
+            uncount(index);
+        }
+    }
+}
+
+void UnitSelection::clear()
+{
+    for ( u16 index : indexes )
+        uncount(index);
+
+    indexes.clear();
+}
+
+void UnitSelection::ensureFirst(u16 index)
+{
+    if ( indexes.size() > 0 && indexes[0] != index && contains(index) )
+    {
+        auto toErase = std::find(indexes.begin(), indexes.end(), index);
+        if ( toErase != indexes.end() )
+        {
+            indexes.erase(toErase);
+            indexes.insert(indexes.begin(), index);
+        }
+    }
+}
+
+void UnitSelection::set(size_t position, u16 index)
+{
+    if ( position >= indexes.size() )
+        throw std::out_of_range("Position " + std::to_string(position) + " is past the end of a selection of " + std::to_string(indexes.size()) + " units!");
+
+    replace(indexes[position], index);
+}
+
+void UnitSelection::sort(bool ascending)
+{
+    if ( ascending )
+        std::sort(indexes.begin(), indexes.end());
+    else // Sort descending
+        std::sort(indexes.begin(), indexes.end(), std::greater<u16>());
+}
+
+void UnitSelection::unitInserted(u16 index)
+{
+    for ( u16 & selectedIndex : indexes )
+    {
+        if ( selectedIndex >= index )
+            replace(selectedIndex, selectedIndex+1);
+    }
+}
+
+void UnitSelection::unitDeleted(u16 index)
+{
+    remove(index);
+    for ( u16 & selectedIndex : indexes )
+    {
+        if ( selectedIndex > index )
+            replace(selectedIndex, selectedIndex-1);
+    }
+}
+
+void UnitSelection::sendSwap(u16 oldIndex, u16 newIndex)
+{
+    for ( u16 & unitIndex : indexes )
+    {
+        if ( unitIndex == newIndex )
+            replace(unitIndex, oldIndex | SortFlags::Swapped);
+        else if ( unitIndex == oldIndex )
+            replace(unitIndex, newIndex);
+    }
+}
+
+void UnitSelection::sendMove(u16 oldIndex, u16 newIndex)
+{
+    for ( u16 & unitIndex : indexes )
+    {
+        if ( unitIndex == newIndex )
+            replace(unitIndex, oldIndex | SortFlags::Moved);
+        else if ( newIndex > unitIndex && oldIndex <= unitIndex ) // The moved unit was somewhere ahead of track and is now behind track
+            replace(unitIndex, unitIndex+1); // Selected unit index needs to be moved forward
+        else if ( newIndex < unitIndex && oldIndex >= unitIndex ) // The moved unit was somewhere behind track and is now ahead of track
+            replace(unitIndex, unitIndex-1); // Selected unit index needs to be moved backward
+    }
+}
+
+void UnitSelection::finishSwap()
+{
+    for ( u16 & unitIndex : indexes )
+    {
+        if ( unitIndex & SortFlags::Swapped )
+            replace(unitIndex, unitIndex & SortFlags::Unswap);
+    }
+}
+
+void UnitSelection::finishMove()
+{
+    for ( u16 & unitIndex : indexes )
+    {
+        if ( unitIndex & SortFlags::Moved )
+            replace(unitIndex, unitIndex & SortFlags::Unmove);
+    }
+}
+
+bool UnitSelection::contains(u16 index) const
+{
+    return size_t(index) < counts.size() && counts[index] > 0;
+}
+
+bool UnitSelection::empty() const
+{
+    return indexes.empty();
+}
+
+size_t UnitSelection::size() const
+{
+    return indexes.size();
+}
+
+size_t UnitSelection::numBefore(u16 index) const
+{
+    size_t numIndexesBefore = 0;
+    for ( u16 unitIndex : indexes )
+    {
+        if ( unitIndex < index )
+            numIndexesBefore++;
+    }
+    return numIndexesBefore;
+}
+
+const std::vector<u16> & UnitSelection::getIndexes() const
+{
+    return indexes;
+}
+
+u16 UnitSelection::first() const
+{
+    return indexes.size() > 0 ? indexes[0] : 0;
+}
+
+u16 UnitSelection::highest() const
+{
+    return indexes.size() > 0 ? *std::max_element(indexes.begin(), indexes.end()) : u16_max;
+}
+
+u16 UnitSelection::lowest() const
+{
+    return indexes.size() > 0 ? *std::min_element(indexes.begin(), indexes.end()) : u16_max;
+}
+
+void UnitSelection::count(u16 index)
+{
+    if ( size_t(index) >= counts.size() )
+        counts.resize(size_t(index)+1, 0);
+
+    counts[index]++;
+}
+
+void UnitSelection::uncount(u16 index)
+{
+    if ( size_t(index) < counts.size() && counts[index] > 0 )
+        counts[index]--;
+}
+
+void UnitSelection::replace(u16 & selectedIndex, u16 newIndex)
+{
+    uncount(selectedIndex);
+    selectedIndex = newIndex;
+    count(newIndex);
+}
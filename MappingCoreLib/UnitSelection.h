@@ -0,0 +1,57 @@
+#ifndef UNITSELECTION_H
+#define UNITSELECTION_H
+#include "Basics.h"
+#include <vector>
+
+/**
+    A unit selection holds the indexes of selected units, most recently selected first, along with how many times each unit index
+    appears in the selection so whether a unit is selected is answered without searching through the selection
+
+    Indexes are only changed through the selection so the counts stay in step; as units are inserted, deleted or reordered
+    the selection is told so through unitInserted, unitDeleted and the swap/move methods, which shift the selected indexes
+
+    While a batch of swaps or moves is being sent, indexes already swapped or moved carry a flag (so later swaps or moves in the batch
+    pass over them) until finishSwap or finishMove clears the flags; a flagged index isn't considered selected until then
+*/
+
+class UnitSelection
+{
+    public:
+        enum_t(SortFlags, u16, { Swapped = (u16)BIT_14, Moved = (u16)BIT_15, Unswap = x16BIT_14, Unmove = x16BIT_15 });
+
+        UnitSelection();
+        virtual ~UnitSelection();
+
+        void add(u16 index); // Adds index to the front of the selection if it's not already selected
+        void remove(u16 index);
+        void clear();
+        void ensureFirst(u16 index); // Moves index to the front of the selection if it's selected
+        void set(size_t position, u16 index); // Replaces the index at position in the selection with a new index
+        void sort(bool ascending);
+
+        void unitInserted(u16 index); // Call after a unit is inserted at index, selected indexes at or after it are shifted forward
+        void unitDeleted(u16 index); // Call after the unit at index is deleted, it's deselected and selected indexes after it are shifted back
+        void sendSwap(u16 oldIndex, u16 newIndex);
+        void sendMove(u16 oldIndex, u16 newIndex); // The unit is being moved back to its oldIndex from its newIndex
+        void finishSwap();
+        void finishMove();
+
+        bool contains(u16 index) const;
+        bool empty() const;
+        size_t size() const;
+        size_t numBefore(u16 index) const; // The number of selected indexes less than index
+        const std::vector<u16> & getIndexes() const;
+        u16 first() const; // 0 if nothing is selected
+        u16 highest() const; // u16_max if nothing is selected
+        u16 lowest() const; // u16_max if nothing is selected
+
+    private:
+        std::vector<u16> indexes; // The selected indexes, most recently selected first
+        std::vector<u16> counts; // The number of times each unit index appears in indexes
+
+        void count(u16 index);
+        void uncount(u16 index);
+        void replace(u16 & selectedIndex, u16 newIndex); // Replaces an entry of indexes, updating counts
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+#include "Basics.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/**
+    The worker pool runs a batch of independent tasks across the available cores and returns once every task is done
+
+    Tasks are numbered [0, numTasks) and handed out one at a time to whichever worker is free, the calling thread works
+    alongside the pool so a batch that's run with a single worker never starts a thread; tasks must not depend on one
+    another, anything order-sensitive should be merged by the caller after the batch completes
+
+    If any task throws, the remaining tasks are abandoned and the exception from the lowest numbered failed task is
+    rethrown on the calling thread
+*/
+
+namespace WorkerPool
+{
+    inline size_t defaultNumWorkers() // One worker per hardware thread, at least one
+    {
+        return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+    }
+
+    template <typename Task>
+    void run(size_t numTasks, const Task & task, size_t maxWorkers = defaultNumWorkers())
+    {
+        size_t numWorkers = std::min(numTasks, std::max(size_t(1), maxWorkers));
+        if ( numWorkers <= 1 )
+        {
+            for ( size_t taskIndex=0; taskIndex<numTasks; taskIndex++ )
+                task(taskIndex);
+
+            return;
+        }
+
+        std::atomic<size_t> nextTask(0);
+        std::atomic<bool> abandoned(false);
+        std::vector<std::exception_ptr> exceptions(numTasks);
+        auto work = [&]() {
+            for ( size_t taskIndex = nextTask++; taskIndex < numTasks && !abandoned; taskIndex = nextTask++ )
+            {
+                try {
+                    task(taskIndex);
+                } catch ( ... ) {
+                    exceptions[taskIndex] = std::current_exception();
+                    abandoned = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(numWorkers-1);
+        try {
+            for ( size_t i=1; i<numWorkers; i++ )
+                workers.push_back(std::thread(work));
+        } catch ( std::system_error & ) {} // Threads that couldn't be started leave their share of tasks to the rest
+
+        work();
+        for ( auto & worker : workers )
+            worker.join();
+
+        for ( auto & exception : exceptions )
+        {
+            if ( exception != nullptr )
+                std::rethrow_exception(exception);
+        }
+    }
+}
+
+#endif
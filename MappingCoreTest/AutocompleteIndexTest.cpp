@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <cctype>
+#include <string>
+#include <vector>
+
+bool autocompleteIndexTestStartsWith(const std::string & str, const std::string & prefix) // Matches the way suggestions were searched before they were indexed
+{
+    if ( str.length() < prefix.length() )
+        return false;
+
+    for ( size_t i = 0; i < prefix.length(); i++ )
+    {
+        if ( tolower(str[i]) != tolower(prefix[i]) )
+            return false;
+    }
+    return true;
+}
+
+std::vector<std::string> autocompleteIndexTestStrings(const AutocompleteIndex & index)
+{
+    std::vector<std::string> strings;
+    for ( size_t i=0; i<index.size(); i++ )
+        strings.push_back(index.at(i));
+
+    return strings;
+}
+
+TEST(AutocompleteIndexTest, Order)
+{
+    AutocompleteIndex index;
+    EXPECT_TRUE(index.empty());
+    index.add("Zerg Zergling");
+    index.add(std::vector<std::string> { "terran Marine", "Protoss Zealot", "Terran Ghost", "Terran" });
+    index.add("protoss Archon");
+    index.add("Terran Ghost"); // Duplicates are kept
+
+    std::vector<std::string> expected = { "protoss Archon", "Protoss Zealot", "Terran", "Terran Ghost", "Terran Ghost", "terran Marine", "Zerg Zergling" };
+    EXPECT_EQ(expected, autocompleteIndexTestStrings(index));
+    EXPECT_THROW(index.at(index.size()), std::out_of_range);
+
+    EXPECT_EQ(5, index.find("terran Marine"));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.find("Terran Marine")); // Finding is exact
+    EXPECT_TRUE(index.remove("Terran Ghost"));
+    EXPECT_TRUE(index.remove("Terran Ghost"));
+    EXPECT_FALSE(index.remove("Terran Ghost"));
+    EXPECT_TRUE(index.rename("Zerg Zergling", "Brood Zergling"));
+    EXPECT_FALSE(index.rename("Zerg Zergling", "Zerg Hydralisk"));
+
+    expected = { "Brood Zergling", "protoss Archon", "Protoss Zealot", "Terran", "terran Marine" };
+    EXPECT_EQ(expected, autocompleteIndexTestStrings(index));
+    index.clear();
+    EXPECT_EQ(0, index.size());
+}
+
+TEST(AutocompleteIndexTest, Prefixes)
+{
+    AutocompleteIndex index;
+    index.add(std::vector<std::string> { "Location 1", "Location 10", "location 2", "Anywhere", "Lobby", "No Location", "" });
+
+    size_t first = 0, last = 0;
+    index.prefixRange("LOC", first, last);
+    EXPECT_EQ(3, last - first);
+    for ( size_t i=first; i<last; i++ )
+        EXPECT_TRUE(autocompleteIndexTestStartsWith(index.at(i), "loc"));
+
+    index.prefixRange("lo", first, last);
+    EXPECT_EQ(4, last - first);
+    EXPECT_EQ("Lobby", index.at(first));
+    index.prefixRange("Locations", first, last);
+    EXPECT_EQ(first, last);
+    index.prefixRange("", first, last);
+    EXPECT_EQ(0, first);
+    EXPECT_EQ(index.size(), last);
+
+    EXPECT_EQ("Location 1", index.at(index.firstStartingWith("location 1")));
+    EXPECT_EQ("", index.at(index.firstStartingWith("")));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.firstStartingWith("Locx"));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.firstStartingWith("Anywhere "));
+}
+
+TEST(AutocompleteIndexTest, Nearest)
+{
+    AutocompleteIndex index;
+    index.add(std::vector<std::string> { "Terran Marine", "Terran Medic", "Zerg Hydralisk", "Protoss Zealot", "Set Switch", "Switch 12" });
+
+    EXPECT_EQ("Terran Marine", index.at(index.nearest("terran ma"))); // Starting with is best
+    EXPECT_EQ("Terran Medic", index.at(index.nearest("medic"))); // Then a word starting with
+    EXPECT_EQ("Switch 12", index.at(index.nearest("switch"))); // Over "Set Switch"
+    EXPECT_EQ("Set Switch", index.at(index.nearest("set")));
+    EXPECT_EQ("Zerg Hydralisk", index.at(index.nearest("hydra")));
+    EXPECT_EQ("Protoss Zealot", index.at(index.nearest("protos zea"))); // Then the fewest edits
+    EXPECT_EQ("Terran Medic", index.at(index.nearest("Terran Medc")));
+    EXPECT_EQ("Zerg Hydralisk", index.at(index.nearest("Zreg")));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.nearest("Xyzzy"));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.nearest("Zreg", 0));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, AutocompleteIndex().nearest("Terran"));
+}
+
+TEST(AutocompleteIndexTest, MatchesScan)
+{
+    std::vector<std::string> strings;
+    for ( size_t i=0; i<2000; i++ )
+        strings.push_back((i%3 == 0 ? "String " : i%3 == 1 ? "switch " : "SWITCH ") + std::to_string(i*7919 % 2000));
+
+    AutocompleteIndex index;
+    for ( size_t i=0; i<strings.size(); i += 2 )
+        index.add(strings[i]);
+    std::vector<std::string> rest;
+    for ( size_t i=1; i<strings.size(); i += 2 )
+        rest.push_back(strings[i]);
+    index.add(rest);
+    ASSERT_EQ(strings.size(), index.size());
+
+    for ( const std::string & prefix : { "s", "st", "Sw", "switch 1", "SWITCH 19", "string 7", "string 77", "x", "switch 1999", "switch 19999" } )
+    {
+        size_t first = 0, last = 0, numExpected = 0;
+        index.prefixRange(prefix, first, last);
+        for ( const std::string & str : strings )
+            numExpected += autocompleteIndexTestStartsWith(str, prefix) ? 1 : 0;
+
+        EXPECT_EQ(numExpected, last - first) << prefix;
+        for ( size_t i=first; i<last; i++ )
+            EXPECT_TRUE(autocompleteIndexTestStartsWith(index.at(i), prefix)) << prefix;
+    }
+}
+
+TEST(AutocompleteIndexTest, Rename)
+{
+    AutocompleteIndex index;
+    index.add(std::vector<std::string> { "Location 1", "Zealot Spawn", "Marine Spawn" });
+
+    EXPECT_TRUE(index.rename("Zealot Spawn", "Archon Spawn"));
+    EXPECT_EQ("Archon Spawn", index.at(index.firstStartingWith("archon")));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.firstStartingWith("Zealot"));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.find("Zealot Spawn"));
+    EXPECT_EQ(0, index.find("Archon Spawn")); // Moved into order
+
+    EXPECT_TRUE(index.remove("Marine Spawn"));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.firstStartingWith("Marine"));
+    EXPECT_EQ(2, index.size());
+}
+
+TEST(AutocompleteIndexTest, LocationNameIndexRenames)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    scenario.strings.setLocationName<RawString>(1, "Zealot Spawn");
+    scenario.strings.setLocationName<RawString>(2, "Marine Spawn");
+
+    LocationNameIndex locationNames;
+    const AutocompleteIndex & index = locationNames.get(scenario);
+    EXPECT_EQ("No Location", index.at(index.find("No Location")));
+    EXPECT_EQ("Zealot Spawn", index.at(index.firstStartingWith("zealot")));
+
+    LocationNameIndex::Rename rename = locationNames.beginRename(scenario, { 1 });
+    EXPECT_TRUE(rename.indexCurrent);
+    scenario.strings.setLocationName<RawString>(1, "Archon Spawn");
+    locationNames.endRename(scenario, rename);
+    EXPECT_EQ("Archon Spawn", index.at(index.firstStartingWith("archon")));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.firstStartingWith("Zealot"));
+    EXPECT_EQ(autocompleteIndexTestStrings(LocationNameIndex().get(scenario)), autocompleteIndexTestStrings(locationNames.get(scenario)));
+
+    size_t stringId = scenario.strings.getLocationNameStringId(2);
+    rename = locationNames.beginStringRename(scenario, stringId);
+    EXPECT_TRUE(rename.indexCurrent);
+    scenario.strings.replaceString<RawString>(stringId, "Ghost Spawn");
+    locationNames.endRename(scenario, rename);
+    EXPECT_EQ("Ghost Spawn", index.at(index.firstStartingWith("Ghost")));
+    EXPECT_EQ(AutocompleteIndex::NoMatch, index.firstStartingWith("Marine"));
+    EXPECT_EQ(autocompleteIndexTestStrings(LocationNameIndex().get(scenario)), autocompleteIndexTestStrings(locationNames.get(scenario)));
+
+    scenario.strings.setLocationName<RawString>(3, "Probe Spawn"); // Outside of a rename, the next use rebuilds
+    EXPECT_EQ("Probe Spawn", locationNames.get(scenario).at(locationNames.get(scenario).firstStartingWith("probe")));
+    EXPECT_EQ(autocompleteIndexTestStrings(LocationNameIndex().get(scenario)), autocompleteIndexTestStrings(locationNames.get(scenario)));
+}
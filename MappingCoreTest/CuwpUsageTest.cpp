@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <deque>
+#include <random>
+
+Chk::TriggerPtr cuwpUsageTestTrigger(std::initializer_list<size_t> cuwpIndexes)
+{
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    size_t actionIndex = 0;
+    for ( size_t cuwpIndex : cuwpIndexes )
+    {
+        trigger->actions[actionIndex].actionType = Chk::Action::Type::CreateUnitWithProperties;
+        trigger->actions[actionIndex].number = u32(cuwpIndex);
+        actionIndex++;
+    }
+    return trigger;
+}
+
+void cuwpUsageTestRescan(Triggers & triggers, size_t excludedTriggerIndex, size_t excludedTriggerActionIndex) // Sets usage the way it was before references were counted
+{
+    for ( size_t i=0; i<Sc::Unit::MaxCuwps; i++ )
+        triggers.setCuwpUsed(i, false);
+
+    size_t numTriggers = triggers.numTriggers();
+    for ( size_t triggerIndex=0; triggerIndex<numTriggers; triggerIndex++ )
+    {
+        Chk::TriggerPtr trigger = triggers.getTrigger(triggerIndex);
+        for ( size_t actionIndex=0; actionIndex < Chk::Trigger::MaxActions; actionIndex++ )
+        {
+            const Chk::Action & action = trigger->action(actionIndex);
+            if ( action.actionType == Chk::Action::Type::CreateUnitWithProperties && action.number < Sc::Unit::MaxCuwps && !(triggerIndex == excludedTriggerIndex && actionIndex == excludedTriggerActionIndex) )
+                triggers.setCuwpUsed(action.number, true);
+        }
+    }
+}
+
+std::vector<bool> cuwpUsageTestUsage(const Triggers & triggers)
+{
+    std::vector<bool> usage;
+    for ( size_t i=0; i<Sc::Unit::MaxCuwps; i++ )
+        usage.push_back(triggers.cuwpUsed(i));
+
+    return usage;
+}
+
+TEST(CuwpUsageTest, CountsFollowTriggerChanges)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    Triggers & triggers = scenario.triggers;
+    triggers.addTrigger(cuwpUsageTestTrigger({ 1, 2, 2 }));
+    triggers.addTrigger(cuwpUsageTestTrigger({ 2, 63, 64 })); // 64 is out of range and not counted
+    triggers.insertTrigger(0, cuwpUsageTestTrigger({ 5 }));
+    EXPECT_EQ(1, triggers.getCuwpReferences(1));
+    EXPECT_EQ(3, triggers.getCuwpReferences(2));
+    EXPECT_EQ(1, triggers.getCuwpReferences(5));
+    EXPECT_EQ(1, triggers.getCuwpReferences(63));
+    EXPECT_THROW(triggers.getCuwpReferences(64), std::out_of_range);
+    EXPECT_TRUE(triggers.cuwpReferencesMatchScan());
+
+    triggers.deleteTrigger(1);
+    EXPECT_EQ(0, triggers.getCuwpReferences(1));
+    EXPECT_EQ(1, triggers.getCuwpReferences(2));
+    triggers.moveTrigger(0, 1);
+    EXPECT_TRUE(triggers.cuwpReferencesMatchScan());
+
+    Chk::Action action = triggers.getTrigger(1)->action(0);
+    action.number = 7;
+    triggers.setAction(1, 0, action);
+    EXPECT_EQ(0, triggers.getCuwpReferences(5));
+    EXPECT_EQ(1, triggers.getCuwpReferences(7));
+    action.actionType = Chk::Action::Type::Wait; // Actions of other types don't use CUWPs even with a number
+    triggers.setAction(1, 0, action);
+    EXPECT_EQ(0, triggers.getCuwpReferences(7));
+    triggers.deleteAction(0, 0);
+    EXPECT_EQ(0, triggers.getCuwpReferences(2));
+    EXPECT_EQ(Chk::Action::Type::CreateUnitWithProperties, triggers.getTrigger(0)->action(0).actionType); // The next action moved up
+    EXPECT_TRUE(triggers.cuwpReferencesMatchScan());
+
+    std::deque<Chk::TriggerPtr> replacements = { cuwpUsageTestTrigger({ 9, 9 }), cuwpUsageTestTrigger({ 10 }) };
+    triggers.replaceRange(1, 2, replacements);
+    EXPECT_EQ(2, triggers.getCuwpReferences(9));
+    EXPECT_EQ(1, triggers.getCuwpReferences(63));
+    replacements = { cuwpUsageTestTrigger({ 11 }) };
+    triggers.replaceRange(0, triggers.numTriggers(), replacements);
+    EXPECT_EQ(0, triggers.getCuwpReferences(9));
+    EXPECT_EQ(0, triggers.getCuwpReferences(63));
+    EXPECT_EQ(1, triggers.getCuwpReferences(11));
+    EXPECT_TRUE(triggers.cuwpReferencesMatchScan());
+
+    triggers.setAction(0, 1, triggers.getTrigger(0)->action(0));
+    EXPECT_EQ(2, triggers.getCuwpReferences(11));
+    triggers.fixCuwpUsage();
+    EXPECT_TRUE(triggers.cuwpUsed(11));
+    EXPECT_TRUE(triggers.cuwpReferencesMatchScan());
+}
+
+TEST(CuwpUsageTest, SameUsageAsRescan)
+{
+    Scenario counted(Sc::Terrain::Tileset::Badlands);
+    Scenario rescanned(Sc::Terrain::Tileset::Badlands);
+    std::mt19937 random(43);
+    for ( size_t i=0; i<200; i++ )
+    {
+        counted.triggers.addTrigger(cuwpUsageTestTrigger({ random() % 70, random() % 70 }));
+        rescanned.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger(*counted.triggers.getTrigger(i))));
+    }
+
+    for ( size_t round=0; round<2000; round++ )
+    {
+        size_t triggerIndex = random() % counted.triggers.numTriggers();
+        size_t actionIndex = random() % 3;
+        switch ( random() % 4 )
+        {
+            case 0:
+            {
+                Chk::TriggerPtr trigger = cuwpUsageTestTrigger({ random() % 64 });
+                counted.triggers.insertTrigger(triggerIndex, trigger);
+                rescanned.triggers.insertTrigger(triggerIndex, Chk::TriggerPtr(new Chk::Trigger(*trigger)));
+                break;
+            }
+            case 1:
+                counted.triggers.deleteTrigger(triggerIndex);
+                rescanned.triggers.deleteTrigger(triggerIndex);
+                break;
+            case 2:
+            {
+                Chk::Action action = counted.triggers.getTrigger(triggerIndex)->action(actionIndex);
+                action.actionType = random() % 4 == 0 ? Chk::Action::Type::Wait : Chk::Action::Type::CreateUnitWithProperties;
+                action.number = u32(random() % 64);
+                counted.triggers.setAction(triggerIndex, actionIndex, action);
+                rescanned.triggers.setAction(triggerIndex, actionIndex, action);
+                break;
+            }
+            case 3:
+                counted.triggers.deleteAction(triggerIndex, actionIndex);
+                rescanned.triggers.deleteAction(triggerIndex, actionIndex);
+                break;
+        }
+
+        size_t excludedTriggerIndex = random() % (counted.triggers.numTriggers() + 1);
+        size_t excludedActionIndex = random() % 4;
+        counted.triggers.fixCuwpUsage(excludedTriggerIndex, excludedActionIndex);
+        cuwpUsageTestRescan(rescanned.triggers, excludedTriggerIndex, excludedActionIndex);
+        ASSERT_EQ(cuwpUsageTestUsage(rescanned.triggers), cuwpUsageTestUsage(counted.triggers)) << round;
+    }
+    EXPECT_TRUE(counted.triggers.cuwpReferencesMatchScan());
+}
+
+TEST(CuwpUsageTest, AddCuwpReusesUnusedSlots)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    for ( size_t i=0; i<Sc::Unit::MaxCuwps; i++ )
+    {
+        Chk::Cuwp cuwp = {};
+        cuwp.hitpointPercent = u8(i);
+        scenario.triggers.setCuwp(i, cuwp);
+        scenario.triggers.addTrigger(cuwpUsageTestTrigger({ i }));
+    }
+    scenario.triggers.fixCuwpUsage();
+    Chk::Cuwp newCuwp = {};
+    newCuwp.hitpointPercent = 100;
+    EXPECT_EQ(Sc::Unit::MaxCuwps, scenario.triggers.addCuwp(newCuwp));
+    EXPECT_EQ(20, scenario.triggers.addCuwp(newCuwp, true, 20, 0)); // The only action using CUWP 20 is the one being changed
+
+    scenario.triggers.deleteTrigger(30);
+    EXPECT_EQ(20, scenario.triggers.addCuwp(newCuwp)); // Found
+    newCuwp.hitpointPercent = 99;
+    EXPECT_EQ(30, scenario.triggers.addCuwp(newCuwp));
+}
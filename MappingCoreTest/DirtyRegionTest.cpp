@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <vector>
+
+void expectRect(s32 left, s32 top, s32 right, s32 bottom, const DirtyRegion::Rect & rect)
+{
+    EXPECT_EQ(left, rect.left);
+    EXPECT_EQ(top, rect.top);
+    EXPECT_EQ(right, rect.right);
+    EXPECT_EQ(bottom, rect.bottom);
+}
+
+TEST(DirtyRegionTest, Rect)
+{
+    DirtyRegion::Rect rect = { 10, 20, 30, 60 };
+    EXPECT_FALSE(rect.isEmpty());
+    EXPECT_EQ(20, rect.width());
+    EXPECT_EQ(40, rect.height());
+    EXPECT_EQ(800, rect.area());
+
+    DirtyRegion::Rect empty = { 10, 10, 10, 20 };
+    EXPECT_TRUE(empty.isEmpty());
+    EXPECT_EQ(0, empty.area());
+    EXPECT_FALSE(rect.intersects(empty));
+    EXPECT_TRUE(rect.contains(empty));
+
+    DirtyRegion::Rect adjacent = { 30, 20, 40, 60 };
+    EXPECT_FALSE(rect.intersects(adjacent));
+    EXPECT_TRUE(rect.touches(adjacent));
+    expectRect(10, 20, 40, 60, rect.united(adjacent));
+
+    DirtyRegion::Rect overlapping = { 25, 50, 50, 70 };
+    EXPECT_TRUE(rect.intersects(overlapping));
+    expectRect(25, 50, 30, 60, rect.intersection(overlapping));
+    EXPECT_TRUE(rect.intersection(DirtyRegion::Rect { 100, 100, 200, 200 }).isEmpty());
+    EXPECT_TRUE(rect.contains(DirtyRegion::Rect { 10, 20, 30, 60 }));
+    EXPECT_FALSE(rect.contains(overlapping));
+}
+
+TEST(DirtyRegionTest, Invalidate)
+{
+    DirtyRegion dirtyRegion;
+    EXPECT_TRUE(dirtyRegion.isEmpty());
+    dirtyRegion.invalidate(DirtyRegion::Rect { 5, 5, 5, 10 });
+    EXPECT_TRUE(dirtyRegion.isEmpty());
+
+    dirtyRegion.invalidateTiles(1, 2, 2, 3);
+    ASSERT_EQ(1, dirtyRegion.getRects().size());
+    expectRect(32, 64, 64, 96, dirtyRegion.getRects()[0]);
+
+    dirtyRegion.invalidate(DirtyRegion::Rect { 40, 70, 50, 80 }); // Contained, nothing added
+    ASSERT_EQ(1, dirtyRegion.getRects().size());
+    expectRect(32, 64, 64, 96, dirtyRegion.getRects()[0]);
+
+    dirtyRegion.invalidateTiles(2, 2, 3, 3); // Adjacent, merged
+    ASSERT_EQ(1, dirtyRegion.getRects().size());
+    expectRect(32, 64, 96, 96, dirtyRegion.getRects()[0]);
+
+    dirtyRegion.invalidateTiles(10, 10, 11, 11); // Separate
+    ASSERT_EQ(2, dirtyRegion.getRects().size());
+    EXPECT_EQ(64*32+32*32, dirtyRegion.area());
+
+    dirtyRegion.invalidate(DirtyRegion::Rect { 0, 0, 400, 400 }); // Contains both, both merged
+    ASSERT_EQ(1, dirtyRegion.getRects().size());
+    expectRect(0, 0, 400, 400, dirtyRegion.getRects()[0]);
+
+    dirtyRegion.invalidateAll();
+    EXPECT_TRUE(dirtyRegion.isAll());
+    EXPECT_FALSE(dirtyRegion.isEmpty());
+    EXPECT_TRUE(dirtyRegion.getRects().empty());
+    dirtyRegion.invalidateTiles(0, 0, 1, 1);
+    EXPECT_TRUE(dirtyRegion.getRects().empty());
+
+    dirtyRegion.clear();
+    EXPECT_TRUE(dirtyRegion.isEmpty());
+    EXPECT_FALSE(dirtyRegion.isAll());
+}
+
+TEST(DirtyRegionTest, MaxRects)
+{
+    DirtyRegion dirtyRegion(4);
+    for ( s32 i=0; i<100; i++ )
+        dirtyRegion.invalidateTiles(i*2, (i%10)*2, i*2+1, (i%10)*2+1); // Tiles that never touch
+
+    const std::vector<DirtyRegion::Rect> & rects = dirtyRegion.getRects();
+    EXPECT_LE(rects.size(), 4);
+    for ( size_t i=0; i<rects.size(); i++ )
+    {
+        for ( size_t j=i+1; j<rects.size(); j++ )
+            EXPECT_FALSE(rects[i].touches(rects[j]));
+    }
+
+    for ( s32 i=0; i<100; i++ ) // Every tile invalidated is still covered
+    {
+        DirtyRegion::Rect tile = DirtyRegion::tileRect(i*2, (i%10)*2, i*2+1, (i%10)*2+1);
+        bool covered = false;
+        for ( const DirtyRegion::Rect & rect : rects )
+            covered = covered || rect.contains(tile);
+
+        EXPECT_TRUE(covered);
+    }
+}
+
+TEST(DirtyRegionTest, Clip)
+{
+    DirtyRegion dirtyRegion;
+    DirtyRegion::Rect view = { 100, 100, 740, 580 };
+    EXPECT_TRUE(dirtyRegion.clip(view).empty());
+
+    dirtyRegion.invalidate(DirtyRegion::Rect { 0, 0, 50, 50 }); // Off screen
+    dirtyRegion.invalidate(DirtyRegion::Rect { 90, 200, 132, 232 }); // Partly on screen
+    dirtyRegion.invalidate(DirtyRegion::Rect { 300, 300, 332, 332 }); // On screen
+    std::vector<DirtyRegion::Rect> clipped = dirtyRegion.clip(view);
+    ASSERT_EQ(2, clipped.size());
+    expectRect(100, 200, 132, 232, clipped[0]);
+    expectRect(300, 300, 332, 332, clipped[1]);
+
+    dirtyRegion.invalidateAll();
+    clipped = dirtyRegion.clip(view);
+    ASSERT_EQ(1, clipped.size());
+    expectRect(100, 100, 740, 580, clipped[0]);
+}
+
+TEST(DirtyRegionTest, RedrawRegions)
+{
+    // Redrawing only the dirty regions of a framebuffer into a stale copy should match redrawing the whole framebuffer
+    const size_t width = 96, height = 64;
+    auto draw = [](PaletteFramebuffer & target, s32 left, s32 top, u16 tileShift) {
+        std::vector<PaletteFramebuffer::Slot> & slots = target.getSlots();
+        for ( size_t y=0; y<target.getHeight(); y++ )
+        {
+            for ( size_t x=0; x<target.getWidth(); x++ )
+            {
+                s32 mapX = left + s32(x), mapY = top + s32(y);
+                slots[y*target.getWidth()+x] = PaletteFramebuffer::Slot((mapX/32 + mapY/32*3 + (mapX/32 == 1 && mapY/32 == 1 ? tileShift : 0)) % 256);
+            }
+        }
+    };
+
+    PaletteFramebuffer full, partial, region;
+    full.resize(width, height);
+    partial.resize(width, height);
+    draw(partial, 0, 0, 0);
+    draw(full, 0, 0, 7);
+
+    DirtyRegion dirtyRegion;
+    dirtyRegion.invalidateTiles(1, 1, 2, 2);
+    for ( const DirtyRegion::Rect & rect : dirtyRegion.clip(DirtyRegion::Rect { 0, 0, s32(width), s32(height) }) )
+    {
+        region.resize(size_t(rect.width()), size_t(rect.height()));
+        draw(region, rect.left, rect.top, 7);
+        partial.blit(region, size_t(rect.left), size_t(rect.top));
+    }
+    EXPECT_EQ(full.getSlots(), partial.getSlots());
+}
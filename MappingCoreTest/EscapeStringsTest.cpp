@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// The reference conversions go through one character at a time, as the conversions did before they scanned for special characters in blocks
+
+void escapeStringsTestAppendHex(std::string & str, unsigned char character)
+{
+    str.push_back(character / 16 > 9 ? character / 16 + 'A' - 10 : character / 16 + '0');
+    str.push_back(character % 16 > 9 ? character % 16 + 'A' - 10 : character % 16 + '0');
+}
+
+std::string escapeStringsTestReferenceMakeEsc(const std::string & raw)
+{
+    std::string esc;
+    for ( unsigned char currChar : raw )
+    {
+        if ( currChar == '\n' )
+            esc.append("\\n");
+        else if ( currChar == '\r' )
+            esc.append("\\r");
+        else if ( currChar == '\t' )
+            esc.append("\\t");
+        else if ( currChar == '\"' )
+            esc.append("\\\"");
+        else if ( currChar == '\\' )
+            esc.append("\\\\");
+        else if ( currChar < 32 || currChar == 127 )
+        {
+            esc.append("\\x");
+            escapeStringsTestAppendHex(esc, currChar);
+        }
+        else
+            esc.push_back(currChar);
+    }
+    return esc;
+}
+
+std::string escapeStringsTestReferenceMakeChkd(const std::string & raw, bool oneLine)
+{
+    std::string chkd;
+    for ( size_t i = 0; i < raw.size(); i++ )
+    {
+        unsigned char currChar = raw[i];
+        bool partOfNewLine = ((currChar == '\r' && i + 1 < raw.size() && raw[i+1] == '\n') ||
+            (currChar == '\n' && i != 0 && raw[i - 1] == '\r'));
+
+        if ( oneLine && partOfNewLine )
+            chkd.append(currChar == '\r' ? "\\r" : "\\n");
+        else if ( oneLine && currChar == '\t' )
+            chkd.append("\\t");
+        else if ( (currChar < 32 || currChar == 127) && currChar != '\t' && !partOfNewLine )
+        {
+            chkd.push_back('<');
+            escapeStringsTestAppendHex(chkd, currChar);
+            chkd.push_back('>');
+        }
+        else if ( currChar == '<' )
+            chkd.append("\\<");
+        else if ( currChar == '\\' )
+            chkd.append("\\\\");
+        else
+            chkd.push_back(currChar);
+    }
+    return chkd;
+}
+
+bool escapeStringsTestReferenceParse(const std::string & str, bool chkd, bool bytes, std::string & raw)
+{
+    size_t lastEscCharPos = 0;
+    char escapedChar = '\0';
+    raw.clear();
+    for ( size_t i = 0; i < str.size(); i++ )
+    {
+        char currChar = str[i];
+        if ( currChar == '\\' && getSlashEscCodeChar(str, str.size(), i, escapedChar, lastEscCharPos) && (bytes || escapedChar != '\0') )
+        {
+            raw.push_back(escapedChar);
+            i = lastEscCharPos;
+        }
+        else if ( chkd && currChar == '<' && getChkdEscCodeChar(str, str.size(), i, escapedChar, lastEscCharPos) && (bytes || escapedChar != '\0') )
+        {
+            raw.push_back(escapedChar);
+            i = lastEscCharPos;
+        }
+        else if ( !bytes && currChar == '\0' )
+        {
+            raw.clear();
+            return false;
+        }
+        else
+            raw.push_back(currChar);
+    }
+    return true;
+}
+
+void escapeStringsTestCheckMake(const std::string & raw)
+{
+    EscString esc;
+    ChkdString chkd;
+    SingleLineChkdString singleLineChkd;
+    ASSERT_TRUE(makeEscStr(raw, raw.size(), esc));
+    ASSERT_TRUE(makeChkdStr(raw, raw.size(), chkd));
+    ASSERT_TRUE(makeChkdStr(raw, raw.size(), singleLineChkd));
+    ASSERT_EQ(escapeStringsTestReferenceMakeEsc(raw), esc);
+    ASSERT_EQ(escapeStringsTestReferenceMakeChkd(raw, false), chkd);
+    ASSERT_EQ(escapeStringsTestReferenceMakeChkd(raw, true), singleLineChkd);
+
+    std::vector<u8> rawBytes;
+    ASSERT_TRUE(parseEscBytes(esc, rawBytes));
+    ASSERT_EQ(raw, std::string(rawBytes.begin(), rawBytes.end()));
+    ASSERT_TRUE(parseChkdBytes(chkd, rawBytes));
+    ASSERT_EQ(raw, std::string(rawBytes.begin(), rawBytes.end()));
+    ASSERT_TRUE(parseChkdBytes(singleLineChkd, rawBytes));
+    ASSERT_EQ(raw, std::string(rawBytes.begin(), rawBytes.end()));
+
+    if ( raw.find('\0') == std::string::npos )
+    {
+        RawString parsed;
+        ASSERT_TRUE(parseEscStr(esc, parsed));
+        ASSERT_EQ(raw, parsed);
+        ASSERT_TRUE(parseChkdStr(chkd, parsed));
+        ASSERT_EQ(raw, parsed);
+        ASSERT_TRUE(parseChkdStr(singleLineChkd, parsed));
+        ASSERT_EQ(raw, parsed);
+    }
+}
+
+void escapeStringsTestCheckParse(const std::string & str)
+{
+    std::string expected;
+    RawString parsed;
+    std::vector<u8> parsedBytes;
+
+    bool expectedResult = escapeStringsTestReferenceParse(str, false, false, expected);
+    ASSERT_EQ(expectedResult, parseEscStr(EscString(str), parsed));
+    ASSERT_EQ(expected, parsed);
+    ASSERT_TRUE(escapeStringsTestReferenceParse(str, false, true, expected));
+    ASSERT_TRUE(parseEscBytes(EscString(str), parsedBytes));
+    ASSERT_EQ(expected, std::string(parsedBytes.begin(), parsedBytes.end()));
+
+    expectedResult = escapeStringsTestReferenceParse(str, true, false, expected);
+    ASSERT_EQ(expectedResult, parseChkdStr(ChkdString(str), parsed));
+    ASSERT_EQ(expected, parsed);
+    ASSERT_TRUE(escapeStringsTestReferenceParse(str, true, true, expected));
+    ASSERT_TRUE(parseChkdBytes(ChkdString(str), parsedBytes));
+    ASSERT_EQ(expected, std::string(parsedBytes.begin(), parsedBytes.end()));
+}
+
+TEST(EscapeStringsTest, EveryByteAndPair)
+{
+    escapeStringsTestCheckMake("");
+    escapeStringsTestCheckParse("");
+    for ( size_t first = 0; first < 256; first++ )
+    {
+        std::string str(1, char(first));
+        escapeStringsTestCheckMake(str);
+        escapeStringsTestCheckParse(str);
+        for ( size_t second = 0; second < 256; second++ )
+        {
+            str = std::string(1, char(first)) + char(second);
+            escapeStringsTestCheckMake(str);
+            escapeStringsTestCheckParse(str);
+            if ( ::testing::Test::HasFatalFailure() )
+                FAIL() << "Bytes " << first << ", " << second;
+        }
+    }
+}
+
+TEST(EscapeStringsTest, EscapeSequences)
+{
+    const std::string alphabet("\\<>xX078Afgn\n\r\0", 15); // Characters escape sequences are made of
+    std::string str;
+    for ( size_t length = 1; length <= 4; length++ )
+    {
+        size_t numStrings = 1;
+        for ( size_t i = 0; i < length; i++ )
+            numStrings *= alphabet.size();
+
+        for ( size_t n = 0; n < numStrings; n++ )
+        {
+            str.clear();
+            for ( size_t i = 0, remaining = n; i < length; i++, remaining /= alphabet.size() )
+                str.push_back(alphabet[remaining % alphabet.size()]);
+
+            escapeStringsTestCheckMake(str);
+            escapeStringsTestCheckParse(str);
+            if ( ::testing::Test::HasFatalFailure() )
+                FAIL() << "String " << escapeStringsTestReferenceMakeEsc(str);
+        }
+    }
+}
+
+TEST(EscapeStringsTest, BlockBoundaries)
+{
+    // Every byte at every position within and across the 16 character blocks scanned at once
+    for ( char background : { 'a', char(0x80), char(0xFF) } )
+    {
+        for ( size_t value = 0; value < 256; value++ )
+        {
+            for ( size_t pos = 0; pos < 48; pos++ )
+            {
+                std::string str(48, background);
+                str[pos] = char(value);
+                escapeStringsTestCheckMake(str);
+                escapeStringsTestCheckParse(str);
+
+                str[47-pos] = char(value); // Two special characters in the same or different blocks
+                escapeStringsTestCheckMake(str);
+                escapeStringsTestCheckParse(str);
+                if ( ::testing::Test::HasFatalFailure() )
+                    FAIL() << "Byte " << value << " at " << pos << " in " << int(u8(background));
+            }
+        }
+    }
+}
+
+TEST(EscapeStringsTest, RandomStrings)
+{
+    std::mt19937 random(39);
+    std::uniform_int_distribution<int> byteDistribution(0, 255), lengthDistribution(0, 100);
+    const std::string escapeChars("\\<>x0\r\n", 7);
+    for ( size_t i = 0; i < 20000; i++ )
+    {
+        std::string str(size_t(lengthDistribution(random)), '\0');
+        for ( char & character : str )
+        {
+            int value = byteDistribution(random);
+            character = value < 64 ? escapeChars[size_t(value) % escapeChars.size()] : char(value);
+        }
+        escapeStringsTestCheckMake(str);
+        escapeStringsTestCheckParse(str);
+        if ( ::testing::Test::HasFatalFailure() )
+            FAIL() << "String " << escapeStringsTestReferenceMakeEsc(str);
+    }
+}
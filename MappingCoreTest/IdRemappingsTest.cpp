@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <random>
+#include <vector>
+
+TEST(IdRemappingsTest, FewRemappings)
+{
+    Chk::StringIdRemappings remappings;
+    EXPECT_TRUE(remappings.empty());
+    EXPECT_EQ(0, remappings.size());
+    EXPECT_EQ(5, remappings[5]);
+    EXPECT_FALSE(remappings.isRemapped(5));
+
+    remappings.set(5, 9);
+    remappings.set(2, 3);
+    remappings.set(Chk::MaxStrings, 1); // Beyond the table, never remapped
+    EXPECT_EQ(2, remappings.size());
+    EXPECT_EQ(9, remappings[5]);
+    EXPECT_EQ(3, remappings[2]);
+    EXPECT_EQ(3, remappings[3]);
+    EXPECT_EQ(Chk::MaxStrings, remappings[Chk::MaxStrings]);
+    EXPECT_TRUE(remappings.isRemapped(5));
+    EXPECT_FALSE(remappings.isRemapped(3));
+
+    u16 stringId = 5;
+    remappings.remap(stringId);
+    EXPECT_EQ(9, stringId);
+
+    remappings.set(5, 5); // Back to itself
+    EXPECT_EQ(1, remappings.size());
+    EXPECT_FALSE(remappings.isRemapped(5));
+    remappings.set(2, 2);
+    EXPECT_TRUE(remappings.empty());
+}
+
+TEST(IdRemappingsTest, SameAsTableAcrossSparseLimit)
+{
+    constexpr size_t totalIds = Chk::TotalLocations+1;
+    std::mt19937 random(26);
+    for ( size_t maxRemapped : { size_t(8), Chk::LocationIdRemappings::MaxSparseRemappings, size_t(totalIds) } )
+    {
+        Chk::LocationIdRemappings remappings;
+        std::vector<u32> expected(totalIds);
+        for ( size_t id=0; id<totalIds; id++ )
+            expected[id] = u32(id);
+
+        size_t numRemapped = 0;
+        for ( size_t i=0; i<1000; i++ )
+        {
+            size_t oldId = random() % maxRemapped;
+            size_t newId = random() % 4 == 0 ? oldId : random() % totalIds; // Some back to themselves
+            numRemapped += (expected[oldId] == u32(oldId) && newId != oldId) ? 1 : 0;
+            numRemapped -= (expected[oldId] != u32(oldId) && newId == oldId) ? 1 : 0;
+            expected[oldId] = u32(newId);
+            remappings.set(oldId, newId);
+            ASSERT_EQ(numRemapped, remappings.size()) << maxRemapped << ", " << i;
+        }
+        for ( size_t id=0; id<totalIds; id++ )
+        {
+            EXPECT_EQ(expected[id], remappings[id]) << maxRemapped << ", " << id;
+            EXPECT_EQ(expected[id] != u32(id), remappings.isRemapped(id)) << maxRemapped << ", " << id;
+        }
+    }
+}
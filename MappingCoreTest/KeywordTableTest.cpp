@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <string>
+
+enum class TestKeyword { Move, Patrol, Attack, AttackMove };
+
+constexpr auto testKeywords = makeKeywordTable<TestKeyword>({
+    { "MOVE", TestKeyword::Move },
+    { "PATROL", TestKeyword::Patrol },
+    { "ATTACK", TestKeyword::Attack },
+    { "ATTACK MOVE", TestKeyword::AttackMove }
+});
+
+constexpr bool findsKeyword(const char* name, TestKeyword expected)
+{
+    TestKeyword keyword = TestKeyword::Move;
+    return testKeywords.find(name, PerfectHash::length(name), keyword) && keyword == expected;
+}
+
+static_assert(findsKeyword("ATTACK MOVE", TestKeyword::AttackMove), "Keyword tables should be usable at compile time");
+
+constexpr bool findsKeywordPrefix(const char* name, TestKeyword expected)
+{
+    TestKeyword keyword = TestKeyword::Move;
+    return testKeywords.findPrefix(name, PerfectHash::length(name), keyword) && keyword == expected;
+}
+
+static_assert(findsKeywordPrefix("PATROLLING", TestKeyword::Patrol) && !findsKeywordPrefix("ATTACKING", TestKeyword::Attack),
+    "Keyword prefixes should be findable at compile time");
+
+TEST(KeywordTableTest, FindKeywords)
+{
+    TestKeyword keyword = TestKeyword::Move;
+    EXPECT_TRUE(testKeywords.find("PATROL", keyword));
+    EXPECT_EQ(TestKeyword::Patrol, keyword);
+    EXPECT_TRUE(testKeywords.find("attack", keyword));
+    EXPECT_EQ(TestKeyword::Attack, keyword);
+    EXPECT_TRUE(testKeywords.find("Attack Move", keyword));
+    EXPECT_EQ(TestKeyword::AttackMove, keyword);
+
+    keyword = TestKeyword::Move;
+    EXPECT_FALSE(testKeywords.find("ATTACKMOVE", keyword));
+    EXPECT_FALSE(testKeywords.find("ATTAC", keyword));
+    EXPECT_FALSE(testKeywords.find("PATROLS", keyword));
+    EXPECT_FALSE(testKeywords.find("", keyword));
+    EXPECT_EQ(TestKeyword::Move, keyword);
+
+    for ( size_t i=0; i<testKeywords.size(); i++ )
+    {
+        EXPECT_TRUE(testKeywords.find(testKeywords[i].name, std::strlen(testKeywords[i].name), keyword));
+        EXPECT_EQ(testKeywords[i].value, keyword);
+    }
+}
+
+TEST(KeywordTableTest, FindKeywordPrefixes)
+{
+    TestKeyword keyword = TestKeyword::Move;
+    EXPECT_TRUE(testKeywords.findPrefix("PATROLS", keyword));
+    EXPECT_EQ(TestKeyword::Patrol, keyword);
+    EXPECT_TRUE(testKeywords.findPrefix("attack move to", keyword));
+    EXPECT_EQ(TestKeyword::AttackMove, keyword);
+    EXPECT_TRUE(testKeywords.findPrefix("ATTACK", keyword)); // Keywords beginning a longer keyword match in full
+    EXPECT_EQ(TestKeyword::Attack, keyword);
+
+    keyword = TestKeyword::Move;
+    EXPECT_FALSE(testKeywords.findPrefix("ATTACKS", keyword));
+    EXPECT_FALSE(testKeywords.findPrefix("ATTACK MOV", keyword));
+    EXPECT_FALSE(testKeywords.findPrefix("MOV", keyword));
+    EXPECT_FALSE(testKeywords.findPrefix("", keyword));
+    EXPECT_EQ(TestKeyword::Move, keyword);
+}
+
+TEST(KeywordTableTest, FindNames)
+{
+    NameTable<u32> names;
+    u32 value = 0;
+    EXPECT_FALSE(names.find("Location 1", value));
+
+    for ( u32 i=0; i<5000; i++ )
+        names.add("Location " + std::to_string(i), i);
+
+    names.add("Location 10", 5000); // Repeated names keep the first value added
+    EXPECT_TRUE(names.build());
+    EXPECT_EQ(5000, names.size());
+
+    for ( u32 i=0; i<5000; i++ )
+    {
+        EXPECT_TRUE(names.find("Location " + std::to_string(i), value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(names.find("location 10", value));
+    EXPECT_FALSE(names.find("Location 5000", value));
+    EXPECT_FALSE(names.find("", value));
+
+    NameTable<u32, false> caseInsensitiveNames;
+    caseInsensitiveNames.add("Anywhere", 64);
+    caseInsensitiveNames.add("ANYWHERE", 1);
+    EXPECT_TRUE(caseInsensitiveNames.build());
+    EXPECT_EQ(1, caseInsensitiveNames.size());
+    EXPECT_TRUE(caseInsensitiveNames.find("anywhere", value));
+    EXPECT_EQ(64, value);
+
+    names.clear();
+    EXPECT_TRUE(names.build());
+    EXPECT_EQ(0, names.size());
+    EXPECT_FALSE(names.find("Location 1", value));
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <deque>
+#include <random>
+#include <vector>
+
+class KtrgSectionTestReference // Allocates extended trigger data indexes the way they were before free indexes were kept, searching from the first index
+{
+    public:
+        size_t add()
+        {
+            for ( size_t i=0; i<used.size(); i++ )
+            {
+                if ( !used[i] && (i & Chk::UnusedExtendedTrigDataIndexCheck) != 0 )
+                {
+                    used[i] = true;
+                    return i;
+                }
+            }
+            while ( (used.size() & Chk::UnusedExtendedTrigDataIndexCheck) == 0 )
+                used.push_back(false);
+
+            used.push_back(true);
+            return used.size()-1;
+        }
+
+        void remove(size_t index)
+        {
+            if ( index < used.size() )
+            {
+                used[index] = false;
+                size_t i = used.size();
+                for ( ; i > 0 && (((i-1) & Chk::UnusedExtendedTrigDataIndexCheck) == 0 || !used[i-1]); i-- );
+                used.resize(i);
+            }
+        }
+
+        std::deque<bool> used;
+};
+
+void expectKtrgSectionTestSameLayout(const KtrgSectionTestReference & reference, const KtrgSection & ktrg)
+{
+    ASSERT_EQ(reference.used.size(), ktrg.numExtendedTriggers());
+    for ( size_t i=0; i<reference.used.size(); i++ )
+        EXPECT_EQ(reference.used[i], ktrg.getExtendedTrigger(i) != nullptr) << i;
+}
+
+TEST(KtrgSectionTest, SkipsUnusableIndexes)
+{
+    KtrgSectionPtr ktrg = KtrgSection::GetDefault();
+    EXPECT_EQ(0, ktrg->addExtendedTrigger(nullptr));
+    for ( size_t i=0; i<0x200; i++ )
+    {
+        size_t index = ktrg->addExtendedTrigger(Chk::ExtendedTrigDataPtr(new Chk::ExtendedTrigData()));
+        EXPECT_NE(0, index & Chk::UnusedExtendedTrigDataIndexCheck);
+    }
+    EXPECT_EQ(nullptr, ktrg->getExtendedTrigger(0x100));
+    EXPECT_EQ(nullptr, ktrg->getExtendedTrigger(0x101));
+
+    ktrg->deleteExtendedTrigger(0x150);
+    ktrg->deleteExtendedTrigger(0x20);
+    ktrg->deleteExtendedTrigger(0x20);
+    ktrg->deleteExtendedTrigger(0x100); // Unusable indexes are never handed out
+    EXPECT_EQ(0x20, ktrg->addExtendedTrigger(Chk::ExtendedTrigDataPtr(new Chk::ExtendedTrigData())));
+    EXPECT_EQ(0x150, ktrg->addExtendedTrigger(Chk::ExtendedTrigDataPtr(new Chk::ExtendedTrigData())));
+
+    size_t size = ktrg->numExtendedTriggers();
+    ktrg->deleteExtendedTrigger(size-2);
+    ktrg->deleteExtendedTrigger(size-1); // Cleans the freed indexes off the tail
+    EXPECT_EQ(size-2, ktrg->numExtendedTriggers());
+    EXPECT_EQ(size-2, ktrg->addExtendedTrigger(Chk::ExtendedTrigDataPtr(new Chk::ExtendedTrigData())));
+    EXPECT_EQ(size-1, ktrg->addExtendedTrigger(Chk::ExtendedTrigDataPtr(new Chk::ExtendedTrigData())));
+}
+
+TEST(KtrgSectionTest, SameLayoutAsSearching)
+{
+    KtrgSectionPtr ktrg = KtrgSection::GetDefault();
+    KtrgSectionTestReference reference;
+    std::mt19937 random(42);
+    for ( size_t round=0; round<20000; round++ )
+    {
+        if ( reference.used.empty() || random() % 3 != 0 )
+            ASSERT_EQ(reference.add(), ktrg->addExtendedTrigger(Chk::ExtendedTrigDataPtr(new Chk::ExtendedTrigData())));
+        else
+        {
+            size_t index = random() % (random() % 8 == 0 ? reference.used.size() : std::min(reference.used.size(), size_t(0x300)));
+            reference.remove(index);
+            ktrg->deleteExtendedTrigger(index);
+        }
+        if ( round % 1000 == 0 )
+            expectKtrgSectionTestSameLayout(reference, *ktrg);
+    }
+    expectKtrgSectionTestSameLayout(reference, *ktrg);
+
+    while ( !reference.used.empty() ) // Empty from the end so the tail is cleaned repeatedly
+    {
+        reference.remove(reference.used.size()-1);
+        ktrg->deleteExtendedTrigger(ktrg->numExtendedTriggers()-1);
+        ASSERT_EQ(reference.used.size(), ktrg->numExtendedTriggers());
+    }
+    EXPECT_TRUE(ktrg->empty());
+    EXPECT_EQ(2, ktrg->addExtendedTrigger(Chk::ExtendedTrigDataPtr(new Chk::ExtendedTrigData())));
+}
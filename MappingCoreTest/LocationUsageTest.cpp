@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <bitset>
+#include <deque>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+Chk::Condition locationUsageTestCondition(std::mt19937 & random)
+{
+    Chk::Condition::Type types[] = { Chk::Condition::Type::Bring, Chk::Condition::Type::CommandTheMostAt, Chk::Condition::Type::Deaths, Chk::Condition::Type::NoCondition };
+    Chk::Condition condition = {};
+    condition.conditionType = types[random() % 4];
+    condition.locationId = u32(random() % 16 == 0 ? 300 : random() % (Chk::TotalLocations+1)); // Some beyond the last location
+    return condition;
+}
+
+Chk::Action locationUsageTestAction(std::mt19937 & random)
+{
+    Chk::Action::Type types[] = { Chk::Action::Type::CreateUnit, Chk::Action::Type::MoveLocation, Chk::Action::Type::Order, Chk::Action::Type::Wait };
+    Chk::Action action = {};
+    action.actionType = types[random() % 4];
+    action.locationId = u32(random() % (Chk::TotalLocations+1));
+    action.number = u32(random() % 16 == 0 ? 300 : random() % (Chk::TotalLocations+1));
+    return action;
+}
+
+Chk::TriggerPtr locationUsageTestTrigger(std::mt19937 & random)
+{
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    for ( size_t i=0; i<3; i++ )
+    {
+        trigger->conditions[i] = locationUsageTestCondition(random);
+        trigger->actions[i] = locationUsageTestAction(random);
+    }
+    return trigger;
+}
+
+void expectLocationUsageTestSameAsScan(const Triggers & triggers)
+{
+    std::bitset<Chk::TotalLocations+1> scanned, indexed;
+    triggers.trig->markUsedLocations(scanned);
+    triggers.markUsedLocations(indexed);
+    EXPECT_EQ(scanned, indexed);
+    for ( size_t locationId=0; locationId<=Chk::TotalLocations+50; locationId++ )
+        EXPECT_EQ(triggers.trig->locationUsed(locationId), triggers.locationUsed(locationId)) << locationId;
+
+    EXPECT_TRUE(triggers.locationReferencesMatchScan());
+}
+
+TEST(LocationUsageTest, CountsFollowTriggerChanges)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    Triggers & triggers = scenario.triggers;
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->conditions[0].conditionType = Chk::Condition::Type::Bring;
+    trigger->conditions[0].locationId = 5;
+    trigger->conditions[1].conditionType = Chk::Condition::Type::Deaths; // Deaths has no location
+    trigger->conditions[1].locationId = 6;
+    trigger->actions[0].actionType = Chk::Action::Type::Order;
+    trigger->actions[0].locationId = 5;
+    trigger->actions[0].number = 7; // Order's destination is the secondary location
+    triggers.addTrigger(trigger);
+    EXPECT_EQ(2, triggers.getLocationReferences(5));
+    EXPECT_EQ(0, triggers.getLocationReferences(6));
+    EXPECT_EQ(1, triggers.getLocationReferences(7));
+    EXPECT_THROW(triggers.getLocationReferences(Chk::TotalLocations+1), std::out_of_range);
+    EXPECT_TRUE(triggers.locationUsed(7));
+    expectLocationUsageTestSameAsScan(triggers);
+
+    Chk::Condition condition = trigger->conditions[1];
+    condition.conditionType = Chk::Condition::Type::Bring;
+    triggers.setCondition(0, 1, condition);
+    EXPECT_TRUE(triggers.locationUsed(6));
+    triggers.deleteCondition(0, 0);
+    EXPECT_EQ(1, triggers.getLocationReferences(5));
+    EXPECT_EQ(6, triggers.getTrigger(0)->conditions[0].locationId); // The next condition moved up
+    Chk::Action action = trigger->actions[0];
+    action.number = 8;
+    triggers.setAction(0, 0, action);
+    EXPECT_FALSE(triggers.locationUsed(7));
+    EXPECT_TRUE(triggers.locationUsed(8));
+    expectLocationUsageTestSameAsScan(triggers);
+
+    triggers.deleteLocation(8);
+    EXPECT_FALSE(triggers.locationUsed(8));
+    EXPECT_EQ(0, trigger->actions[0].number);
+    Chk::LocationIdRemappings remappings;
+    remappings.set(5, 9);
+    remappings.set(6, 5);
+    triggers.remapLocationIds(remappings);
+    EXPECT_EQ(1, triggers.getLocationReferences(9));
+    EXPECT_EQ(1, triggers.getLocationReferences(5));
+    EXPECT_EQ(0, triggers.getLocationReferences(6));
+    expectLocationUsageTestSameAsScan(triggers);
+
+    triggers.deleteTrigger(0);
+    EXPECT_FALSE(triggers.locationUsed(5));
+    EXPECT_FALSE(triggers.locationUsed(9));
+    expectLocationUsageTestSameAsScan(triggers);
+}
+
+TEST(LocationUsageTest, EditsThroughTriggersAreCounted)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    for ( size_t locationId : { 3, 4 } )
+    {
+        Chk::LocationPtr location = Chk::LocationPtr(new Chk::Location());
+        location->right = 32;
+        location->bottom = 32;
+        scenario.layers.replaceLocation(locationId, location);
+    }
+    scenario.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger()));
+    Chk::Condition condition = scenario.triggers.getTrigger(0)->conditions[0];
+    condition.conditionType = Chk::Condition::Type::Bring;
+    condition.locationId = 3;
+    scenario.triggers.setCondition(0, 0, condition);
+    EXPECT_TRUE(scenario.triggers.locationUsed(3));
+
+    Chk::Trigger trigger = *scenario.triggers.getTrigger(0);
+    trigger.actions[0].actionType = Chk::Action::Type::CreateUnit;
+    trigger.actions[0].locationId = 4;
+    scenario.triggers.setTrigger(0, trigger);
+    EXPECT_TRUE(scenario.triggers.locationUsed(4));
+    scenario.layers.deleteLocation(4); // Used, not deleted
+    EXPECT_FALSE(scenario.layers.isBlank(4));
+
+    condition.locationId = 4;
+    scenario.triggers.setCondition(0, 0, condition);
+    EXPECT_FALSE(scenario.triggers.locationUsed(3));
+    scenario.layers.deleteLocation(3);
+    EXPECT_TRUE(scenario.layers.isBlank(3));
+    expectLocationUsageTestSameAsScan(scenario.triggers);
+}
+
+TEST(LocationUsageTest, ReadTriggersAreCounted)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    std::mt19937 random(45);
+    for ( size_t i=0; i<20; i++ )
+        scenario.triggers.addTrigger(locationUsageTestTrigger(random));
+
+    std::vector<u8> serialized = scenario.serialize();
+    Scenario reloaded;
+    constexpr size_t chkHeaderSize = sizeof(Chk::CHK) + sizeof(Chk::Size);
+    std::stringstream chk(std::string(serialized.begin() + chkHeaderSize, serialized.end()), std::ios_base::in|std::ios_base::binary);
+    ASSERT_TRUE(reloaded.read(chk));
+    ASSERT_EQ(20, reloaded.triggers.numTriggers());
+    expectLocationUsageTestSameAsScan(reloaded.triggers);
+
+    for ( size_t i=0; i<20; i++ ) // Triggers read together are changed one at a time
+    {
+        reloaded.triggers.setAction(i, 0, locationUsageTestAction(random));
+        ASSERT_TRUE(reloaded.triggers.locationReferencesMatchScan()) << i;
+    }
+    expectLocationUsageTestSameAsScan(reloaded.triggers);
+}
+
+TEST(LocationUsageTest, CompiledTriggersAreCounted)
+{
+    ScenarioPtr scenario = ScenarioPtr(new Scenario(Sc::Terrain::Tileset::Badlands));
+    std::mt19937 random(46);
+    for ( size_t i=0; i<5; i++ )
+        scenario->triggers.addTrigger(locationUsageTestTrigger(random));
+
+    Sc::Data scData;
+    TextTrigCompiler ttc(true, 0x0058A364);
+    std::string textTrigs = "Trigger(\"Player 1\"){\nConditions:"
+        "\n\tBring(\"Player 1\", \"Terran Marine\", \"Anywhere\", At least, 1);"
+        "\n\nActions:"
+        "\n\tDisplay Text Message(Always Display, \"Compiled\");"
+        "\n}\n\n";
+    ASSERT_TRUE(ttc.compileTriggers(textTrigs, scenario, scData, 1, 3));
+    ASSERT_EQ(4, scenario->triggers.numTriggers());
+    EXPECT_LE(size_t(1), scenario->triggers.getLocationReferences(Chk::LocationId::Anywhere));
+    expectLocationUsageTestSameAsScan(scenario->triggers);
+
+    std::string invalidText = "Trigger(\"Player 1\"){\nConditions:\n\tNot a Condition();\n}\n\n";
+    EXPECT_FALSE(ttc.compileTriggers(invalidText, scenario, scData, 0, scenario->triggers.numTriggers()));
+    EXPECT_EQ(4, scenario->triggers.numTriggers());
+    expectLocationUsageTestSameAsScan(scenario->triggers);
+
+    scenario->triggers.setAction(0, 0, locationUsageTestAction(random)); // Counts are still kept after the failed compile
+    expectLocationUsageTestSameAsScan(scenario->triggers);
+}
+
+TEST(LocationUsageTest, RemapsSecondaryLocations)
+{
+    Chk::Trigger trigger = {};
+    trigger.actions[0].actionType = Chk::Action::Type::MoveLocation; // Moves the location in 'number' to locationId
+    trigger.actions[0].locationId = 3;
+    trigger.actions[0].number = 4;
+    trigger.actions[1].actionType = Chk::Action::Type::CreateUnit; // Has no secondary location
+    trigger.actions[1].locationId = 4;
+    trigger.actions[1].number = 3;
+    Chk::LocationIdRemappings remappings;
+    remappings.set(3, 4);
+    remappings.set(4, 6);
+    trigger.remapLocationIds(remappings);
+    EXPECT_EQ(4, trigger.actions[0].locationId); // Remapped once
+    EXPECT_EQ(6, trigger.actions[0].number);
+    EXPECT_EQ(6, trigger.actions[1].locationId);
+    EXPECT_EQ(3, trigger.actions[1].number);
+
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    scenario.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger(trigger)));
+    remappings.set(3, 3);
+    remappings.set(4, 8);
+    remappings.set(6, 7);
+    scenario.triggers.remapLocationIds(remappings);
+    EXPECT_EQ(8, scenario.triggers.readTrigger(0)->actions[0].locationId);
+    EXPECT_EQ(7, scenario.triggers.readTrigger(0)->actions[0].number);
+    EXPECT_EQ(1, scenario.triggers.getLocationReferences(8));
+    EXPECT_EQ(2, scenario.triggers.getLocationReferences(7));
+    EXPECT_FALSE(scenario.triggers.locationUsed(6));
+    expectLocationUsageTestSameAsScan(scenario.triggers);
+}
+
+TEST(LocationUsageTest, SameAsScan)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    Triggers & triggers = scenario.triggers;
+    std::mt19937 random(44);
+    for ( size_t i=0; i<300; i++ )
+        triggers.addTrigger(locationUsageTestTrigger(random));
+
+    for ( size_t round=0; round<1000; round++ )
+    {
+        size_t triggerIndex = random() % triggers.numTriggers();
+        switch ( random() % 8 )
+        {
+            case 0: triggers.insertTrigger(triggerIndex, locationUsageTestTrigger(random)); break;
+            case 1: triggers.deleteTrigger(triggerIndex); break;
+            case 2: triggers.setCondition(triggerIndex, random() % 4, locationUsageTestCondition(random)); break;
+            case 3: triggers.deleteCondition(triggerIndex, random() % 4); break;
+            case 4: triggers.setAction(triggerIndex, random() % 4, locationUsageTestAction(random)); break;
+            case 5: triggers.deleteAction(triggerIndex, random() % 4); break;
+            case 6: triggers.deleteLocation(random() % (Chk::TotalLocations+1)); break;
+            case 7:
+            {
+                Chk::LocationIdRemappings remappings;
+                for ( size_t i=0; i<8; i++ )
+                    remappings.set(random() % (Chk::TotalLocations+1), random() % (Chk::TotalLocations+1));
+                triggers.remapLocationIds(remappings);
+                break;
+            }
+        }
+        if ( round % 50 == 0 )
+            expectLocationUsageTestSameAsScan(triggers);
+    }
+    std::deque<Chk::TriggerPtr> replacements = { locationUsageTestTrigger(random), locationUsageTestTrigger(random) };
+    triggers.replaceRange(10, 100, replacements);
+    expectLocationUsageTestSameAsScan(triggers);
+}
+
+TEST(LocationUsageTest, DeleteAndTrimLocations)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    scenario.layers.expandToScHybridOrExpansion();
+    for ( size_t locationId : { 10, 100, 200 } )
+    {
+        Chk::LocationPtr location = Chk::LocationPtr(new Chk::Location());
+        location->right = 32;
+        location->bottom = 32;
+        scenario.layers.replaceLocation(locationId, location);
+    }
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->actions[0].actionType = Chk::Action::Type::MoveLocation;
+    trigger->actions[0].locationId = 100;
+    trigger->actions[0].number = 200;
+    scenario.triggers.addTrigger(trigger);
+
+    scenario.layers.deleteLocation(200); // Used, not deleted
+    EXPECT_FALSE(scenario.layers.isBlank(200));
+    scenario.layers.deleteLocation(10);
+    EXPECT_TRUE(scenario.layers.isBlank(10));
+
+    EXPECT_TRUE(scenario.layers.locationsFitOriginal());
+    EXPECT_TRUE(scenario.layers.trimLocationsToOriginal());
+    EXPECT_EQ(Chk::TotalOriginalLocations, scenario.layers.numLocations());
+    EXPECT_EQ(1, trigger->actions[0].locationId);
+    EXPECT_EQ(2, trigger->actions[0].number);
+    EXPECT_TRUE(scenario.triggers.locationUsed(1));
+    EXPECT_TRUE(scenario.triggers.locationUsed(2));
+    EXPECT_FALSE(scenario.triggers.locationUsed(100));
+    EXPECT_FALSE(scenario.triggers.locationUsed(200));
+    expectLocationUsageTestSameAsScan(scenario.triggers);
+}
@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+Sc::Terrain::Tiles testTiles() // Eight tile groups whose tiles are solid or striped palette colors
+{
+    Sc::Terrain::Tiles tiles {};
+    tiles.miniTilePixels.resize(32);
+    for ( size_t i=0; i<tiles.miniTilePixels.size(); i++ )
+    {
+        for ( size_t y=0; y<8; y++ )
+        {
+            for ( size_t x=0; x<8; x++ )
+                tiles.miniTilePixels[i].wpeIndex[y][x] = u8(i%2 == 0 ? i : (x%2 == 0 ? i : i*3));
+        }
+    }
+    tiles.tileGraphics.resize(16);
+    for ( size_t i=0; i<tiles.tileGraphics.size(); i++ )
+    {
+        for ( size_t y=0; y<4; y++ )
+        {
+            for ( size_t x=0; x<4; x++ )
+                tiles.tileGraphics[i].miniTileGraphics[y][x].graphics = Sc::Terrain::TileGraphics::MiniTileGraphics::Graphics(u16(((i+x+y)%32) << 1));
+        }
+    }
+    tiles.tileGroups.resize(8);
+    for ( size_t i=0; i<tiles.tileGroups.size(); i++ )
+    {
+        for ( size_t member=0; member<16; member++ )
+            tiles.tileGroups[i].megaTileIndex[member] = u16((i+member)%16);
+    }
+    return tiles;
+}
+
+MiniMapRaster::Palette testMiniMapPalette()
+{
+    MiniMapRaster::Palette palette {};
+    for ( size_t i=0; i<Sc::NumColors; i++ )
+    {
+        palette[i].red = u8(i);
+        palette[i].green = u8(255-i);
+        palette[i].blue = u8(i*7);
+    }
+    return palette;
+}
+
+std::vector<Sc::SystemColor> testMiniMapColors()
+{
+    std::vector<Sc::SystemColor> colors(24);
+    for ( size_t i=0; i<colors.size(); i++ )
+    {
+        colors[i].red = 255;
+        colors[i].green = u8(i*10);
+        colors[i].blue = u8(i);
+    }
+    return colors;
+}
+
+Chk::UnitPtr testUnit(u16 xc, u16 yc, u8 owner)
+{
+    Chk::UnitPtr unit = Chk::UnitPtr(new Chk::Unit());
+    std::memset(unit.get(), 0, sizeof(Chk::Unit));
+    unit->xc = xc;
+    unit->yc = yc;
+    unit->owner = owner;
+    return unit;
+}
+
+Chk::SpritePtr testSprite(u16 xc, u16 yc, u8 owner)
+{
+    Chk::SpritePtr sprite = Chk::SpritePtr(new Chk::Sprite());
+    std::memset(sprite.get(), 0, sizeof(Chk::Sprite));
+    sprite->xc = xc;
+    sprite->yc = yc;
+    sprite->owner = owner;
+    sprite->flags = Chk::Sprite::SpriteFlags::DrawAsSprite;
+    return sprite;
+}
+
+void expectSameBitmap(const MiniMapRaster & expected, const MiniMapRaster & actual)
+{
+    const std::vector<Sc::SystemColor> & expectedBitmap = expected.getBitmap();
+    const std::vector<Sc::SystemColor> & actualBitmap = actual.getBitmap();
+    ASSERT_EQ(expectedBitmap.size(), actualBitmap.size());
+    size_t numDifferent = 0;
+    for ( size_t i=0; i<expectedBitmap.size(); i++ )
+    {
+        if ( expectedBitmap[i].red != actualBitmap[i].red || expectedBitmap[i].green != actualBitmap[i].green ||
+            expectedBitmap[i].blue != actualBitmap[i].blue )
+        {
+            numDifferent++;
+        }
+    }
+    EXPECT_EQ(0, numDifferent);
+}
+
+TEST(MiniMapRasterTest, Scale)
+{
+    EXPECT_EQ(4.0f, MiniMapRaster::scaleFor(32, 32));
+    EXPECT_EQ(2.0f, MiniMapRaster::scaleFor(64, 48));
+    EXPECT_EQ(1.0f, MiniMapRaster::scaleFor(96, 128));
+    EXPECT_EQ(0.5f, MiniMapRaster::scaleFor(256, 256));
+    EXPECT_EQ(0.5f, MiniMapRaster::scaleFor(192, 256));
+
+    Sc::Terrain::Tiles tiles = testTiles();
+    Scenario scenario(Sc::Terrain::Tileset::Badlands, 96, 64);
+    MiniMapRaster miniMap;
+    miniMap.rebuild(scenario, tiles, testMiniMapPalette(), testMiniMapColors());
+    EXPECT_EQ(1.0f, miniMap.getScale());
+    EXPECT_EQ(16, miniMap.getXOffset());
+    EXPECT_EQ(32, miniMap.getYOffset());
+    EXPECT_EQ(MiniMapRaster::Width*MiniMapRaster::Height, miniMap.getBitmap().size());
+}
+
+TEST(MiniMapRasterTest, AverageTileColors)
+{
+    Sc::Terrain::Tiles tiles = testTiles();
+    MiniMapRaster::Palette palette = testMiniMapPalette();
+    Scenario scenario(Sc::Terrain::Tileset::Badlands, 64, 64);
+    scenario.layers.setTile(1, 0, 16); // Group 1 member 0 uses megatile 1
+
+    MiniMapRaster miniMap;
+    miniMap.rebuild(scenario, tiles, palette, testMiniMapColors());
+
+    u32 red = 0, green = 0, blue = 0;
+    for ( size_t y=0; y<4; y++ )
+    {
+        for ( size_t x=0; x<4; x++ )
+        {
+            const Sc::Terrain::MiniTilePixels & pixels = tiles.miniTilePixels[(1+x+y)%32];
+            for ( size_t py=0; py<8; py++ )
+            {
+                for ( size_t px=0; px<8; px++ )
+                {
+                    red += palette[pixels.wpeIndex[py][px]].red;
+                    green += palette[pixels.wpeIndex[py][px]].green;
+                    blue += palette[pixels.wpeIndex[py][px]].blue;
+                }
+            }
+        }
+    }
+    const Sc::SystemColor & pixel = miniMap.getBitmap()[2]; // Scale is 2, so tile 1, 0 covers pixels 2-3 of the first row
+    EXPECT_EQ(u8(red/1024), pixel.red);
+    EXPECT_EQ(u8(green/1024), pixel.green);
+    EXPECT_EQ(u8(blue/1024), pixel.blue);
+}
+
+TEST(MiniMapRasterTest, IncrementalMatchesRebuild)
+{
+    Sc::Terrain::Tiles tiles = testTiles();
+    MiniMapRaster::Palette palette = testMiniMapPalette();
+    std::vector<Sc::SystemColor> miniMapColors = testMiniMapColors();
+    std::mt19937 random(12345);
+
+    for ( auto size : std::vector<std::pair<u16, u16>> { {64, 64}, {96, 128}, {192, 128}, {256, 256} } )
+    {
+        Scenario scenario(Sc::Terrain::Tileset::Badlands, size.first, size.second);
+        for ( size_t i=0; i<50; i++ )
+            scenario.layers.addUnit(testUnit(u16(random() % (size.first*32)), u16(random() % (size.second*32)), u8(random() % 12)));
+        for ( size_t i=0; i<20; i++ )
+            scenario.layers.addSprite(testSprite(u16(random() % (size.first*32)), u16(random() % (size.second*32)), u8(random() % 12)));
+
+        MiniMapRaster incremental, rebuilt;
+        incremental.rebuild(scenario, tiles, palette, miniMapColors);
+        for ( size_t step=0; step<400; step++ )
+        {
+            switch ( random() % 9 )
+            {
+                case 0: case 1:
+                    {
+                        size_t x = random() % size.first, y = random() % size.second;
+                        scenario.layers.setTile(x, y, u16(random() % 128));
+                        incremental.tileChanged(scenario, x, y);
+                    }
+                    break;
+                case 2:
+                    {
+                        size_t unitIndex = random() % (scenario.layers.numUnits()+1);
+                        scenario.layers.insertUnit(unitIndex, testUnit(u16(random() % (size.first*32)), u16(random() % (size.second*32)), u8(random() % 12)));
+                        incremental.unitAdded(scenario, unitIndex);
+                    }
+                    break;
+                case 3:
+                    if ( scenario.layers.numUnits() > 0 )
+                    {
+                        size_t unitIndex = random() % scenario.layers.numUnits();
+                        scenario.layers.deleteUnit(unitIndex);
+                        incremental.unitRemoved(unitIndex);
+                    }
+                    break;
+                case 4:
+                    if ( scenario.layers.numUnits() > 0 )
+                    {
+                        size_t unitIndex = random() % scenario.layers.numUnits();
+                        Chk::UnitPtr unit = scenario.layers.getUnit(unitIndex);
+                        if ( random() % 2 == 0 ) // Stack onto another unit so overlapping units are covered
+                        {
+                            Chk::UnitPtr other = scenario.layers.getUnit(random() % scenario.layers.numUnits());
+                            unit->xc = other->xc;
+                            unit->yc = other->yc;
+                        }
+                        else
+                        {
+                            unit->xc = u16(random() % (size.first*32));
+                            unit->yc = u16(random() % (size.second*32));
+                        }
+                        unit->owner = u8(random() % 12);
+                        incremental.unitChanged(scenario, unitIndex);
+                    }
+                    break;
+                case 5:
+                    {
+                        size_t player = random() % Sc::Player::TotalSlots;
+                        scenario.players.setPlayerColor(player, Chk::PlayerColor(random() % Chk::TotalColors));
+                        incremental.playerColorChanged(scenario, player);
+                    }
+                    break;
+                case 6:
+                    {
+                        size_t spriteIndex = random() % (scenario.layers.numSprites()+1);
+                        scenario.layers.insertSprite(spriteIndex, testSprite(u16(random() % (size.first*32)), u16(random() % (size.second*32)), u8(random() % 12)));
+                        incremental.spriteAdded(scenario, spriteIndex);
+                    }
+                    break;
+                case 7:
+                    if ( scenario.layers.numSprites() > 0 )
+                    {
+                        size_t spriteIndex = random() % scenario.layers.numSprites();
+                        scenario.layers.deleteSprite(spriteIndex);
+                        incremental.spriteRemoved(spriteIndex);
+                    }
+                    break;
+                case 8:
+                    if ( scenario.layers.numSprites() > 0 && scenario.layers.numUnits() > 0 )
+                    {
+                        size_t spriteIndex = random() % scenario.layers.numSprites();
+                        Chk::SpritePtr sprite = scenario.layers.getSprite(spriteIndex);
+                        Chk::UnitPtr unit = scenario.layers.getUnit(random() % scenario.layers.numUnits());
+                        sprite->xc = unit->xc; // Stack onto a unit so sprites drawn over units are covered
+                        sprite->yc = unit->yc;
+                        incremental.spriteChanged(scenario, spriteIndex);
+                    }
+                    break;
+            }
+        }
+        rebuilt.rebuild(scenario, tiles, palette, miniMapColors);
+        expectSameBitmap(rebuilt, incremental);
+    }
+}
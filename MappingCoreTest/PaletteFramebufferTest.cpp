@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <vector>
+
+Sc::SystemColor testColor(u8 red, u8 green, u8 blue)
+{
+    Sc::SystemColor color = {};
+    color.red = red;
+    color.green = green;
+    color.blue = blue;
+    return color;
+}
+
+PaletteFramebuffer::Palette testPalette(u8 offset)
+{
+    PaletteFramebuffer::Palette palette = {};
+    for ( size_t i=0; i<Sc::NumColors; i++ )
+        palette[i] = testColor(u8(i+offset), u8(255-i), u8(i/2));
+
+    return palette;
+}
+
+void expectColor(const Sc::SystemColor & expected, const Sc::SystemColor & actual)
+{
+    EXPECT_EQ(expected.red, actual.red);
+    EXPECT_EQ(expected.green, actual.green);
+    EXPECT_EQ(expected.blue, actual.blue);
+}
+
+TEST(PaletteFramebufferTest, Compose)
+{
+    const Sc::SystemColor background = testColor(1, 2, 3);
+    const Sc::SystemColor fixed = testColor(200, 100, 50);
+    const PaletteFramebuffer::Slot fixedSlot = PaletteFramebuffer::FirstFixedSlot+3;
+
+    PaletteFramebuffer framebuffer;
+    framebuffer.resize(4, 2);
+    EXPECT_EQ(4, framebuffer.getWidth());
+    EXPECT_EQ(2, framebuffer.getHeight());
+    framebuffer.fill(PaletteFramebuffer::Transparent);
+    framebuffer.setFixedColor(fixedSlot, fixed);
+    EXPECT_THROW(framebuffer.setFixedColor(0, fixed), std::out_of_range);
+    EXPECT_THROW(framebuffer.setFixedColor(PaletteFramebuffer::Transparent, fixed), std::out_of_range);
+
+    std::vector<PaletteFramebuffer::Slot> & slots = framebuffer.getSlots();
+    const PaletteFramebuffer::Slot drawn[8] = {
+        0, 1, 7, 255,
+        fixedSlot, PaletteFramebuffer::Transparent, 128, fixedSlot
+    };
+    std::copy(drawn, drawn+8, slots.begin());
+
+    PaletteFramebuffer::Palette palette = testPalette(0);
+    EXPECT_TRUE(framebuffer.setPalette(palette));
+    EXPECT_FALSE(framebuffer.setPalette(palette));
+
+    std::vector<Sc::SystemColor> bitmap(8, background);
+    framebuffer.compose(bitmap);
+    const Sc::SystemColor golden[8] = {
+        testColor(0, 255, 0), testColor(1, 254, 0), testColor(7, 248, 3), testColor(255, 0, 127),
+        fixed, background, testColor(128, 127, 64), fixed
+    };
+    for ( size_t i=0; i<8; i++ )
+        expectColor(golden[i], bitmap[i]);
+
+    std::vector<Sc::SystemColor> wrongSize(7, background);
+    EXPECT_THROW(framebuffer.compose(wrongSize), std::length_error);
+}
+
+TEST(PaletteFramebufferTest, RecomposeRotatedPalette)
+{
+    const Sc::SystemColor background = testColor(9, 9, 9);
+    const Sc::SystemColor fixed = testColor(10, 20, 30);
+    const PaletteFramebuffer::Slot fixedSlot = PaletteFramebuffer::FirstFixedSlot;
+
+    PaletteFramebuffer framebuffer;
+    framebuffer.resize(16, 16);
+    std::vector<PaletteFramebuffer::Slot> & slots = framebuffer.getSlots();
+    for ( size_t i=0; i<slots.size(); i++ )
+        slots[i] = i%17 == 0 ? fixedSlot : (i%13 == 0 ? PaletteFramebuffer::Transparent : PaletteFramebuffer::Slot(i%Sc::NumColors));
+
+    framebuffer.setFixedColor(fixedSlot, fixed);
+    PaletteFramebuffer::Palette palette = testPalette(0);
+    framebuffer.setPalette(palette);
+    std::vector<Sc::SystemColor> bitmap(slots.size(), background);
+    framebuffer.compose(bitmap);
+
+    std::rotate(palette.begin()+1, palette.begin()+2, palette.begin()+7); // Rotate a range of colors the way color cycling does
+    EXPECT_TRUE(framebuffer.setPalette(palette));
+    framebuffer.compose(bitmap);
+    for ( size_t i=0; i<slots.size(); i++ )
+    {
+        if ( slots[i] == fixedSlot )
+            expectColor(fixed, bitmap[i]);
+        else if ( slots[i] == PaletteFramebuffer::Transparent )
+            expectColor(background, bitmap[i]);
+        else
+            expectColor(palette[slots[i]], bitmap[i]);
+    }
+    expectColor(testPalette(0)[2], bitmap[1]);
+    expectColor(testPalette(0)[1], bitmap[6]);
+}
+
+TEST(PaletteFramebufferTest, PaletteSlots)
+{
+    PaletteFramebuffer::SlotMap slotMap = PaletteFramebuffer::paletteSlots();
+    for ( size_t i=0; i<Sc::NumColors; i++ )
+        EXPECT_EQ(PaletteFramebuffer::Slot(i), slotMap[i]);
+
+    PaletteFramebuffer framebuffer;
+    framebuffer.resize(3, 3);
+    framebuffer.resize(2, 1);
+    EXPECT_EQ(2, framebuffer.getSlots().size());
+}
+
+TEST(PaletteFramebufferTest, Blit)
+{
+    PaletteFramebuffer framebuffer, source;
+    framebuffer.resize(4, 3);
+    framebuffer.fill(0);
+    source.resize(2, 2);
+    source.getSlots() = { 1, 2, 3, 4 };
+
+    framebuffer.blit(source, 1, 1);
+    const std::vector<PaletteFramebuffer::Slot> golden = {
+        0, 0, 0, 0,
+        0, 1, 2, 0,
+        0, 3, 4, 0
+    };
+    EXPECT_EQ(golden, framebuffer.getSlots());
+
+    framebuffer.blit(source, 3, 2); // Clipped to the bottom-right pixel
+    EXPECT_EQ(1, framebuffer.getSlots()[11]);
+    EXPECT_EQ(4, framebuffer.getSlots()[10]);
+
+    framebuffer.blit(source, 4, 0); // Entirely outside
+    EXPECT_EQ(0, framebuffer.getSlots()[3]);
+}
+
+TEST(PaletteFramebufferTest, BlitReduced)
+{
+    PaletteFramebuffer framebuffer, source;
+    framebuffer.resize(3, 3);
+    framebuffer.fill(9);
+    source.resize(5, 4);
+    source.getSlots() = {
+        1, 0, 2, 0, 3,
+        0, 0, 0, 0, 0,
+        PaletteFramebuffer::Transparent, 0, 4, 0, 5,
+        0, 0, 0, 0, 0
+    };
+
+    framebuffer.blitReduced(source, 0, 0, 1);
+    const std::vector<PaletteFramebuffer::Slot> golden = {
+        1, 2, 3,
+        9, 4, 5,
+        9, 9, 9
+    };
+    EXPECT_EQ(golden, framebuffer.getSlots());
+
+    framebuffer.blitReduced(source, -2, 2, 1); // Clipped to the bottom-left pixel
+    EXPECT_EQ(3, framebuffer.getSlots()[6]);
+    EXPECT_EQ(9, framebuffer.getSlots()[7]);
+
+    framebuffer.blitReduced(source, 1, 0, 2); // Only the top-left slot of every 4x4 block is drawn
+    EXPECT_EQ(1, framebuffer.getSlots()[1]);
+    EXPECT_EQ(3, framebuffer.getSlots()[2]);
+    EXPECT_EQ(4, framebuffer.getSlots()[4]);
+}
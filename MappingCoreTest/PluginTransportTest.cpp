@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+class FakeTriggerPlugin // Stands in for a plugin process: maps the view by name, reads records and answers with a patch
+{
+    public:
+        std::vector<u8> run(const std::string & viewName, size_t unitToGive, u8 newOwner, size_t triggerToDisable)
+        {
+            SharedMemory sharedMemory;
+            if ( !sharedMemory.open(viewName) )
+                return std::vector<u8>();
+
+            ScenarioView view(sharedMemory.data(), sharedMemory.size());
+            if ( !view.isValid() )
+                return std::vector<u8>();
+
+            ScenarioPatch patch;
+            size_t numUnits = 0, numTriggers = 0;
+            const Chk::Unit* units = view.getRecords<Chk::Unit>(SectionName::UNIT, numUnits);
+            if ( unitToGive < numUnits )
+            {
+                Chk::Unit unit = units[unitToGive];
+                unit.owner = newOwner;
+                patch.writeRecord(SectionName::UNIT, unitToGive, unit);
+            }
+
+            const Chk::Trigger* triggers = view.getRecords<Chk::Trigger>(SectionName::TRIG, numTriggers);
+            if ( triggerToDisable < numTriggers )
+            {
+                Chk::Trigger trigger = triggers[triggerToDisable];
+                trigger.setDisabled(true);
+                patch.writeRecord(SectionName::TRIG, triggerToDisable, trigger);
+            }
+
+            Chk::Trigger addedTrigger;
+            addedTrigger.setPreserveTriggerFlagged(true);
+            patch.writeRecord(SectionName::TRIG, numTriggers, addedTrigger); // Writing at the end appends
+            return patch.serialize();
+        }
+};
+
+std::string pluginTransportTestName(const std::string & name)
+{
+    return "ChkdPluginTransportTest-" + name;
+}
+
+constexpr size_t pluginTransportTestChkHeaderSize = sizeof(Chk::CHK) + sizeof(Chk::Size); // Serialized scenarios start with the "CHK " header
+
+Scenario pluginTransportTestScenario(size_t numUnits, size_t numTriggers)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands, 96, 128);
+    for ( size_t i=0; i<numUnits; i++ )
+    {
+        Chk::UnitPtr unit = Chk::UnitPtr(new Chk::Unit());
+        std::memset(unit.get(), 0, sizeof(Chk::Unit));
+        unit->xc = u16(32*i + 16);
+        unit->yc = u16(16);
+        unit->owner = u8(i % 8);
+        scenario.layers.addUnit(unit);
+    }
+    for ( size_t i=0; i<numTriggers; i++ )
+        scenario.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger()));
+
+    return scenario;
+}
+
+TEST(PluginTransportTest, SharedMemory)
+{
+    std::string name = pluginTransportTestName("SharedMemory");
+    SharedMemory created;
+    EXPECT_FALSE(created.isOpen());
+    ASSERT_TRUE(created.create(name, 4096));
+    EXPECT_TRUE(created.isOpen());
+    EXPECT_FALSE(created.isReadOnly());
+    ASSERT_NE(nullptr, created.writableData());
+    for ( size_t i=0; i<4096; i++ )
+        created.writableData()[i] = u8(i*7);
+
+    SharedMemory opened;
+    ASSERT_TRUE(opened.open(name));
+    EXPECT_TRUE(opened.isReadOnly());
+    EXPECT_EQ(nullptr, opened.writableData()); // Opened read-only
+    ASSERT_GE(opened.size(), 4096);
+    EXPECT_EQ(0, std::memcmp(created.data(), opened.data(), 4096));
+
+    created.writableData()[100] = 42; // Both map the same memory
+    EXPECT_EQ(42, opened.data()[100]);
+
+    created.close();
+    EXPECT_FALSE(created.isOpen());
+    EXPECT_EQ(42, opened.data()[100]); // Readers keep their mapping once the creator closes
+    SharedMemory reopened;
+    EXPECT_FALSE(reopened.open(name)); // But the name is released
+    EXPECT_FALSE(reopened.open(""));
+}
+
+TEST(PluginTransportTest, ViewMatchesScenario)
+{
+    Scenario scenario = pluginTransportTestScenario(5, 3);
+    std::vector<u8> bytes = ScenarioView::write(scenario);
+    ScenarioView view(&bytes[0], bytes.size());
+    ASSERT_TRUE(view.isValid());
+    EXPECT_GT(view.numSections(), 10);
+
+    size_t size = 0;
+    const u8* dim = view.getSectionData(SectionName::DIM, size);
+    ASSERT_EQ(4, size);
+    EXPECT_EQ(96, ((const u16*)dim)[0]);
+    EXPECT_EQ(128, ((const u16*)dim)[1]);
+
+    size_t numUnits = 0, numTriggers = 0;
+    const Chk::Unit* units = view.getRecords<Chk::Unit>(SectionName::UNIT, numUnits);
+    ASSERT_EQ(5, numUnits);
+    for ( size_t i=0; i<numUnits; i++ )
+    {
+        EXPECT_EQ(scenario.layers.getUnit(i)->xc, units[i].xc);
+        EXPECT_EQ(scenario.layers.getUnit(i)->owner, units[i].owner);
+    }
+    view.getRecords<Chk::Trigger>(SectionName::TRIG, numTriggers);
+    EXPECT_EQ(3, numTriggers);
+
+    ScenarioView::SectionData sectionData = {};
+    EXPECT_FALSE(view.getSection(SectionName::UNKNOWN, sectionData));
+    EXPECT_THROW(view.getSection(view.numSections()), std::out_of_range);
+    for ( size_t i=0; i<view.numSections(); i++ )
+        EXPECT_EQ(0, size_t(view.getSection(i).data - &bytes[0]) % 8);
+
+    EXPECT_FALSE(ScenarioView(&bytes[0], bytes.size()/2).isValid()); // Truncated views have no sections
+    EXPECT_EQ(0, ScenarioView(&bytes[0], bytes.size()/2).numSections());
+    EXPECT_FALSE(ScenarioView(nullptr, 0).isValid());
+}
+
+TEST(PluginTransportTest, PatchSerialization)
+{
+    ScenarioPatch patch;
+    EXPECT_TRUE(patch.empty());
+    const u8 data[] = { 1, 2, 3, 4, 5 };
+    patch.replaceSection(SectionName::SWNM, data, sizeof(data));
+    patch.write(SectionName::UNIT, 36, data, 3);
+    patch.resize(SectionName::TRIG, 2400);
+    EXPECT_EQ(3, patch.numOperations());
+    EXPECT_THROW(patch.write(SectionName::UNIT, size_t(ChkSection::MaxChkSectionSize), data, 1), std::out_of_range);
+
+    std::vector<u8> serialized = patch.serialize();
+    ScenarioPatch deserialized;
+    ASSERT_TRUE(deserialized.deserialize(&serialized[0], serialized.size()));
+    EXPECT_EQ(3, deserialized.numOperations());
+    EXPECT_EQ(serialized, deserialized.serialize());
+
+    EXPECT_FALSE(deserialized.deserialize(&serialized[0], serialized.size()-1));
+    EXPECT_TRUE(deserialized.empty());
+    serialized.push_back(0);
+    EXPECT_FALSE(deserialized.deserialize(&serialized[0], serialized.size()));
+    serialized.pop_back();
+    serialized[0] ^= 0xFF;
+    EXPECT_FALSE(deserialized.deserialize(&serialized[0], serialized.size()));
+}
+
+TEST(PluginTransportTest, FakePluginRoundTrip)
+{
+    Scenario scenario = pluginTransportTestScenario(5, 3);
+    MtxmSectionPtr mtxm = scenario.layers.mtxm;
+    SharedMemory view;
+    ASSERT_TRUE(ScenarioView::publish(scenario, pluginTransportTestName("RoundTrip"), view));
+
+    FakeTriggerPlugin plugin;
+    std::vector<u8> patchData = plugin.run(pluginTransportTestName("RoundTrip"), 2, 7, 1);
+    ASSERT_FALSE(patchData.empty());
+    view.close();
+
+    ScenarioPatch patch;
+    ASSERT_TRUE(patch.deserialize(&patchData[0], patchData.size()));
+    EXPECT_EQ(3, patch.numOperations());
+    ASSERT_TRUE(patch.apply(scenario));
+
+    ASSERT_EQ(5, scenario.layers.numUnits());
+    for ( size_t i=0; i<5; i++ )
+    {
+        EXPECT_EQ(u16(32*i + 16), scenario.layers.getUnit(i)->xc);
+        EXPECT_EQ(i == 2 ? 7 : u8(i % 8), scenario.layers.getUnit(i)->owner);
+    }
+    ASSERT_EQ(4, scenario.triggers.numTriggers());
+    EXPECT_FALSE(scenario.triggers.getTrigger(0)->disabled());
+    EXPECT_TRUE(scenario.triggers.getTrigger(1)->disabled());
+    EXPECT_TRUE(scenario.triggers.getTrigger(3)->preserveTriggerFlagged());
+    EXPECT_EQ(mtxm, scenario.layers.mtxm); // Sections the patch didn't touch aren't read again
+
+    std::vector<u8> serialized = scenario.serialize(); // The patched sections are the ones saved
+    Scenario reloaded;
+    std::stringstream chk(std::string(serialized.begin() + pluginTransportTestChkHeaderSize, serialized.end()), std::ios_base::in|std::ios_base::binary);
+    ASSERT_TRUE(reloaded.read(chk));
+    EXPECT_EQ(7, reloaded.layers.getUnit(2)->owner);
+    EXPECT_EQ(4, reloaded.triggers.numTriggers());
+}
+
+TEST(PluginTransportTest, InvalidPatchChangesNothing)
+{
+    Scenario scenario = pluginTransportTestScenario(5, 3);
+    Chk::Unit unit = *scenario.layers.getUnit(0);
+    unit.owner = 6;
+
+    ScenarioPatch patch;
+    patch.writeRecord(SectionName::UNIT, 0, unit);
+    patch.write(SectionName::SWNM, 100000, &unit, sizeof(unit)); // Past the end of the section
+    EXPECT_FALSE(patch.apply(scenario));
+    EXPECT_EQ(0, scenario.layers.getUnit(0)->owner);
+    EXPECT_EQ(5, scenario.layers.numUnits());
+}
+
+TEST(PluginTransportTest, DiffReplacesChangedSections)
+{
+    Scenario scenario = pluginTransportTestScenario(5, 3);
+    Scenario updated = pluginTransportTestScenario(5, 3);
+    updated.layers.getUnit(2)->owner = 7;
+    Chk::Trigger disabledTrigger = *updated.triggers.getTrigger(1);
+    disabledTrigger.setDisabled(true);
+    updated.triggers.setTrigger(1, disabledTrigger);
+
+    std::vector<u8> currentView = ScenarioView::write(scenario), updatedView = ScenarioView::write(updated);
+    ScenarioPatch patch;
+    ASSERT_TRUE(patch.diff(ScenarioView(&currentView[0], currentView.size()), ScenarioView(&updatedView[0], updatedView.size())));
+    EXPECT_EQ(2, patch.numOperations());
+
+    MtxmSectionPtr mtxm = scenario.layers.mtxm;
+    ASSERT_TRUE(patch.apply(scenario));
+    EXPECT_EQ(7, scenario.layers.getUnit(2)->owner);
+    EXPECT_TRUE(scenario.triggers.getTrigger(1)->disabled());
+    EXPECT_EQ(mtxm, scenario.layers.mtxm); // Unchanged sections aren't read again
+    EXPECT_EQ(updatedView, ScenarioView::write(scenario));
+
+    EXPECT_TRUE(patch.diff(ScenarioView(&updatedView[0], updatedView.size()), ScenarioView(&updatedView[0], updatedView.size())));
+    EXPECT_TRUE(patch.empty());
+    EXPECT_FALSE(patch.diff(ScenarioView(&currentView[0], currentView.size()), ScenarioView(nullptr, 0)));
+}
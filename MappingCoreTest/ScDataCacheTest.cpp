@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include "TestAssets.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+std::string scDataCacheTestPath(const std::string & fileName)
+{
+    return (std::filesystem::temp_directory_path() / ("ScDataCacheTest_" + fileName)).string();
+}
+
+void writeScDataCacheTestFile(const std::string & filePath, const std::string & contents)
+{
+    std::ofstream file(filePath, std::ios_base::out|std::ios_base::binary|std::ios_base::trunc);
+    file << contents;
+}
+
+std::vector<u8> readScDataCacheTestFile(const std::string & filePath)
+{
+    std::ifstream file(filePath, std::ios_base::in|std::ios_base::binary);
+    return std::vector<u8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void fillScDataCacheTestPalettes(Sc::Data & data)
+{
+    for ( size_t i=0; i<256; i++ )
+    {
+        data.tunit.palette.push_back(Sc::SystemColor(u8(i), u8(255-i), u8(i/2)));
+        if ( i < 24 )
+            data.tselect.palette.push_back(Sc::SystemColor(u8(i*3), 0, u8(i)));
+    }
+    data.tminimap.palette.push_back(Sc::SystemColor(1, 2, 3));
+}
+
+void expectSamePalette(const std::vector<Sc::SystemColor> & expected, const std::vector<Sc::SystemColor> & actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for ( size_t i=0; i<expected.size(); i++ )
+    {
+        EXPECT_EQ(expected[i].red, actual[i].red);
+        EXPECT_EQ(expected[i].green, actual[i].green);
+        EXPECT_EQ(expected[i].blue, actual[i].blue);
+    }
+}
+
+TEST(ScDataCacheTest, SourceKeyTracksArchives)
+{
+    std::string starDat = scDataCacheTestPath("StarDat.mpq"), brooDat = scDataCacheTestPath("BrooDat.mpq");
+    writeScDataCacheTestFile(starDat, "star");
+    writeScDataCacheTestFile(brooDat, "brood");
+
+    std::string key = ScDataCache::getSourceKey(std::vector<std::string> { brooDat, starDat });
+    EXPECT_EQ(key, ScDataCache::getSourceKey(std::vector<std::string> { brooDat, starDat }));
+    EXPECT_NE(key, ScDataCache::getSourceKey(std::vector<std::string> { starDat, brooDat })); // Priority order matters
+    EXPECT_NE(key, ScDataCache::getSourceKey(std::vector<std::string> { brooDat }));
+
+    writeScDataCacheTestFile(starDat, "starcraft"); // Patching an archive changes the key
+    EXPECT_NE(key, ScDataCache::getSourceKey(std::vector<std::string> { brooDat, starDat }));
+
+    key = ScDataCache::getSourceKey(std::vector<std::string> { brooDat, starDat });
+    auto lastWriteTime = std::filesystem::last_write_time(starDat);
+    writeScDataCacheTestFile(starDat, "starcrack"); // Replaced with the same size and last write time
+    std::filesystem::last_write_time(starDat, lastWriteTime);
+    EXPECT_NE(key, ScDataCache::getSourceKey(std::vector<std::string> { brooDat, starDat }));
+
+    std::filesystem::remove(starDat);
+    std::filesystem::remove(brooDat);
+    EXPECT_NE(key, ScDataCache::getSourceKey(std::vector<std::string> { brooDat, starDat })); // Missing archives still give a key
+}
+
+TEST(ScDataCacheTest, RoundTrip)
+{
+    std::string cacheFilePath = scDataCacheTestPath("RoundTrip.cache"), rewrittenFilePath = scDataCacheTestPath("RoundTripRewritten.cache");
+    Sc::Data data;
+    fillScDataCacheTestPalettes(data);
+    EXPECT_TRUE(ScDataCache::write(data, "key", cacheFilePath));
+
+    Sc::Data loaded;
+    EXPECT_FALSE(ScDataCache::read(loaded, "otherKey", cacheFilePath));
+    EXPECT_TRUE(loaded.tunit.palette.empty());
+    EXPECT_FALSE(ScDataCache::read(loaded, "key", scDataCacheTestPath("Missing.cache")));
+
+    EXPECT_TRUE(ScDataCache::read(loaded, "key", cacheFilePath));
+    expectSamePalette(data.tunit.palette, loaded.tunit.palette);
+    expectSamePalette(data.tselect.palette, loaded.tselect.palette);
+    expectSamePalette(data.tminimap.palette, loaded.tminimap.palette);
+    EXPECT_EQ(0, loaded.sprites.numGrps());
+    EXPECT_EQ(0, loaded.ai.numEntries());
+
+    EXPECT_TRUE(ScDataCache::write(loaded, "key", rewrittenFilePath)); // Everything read is written back the same
+    EXPECT_EQ(readScDataCacheTestFile(cacheFilePath), readScDataCacheTestFile(rewrittenFilePath));
+
+    std::filesystem::remove(cacheFilePath);
+    std::filesystem::remove(rewrittenFilePath);
+}
+
+TEST(ScDataCacheTest, IncompleteCacheIsRejected)
+{
+    std::string cacheFilePath = scDataCacheTestPath("Incomplete.cache");
+    Sc::Data data;
+    fillScDataCacheTestPalettes(data);
+    EXPECT_TRUE(ScDataCache::write(data, "key", cacheFilePath));
+    std::vector<u8> contents = readScDataCacheTestFile(cacheFilePath);
+
+    for ( size_t size : { size_t(0), size_t(10), contents.size()/2, contents.size()-1 } )
+    {
+        writeScDataCacheTestFile(cacheFilePath, std::string(contents.begin(), contents.begin()+size));
+        Sc::Data loaded;
+        loaded.tminimap.palette.push_back(Sc::SystemColor(4, 5, 6));
+        EXPECT_FALSE(ScDataCache::read(loaded, "key", cacheFilePath));
+        ASSERT_EQ(1, loaded.tminimap.palette.size()); // Left unchanged
+        EXPECT_EQ(4, loaded.tminimap.palette[0].red);
+    }
+
+    contents.push_back(0); // Trailing bytes mean the file isn't what was written
+    writeScDataCacheTestFile(cacheFilePath, std::string(contents.begin(), contents.end()));
+    Sc::Data loaded;
+    EXPECT_FALSE(ScDataCache::read(loaded, "key", cacheFilePath));
+
+    std::filesystem::remove(cacheFilePath);
+}
+
+TEST(ScDataCacheTest, LoadedDataRoundTrip)
+{
+    Sc::Data data;
+    TestAssets::LoadScData(data);
+    std::string cacheFilePath = scDataCacheTestPath("Loaded.cache");
+    EXPECT_TRUE(ScDataCache::write(data, "key", cacheFilePath));
+
+    Sc::Data loaded;
+    EXPECT_TRUE(ScDataCache::read(loaded, "key", cacheFilePath));
+    for ( size_t i=0; i<Sc::Terrain::NumTilesets; i++ )
+    {
+        const Sc::Terrain::Tiles & expected = data.terrain.get(Sc::Terrain::Tileset(i));
+        const Sc::Terrain::Tiles & actual = loaded.terrain.get(Sc::Terrain::Tileset(i));
+        EXPECT_EQ(expected.tileGroups.size(), actual.tileGroups.size());
+        EXPECT_EQ(expected.miniTilePixels.size(), actual.miniTilePixels.size());
+        EXPECT_EQ(0, std::memcmp(&expected.systemColorPalette[0], &actual.systemColorPalette[0], sizeof(expected.systemColorPalette)));
+    }
+    EXPECT_EQ(data.sprites.numGrps(), loaded.sprites.numGrps());
+    EXPECT_EQ(data.sprites.numImages(), loaded.sprites.numImages());
+    ASSERT_EQ(data.ai.numEntries(), loaded.ai.numEntries());
+    for ( size_t i=0; i<data.ai.numEntries(); i++ )
+        EXPECT_EQ(data.ai.getName(i), loaded.ai.getName(i));
+
+    expectSamePalette(data.tunit.palette, loaded.tunit.palette);
+    std::filesystem::remove(cacheFilePath);
+}
@@ -0,0 +1,297 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+void appendScStrArenaTestValue(std::vector<u8> & bytes, u32 value, size_t size)
+{
+    for ( size_t i=0; i<size; i++ )
+        bytes.push_back(u8(value >> (8*i)));
+}
+
+std::vector<u8> scStrArenaTestStrBytes(const std::vector<u16> & offsets, const std::string & characters)
+{
+    std::vector<u8> bytes;
+    appendScStrArenaTestValue(bytes, u32(offsets.size()), sizeof(u16));
+    for ( u16 offset : offsets )
+        appendScStrArenaTestValue(bytes, offset, sizeof(u16));
+
+    bytes.insert(bytes.end(), characters.begin(), characters.end());
+    return bytes;
+}
+
+bool loadScStrArenaTestSection(Scenario & scenario, SectionName sectionName, const std::vector<u8> & bytes)
+{
+    ScenarioPatch patch;
+    patch.replaceSection(sectionName, &bytes[0], bytes.size());
+    return patch.apply(scenario);
+}
+
+TEST(ScStrArenaTest, Intern)
+{
+    ScStrArena arena;
+    EXPECT_EQ(ScStrArena::NoStr, arena.find("abc", 3));
+
+    u32 abc = arena.intern("abc", 3);
+    ASSERT_NE(ScStrArena::NoStr, abc);
+    EXPECT_STREQ("abc", arena.str(abc));
+    EXPECT_EQ(3, arena.length(abc));
+    EXPECT_EQ(abc, arena.intern("abcd", 3)); // Only length characters are interned
+    EXPECT_EQ(abc, arena.find("abc", 3));
+    EXPECT_NE(abc, arena.intern("abd", 3));
+    EXPECT_NE(abc, arena.intern("ab", 2));
+    u32 empty = arena.intern("", 0);
+    EXPECT_NE(ScStrArena::NoStr, empty);
+    EXPECT_STREQ("", arena.str(empty));
+    EXPECT_EQ(4, arena.numInterned());
+    EXPECT_EQ(1, arena.numBlocks());
+
+    std::vector<u32> interned;
+    for ( size_t i=0; i<10000; i++ ) // Enough to grow the table several times
+    {
+        std::string str = "String " + std::to_string(i);
+        interned.push_back(arena.intern(str.c_str(), str.size()));
+    }
+    for ( size_t i=0; i<10000; i++ )
+    {
+        std::string str = "String " + std::to_string(i);
+        EXPECT_EQ(interned[i], arena.find(str.c_str(), str.size()));
+        EXPECT_STREQ(str.c_str(), arena.str(interned[i]));
+    }
+    EXPECT_EQ(abc, arena.find("abc", 3));
+    EXPECT_EQ(10004, arena.numInterned());
+    EXPECT_LT(arena.numBlocks(), 10); // Many strings share each block
+}
+
+TEST(ScStrArenaTest, InternInPlace)
+{
+    ScStrArena arena;
+    const char section[] = { 'H', 'e', 'l', 'l', 'o', '\0', 'a', 'b', 'c' }; // The last string isn't terminated
+    const char* copied = arena.copy(section, sizeof(section));
+    EXPECT_EQ(0, std::memcmp(section, copied, sizeof(section)));
+    EXPECT_EQ('\0', copied[sizeof(section)]);
+
+    u32 hello = arena.internInPlace(&copied[0], 5);
+    u32 llo = arena.internInPlace(&copied[2], 3); // "llo" is used within "Hello"
+    u32 abc = arena.internInPlace(&copied[6], 3);
+    EXPECT_EQ(&copied[0], arena.str(hello));
+    EXPECT_EQ(&copied[2], arena.str(llo));
+    EXPECT_EQ(&copied[6], arena.str(abc));
+    EXPECT_EQ(llo, arena.intern("llo", 3));
+    EXPECT_EQ(hello, arena.internInPlace(&copied[0], 5));
+    EXPECT_EQ(abc, arena.find("abc", 3));
+
+    std::vector<char> large(0x10000, 'x');
+    size_t bytesAllocated = arena.bytesAllocated();
+    arena.copy(&large[0], large.size()); // Large blocks are allocated on their own
+    EXPECT_EQ(bytesAllocated + large.size() + 1, arena.bytesAllocated());
+}
+
+TEST(ScStrArenaTest, SubStrings)
+{
+    ScStrArena arena;
+    const char* characters = arena.copy("Hello World", 11);
+    u32 helloWorld = arena.internInPlace(characters, 11);
+    u32 world = arena.internInPlace(&characters[6], 5);
+    u32 hello = arena.intern("Hello", 5);
+    EXPECT_EQ(world, arena.intern("World", 5)); // Interned strings with the same contents share an id
+
+    size_t offset = 0;
+    EXPECT_TRUE(arena.isSubStringOf(world, helloWorld, offset));
+    EXPECT_EQ(6, offset);
+    EXPECT_TRUE(arena.isSubStringOf(helloWorld, helloWorld, offset));
+    EXPECT_EQ(0, offset);
+    EXPECT_FALSE(arena.isSubStringOf(helloWorld, world, offset));
+    EXPECT_FALSE(arena.isSubStringOf(hello, helloWorld, offset)); // A prefix doesn't share the terminator
+    EXPECT_FALSE(arena.isSubStringOf(ScStrArena::NoStr, helloWorld, offset));
+}
+
+TEST(ScStrArenaTest, ScStr)
+{
+    ScStr standalone(std::string("Hello\0World", 11));
+    EXPECT_STREQ("Hello", standalone.str);
+    EXPECT_EQ(5, standalone.length());
+    EXPECT_FALSE(standalone.empty());
+    EXPECT_TRUE(ScStr("").empty());
+}
+
+TEST(ScStrArenaTest, LoadedStrings)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    std::string characters = std::string("\0Hello World\0Hello World\0tail", 29);
+    u16 charactersStart = u16(sizeof(u16) + 5*sizeof(u16));
+    std::vector<u16> offsets = {
+        u16(charactersStart+1), // "Hello World"
+        u16(charactersStart+7), // "World", within string 1
+        u16(charactersStart+13), // A second "Hello World"
+        u16(charactersStart+25), // "tail", ends where the section ends
+        u16(charactersStart) // ""
+    };
+    ASSERT_TRUE(loadScStrArenaTestSection(scenario, SectionName::STR, scStrArenaTestStrBytes(offsets, characters)));
+
+    const std::vector<std::string> expected = { "Hello World", "World", "Hello World", "tail", "" };
+    for ( size_t i=0; i<expected.size(); i++ )
+    {
+        std::shared_ptr<RawString> str = scenario.strings.getString<RawString>(i+1, Chk::Scope::Game);
+        ASSERT_NE(nullptr, str);
+        EXPECT_EQ(expected[i], *str);
+    }
+    EXPECT_EQ(1, scenario.strings.findString<RawString>("Hello World"));
+    EXPECT_EQ(2, scenario.strings.findString<RawString>("World"));
+    EXPECT_EQ(4, scenario.strings.findString<RawString>("tail"));
+    EXPECT_EQ(Chk::StringId::NoString, scenario.strings.findString<RawString>("Hello"));
+    EXPECT_EQ(2, scenario.strings.addString<RawString>("World")); // Found rather than added
+
+    size_t added = scenario.strings.addString<RawString>("Hello");
+    EXPECT_EQ(added, scenario.strings.findString<RawString>("Hello"));
+    scenario.strings.replaceString<RawString>(4, "World");
+    EXPECT_EQ("World", *scenario.strings.getString<RawString>(4, Chk::Scope::Game));
+    EXPECT_EQ(2, scenario.strings.findString<RawString>("World")); // Found at the first of the identical strings
+
+    std::vector<u8> chkFile = scenario.serialize();
+    Scenario reloaded;
+    std::stringstream chk(std::string(chkFile.begin() + sizeof(Chk::CHK) + sizeof(Chk::Size), chkFile.end()), std::ios_base::in|std::ios_base::binary);
+    ASSERT_TRUE(reloaded.read(chk));
+    EXPECT_EQ("Hello World", *reloaded.strings.getString<RawString>(3, Chk::Scope::Game));
+    EXPECT_EQ("World", *reloaded.strings.getString<RawString>(4, Chk::Scope::Game));
+    EXPECT_EQ(added, reloaded.strings.findString<RawString>("Hello"));
+}
+
+TEST(ScStrArenaTest, ReplacedStringsAreReleased)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    size_t stringId = scenario.strings.addString<RawString>("first");
+    std::string padding(200, 'x');
+    for ( size_t i=0; i<5000; i++ ) // A megabyte of characters, each replacing the last
+        scenario.strings.replaceString<RawString>(stringId, padding + std::to_string(i), Chk::Scope::Game);
+
+    EXPECT_LT(scenario.strings.str->getCharactersAllocated(), 4*ScStrArena::BlockSize);
+    EXPECT_EQ(padding + "4999", *scenario.strings.getString<RawString>(stringId, Chk::Scope::Game));
+    EXPECT_EQ("Untitled Scenario", *scenario.strings.getString<RawString>(1, Chk::Scope::Game));
+    EXPECT_EQ(stringId, scenario.strings.findString<RawString>(padding + "4999"));
+    EXPECT_EQ(1, scenario.strings.findString<RawString>("Untitled Scenario"));
+}
+
+TEST(ScStrArenaTest, DeletedStringsAreReleased)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    std::vector<RawString> strs;
+    for ( size_t i=0; i<2000; i++ )
+        strs.push_back(std::string(200, 'x') + std::to_string(i));
+
+    scenario.strings.addStrings<RawString>(strs, Chk::Scope::Editor);
+    size_t charactersAllocated = scenario.strings.kstr->getCharactersAllocated();
+    EXPECT_LT(2000*200, charactersAllocated);
+
+    scenario.strings.deleteUnusedStrings(Chk::Scope::Editor); // None of the strings were put to use
+    EXPECT_LT(scenario.strings.kstr->getCharactersAllocated(), charactersAllocated/8);
+    EXPECT_EQ(Chk::StringId::NoString, scenario.strings.findString<RawString>(strs[0], Chk::Scope::Editor));
+}
+
+void expectScStrArenaTestPacked(const Scenario & scenario, size_t numStored, Chk::Scope storageScope)
+{
+    EXPECT_FALSE(scenario.strings.stringStored(0, storageScope)); // stringId:0 is never used
+    size_t stringId = 1;
+    while ( scenario.strings.stringStored(stringId, storageScope) )
+        stringId++;
+
+    EXPECT_EQ(numStored, stringId-1);
+    for ( size_t capacity = scenario.strings.getCapacity(storageScope); stringId<capacity; stringId++ )
+        EXPECT_FALSE(scenario.strings.stringStored(stringId, storageScope)) << stringId;
+}
+
+TEST(ScStrArenaTest, DefragmentMovesEachStringOnce)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    size_t first = scenario.strings.addString<RawString>("first");
+    size_t second = scenario.strings.addString<RawString>("second");
+    size_t third = scenario.strings.addString<RawString>("third");
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->actions[0].actionType = Chk::Action::Type::DisplayTextMessage;
+    trigger->actions[0].stringId = u32(second);
+    trigger->actions[1].actionType = Chk::Action::Type::DisplayTextMessage;
+    trigger->actions[1].stringId = u32(third);
+    scenario.triggers.addTrigger(trigger);
+    expectScStrArenaTestPacked(scenario, third, Chk::Scope::Game);
+
+    scenario.strings.deleteString(first, Chk::Scope::Game);
+    EXPECT_FALSE(scenario.strings.stringStored(first, Chk::Scope::Game));
+    EXPECT_TRUE(scenario.strings.str->defragment(scenario.strings, false));
+    expectScStrArenaTestPacked(scenario, third-1, Chk::Scope::Game); // Moved strings leave their old slots empty
+    const Chk::Trigger* defragmented = scenario.triggers.readTrigger(0);
+    EXPECT_EQ(first, defragmented->actions[0].stringId);
+    EXPECT_EQ(second, defragmented->actions[1].stringId);
+    EXPECT_EQ("second", *scenario.strings.getString<RawString>(first, Chk::Scope::Game));
+    EXPECT_EQ("third", *scenario.strings.getString<RawString>(second, Chk::Scope::Game));
+    EXPECT_EQ(second, scenario.strings.findString<RawString>("third"));
+    EXPECT_EQ(1, scenario.strings.getScenarioNameStringId()); // Not moved into stringId:0
+    EXPECT_FALSE(scenario.strings.str->defragment(scenario.strings, false));
+
+    std::vector<size_t> editorStringIds = scenario.strings.addStrings<RawString>({ "one", "two", "three", "four" }, Chk::Scope::Editor);
+    ASSERT_EQ(4, editorStringIds.size());
+    scenario.strings.deleteStrings({ editorStringIds[0], editorStringIds[2] }, Chk::Scope::Editor);
+    EXPECT_TRUE(scenario.strings.kstr->defragment(scenario.strings, false));
+    expectScStrArenaTestPacked(scenario, editorStringIds[3]-2, Chk::Scope::Editor);
+    EXPECT_EQ(editorStringIds[0], scenario.strings.findString<RawString>("two", Chk::Scope::Editor));
+    EXPECT_EQ(editorStringIds[1], scenario.strings.findString<RawString>("four", Chk::Scope::Editor));
+}
+
+TEST(ScStrArenaTest, FailedBatchInternsNothing)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    std::vector<RawString> strs;
+    for ( size_t i=0; i<Chk::MaxStrings; i++ ) // One more than there are stringIds for
+        strs.push_back("String " + std::to_string(i));
+
+    size_t capacity = scenario.strings.getCapacity(Chk::Scope::Game);
+    size_t charactersAllocated = scenario.strings.str->getCharactersAllocated();
+    EXPECT_THROW(scenario.strings.addStrings<RawString>(strs), MaximumStringsExceeded);
+    EXPECT_EQ(capacity, scenario.strings.getCapacity(Chk::Scope::Game));
+    EXPECT_EQ(charactersAllocated, scenario.strings.str->getCharactersAllocated());
+    EXPECT_EQ(Chk::StringId::NoString, scenario.strings.findString<RawString>("String 0"));
+}
+
+size_t scStrArenaTestFindByScan(Scenario & scenario, const std::string & str, Chk::Scope storageScope)
+{
+    size_t capacity = scenario.strings.getCapacity(storageScope);
+    for ( size_t stringId=1; stringId<capacity; stringId++ )
+    {
+        RawStringPtr stored = scenario.strings.getString<RawString>(stringId, storageScope);
+        if ( stored != nullptr && *stored == str )
+            return stringId;
+    }
+    return Chk::StringId::NoString;
+}
+
+TEST(ScStrArenaTest, FindStringSameAsScan)
+{
+    for ( Chk::Scope storageScope : { Chk::Scope::Game, Chk::Scope::Editor } )
+    {
+        Scenario scenario(Sc::Terrain::Tileset::Badlands);
+        std::mt19937 random(38);
+        auto randomStr = [&]() { return "String " + std::to_string(random() % 40); }; // Few enough contents that there are duplicates
+        for ( size_t i=0; i<600; i++ )
+        {
+            size_t capacity = scenario.strings.getCapacity(storageScope);
+            size_t stringId = capacity > 1 ? 1 + random() % (capacity-1) : 1;
+            switch ( random() % 6 )
+            {
+                case 0: case 1: scenario.strings.addString<RawString>(randomStr(), storageScope); break;
+                case 2: scenario.strings.replaceString<RawString>(stringId, randomStr(), storageScope); break;
+                case 3: scenario.strings.deleteString(stringId, storageScope == Chk::Scope::Game ? Chk::Scope::Game : Chk::Scope::Editor, false); break;
+                case 4: scenario.strings.moveString(stringId, capacity > 1 ? 1 + random() % (capacity-1) : 1, storageScope); break;
+                case 5: scenario.strings.addStrings<RawString>({randomStr(), randomStr()}, storageScope); break;
+            }
+            if ( i % 150 == 149 )
+                scenario.strings.deleteUnusedStrings(storageScope);
+
+            for ( size_t content=0; content<40; content++ )
+            {
+                std::string str = "String " + std::to_string(content);
+                ASSERT_EQ(scStrArenaTestFindByScan(scenario, str, storageScope), scenario.strings.findString<RawString>(str, storageScope)) << i << ", " << str;
+            }
+        }
+    }
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <random>
+#include <vector>
+
+void expectScenarioValidatorTestIssue(const ScenarioValidator::Issue & issue, ScenarioValidator::Issue::Type type, SectionName sectionName,
+    size_t index, size_t value, ScenarioValidator::Issue::Within within = ScenarioValidator::Issue::Within::Entry, size_t subIndex = 0)
+{
+    EXPECT_EQ(type, issue.type) << issue.toString();
+    EXPECT_EQ(sectionName, issue.sectionName) << issue.toString();
+    EXPECT_EQ(index, issue.index) << issue.toString();
+    EXPECT_EQ(value, issue.value) << issue.toString();
+    EXPECT_EQ(within, issue.within) << issue.toString();
+    EXPECT_EQ(subIndex, issue.subIndex) << issue.toString();
+}
+
+void scenarioValidatorTestAddTriggers(Scenario & scenario, size_t numTriggers, std::mt19937 & random)
+{
+    for ( size_t i=0; i<numTriggers; i++ )
+    {
+        Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+        for ( size_t j=0; j<4; j++ )
+        {
+            Chk::Action & action = trigger->actions[random() % Chk::Trigger::MaxActions];
+            action.actionType = Chk::Action::Type(random() % (Chk::Action::NumActionTypes+2)); // Some beyond the last action type
+            action.locationId = u32(random() % 80);
+            action.stringId = u32(random() % 16);
+            action.soundStringId = u32(random() % 16);
+            action.type = u16(random() % (Sc::Unit::TotalReferenceTypes+16));
+            action.number = u32(random() % 80);
+        }
+        scenario.triggers.addTrigger(trigger);
+    }
+}
+
+TEST(ScenarioValidatorTest, NewScenarioHasNoIssues)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    for ( size_t numWorkers : { size_t(1), WorkerPool::defaultNumWorkers() } )
+    {
+        std::vector<ScenarioValidator::Issue> issues = ScenarioValidator(numWorkers).validate(scenario);
+        for ( const auto & issue : issues )
+            ADD_FAILURE() << issue.toString();
+    }
+}
+
+TEST(ScenarioValidatorTest, FindsIssues)
+{
+    using Issue = ScenarioValidator::Issue;
+    Scenario scenario(Sc::Terrain::Tileset::Badlands, 64, 64);
+    scenario.layers.setTile(3, 1, 7, Chk::Scope::Editor); // TILE differs from MTXM
+
+    Chk::UnitPtr unit = Chk::UnitPtr(new Chk::Unit());
+    unit->type = Sc::Unit::Type::TerranMarine;
+    unit->xc = 64*32;
+    unit->yc = 10;
+    scenario.layers.addUnit(unit);
+    Chk::UnitPtr badUnit = Chk::UnitPtr(new Chk::Unit());
+    badUnit->type = Sc::Unit::Type::AnyUnit;
+    scenario.layers.addUnit(badUnit);
+
+    Chk::SpritePtr sprite = Chk::SpritePtr(new Chk::Sprite());
+    sprite->type = Sc::Sprite::Type(Sc::Sprite::TotalSprites);
+    sprite->yc = 64*32;
+    scenario.layers.addSprite(sprite);
+
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->conditions[1].conditionType = Chk::Condition::Type::Bring;
+    trigger->conditions[1].locationId = Chk::LocationId::Anywhere;
+    trigger->conditions[1].unitType = Sc::Unit::Type(Sc::Unit::TotalReferenceTypes);
+    trigger->actions[2].actionType = Chk::Action::Type::Transmission;
+    trigger->actions[2].locationId = 10; // Blank
+    trigger->actions[2].stringId = 900;
+    trigger->actions[2].soundStringId = 901;
+    trigger->actions[3].actionType = Chk::Action::Type::CreateUnitWithProperties;
+    trigger->actions[3].locationId = Chk::LocationId::Anywhere;
+    trigger->actions[3].type = Sc::Unit::Type::TerranMarine;
+    trigger->actions[3].number = 5; // Unused CUWP
+    scenario.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger()));
+    scenario.triggers.addTrigger(trigger);
+    scenario.triggers.setSoundStringId(4, 902);
+
+    std::vector<Issue> issues = ScenarioValidator().validate(scenario);
+    ASSERT_EQ(11, issues.size());
+    expectScenarioValidatorTestIssue(issues[0], Issue::Type::TileMismatch, SectionName::TILE, 1*64+3, 7);
+    expectScenarioValidatorTestIssue(issues[1], Issue::Type::MissingString, SectionName::WAV, 4, 902);
+    expectScenarioValidatorTestIssue(issues[2], Issue::Type::UnitOutOfBounds, SectionName::UNIT, 0, 0);
+    expectScenarioValidatorTestIssue(issues[3], Issue::Type::BadUnitType, SectionName::UNIT, 1, Sc::Unit::Type::AnyUnit);
+    expectScenarioValidatorTestIssue(issues[4], Issue::Type::BadSpriteType, SectionName::THG2, 0, Sc::Sprite::TotalSprites);
+    expectScenarioValidatorTestIssue(issues[5], Issue::Type::SpriteOutOfBounds, SectionName::THG2, 0, 0);
+    expectScenarioValidatorTestIssue(issues[6], Issue::Type::BadUnitType, SectionName::TRIG, 1, Sc::Unit::TotalReferenceTypes, Issue::Within::Condition, 1);
+    expectScenarioValidatorTestIssue(issues[7], Issue::Type::MissingLocation, SectionName::TRIG, 1, 10, Issue::Within::Action, 2);
+    expectScenarioValidatorTestIssue(issues[8], Issue::Type::MissingString, SectionName::TRIG, 1, 900, Issue::Within::Action, 2);
+    expectScenarioValidatorTestIssue(issues[9], Issue::Type::MissingSound, SectionName::TRIG, 1, 901, Issue::Within::Action, 2);
+    expectScenarioValidatorTestIssue(issues[10], Issue::Type::BadCuwp, SectionName::TRIG, 1, 5, Issue::Within::Action, 3);
+    EXPECT_EQ("TRIG: trigger 1 action 2 uses location 10 which doesn't exist", issues[7].toString());
+
+    scenario.triggers.setCuwpUsed(5, true);
+    scenario.triggers.setSoundStringId(4, 0);
+    issues = ScenarioValidator().validate(scenario);
+    EXPECT_EQ(9, issues.size());
+}
+
+TEST(ScenarioValidatorTest, FindsIsomMismatches)
+{
+    using Issue = ScenarioValidator::Issue;
+    Scenario scenario(Sc::Terrain::Tileset::Badlands, 96, 160);
+    std::vector<u16> placedTileGroups(96*160); // Stands in for tiles derived from ISOM, which needs the tileset's isometric tables
+    for ( size_t y=0; y<160; y++ )
+    {
+        for ( size_t x=0; x<96; x++ )
+            placedTileGroups[y*96+x] = scenario.layers.getTile(x, y, Chk::Scope::Game)/16;
+    }
+    scenario.layers.setTile(3, 5, u16(2*16+1));
+    scenario.layers.setTile(95, 130, u16(40*16)); // In a later task's rows
+    scenario.layers.setTile(7, 0, u16(3*16)); // Where ISOM determines no tile group
+
+    for ( size_t numWorkers : { size_t(1), size_t(3) } )
+    {
+        ScenarioValidator validator(numWorkers);
+        EXPECT_TRUE(validator.validate(scenario).empty()); // Not compared without a source for ISOM tile groups
+        validator.setIsomTileGroups([&](const Scenario &, size_t tileX, size_t tileY, u16 & tileGroup) {
+            tileGroup = placedTileGroups[tileY*96+tileX];
+            return tileY > 0;
+        });
+
+        std::vector<Issue> issues = validator.validate(scenario);
+        ASSERT_EQ(2, issues.size());
+        expectScenarioValidatorTestIssue(issues[0], Issue::Type::IsomMismatch, SectionName::MTXM, 3, placedTileGroups[5*96+3], Issue::Within::Tile, 5);
+        expectScenarioValidatorTestIssue(issues[1], Issue::Type::IsomMismatch, SectionName::MTXM, 95, placedTileGroups[130*96+95], Issue::Within::Tile, 130);
+        EXPECT_EQ("MTXM: tile (3, 5) differs from tile group " + std::to_string(placedTileGroups[5*96+3]) + " which ISOM places there", issues[0].toString());
+    }
+}
+
+TEST(ScenarioValidatorTest, FindsStringSectionsTooLarge)
+{
+    using Issue = ScenarioValidator::Issue;
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    scenario.strings.setCapacity(300);
+    for ( size_t stringId=10; stringId<260; stringId++ )
+        scenario.strings.replaceString<RawString>(stringId, std::string(250, 'a') + std::to_string(stringId));
+    EXPECT_TRUE(ScenarioValidator().validate(scenario).empty()); // 250 strings of about 253 characters fit
+
+    scenario.strings.replaceString<RawString>(260, std::string(2000, 'b'));
+    size_t numStrings = scenario.strings.getCapacity()-1;
+    size_t sectionSize = sizeof(u16) + sizeof(u16)*numStrings + 1; // Count, offsets and the NUL blank strings point to
+    for ( size_t stringId=1; stringId<=numStrings; stringId++ )
+    {
+        RawStringPtr str = scenario.strings.getString<RawString>(stringId, Chk::Scope::Game);
+        sectionSize += str != nullptr ? str->size()+1 : 0;
+    }
+    std::vector<Issue> issues = ScenarioValidator().validate(scenario);
+    ASSERT_EQ(1, issues.size());
+    expectScenarioValidatorTestIssue(issues[0], Issue::Type::StringSectionTooLarge, SectionName::STR, 65535, sectionSize);
+    EXPECT_EQ("STR: would be written as " + std::to_string(sectionSize) + " bytes, over the 65535 its offsets can address", issues[0].toString());
+}
+
+TEST(ScenarioValidatorTest, SameForAnyNumberOfWorkers)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    std::mt19937 random(50);
+    scenarioValidatorTestAddTriggers(scenario, 5000, random);
+
+    std::vector<ScenarioValidator::Issue> expected = ScenarioValidator(1).validate(scenario);
+    EXPECT_LT(1000, expected.size());
+    for ( size_t numWorkers : { size_t(2), size_t(3), size_t(4), WorkerPool::defaultNumWorkers() } )
+    {
+        std::vector<ScenarioValidator::Issue> issues = ScenarioValidator(numWorkers).validate(scenario);
+        ASSERT_EQ(expected.size(), issues.size()) << numWorkers;
+        for ( size_t i=0; i<expected.size(); i++ )
+            EXPECT_EQ(expected[i].toString(), issues[i].toString()) << numWorkers;
+    }
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <random>
+#include <string>
+#include <vector>
+
+void stringBatchTestUse(Scenario & scenario, size_t userIndex, size_t stringId) // Puts the string to use in a trigger action, adding triggers as needed
+{
+    while ( scenario.triggers.numTriggers() <= userIndex/Chk::Trigger::MaxActions )
+        scenario.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger()));
+
+    Chk::Action action = scenario.triggers.getTrigger(userIndex/Chk::Trigger::MaxActions)->actions[userIndex%Chk::Trigger::MaxActions];
+    action.actionType = Chk::Action::Type::DisplayTextMessage;
+    action.stringId = u32(stringId);
+    scenario.triggers.setAction(userIndex/Chk::Trigger::MaxActions, userIndex%Chk::Trigger::MaxActions, action);
+}
+
+void stringBatchTestSetup(Scenario & scenario)
+{
+    scenario.strings.setCapacity(30);
+    for ( size_t stringId=3; stringId<30; stringId++ )
+        scenario.strings.replaceString<RawString>(stringId, "Existing " + std::to_string(stringId % 10));
+
+    size_t userIndex = 0;
+    for ( size_t stringId : { 3, 5, 7, 15, 25 } ) // The rest are stored but unused
+        stringBatchTestUse(scenario, userIndex++, stringId);
+}
+
+std::vector<size_t> stringBatchTestAddSequentially(Scenario & scenario, const std::vector<RawString> & strs, size_t firstUserIndex, Chk::Scope storageScope = Chk::Scope::Game)
+{
+    std::vector<size_t> stringIds;
+    for ( size_t i=0; i<strs.size(); i++ )
+    {
+        stringIds.push_back(scenario.strings.addString<RawString>(strs[i], storageScope));
+        if ( storageScope == Chk::Scope::Game )
+            stringBatchTestUse(scenario, firstUserIndex+i, stringIds.back());
+        else
+            scenario.strings.setSwitchNameStringId(i, stringIds.back(), Chk::Scope::Editor);
+    }
+    return stringIds;
+}
+
+std::vector<size_t> stringBatchTestAddBatch(Scenario & scenario, const std::vector<RawString> & strs, size_t firstUserIndex, Chk::Scope storageScope = Chk::Scope::Game)
+{
+    std::vector<size_t> stringIds = scenario.strings.addStrings<RawString>(strs, storageScope);
+    for ( size_t i=0; i<stringIds.size(); i++ )
+    {
+        if ( storageScope == Chk::Scope::Game )
+            stringBatchTestUse(scenario, firstUserIndex+i, stringIds[i]);
+        else
+            scenario.strings.setSwitchNameStringId(i, stringIds[i], Chk::Scope::Editor);
+    }
+    return stringIds;
+}
+
+void expectStringBatchTestSameStrings(const Scenario & expected, const Scenario & actual, Chk::Scope storageScope = Chk::Scope::Game)
+{
+    ASSERT_EQ(expected.strings.getCapacity(storageScope), actual.strings.getCapacity(storageScope));
+    for ( size_t stringId=0; stringId<expected.strings.getCapacity(storageScope); stringId++ )
+    {
+        RawStringPtr expectedString = expected.strings.getString<RawString>(stringId, storageScope);
+        RawStringPtr actualString = actual.strings.getString<RawString>(stringId, storageScope);
+        ASSERT_EQ(expectedString == nullptr, actualString == nullptr) << stringId;
+        if ( expectedString != nullptr )
+            EXPECT_EQ(*expectedString, *actualString) << stringId;
+    }
+}
+
+TEST(StringBatchTest, AddsSameAsSequential)
+{
+    Scenario sequential(Sc::Terrain::Tileset::Badlands), batched(Sc::Terrain::Tileset::Badlands);
+    stringBatchTestSetup(sequential);
+    stringBatchTestSetup(batched);
+    std::vector<RawString> strs = { "New 0", "Existing 5", "Existing 4", "New 0", "Existing 3" };
+    for ( size_t i=1; i<40; i++ ) // Enough to replace the unused strings and grow the capacity
+        strs.push_back("New " + std::to_string(i));
+    strs.push_back("Existing 6"); // Replaced at 6, still stored at 16 and 26
+    strs.push_back("Existing 4");
+
+    std::vector<size_t> expectedIds = stringBatchTestAddSequentially(sequential, strs, 5);
+    std::vector<size_t> stringIds = stringBatchTestAddBatch(batched, strs, 5);
+    EXPECT_EQ(expectedIds, stringIds);
+    EXPECT_EQ(5, stringIds[1]); // Found where it was used
+    EXPECT_EQ(stringIds[0], stringIds[3]); // Found where it was added
+    EXPECT_EQ(3, stringIds[4]); // Found at the lowest of the identical strings
+    expectStringBatchTestSameStrings(sequential, batched);
+
+    EXPECT_TRUE(batched.strings.addStrings<RawString>(std::vector<RawString>()).empty());
+}
+
+TEST(StringBatchTest, RandomAddsSameAsSequential)
+{
+    std::mt19937 random(47);
+    for ( size_t round=0; round<20; round++ )
+    {
+        Scenario sequential(Sc::Terrain::Tileset::Badlands), batched(Sc::Terrain::Tileset::Badlands);
+        stringBatchTestSetup(sequential);
+        stringBatchTestSetup(batched);
+        for ( size_t i=0; i<3; i++ )
+        {
+            std::vector<RawString> strs;
+            size_t numStrings = random() % 60;
+            for ( size_t j=0; j<numStrings; j++ )
+                strs.push_back((random() % 2 == 0 ? "Existing " : "New ") + std::to_string(random() % 20));
+
+            size_t firstUserIndex = 5 + i*60;
+            ASSERT_EQ(stringBatchTestAddSequentially(sequential, strs, firstUserIndex), stringBatchTestAddBatch(batched, strs, firstUserIndex)) << round;
+        }
+        expectStringBatchTestSameStrings(sequential, batched);
+    }
+}
+
+TEST(StringBatchTest, EditorStrings)
+{
+    Scenario sequential(Sc::Terrain::Tileset::Badlands), batched(Sc::Terrain::Tileset::Badlands);
+    std::vector<RawString> strs;
+    for ( size_t i=0; i<100; i++ )
+        strs.push_back("Switch " + std::to_string(i % 70));
+
+    EXPECT_EQ(stringBatchTestAddSequentially(sequential, strs, 0, Chk::Scope::Editor), stringBatchTestAddBatch(batched, strs, 0, Chk::Scope::Editor));
+    expectStringBatchTestSameStrings(sequential, batched, Chk::Scope::Editor);
+    EXPECT_EQ(batched.strings.getSwitchNameStringId(5, Chk::Scope::Editor), batched.strings.getSwitchNameStringId(75, Chk::Scope::Editor));
+}
+
+TEST(StringBatchTest, DeletesSameAsSequential)
+{
+    Scenario sequential(Sc::Terrain::Tileset::Badlands), batched(Sc::Terrain::Tileset::Badlands);
+    stringBatchTestSetup(sequential);
+    stringBatchTestSetup(batched);
+    std::vector<size_t> stringIds = { 3, 4, 5, 6, 6, 20, 25, 29, 31, 70000 };
+
+    for ( size_t stringId : stringIds )
+        sequential.strings.deleteString(stringId);
+    batched.strings.deleteStrings(stringIds);
+    expectStringBatchTestSameStrings(sequential, batched);
+    EXPECT_NE(nullptr, batched.strings.getString<RawString>(5, Chk::Scope::Game)); // Used strings are kept
+    EXPECT_EQ(nullptr, batched.strings.getString<RawString>(20, Chk::Scope::Game));
+
+    stringIds = { 5, 7, 15 };
+    for ( size_t stringId : stringIds )
+        sequential.strings.deleteString(stringId, Chk::Scope::Both, false);
+    batched.strings.deleteStrings(stringIds, Chk::Scope::Both, false);
+    expectStringBatchTestSameStrings(sequential, batched);
+    EXPECT_EQ(nullptr, batched.strings.getString<RawString>(5, Chk::Scope::Game));
+    EXPECT_EQ(0, batched.triggers.getTrigger(0)->actions[1].stringId); // References to deleted strings are cleared
+    EXPECT_EQ(sequential.triggers.getTrigger(0)->actions[4].stringId, batched.triggers.getTrigger(0)->actions[4].stringId);
+}
+
+TEST(StringBatchTest, ReplacesSameAsSequential)
+{
+    Scenario sequential(Sc::Terrain::Tileset::Badlands), batched(Sc::Terrain::Tileset::Badlands);
+    stringBatchTestSetup(sequential);
+    stringBatchTestSetup(batched);
+    std::vector<std::pair<size_t, RawString>> replacements = { { 3, "Replaced 3" }, { 6, "Existing 5" }, { 4, "Replaced 4" }, { 4, "Replaced again" }, { 31, "Past capacity" } };
+    for ( size_t i=0; i<1500; i++ ) // Enough replaced characters that the strings are moved to a new arena
+        replacements.push_back({ 10 + i % 15, std::string(200, char('a' + i % 26)) + std::to_string(i) });
+    replacements.push_back({ 12, "Existing 7" });
+
+    for ( const auto & replacement : replacements )
+        sequential.strings.replaceString<RawString>(replacement.first, replacement.second);
+    u64 modificationEpoch = batched.strings.getModificationEpoch();
+    batched.strings.replaceStrings<RawString>(replacements);
+    EXPECT_NE(modificationEpoch, batched.strings.getModificationEpoch());
+    expectStringBatchTestSameStrings(sequential, batched);
+    EXPECT_EQ("Replaced again", *batched.strings.getString<RawString>(4, Chk::Scope::Game));
+    EXPECT_LE(batched.strings.str->getCharactersAllocated(), ScStrArena::BlockSize); // Replaced characters were released
+
+    for ( const RawString & str : { RawString("Existing 5"), RawString("Existing 7"), RawString("Replaced 3"), RawString("Existing 4"), RawString("Replaced 4") } )
+        EXPECT_EQ(sequential.strings.findString<RawString>(str), batched.strings.findString<RawString>(str)) << str;
+
+    std::vector<std::pair<size_t, RawString>> editorReplacements = { { 1, "Switch 1" }, { 2, "Switch 2" }, { 1, "Switch 0" } };
+    sequential.strings.addStrings<RawString>({ "Editor 1", "Editor 2" }, Chk::Scope::Editor);
+    batched.strings.addStrings<RawString>({ "Editor 1", "Editor 2" }, Chk::Scope::Editor);
+    for ( const auto & replacement : editorReplacements )
+        sequential.strings.replaceString<RawString>(replacement.first, replacement.second, Chk::Scope::Editor);
+    batched.strings.replaceStrings<RawString>(editorReplacements, Chk::Scope::Editor);
+    expectStringBatchTestSameStrings(sequential, batched, Chk::Scope::Editor);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "../MappingCoreLib/MappingCore.h"
 #include "TestAssets.h"
+#include <chrono>
+#include <iostream>
 #include <regex>
 
 TEST(TextTrigCompilerTest, Basic)
@@ -8,6 +10,516 @@ TEST(TextTrigCompilerTest, Basic)
     TextTrigCompiler ttc(true, 0x0058A364);
 }
 
+class NameLookupTextTrigCompiler : public TextTrigCompiler
+{
+    public:
+        NameLookupTextTrigCompiler() : TextTrigCompiler(true, 0x0058A364) {}
+        using TextTrigCompiler::parseConditionName;
+        using TextTrigCompiler::parseActionName;
+};
+
+const std::vector<std::pair<std::string, Chk::Condition::VirtualType>> conditionNames = {
+    { "Accumulate", Chk::Condition::VirtualType::Accumulate }, { "Always", Chk::Condition::VirtualType::Always },
+    { "Bring", Chk::Condition::VirtualType::Bring }, { "Command", Chk::Condition::VirtualType::Command },
+    { "Command the Least", Chk::Condition::VirtualType::CommandTheLeast }, { "Command the Least At", Chk::Condition::VirtualType::CommandTheLeastAt },
+    { "Command the Most", Chk::Condition::VirtualType::CommandTheMost }, { "Command the Most At", Chk::Condition::VirtualType::CommandTheMostAt },
+    { "Commands the Most At", Chk::Condition::VirtualType::CommandTheMostAt }, { "Countdown Timer", Chk::Condition::VirtualType::CountdownTimer },
+    { "Custom", Chk::Condition::VirtualType::Custom }, { "Deaths", Chk::Condition::VirtualType::Deaths },
+    { "Elapsed Time", Chk::Condition::VirtualType::ElapsedTime }, { "Highest Score", Chk::Condition::VirtualType::HighestScore },
+    { "Kill", Chk::Condition::VirtualType::Kill }, { "Least Kills", Chk::Condition::VirtualType::LeastKills },
+    { "Least Resources", Chk::Condition::VirtualType::LeastResources }, { "Lowest Score", Chk::Condition::VirtualType::LowestScore },
+    { "Memory", Chk::Condition::VirtualType::Memory }, { "Most Kills", Chk::Condition::VirtualType::MostKills },
+    { "Most Resources", Chk::Condition::VirtualType::MostResources }, { "Never", Chk::Condition::VirtualType::Never },
+    { "Opponents", Chk::Condition::VirtualType::Opponents }, { "Score", Chk::Condition::VirtualType::Score },
+    { "Switch", Chk::Condition::VirtualType::Switch }
+};
+
+const std::vector<std::pair<std::string, Chk::Action::VirtualType>> actionNames = {
+    { "Center View", Chk::Action::VirtualType::CenterView }, { "Comment", Chk::Action::VirtualType::Comment },
+    { "Create Unit", Chk::Action::VirtualType::CreateUnit }, { "Create Unit with Properties", Chk::Action::VirtualType::CreateUnitWithProperties },
+    { "Custom", Chk::Action::VirtualType::Custom }, { "Defeat", Chk::Action::VirtualType::Defeat },
+    { "Display Text Message", Chk::Action::VirtualType::DisplayTextMessage }, { "Draw", Chk::Action::VirtualType::Draw },
+    { "Give Units to Player", Chk::Action::VirtualType::GiveUnitsToPlayer }, { "Kill Unit", Chk::Action::VirtualType::KillUnit },
+    { "Kill Unit At Location", Chk::Action::VirtualType::KillUnitAtLocation }, { "Leaderboard Computer Players", Chk::Action::VirtualType::LeaderboardCompPlayers },
+    { "Leader Board Control", Chk::Action::VirtualType::LeaderboardCtrl }, { "Leader Board Control At Location", Chk::Action::VirtualType::LeaderboardCtrlAtLoc },
+    { "Leaderboard Goal Control", Chk::Action::VirtualType::LeaderboardGoalCtrl }, { "Leaderboard Goal Control At Location", Chk::Action::VirtualType::LeaderboardGoalCtrlAtLoc },
+    { "Leaderboard Goal Kills", Chk::Action::VirtualType::LeaderboardGoalKills }, { "Leaderboard Goal Points", Chk::Action::VirtualType::LeaderboardGoalPoints },
+    { "Leaderboard Goal Resources", Chk::Action::VirtualType::LeaderboardGoalResources }, { "Leaderboard Greed", Chk::Action::VirtualType::LeaderboardGreed },
+    { "Leader Board Kills", Chk::Action::VirtualType::LeaderboardKills }, { "Leader Board Points", Chk::Action::VirtualType::LeaderboardPoints },
+    { "Leader Board Resources", Chk::Action::VirtualType::LeaderboardResources }, { "Memory", Chk::Action::VirtualType::SetMemory },
+    { "Minimap Ping", Chk::Action::VirtualType::MinimapPing }, { "Modify Unit Energy", Chk::Action::VirtualType::ModifyUnitEnergy },
+    { "Modify Unit Hanger Count", Chk::Action::VirtualType::ModifyUnitHangerCount }, { "Modify Unit Hit Points", Chk::Action::VirtualType::ModifyUnitHitpoints },
+    { "Modify Unit Resource Amount", Chk::Action::VirtualType::ModifyUnitResourceAmount }, { "Modify Unit Shield Points", Chk::Action::VirtualType::ModifyUnitShieldPoints },
+    { "Move Location", Chk::Action::VirtualType::MoveLocation }, { "Move Unit", Chk::Action::VirtualType::MoveUnit },
+    { "Mute Unit Speech", Chk::Action::VirtualType::MuteUnitSpeech }, { "Order", Chk::Action::VirtualType::Order },
+    { "Pause Game", Chk::Action::VirtualType::PauseGame }, { "Pause Timer", Chk::Action::VirtualType::PauseTimer },
+    { "Play WAV", Chk::Action::VirtualType::PlaySound }, { "Preserve Trigger", Chk::Action::VirtualType::PreserveTrigger },
+    { "Remove Unit", Chk::Action::VirtualType::RemoveUnit }, { "Remove Unit At Location", Chk::Action::VirtualType::RemoveUnitAtLocation },
+    { "Run AI Script", Chk::Action::VirtualType::RunAiScript }, { "Run AI Script At Location", Chk::Action::VirtualType::RunAiScriptAtLocation },
+    { "Set Alliance Status", Chk::Action::VirtualType::SetAllianceStatus }, { "Set Countdown Timer", Chk::Action::VirtualType::SetCountdownTimer },
+    { "Set Deaths", Chk::Action::VirtualType::SetDeaths }, { "Set Doodad State", Chk::Action::VirtualType::SetDoodadState },
+    { "Set Invincibility", Chk::Action::VirtualType::SetInvincibility }, { "Set Memory", Chk::Action::VirtualType::SetMemory },
+    { "Set Mission Objectives", Chk::Action::VirtualType::SetMissionObjectives }, { "Set Next Scenario", Chk::Action::VirtualType::SetNextScenario },
+    { "Set Resources", Chk::Action::VirtualType::SetResources }, { "Set Score", Chk::Action::VirtualType::SetScore },
+    { "Set Switch", Chk::Action::VirtualType::SetSwitch }, { "Talking Portrait", Chk::Action::VirtualType::TalkingPortrait },
+    { "Transmission", Chk::Action::VirtualType::Transmission }, { "Unmute Unit Speech", Chk::Action::VirtualType::UnmuteUnitSpeech },
+    { "Unpause Game", Chk::Action::VirtualType::UnpauseGame }, { "Unpause Timer", Chk::Action::VirtualType::UnpauseTimer },
+    { "Victory", Chk::Action::VirtualType::Victory }, { "Wait", Chk::Action::VirtualType::Wait }
+};
+
+std::string cleanName(const std::string & name) // Capitalized and without spaces, as names appear after the compiler cleans trigger text
+{
+    std::string cleanedName;
+    for ( char character : name )
+    {
+        if ( character != ' ' )
+            cleanedName.push_back(character >= 'a' && character <= 'z' ? character-32 : character);
+    }
+    return cleanedName;
+}
+
+TEST(TextTrigCompilerTest, ParseNames)
+{
+    NameLookupTextTrigCompiler ttc;
+    for ( auto & conditionName : conditionNames )
+    {
+        Chk::Condition::VirtualType conditionType = Chk::Condition::VirtualType::NoCondition;
+        std::string cleanedName = cleanName(conditionName.first);
+        EXPECT_TRUE(ttc.parseConditionName(cleanedName, 0, cleanedName.size(), conditionType)) << conditionName.first;
+        EXPECT_EQ(conditionName.second, conditionType) << conditionName.first;
+    }
+    for ( auto & actionName : actionNames )
+    {
+        Chk::Action::VirtualType actionType = Chk::Action::VirtualType::NoAction;
+        std::string cleanedName = cleanName(actionName.first);
+        EXPECT_TRUE(ttc.parseActionName(cleanedName, 0, cleanedName.size(), actionType)) << actionName.first;
+        EXPECT_EQ(actionName.second, actionType) << actionName.first;
+    }
+
+    Chk::Condition::Type conditionType = Chk::Condition::Type::NoCondition;
+    EXPECT_TRUE(ttc.parseConditionName("Command the Least At", conditionType));
+    EXPECT_EQ(Chk::Condition::Type::CommandTheLeastAt, conditionType);
+    EXPECT_FALSE(ttc.parseConditionName("Command the Leas", conditionType));
+    EXPECT_FALSE(ttc.parseConditionName("Command the Leastx", conditionType));
+    EXPECT_FALSE(ttc.parseConditionName("Commandx", conditionType));
+    EXPECT_TRUE(ttc.parseConditionName("Always Never", conditionType)); // Text following a name is ignored
+    EXPECT_EQ(Chk::Condition::Type::Always, conditionType);
+    EXPECT_TRUE(ttc.parseConditionName("Command the Least At 2", conditionType));
+    EXPECT_EQ(Chk::Condition::Type::CommandTheLeastAt, conditionType);
+
+    Chk::Action::Type actionType = Chk::Action::Type::NoAction;
+    EXPECT_TRUE(ttc.parseActionName("Unmute Unit Speech", actionType));
+    EXPECT_EQ(Chk::Action::Type::UnmuteUnitSpeech, actionType);
+    EXPECT_TRUE(ttc.parseActionName("Set Memory", actionType));
+    EXPECT_EQ(Chk::Action::Type::SetDeaths, actionType);
+    EXPECT_TRUE(ttc.parseActionName("Display Text Messages", actionType));
+    EXPECT_EQ(Chk::Action::Type::DisplayTextMessage, actionType);
+    EXPECT_TRUE(ttc.parseActionName("Kill Unit At Location2", actionType));
+    EXPECT_EQ(Chk::Action::Type::KillUnitAtLocation, actionType);
+    EXPECT_FALSE(ttc.parseActionName("Kill Units", actionType));
+    EXPECT_FALSE(ttc.parseActionName("Leader Board Goal Controls", actionType));
+}
+
+TEST(TextTrigCompilerTest, DISABLED_NameLookupBenchmark) // Run with --gtest_also_run_disabled_tests
+{
+    constexpr size_t numRounds = 20000;
+    NameLookupTextTrigCompiler ttc;
+    std::vector<std::string> cleanedConditionNames, cleanedActionNames;
+    for ( auto & conditionName : conditionNames )
+        cleanedConditionNames.push_back(cleanName(conditionName.first));
+    for ( auto & actionName : actionNames )
+        cleanedActionNames.push_back(cleanName(actionName.first));
+
+    size_t numFound = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for ( size_t round=0; round<numRounds; round++ )
+    {
+        for ( auto & name : cleanedConditionNames )
+        {
+            Chk::Condition::VirtualType conditionType = Chk::Condition::VirtualType::NoCondition;
+            numFound += ttc.parseConditionName(name, 0, name.size(), conditionType) ? 1 : 0;
+        }
+        for ( auto & name : cleanedActionNames )
+        {
+            Chk::Action::VirtualType actionType = Chk::Action::VirtualType::NoAction;
+            numFound += ttc.parseActionName(name, 0, name.size(), actionType) ? 1 : 0;
+        }
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(numRounds*(conditionNames.size() + actionNames.size()), numFound);
+    std::cout << "[ BENCHMARK] " << numFound << " condition/action name lookups in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
+}
+
+TEST(TextTrigCompilerTest, DISABLED_LargeTriggerFileBenchmark) // Run with --gtest_also_run_disabled_tests
+{
+    constexpr size_t numTriggers = 20000;
+    std::string textTrigs;
+    for ( size_t i=0; i<numTriggers; i++ )
+    {
+        textTrigs += "Trigger(\"Player 1\"){\nConditions:"
+            "\n\tBring(\"Player 1\", \"Terran Marine\", \"Anywhere\", At least, 1);"
+            "\n\tDeaths(\"Current Player\", \"Zerg Zergling\", Exactly, 0);"
+            "\n\tSwitch(\"Switch 1\", set);"
+            "\n\tElapsed Time(At least, 5);"
+            "\n\nActions:"
+            "\n\tDisplay Text Message(Always Display, \"Message " + std::to_string(i % 1000) + "\");"
+            "\n\tCreate Unit(\"Player 1\", \"Protoss Zealot\", 1, \"Anywhere\");"
+            "\n\tSet Deaths(\"Current Player\", \"Zerg Zergling\", Add, 1);"
+            "\n\tSet Switch(\"Switch 2\", set);"
+            "\n\tWait(100);"
+            "\n\tPreserve Trigger();"
+            "\n}\n\n//-----------------------------------------------------------------//\n\n";
+    }
+
+    Sc::Data scData;
+    ScenarioPtr scenario = ScenarioPtr(new Scenario(Sc::Terrain::Tileset::Badlands));
+    TextTrigCompiler ttc(true, 0x0058A364);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    EXPECT_TRUE(ttc.compileTriggers(textTrigs, scenario, scData, 0, scenario->triggers.numTriggers()));
+    auto finish = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(numTriggers, scenario->triggers.numTriggers());
+    std::cout << "[ BENCHMARK] Compiled " << numTriggers << " triggers in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(finish-start).count() << "ms" << std::endl;
+}
+
+std::string generateTriggerText(size_t numTriggers)
+{
+    std::string textTrigs;
+    for ( size_t i=0; i<numTriggers; i++ )
+    {
+        textTrigs += "Trigger(\"Player " + std::to_string(i % 8 + 1) + "\"){\nConditions:"
+            "\n\tDeaths(\"Current Player\", \"Zerg Zergling\", Exactly, " + std::to_string(i) + ");"
+            "\n\nActions:"
+            "\n\tDisplay Text Message(Always Display, \"Message " + std::to_string(i % 300) + "\");"
+            "\n\tPlay WAV(\"sound\\\\" + std::to_string(i % 7) + ".wav\", 0);"
+            "\n\tSet Mission Objectives(\"Objective " + std::to_string(i) + "\");"
+            "\n}\n\n//-----------------------------------------------------------------//\n\n";
+    }
+    return textTrigs;
+}
+
+class ParseErrorTextTrigCompiler : public TextTrigCompiler
+{
+    public:
+        ParseErrorTextTrigCompiler(size_t numWorkers) : TextTrigCompiler(true, 0x0058A364, numWorkers) {}
+
+        std::string parseError(std::string text, ScenarioPtr scenario, Sc::Data & scData) // Returns the error from parsing text
+        {
+            std::vector<RawString> stringContents;
+            std::deque<Chk::TriggerPtr> triggers;
+            std::stringstream error;
+            loadCompiler(scenario, scData, 0, scenario->triggers.numTriggers());
+            cleanText(text, stringContents);
+            parseTriggers(text, stringContents, triggers, error);
+            return error.str();
+        }
+};
+
+TEST(TextTrigCompilerTest, ParallelCompileMatchesSequential)
+{
+    constexpr size_t numTriggers = 3000;
+    std::string textTrigs = generateTriggerText(numTriggers);
+    std::string sequentialTextTrigs = textTrigs;
+
+    Sc::Data scData;
+    ScenarioPtr scenario = ScenarioPtr(new Scenario(Sc::Terrain::Tileset::Badlands));
+    ScenarioPtr sequentialScenario = ScenarioPtr(new Scenario(Sc::Terrain::Tileset::Badlands));
+    TextTrigCompiler ttc(true, 0x0058A364, 8);
+    TextTrigCompiler sequentialTtc(true, 0x0058A364, 1);
+    EXPECT_TRUE(ttc.compileTriggers(textTrigs, scenario, scData, 0, scenario->triggers.numTriggers()));
+    EXPECT_TRUE(sequentialTtc.compileTriggers(sequentialTextTrigs, sequentialScenario, scData, 0, sequentialScenario->triggers.numTriggers()));
+
+    ASSERT_EQ(numTriggers, scenario->triggers.numTriggers());
+    ASSERT_EQ(numTriggers, sequentialScenario->triggers.numTriggers());
+    for ( size_t trigIndex=0; trigIndex<numTriggers; trigIndex++ )
+    {
+        Chk::TriggerPtr trigger = scenario->triggers.getTrigger(trigIndex);
+        Chk::TriggerPtr sequentialTrigger = sequentialScenario->triggers.getTrigger(trigIndex);
+        EXPECT_EQ(0, std::memcmp(trigger.get(), sequentialTrigger.get(), sizeof(Chk::Trigger))) << "Trigger #" << trigIndex;
+        EXPECT_EQ(Chk::Trigger::Owned::Yes, trigger->owners[trigIndex % 8]);
+        EXPECT_EQ(u32(trigIndex), trigger->conditions[0].amount);
+
+        auto message = scenario->strings.getString<RawString>(trigger->actions[0].stringId, Chk::Scope::Game);
+        ASSERT_TRUE(message != nullptr);
+        EXPECT_EQ("Message " + std::to_string(trigIndex % 300), *message);
+        auto sound = scenario->strings.getString<RawString>(trigger->actions[1].soundStringId, Chk::Scope::Game);
+        ASSERT_TRUE(sound != nullptr);
+        EXPECT_EQ("sound\\" + std::to_string(trigIndex % 7) + ".wav", *sound);
+        auto objective = scenario->strings.getString<RawString>(trigger->actions[2].stringId, Chk::Scope::Game);
+        ASSERT_TRUE(objective != nullptr);
+        EXPECT_EQ("Objective " + std::to_string(trigIndex), *objective);
+    }
+}
+
+TEST(TextTrigCompilerTest, ParallelCompileErrorsMatchSequential)
+{
+    constexpr size_t numTriggers = 3000;
+    Sc::Data scData;
+    ScenarioPtr scenario = ScenarioPtr(new Scenario(Sc::Terrain::Tileset::Badlands));
+    ParseErrorTextTrigCompiler ttc(8);
+    ParseErrorTextTrigCompiler sequentialTtc(1);
+
+    std::string textTrigs = generateTriggerText(numTriggers);
+    EXPECT_EQ("Success!", ttc.parseError(textTrigs, scenario, scData));
+
+    std::vector<std::pair<std::string, std::string>> errors = { // Trigger text that's replaced and the broken text replacing it
+        { "\"Zerg Zergling\", Exactly, 2500);", "\"Zerg Zergling Queen\", Exactly, 2500);" }, // Error within a chunk
+        { "Exactly, 1500);\n\nActions:", "Exactly, 1500);\n\nActions:\n\tNot An Action();" }, // Error within a chunk after a multi-line trigger
+        { "\"Objective 1000\");\n}", "\"Objective 1000\");\n" }, // Trigger left open, only seen as an error when parsing into the next chunk
+        { "\"Objective 2999\");\n}", "\"Objective 2999\");\n" } // Last trigger left open
+    };
+    for ( auto & error : errors )
+    {
+        std::string brokenTextTrigs = textTrigs;
+        size_t errorPos = brokenTextTrigs.find(error.first);
+        ASSERT_NE(std::string::npos, errorPos);
+        brokenTextTrigs.replace(errorPos, error.first.size(), error.second);
+
+        std::string parallelError = ttc.parseError(brokenTextTrigs, scenario, scData);
+        std::string sequentialError = sequentialTtc.parseError(brokenTextTrigs, scenario, scData);
+        EXPECT_EQ(0, parallelError.find("Line: ")) << parallelError;
+        EXPECT_EQ(sequentialError, parallelError);
+    }
+}
+
+TEST(TextTrigCompilerTest, HashTriggers)
+{
+    std::string textTrigs = generateTriggerText(3);
+    std::vector<size_t> triggerStarts;
+    std::vector<u64> triggerHashes;
+    TextTrigGenerator::hashTriggers(textTrigs, triggerStarts, triggerHashes);
+    ASSERT_EQ(3, triggerStarts.size());
+    ASSERT_EQ(3, triggerHashes.size());
+    EXPECT_EQ(0, triggerStarts[0]);
+    EXPECT_EQ(0, textTrigs.compare(triggerStarts[1], 8, "Trigger("));
+    EXPECT_NE(triggerHashes[0], triggerHashes[1]);
+
+    std::string reformatted = "// Leading comment\r\n" + std::regex_replace(textTrigs, std::regex("\n"), " // Comment\r\n");
+    reformatted = std::regex_replace(reformatted, std::regex("Trigger\\(|Deaths\\("), "  $&  ");
+    reformatted = std::regex_replace(reformatted, std::regex("Conditions"), "conditions");
+    std::vector<u64> reformattedHashes;
+    TextTrigGenerator::hashTriggers(reformatted, triggerStarts, reformattedHashes);
+    EXPECT_EQ(triggerHashes, reformattedHashes);
+
+    std::string changedString = std::regex_replace(textTrigs, std::regex("\"Message 1\""), "\"message 1\"");
+    std::vector<u64> changedHashes;
+    TextTrigGenerator::hashTriggers(changedString, triggerStarts, changedHashes);
+    ASSERT_EQ(3, changedHashes.size());
+    EXPECT_EQ(triggerHashes[0], changedHashes[0]);
+    EXPECT_NE(triggerHashes[1], changedHashes[1]);
+    EXPECT_EQ(triggerHashes[2], changedHashes[2]);
+}
+
+TEST(TextTrigCompilerTest, RecompileKeepsStringsOfReplacedTriggers)
+{
+    std::string textTrigs = "Trigger(\"Player 1\"){\nConditions:"
+        "\n\tAlways();"
+        "\n\nActions:"
+        "\n\tDisplay Text Message(Always Display, \"Kept Message\");"
+        "\n\tSet Mission Objectives(\"Old Objective\");"
+        "\n}\n\n//-----------------------------------------------------------------//\n\n";
+    Sc::Data scData;
+    ScenarioPtr scenario = ScenarioPtr(new Scenario(Sc::Terrain::Tileset::Badlands));
+    TextTrigCompiler ttc(true, 0x0058A364);
+    ASSERT_TRUE(ttc.compileTriggers(textTrigs, scenario, scData, 0, scenario->triggers.numTriggers()));
+    size_t keptStringId = scenario->triggers.getTrigger(0)->actions[0].stringId;
+
+    // The kept message is only used by the trigger being replaced, the new objective mustn't take its place
+    std::string changedText = std::regex_replace(textTrigs, std::regex("\"Old Objective\""), "\"New Objective\"");
+    ASSERT_TRUE(ttc.compileTriggers(changedText, scenario, scData, 0, scenario->triggers.numTriggers()));
+    ASSERT_EQ(1, scenario->triggers.numTriggers());
+    const Chk::TriggerPtr trigger = scenario->triggers.getTrigger(0);
+    EXPECT_EQ(keptStringId, trigger->actions[0].stringId);
+    EXPECT_NE(trigger->actions[0].stringId, trigger->actions[1].stringId);
+    auto message = scenario->strings.getString<RawString>(trigger->actions[0].stringId, Chk::Scope::Game);
+    ASSERT_TRUE(message != nullptr);
+    EXPECT_EQ("Kept Message", *message);
+    auto objective = scenario->strings.getString<RawString>(trigger->actions[1].stringId, Chk::Scope::Game);
+    ASSERT_TRUE(objective != nullptr);
+    EXPECT_EQ("New Objective", *objective);
+    EXPECT_TRUE(scenario->strings.findString<RawString>("Old Objective", Chk::Scope::Game) == Chk::StringId::NoString);
+}
+
+TEST(TextTrigCompilerTest, CompileChangedTriggers)
+{
+    constexpr size_t numTriggers = 400;
+    std::string textTrigs = generateTriggerText(numTriggers);
+    Sc::Data scData;
+    ScenarioPtr scenario = ScenarioPtr(new Scenario(Sc::Terrain::Tileset::Badlands));
+    TextTrigCompiler ttc(true, 0x0058A364);
+    ASSERT_TRUE(ttc.compileTriggers(textTrigs, scenario, scData, 0, scenario->triggers.numTriggers()));
+
+    TextTrigGenerator ttg(true, 0x0058A364);
+    ASSERT_TRUE(ttg.generateTextTrigs(scenario, textTrigs));
+    std::vector<u64> triggerHashes = ttg.getTriggerHashes();
+    u64 modificationEpoch = ttg.getModificationEpoch();
+    ASSERT_EQ(numTriggers, triggerHashes.size());
+    const Triggers & triggers = scenario->triggers;
+    auto expectTriggerStrings = [&](bool lastObjectiveEdited) { // Reused triggers must keep the text of their strings, not only the string ids
+        for ( size_t trigIndex=0; trigIndex<triggers.numTriggers(); trigIndex++ )
+        {
+            Chk::TriggerPtr trigger = triggers.getTrigger(trigIndex);
+            u32 textIndex = trigger->conditions[0].amount; // The index of the trigger when the text was generated
+            auto message = scenario->strings.getString<RawString>(trigger->actions[0].stringId, Chk::Scope::Game);
+            ASSERT_TRUE(message != nullptr) << "Trigger #" << trigIndex;
+            EXPECT_EQ("Message " + std::to_string(textIndex % 300), *message) << "Trigger #" << trigIndex;
+            auto objective = scenario->strings.getString<RawString>(trigger->actions[2].stringId, Chk::Scope::Game);
+            ASSERT_TRUE(objective != nullptr) << "Trigger #" << trigIndex;
+            if ( textIndex == 200 )
+                EXPECT_EQ("Changed Objective", *objective);
+            else if ( textIndex == 399 && lastObjectiveEdited )
+                EXPECT_EQ("Last Objective", *objective);
+            else
+                EXPECT_EQ("Objective " + std::to_string(textIndex), *objective) << "Trigger #" << trigIndex;
+        }
+    };
+
+    std::vector<Chk::Trigger*> originalTriggers;
+    for ( size_t trigIndex=0; trigIndex<numTriggers; trigIndex++ )
+        originalTriggers.push_back(triggers.getTrigger(trigIndex).get());
+
+    std::string unchangedText = textTrigs;
+    EXPECT_TRUE(ttc.compileChangedTriggers(unchangedText, scenario, scData, triggerHashes, modificationEpoch));
+    for ( size_t trigIndex=0; trigIndex<numTriggers; trigIndex++ )
+        EXPECT_EQ(originalTriggers[trigIndex], triggers.getTrigger(trigIndex).get());
+
+    // Changing one trigger only replaces that trigger
+    std::string changedText = std::regex_replace(textTrigs, std::regex("\"Objective 200\""), "\"Changed Objective\"");
+    ASSERT_NE(textTrigs, changedText);
+    EXPECT_TRUE(ttc.compileChangedTriggers(changedText, scenario, scData, triggerHashes, modificationEpoch));
+    ASSERT_EQ(numTriggers, scenario->triggers.numTriggers());
+    for ( size_t trigIndex=0; trigIndex<numTriggers; trigIndex++ )
+    {
+        Chk::TriggerPtr trigger = triggers.getTrigger(trigIndex);
+        if ( trigIndex == 200 )
+            EXPECT_NE(originalTriggers[trigIndex], trigger.get());
+        else
+            EXPECT_EQ(originalTriggers[trigIndex], trigger.get()) << "Trigger #" << trigIndex;
+
+        auto objective = scenario->strings.getString<RawString>(trigger->actions[2].stringId, Chk::Scope::Game);
+        ASSERT_TRUE(objective != nullptr);
+        EXPECT_EQ(trigIndex == 200 ? "Changed Objective" : "Objective " + std::to_string(trigIndex), *objective);
+        auto message = scenario->strings.getString<RawString>(trigger->actions[0].stringId, Chk::Scope::Game);
+        ASSERT_TRUE(message != nullptr);
+        EXPECT_EQ("Message " + std::to_string(trigIndex % 300), *message);
+    }
+    EXPECT_TRUE(scenario->strings.findString<RawString>("Objective 200", Chk::Scope::Game) == Chk::StringId::NoString);
+    expectTriggerStrings(false);
+
+    // Inserting and removing triggers shifts the unchanged triggers after them
+    std::vector<size_t> triggerStarts;
+    std::vector<u64> textHashes;
+    TextTrigGenerator::hashTriggers(changedText, triggerStarts, textHashes);
+    std::string insertedTrigger = generateTriggerText(1);
+    std::string insertedText = changedText.substr(0, triggerStarts[100]) + insertedTrigger + changedText.substr(triggerStarts[100]);
+    EXPECT_TRUE(ttc.compileChangedTriggers(insertedText, scenario, scData, triggerHashes, modificationEpoch));
+    ASSERT_EQ(numTriggers+1, scenario->triggers.numTriggers());
+    EXPECT_EQ(numTriggers+1, triggerHashes.size());
+    EXPECT_EQ(0, triggers.getTrigger(100)->conditions[0].amount);
+    for ( size_t trigIndex=0; trigIndex<numTriggers; trigIndex++ )
+    {
+        if ( trigIndex != 200 )
+            EXPECT_EQ(originalTriggers[trigIndex], triggers.getTrigger(trigIndex < 100 ? trigIndex : trigIndex+1).get()) << "Trigger #" << trigIndex;
+    }
+    expectTriggerStrings(false);
+
+    std::string removedText = insertedText.substr(triggerStarts[1]);
+    EXPECT_TRUE(ttc.compileChangedTriggers(removedText, scenario, scData, triggerHashes, modificationEpoch));
+    ASSERT_EQ(numTriggers, scenario->triggers.numTriggers());
+    for ( size_t trigIndex=1; trigIndex<numTriggers; trigIndex++ )
+    {
+        if ( trigIndex != 200 )
+            EXPECT_EQ(originalTriggers[trigIndex], triggers.getTrigger(trigIndex < 100 ? trigIndex-1 : trigIndex).get()) << "Trigger #" << trigIndex;
+    }
+    expectTriggerStrings(false);
+
+    // Editing only the last trigger replaces just that trigger
+    TextTrigGenerator::hashTriggers(removedText, triggerStarts, textHashes);
+    ASSERT_EQ(numTriggers, triggerStarts.size());
+    std::string lastTrigger = removedText.substr(triggerStarts[numTriggers-1]);
+    std::string editedLastText = removedText.substr(0, triggerStarts[numTriggers-1]) + std::regex_replace(lastTrigger, std::regex("\"Objective 399\""), "\"Last Objective\"");
+    ASSERT_NE(removedText, editedLastText);
+    Chk::Trigger* lastTriggerBefore = triggers.getTrigger(numTriggers-2).get();
+    EXPECT_TRUE(ttc.compileChangedTriggers(editedLastText, scenario, scData, triggerHashes, modificationEpoch));
+    ASSERT_EQ(numTriggers, scenario->triggers.numTriggers());
+    EXPECT_EQ(lastTriggerBefore, triggers.getTrigger(numTriggers-2).get());
+    EXPECT_NE(originalTriggers[numTriggers-1], triggers.getTrigger(numTriggers-1).get());
+    auto lastObjective = scenario->strings.getString<RawString>(triggers.getTrigger(numTriggers-1)->actions[2].stringId, Chk::Scope::Game);
+    ASSERT_TRUE(lastObjective != nullptr);
+    EXPECT_EQ("Last Objective", *lastObjective);
+    expectTriggerStrings(true);
+
+    // Removing the trailing triggers keeps every trigger before them
+    std::string trailingRemovedText = editedLastText.substr(0, triggerStarts[numTriggers-2]);
+    EXPECT_TRUE(ttc.compileChangedTriggers(trailingRemovedText, scenario, scData, triggerHashes, modificationEpoch));
+    ASSERT_EQ(numTriggers-2, scenario->triggers.numTriggers());
+    EXPECT_EQ(numTriggers-2, triggerHashes.size());
+    for ( size_t trigIndex=1; trigIndex<numTriggers-2; trigIndex++ )
+    {
+        if ( trigIndex != 200 )
+            EXPECT_EQ(originalTriggers[trigIndex], triggers.getTrigger(trigIndex < 100 ? trigIndex-1 : trigIndex).get()) << "Trigger #" << trigIndex;
+    }
+    EXPECT_TRUE(scenario->strings.findString<RawString>("Last Objective", Chk::Scope::Game) == Chk::StringId::NoString);
+    expectTriggerStrings(false);
+
+    std::string lastRemovedText = trailingRemovedText.substr(0, triggerStarts[numTriggers-3]);
+    EXPECT_TRUE(ttc.compileChangedTriggers(lastRemovedText, scenario, scData, triggerHashes, modificationEpoch));
+    EXPECT_EQ(numTriggers-3, scenario->triggers.numTriggers());
+    EXPECT_EQ(numTriggers-3, triggerHashes.size());
+    expectTriggerStrings(false);
+
+    // Strings or triggers changed outside of the text since it was compiled make the next compile replace every trigger
+    TextTrigGenerator::hashTriggers(lastRemovedText, triggerStarts, textHashes);
+    std::string editedText = std::regex_replace(lastRemovedText, std::regex("\"Objective 50\""), "\"Edited Objective\"");
+    ASSERT_NE(lastRemovedText, editedText);
+    std::string compiledText; // Compiling changes the text given
+    Chk::Trigger* firstTrigger = triggers.getTrigger(0).get();
+    scenario->strings.replaceString<RawString>(triggers.getTrigger(10)->actions[2].stringId, "Renamed Elsewhere");
+    EXPECT_TRUE(ttc.compileChangedTriggers(compiledText = editedText, scenario, scData, triggerHashes, modificationEpoch));
+    ASSERT_EQ(numTriggers-3, triggers.numTriggers());
+    EXPECT_NE(firstTrigger, triggers.getTrigger(0).get());
+    auto renamedObjective = scenario->strings.getString<RawString>(triggers.getTrigger(10)->actions[2].stringId, Chk::Scope::Game);
+    ASSERT_TRUE(renamedObjective != nullptr);
+    EXPECT_EQ("Objective 11", *renamedObjective); // Index 10 holds the trigger that was originally at 11
+    EXPECT_TRUE(scenario->strings.findString<RawString>("Renamed Elsewhere", Chk::Scope::Game) == Chk::StringId::NoString);
+
+    firstTrigger = triggers.getTrigger(0).get();
+    Chk::Condition changedCondition = triggers.getTrigger(5)->conditions[0];
+    changedCondition.amount = 99;
+    scenario->triggers.setCondition(5, 0, changedCondition);
+    EXPECT_TRUE(ttc.compileChangedTriggers(compiledText = editedText, scenario, scData, triggerHashes, modificationEpoch));
+    EXPECT_NE(firstTrigger, triggers.getTrigger(0).get());
+    EXPECT_EQ(6, triggers.getTrigger(5)->conditions[0].amount);
+
+    firstTrigger = triggers.getTrigger(0).get();
+    EXPECT_TRUE(ttc.compileChangedTriggers(compiledText = editedText, scenario, scData, triggerHashes, modificationEpoch)); // Nothing changed since
+    EXPECT_EQ(firstTrigger, triggers.getTrigger(0).get());
+
+    // Cleanup only removes strings the replaced triggers used that nothing else uses
+    scenario->strings.setLocationName<RawString>(1, "Objective 30"); // Shares the string of the trigger at index 29
+    std::string regeneratedText;
+    ASSERT_TRUE(ttg.generateTextTrigs(scenario, regeneratedText));
+    triggerHashes = ttg.getTriggerHashes();
+    modificationEpoch = ttg.getModificationEpoch();
+    std::string sharedEditedText = std::regex_replace(regeneratedText, std::regex("\"Objective 30\""), "\"Objective Thirty\"");
+    ASSERT_NE(regeneratedText, sharedEditedText);
+    firstTrigger = triggers.getTrigger(0).get();
+    EXPECT_TRUE(ttc.compileChangedTriggers(sharedEditedText, scenario, scData, triggerHashes, modificationEpoch));
+    EXPECT_EQ(firstTrigger, triggers.getTrigger(0).get());
+    auto locationName = scenario->strings.getLocationName<RawString>(1);
+    ASSERT_TRUE(locationName != nullptr);
+    EXPECT_EQ("Objective 30", *locationName);
+
+    // Hashes that don't match the map's triggers fall back to compiling everything
+    std::vector<u64> mismatchedHashes(3);
+    std::string fullText = generateTriggerText(5);
+    EXPECT_TRUE(ttc.compileChangedTriggers(fullText, scenario, scData, mismatchedHashes, modificationEpoch));
+    EXPECT_EQ(5, scenario->triggers.numTriggers());
+    EXPECT_EQ(5, mismatchedHashes.size());
+}
+
 void TestCircularity(Sc::Data & scData, MapFile mapFile)
 {
     ScenarioPtr scenarioPtr = ScenarioPtr(&((Scenario &)mapFile), [](Scenario*){});
@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+void setActionString(ScenarioPtr scenario, size_t triggerIndex, size_t actionIndex, const std::string & str) // Each string is in use before the next is added, unused string ids are reused
+{
+    Chk::Action action = scenario->triggers.getTrigger(triggerIndex)->actions[actionIndex];
+    action.stringId = u32(scenario->strings.addString<RawString>(str));
+    scenario->triggers.setAction(triggerIndex, actionIndex, action);
+}
+
+ScenarioPtr scenarioWithTriggers(size_t numTriggers)
+{
+    ScenarioPtr scenario = ScenarioPtr(new Scenario(Sc::Terrain::Tileset::Badlands));
+    for ( size_t i=0; i<numTriggers; i++ )
+    {
+        auto trigger = Chk::TriggerPtr(new Chk::Trigger());
+        trigger->owners[i % 8] = Chk::Trigger::Owned::Yes;
+        trigger->conditions[0].conditionType = Chk::Condition::Type::Deaths;
+        trigger->conditions[0].player = Sc::Player::Id::CurrentPlayer;
+        trigger->conditions[0].comparison = Chk::Condition::Comparison::Exactly;
+        trigger->conditions[0].amount = u32(i);
+        trigger->actions[0].actionType = Chk::Action::Type::DisplayTextMessage;
+        trigger->actions[1].actionType = Chk::Action::Type::SetMissionObjectives;
+        scenario->triggers.addTrigger(trigger);
+        setActionString(scenario, i, 0, "Message\r\n" + std::to_string(i % 50));
+        setActionString(scenario, i, 1, "Objective " + std::to_string(i % 20));
+    }
+    return scenario;
+}
+
+ScenarioPtr scenarioWithVariedTriggers() // Triggers using many argument types, flags, escaped strings and disabled conditions and actions
+{
+    ScenarioPtr scenario = scenarioWithTriggers(3);
+
+    auto trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->owners[Sc::Player::Id::Player1] = Chk::Trigger::Owned::Yes;
+    trigger->owners[Sc::Player::Id::Player3] = Chk::Trigger::Owned::Yes;
+    trigger->conditions[0].conditionType = Chk::Condition::Type::Switch;
+    trigger->conditions[0].typeIndex = 3;
+    trigger->conditions[0].comparison = Chk::Condition::Comparison::Set;
+    trigger->conditions[1].conditionType = Chk::Condition::Type::Bring;
+    trigger->conditions[1].player = Sc::Player::Id::CurrentPlayer;
+    trigger->conditions[1].unitType = Sc::Unit::Type::TerranMarine;
+    trigger->conditions[1].locationId = Chk::LocationId::Anywhere;
+    trigger->conditions[1].comparison = Chk::Condition::Comparison::AtLeast;
+    trigger->conditions[1].amount = 5;
+    trigger->conditions[2].conditionType = Chk::Condition::Type::Always;
+    trigger->actions[0].actionType = Chk::Action::Type::DisplayTextMessage;
+    trigger->actions[0].stringId = u32(scenario->strings.addString<RawString>("Say \"hi\"\\ now\r\nline\t2"));
+    trigger->actions[1].actionType = Chk::Action::Type::SetSwitch;
+    trigger->actions[1].number = 3;
+    trigger->actions[1].type2 = Chk::Trigger::ValueModifier::Toggle;
+    trigger->actions[2].actionType = Chk::Action::Type::CreateUnit;
+    trigger->actions[2].group = Sc::Player::Id::Player2;
+    trigger->actions[2].type = Sc::Unit::Type::ZergZergling;
+    trigger->actions[2].type2 = 4;
+    trigger->actions[2].locationId = Chk::LocationId::Anywhere;
+    trigger->actions[3].actionType = Chk::Action::Type::Wait;
+    trigger->actions[3].time = 1000;
+    trigger->actions[4].actionType = Chk::Action::Type::PreserveTrigger;
+    scenario->triggers.addTrigger(trigger);
+
+    trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->owners[Sc::Player::Id::Force1] = Chk::Trigger::Owned::Yes;
+    trigger->conditions[0].conditionType = Chk::Condition::Type::Deaths;
+    trigger->conditions[0].player = Sc::Player::Id::AllPlayers;
+    trigger->conditions[0].unitType = Sc::Unit::Type::ProtossZealot;
+    trigger->conditions[0].comparison = Chk::Condition::Comparison::AtMost;
+    trigger->conditions[0].amount = 12;
+    trigger->conditions[0].toggleDisabled();
+    trigger->conditions[1].conditionType = Chk::Condition::Type::ElapsedTime;
+    trigger->conditions[1].comparison = Chk::Condition::Comparison::Exactly;
+    trigger->conditions[1].amount = 60;
+    trigger->actions[0].actionType = Chk::Action::Type::Comment;
+    trigger->actions[0].stringId = u32(scenario->strings.addString<RawString>("A comment"));
+    trigger->actions[1].actionType = Chk::Action::Type::SetDeaths;
+    trigger->actions[1].group = Sc::Player::Id::Player1;
+    trigger->actions[1].type = Sc::Unit::Type::TerranGhost;
+    trigger->actions[1].type2 = Chk::Trigger::ValueModifier::Add;
+    trigger->actions[1].number = 7;
+    trigger->actions[2].actionType = Chk::Action::Type::MinimapPing;
+    trigger->actions[2].locationId = Chk::LocationId::Anywhere;
+    trigger->actions[2].toggleDisabled();
+    trigger->actions[3].actionType = Chk::Action::Type::SetResources;
+    trigger->actions[3].group = Sc::Player::Id::CurrentPlayer;
+    trigger->actions[3].type = Chk::Trigger::ResourceType::OreAndGas;
+    trigger->actions[3].type2 = Chk::Trigger::ValueModifier::Subtract;
+    trigger->actions[3].number = 250;
+    trigger->actions[4].actionType = Chk::Action::Type::Victory;
+    trigger->flags = Chk::Trigger::Flags::PreserveTrigger | Chk::Trigger::Flags::IgnoreDefeatDraw;
+    scenario->triggers.addTrigger(trigger);
+    return scenario;
+}
+
+TEST(TextTrigGeneratorTest, ParallelGenerationMatchesSequential)
+{
+    ScenarioPtr scenario = scenarioWithTriggers(2000);
+    TextTrigGenerator ttg(true, 0x0058A364, 8);
+    TextTrigGenerator sequentialTtg(true, 0x0058A364, 1);
+
+    std::string textTrigs, sequentialTextTrigs;
+    EXPECT_TRUE(ttg.generateTextTrigs(scenario, textTrigs));
+    EXPECT_TRUE(sequentialTtg.generateTextTrigs(scenario, sequentialTextTrigs));
+    EXPECT_EQ(sequentialTextTrigs, textTrigs);
+    EXPECT_EQ(sequentialTtg.getTriggerHashes(), ttg.getTriggerHashes());
+    ASSERT_EQ(2000, ttg.getTriggerHashes().size());
+
+    std::vector<size_t> triggerStarts;
+    std::vector<u64> triggerHashes;
+    TextTrigGenerator::hashTriggers(textTrigs, triggerStarts, triggerHashes);
+    EXPECT_EQ(ttg.getTriggerHashes(), triggerHashes);
+    for ( size_t pos = textTrigs.find('\n'); pos != std::string::npos; pos = textTrigs.find('\n', pos+1) )
+        ASSERT_EQ('\r', textTrigs[pos-1]) << "Line ending at " << pos << " wasn't corrected";
+}
+
+TEST(TextTrigGeneratorTest, HashTriggersEndingInEscapedBackslash)
+{
+    std::string textTrigs =
+        "Trigger(\"All Players\"){\r\nConditions:\r\n\tAlways();\r\n\r\nActions:\r\n\tComment(\"Ends in \\\\\");\r\n}\r\n\r\n"
+        "Trigger(\"All Players\"){\r\nConditions:\r\n\tNever();\r\n\r\nActions:\r\n\tComment(\"Quoted \\\"\\\\\\\"\");\r\n}\r\n\r\n"
+        "Trigger(\"All Players\"){\r\nConditions:\r\n\tAlways();\r\n\r\nActions:\r\n\tVictory();\r\n}\r\n\r\n";
+    std::vector<size_t> triggerStarts;
+    std::vector<u64> triggerHashes;
+    TextTrigGenerator::hashTriggers(textTrigs, triggerStarts, triggerHashes);
+    ASSERT_EQ(3, triggerStarts.size());
+    ASSERT_EQ(3, triggerHashes.size());
+    for ( size_t i=0; i<triggerStarts.size(); i++ )
+    {
+        size_t end = i+1 < triggerStarts.size() ? triggerStarts[i+1] : textTrigs.size();
+        EXPECT_EQ(0, textTrigs.compare(triggerStarts[i], 8, "Trigger("));
+        EXPECT_EQ(TextTrigGenerator::hashTriggerText(&textTrigs[triggerStarts[i]], end-triggerStarts[i]), triggerHashes[i]);
+    }
+
+    std::string changedSpacing = textTrigs;
+    changedSpacing.replace(changedSpacing.find("Victory();"), 10, "victory ( ) ;");
+    std::vector<u64> changedHashes;
+    TextTrigGenerator::hashTriggers(changedSpacing, triggerStarts, changedHashes);
+    EXPECT_EQ(triggerHashes, changedHashes); // Spacing and case outside of strings are not hashed
+
+    ScenarioPtr scenario = scenarioWithTriggers(2);
+    auto trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->owners[Sc::Player::Id::Player1] = Chk::Trigger::Owned::Yes;
+    trigger->conditions[0].conditionType = Chk::Condition::Type::Always;
+    trigger->actions[0].actionType = Chk::Action::Type::Comment;
+    trigger->actions[0].stringId = u32(scenario->strings.addString<RawString>("Ends in \\"));
+    scenario->triggers.insertTrigger(1, trigger);
+
+    TextTrigGenerator ttg(true, 0x0058A364, 1);
+    std::string generatedText;
+    EXPECT_TRUE(ttg.generateTextTrigs(scenario, generatedText));
+    EXPECT_NE(std::string::npos, generatedText.find("\"Ends in \\\\\")"));
+    TextTrigGenerator::hashTriggers(generatedText, triggerStarts, triggerHashes);
+    EXPECT_EQ(ttg.getTriggerHashes(), triggerHashes);
+}
+
+TEST(TextTrigGeneratorTest, StreamedGenerationMatchesString)
+{
+    for ( size_t numTriggers : { size_t(0), size_t(1), size_t(5000) } )
+    {
+        ScenarioPtr scenario = scenarioWithTriggers(numTriggers);
+        TextTrigGenerator ttg(true, 0x0058A364, 4);
+
+        std::string textTrigs;
+        EXPECT_TRUE(ttg.generateTextTrigs(scenario, textTrigs));
+        std::vector<u64> triggerHashes = ttg.getTriggerHashes();
+
+        std::stringstream streamedTextTrigs;
+        EXPECT_TRUE(ttg.generateTextTrigs(scenario, streamedTextTrigs));
+        EXPECT_EQ(textTrigs, streamedTextTrigs.str());
+        EXPECT_EQ(triggerHashes, ttg.getTriggerHashes());
+        EXPECT_EQ(numTriggers, triggerHashes.size());
+    }
+}
+
+TEST(TextTrigGeneratorTest, MatchesGoldenOutput)
+{
+    const std::vector<std::string> goldenLines = { // Captured from the generator before triggers were rendered in parallel chunks
+        "Trigger(\"Player 1\"){",
+        "Conditions:",
+        "\tDeaths(\"Current Player\", \"Terran Marine\", Exactly, 0);",
+        "",
+        "Actions:",
+        "\tDisplay Text Message(Don't Always Display, \"Message\\r\\n0\");",
+        "\tSet Mission Objectives(\"Objective 0\");",
+        "}",
+        "",
+        "//-----------------------------------------------------------------//",
+        "",
+        "Trigger(\"Player 2\"){",
+        "Conditions:",
+        "\tDeaths(\"Current Player\", \"Terran Marine\", Exactly, 1);",
+        "",
+        "Actions:",
+        "\tDisplay Text Message(Don't Always Display, \"Message\\r\\n1\");",
+        "\tSet Mission Objectives(\"Objective 1\");",
+        "}",
+        "",
+        "//-----------------------------------------------------------------//",
+        "",
+        "Trigger(\"Player 3\"){",
+        "Conditions:",
+        "\tDeaths(\"Current Player\", \"Terran Marine\", Exactly, 2);",
+        "",
+        "Actions:",
+        "\tDisplay Text Message(Don't Always Display, \"Message\\r\\n2\");",
+        "\tSet Mission Objectives(\"Objective 2\");",
+        "}",
+        "",
+        "//-----------------------------------------------------------------//",
+        "",
+        "Trigger(\"Player 1\",\"Player 3\"){",
+        "Conditions:",
+        "\tSwitch(\"Switch4\", set);",
+        "\tBring(\"Current Player\", \"Terran Marine\", \"Anywhere\", At least, 5);",
+        "\tAlways();",
+        "",
+        "Actions:",
+        "\tDisplay Text Message(Don't Always Display, \"Say \\\"hi\\\"\\\\ now\\r\\nline\\t2\");",
+        "\tSet Switch(\"Switch4\", toggle);",
+        "\tCreate Unit(\"Player 2\", \"Zerg Zergling\", 4, \"Anywhere\");",
+        "\tWait(1000);",
+        "\tPreserve Trigger();",
+        "}",
+        "",
+        "//-----------------------------------------------------------------//",
+        "",
+        "Trigger(\"Force 1\"){",
+        "Conditions:",
+        ";\tDeaths(\"All players\", \"Protoss Zealot\", At most, 12);",
+        "\tElapsed Time(Exactly, 60);",
+        "",
+        "Actions:",
+        "\tComment(\"A comment\");",
+        "\tSet Deaths(\"Player 1\", \"Terran Ghost\", Add, 7);",
+        ";\tMinimap Ping(\"Anywhere\");",
+        "\tSet Resources(\"Current Player\", Subtract, 250, ore and gas);",
+        "\tVictory();",
+        "",
+        "Flags:",
+        "00000000000000000000000000000110;",
+        "}",
+        "",
+        "//-----------------------------------------------------------------//",
+        ""
+    };
+    std::string golden;
+    for ( const std::string & line : goldenLines )
+        golden += line + "\r\n";
+
+    ScenarioPtr scenario = scenarioWithVariedTriggers();
+    for ( size_t numWorkers : { size_t(1), size_t(4) } )
+    {
+        TextTrigGenerator ttg(true, 0x0058A364, numWorkers);
+        std::string textTrigs;
+        EXPECT_TRUE(ttg.generateTextTrigs(scenario, textTrigs));
+        EXPECT_EQ(golden, textTrigs) << numWorkers;
+
+        std::stringstream streamedTextTrigs;
+        EXPECT_TRUE(ttg.generateTextTrigs(scenario, streamedTextTrigs));
+        EXPECT_EQ(golden, streamedTextTrigs.str()) << numWorkers;
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+Sc::Terrain::Tiles mipmapTestTiles() // Four tile groups using megatiles with distinct, partly flipped minitiles
+{
+    Sc::Terrain::Tiles tiles {};
+    tiles.miniTilePixels.resize(16);
+    for ( size_t i=0; i<tiles.miniTilePixels.size(); i++ )
+    {
+        for ( size_t y=0; y<8; y++ )
+        {
+            for ( size_t x=0; x<8; x++ )
+                tiles.miniTilePixels[i].wpeIndex[y][x] = u8(i*16 + y*2 + x%3);
+        }
+    }
+    tiles.tileGraphics.resize(8);
+    for ( size_t i=0; i<tiles.tileGraphics.size(); i++ )
+    {
+        for ( size_t y=0; y<4; y++ )
+        {
+            for ( size_t x=0; x<4; x++ )
+                tiles.tileGraphics[i].miniTileGraphics[y][x].graphics = Sc::Terrain::TileGraphics::MiniTileGraphics::Graphics(u16((((i+x*y)%16) << 1) | ((x+y)%2)));
+        }
+    }
+    tiles.tileGroups.resize(4);
+    for ( size_t i=0; i<tiles.tileGroups.size(); i++ )
+    {
+        for ( size_t member=0; member<16; member++ )
+            tiles.tileGroups[i].megaTileIndex[member] = u16((i+member)%8);
+    }
+    return tiles;
+}
+
+u8 fullScalePixel(const Sc::Terrain::Tiles & tiles, u16 tileValue, size_t x, size_t y)
+{
+    const Sc::Terrain::TileGraphics & tileGraphics = tiles.tileGraphics[tiles.tileGroups[tileValue/16].megaTileIndex[tileValue%16]];
+    const Sc::Terrain::TileGraphics::MiniTileGraphics & miniTileGraphics = tileGraphics.miniTileGraphics[y/8][x/8];
+    return tiles.miniTilePixels[miniTileGraphics.vr4Index()].wpeIndex[y%8][miniTileGraphics.isFlipped() ? 7-x%8 : x%8];
+}
+
+TEST(TileMipmapsTest, LevelFor)
+{
+    EXPECT_EQ(0, TileMipmaps::levelFor(4.0));
+    EXPECT_EQ(0, TileMipmaps::levelFor(1.0));
+    EXPECT_EQ(0, TileMipmaps::levelFor(0.66));
+    EXPECT_EQ(1, TileMipmaps::levelFor(0.5));
+    EXPECT_EQ(1, TileMipmaps::levelFor(0.33));
+    EXPECT_EQ(2, TileMipmaps::levelFor(0.25));
+    EXPECT_EQ(3, TileMipmaps::levelFor(0.10));
+    EXPECT_EQ(3, TileMipmaps::levelFor(0.01));
+
+    EXPECT_EQ(32, TileMipmaps::tileSize(0));
+    EXPECT_EQ(16, TileMipmaps::tileSize(1));
+    EXPECT_EQ(8, TileMipmaps::tileSize(2));
+    EXPECT_EQ(4, TileMipmaps::tileSize(3));
+}
+
+TEST(TileMipmapsTest, FullScaleMatchesTiles)
+{
+    Sc::Terrain::Tiles tiles = mipmapTestTiles();
+    TileMipmaps mipmaps;
+    EXPECT_EQ(nullptr, mipmaps.get(0, 0));
+    mipmaps.setTiles(tiles);
+    EXPECT_THROW(mipmaps.get(0, TileMipmaps::MaxLevel+1), std::out_of_range);
+
+    for ( u16 tileValue=0; tileValue<64; tileValue++ )
+    {
+        const u8* image = mipmaps.get(tileValue, 0);
+        ASSERT_NE(nullptr, image);
+        std::vector<u8> pixels(image, image+32*32);
+        for ( size_t y=0; y<32; y++ )
+        {
+            for ( size_t x=0; x<32; x++ )
+                EXPECT_EQ(fullScalePixel(tiles, tileValue, x, y), pixels[y*32+x]);
+        }
+    }
+    EXPECT_EQ(nullptr, mipmaps.get(64, 0)); // Group 4 isn't in the tileset
+    EXPECT_EQ(nullptr, mipmaps.get(0xFFFF, 2));
+}
+
+TEST(TileMipmapsTest, ReducedLevels)
+{
+    Sc::Terrain::Tiles tiles = mipmapTestTiles();
+    TileMipmaps mipmaps;
+    mipmaps.setTiles(tiles);
+
+    for ( u8 level=1; level<=TileMipmaps::MaxLevel; level++ )
+    {
+        size_t size = TileMipmaps::tileSize(level), blockSize = size_t(1) << level;
+        for ( u16 tileValue : { u16(0), u16(17), u16(63) } )
+        {
+            std::vector<u8> pixels(mipmaps.get(tileValue, level), mipmaps.get(tileValue, level)+size*size);
+            for ( size_t y=0; y<size; y++ )
+            {
+                for ( size_t x=0; x<size; x++ )
+                {
+                    size_t counts[Sc::NumColors] = {};
+                    size_t mostSeenCount = 0;
+                    for ( size_t yPixel=y*blockSize; yPixel<(y+1)*blockSize; yPixel++ )
+                    {
+                        for ( size_t xPixel=x*blockSize; xPixel<(x+1)*blockSize; xPixel++ )
+                            mostSeenCount = std::max(mostSeenCount, ++counts[fullScalePixel(tiles, tileValue, xPixel, yPixel)]);
+                    }
+                    EXPECT_EQ(mostSeenCount, counts[pixels[y*size+x]]); // The reduced pixel is one of the most common in its block
+                }
+            }
+        }
+    }
+
+    Sc::Terrain::Tiles solidTiles = mipmapTestTiles();
+    for ( size_t i=0; i<solidTiles.miniTilePixels.size(); i++ )
+        std::memset(solidTiles.miniTilePixels[i].wpeIndex, 42, sizeof(solidTiles.miniTilePixels[i].wpeIndex));
+
+    mipmaps.setTiles(solidTiles); // Images built from the previous tiles are discarded
+    const u8* image = mipmaps.get(17, 3);
+    for ( size_t i=0; i<16; i++ )
+        EXPECT_EQ(42, image[i]);
+}
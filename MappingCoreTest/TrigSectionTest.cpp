@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <cstring>
+#include <deque>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+Chk::TriggerPtr trigSectionTestTrigger(size_t id)
+{
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->conditions[0].amount = u32(id); // Identifies the trigger
+    trigger->actions[Chk::Trigger::MaxActions-1].number = u32(id);
+    return trigger;
+}
+
+std::string trigSectionTestSection(SectionName sectionName, const std::vector<Chk::TriggerPtr> & triggers, size_t extraBytes = 0)
+{
+    Chk::SectionHeader header = { sectionName, Chk::SectionSize(sizeof(Chk::Trigger)*triggers.size() + extraBytes) };
+    std::string section((const char*)&header, sizeof(header));
+    for ( const Chk::TriggerPtr & trigger : triggers )
+        section.append((const char*)trigger.get(), sizeof(Chk::Trigger));
+
+    section.append(extraBytes, '\x7');
+    return section;
+}
+
+Section trigSectionTestRead(std::multimap<SectionName, Section> & parsedSections, const std::string & sectionData)
+{
+    std::stringstream is(sectionData, std::ios_base::in|std::ios_base::binary);
+    Chk::SectionHeader header = {};
+    is.read((char*)&header, sizeof(header));
+    Chk::SectionSize sizeRead = 0;
+    Section section = ChkSection::read(parsedSections, header, is, sizeRead);
+    EXPECT_EQ(header.sizeInBytes, sizeRead);
+    parsedSections.insert(std::pair<SectionName, Section>(header.name, section));
+    return section;
+}
+
+std::string trigSectionTestWrite(Section section)
+{
+    std::stringstream os(std::ios_base::out|std::ios_base::binary);
+    section->writeWithHeader(os);
+    return os.str();
+}
+
+TEST(TrigSectionTest, ReadWrite)
+{
+    std::vector<Chk::TriggerPtr> first, second;
+    for ( size_t i=0; i<10; i++ )
+        first.push_back(trigSectionTestTrigger(i));
+    for ( size_t i=10; i<15; i++ )
+        second.push_back(trigSectionTestTrigger(i));
+
+    std::multimap<SectionName, Section> parsedSections;
+    TrigSectionPtr trig = std::dynamic_pointer_cast<TrigSection>(trigSectionTestRead(parsedSections, trigSectionTestSection(SectionName::TRIG, first)));
+    ASSERT_NE(nullptr, trig);
+    EXPECT_EQ(trig, trigSectionTestRead(parsedSections, trigSectionTestSection(SectionName::TRIG, second))); // Appended
+    ASSERT_EQ(15, trig->numTriggers());
+    for ( size_t i=0; i<trig->numTriggers(); i++ )
+    {
+        EXPECT_EQ(u32(i), trig->readTrigger(i)->conditions[0].amount);
+        EXPECT_EQ(u32(i), trig->readTrigger(i)->actions[Chk::Trigger::MaxActions-1].number);
+    }
+
+    std::vector<Chk::TriggerPtr> all(first);
+    all.insert(all.end(), second.begin(), second.end());
+    EXPECT_EQ(trigSectionTestSection(SectionName::TRIG, all), trigSectionTestWrite(trig));
+
+    trig->getTrigger(3)->conditions[0].amount = 100;
+    trig->deleteTrigger(5);
+    trig->insertTrigger(8, trigSectionTestTrigger(200));
+    trig->moveTrigger(0, 7);
+    all[3]->conditions[0].amount = 100;
+    all.erase(all.begin()+5);
+    all.insert(all.begin()+8, trigSectionTestTrigger(200));
+    Chk::TriggerPtr moved = all[0];
+    all.erase(all.begin());
+    all.insert(all.begin()+6, moved);
+    EXPECT_EQ(trigSectionTestSection(SectionName::TRIG, all), trigSectionTestWrite(trig));
+
+    trig.reset();
+    parsedSections.clear();
+    trig = std::dynamic_pointer_cast<TrigSection>(trigSectionTestRead(parsedSections, trigSectionTestSection(SectionName::TRIG, std::vector<Chk::TriggerPtr>())));
+    ASSERT_NE(nullptr, trig);
+    EXPECT_EQ(0, trig->numTriggers());
+    EXPECT_EQ(trigSectionTestSection(SectionName::TRIG, std::vector<Chk::TriggerPtr>()), trigSectionTestWrite(trig));
+}
+
+TEST(TrigSectionTest, RawRecordsUntilGotten)
+{
+    std::vector<Chk::TriggerPtr> triggers;
+    for ( size_t i=0; i<6; i++ )
+    {
+        triggers.push_back(trigSectionTestTrigger(i));
+        triggers[i]->actions[0].actionType = Chk::Action::Type::DisplayTextMessage;
+        triggers[i]->actions[0].stringId = 5;
+    }
+    std::multimap<SectionName, Section> parsedSections;
+    TrigSectionPtr trig = std::dynamic_pointer_cast<TrigSection>(trigSectionTestRead(parsedSections, trigSectionTestSection(SectionName::TRIG, triggers)));
+    ASSERT_NE(nullptr, trig);
+    ASSERT_EQ(6, trig->numTriggers());
+    for ( size_t i=1; i<trig->numTriggers(); i++ )
+        EXPECT_EQ(trig->readTrigger(i-1)+1, trig->readTrigger(i)); // Read into one contiguous buffer
+
+    Chk::StringIdRemappings remappings;
+    remappings.set(5, 7);
+    trig->remapStringIds(remappings); // Changes the raw records in place
+    EXPECT_EQ(trig->readTrigger(0)+5, trig->readTrigger(5));
+    for ( auto & trigger : triggers )
+        trigger->actions[0].stringId = 7;
+    EXPECT_EQ(trigSectionTestSection(SectionName::TRIG, triggers), trigSectionTestWrite(trig));
+
+    const Chk::Trigger* rawFirst = trig->readTrigger(0);
+    Chk::TriggerPtr gotten = trig->getTrigger(2); // Copied to its own allocation, the others stay raw
+    EXPECT_EQ(gotten.get(), trig->readTrigger(2));
+    EXPECT_EQ(gotten, trig->getTrigger(2));
+    EXPECT_EQ(rawFirst, trig->readTrigger(0));
+    EXPECT_EQ(rawFirst+5, trig->readTrigger(5));
+    EXPECT_TRUE(gotten.get() < rawFirst || gotten.get() > rawFirst+5);
+
+    gotten->conditions[0].amount = 100;
+    triggers[2]->conditions[0].amount = 100;
+    EXPECT_EQ(100, trig->readTrigger(2)->conditions[0].amount);
+    EXPECT_EQ(3, trig->readTrigger(3)->conditions[0].amount);
+    EXPECT_EQ(trigSectionTestSection(SectionName::TRIG, triggers), trigSectionTestWrite(trig)); // Raw runs around the gotten trigger are written as they are
+
+    trig->moveTrigger(1, 4);
+    trig->deleteTrigger(0);
+    Chk::TriggerPtr moved = triggers[1];
+    triggers.erase(triggers.begin()+1);
+    triggers.insert(triggers.begin()+3, moved);
+    triggers.erase(triggers.begin());
+    EXPECT_EQ(trigSectionTestSection(SectionName::TRIG, triggers), trigSectionTestWrite(trig));
+
+    for ( size_t i=0; i<trig->numTriggers(); i++ )
+        trig->getTrigger(i);
+    EXPECT_EQ(trigSectionTestSection(SectionName::TRIG, triggers), trigSectionTestWrite(trig)); // Once all are gotten the buffer is released
+}
+
+TEST(TrigSectionTest, PartialTrigger)
+{
+    std::vector<Chk::TriggerPtr> triggers = { trigSectionTestTrigger(1), trigSectionTestTrigger(2) };
+    std::multimap<SectionName, Section> parsedSections;
+    TrigSectionPtr trig = std::dynamic_pointer_cast<TrigSection>(trigSectionTestRead(parsedSections, trigSectionTestSection(SectionName::TRIG, triggers, 100)));
+    ASSERT_NE(nullptr, trig);
+    ASSERT_EQ(3, trig->numTriggers()); // The partial trigger is filled out with zeroes
+    const u8* partialTrigger = (const u8*)trig->getTrigger(2).get();
+    for ( size_t i=0; i<sizeof(Chk::Trigger); i++ )
+        EXPECT_EQ(i < 100 ? u8(7) : u8(0), partialTrigger[i]) << i;
+
+    Chk::TriggerPtr expectedPartial = Chk::TriggerPtr(new Chk::Trigger());
+    std::memcpy(expectedPartial.get(), partialTrigger, sizeof(Chk::Trigger));
+    triggers.push_back(expectedPartial);
+    EXPECT_EQ(trigSectionTestSection(SectionName::TRIG, triggers), trigSectionTestWrite(trig));
+}
+
+TEST(TrigSectionTest, HeldTriggerOwnsOnlyItself)
+{
+    std::vector<Chk::TriggerPtr> triggers = { trigSectionTestTrigger(1), trigSectionTestTrigger(2), trigSectionTestTrigger(3) };
+    std::multimap<SectionName, Section> parsedSections;
+    TrigSectionPtr trig = std::dynamic_pointer_cast<TrigSection>(trigSectionTestRead(parsedSections, trigSectionTestSection(SectionName::TRIG, triggers)));
+    ASSERT_NE(nullptr, trig);
+    ASSERT_EQ(3, trig->numTriggers());
+
+    Chk::TriggerPtr held = trig->getTrigger(1); // As held by an undo, clipboard or plugin view after the map moves on
+    std::weak_ptr<Chk::Trigger> first = trig->getTrigger(0);
+    std::weak_ptr<Chk::Trigger> last = trig->getTrigger(2);
+    EXPECT_EQ(2, held.use_count());
+
+    trig.reset();
+    parsedSections.clear();
+    EXPECT_EQ(1, held.use_count());
+    EXPECT_EQ(2, held->conditions[0].amount);
+    EXPECT_TRUE(first.expired()); // The held trigger doesn't keep the rest of the section alive
+    EXPECT_TRUE(last.expired());
+}
+
+TEST(TrigSectionTest, BriefingTriggers)
+{
+    std::vector<Chk::TriggerPtr> briefingTriggers = { trigSectionTestTrigger(1), trigSectionTestTrigger(2), trigSectionTestTrigger(3) };
+    std::multimap<SectionName, Section> parsedSections;
+    MbrfSectionPtr mbrf = std::dynamic_pointer_cast<MbrfSection>(trigSectionTestRead(parsedSections, trigSectionTestSection(SectionName::MBRF, briefingTriggers)));
+    ASSERT_NE(nullptr, mbrf);
+    ASSERT_EQ(3, mbrf->numBriefingTriggers());
+    EXPECT_EQ(2, mbrf->getBriefingTrigger(1)->conditions[0].amount);
+
+    mbrf->addBriefingTrigger(trigSectionTestTrigger(4));
+    mbrf->deleteBriefingTrigger(0);
+    briefingTriggers.push_back(trigSectionTestTrigger(4));
+    briefingTriggers.erase(briefingTriggers.begin());
+    EXPECT_EQ(trigSectionTestSection(SectionName::MBRF, briefingTriggers), trigSectionTestWrite(mbrf));
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+Scenario triggerBatchTestScenario(size_t numTriggers, size_t extensionEvery, size_t extensionOffset)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    for ( size_t i=0; i<numTriggers; i++ )
+    {
+        Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+        trigger->conditions[0].amount = u32(i); // Identifies the trigger wherever it's moved
+        scenario.triggers.addTrigger(trigger);
+        if ( i % extensionEvery == extensionOffset )
+            scenario.triggers.getTriggerExtension(i, true)->trigNum = u32(i);
+    }
+    return scenario;
+}
+
+void expectTriggerBatchTestExtensionsFixed(const Scenario & scenario)
+{
+    for ( size_t i=0; i<scenario.triggers.numTriggers(); i++ )
+    {
+        Chk::ExtendedTrigDataPtr extension = scenario.triggers.getTriggerExtension(i);
+        if ( extension != nullptr )
+            EXPECT_EQ(u32(i), extension->trigNum);
+    }
+}
+
+void expectTriggerBatchTestSameTriggers(const Scenario & expected, const Scenario & actual)
+{
+    ASSERT_EQ(expected.triggers.numTriggers(), actual.triggers.numTriggers());
+    for ( size_t i=0; i<expected.triggers.numTriggers(); i++ )
+    {
+        EXPECT_EQ(expected.triggers.getTrigger(i)->conditions[0].amount, actual.triggers.getTrigger(i)->conditions[0].amount);
+        EXPECT_EQ(expected.triggers.getTrigger(i)->getExtendedDataIndex(), actual.triggers.getTrigger(i)->getExtendedDataIndex());
+        EXPECT_EQ(expected.triggers.getTriggerExtension(i) == nullptr, actual.triggers.getTriggerExtension(i) == nullptr);
+    }
+}
+
+void triggerBatchTestDeleteEveryFifth(Scenario & scenario, size_t numDeleted) // None of the deleted triggers have extensions
+{
+    for ( size_t i=0; i<numDeleted; i++ )
+        scenario.triggers.deleteTrigger(i*4);
+}
+
+TEST(TriggerBatchTest, FixesExtensionsAtCommit)
+{
+    Scenario scenario = triggerBatchTestScenario(10, 3, 2); // Triggers 2, 5 and 8 have extensions
+    Chk::ExtendedTrigDataPtr extension = scenario.triggers.getTriggerExtension(5);
+    ASSERT_NE(nullptr, extension);
+
+    EXPECT_FALSE(scenario.triggers.inBatch());
+    scenario.triggers.beginBatch();
+    EXPECT_TRUE(scenario.triggers.inBatch());
+    scenario.triggers.deleteTrigger(0);
+    scenario.triggers.deleteTrigger(0);
+    scenario.triggers.moveTrigger(3, 2);
+    EXPECT_EQ(extension, scenario.triggers.getTriggerExtension(2));
+    EXPECT_EQ(5, extension->trigNum); // Not fixed until the batch is committed
+
+    scenario.triggers.beginBatch(); // Nested batches are committed with the outermost batch
+    scenario.triggers.insertTrigger(0, Chk::TriggerPtr(new Chk::Trigger()));
+    scenario.triggers.commitBatch();
+    EXPECT_EQ(5, extension->trigNum);
+    scenario.triggers.commitBatch();
+    EXPECT_FALSE(scenario.triggers.inBatch());
+    EXPECT_EQ(3, extension->trigNum);
+    expectTriggerBatchTestExtensionsFixed(scenario);
+
+    EXPECT_THROW(scenario.triggers.commitBatch(), std::logic_error);
+    {
+        Triggers::Batch batch(scenario.triggers);
+        scenario.triggers.moveTrigger(3, 4);
+        EXPECT_EQ(3, extension->trigNum);
+    } // Committed when the batch goes out of scope
+    EXPECT_EQ(4, extension->trigNum);
+}
+
+TEST(TriggerBatchTest, SameAsUnbatched)
+{
+    Scenario unbatched = triggerBatchTestScenario(200, 4, 1);
+    Scenario batched = triggerBatchTestScenario(200, 4, 1);
+    auto change = [](Scenario & scenario) {
+        for ( size_t i=0; i<40; i++ )
+        {
+            scenario.triggers.moveTrigger(i*3, 150 - i);
+            scenario.triggers.insertTrigger(i*2, Chk::TriggerPtr(new Chk::Trigger()));
+            if ( scenario.triggers.getTriggerExtension(i*5) == nullptr ) // Extensions of deleted triggers are passed on to the trigger taking their place
+                scenario.triggers.deleteTrigger(i*5);
+        }
+    };
+
+    change(unbatched);
+    Triggers::Batch batch(batched.triggers);
+    change(batched);
+    batch.commit();
+    expectTriggerBatchTestSameTriggers(unbatched, batched);
+    expectTriggerBatchTestExtensionsFixed(batched);
+}
+
+TEST(TriggerBatchTest, BatchesAreNotCopiedAndDontThrowFromDestructors)
+{
+    EXPECT_FALSE(std::is_copy_constructible<Triggers::Batch>::value);
+    EXPECT_FALSE(std::is_copy_assignable<Triggers::Batch>::value);
+
+    Scenario scenario = triggerBatchTestScenario(10, 3, 2);
+    {
+        Triggers::Batch batch(scenario.triggers);
+        scenario.triggers.commitBatch(); // Closes the batch out from under the guard
+        EXPECT_FALSE(scenario.triggers.inBatch());
+    } // The guard's commit fails without throwing
+    EXPECT_FALSE(scenario.triggers.inBatch());
+    EXPECT_THROW(scenario.triggers.commitBatch(), std::logic_error);
+}
+
+TEST(TriggerBatchTest, ReplaceRangeFixesExtensions)
+{
+    Scenario scenario = triggerBatchTestScenario(10, 3, 2);
+    Chk::ExtendedTrigDataPtr extension = scenario.triggers.getTriggerExtension(8);
+    std::deque<Chk::TriggerPtr> replacements = { Chk::TriggerPtr(new Chk::Trigger()) };
+    std::deque<Chk::TriggerPtr> replaced = scenario.triggers.replaceRange(3, 6, replacements);
+    EXPECT_EQ(3, replaced.size());
+    EXPECT_EQ(8, scenario.triggers.numTriggers());
+    EXPECT_EQ(extension, scenario.triggers.getTriggerExtension(6));
+    EXPECT_EQ(6, extension->trigNum);
+    expectTriggerBatchTestExtensionsFixed(scenario);
+}
+
+TEST(TriggerBatchTest, DeleteSameAsUnbatched)
+{
+    constexpr size_t numTriggers = 500, numDeleted = 100;
+    Scenario unbatched = triggerBatchTestScenario(numTriggers, 5, 2);
+    Scenario batched = triggerBatchTestScenario(numTriggers, 5, 2);
+    triggerBatchTestDeleteEveryFifth(unbatched, numDeleted);
+    Triggers::Batch batch(batched.triggers);
+    triggerBatchTestDeleteEveryFifth(batched, numDeleted);
+    batch.commit();
+
+    EXPECT_EQ(numTriggers - numDeleted, batched.triggers.numTriggers());
+    expectTriggerBatchTestSameTriggers(unbatched, batched);
+    expectTriggerBatchTestExtensionsFixed(batched);
+}
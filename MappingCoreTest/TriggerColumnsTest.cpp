@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <bitset>
+#include <random>
+#include <vector>
+
+Chk::TriggerPtr triggerColumnsTestTrigger(std::mt19937 & random)
+{
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    size_t numConditions = random() % 4;
+    for ( size_t i=0; i<numConditions; i++ )
+    {
+        Chk::Condition & condition = trigger->conditions[random() % Chk::Trigger::MaxConditions];
+        condition.conditionType = Chk::Condition::Type(random() % (Chk::Condition::NumConditionTypes+2)); // Some beyond the last condition type
+        condition.locationId = u32(random() % 20);
+        condition.player = u32(random() % 8);
+        condition.amount = u32(random() % 20);
+    }
+    size_t numActions = random() % 6;
+    for ( size_t i=0; i<numActions; i++ )
+    {
+        Chk::Action & action = trigger->actions[random() % Chk::Trigger::MaxActions];
+        action.actionType = Chk::Action::Type(random() % (Chk::Action::NumActionTypes+2));
+        action.locationId = u32(random() % 20);
+        action.stringId = u32(random() % 16 == 0 ? Chk::MaxStrings+1 : random() % 20); // Some beyond the last string
+        action.soundStringId = u32(random() % 20);
+        action.number = u32(random() % 20);
+    }
+    return trigger;
+}
+
+TrigSectionPtr triggerColumnsTestTriggers(size_t numTriggers, std::mt19937 & random)
+{
+    TrigSectionPtr trig = TrigSection::GetDefault();
+    for ( size_t i=0; i<numTriggers; i++ )
+        trig->addTrigger(triggerColumnsTestTrigger(random));
+
+    return trig;
+}
+
+void expectTriggerColumnsTestSameStringUsers(const std::vector<Chk::StringUser> & expected, const std::vector<Chk::StringUser> & actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for ( size_t i=0; i<expected.size(); i++ )
+    {
+        EXPECT_EQ(expected[i].userFlags, actual[i].userFlags) << i;
+        EXPECT_EQ(expected[i].index, actual[i].index) << i;
+        EXPECT_EQ(expected[i].subIndex, actual[i].subIndex) << i;
+    }
+}
+
+TEST(TriggerColumnsTest, Columns)
+{
+    TrigSectionPtr trig = TrigSection::GetDefault();
+    trig->addTrigger(Chk::TriggerPtr(new Chk::Trigger()));
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->conditions[2].conditionType = Chk::Condition::Type::Bring;
+    trigger->conditions[2].locationId = 5;
+    trigger->conditions[2].unitType = Sc::Unit::Type::TerranMarine;
+    trigger->conditions[2].player = 3;
+    trigger->conditions[2].amount = 10;
+    trigger->actions[7].actionType = Chk::Action::Type::Transmission;
+    trigger->actions[7].locationId = 6;
+    trigger->actions[7].stringId = 7;
+    trigger->actions[7].soundStringId = 8;
+    trigger->actions[7].type = 9;
+    trigger->actions[7].group = 10;
+    trigger->actions[7].number = 11;
+    trig->addTrigger(trigger);
+
+    TriggerColumns columns(*trig);
+    EXPECT_EQ(2, columns.numTriggers());
+    ASSERT_EQ(1, columns.numConditions()); // Empty slots aren't copied
+    ASSERT_EQ(1, columns.numActions());
+    EXPECT_EQ(std::vector<u32>({ 1 }), columns.getConditionTriggers());
+    EXPECT_EQ(std::vector<u8>({ 2 }), columns.getConditionIndexes());
+    EXPECT_EQ(std::vector<u8>({ u8(Chk::Condition::Type::Bring) }), columns.getConditionTypes());
+    EXPECT_EQ(std::vector<u32>({ 5 }), columns.getConditionLocations());
+    EXPECT_EQ(std::vector<u16>({ u16(Sc::Unit::Type::TerranMarine) }), columns.getConditionUnits());
+    EXPECT_EQ(std::vector<u32>({ 3 }), columns.getConditionPlayers());
+    EXPECT_EQ(std::vector<u32>({ 10 }), columns.getConditionNumbers());
+    EXPECT_EQ(std::vector<u32>({ 1 }), columns.getActionTriggers());
+    EXPECT_EQ(std::vector<u8>({ 7 }), columns.getActionIndexes());
+    EXPECT_EQ(std::vector<u8>({ u8(Chk::Action::Type::Transmission) }), columns.getActionTypes());
+    EXPECT_EQ(std::vector<u32>({ 6 }), columns.getActionLocations());
+    EXPECT_EQ(std::vector<u32>({ 7 }), columns.getActionStrings());
+    EXPECT_EQ(std::vector<u32>({ 8 }), columns.getActionSounds());
+    EXPECT_EQ(std::vector<u16>({ 9 }), columns.getActionUnits());
+    EXPECT_EQ(std::vector<u32>({ 10 }), columns.getActionPlayers());
+    EXPECT_EQ(std::vector<u32>({ 11 }), columns.getActionNumbers());
+
+    EXPECT_EQ(2*Chk::Trigger::MaxConditions-1, columns.countConditions(Chk::Condition::Type::NoCondition));
+    EXPECT_EQ(1, columns.countConditions(Chk::Condition::Type::Bring));
+    EXPECT_EQ(2*Chk::Trigger::MaxActions-1, columns.countActions(Chk::Action::Type::NoAction));
+    EXPECT_EQ(1, columns.countActions(Chk::Action::Type::Transmission));
+    EXPECT_EQ(0, columns.countActions(Chk::Action::Type::Wait));
+
+    EXPECT_TRUE(columns.locationUsed(5));
+    EXPECT_TRUE(columns.locationUsed(6));
+    EXPECT_FALSE(columns.locationUsed(11)); // Transmission has no secondary location
+    EXPECT_TRUE(columns.stringUsed(7));
+    EXPECT_TRUE(columns.stringUsed(8));
+    EXPECT_FALSE(columns.stringUsed(8, Chk::StringUserFlag::TriggerAction));
+    EXPECT_EQ(std::vector<size_t>({ 1 }), columns.findTriggersUsingLocation(5));
+
+    trigger->actions[7].stringId = 20; // Columns are a snapshot
+    EXPECT_TRUE(columns.stringUsed(7));
+}
+
+TEST(TriggerColumnsTest, SameAsScan)
+{
+    std::mt19937 random(49);
+    TrigSectionPtr trig = triggerColumnsTestTriggers(2000, random);
+    TriggerColumns columns(*trig);
+
+    std::bitset<Chk::TotalLocations+1> scannedLocations, columnLocations;
+    trig->markUsedLocations(scannedLocations);
+    columns.markUsedLocations(columnLocations);
+    EXPECT_EQ(scannedLocations, columnLocations);
+    for ( size_t locationId=0; locationId<=30; locationId++ )
+    {
+        EXPECT_EQ(trig->locationUsed(locationId), columns.locationUsed(locationId)) << locationId;
+        std::vector<size_t> scannedTriggers;
+        for ( size_t i=0; i<trig->numTriggers(); i++ )
+        {
+            if ( trig->getTrigger(i)->locationUsed(locationId) )
+                scannedTriggers.push_back(i);
+        }
+        EXPECT_EQ(scannedTriggers, columns.findTriggersUsingLocation(locationId)) << locationId;
+    }
+
+    for ( u32 userMask : { u32(Chk::StringUserFlag::AnyTrigger), u32(Chk::StringUserFlag::TriggerAction), u32(Chk::StringUserFlag::TriggerActionSound), u32(Chk::StringUserFlag::All) } )
+    {
+        std::bitset<Chk::MaxStrings> scannedStrings, columnStrings, scannedGameStrings, columnGameStrings;
+        trig->markUsedStrings(scannedStrings, userMask);
+        columns.markUsedStrings(columnStrings, userMask);
+        EXPECT_EQ(scannedStrings, columnStrings) << userMask;
+        trig->markUsedGameStrings(scannedGameStrings, userMask);
+        columns.markUsedGameStrings(columnGameStrings, userMask);
+        EXPECT_EQ(scannedGameStrings, columnGameStrings) << userMask;
+        for ( size_t stringId : { size_t(0), size_t(1), size_t(5), size_t(19), size_t(25), size_t(Chk::MaxStrings+1) } )
+        {
+            EXPECT_EQ(trig->stringUsed(stringId, userMask), columns.stringUsed(stringId, userMask)) << stringId;
+            EXPECT_EQ(trig->gameStringUsed(stringId, userMask), columns.gameStringUsed(stringId, userMask)) << stringId;
+            std::vector<Chk::StringUser> scannedUsers, columnUsers;
+            trig->appendUsage(stringId, scannedUsers, userMask);
+            columns.appendUsage(stringId, columnUsers, userMask);
+            expectTriggerColumnsTestSameStringUsers(scannedUsers, columnUsers);
+        }
+    }
+    std::bitset<Chk::MaxStrings> scannedCommentStrings, columnCommentStrings;
+    trig->markUsedCommentStrings(scannedCommentStrings);
+    columns.markUsedCommentStrings(columnCommentStrings);
+    EXPECT_EQ(scannedCommentStrings, columnCommentStrings);
+
+    for ( size_t conditionType=0; conditionType<Chk::Condition::NumConditionTypes+2; conditionType++ )
+    {
+        size_t scannedCount = 0;
+        for ( size_t i=0; i<trig->numTriggers(); i++ )
+        {
+            for ( size_t j=0; j<Chk::Trigger::MaxConditions; j++ )
+                scannedCount += size_t(trig->getTrigger(i)->conditions[j].conditionType) == conditionType ? 1 : 0;
+        }
+        EXPECT_EQ(scannedCount, columns.countConditions(Chk::Condition::Type(conditionType))) << conditionType;
+    }
+    for ( size_t actionType=0; actionType<Chk::Action::NumActionTypes+2; actionType++ )
+    {
+        size_t scannedCount = 0;
+        for ( size_t i=0; i<trig->numTriggers(); i++ )
+        {
+            for ( size_t j=0; j<Chk::Trigger::MaxActions; j++ )
+                scannedCount += size_t(trig->getTrigger(i)->actions[j].actionType) == actionType ? 1 : 0;
+        }
+        EXPECT_EQ(scannedCount, columns.countActions(Chk::Action::Type(actionType))) << actionType;
+    }
+}
+
+TEST(TriggerColumnsTest, TriggersKeepColumnsCurrent)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    Triggers & triggers = scenario.triggers;
+    Chk::TriggerPtr trigger = Chk::TriggerPtr(new Chk::Trigger());
+    trigger->actions[0].actionType = Chk::Action::Type::DisplayTextMessage;
+    trigger->actions[0].stringId = 4;
+    triggers.addTrigger(trigger);
+
+    auto columns = triggers.getColumns();
+    EXPECT_EQ(size_t(1), columns->numActions());
+    EXPECT_EQ(columns, triggers.getColumns()); // Nothing changed, the same columns are used
+
+    std::bitset<Chk::MaxStrings> stringIdUsed;
+    triggers.markUsedStrings(stringIdUsed, Chk::Scope::Game);
+    EXPECT_TRUE(stringIdUsed[4]);
+
+    Chk::Action action = triggers.getTrigger(0)->actions[0];
+    action.stringId = 6;
+    triggers.setAction(0, 0, action);
+    action.actionType = Chk::Action::Type::Order;
+    action.stringId = 0;
+    action.locationId = 7;
+    triggers.setAction(0, 1, action);
+    EXPECT_NE(columns, triggers.getColumns());
+    stringIdUsed.reset();
+    triggers.markUsedStrings(stringIdUsed, Chk::Scope::Game);
+    EXPECT_FALSE(stringIdUsed[4]);
+    EXPECT_TRUE(stringIdUsed[6]);
+    std::bitset<Chk::TotalLocations+1> locationIdUsed;
+    triggers.markUsedLocations(locationIdUsed);
+    EXPECT_TRUE(locationIdUsed[7]);
+
+    triggers.deleteTrigger(0);
+    stringIdUsed.reset();
+    triggers.markUsedGameStrings(stringIdUsed);
+    EXPECT_FALSE(stringIdUsed[6]);
+    EXPECT_EQ(size_t(0), triggers.getColumns()->numActions());
+}
+
+TEST(TriggerColumnsTest, EditedActionStringsAreKept)
+{
+    // As in editing an action's string: add the string, set the action, then delete unused strings
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    scenario.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger()));
+    auto columns = scenario.triggers.getColumns();
+    Chk::Action action = scenario.triggers.getTrigger(0)->actions[0];
+    action.actionType = Chk::Action::Type::DisplayTextMessage;
+    size_t stringId = scenario.strings.addString<RawString>("Edited");
+    ASSERT_NE(size_t(Chk::StringId::NoString), stringId);
+    action.stringId = u32(stringId);
+    scenario.triggers.setAction(0, 0, action);
+    EXPECT_NE(columns, scenario.triggers.getColumns());
+    scenario.strings.deleteUnusedStrings(Chk::Scope::Game);
+    EXPECT_EQ(stringId, scenario.strings.findString<RawString>("Edited"));
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+class ScanningSelection // The selection as a plain list of indexes that's searched for every lookup, which UnitSelection must match
+{
+    public:
+        std::vector<u16> indexes;
+
+        bool contains(u16 index) const { return std::find(indexes.begin(), indexes.end(), index) != indexes.end(); }
+        void add(u16 index) { if ( !contains(index) ) indexes.insert(indexes.begin(), index); }
+        void remove(u16 index) { auto found = std::find(indexes.begin(), indexes.end(), index); if ( found != indexes.end() ) indexes.erase(found); }
+        void ensureFirst(u16 index) { if ( contains(index) ) { remove(index); indexes.insert(indexes.begin(), index); } }
+        void unitInserted(u16 index) { for ( u16 & unitIndex : indexes ) { if ( unitIndex >= index ) unitIndex++; } }
+        void unitDeleted(u16 index) { remove(index); for ( u16 & unitIndex : indexes ) { if ( unitIndex > index ) unitIndex--; } }
+};
+
+void expectSameSelection(const ScanningSelection & expected, const UnitSelection & actual, u16 maxIndex)
+{
+    EXPECT_EQ(expected.indexes, actual.getIndexes());
+    EXPECT_EQ(expected.indexes.size(), actual.size());
+    for ( u16 index=0; index<=maxIndex; index++ )
+        EXPECT_EQ(expected.contains(index), actual.contains(index));
+}
+
+TEST(UnitSelectionTest, AddRemove)
+{
+    UnitSelection selection;
+    EXPECT_TRUE(selection.empty());
+    EXPECT_FALSE(selection.contains(0));
+    EXPECT_EQ(0, selection.first());
+    EXPECT_EQ(u16_max, selection.highest());
+    EXPECT_EQ(u16_max, selection.lowest());
+
+    selection.add(5);
+    selection.add(2);
+    selection.add(9);
+    selection.add(2); // Already selected, not added again
+    EXPECT_EQ(std::vector<u16>({ 9, 2, 5 }), selection.getIndexes());
+    EXPECT_TRUE(selection.contains(2));
+    EXPECT_FALSE(selection.contains(3));
+    EXPECT_FALSE(selection.contains(1000));
+    EXPECT_EQ(9, selection.first());
+    EXPECT_EQ(9, selection.highest());
+    EXPECT_EQ(2, selection.lowest());
+    EXPECT_EQ(2, selection.numBefore(6));
+
+    selection.ensureFirst(5);
+    EXPECT_EQ(std::vector<u16>({ 5, 9, 2 }), selection.getIndexes());
+    selection.ensureFirst(7); // Not selected, nothing changes
+    EXPECT_EQ(std::vector<u16>({ 5, 9, 2 }), selection.getIndexes());
+
+    selection.remove(9);
+    selection.remove(4);
+    EXPECT_EQ(std::vector<u16>({ 5, 2 }), selection.getIndexes());
+    EXPECT_FALSE(selection.contains(9));
+
+    selection.sort(true);
+    EXPECT_EQ(std::vector<u16>({ 2, 5 }), selection.getIndexes());
+    selection.sort(false);
+    EXPECT_EQ(std::vector<u16>({ 5, 2 }), selection.getIndexes());
+
+    selection.set(1, 3);
+    EXPECT_EQ(std::vector<u16>({ 5, 3 }), selection.getIndexes());
+    EXPECT_FALSE(selection.contains(2));
+    EXPECT_TRUE(selection.contains(3));
+    EXPECT_THROW(selection.set(2, 0), std::out_of_range);
+
+    selection.clear();
+    EXPECT_TRUE(selection.empty());
+    EXPECT_FALSE(selection.contains(5));
+    EXPECT_FALSE(selection.contains(3));
+}
+
+TEST(UnitSelectionTest, InsertDelete)
+{
+    UnitSelection selection;
+    selection.add(1);
+    selection.add(4);
+    selection.add(6);
+
+    selection.unitInserted(4); // 4 and 6 shift forward
+    EXPECT_EQ(std::vector<u16>({ 7, 5, 1 }), selection.getIndexes());
+    EXPECT_FALSE(selection.contains(4));
+    EXPECT_TRUE(selection.contains(5));
+
+    selection.unitDeleted(5); // 5 is deselected, 7 shifts back
+    EXPECT_EQ(std::vector<u16>({ 6, 1 }), selection.getIndexes());
+    EXPECT_FALSE(selection.contains(7));
+    EXPECT_TRUE(selection.contains(6));
+
+    selection.unitDeleted(0);
+    EXPECT_EQ(std::vector<u16>({ 5, 0 }), selection.getIndexes());
+}
+
+TEST(UnitSelectionTest, SendMoveAndSwap)
+{
+    UnitSelection selection;
+    selection.add(2);
+    selection.add(5);
+
+    selection.sendMove(0, 5); // The unit at 5 moves back to 0, units from 0 to 4 shift forward
+    EXPECT_FALSE(selection.contains(0)); // Flagged until the move is finished
+    selection.finishMove();
+    EXPECT_EQ(std::vector<u16>({ 0, 3 }), selection.getIndexes());
+    EXPECT_TRUE(selection.contains(0));
+    EXPECT_TRUE(selection.contains(3));
+    EXPECT_FALSE(selection.contains(5));
+
+    selection.sendSwap(3, 0); // The units at 0 and 3 trade places, the unit that went to 3 is flagged so it isn't swapped again
+    EXPECT_TRUE(selection.contains(0));
+    EXPECT_FALSE(selection.contains(3));
+    selection.finishSwap();
+    EXPECT_EQ(std::vector<u16>({ 3, 0 }), selection.getIndexes());
+    EXPECT_TRUE(selection.contains(3));
+}
+
+TEST(UnitSelectionTest, MatchesScanning)
+{
+    const u16 numUnits = 300;
+    std::mt19937 random(4321);
+    UnitSelection selection;
+    ScanningSelection expected;
+    for ( size_t step=0; step<5000; step++ )
+    {
+        u16 index = u16(random() % numUnits);
+        switch ( random() % 8 )
+        {
+            case 0: case 1: case 2: selection.add(index); expected.add(index); break;
+            case 3: selection.remove(index); expected.remove(index); break;
+            case 4: selection.ensureFirst(index); expected.ensureFirst(index); break;
+            case 5:
+                if ( !expected.indexes.empty() && expected.indexes.size() < numUnits/2 )
+                {
+                    size_t position = random() % expected.indexes.size();
+                    u16 replacement = u16(random() % numUnits); // May briefly duplicate another entry, as reordering units does
+                    selection.set(position, replacement);
+                    expected.indexes[position] = replacement;
+                }
+                break;
+            case 6:
+                if ( index+1 < numUnits && std::none_of(expected.indexes.begin(), expected.indexes.end(), [&](u16 i) { return i+1 >= numUnits; }) )
+                {
+                    selection.unitInserted(index);
+                    expected.unitInserted(index);
+                }
+                break;
+            case 7: selection.unitDeleted(index); expected.unitDeleted(index); break;
+        }
+        if ( step % 1000 == 999 )
+        {
+            std::sort(expected.indexes.begin(), expected.indexes.end());
+            expected.indexes.erase(std::unique(expected.indexes.begin(), expected.indexes.end()), expected.indexes.end());
+            selection.clear();
+            for ( auto it = expected.indexes.rbegin(); it != expected.indexes.rend(); ++it )
+                selection.add(*it);
+        }
+        ASSERT_EQ(expected.indexes, selection.getIndexes());
+    }
+    expectSameSelection(expected, selection, numUnits);
+}
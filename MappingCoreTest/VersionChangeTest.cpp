@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <string>
+#include <vector>
+
+void versionChangeTestAddLocation(Scenario & scenario, size_t locationId, size_t actionIndex)
+{
+    Chk::LocationPtr location = Chk::LocationPtr(new Chk::Location());
+    location->right = 32;
+    location->bottom = 32;
+    scenario.layers.replaceLocation(locationId, location);
+
+    while ( scenario.triggers.numTriggers() <= actionIndex/Chk::Trigger::MaxActions )
+        scenario.triggers.addTrigger(Chk::TriggerPtr(new Chk::Trigger()));
+
+    Chk::Action action = {};
+    action.actionType = Chk::Action::Type::CreateUnit;
+    action.locationId = u32(locationId);
+    scenario.triggers.setAction(actionIndex/Chk::Trigger::MaxActions, actionIndex%Chk::Trigger::MaxActions, action);
+}
+
+TEST(VersionChangeTest, PlanDoesNotChangeScenario)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    scenario.changeVersionTo(Chk::Version::StarCraft_BroodWar);
+    versionChangeTestAddLocation(scenario, 10, 0);
+    versionChangeTestAddLocation(scenario, 100, 1);
+    versionChangeTestAddLocation(scenario, 200, 2);
+    size_t unusedStringId = scenario.strings.addString<RawString>("Unused");
+    size_t unusedEditorStringId = scenario.strings.addString<RawString>("Unused editor string", Chk::Scope::Editor);
+
+    Scenario::VersionChange versionChange = scenario.planVersionChange(Chk::Version::StarCraft_Original);
+    EXPECT_EQ(Chk::Version::StarCraft_Original, versionChange.version);
+    EXPECT_TRUE(versionChange.possible);
+    EXPECT_EQ(4, versionChange.numLocationsUsed); // Including anywhere
+    EXPECT_EQ(3, versionChange.locationIdRemappings.size());
+    EXPECT_EQ(1, versionChange.locationIdRemappings[10]); // Locations in use are packed into the lowest ids
+    EXPECT_EQ(std::vector<size_t>({ unusedStringId }), versionChange.unusedGameStringIds);
+    EXPECT_EQ(std::vector<size_t>({ unusedEditorStringId }), versionChange.unusedEditorStringIds);
+
+    EXPECT_TRUE(scenario.versions.isExpansion());
+    EXPECT_EQ(Chk::TotalLocations, scenario.layers.numLocations());
+    EXPECT_FALSE(scenario.layers.isBlank(200));
+    EXPECT_EQ(200, scenario.triggers.getTrigger(0)->actions[2].locationId);
+    EXPECT_TRUE(scenario.strings.stringStored(unusedStringId, Chk::Scope::Game));
+    EXPECT_TRUE(scenario.strings.stringStored(unusedEditorStringId, Chk::Scope::Editor));
+
+    ASSERT_TRUE(scenario.changeVersionTo(Chk::Version::StarCraft_Original));
+    EXPECT_TRUE(scenario.versions.isOriginal());
+    EXPECT_EQ(Chk::TotalOriginalLocations, scenario.layers.numLocations());
+    EXPECT_EQ(1, scenario.triggers.getTrigger(0)->actions[0].locationId);
+    EXPECT_EQ(versionChange.locationIdRemappings[100], scenario.triggers.getTrigger(0)->actions[1].locationId);
+    EXPECT_EQ(versionChange.locationIdRemappings[200], scenario.triggers.getTrigger(0)->actions[2].locationId);
+    EXPECT_FALSE(scenario.layers.isBlank(versionChange.locationIdRemappings[200]));
+    EXPECT_FALSE(scenario.strings.stringStored(unusedStringId, Chk::Scope::Game));
+    EXPECT_FALSE(scenario.strings.stringStored(unusedEditorStringId, Chk::Scope::Editor));
+}
+
+TEST(VersionChangeTest, TooManyLocationsChangesNothing)
+{
+    Scenario scenario(Sc::Terrain::Tileset::Badlands);
+    scenario.changeVersionTo(Chk::Version::StarCraft_BroodWar);
+    for ( size_t i=0; i<Chk::TotalOriginalLocations; i++ )
+        versionChangeTestAddLocation(scenario, 100+i, i);
+    size_t unusedStringId = scenario.strings.addString<RawString>("Unused");
+
+    Scenario::VersionChange versionChange = scenario.planVersionChange(Chk::Version::StarCraft_Original);
+    EXPECT_FALSE(versionChange.possible);
+    EXPECT_EQ(Chk::TotalOriginalLocations+1, versionChange.numLocationsUsed);
+    EXPECT_TRUE(versionChange.unusedGameStringIds.empty());
+
+    EXPECT_FALSE(scenario.changeVersionTo(Chk::Version::StarCraft_Original)); // Fails before changing the version
+    EXPECT_TRUE(scenario.versions.isExpansion());
+    EXPECT_EQ(Chk::TotalLocations, scenario.layers.numLocations());
+    EXPECT_EQ(100, scenario.triggers.getTrigger(0)->actions[0].locationId);
+    EXPECT_TRUE(scenario.strings.stringStored(unusedStringId, Chk::Scope::Game));
+
+    EXPECT_FALSE(scenario.versions.changeTo(Chk::Version::StarCraft_Original));
+    EXPECT_TRUE(scenario.versions.isExpansion());
+
+    EXPECT_TRUE(scenario.planVersionChange(Chk::Version::StarCraft_Hybrid).possible);
+    EXPECT_TRUE(scenario.changeVersionTo(Chk::Version::StarCraft_Hybrid));
+    EXPECT_TRUE(scenario.versions.isHybrid());
+    EXPECT_EQ(Chk::TotalLocations, scenario.layers.numLocations());
+    EXPECT_EQ(100, scenario.triggers.getTrigger(0)->actions[0].locationId);
+}
+
+TEST(VersionChangeTest, SameAsSeparateSteps)
+{
+    Scenario planned(Sc::Terrain::Tileset::Badlands), separate(Sc::Terrain::Tileset::Badlands);
+    for ( Scenario* scenario : { &planned, &separate } )
+    {
+        scenario->changeVersionTo(Chk::Version::StarCraft_BroodWar);
+        for ( size_t i=0; i<40; i++ )
+            versionChangeTestAddLocation(*scenario, 3 + i*6, i);
+        for ( size_t i=0; i<20; i++ )
+            scenario->strings.addString<RawString>("String " + std::to_string(i));
+    }
+
+    ASSERT_TRUE(planned.changeVersionTo(Chk::Version::StarCraft_Original));
+    ASSERT_TRUE(separate.layers.trimLocationsToOriginal());
+    separate.strings.deleteUnusedStrings(Chk::Scope::Both);
+
+    ASSERT_EQ(separate.layers.numLocations(), planned.layers.numLocations());
+    for ( size_t locationId=1; locationId<=separate.layers.numLocations(); locationId++ )
+        EXPECT_EQ(separate.layers.isBlank(locationId), planned.layers.isBlank(locationId)) << locationId;
+    for ( size_t i=0; i<40; i++ )
+        EXPECT_EQ(separate.triggers.getTrigger(i/Chk::Trigger::MaxActions)->actions[i%Chk::Trigger::MaxActions].locationId,
+            planned.triggers.getTrigger(i/Chk::Trigger::MaxActions)->actions[i%Chk::Trigger::MaxActions].locationId) << i;
+    for ( size_t stringId=0; stringId<separate.strings.getCapacity(Chk::Scope::Game); stringId++ )
+        EXPECT_EQ(separate.strings.stringStored(stringId, Chk::Scope::Game), planned.strings.stringStored(stringId, Chk::Scope::Game)) << stringId;
+}
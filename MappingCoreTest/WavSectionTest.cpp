@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <bitset>
+#include <map>
+#include <random>
+#include <sstream>
+#include <vector>
+
+bool wavSectionTestStringIsSound(const WavSection & wav, size_t stringId) // Matches the way sounds were searched before they were indexed
+{
+    for ( size_t i=0; i<Chk::TotalSounds; i++ )
+    {
+        if ( wav.getSoundStringId(i) == stringId )
+            return true;
+    }
+    return false;
+}
+
+std::vector<size_t> wavSectionTestUsage(const WavSection & wav, size_t stringId)
+{
+    std::vector<Chk::StringUser> stringUsers;
+    wav.appendUsage(stringId, stringUsers);
+    std::vector<size_t> soundIndexes;
+    for ( const Chk::StringUser & stringUser : stringUsers )
+        soundIndexes.push_back(stringUser.index);
+
+    return soundIndexes;
+}
+
+void expectWavSectionTestSameAsScan(const WavSection & wav, size_t maxStringId)
+{
+    std::bitset<Chk::MaxStrings> used;
+    wav.markUsedStrings(used);
+    for ( size_t stringId=0; stringId<=maxStringId; stringId++ )
+    {
+        std::vector<size_t> scannedUsage;
+        for ( size_t i=0; i<Chk::TotalSounds; i++ )
+        {
+            if ( wav.getSoundStringId(i) == stringId )
+                scannedUsage.push_back(i);
+        }
+        EXPECT_EQ(wavSectionTestStringIsSound(wav, stringId), wav.stringIsSound(stringId)) << stringId;
+        EXPECT_EQ(scannedUsage, wavSectionTestUsage(wav, stringId)) << stringId;
+        EXPECT_EQ(stringId != Chk::StringId::UnusedSound && !scannedUsage.empty(), used[stringId]) << stringId;
+    }
+}
+
+TEST(WavSectionTest, AddAndDeleteSounds)
+{
+    WavSectionPtr wav = WavSection::GetDefault();
+    EXPECT_TRUE(wav->stringIsSound(Chk::StringId::UnusedSound));
+    EXPECT_FALSE(wav->stringIsSound(5));
+    EXPECT_EQ(0, wav->addSound(5));
+    EXPECT_EQ(1, wav->addSound(6));
+    EXPECT_EQ(2, wav->addSound(5)); // The same string can be used by more than one sound
+    EXPECT_TRUE(wav->stringIsSound(5));
+    EXPECT_EQ(std::vector<size_t>({ 0, 2 }), wavSectionTestUsage(*wav, 5));
+
+    wav->deleteString(5);
+    EXPECT_FALSE(wav->stringIsSound(5));
+    EXPECT_EQ(Chk::StringId::UnusedSound, wav->getSoundStringId(2));
+    EXPECT_EQ(0, wav->addSound(7)); // Lowest unused sound first
+    wav->setSoundStringId(1, Chk::StringId::UnusedSound);
+    EXPECT_FALSE(wav->stringIsSound(6));
+    EXPECT_EQ(1, wav->addSound(8));
+    expectWavSectionTestSameAsScan(*wav, 10);
+
+    for ( size_t i=2; i<Chk::TotalSounds; i++ )
+        EXPECT_EQ(i, wav->addSound(100+i));
+    EXPECT_FALSE(wav->stringIsSound(Chk::StringId::UnusedSound));
+    EXPECT_EQ(Chk::TotalSounds, wav->addSound(9)); // Full
+    EXPECT_FALSE(wav->stringIsSound(9));
+    EXPECT_THROW(wav->getSoundStringId(Chk::TotalSounds), std::out_of_range);
+}
+
+TEST(WavSectionTest, SameAsScan)
+{
+    WavSectionPtr wav = WavSection::GetDefault();
+    std::mt19937 random(46);
+    constexpr size_t maxStringId = 700;
+    for ( size_t round=0; round<5000; round++ )
+    {
+        switch ( random() % 5 )
+        {
+            case 0: case 1: wav->addSound(random() % (maxStringId+1)); break;
+            case 2: wav->setSoundStringId(random() % Chk::TotalSounds, random() % 8 == 0 ? Chk::StringId::UnusedSound : random() % (maxStringId+1)); break;
+            case 3: wav->deleteString(random() % (maxStringId+1)); break;
+            case 4:
+            {
+                Chk::StringIdRemappings remappings;
+                for ( size_t i=0; i<8; i++ )
+                    remappings.set(random() % (maxStringId+1), random() % (maxStringId+1));
+                wav->remapStringIds(remappings);
+                break;
+            }
+        }
+        if ( round % 500 == 0 )
+            expectWavSectionTestSameAsScan(*wav, maxStringId);
+    }
+    expectWavSectionTestSameAsScan(*wav, maxStringId);
+}
+
+TEST(WavSectionTest, ReadIndexesSounds)
+{
+    WavSectionPtr written = WavSection::GetDefault();
+    written->setSoundStringId(3, 20);
+    written->setSoundStringId(200, 21);
+    std::stringstream chk(std::ios_base::in|std::ios_base::out|std::ios_base::binary);
+    written->writeWithHeader(chk);
+
+    Chk::SectionHeader header = {};
+    chk.read((char*)&header, sizeof(header));
+    std::multimap<SectionName, Section> parsedSections;
+    Chk::SectionSize sizeRead = 0;
+    WavSectionPtr read = std::dynamic_pointer_cast<WavSection>(ChkSection::read(parsedSections, header, chk, sizeRead));
+    ASSERT_NE(nullptr, read);
+    EXPECT_EQ(header.sizeInBytes, sizeRead);
+    EXPECT_TRUE(read->stringIsSound(20));
+    EXPECT_TRUE(read->stringIsSound(21));
+    for ( size_t expectedSoundIndex : { 0, 1, 2, 4 } ) // Skipping the sound read in
+        EXPECT_EQ(expectedSoundIndex, read->addSound(22));
+    expectWavSectionTestSameAsScan(*read, 30);
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "../MappingCoreLib/MappingCore.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(WorkerPoolTest, RunsEachTaskOnce)
+{
+    for ( size_t numWorkers : { size_t(1), size_t(2), size_t(8) } )
+    {
+        std::vector<std::atomic<u32>> timesRun(1000);
+        WorkerPool::run(timesRun.size(), [&](size_t taskIndex) {
+            timesRun[taskIndex] ++;
+        }, numWorkers);
+
+        for ( auto & count : timesRun )
+            EXPECT_EQ(1, count.load());
+    }
+
+    size_t timesRun = 0;
+    WorkerPool::run(0, [&](size_t) { timesRun ++; });
+    EXPECT_EQ(0, timesRun);
+}
+
+TEST(WorkerPoolTest, RethrowsTaskExceptions)
+{
+    for ( size_t numWorkers : { size_t(1), size_t(4) } )
+    {
+        EXPECT_THROW(WorkerPool::run(100, [](size_t taskIndex) {
+            if ( taskIndex == 50 )
+                throw std::runtime_error("Task failed");
+        }, numWorkers), std::runtime_error);
+    }
+}